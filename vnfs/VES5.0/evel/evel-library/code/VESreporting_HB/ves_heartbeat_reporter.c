@@ -23,17 +23,40 @@
 #include <netdb.h>
 #include <sys/time.h>
 #include <sys/stat.h>
-#include "jsmn.h"
 #include "evel.h"
-
-#define BUFSIZE 128
-#define MAX_BUFFER_SIZE 4096
-#define MAX_TOKENS 1000
+#ifdef VES_AGENT_PLUGIN
+#include "ves_plugin.h"
+#endif
 
 void *HeartbeatThread(void *threadarg);
+int start_heartbeats(void);
+
+/**************************************************************************//**
+ * Heartbeat parameters, compiled from hb_config.json.  The strings point
+ * into the parsed file.
+ *****************************************************************************/
+typedef struct hb_config {
+  const char * event_name;
+  const char * event_type;
+  const char * nfc_naming_code;
+  const char * nf_naming_code;
+  const char * reporting_entity_name;
+  const char * reporting_entity_id;
+  const char * source_id;
+  const char * source_name;
+  int interval;
+} HB_CONFIG;
 
 unsigned long long epoch_start = 0;
 
+/*****************************************************************************/
+/* The configuration file, and the scheduler, which is the VES agent's when  */
+/* running as a plugin.                                                      */
+/*****************************************************************************/
+const char * hb_config_file = "hb_config.json";
+EVEL_SCHEDULER * hb_scheduler = NULL;
+
+#ifndef VES_AGENT_PLUGIN
 int main(int argc, char** argv)
 {
   char* fqdn = argv[1];
@@ -113,143 +136,237 @@ int main(int argc, char** argv)
   printf("Terminated\n");
   return 0;
 }
+#endif
 
-void *HeartbeatThread(void *threadarg)
+/**************************************************************************//**
+ * Compile hb_config.json.
+ *****************************************************************************/
+void * compile_hb_config(const EVEL_CONFIG * config, void * context)
+{
+  const EVEL_CONFIG_NODE * direct;
+  HB_CONFIG * hb;
+
+  direct = evel_config_find(config, NULL, "tmp_directParameters");
+  if (direct == NULL)
+  {
+    printf("Missing mandatory parameters - tmp_directParameters is not there\n");
+    return NULL;
+  }
+
+  hb = calloc(1, sizeof(HB_CONFIG));
+  if (hb == NULL)
+  {
+    return NULL;
+  }
+
+  hb->event_name = evel_config_string(config, direct, "eventName", NULL);
+  if (hb->event_name == NULL)
+  {
+    printf("Missing mandatory parameters - eventName is not there in tmp_directParameters\n");
+    free(hb);
+    return NULL;
+  }
+
+  hb->interval = evel_config_int(config, direct, "heartbeatInterval", 0);
+  if (hb->interval <= 0)
+  {
+    printf("The parameter heartbeatInterval is not defined, defaulted to 60 seconds\n");
+    hb->interval = 60;
+  }
+
+  hb->event_type = evel_config_string(config, direct, "eventType", NULL);
+  hb->nfc_naming_code = evel_config_string(config, direct, "nfcNamingCode", NULL);
+  hb->nf_naming_code = evel_config_string(config, direct, "nfNamingCode", NULL);
+  hb->reporting_entity_id = evel_config_string(config, direct, "reportingEntityId", NULL);
+  hb->source_id = evel_config_string(config, direct, "sourceId", NULL);
+
+  hb->reporting_entity_name = evel_config_string(config, direct, "reportingEntityName", NULL);
+  if (hb->reporting_entity_name == NULL)
+  {
+     printf("Missing mandatory parameters - reportingEntityName is not there in tmp_directParameters\n");
+     printf("Defaulting reportingEntityName to hostname\n");
+  }
+
+  hb->source_name = evel_config_string(config, direct, "sourceName", NULL);
+  if (hb->source_name == NULL)
+  {
+     printf("Missing mandatory parameters - sourceName is not there in tmp_directParameters\n");
+     printf("Defaulting sourceName to hostname\n");
+  }
+
+  return hb;
+}
+
+/**************************************************************************//**
+ * Free a compiled hb_config.json.
+ *****************************************************************************/
+void free_hb_config(void * compiled)
 {
+  free(compiled);
+}
 
+/*****************************************************************************/
+/* Heartbeats are sent by a scheduled job, whose interval follows            */
+/* hb_config.json when it is reloaded.                                       */
+/*****************************************************************************/
+EVEL_CONFIG_WATCH * hb_config_watch;
+EVEL_SCHEDULER_JOB * hb_job;
+EVEL_ID_GENERATOR hb_event_ids;
+
+/**************************************************************************//**
+ * Send one heartbeat, for the interval ending at the scheduled time.
+ *****************************************************************************/
+void HeartbeatJob(void * context, unsigned long long scheduled)
+{
   EVENT_HEARTBEAT_FIELD * event = NULL;
   EVENT_HEADER* hb_header = NULL;
   EVEL_ERR_CODES evel_rc = EVEL_SUCCESS;
 
-  int numToken;
-  jsmntok_t tokens[MAX_TOKENS];
-  char js[MAX_BUFFER_SIZE]; 
+  HB_CONFIG * hb;
+
+  char event_id[EVEL_ID_MAX_LEN + 1] = {0};
+
+  evel_config_watch_check(hb_config_watch);
+  hb = evel_config_watch_acquire(hb_config_watch);
+
+  /***************************************************************************/
+  /* Heartbeat                                                               */
+  /***************************************************************************/
+  evel_id_generator_next(&hb_event_ids, event_id, sizeof(event_id));
+
+  event = evel_new_heartbeat_field(hb->interval, hb->event_name, event_id);
+  if (event != NULL)
+  {
+    hb_header = (EVENT_HEADER *)event;
+
+    if (hb->event_type != NULL)
+      evel_header_type_set(&event->header, hb->event_type);
+
+    evel_start_epoch_set(&event->header, epoch_start);
+    evel_last_epoch_set(&event->header, scheduled);
+    epoch_start = scheduled;
+
+    if (hb->nfc_naming_code != NULL)
+      evel_nfcnamingcode_set(&event->header, hb->nfc_naming_code);
+    if (hb->nf_naming_code != NULL)
+      evel_nfnamingcode_set(&event->header, hb->nf_naming_code);
+    if (hb->reporting_entity_name != NULL)
+      evel_reporting_entity_name_set(&event->header, hb->reporting_entity_name);
+    if (hb->reporting_entity_id != NULL)
+      evel_reporting_entity_id_set(&event->header, hb->reporting_entity_id);
+    if (hb->source_id != NULL)
+      evel_source_id_set(&event->header, hb->source_id);
+    if (hb->source_name != NULL)
+      evel_source_name_set(&event->header, hb->source_name);
+
+    evel_rc = evel_post_event(hb_header);
+    if (evel_rc != EVEL_SUCCESS)
+    {
+      EVEL_ERROR("Post failed %d (%s)", evel_rc, evel_error_string());
+    }
+  }
+  else
+  {
+    EVEL_ERROR("New Heartbeat failed");
+  }
+  printf("   Processed Heartbeat\n");
+
+  evel_scheduler_job_interval_set(hb_job, hb->interval * 1000);
+  evel_config_watch_release(hb_config_watch, hb);
+}
 
-  jsmn_parser p;
-  char ch[BUFSIZE];
-  int ret = 0;
-  char stringVal[BUFSIZE];
-  char eName[BUFSIZE];
-  int hb_interval;
+/**************************************************************************//**
+ * Load the heartbeat configuration and schedule the heartbeat job on
+ * hb_scheduler.  The scheduler is left for the caller to start.
+ *
+ * @returns 0 on success, or -1 on failure.
+ *****************************************************************************/
+int start_heartbeats(void)
+{
+  HB_CONFIG * hb;
+
+  evel_id_generator_init(&hb_event_ids, "heartbeat", 0);
+
+  /***************************************************************************/
+  /* The configuration is parsed once, and again only when the file changes. */
+  /***************************************************************************/
+  hb_config_watch = evel_new_config_watch(hb_config_file,
+                                          compile_hb_config,
+                                          free_hb_config,
+                                          NULL);
+  if (hb_config_watch == NULL)
+  {
+     printf("Failed to load %s\n", hb_config_file);
+     return -1;
+  }
+
+  /***************************************************************************/
+  /* Heartbeats are sent on the interval boundaries, however long each post  */
+  /* takes.                                                                  */
+  /***************************************************************************/
+  if (hb_scheduler == NULL)
+  {
+     hb_scheduler = evel_new_scheduler(1);
+  }
+  if (hb_scheduler == NULL)
+  {
+     printf("Failed to create the scheduler\n");
+     evel_free_config_watch(hb_config_watch);
+     hb_config_watch = NULL;
+     return -1;
+  }
+  hb = evel_config_watch_acquire(hb_config_watch);
+  hb_job = evel_scheduler_job_add(hb_scheduler, "heartbeat", hb->interval * 1000, HeartbeatJob, NULL);
+  evel_config_watch_release(hb_config_watch, hb);
+  if (hb_job == NULL)
+  {
+     printf("Failed to schedule heartbeats\n");
+     return -1;
+  }
 
-  char event_id1[10] = "heartbeat";
-  char event_id2[15] = {0};
-  int event_id3 = 0;
-  char event_id[BUFSIZE] = {0};
+  return 0;
+}
 
+#ifndef VES_AGENT_PLUGIN
+void *HeartbeatThread(void *threadarg)
+{
   sleep(1);
   printf("Running HB thread \n");
   fflush(stdout);
 
-  while(1)
+  if (start_heartbeats() != 0 ||
+      evel_scheduler_start(hb_scheduler) != EVEL_SUCCESS)
   {
+     printf("Failed to start sending heartbeats. Exiting...\n");
+     exit(1);
+  }
 
-     FILE * file = fopen("hb_config.json", "r");
-
-     memset(js, 0, MAX_BUFFER_SIZE);
-     memset(ch, 0, BUFSIZE);
-
-     while((fgets(ch, (BUFSIZE-1), file)) !=NULL)
-     {
-        strcat(js, ch);
-        memset(ch, 0, BUFSIZE);
-     }
-//   printf("the file content is \n %s \n", js);
-
-     jsmn_init(&p);
-     numToken = jsmn_parse(&p, js, strlen(js), tokens, MAX_TOKENS);
-     printf("Token count-%d\n", numToken);
-
-//   printToken(js,tokens, numToken);
-
-     ret = getStringToken(js, tokens, numToken, "eventName", "tmp_directParameters", eName, BUFSIZE);
-     if (ret != 0)
-     {
-        printf("Missing mandatory parameters - eventName is not there in tmp_directParameters. Exiting...\n");
-        exit(1);
-     }
-
-     ret = getIntToken(js, tokens, numToken, "heartbeatInterval", "tmp_directParameters", &hb_interval);
-     if (ret != 0)
-     {
-        printf("The parameter heartbeatInterval is not defined, defaulted to 60 seconds\n");
-        hb_interval = 60;
-     }
-
-     /***************************************************************************/
-     /* Heartbeat                                                               */
-     /***************************************************************************/
-     memset(event_id, 0, BUFSIZE);
-     memset(event_id2, 0, 15);
-     sprintf(event_id2, "%09d", event_id3++);
-     strcat(event_id, event_id1);
-     strcat(event_id, event_id2);
-
-     event = evel_new_heartbeat_field(hb_interval, eName, event_id);
-     if (event != NULL)
-     {
-       hb_header = (EVENT_HEADER *)event;
-
-       ret = getStringToken(js, tokens, numToken, "eventType", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-       {
-         evel_header_type_set(&event->header, stringVal);
-       }
-
-       struct timeval tv_now;
-       gettimeofday(&tv_now, NULL);
-       unsigned long long epoch_now = tv_now.tv_usec + 1000000 * tv_now.tv_sec;
-
-       evel_start_epoch_set(&event->header, epoch_start);
-       evel_last_epoch_set(&event->header, epoch_now);
-       epoch_start = epoch_now;
-
-       ret = getStringToken(js, tokens, numToken, "nfcNamingCode", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-         evel_nfcnamingcode_set(&event->header, stringVal);
- 
-       ret = getStringToken(js, tokens, numToken, "nfNamingCode", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-         evel_nfnamingcode_set(&event->header, stringVal);
-
-       ret = getStringToken(js, tokens, numToken, "reportingEntityName", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-         evel_reporting_entity_name_set(&event->header, stringVal);
-       else 
-       {
-          printf("Missing mandatory parameters - reportingEntityName is not there in tmp_directParameters\n");
-          printf("Defaulting reportingEntityName to hostname\n");
-       }
-
-       ret = getStringToken(js, tokens, numToken, "reportingEntityId", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-         evel_reporting_entity_id_set(&event->header, stringVal);
-
-       ret = getStringToken(js, tokens, numToken, "sourceId", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-         evel_source_id_set(&event->header, stringVal);
-
-       ret = getStringToken(js, tokens, numToken, "sourceName", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-         evel_source_name_set(&event->header, stringVal);
-       else 
-       {
-          printf("Missing mandatory parameters - sourceName is not there in tmp_directParameters\n");
-          printf("Defaulting sourceName to hostname\n");
-       }
-
-       evel_rc = evel_post_event(hb_header);
-       if (evel_rc != EVEL_SUCCESS)
-       {
-         EVEL_ERROR("Post failed %d (%s)", evel_rc, evel_error_string());
-       }
-    }
-    else
-    {
-      EVEL_ERROR("New Heartbeat failed");
-    }
-    printf("   Processed Heartbeat\n");
-
-    sleep(hb_interval);
+  while(1)
+  {
+     sleep(100);
   }
 }
+#endif
+
+#ifdef VES_AGENT_PLUGIN
+/**************************************************************************//**
+ * Start sending heartbeats in the VES agent.
+ *****************************************************************************/
+int hb_plugin_start(const VES_PLUGIN_HOST * host, const char * config_file)
+{
+  hb_scheduler = host->scheduler;
+  hb_config_file = config_file;
+
+  /***************************************************************************/
+  /* The job runs on the agent's scheduler, which the agent starts, so there */
+  /* is no thread of our own.                                                */
+  /***************************************************************************/
+  return start_heartbeats();
+}
+
+const VES_PLUGIN ves_plugin = {
+  VES_PLUGIN_API_VERSION,
+  "heartbeat",
+  hb_plugin_start
+};
+#endif
@@ -0,0 +1,272 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2018 AT&T Intellectual Property. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <dlfcn.h>
+#include "evel.h"
+#include "ves_plugin.h"
+
+#define DEFAULT_SCHEDULER_WORKERS 4
+#define RING_BUFFER_SIZE 400
+
+/*****************************************************************************/
+/* agent_config.json, kept for as long as the agent runs since the plugins   */
+/* are given their configuration file names from it.                         */
+/*****************************************************************************/
+EVEL_CONFIG * agent_config;
+
+/*****************************************************************************/
+/* The scheduler shared by all plugins.                                      */
+/*****************************************************************************/
+VES_PLUGIN_HOST agent_host;
+
+/**************************************************************************//**
+ * Load a plugin and start it.
+ *****************************************************************************/
+int load_plugin(const char * library, const char * config_file)
+{
+  void * handle;
+  const VES_PLUGIN * plugin;
+
+  handle = dlopen(library, RTLD_NOW | RTLD_LOCAL);
+  if (handle == NULL)
+  {
+    printf("Failed to load plugin %s: %s\n", library, dlerror());
+    return -1;
+  }
+
+  plugin = dlsym(handle, VES_PLUGIN_SYMBOL);
+  if (plugin == NULL)
+  {
+    printf("%s is not a VES plugin\n", library);
+    dlclose(handle);
+    return -1;
+  }
+  if (plugin->api_version != VES_PLUGIN_API_VERSION)
+  {
+    printf("Plugin %s has interface version %d, expected %d\n",
+           library, plugin->api_version, VES_PLUGIN_API_VERSION);
+    dlclose(handle);
+    return -1;
+  }
+
+  /***************************************************************************/
+  /* The plugin is never unloaded, since its threads run until we exit.      */
+  /***************************************************************************/
+  if (plugin->start(&agent_host, config_file) != 0)
+  {
+    printf("Failed to start plugin %s\n", plugin->name);
+    return -1;
+  }
+  printf("Started plugin %s from %s with %s\n", plugin->name, library, config_file);
+
+  return 0;
+}
+
+/**************************************************************************//**
+ * Load and start every plugin listed in agent_config.json.
+ *****************************************************************************/
+int load_plugins(void)
+{
+  const EVEL_CONFIG_NODE * agent;
+  const EVEL_CONFIG_NODE * plugins;
+  const EVEL_CONFIG_NODE * node;
+  const char * library;
+  const char * config_file;
+  int workers;
+  int prometheus_port;
+  int num_plugins = 0;
+
+  agent = evel_config_find(agent_config, NULL, "tmp_agentParameters");
+  if (agent == NULL)
+  {
+    printf("Missing mandatory parameters - tmp_agentParameters is not there\n");
+    return -1;
+  }
+
+  workers = evel_config_int(agent_config, agent, "schedulerWorkers", DEFAULT_SCHEDULER_WORKERS);
+  if (workers <= 0)
+  {
+    printf("The parameter schedulerWorkers is not valid, defaulted to %d\n", DEFAULT_SCHEDULER_WORKERS);
+    workers = DEFAULT_SCHEDULER_WORKERS;
+  }
+  agent_host.scheduler = evel_new_scheduler(workers);
+  if (agent_host.scheduler == NULL)
+  {
+    printf("Failed to create the scheduler\n");
+    return -1;
+  }
+
+  /**************************************************************************/
+  /* Serve the plugins' measurements to Prometheus too, if asked to, before */
+  /* any are encoded.                                                       */
+  /**************************************************************************/
+  prometheus_port = evel_config_int(agent_config, agent, "prometheusPort", 0);
+  if (prometheus_port > 0)
+  {
+    if (prometheus_port > 65535 ||
+        evel_prometheus_start(evel_config_string(agent_config, agent, "prometheusAddress", NULL),
+                              prometheus_port) != EVEL_SUCCESS)
+    {
+      printf("Failed to serve Prometheus metrics on port %d\n", prometheus_port);
+      return -1;
+    }
+    printf("Serving Prometheus metrics on port %d\n", prometheus_port);
+  }
+
+  plugins = evel_config_find(agent_config, agent, "plugins");
+  if (plugins == NULL || plugins->type != EVEL_CONFIG_ARRAY)
+  {
+    printf("Missing mandatory parameters - plugins is not there in tmp_agentParameters\n");
+    return -1;
+  }
+
+  for (node = evel_config_child(agent_config, plugins);
+       node != NULL;
+       node = evel_config_next(agent_config, node))
+  {
+    library = evel_config_string(agent_config, node, "library", NULL);
+    config_file = evel_config_string(agent_config, node, "config", NULL);
+    if (library == NULL || config_file == NULL)
+    {
+      printf("Missing mandatory parameters - each plugin needs a library and a config\n");
+      return -1;
+    }
+    if (load_plugin(library, config_file) != 0)
+    {
+      return -1;
+    }
+    num_plugins++;
+  }
+
+  if (num_plugins == 0)
+  {
+    printf("No plugins to load\n");
+    return -1;
+  }
+
+  if (evel_scheduler_start(agent_host.scheduler) != EVEL_SUCCESS)
+  {
+    printf("Failed to start the scheduler\n");
+    return -1;
+  }
+
+  return 0;
+}
+
+int main(int argc, char** argv)
+{
+  char* fqdn = argv[1];
+  int port = atoi(argv[2]);
+  char* fqdn2 = NULL;
+  int port2 = 0;
+  sigset_t signals;
+  int sig;
+
+  if(argc == 5)
+  {
+     fqdn2 = argv[3];
+     port2 = atoi(argv[4]);
+  }
+
+  if (!((argc == 3) || (argc == 5)))
+  {
+    fprintf(stderr, "Usage: %s <FQDN>|<IP address> <port> <FQDN>|<IP address> <port>  \n", argv[0]);
+    fprintf(stderr, "OR\n");
+    fprintf(stderr, "Usage: %s <FQDN>|<IP address> <port> \n", argv[0]);
+    exit(-1);
+  }
+
+  /**************************************************************************/
+  /* Block the signals we stop on before any threads are started, so that   */
+  /* they are left for us to wait for.                                      */
+  /**************************************************************************/
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+  /**************************************************************************/
+  /* Initialize once for all the plugins, with room in the ring buffer for  */
+  /* all of their events.                                                   */
+  /**************************************************************************/
+  if(evel_initialize(fqdn,                         /* FQDN                  */
+                     port,                         /* Port                  */
+                     fqdn2,                        /* Backup FQDN           */
+                     port2,                        /* Backup port           */
+                     NULL,                         /* optional path         */
+                     NULL,                         /* optional topic        */
+                     RING_BUFFER_SIZE,             /* Ring Buffer size      */
+                     0,                            /* HTTPS?                */
+                     NULL,                         /* cert file             */
+                     NULL,                         /* key  file             */
+                     NULL,                         /* ca   info             */
+                     NULL,                         /* ca   file             */
+                     0,                            /* verify peer           */
+                     0,                            /* verify host           */
+                     "sample1",                    /* Username              */
+                     "sample1",                    /* Password              */
+                     "sample1",                    /* Username2             */
+                     "sample1",                    /* Password2             */
+                     NULL,                         /* Source ip             */
+                     NULL,                         /* Source ip2            */
+                     EVEL_SOURCE_VIRTUAL_MACHINE,  /* Source type           */
+                     "vAgent",                     /* Role                  */
+                     1))                           /* Verbosity             */
+  {
+    fprintf(stderr, "\nFailed to initialize the EVEL library!!!\n");
+    exit(-1);
+  }
+  else
+  {
+    printf("\nInitialization completed\n");
+  }
+
+  agent_config = evel_new_config("agent_config.json");
+  if (agent_config == NULL)
+  {
+    printf("Failed to load agent_config.json. Exiting...\n");
+    exit(1);
+  }
+
+  if (load_plugins() != 0)
+  {
+    printf("Failed to start the plugins. Exiting...\n");
+    if (agent_host.scheduler != NULL)
+    {
+      evel_free_scheduler(agent_host.scheduler);
+    }
+    evel_terminate();
+    exit(1);
+  }
+
+  sigwait(&signals, &sig);
+  printf("Stopping on signal %d\n", sig);
+
+  /**************************************************************************/
+  /* Stop the scheduled jobs before the library they post to.               */
+  /**************************************************************************/
+  evel_scheduler_stop(agent_host.scheduler);
+  evel_terminate();
+  printf("Terminated\n");
+  return 0;
+}
@@ -0,0 +1,78 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2018 AT&T Intellectual Property. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Interface between the VES agent and the reporters it loads as plugins.
+ *
+ * A reporter built as a plugin is a shared object exporting a ::VES_PLUGIN
+ * named ::VES_PLUGIN_SYMBOL.  The agent initializes the EVEL library once,
+ * so every plugin posts through the same event handler, ring buffer and
+ * collector connection, and runs their periodic jobs on one scheduler.
+ *
+ * Plugins link with the shared EVEL library, and with -Bsymbolic so that
+ * their own functions and globals are not confused with another plugin's of
+ * the same name.
+ ****************************************************************************/
+
+#ifndef VES_PLUGIN_INCLUDED
+#define VES_PLUGIN_INCLUDED
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Version of this interface, which a plugin must have been built with.      */
+/*****************************************************************************/
+#define VES_PLUGIN_API_VERSION 1
+
+/*****************************************************************************/
+/* Name of the ::VES_PLUGIN exported by each plugin.                         */
+/*****************************************************************************/
+#define VES_PLUGIN_SYMBOL "ves_plugin"
+
+/**************************************************************************//**
+ * What the agent shares with its plugins.
+ *****************************************************************************/
+typedef struct ves_plugin_host {
+  EVEL_SCHEDULER * scheduler;
+} VES_PLUGIN_HOST;
+
+/**************************************************************************//**
+ * Start a plugin, once the EVEL library has been initialized.  The plugin
+ * loads its configuration and adds its jobs to the host's scheduler, which
+ * the agent starts, and starts any threads of its own, then returns.  Any
+ * failure is reported by the return code rather than by exiting.  Plugins
+ * run until the agent exits.
+ *
+ * @param host          What the agent shares.
+ * @param config_file   The plugin's configuration file.
+ *
+ * @returns 0 on success, or -1 if the plugin could not be started.
+ *****************************************************************************/
+typedef int (*VES_PLUGIN_START_FN)(const VES_PLUGIN_HOST * host,
+                                   const char * config_file);
+
+/**************************************************************************//**
+ * A plugin.
+ *****************************************************************************/
+typedef struct ves_plugin {
+  int api_version;
+  const char * name;
+  VES_PLUGIN_START_FN start;
+} VES_PLUGIN;
+
+#endif
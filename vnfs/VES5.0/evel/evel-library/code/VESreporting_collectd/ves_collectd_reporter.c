@@ -0,0 +1,504 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2018 AT&T Intellectual Property. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <string.h>
+#include "evel.h"
+#ifdef VES_AGENT_PLUGIN
+#include "ves_plugin.h"
+#endif
+
+#define BUFSIZE 128
+#define RECEIVE_TIMEOUT_MS 1000
+#define DEFAULT_MEASUREMENT_INTERVAL 10
+
+void *CollectdThread(void *threadarg);
+int start_collectd(void);
+
+/**************************************************************************//**
+ * collectd parameters, compiled from collectd_config.json.  The strings
+ * point into the parsed file.
+ *****************************************************************************/
+typedef struct collectd_config {
+  const char * event_name;
+  const char * event_type;
+  const char * nfc_naming_code;
+  const char * nf_naming_code;
+  const char * reporting_entity_name;
+  const char * reporting_entity_id;
+  const char * udp_address;
+  int udp_port;
+  int interval;
+} COLLECTD_CONFIG;
+
+/**************************************************************************//**
+ * The batch being built for one interval, and the interval it covers.
+ *****************************************************************************/
+typedef struct collectd_report {
+  const COLLECTD_CONFIG * cfg;
+  EVENT_HEADER * batch;
+  unsigned long long start;
+  unsigned long long end;
+  int num_events;
+} COLLECTD_REPORT;
+
+EVEL_ID_GENERATOR collectd_event_ids;
+
+/*****************************************************************************/
+/* collectd_config.json, reloaded on change.                                 */
+/*****************************************************************************/
+const char * collectd_config_file = "collectd_config.json";
+EVEL_CONFIG_WATCH * collectd_config_watch;
+
+/*****************************************************************************/
+/* The sockets values are received on, and the settings they were opened     */
+/* with.                                                                     */
+/*****************************************************************************/
+EVEL_COLLECTD * collectd_receiver = NULL;
+char collectd_source[BUFSIZE];
+
+/**************************************************************************//**
+ * Compile collectd_config.json.
+ *****************************************************************************/
+void * compile_collectd_config(const EVEL_CONFIG * config, void * context)
+{
+  const EVEL_CONFIG_NODE * direct;
+  const EVEL_CONFIG_NODE * indirect;
+  COLLECTD_CONFIG * cfg;
+
+  direct = evel_config_find(config, NULL, "tmp_directParameters");
+  indirect = evel_config_find(config, NULL, "tmp_indirectParameters");
+  if (direct == NULL)
+  {
+    printf("Missing mandatory parameters - tmp_directParameters is not there\n");
+    return NULL;
+  }
+
+  cfg = calloc(1, sizeof(COLLECTD_CONFIG));
+  if (cfg == NULL)
+  {
+    return NULL;
+  }
+
+  cfg->event_name = evel_config_string(config, direct, "eventName", NULL);
+  if (cfg->event_name == NULL)
+  {
+    printf("Missing mandatory parameters - eventName is not there in tmp_directParameters\n");
+    free(cfg);
+    return NULL;
+  }
+
+  cfg->interval = evel_config_int(config, direct, "measurementInterval", 0);
+  if (cfg->interval <= 0)
+  {
+    printf("The parameter measurementInterval is not defined, defaulted to %d seconds\n",
+           DEFAULT_MEASUREMENT_INTERVAL);
+    cfg->interval = DEFAULT_MEASUREMENT_INTERVAL;
+  }
+
+  cfg->event_type = evel_config_string(config, direct, "eventType", NULL);
+  cfg->nfc_naming_code = evel_config_string(config, direct, "nfcNamingCode", NULL);
+  cfg->nf_naming_code = evel_config_string(config, direct, "nfNamingCode", NULL);
+  cfg->reporting_entity_name = evel_config_string(config, direct, "reportingEntityName", NULL);
+  cfg->reporting_entity_id = evel_config_string(config, direct, "reportingEntityId", NULL);
+
+  /***************************************************************************/
+  /* collectd's network plugin sends to port 25826 unless told otherwise.    */
+  /***************************************************************************/
+  cfg->udp_port = EVEL_COLLECTD_PORT;
+  if (indirect != NULL)
+  {
+    cfg->udp_address = evel_config_string(config, indirect, "tmp_collectdUdpAddress", NULL);
+    cfg->udp_port = evel_config_int(config, indirect, "tmp_collectdUdpPort", EVEL_COLLECTD_PORT);
+  }
+  if (cfg->udp_port <= 0 || cfg->udp_port > 65535)
+  {
+    printf("Invalid tmp_collectdUdpPort %d in tmp_indirectParameters\n", cfg->udp_port);
+    free(cfg);
+    return NULL;
+  }
+
+  return cfg;
+}
+
+/**************************************************************************//**
+ * Free a compiled collectd_config.json.
+ *****************************************************************************/
+void free_collectd_config(void * compiled)
+{
+  free(compiled);
+}
+
+/**************************************************************************//**
+ * Create the measurement for a host collectd has sent values for, and add
+ * it to the interval's batch.  The host is the measurement's source.
+ *****************************************************************************/
+EVENT_MEASUREMENT * new_collectd_measurement(void * context, const char * host)
+{
+  COLLECTD_REPORT * report = context;
+  const COLLECTD_CONFIG * cfg = report->cfg;
+  EVENT_MEASUREMENT * measurement;
+  char event_id[EVEL_ID_MAX_LEN + 1] = {0};
+
+  if (report->batch == NULL)
+  {
+    evel_id_generator_next(&collectd_event_ids, event_id, sizeof(event_id));
+    report->batch = evel_new_batch(cfg->event_name, event_id);
+    if (report->batch == NULL)
+    {
+      printf("Batch event creation failed (%s)\n", evel_error_string());
+      return NULL;
+    }
+  }
+
+  evel_id_generator_next(&collectd_event_ids, event_id, sizeof(event_id));
+  measurement = evel_new_measurement(cfg->interval, cfg->event_name, event_id);
+  if (measurement == NULL)
+  {
+    printf("Measurement event creation failed (%s)\n", evel_error_string());
+    return NULL;
+  }
+
+  if (cfg->event_type != NULL)
+    evel_measurement_type_set(measurement, cfg->event_type);
+  if (cfg->nfc_naming_code != NULL)
+    evel_nfcnamingcode_set(&measurement->header, cfg->nfc_naming_code);
+  if (cfg->nf_naming_code != NULL)
+    evel_nfnamingcode_set(&measurement->header, cfg->nf_naming_code);
+  if (cfg->reporting_entity_name != NULL)
+    evel_reporting_entity_name_set(&measurement->header, cfg->reporting_entity_name);
+  if (cfg->reporting_entity_id != NULL)
+    evel_reporting_entity_id_set(&measurement->header, cfg->reporting_entity_id);
+  evel_source_name_set(&measurement->header, host);
+  evel_start_epoch_set(&measurement->header, report->start);
+  evel_last_epoch_set(&measurement->header, report->end);
+
+  evel_batch_add_event(report->batch, &measurement->header);
+  report->num_events++;
+
+  return measurement;
+}
+
+/**************************************************************************//**
+ * Post what collectd has sent in the interval, as one batch with a
+ * measurement for each host.
+ *****************************************************************************/
+void report_collectd(EVEL_COLLECTD * collectd,
+                     const COLLECTD_CONFIG * cfg,
+                     unsigned long long start,
+                     unsigned long long end)
+{
+  EVEL_ERR_CODES evel_rc = EVEL_SUCCESS;
+  COLLECTD_REPORT report;
+
+  memset(&report, 0, sizeof(report));
+  report.cfg = cfg;
+  report.start = start;
+  report.end = end;
+
+  evel_collectd_report(collectd, new_collectd_measurement, &report);
+  if (report.batch == NULL)
+  {
+    return;
+  }
+
+  evel_rc = evel_post_event(report.batch);
+  if (evel_rc == EVEL_SUCCESS)
+    printf("   Processed collectd measurements for %d hosts\n", report.num_events);
+  else
+    printf("Post failed %d (%s)\n", evel_rc, evel_error_string());
+}
+
+/**************************************************************************//**
+ * Open the UDP sockets given in the configuration.
+ *****************************************************************************/
+EVEL_COLLECTD * open_collectd_receiver(const COLLECTD_CONFIG * cfg)
+{
+  EVEL_COLLECTD * collectd;
+
+  collectd = evel_new_collectd();
+  if (collectd == NULL)
+  {
+     return NULL;
+  }
+
+  if (evel_collectd_udp(collectd, cfg->udp_address, cfg->udp_port) != EVEL_SUCCESS)
+  {
+     printf("Error while binding UDP port %d (%s)\n", cfg->udp_port, evel_error_string());
+     evel_free_collectd(collectd);
+     return NULL;
+  }
+
+  return collectd;
+}
+
+/**************************************************************************//**
+ * Open the UDP sockets given in the configuration, unless they are open
+ * already, closing any opened for an earlier configuration.
+ *
+ * @returns 0 on success, or -1 if they could not be opened, in which case
+ *          nothing is left open and the next call tries again.
+ *****************************************************************************/
+int open_collectd_source(const COLLECTD_CONFIG * cfg)
+{
+  char new_source[BUFSIZE];
+
+  snprintf(new_source, sizeof(new_source), "%s|%d",
+           cfg->udp_address ? cfg->udp_address : "", cfg->udp_port);
+  if (collectd_receiver != NULL && strcmp(collectd_source, new_source) == 0)
+  {
+     return 0;
+  }
+
+  evel_free_collectd(collectd_receiver);
+  collectd_receiver = open_collectd_receiver(cfg);
+  if (collectd_receiver == NULL)
+  {
+     printf("Error while opening collectd sockets\n");
+     return -1;
+  }
+  strcpy(collectd_source, new_source);
+
+  return 0;
+}
+
+/**************************************************************************//**
+ * Load collectd_config.json and open the sockets it gives, so that
+ * CollectdThread() has only to receive on them.
+ *
+ * @returns 0 on success, or -1 on failure.
+ *****************************************************************************/
+int start_collectd(void)
+{
+  COLLECTD_CONFIG * cfg;
+  int rc;
+
+  /***************************************************************************/
+  /* The configuration is parsed once, and again only when the file changes. */
+  /***************************************************************************/
+  collectd_config_watch = evel_new_config_watch(collectd_config_file,
+                                                compile_collectd_config,
+                                                free_collectd_config,
+                                                NULL);
+  if (collectd_config_watch == NULL)
+  {
+     printf("Failed to load %s\n", collectd_config_file);
+     return -1;
+  }
+
+  cfg = evel_config_watch_acquire(collectd_config_watch);
+  rc = open_collectd_source(cfg);
+  evel_config_watch_release(collectd_config_watch, cfg);
+  if (rc != 0)
+  {
+     evel_free_config_watch(collectd_config_watch);
+     collectd_config_watch = NULL;
+  }
+
+  return rc;
+}
+
+void *CollectdThread(void *threadarg)
+{
+  COLLECTD_CONFIG * cfg;
+  unsigned long long now;
+  unsigned long long start;
+  unsigned long long deadline;
+  int timeout_ms;
+
+  printf("Running collectd thread \n");
+  fflush(stdout);
+
+  start = evel_time_now_usec(EVEL_CLOCK_EXACT);
+  deadline = 0;
+
+  /***************************************************************************/
+  /* Values are received as they arrive, and what has arrived is reported    */
+  /* once an interval.  The sockets are reopened when the configuration      */
+  /* changes them, and retried until they open if that fails.                */
+  /***************************************************************************/
+  while(1)
+  {
+     evel_config_watch_check(collectd_config_watch);
+     cfg = evel_config_watch_acquire(collectd_config_watch);
+
+     if (open_collectd_source(cfg) != 0)
+     {
+        evel_config_watch_release(collectd_config_watch, cfg);
+        sleep(1);
+        continue;
+     }
+
+     now = evel_time_now_usec(EVEL_CLOCK_EXACT);
+     if (deadline == 0)
+     {
+        deadline = now + cfg->interval * 1000000ULL;
+     }
+     timeout_ms = (deadline <= now) ? 0 : (deadline - now + 999) / 1000;
+     if (timeout_ms > RECEIVE_TIMEOUT_MS)
+     {
+        timeout_ms = RECEIVE_TIMEOUT_MS;
+     }
+
+     if (evel_collectd_wait(collectd_receiver, timeout_ms) != EVEL_SUCCESS)
+     {
+        printf("Failed to receive collectd (%s)\n", evel_error_string());
+        sleep(1);
+     }
+
+     /************************************************************************/
+     /* The next interval follows on from this one, unless we have fallen    */
+     /* behind by more than an interval.                                     */
+     /************************************************************************/
+     now = evel_time_now_usec(EVEL_CLOCK_EXACT);
+     if (now >= deadline)
+     {
+        report_collectd(collectd_receiver, cfg, start, now);
+        start = now;
+        deadline += cfg->interval * 1000000ULL;
+        if (deadline <= now)
+        {
+           deadline = now + cfg->interval * 1000000ULL;
+        }
+     }
+
+     evel_config_watch_release(collectd_config_watch, cfg);
+  }
+}
+
+#ifndef VES_AGENT_PLUGIN
+int main(int argc, char** argv)
+{
+  char* fqdn = argv[1];
+  int port = atoi(argv[2]);
+  int rc;
+  pthread_t collectd_thread;
+  char* fqdn2 = NULL;
+  int port2 = 0;
+
+  if(argc == 5)
+  {
+     fqdn2 = argv[3];
+     port2 = atoi(argv[4]);
+  }
+
+  if (!((argc == 3) || (argc == 5)))
+  {
+    fprintf(stderr, "Usage: %s <FQDN>|<IP address> <port> <FQDN>|<IP address> <port>  \n", argv[0]);
+    fprintf(stderr, "OR\n");
+    fprintf(stderr, "Usage: %s <FQDN>|<IP address> <port> \n", argv[0]);
+    exit(-1);
+  }
+
+  /**************************************************************************/
+  /* Initialize                                                             */
+  /**************************************************************************/
+  if(evel_initialize(fqdn,                         /* FQDN                  */
+                     port,                         /* Port                  */
+                     fqdn2,                        /* Backup FQDN           */
+                     port2,                        /* Backup port           */
+                     NULL,                         /* optional path         */
+                     NULL,                         /* optional topic        */
+                     100,                          /* Ring Buffer size      */
+                     0,                            /* HTTPS?                */
+                     NULL,                         /* cert file             */
+                     NULL,                         /* key  file             */
+                     NULL,                         /* ca   info             */
+                     NULL,                         /* ca   file             */
+                     0,                            /* verify peer           */
+                     0,                            /* verify host           */
+                     "sample1",                    /* Username              */
+                     "sample1",                    /* Password              */
+                     "sample1",                    /* Username2             */
+                     "sample1",                    /* Password2             */
+                     NULL,                         /* Source ip             */
+                     NULL,                         /* Source ip2            */
+                     EVEL_SOURCE_VIRTUAL_MACHINE,  /* Source type           */
+                     "vCollectd",                  /* Role                  */
+                     1))                           /* Verbosity             */
+  {
+    fprintf(stderr, "\nFailed to initialize the EVEL library!!!\n");
+    exit(-1);
+  }
+  else
+  {
+    printf("\nInitialization completed\n");
+  }
+
+  evel_id_generator_init(&collectd_event_ids, "collectd", 0);
+
+  if (start_collectd() != 0)
+  {
+    printf("Failed to start reporting collectd. Exiting...\n");
+    exit(1);
+  }
+
+  printf("Main:Creating thread \n");
+  rc = pthread_create(&collectd_thread, NULL, CollectdThread, NULL);
+  if (rc)
+  {
+    printf("ERROR; return code from pthread_create() is %d\n", rc);
+    exit(-1);
+  }
+  printf("Main:Created collectd thread \n");
+
+  pthread_join(collectd_thread, NULL);
+
+  evel_terminate();
+  printf("Terminated\n");
+  return 0;
+}
+#endif
+
+#ifdef VES_AGENT_PLUGIN
+/**************************************************************************//**
+ * Start reporting collectd's metrics in the VES agent.  The metrics are
+ * received by a thread of their own rather than by a scheduled job.
+ *****************************************************************************/
+int collectd_plugin_start(const VES_PLUGIN_HOST * host, const char * config_file)
+{
+  pthread_attr_t attr;
+  pthread_t collectd_thread;
+
+  collectd_config_file = config_file;
+
+  evel_id_generator_init(&collectd_event_ids, "collectd", 0);
+
+  if (start_collectd() != 0)
+  {
+    return -1;
+  }
+
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  if (pthread_create(&collectd_thread, &attr, CollectdThread, NULL) != 0)
+  {
+    printf("Failed to create the collectd thread\n");
+    return -1;
+  }
+  return 0;
+}
+
+const VES_PLUGIN ves_plugin = {
+  VES_PLUGIN_API_VERSION,
+  "collectd",
+  collectd_plugin_start
+};
+#endif
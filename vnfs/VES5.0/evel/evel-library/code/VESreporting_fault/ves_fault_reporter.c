@@ -15,6 +15,7 @@
  *
  ****************************************************************************/
 
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -23,28 +24,112 @@
 #include <netdb.h>
 #include <sys/time.h>
 #include <sys/stat.h>
-#include "jsmn.h"
 #include "evel.h"
+#ifdef VES_AGENT_PLUGIN
+#include "ves_plugin.h"
+#endif
 
 #define BUFSIZE 128
-#define MAX_BUFFER_SIZE 4096
-#define MAX_TOKENS 1000
 #define MAX_INTERFACES 40
+#define MAX_COMMANDS 32
+#define MAX_PROBE_WORKERS 8
+#define PROBE_TIMEOUT_MS 10000
+#define MAX_FAULT_WORKERS 4
+#define CONFIG_CHECK_INTERVAL 10
+#define RULE_SAMPLE_PERIOD_MS 1000
 
 void *FaultThread(void *threadarg);
-void *FaultThread01(void *threadarg);
-void *FaultThread02(void *threadarg);
-void *FaultThread03(void *threadarg);
+int start_faults(void);
+
+/**************************************************************************//**
+ * A command from flt_config.json, compiled with $tmp_device as its only
+ * variable.
+ *****************************************************************************/
+typedef struct flt_command {
+  const char * key;
+  EVEL_COMMAND command;
+} FLT_COMMAND;
+
+/**************************************************************************//**
+ * The parameters of an alarm being set or cleared.
+ *****************************************************************************/
+typedef struct flt_alarm {
+  const char * specific_problem;
+  const char * alarm_condition;
+  int severity;
+} FLT_ALARM;
+
+/**************************************************************************//**
+ * One tmp_faultInstance from flt_config.json.  An instance whose
+ * alarmInterfaceA is $tmp_device is checked on each link; any other runs
+ * its commands once, and raises its fault when the first prints 1.
+ *****************************************************************************/
+typedef struct flt_instance {
+  const char * name;
+  const char * event_name;
+  const char * event_category;
+  const char * alarm_interface;
+  int per_link;
+  int source_type;
+  int interval;
+  int low_water_mark;
+  int num_init_commands;
+  FLT_COMMAND init_commands[MAX_COMMANDS];
+  int num_commands;
+  FLT_COMMAND commands[MAX_COMMANDS];
+  FLT_ALARM set;
+  FLT_ALARM clear;
+} FLT_INSTANCE;
+
+/**************************************************************************//**
+ * One entry of tmp_thresholdRules.  A rule whose metric names $tmp_device
+ * is added once for each link.
+ *****************************************************************************/
+typedef struct flt_rule {
+  const char * name;
+  const char * event_name;
+  const char * description;
+  int per_link;
+  EVEL_COMMAND metric;
+  EVEL_COMMAND denominator;
+  int type;
+  int direction;
+  double set_threshold;
+  double clear_threshold;
+  int set_after_ms;
+  int clear_after_ms;
+  int severity;
+  int alert_type;
+} FLT_RULE;
+
+/**************************************************************************//**
+ * Fault parameters, compiled from flt_config.json.  The strings point into
+ * the parsed file, or to the hostname.
+ *****************************************************************************/
+typedef struct flt_config {
+  const char * event_type;
+  const char * nfc_naming_code;
+  const char * nf_naming_code;
+  const char * reporting_entity_name;
+  const char * reporting_entity_id;
+  const char * source_id;
+  const char * source_name;
+  int priority;
+  int vf_status;
+  int num_links;
+  const char * links[MAX_INTERFACES];
+  int num_instances;
+  FLT_INSTANCE * instances;
+  int num_rules;
+  FLT_RULE * rules;
+  int serial;
+} FLT_CONFIG;
 
 typedef struct dummy_vpp_metrics_struct {
-  int curr_bytes_in;
-  int curr_bytes_out;
-  int curr_packets_in;
-  int curr_packets_out;
-  int last_bytes_in;
-  int last_bytes_out;
-  int last_packets_in;
-  int last_packets_out;
+  EVEL_COUNTER bytes_in;
+  EVEL_COUNTER bytes_out;
+  EVEL_COUNTER packets_in;
+  EVEL_COUNTER packets_out;
 } vpp_metrics_struct;
 
 typedef struct linkstat {
@@ -58,106 +143,223 @@ typedef struct linkstat {
 
 }LINKSTAT;
 
-//vpp_metrics_struct meas_intfstat[MAX_INTERFACES];
-//LINKSTAT meas_linkstat[MAX_INTERFACES];
-//int request_rate=0;
-vpp_metrics_struct fault_intfstat[MAX_INTERFACES];
-LINKSTAT fault_linkstat[MAX_INTERFACES];
+/**************************************************************************//**
+ * The state of one fault instance, kept between runs of its scheduled job
+ * and across reloads of flt_config.json.  The commands for every link are
+ * run as one batch, with the result for each link and command at
+ * results[link][command].
+ *****************************************************************************/
+typedef struct flt_job {
+  char * name;
+  EVEL_SCHEDULER_JOB * job;
+  int initialized;
+  vpp_metrics_struct intfstat[MAX_INTERFACES];
+  LINKSTAT linkstat[MAX_INTERFACES];
+  const char * link_names[MAX_INTERFACES];
+  EVEL_IF_SNAPSHOT snapshot;
+  EVEL_PROBE probes[MAX_INTERFACES * MAX_COMMANDS];
+  char results[MAX_INTERFACES][MAX_COMMANDS][BUFSIZE];
+  int fault_raised;
+  unsigned long long last_epoch;
+  struct flt_job * next;
+} FLT_JOB;
+
+/**************************************************************************//**
+ * A counter of one link, sampled for the threshold rules.
+ *****************************************************************************/
+typedef struct flt_sample {
+  const EVEL_IF_SNAPSHOT * snapshot;
+  const char * link;
+  size_t offset;
+} FLT_SAMPLE;
+
+/**************************************************************************//**
+ * What a threshold rule's alerts are about, copied so that they outlive the
+ * flt_config.json the rule came from.
+ *****************************************************************************/
+typedef struct flt_rule_target {
+  char event_name[BUFSIZE];
+  char link[EVEL_IF_NAME_MAX + 1];
+} FLT_RULE_TARGET;
+
+/*****************************************************************************/
+/* Link counters the threshold rules can read, as "<link>.<name>", each      */
+/* sampled as a per-second rate.                                             */
+/*****************************************************************************/
+static const struct {
+  const char * name;
+  size_t offset;
+} link_counters[] = {
+  { "bytesIn", offsetof(EVEL_IF_STATS, rx_bytes) },
+  { "bytesOut", offsetof(EVEL_IF_STATS, tx_bytes) },
+  { "packetsIn", offsetof(EVEL_IF_STATS, rx_packets) },
+  { "packetsOut", offsetof(EVEL_IF_STATS, tx_packets) },
+  { "errorsIn", offsetof(EVEL_IF_STATS, rx_errors) },
+  { "errorsOut", offsetof(EVEL_IF_STATS, tx_errors) },
+  { "droppedIn", offsetof(EVEL_IF_STATS, rx_dropped) },
+  { "droppedOut", offsetof(EVEL_IF_STATS, tx_dropped) }
+};
+#define NUM_LINK_COUNTERS (sizeof(link_counters) / sizeof(link_counters[0]))
+
+/**************************************************************************//**
+ * The threshold rules from one version of flt_config.json, evaluated on
+ * every sample of the links' counters rather than on each instance's
+ * tmp_faultCheckInterval.
+ *****************************************************************************/
+typedef struct flt_rules {
+  EVEL_RULES * rules;
+  EVEL_SAMPLER * sampler;
+  EVEL_IF_SNAPSHOT snapshot;
+  char links[MAX_INTERFACES][EVEL_IF_NAME_MAX + 1];
+  FLT_SAMPLE samples[MAX_INTERFACES][NUM_LINK_COUNTERS];
+  int num_targets;
+  FLT_RULE_TARGET * targets;
+} FLT_RULES;
 
 unsigned long long epoch_start = 0;
 
-int format_val_params(KEYVALRESULT * keyValArray, int numElements, const char *replace, const char *search)
+/*****************************************************************************/
+/* Event IDs are shared by all fault threads so that they never collide.     */
+/*****************************************************************************/
+EVEL_ID_GENERATOR fault_event_ids;
+
+/*****************************************************************************/
+/* flt_config.json is shared by all fault threads, and reloaded on change.   */
+/*****************************************************************************/
+const char * flt_config_file = "flt_config.json";
+EVEL_CONFIG_WATCH * flt_config_watch;
+char fault_hostname[BUFSIZE];
+
+/*****************************************************************************/
+/* The only variable in the commands.                                        */
+/*****************************************************************************/
+static const char * const command_variables[] = { "tmp_device" };
+
+/*****************************************************************************/
+/* Each fault instance is checked by its own scheduled job, added when the   */
+/* instance first appears in flt_config.json.  The scheduler is the VES      */
+/* agent's when running as a plugin.                                         */
+/*****************************************************************************/
+EVEL_SCHEDULER * flt_scheduler = NULL;
+FLT_JOB * flt_jobs;
+
+/*****************************************************************************/
+/* The running threshold rules, rebuilt when flt_config.json changes.        */
+/*****************************************************************************/
+FLT_RULES * flt_rules;
+int flt_rules_serial = -1;
+
+/**************************************************************************//**
+ * Run the commands for each link, several at once.  A probe that could not
+ * be run, failed or timed out is left with an empty result and a state
+ * other than EVEL_PROBE_SUCCESS.
+ *****************************************************************************/
+void runCommands(const FLT_COMMAND * commands, int numCommands, const char ** links, int linkCount, const EVEL_IF_SNAPSHOT * snapshot, EVEL_PROBE * probes, char results[][MAX_COMMANDS][BUFSIZE], const char * tag)
 {
-     char *sp;
-     int i =0;
-     int search_len;
-     int replace_len;
-     int tail_len;
+  EVEL_PROBE_STATS stats;
+  EVEL_PROBE * probe;
+  int numProbes = 0;
+  int i;
+  int j;
 
-     for (i=0; i<numElements; i++)
-     {
-        if ((sp = strstr(keyValArray[i].valStr, search)) == NULL) {
-           printf("\n String not found\n");
-           return 1; //Error search string not found
-        }
-        
-        search_len = strlen(search);
-        replace_len = strlen(replace);
-        tail_len = strlen(sp+search_len);
-        memmove(sp+replace_len,sp+search_len,tail_len+1);
-        memcpy(sp, replace, replace_len);
-//       printf("\n Changed value for i=%d is %s", i, keyValArray[i].valStr);
-     }
-     return 0; //search and replace is successful
+  for(i = 0; i < linkCount; i++)
+  {
+      for(j = 0; j < numCommands; j++)
+      {
+          probe = &probes[numProbes++];
+          memset(probe, 0, sizeof(EVEL_PROBE));
+          probe->command = &commands[j].command;
+          probe->values = &links[i];
+          probe->result = results[i][j];
+          probe->result_size = BUFSIZE;
+          probe->state = EVEL_PROBE_FAILED;
+          probe->result[0] = '\0';
+      }
+  }
+
+  if (evel_probe_run(probes, numProbes, snapshot, MAX_PROBE_WORKERS, PROBE_TIMEOUT_MS, &stats) != EVEL_SUCCESS)
+  {
+      printf("%s::Failed to run commands (%s)\n", tag, evel_error_string());
+      return;
+  }
+  printf("%s::Ran %d commands, %d natively, in %llums; %d failed, %d timed out\n",
+         tag, stats.num_probes, stats.num_native, stats.runtime / 1000, stats.num_failed, stats.num_timed_out);
 }
 
-void runCommands(KEYVALRESULT * commandArray, int numCommands)
+/**************************************************************************//**
+ * Read the interface counters if any of the commands need them.
+ *
+ * @returns The snapshot, or NULL if the commands are to run in the shell.
+ *****************************************************************************/
+const EVEL_IF_SNAPSHOT * read_if_snapshot(EVEL_IF_SNAPSHOT * snapshot, const FLT_COMMAND * commands, int numCommands)
 {
-
-  char buf[BUFSIZE];            /* buffer used to store VPP metrics     */
-  FILE *fp;                     /* file descriptor to pipe cmd to shell */
   int i;
 
   for(i = 0; i < numCommands; i++)
   {
-      memset(buf, 0, BUFSIZE);
-
-      // Open a pipe and read VPP values
-      if ((fp = popen(commandArray[i].valStr, "r")) == NULL) {
-          printf("Error opening pipe!\n");
-          return;
-      }
-
-      while (fgets(buf, BUFSIZE, fp) != NULL);
-      // printf("\n the vpp value is %d\n", atoi(buf));
-      strcpy(commandArray[i].resultStr, buf);
-
-      if(pclose(fp))  {
-          printf("Command not found or exited with error status\n");
-          return;
+      if (commands[i].command.type == EVEL_COMMAND_IF_STATS)
+      {
+          if (evel_ifstats_read_netlink(snapshot) == EVEL_SUCCESS)
+          {
+              return snapshot;
+          }
+          printf("Failed to read interface counters (%s)\n", evel_error_string());
+          return NULL;
       }
-   }
-   //for(i = 0; i < numCommands; i++)
-   //   printf("\n commandArray[%d].resultStr is- %s\n", i, commandArray[i].resultStr);
+  }
+  return NULL;
 }
 
-
-void copy_vpp_metic_data(vpp_metrics_struct *intfstats, KEYVALRESULT * cmdArray, int numCmds, int linkNum)
+/**************************************************************************//**
+ * Update a link's counters from the results of its commands.  A counter
+ * whose command did not succeed, or printed no number, keeps its previous
+ * reading rather than being taken as reset to zero.
+ *
+ * @returns The number of commands whose result could not be used.
+ *****************************************************************************/
+int copy_vpp_metic_data(vpp_metrics_struct *intfstats, const FLT_COMMAND * cmdArray, const EVEL_PROBE * probes, char results[][BUFSIZE], int numCmds, int linkNum)
 {
     int i;
+    int numFailed = 0;
+    char * end;
+    unsigned long long now = evel_time_monotonic_usec();
 
-    // Store the current metric in the last metric
-    intfstats[linkNum].last_bytes_in = intfstats[linkNum].curr_bytes_in;
-    intfstats[linkNum].last_bytes_out = intfstats[linkNum].curr_bytes_out;
-    intfstats[linkNum].last_packets_in = intfstats[linkNum].curr_packets_in;
-    intfstats[linkNum].last_packets_out = intfstats[linkNum].curr_packets_out;
-
-    // Store metrics read from the vNIC in the current
+    // Update the counters with the metrics read from the vNIC; they keep
+    // the previous reading to work out the deltas
     for(i=0; i<numCmds; i++)
     {
-       if((strcmp(cmdArray[i].keyStr, "tmp_t0BytesIn") == 0) ||
-          (strcmp(cmdArray[i].keyStr, "tmp_t1BytesIn") == 0))
-          intfstats[linkNum].curr_bytes_in = atoi(cmdArray[i].resultStr);
-
-       if((strcmp(cmdArray[i].keyStr, "tmp_t0BytesOut") == 0) ||
-          (strcmp(cmdArray[i].keyStr, "tmp_t1BytesOut") == 0))
-          intfstats[linkNum].curr_bytes_out = atoi(cmdArray[i].resultStr);
-
-       if((strcmp(cmdArray[i].keyStr, "tmp_t0PacketsIn") == 0) ||
-          (strcmp(cmdArray[i].keyStr, "tmp_t1PacketsIn") == 0))
-          intfstats[linkNum].curr_packets_in = atoi(cmdArray[i].resultStr);
-
-       if((strcmp(cmdArray[i].keyStr, "tmp_t0PacketsOut") == 0) ||
-          (strcmp(cmdArray[i].keyStr, "tmp_t1PacketsOut") == 0))
-          intfstats[linkNum].curr_packets_out = atoi(cmdArray[i].resultStr);
+       if (probes[i].state != EVEL_PROBE_SUCCESS)
+       {
+          numFailed++;
+          continue;
+       }
+       strtoull(results[i], &end, 10);
+       if (end == results[i])
+       {
+          numFailed++;
+          continue;
+       }
+
+       if((strcmp(cmdArray[i].key, "tmp_t0BytesIn") == 0) ||
+          (strcmp(cmdArray[i].key, "tmp_t1BytesIn") == 0))
+          evel_counter_update(&intfstats[linkNum].bytes_in, strtoull(results[i], NULL, 10), now);
+
+       if((strcmp(cmdArray[i].key, "tmp_t0BytesOut") == 0) ||
+          (strcmp(cmdArray[i].key, "tmp_t1BytesOut") == 0))
+          evel_counter_update(&intfstats[linkNum].bytes_out, strtoull(results[i], NULL, 10), now);
+
+       if((strcmp(cmdArray[i].key, "tmp_t0PacketsIn") == 0) ||
+          (strcmp(cmdArray[i].key, "tmp_t1PacketsIn") == 0))
+          evel_counter_update(&intfstats[linkNum].packets_in, strtoull(results[i], NULL, 10), now);
+
+       if((strcmp(cmdArray[i].key, "tmp_t0PacketsOut") == 0) ||
+          (strcmp(cmdArray[i].key, "tmp_t1PacketsOut") == 0))
+          evel_counter_update(&intfstats[linkNum].packets_out, strtoull(results[i], NULL, 10), now);
     }
-    // printf("intfstats[%d].curr_bytes_in = %d\n", linkNum, intfstats[linkNum].curr_bytes_in);
-    // printf("intfstats[%d].curr_bytes_out = %d\n", linkNum, intfstats[linkNum].curr_bytes_out);
-    // printf("intfstats[%d].curr_packets_in = %d\n", linkNum, intfstats[linkNum].curr_packets_in);
-    // printf("intfstats[%d].curr_packets_out = %d\n", linkNum, intfstats[linkNum].curr_packets_out);
+    return numFailed;
 }
 
-int get_severity(char * inStr)
+int get_severity(const char * inStr)
 {
    int result = -1;
 
@@ -175,7 +377,7 @@ int get_severity(char * inStr)
   return result;
 }
 
-int get_priority(char * inStr)
+int get_priority(const char * inStr)
 {
    int result = -1;
 
@@ -191,7 +393,7 @@ int get_priority(char * inStr)
   return result;
 }
 
-int get_source(char * inStr)
+int get_source(const char * inStr)
 {
    int result = -1;
 
@@ -219,7 +421,7 @@ int get_source(char * inStr)
   return result;
 }
 
-int get_vf_status(char * inStr)
+int get_vf_status(const char * inStr)
 {
    int result = -1;
 
@@ -237,6 +439,37 @@ int get_vf_status(char * inStr)
   return result;
 }
 
+int get_rule_type(const char * inStr)
+{
+   int result = -1;
+
+   if(strcmp(inStr, "absolute") == 0)
+     result = EVEL_RULE_ABSOLUTE;
+   else if(strcmp(inStr, "rate") == 0)
+     result = EVEL_RULE_RATE;
+   else if(strcmp(inStr, "ratio") == 0)
+     result = EVEL_RULE_RATIO;
+
+  return result;
+}
+
+int get_alert_type(const char * inStr)
+{
+   int result = -1;
+
+   if(strcmp(inStr, "CARD-ANOMALY") == 0)
+     result = EVEL_CARD_ANOMALY;
+   else if(strcmp(inStr, "ELEMENT-ANOMALY") == 0)
+     result = EVEL_ELEMENT_ANOMALY;
+   else if(strcmp(inStr, "INTERFACE-ANOMALY") == 0)
+     result = EVEL_INTERFACE_ANOMALY;
+   else if(strcmp(inStr, "SERVICE-ANOMALY") == 0)
+     result = EVEL_SERVICE_ANOMALY;
+
+  return result;
+}
+
+#ifndef VES_AGENT_PLUGIN
 int main(int argc, char** argv)
 {
   char* fqdn = argv[1];
@@ -301,6 +534,8 @@ int main(int argc, char** argv)
   pthread_attr_init(&attr);
   pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
 
+  evel_id_generator_init(&fault_event_ids, "fault", 1);
+
   printf("Main:Creating thread \n");
   rc = pthread_create(&flt_thread, NULL, FaultThread, &i);
   if (rc)
@@ -316,1013 +551,1196 @@ int main(int argc, char** argv)
   printf("Terminated\n");
   return 0;
 }
+#endif
 
-void *FaultThread(void *mainFault)
+/**************************************************************************//**
+ * Compile a set of commands, one per member of an object.
+ *****************************************************************************/
+int compile_commands(const EVEL_CONFIG * config, const EVEL_CONFIG_NODE * commands, FLT_COMMAND * commandArray)
 {
+  const EVEL_CONFIG_NODE * command;
+  int numCommands = 0;
 
-   pthread_attr_t attr;
-   pthread_t flt_thread01;
-   pthread_t flt_thread02;
-   pthread_t flt_thread03;
-   int faultInstance01 = 0;
-   int faultInstance02 = 0;
-   int faultInstance03 = 0;
-   int rc;
-
-   int numToken;
-   jsmntok_t tokens[MAX_TOKENS];
-   char js[MAX_BUFFER_SIZE]; 
-
-   jsmn_parser p;
-   char ch[BUFSIZE];
-   int ret = 0;
+  if (commands == NULL)
+  {
+    return 0;
+  }
 
-   memset(js, 0, MAX_BUFFER_SIZE);
-   memset(ch, 0, BUFSIZE);
+  for (command = evel_config_child(config, commands);
+       command != NULL && numCommands < MAX_COMMANDS;
+       command = evel_config_next(config, command))
+  {
+    if (command->type != EVEL_CONFIG_STRING)
+    {
+      continue;
+    }
+    if (evel_command_compile(&commandArray[numCommands].command, command->value, command_variables, 1) != EVEL_SUCCESS)
+    {
+      break;
+    }
+    commandArray[numCommands].key = command->name;
+    numCommands++;
+  }
 
-   sleep(1);
-   printf("Running Main Fault thread \n");
-   fflush(stdout);
+  return numCommands;
+}
 
-   /* Initialize and set thread detached attribute */
-   pthread_attr_init(&attr);
-   pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+/**************************************************************************//**
+ * Compile tmp_alarmSetParameters or tmp_alarmClearParameters.
+ *****************************************************************************/
+int compile_alarm(const EVEL_CONFIG * config, const EVEL_CONFIG_NODE * instance, const char * params, const char * defSeverity, FLT_ALARM * alarm)
+{
+  const EVEL_CONFIG_NODE * node;
+  const char * severity;
 
-   FILE * file = fopen("flt_config.json", "r");
+  node = evel_config_find(config, instance, params);
+  if (node == NULL)
+  {
+    printf("FAULT::Missing mandatory parameters - %s is not there in %s\n", params, instance->name);
+    return -1;
+  }
 
-   while((fgets(ch, (BUFSIZE-1), file)) !=NULL)
-   {
-      strcat(js, ch);
-      memset(ch, 0, BUFSIZE);
-   }
-   //printf("MainFaulThread::the file content is \n %s \n", js);
-   //printf("\n MainFaulThread::MMMMMMMMMMMMMMM\n");
+  alarm->specific_problem = evel_config_string(config, node, "specificProblem", NULL);
+  if (alarm->specific_problem == NULL)
+  {
+    printf("FAULT::Missing mandatory parameters - specificProblem is not there in %s\n", params);
+    return -1;
+  }
+  alarm->alarm_condition = evel_config_string(config, node, "alarmCondition", NULL);
+  if (alarm->alarm_condition == NULL)
+  {
+    printf("FAULT::Missing mandatory parameters - alarmCondition is not there in %s\n", params);
+    return -1;
+  }
 
-   jsmn_init(&p);
-   numToken = jsmn_parse(&p, js, strlen(js), tokens, MAX_TOKENS);
-   //printf("count-%d\n", numToken);
+  severity = evel_config_string(config, node, "eventSeverity", NULL);
+  if (severity == NULL)
+  {
+    printf("FAULT::Missing mandatory parameters - eventSeverity is not there in %s\n", params);
+    printf("FAULT::Defaulting eventSeverity to %s\n", defSeverity);
+    severity = defSeverity;
+  }
+  alarm->severity = get_severity(severity);
+  if (alarm->severity == -1)
+  {
+    printf("FAULT::Fault eventSeverity value is not matching, eventSeverity-%s \n", severity);
+    return -1;
+  }
 
-   //printToken(js,tokens, numToken);
+  return 0;
+}
 
-   printf("Main Fault Thread: Creating other fault threads\n");
+/**************************************************************************//**
+ * Compile one tmp_faultInstance.
+ *****************************************************************************/
+int compile_instance(const EVEL_CONFIG * config, const EVEL_CONFIG_NODE * node, FLT_INSTANCE * instance)
+{
+  const char * srcTyp;
 
-   ret = isTokenPresent(js, tokens, numToken, "tmp_faultInstance01", "tmp_indirectParameters");
-   if (ret == 0)
-   {
-//      rc = pthread_create(&flt_thread01, NULL, FaultThread01, "tmp_faultInstance01");
-      rc = pthread_create(&flt_thread01, NULL, FaultThread01, &ret);
-      if (rc)
-      {
-        printf("Main Fault Thread::ERROR; return code from pthread_create() is %d\n", rc);
-        exit(-1);
-      }
-      faultInstance01 = 1;
-   }
+  instance->name = node->name;
 
-   ret = isTokenPresent(js, tokens, numToken, "tmp_faultInstance02", "tmp_indirectParameters");
-   if (ret == 0)
-   {
-//      rc = pthread_create(&flt_thread02, NULL, FaultThread02, "tmp_faultInstance02");
-      rc = pthread_create(&flt_thread02, NULL, FaultThread02, &ret);
-      if (rc)
-      {
-        printf("Main Fault Thread::ERROR; return code from pthread_create() is %d\n", rc);
-        exit(-1);
-      }
-      faultInstance02 = 1;
-   }
+  instance->event_name = evel_config_string(config, node, "eventName", NULL);
+  if (instance->event_name == NULL)
+  {
+    printf("FAULT::Missing mandatory parameters - eventName is not there in %s\n", node->name);
+    return -1;
+  }
+  instance->event_category = evel_config_string(config, node, "eventCategory", NULL);
+  instance->alarm_interface = evel_config_string(config, node, "alarmInterfaceA", NULL);
+  instance->per_link = (instance->alarm_interface != NULL &&
+                        strcmp(instance->alarm_interface, "$tmp_device") == 0);
 
-   ret = isTokenPresent(js, tokens, numToken, "tmp_faultInstance03", "tmp_indirectParameters");
-   if (ret == 0)
-   {
-      rc = pthread_create(&flt_thread03, NULL, FaultThread03, &ret);
-      if (rc)
-      {
-        printf("Main Fault Thread::ERROR; return code from pthread_create() is %d\n", rc);
-        exit(-1);
-      }
-      faultInstance03 = 1;
-   }
+  srcTyp = evel_config_string(config, node, "eventSourceType", NULL);
+  if (srcTyp == NULL)
+  {
+    printf("FAULT::Missing mandatory parameters - eventSourceType is not there in %s\n", node->name);
+    return -1;
+  }
+  instance->source_type = get_source(srcTyp);
+  if (instance->source_type == -1)
+  {
+    printf("FAULT::Fault eventSourceType value is not matching, eventSourceType-%s \n", srcTyp);
+    return -1;
+  }
 
-   if (faultInstance01 == 1)
-   {
-       pthread_join(flt_thread01, NULL);
-   }
+  instance->interval = evel_config_int(config, node, "tmp_faultCheckInterval", 0);
+  if (instance->interval <= 0)
+  {
+    printf("FAULT::The parameter tmp_faultCheckInterval is not defined in %s, defaulted to 60 seconds\n", node->name);
+    instance->interval = 60;
+  }
+  instance->low_water_mark = evel_config_int(config, node, "tmp_lowWaterMark", 100);
 
-   if (faultInstance02 == 1)
-   {
-       pthread_join(flt_thread02, NULL);
-   }
+  if (compile_alarm(config, node, "tmp_alarmSetParameters", "MAJOR", &instance->set) != 0 ||
+      compile_alarm(config, node, "tmp_alarmClearParameters", "NORMAL", &instance->clear) != 0)
+  {
+    return -1;
+  }
 
-   if (faultInstance03 == 1)
-   {
-       pthread_join(flt_thread03, NULL);
-   }
+  instance->num_init_commands = compile_commands(config, evel_config_find(config, node, "tmp_init"), instance->init_commands);
+  instance->num_commands = compile_commands(config, evel_config_find(config, node, "tmp_command"), instance->commands);
 
-   while(1)
-   {
-       sleep(100);
-   }
+  return 0;
 }
 
-void *FaultThread01(void *faultInstanceTag)
+/**************************************************************************//**
+ * Read a number from a member of a threshold rule.
+ *
+ * @returns 1 if the member is a number, 0 if it is missing, or -1 if it is
+ *          not a number.
+ *****************************************************************************/
+int get_number(const EVEL_CONFIG * config, const EVEL_CONFIG_NODE * node, const char * name, double * value)
 {
-  EVEL_ERR_CODES evel_rc = EVEL_SUCCESS;
-  EVENT_FAULT * fault = NULL;
-  EVENT_HEADER* fault_header = NULL;
-  int bytes_in;
-  int bytes_out;
-  int packets_in;
-  int packets_out;
-  unsigned long long epoch_now;
-  int lowWaterMark;
-
-  struct timeval time_val;
-  char event_id1[10] = "fault";
-  char event_id2[15] = {0};
-  char event_id[BUFSIZE] = {0};
-  int fault_event_id = 0;
-
-   int numToken;
-   jsmntok_t tokens[MAX_TOKENS];
-   char js[MAX_BUFFER_SIZE]; 
-
-   jsmn_parser p;
-   char ch[BUFSIZE];
-   int ret = 0;
-   char eName[BUFSIZE];
-   char eType[BUFSIZE];
-   char nfcCode[BUFSIZE];
-   char nfCode[BUFSIZE];
-   char prio[BUFSIZE];
-   char reportEId[BUFSIZE];
-   char reportEName[BUFSIZE];
-   char srcId[BUFSIZE];
-   char srcName[BUFSIZE];
-   char eCategory[BUFSIZE];
-   char eventSrcTyp[BUFSIZE];
-   char specProb[BUFSIZE];
-   char alarmCondn[BUFSIZE];
-   char eventSev[BUFSIZE];
-   char vfStatus[BUFSIZE];
-
-   int priority;
-   int srcTyp;
-   int vfStat;
-   int eSev;
-
-   char hostname[BUFSIZE];
-
-   int flt_interval;
-   ARRAYVAL intfArray[MAX_INTERFACES];
-   KEYVALRESULT keyValResultArray[32];
-   KEYVALRESULT commandArray[32];
-   int numInitCommands = 0;
-   int numCommands = 0;
-   int linkCount = 0;
-   int i = 0;
+  const char * text;
+  char * end;
 
-   memset(hostname, 0, BUFSIZE);
-   gethostname(hostname, BUFSIZE);
-   printf("FAULT01::The hostname is %s\n", hostname);
-
-   sleep(1);
-   printf("FAULT01::Running Fault thread \n");
-   fflush(stdout);
+  text = evel_config_string(config, node, name, NULL);
+  if (text == NULL)
+  {
+    return 0;
+  }
+  *value = strtod(text, &end);
+  return (end != text && *end == '\0') ? 1 : -1;
+}
 
-   memset(&intfArray[0],0,(sizeof(ARRAYVAL) * MAX_INTERFACES));
-   memset(&keyValResultArray[0],0,(sizeof(KEYVALRESULT) * 32));
+/**************************************************************************//**
+ * Compile one entry of tmp_thresholdRules.
+ *****************************************************************************/
+int compile_rule(const EVEL_CONFIG * config, const EVEL_CONFIG_NODE * node, FLT_RULE * rule)
+{
+  const char * metric;
+  const char * value;
+  int above;
+  int below;
+
+  rule->name = evel_config_string(config, node, "name", NULL);
+  metric = evel_config_string(config, node, "metric", NULL);
+  if (rule->name == NULL || metric == NULL)
+  {
+    printf("FAULT::Missing mandatory parameters - name or metric is not there in tmp_thresholdRules\n");
+    return -1;
+  }
+  rule->event_name = evel_config_string(config, node, "eventName", rule->name);
+  rule->description = evel_config_string(config, node, "description", NULL);
+  rule->per_link = (strstr(metric, "$tmp_device") != NULL);
 
-   memset(js, 0, MAX_BUFFER_SIZE);
-   memset(ch, 0, BUFSIZE);
-   memset(&fault_intfstat[0],0,(sizeof(vpp_metrics_struct)* MAX_INTERFACES));
-   memset(&fault_linkstat[0],0,(sizeof(LINKSTAT) * MAX_INTERFACES));
+  value = evel_config_string(config, node, "type", "absolute");
+  rule->type = get_rule_type(value);
+  if (rule->type == -1)
+  {
+    printf("FAULT::Threshold rule type value is not matching, type-%s \n", value);
+    return -1;
+  }
 
-   FILE * file = fopen("flt_config.json", "r");
+  above = get_number(config, node, "above", &rule->set_threshold);
+  below = get_number(config, node, "below", &rule->set_threshold);
+  if (above < 0 || below < 0 || above + below != 1)
+  {
+    printf("FAULT::Threshold rule %s needs one numeric above or below\n", rule->name);
+    return -1;
+  }
+  rule->direction = above ? EVEL_RULE_ABOVE : EVEL_RULE_BELOW;
+  rule->clear_threshold = rule->set_threshold;
+  if (get_number(config, node, "clear", &rule->clear_threshold) < 0)
+  {
+    printf("FAULT::Threshold rule %s clear is not a number\n", rule->name);
+    return -1;
+  }
+  rule->set_after_ms = evel_config_int(config, node, "setAfterMs", 0);
+  rule->clear_after_ms = evel_config_int(config, node, "clearAfterMs", 0);
 
-   while((fgets(ch, (BUFSIZE-1), file)) !=NULL)
-   {
-      strcat(js, ch);
-      memset(ch, 0, BUFSIZE);
-   }
-//   printf("FAULT01::the file content is \n %s \n", js);
+  value = evel_config_string(config, node, "severity", "MAJOR");
+  rule->severity = get_severity(value);
+  if (rule->severity == -1)
+  {
+    printf("FAULT::Threshold rule severity value is not matching, severity-%s \n", value);
+    return -1;
+  }
+  value = evel_config_string(config, node, "alertType", rule->per_link ? "INTERFACE-ANOMALY" : "ELEMENT-ANOMALY");
+  rule->alert_type = get_alert_type(value);
+  if (rule->alert_type == -1)
+  {
+    printf("FAULT::Threshold rule alertType value is not matching, alertType-%s \n", value);
+    return -1;
+  }
 
-   jsmn_init(&p);
-   numToken = jsmn_parse(&p, js, strlen(js), tokens, MAX_TOKENS);
-   printf("FAULT01::count-%d\n", numToken);
+  if (evel_command_compile(&rule->metric, metric, command_variables, 1) != EVEL_SUCCESS)
+  {
+    return -1;
+  }
+  value = evel_config_string(config, node, "denominator", metric);
+  if (rule->type == EVEL_RULE_RATIO && value == metric)
+  {
+    printf("FAULT::Missing mandatory parameters - denominator is not there in %s\n", rule->name);
+    evel_command_free(&rule->metric);
+    return -1;
+  }
+  if (evel_command_compile(&rule->denominator, value, command_variables, 1) != EVEL_SUCCESS)
+  {
+    evel_command_free(&rule->metric);
+    return -1;
+  }
 
-//   printToken(js,tokens, numToken);
+  return 0;
+}
 
+void free_flt_config(void * compiled);
 
-   ret = getIntToken(js, tokens, numToken, "tmp_faultCheckInterval", "tmp_faultInstance01", &flt_interval);
-   if (ret != 0)
-   {
-      printf("FAULT01::The parameter tmp_faultCheckInterval is not defined, defaulted to 60 seconds\n");
-      flt_interval = 60;
-   }
+/**************************************************************************//**
+ * Compile flt_config.json.  The context is the hostname, used where the
+ * reporting entity or source name is not given.
+ *****************************************************************************/
+void * compile_flt_config(const EVEL_CONFIG * config, void * context)
+{
+  static int serial = 0;
+  const char * hostname = context;
+  const EVEL_CONFIG_NODE * direct;
+  const EVEL_CONFIG_NODE * indirect;
+  const EVEL_CONFIG_NODE * rules;
+  const EVEL_CONFIG_NODE * node;
+  const char * value;
+  FLT_CONFIG * flt;
+  int numInstances = 0;
+
+  direct = evel_config_find(config, NULL, "tmp_directParameters");
+  indirect = evel_config_find(config, NULL, "tmp_indirectParameters");
+  if (direct == NULL || indirect == NULL)
+  {
+    printf("FAULT::Missing mandatory parameters - tmp_directParameters or tmp_indirectParameters is not there\n");
+    return NULL;
+  }
 
-   ret = getIntToken(js, tokens, numToken, "tmp_lowWaterMark", "tmp_faultInstance01", &lowWaterMark);
-   if (ret != 0)
-   {
-      printf("FAULT01::The parameter tmp_lowWaterMark is not defined, defaulted to 100\n");
-      lowWaterMark = 100;
-   }
+  flt = calloc(1, sizeof(FLT_CONFIG));
+  if (flt == NULL)
+  {
+    return NULL;
+  }
+  flt->serial = ++serial;
 
-  ret = getArrayTokens(js, tokens, numToken, "tmp_device", "tmp_directParameters", intfArray, &linkCount);
+  flt->event_type = evel_config_string(config, direct, "eventType", NULL);
+  flt->nfc_naming_code = evel_config_string(config, direct, "nfcNamingCode", NULL);
+  flt->nf_naming_code = evel_config_string(config, direct, "nfNamingCode", NULL);
+  flt->reporting_entity_id = evel_config_string(config, direct, "reportingEntityId", NULL);
+  flt->source_id = evel_config_string(config, direct, "sourceId", NULL);
 
-  printf("FAULT01::Array link count is %d\n", linkCount); 
+  flt->reporting_entity_name = evel_config_string(config, direct, "reportingEntityName", NULL);
+  if (flt->reporting_entity_name == NULL)
+  {
+    printf("FAULT::Missing mandatory parameters - reportingEntityName is not there in tmp_directParameters\n");
+    printf("FAULT::Defaulting reportingEntityName to hostname\n");
+    flt->reporting_entity_name = hostname;
+  }
+  flt->source_name = evel_config_string(config, direct, "sourceName", NULL);
+  if (flt->source_name == NULL)
+  {
+    printf("FAULT::Missing mandatory parameters - sourceName is not there in tmp_directParameters\n");
+    printf("FAULT::Defaulting sourceName to hostname\n");
+    flt->source_name = hostname;
+  }
 
-  /* Copy the link information */
-  for(i=0;i<linkCount;i++)
+  value = evel_config_string(config, direct, "priority", NULL);
+  if (value == NULL)
   {
-     strcpy(fault_linkstat[i].linkname, &intfArray[i]);
-//     printf("FAULT01::Link name %s\n", fault_linkstat[i].linkname);
+    printf("FAULT::Missing mandatory parameters - priority is not there in tmp_directParameters\nDefaulting priority to Medium\n");
+    value = "Medium";
+  }
+  flt->priority = get_priority(value);
+  if (flt->priority == -1)
+  {
+    printf("FAULT::Fault priority value is not matching, prioirty-%s \n", value);
+    goto error;
   }
-  
-  //read_fault_config_file();
 
-  read_keyVal_params(js, tokens, numToken, "tmp_init", "tmp_faultInstance01", keyValResultArray, &numInitCommands);
+  value = evel_config_string(config, direct, "vfStatus", NULL);
+  if (value == NULL)
+  {
+    printf("FAULT::Missing mandatory parameters - vfStatus is not there in tmp_directParameters\n");
+    goto error;
+  }
+  flt->vf_status = get_vf_status(value);
+  if (flt->vf_status == -1)
+  {
+    printf("FAULT::Fault vfStatus value is not matching, vfStatus-%s \n", value);
+    goto error;
+  }
 
-  for(i=0;i<linkCount;i++)
+  node = evel_config_find(config, direct, "tmp_device");
+  if (node != NULL)
   {
-     memset(&commandArray[0],0,(sizeof(KEYVALRESULT) * 32));
-     memcpy(commandArray, keyValResultArray, (sizeof(KEYVALRESULT) * 32)); 
-     format_val_params(commandArray, numInitCommands, fault_linkstat[i].linkname, "$tmp_device");
-     runCommands(commandArray, numInitCommands);
-     copy_vpp_metic_data(fault_intfstat, commandArray, numInitCommands, i); 
+    for (node = evel_config_child(config, node);
+         node != NULL && flt->num_links < MAX_INTERFACES;
+         node = evel_config_next(config, node))
+    {
+      if (node->type == EVEL_CONFIG_STRING)
+      {
+        flt->links[flt->num_links++] = node->value;
+      }
+    }
   }
 
-  gettimeofday(&time_val, NULL);
+  for (node = evel_config_child(config, indirect);
+       node != NULL;
+       node = evel_config_next(config, node))
+  {
+    if (node->type == EVEL_CONFIG_OBJECT)
+    {
+      numInstances++;
+    }
+  }
+  flt->instances = calloc(numInstances > 0 ? numInstances : 1, sizeof(FLT_INSTANCE));
+  if (flt->instances == NULL)
+  {
+    goto error;
+  }
 
-  sleep(flt_interval);
+  for (node = evel_config_child(config, indirect);
+       node != NULL;
+       node = evel_config_next(config, node))
+  {
+    if (node->type != EVEL_CONFIG_OBJECT)
+    {
+      continue;
+    }
+    if (compile_instance(config, node, &flt->instances[flt->num_instances]) != 0)
+    {
+      goto error;
+    }
+    flt->num_instances++;
+  }
 
   /***************************************************************************/
-  /* Collect metrics from the VNIC                                           */
+  /* Threshold rules are optional.                                           */
   /***************************************************************************/
-  while(1) 
+  rules = evel_config_find(config, NULL, "tmp_thresholdRules");
+  if (rules != NULL && rules->size > 0)
   {
+    flt->rules = calloc(rules->size, sizeof(FLT_RULE));
+    if (flt->rules == NULL)
+    {
+      goto error;
+    }
+    for (node = evel_config_child(config, rules);
+         node != NULL;
+         node = evel_config_next(config, node))
+    {
+      if (node->type != EVEL_CONFIG_OBJECT)
+      {
+        continue;
+      }
+      if (compile_rule(config, node, &flt->rules[flt->num_rules]) != 0)
+      {
+        goto error;
+      }
+      flt->num_rules++;
+    }
+  }
 
-    ret = getIntToken(js, tokens, numToken, "tmp_faultCheckInterval", "tmp_faultInstance01", &flt_interval);
-   if (ret != 0)
-   {
-      flt_interval = 60;
-   }
+  return flt;
 
-    ret = getIntToken(js, tokens, numToken, "tmp_lowWaterMark", "tmp_faultInstance01", &lowWaterMark);
-   if (ret != 0)
-   {
-      lowWaterMark = 100;
-   }
+error:
+  free_flt_config(flt);
+  return NULL;
+}
 
-   ret = getStringToken(js, tokens, numToken, "eventName", "tmp_faultInstance01", eName, BUFSIZE);
-   if (ret != 0)
-   {
-      printf("FAULT01::Missing mandatory parameters - eventName is not there in tmp_faultInstance01. Exiting...\n");
-      exit(1);
-   }
+/**************************************************************************//**
+ * Free a compiled flt_config.json.
+ *****************************************************************************/
+void free_flt_config(void * compiled)
+{
+  FLT_CONFIG * flt = compiled;
+  FLT_INSTANCE * instance;
+  int i;
+  int j;
 
-   ret = getStringToken(js, tokens, numToken, "eventType", "tmp_directParameters", eType, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "nfcNamingCode", "tmp_directParameters", nfcCode, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "nfNamingCode", "tmp_directParameters", nfCode, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "reportingEntityId", "tmp_directParameters", reportEId, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "sourceId", "tmp_directParameters", srcId, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "eventCategory", "tmp_faultInstance01", eCategory, BUFSIZE);  
+  for (i = 0; i < flt->num_instances; i++)
+  {
+    instance = &flt->instances[i];
+    for (j = 0; j < instance->num_init_commands; j++)
+    {
+      evel_command_free(&instance->init_commands[j].command);
+    }
+    for (j = 0; j < instance->num_commands; j++)
+    {
+      evel_command_free(&instance->commands[j].command);
+    }
+  }
+  for (i = 0; i < flt->num_rules; i++)
+  {
+    evel_command_free(&flt->rules[i].metric);
+    evel_command_free(&flt->rules[i].denominator);
+  }
+  free(flt->rules);
+  free(flt->instances);
+  free(flt);
+}
 
-   ret = getStringToken(js, tokens, numToken, "eventSourceType", "tmp_faultInstance01", eventSrcTyp, BUFSIZE);
-   if (ret != 0)
-   {
-      printf("FAULT01::Missing mandatory parameters - eventSourceType is not there in tmp_directParameters, exiting..\n");
-      exit(1); 
-   }
-   srcTyp = get_source(eventSrcTyp);
-   if(srcTyp == -1)
-   {
-      printf("FAULT01::Fault eventSourceType value is not matching, eventSourceType-%s \n", eventSrcTyp);
-      exit(1);
-   }
+/**************************************************************************//**
+ * Find a fault instance by name, or NULL if it is not configured.
+ *****************************************************************************/
+const FLT_INSTANCE * find_instance(const FLT_CONFIG * flt, const char * name)
+{
+  int i;
 
-   ret = getStringToken(js, tokens, numToken, "vfStatus", "tmp_directParameters", vfStatus, BUFSIZE);
-   if (ret != 0)
-   {
-      printf("FAULT01::Missing mandatory parameters - vfStatus is not there in tmp_directParameters, exiting..\n");
-      exit(1); 
-   }
-   vfStat = get_vf_status(vfStatus);
-   if(vfStat == -1)
-   {
-      printf("FAULT01::Fault vfStatus value is not matching, vfStatus-%s \n", vfStatus);
-      exit(1);
-   }
+  for (i = 0; i < flt->num_instances; i++)
+  {
+    if (strcmp(flt->instances[i].name, name) == 0)
+    {
+      return &flt->instances[i];
+    }
+  }
+  return NULL;
+}
 
-   read_keyVal_params(js, tokens, numToken, "tmp_command", "tmp_faultInstance01", keyValResultArray, &numCommands);
+/**************************************************************************//**
+ * Acquire the current configuration, reloading it first if it has changed.
+ *****************************************************************************/
+FLT_CONFIG * acquire_flt_config(void)
+{
+  if (evel_config_watch_check(flt_config_watch))
+  {
+    printf("FAULT::Reloaded flt_config.json\n");
+  }
+  return evel_config_watch_acquire(flt_config_watch);
+}
 
-   for(i=0;i<linkCount;i++)
-   {
-       memset(&commandArray[0],0,(sizeof(KEYVALRESULT) * 32));
-       memcpy(commandArray, keyValResultArray, (sizeof(KEYVALRESULT) * 32)); 
-       format_val_params(commandArray, numCommands, fault_linkstat[i].linkname, "$tmp_device");
-       runCommands(commandArray, numCommands);
-       copy_vpp_metic_data(fault_intfstat, commandArray, numInitCommands, i); 
-   }
+/**************************************************************************//**
+ * Fill in the header fields common to all faults.
+ *****************************************************************************/
+void set_fault_header(EVENT_FAULT * fault, const FLT_CONFIG * flt, const FLT_INSTANCE * instance)
+{
+  if (instance->event_category != NULL)
+    evel_fault_category_set(fault, instance->event_category);
+  if (flt->event_type != NULL)
+    evel_fault_type_set(fault, flt->event_type);
+  if (flt->nfc_naming_code != NULL)
+    evel_nfcnamingcode_set(&fault->header, flt->nfc_naming_code);
+  if (flt->nf_naming_code != NULL)
+    evel_nfnamingcode_set(&fault->header, flt->nf_naming_code);
+  evel_reporting_entity_name_set(&fault->header, flt->reporting_entity_name);
+  if (flt->reporting_entity_id != NULL)
+    evel_reporting_entity_id_set(&fault->header, flt->reporting_entity_id);
+  if (flt->source_id != NULL)
+    evel_source_id_set(&fault->header, flt->source_id);
+  evel_source_name_set(&fault->header, flt->source_name);
+}
 
-   for (int i = 0; i < linkCount; i++)
-   {
-      if(fault_intfstat[i].curr_bytes_in - fault_intfstat[i].last_bytes_in > 0) {
-        bytes_in = fault_intfstat[i].curr_bytes_in - fault_intfstat[i].last_bytes_in;
-      }
-      else {
-        bytes_in = 0;
-      }
-      if(fault_intfstat[i].curr_bytes_out - fault_intfstat[i].last_bytes_out > 0) {
-        bytes_out = fault_intfstat[i].curr_bytes_out - fault_intfstat[i].last_bytes_out;
-      }
-      else {
-        bytes_out = 0;
-      }
-      if(fault_intfstat[i].curr_packets_in - fault_intfstat[i].last_packets_in > 0) {
-        packets_in = fault_intfstat[i].curr_packets_in - fault_intfstat[i].last_packets_in;
-      }
-      else {
-        packets_in = 0;
-      }
-      if(fault_intfstat[i].curr_packets_out - fault_intfstat[i].last_packets_out > 0) {
-        packets_out = fault_intfstat[i].curr_packets_out - fault_intfstat[i].last_packets_out;
-      }
-      else {
-        packets_out = 0;
-      }
-      if (((bytes_in < lowWaterMark) || (bytes_out < lowWaterMark) || 
-          (packets_in < lowWaterMark) || (packets_out < lowWaterMark)) &&
-          (fault_linkstat[i].fault_raised == 0)) 
-      {
-        printf("\n%d - bytes in %d, ouot %d, packets in %d, out %d", i, bytes_in, bytes_out, packets_in, packets_out);
-        printf("\nFAULT01::Raising fault\n");
-        memset(event_id, 0, BUFSIZE);
-        fault_event_id = fault_event_id+1;
-        sprintf(event_id2, "%09d", fault_event_id);
-        strcat(event_id, event_id1);
-        strcat(event_id, event_id2);
-
-        ret = getIntToken(js, tokens, numToken, "tmp_faultCheckInterval", "tmp_faultInstance01", &flt_interval);
-        if (ret != 0)
-        {
-           printf("FAULT01::The parameter tmp_faultCheckInterval is not defined, defaulted to 60 seconds\n");
-           flt_interval = 60;
-        }
+/**************************************************************************//**
+ * Read the counters of every link, once per sampling round.
+ *****************************************************************************/
+EVEL_ERR_CODES read_rule_snapshot(void * context)
+{
+  FLT_RULES * state = context;
 
-        ret = getIntToken(js, tokens, numToken, "tmp_lowWaterMark", "tmp_faultInstance01", &lowWaterMark);
-        if (ret != 0)
-        {
-           printf("FAULT01::The parameter tmp_lowWaterMark is not defined, defaulted to 100\n");
-           lowWaterMark = 100;
-        }
-        ret = getStringToken(js, tokens, numToken, "reportingEntityName", "tmp_directParameters", reportEName, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT01::Missing mandatory parameters - reportingEntityName is not there in tmp_directParameters\n");
-           printf("FAULT01::Defaulting reportingEntityName to hostname\n");
-           strcpy(reportEName, hostname);
-        }
-        ret = getStringToken(js, tokens, numToken, "sourceName", "tmp_directParameters", srcName, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT01::Missing mandatory parameters - sourceName is not there in tmp_directParameters\n");
-           printf("FAULT01::Defaulting sourceName to hostname\n");
-           strcpy(srcName, hostname);
-        }
+  return evel_ifstats_read_netlink(&state->snapshot);
+}
 
-        ret = getStringToken(js, tokens, numToken, "priority", "tmp_directParameters", prio, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT01::Missing mandatory parameters - priority is not there in tmp_directParameters\nDefaulting priority to Low\n");
-           strcpy(prio, "Medium");
-        }
-        priority = get_priority(prio);
-        if(priority == -1)
-        {
-           printf("FAULT01::Fault priority value is not matching, prioirty-%s \n", prio);
-           exit(1);
-        }
+/**************************************************************************//**
+ * Read one link counter from the round's snapshot.
+ *****************************************************************************/
+EVEL_ERR_CODES read_link_counter(void * context, unsigned long long * value)
+{
+  const FLT_SAMPLE * sample = context;
+  const EVEL_IF_STATS * stats;
 
-        ret = getStringTokenV2(js, tokens, numToken, "specificProblem", "tmp_alarmSetParameters", "tmp_faultInstance01", specProb, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT01::Missing mandatory parameters - specificProblem is not there in tmp_alarmSetParameters, exiting ...\n");
-           exit(1);
-        }
-        ret = getStringTokenV2(js, tokens, numToken, "alarmCondition", "tmp_alarmSetParameters", "tmp_faultInstance01", alarmCondn, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT01::Missing mandatory parameters - alarmCondition is not there in tmp_alarmSetParameters, exiting ...\n");
-           exit(1);
-        }
-        ret = getStringTokenV2(js, tokens, numToken, "eventSeverity", "tmp_alarmSetParameters", "tmp_faultInstance01", eventSev, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT01::Missing mandatory parameters - eventSeverity is not there in tmp_alarmSetParameters\n");
-           printf("FAULT01::Defaulting eventSeverity to MAJOR\n");
-           strcpy(eventSev, "MAJOR");
-        }
-        eSev = get_severity(eventSev);
-        if(eSev == -1)
-        {
-           printf("FAULT01::Fault eventSeverity value is not matching, eventSeverity-%s \n", eventSev);
-           exit(1);
-        }
+  stats = evel_if_snapshot_get(sample->snapshot, sample->link);
+  if (stats == NULL)
+  {
+    return EVEL_ERR_GEN_FAIL;
+  }
+  *value = *(const unsigned long long *) ((const char *) stats + sample->offset);
+  return EVEL_SUCCESS;
+}
+
+/**************************************************************************//**
+ * Post a Threshold Crossing Alert as soon as a rule is raised or cleared.
+ *****************************************************************************/
+void RuleAlert(void * context, const EVEL_RULE_ALERT * const alert)
+{
+  const FLT_RULE_TARGET * target = alert->context;
+  EVEL_ERR_CODES evel_rc = EVEL_SUCCESS;
+  EVENT_THRESHOLD_CROSS * tca = NULL;
+  FLT_CONFIG * flt;
+
+  char event_id[EVEL_ID_MAX_LEN + 1] = {0};
+
+  printf("\nFAULT::Threshold rule %s %s, %s is %.2f\n", alert->rule,
+         alert->action == EVEL_EVENT_ACTION_SET ? "raised" : "cleared",
+         alert->metric, alert->value);
+  evel_id_generator_next(&fault_event_ids, event_id, sizeof(event_id));
+
+  tca = evel_rules_new_threshold_cross(alert, target->event_name, event_id);
+  if (tca == NULL)
+  {
+    printf("FAULT::New threshold cross failed (%s)\n", evel_error_string());
+    return;
+  }
+
+  flt = evel_config_watch_acquire(flt_config_watch);
+  if (flt->event_type != NULL)
+    evel_threshold_cross_type_set(tca, (char *) flt->event_type);
+  if (flt->nfc_naming_code != NULL)
+    evel_nfcnamingcode_set(&tca->header, flt->nfc_naming_code);
+  if (flt->nf_naming_code != NULL)
+    evel_nfnamingcode_set(&tca->header, flt->nf_naming_code);
+  evel_reporting_entity_name_set(&tca->header, flt->reporting_entity_name);
+  if (flt->reporting_entity_id != NULL)
+    evel_reporting_entity_id_set(&tca->header, flt->reporting_entity_id);
+  if (flt->source_id != NULL)
+    evel_source_id_set(&tca->header, flt->source_id);
+  evel_source_name_set(&tca->header, flt->source_name);
+  evel_config_watch_release(flt_config_watch, flt);
+
+  if (target->link[0] != '\0')
+    evel_threshold_cross_interfacename_set(tca, (char *) target->link);
+
+  evel_rc = evel_post_event((EVENT_HEADER *) tca);
+  if(evel_rc == EVEL_SUCCESS)
+    printf("FAULT::Threshold cross event is correctly sent to the collector!\n");
+  else
+    printf("FAULT::Post failed %d (%s)\n", evel_rc, evel_error_string());
+}
+
+/**************************************************************************//**
+ * Stop and free the threshold rules.
+ *****************************************************************************/
+void stop_rules(FLT_RULES * state)
+{
+  if (state == NULL)
+  {
+    return;
+  }
+
+  evel_free_sampler(state->sampler);
+  evel_free_rules(state->rules);
+  evel_if_snapshot_free(&state->snapshot);
+  free(state->targets);
+  free(state);
+}
+
+/**************************************************************************//**
+ * Start evaluating the configured threshold rules against every link's
+ * counters.  Returns NULL if there are no rules.
+ *****************************************************************************/
+FLT_RULES * start_rules(const FLT_CONFIG * flt)
+{
+  FLT_RULES * state;
+  const FLT_RULE * rule;
+  FLT_RULE_TARGET * target;
+  FLT_SAMPLE * sample;
+  EVEL_RULE_SPEC spec;
+  char metric[BUFSIZE];
+  char denominator[BUFSIZE];
+  const char * values[1];
+  int numTargets;
+  int i;
+  int j;
+
+  if (flt->num_rules == 0)
+  {
+    return NULL;
+  }
+
+  state = calloc(1, sizeof(FLT_RULES));
+  if (state == NULL || evel_if_snapshot_init(&state->snapshot) != EVEL_SUCCESS)
+  {
+    printf("FAULT::Failed to allocate the threshold rules\n");
+    free(state);
+    return NULL;
+  }
+  state->targets = calloc(flt->num_rules * (flt->num_links + 1), sizeof(FLT_RULE_TARGET));
+  state->rules = evel_new_rules(RuleAlert, NULL);
+  state->sampler = evel_new_sampler(RULE_SAMPLE_PERIOD_MS, read_rule_snapshot, state);
+  if (state->targets == NULL || state->rules == NULL || state->sampler == NULL)
+  {
+    goto error;
+  }
+
+  /***************************************************************************/
+  /* Every counter of every link is sampled, so rules may name any of them.  */
+  /***************************************************************************/
+  for (i = 0; i < flt->num_links; i++)
+  {
+    strncpy(state->links[i], flt->links[i], EVEL_IF_NAME_MAX);
+    for (j = 0; j < NUM_LINK_COUNTERS; j++)
+    {
+      sample = &state->samples[i][j];
+      sample->snapshot = &state->snapshot;
+      sample->link = state->links[i];
+      sample->offset = link_counters[j].offset;
+      snprintf(metric, sizeof(metric), "%s.%s", state->links[i], link_counters[j].name);
+      if (evel_sampler_metric_add(state->sampler, metric, EVEL_SAMPLE_RATE, 0, read_link_counter, sample) != EVEL_SUCCESS)
+      {
+        goto error;
+      }
+    }
+  }
+
+  for (i = 0; i < flt->num_rules; i++)
+  {
+    rule = &flt->rules[i];
+    numTargets = rule->per_link ? flt->num_links : 1;
+    for (j = 0; j < numTargets; j++)
+    {
+      values[0] = rule->per_link ? state->links[j] : "";
+      evel_command_render(&rule->metric, values, metric, sizeof(metric));
+      evel_command_render(&rule->denominator, values, denominator, sizeof(denominator));
+
+      target = &state->targets[state->num_targets++];
+      strncpy(target->event_name, rule->event_name, sizeof(target->event_name) - 1);
+      if (rule->per_link)
+      {
+        strncpy(target->link, state->links[j], EVEL_IF_NAME_MAX);
+      }
+
+      memset(&spec, 0, sizeof(spec));
+      spec.name = rule->name;
+      spec.metric = metric;
+      spec.denominator = denominator;
+      spec.type = rule->type;
+      spec.direction = rule->direction;
+      spec.set_threshold = rule->set_threshold;
+      spec.clear_threshold = rule->clear_threshold;
+      spec.set_after_ms = rule->set_after_ms;
+      spec.clear_after_ms = rule->clear_after_ms;
+      spec.severity = rule->severity;
+      spec.alert_type = rule->alert_type;
+      spec.description = rule->description;
+      spec.context = target;
+      if (evel_rules_add(state->rules, &spec) != EVEL_SUCCESS)
+      {
+        goto error;
+      }
+    }
+  }
+
+  if (evel_sampler_rules_set(state->sampler, state->rules) != EVEL_SUCCESS ||
+      evel_sampler_start(state->sampler) != EVEL_SUCCESS)
+  {
+    goto error;
+  }
+  printf("FAULT::Evaluating %d threshold rules every %d ms\n", state->num_targets, RULE_SAMPLE_PERIOD_MS);
+  return state;
+
+error:
+  printf("FAULT::Failed to start the threshold rules\n");
+  stop_rules(state);
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Restart the threshold rules when flt_config.json has changed.  A rule
+ * raised under the old configuration is not cleared, as it may have been
+ * removed.
+ *****************************************************************************/
+void update_rules(const FLT_CONFIG * flt)
+{
+  if (flt->serial == flt_rules_serial)
+  {
+    return;
+  }
+  stop_rules(flt_rules);
+  flt_rules = start_rules(flt);
+  flt_rules_serial = flt->serial;
+}
+
+/**************************************************************************//**
+ * Track the configured links, resetting the state of any that change.
+ *****************************************************************************/
+int update_links(FLT_JOB * job, const FLT_CONFIG * flt)
+{
+  int i;
 
-        fault = evel_new_fault(eName, event_id, alarmCondn, 
-                               specProb, priority, eSev, srcTyp,vfStat);
+  for (i = 0; i < flt->num_links; i++)
+  {
+    if (strcmp(job->linkstat[i].linkname, flt->links[i]) != 0)
+    {
+      memset(&job->linkstat[i], 0, sizeof(LINKSTAT));
+      evel_counter_init(&job->intfstat[i].bytes_in, EVEL_COUNTER_AUTO);
+      evel_counter_init(&job->intfstat[i].bytes_out, EVEL_COUNTER_AUTO);
+      evel_counter_init(&job->intfstat[i].packets_in, EVEL_COUNTER_AUTO);
+      evel_counter_init(&job->intfstat[i].packets_out, EVEL_COUNTER_AUTO);
+      strncpy(job->linkstat[i].linkname, flt->links[i], sizeof(job->linkstat[i].linkname) - 1);
+    }
+    job->link_names[i] = job->linkstat[i].linkname;
+  }
+
+  return flt->num_links;
+}
+
+/**************************************************************************//**
+ * Check each link's traffic against the low water mark, raising a fault on
+ * a link that falls below it and clearing it when the link recovers.
+ *****************************************************************************/
+void check_link_faults(FLT_JOB * job, const FLT_CONFIG * flt, const FLT_INSTANCE * instance)
+{
+  EVEL_ERR_CODES evel_rc = EVEL_SUCCESS;
+  EVENT_FAULT * fault = NULL;
+  EVENT_HEADER* fault_header = NULL;
+  unsigned long long bytes_in;
+  unsigned long long bytes_out;
+  unsigned long long packets_in;
+  unsigned long long packets_out;
+  unsigned long long epoch_now;
+  unsigned long long lowWaterMark;
+  int primed[MAX_INTERFACES];
+  int failed[MAX_INTERFACES];
+
+  char event_id[EVEL_ID_MAX_LEN + 1] = {0};
+
+   const EVEL_IF_SNAPSHOT * snapshot;
+   int linkCount = 0;
+   int i = 0;
+
+   linkCount = update_links(job, flt);
+   lowWaterMark = (instance->low_water_mark > 0) ? instance->low_water_mark : 0;
+
+   snapshot = read_if_snapshot(&job->snapshot, instance->commands, instance->num_commands);
+   runCommands(instance->commands, instance->num_commands, job->link_names, linkCount, snapshot, job->probes, job->results, job->name);
+   for(i=0;i<linkCount;i++)
+   {
+       // A link's first reading has no delta to check yet, and a link
+       // without a full set of readings this time is not checked either
+       primed[i] = job->intfstat[i].bytes_in.valid &&
+                   job->intfstat[i].bytes_out.valid &&
+                   job->intfstat[i].packets_in.valid &&
+                   job->intfstat[i].packets_out.valid;
+       failed[i] = copy_vpp_metic_data(job->intfstat, instance->commands, &job->probes[i * instance->num_commands], job->results[i], instance->num_commands, i);
+   }
+
+   for (int i = 0; i < linkCount; i++)
+   {
+      if (!primed[i])
+      {
+        continue;
+      }
+      if (failed[i] > 0)
+      {
+        printf("%s::No reading for link %s, not checked\n", job->name, job->link_names[i]);
+        continue;
+      }
+      bytes_in = job->intfstat[i].bytes_in.delta;
+      bytes_out = job->intfstat[i].bytes_out.delta;
+      packets_in = job->intfstat[i].packets_in.delta;
+      packets_out = job->intfstat[i].packets_out.delta;
+      if (((bytes_in < lowWaterMark) || (bytes_out < lowWaterMark) ||
+          (packets_in < lowWaterMark) || (packets_out < lowWaterMark)) &&
+          (job->linkstat[i].fault_raised == 0))
+      {
+        printf("\n%d - bytes in %llu, ouot %llu, packets in %llu, out %llu", i, bytes_in, bytes_out, packets_in, packets_out);
+        printf("\n%s::Raising fault\n", job->name);
+        evel_id_generator_next(&fault_event_ids, event_id, sizeof(event_id));
+
+        fault = evel_new_fault(instance->event_name, event_id,
+                               instance->set.alarm_condition,
+                               instance->set.specific_problem,
+                               flt->priority, instance->set.severity,
+                               instance->source_type, flt->vf_status);
         if (fault != NULL)
         {
-            fault_linkstat[i].fault_raised = 1;
+            job->linkstat[i].fault_raised = 1;
+
+            epoch_now = evel_time_now_usec(EVEL_CLOCK_EXACT);
+            job->linkstat[i].last_epoch = epoch_now;
 
-            struct timeval tv_now;
-            gettimeofday(&tv_now, NULL);
-            epoch_now = tv_now.tv_usec + 1000000 * tv_now.tv_sec;
-            fault_linkstat[i].last_epoch = epoch_now;
-  
             fault_header = (EVENT_HEADER *)fault;
-  
-            evel_fault_category_set(fault, eCategory);
-            evel_fault_interface_set(fault, fault_linkstat[i].linkname);
-    
-            if (eType != NULL)
-                evel_fault_type_set(fault, eType); 
-      
+
+            set_fault_header(fault, flt, instance);
+            evel_fault_interface_set(fault, job->linkstat[i].linkname);
+
             evel_start_epoch_set(&fault->header, epoch_now);
             evel_last_epoch_set(&fault->header, epoch_now);
-            if(nfcCode != NULL)
-                evel_nfcnamingcode_set(&fault->header, nfcCode);
-            if(nfCode != NULL)
-                evel_nfnamingcode_set(&fault->header, nfCode);
-            evel_reporting_entity_name_set(&fault->header, reportEName);
-            if(reportEId != NULL)
-                evel_reporting_entity_id_set(&fault->header, reportEId);
-            if(srcId != NULL )
-                evel_source_id_set(&fault->header, srcId);
-            if(srcName!= NULL )
-                evel_source_name_set(&fault->header, srcName);
-    
+
             evel_rc = evel_post_event(fault_header);
 
             if(evel_rc == EVEL_SUCCESS)
-                printf("FAULT01::Fault event is correctly sent to the collector!\n");
+                printf("%s::Fault event is correctly sent to the collector!\n", job->name);
             else
-                printf("FAULT01::Post failed %d (%s)\n", evel_rc, evel_error_string());
+                printf("%s::Post failed %d (%s)\n", job->name, evel_rc, evel_error_string());
         }
         else
         {
-           printf("FAULT01::New new fault failed (%s)\n", evel_error_string());
+           printf("%s::New new fault failed (%s)\n", job->name, evel_error_string());
         }
       }
-      else if (((bytes_in > lowWaterMark) && (bytes_out > lowWaterMark) && 
+      else if (((bytes_in > lowWaterMark) && (bytes_out > lowWaterMark) &&
           (packets_in > lowWaterMark) && (packets_out > lowWaterMark)) &&
-          (fault_linkstat[i].fault_raised == 1)) 
+          (job->linkstat[i].fault_raised == 1))
       {
-         printf("\nFAULT01:: Clearing fault\n");
-         memset(event_id, 0, BUFSIZE);
-         sprintf(event_id2, "%09d", (i+1));
-         strcat(event_id, event_id1);
-         strcat(event_id, event_id2);
- 
-         ret = getIntToken(js, tokens, numToken, "tmp_faultCheckInterval", "tmp_faultInstance01", &flt_interval);
-         if (ret != 0)
-         {
-            printf("FAULT01::The parameter tmp_faultCheckInterval is not defined, defaulted to 60 seconds\n");
-            flt_interval = 60;
-         }
-
-         ret = getIntToken(js, tokens, numToken, "tmp_lowWaterMark", "tmp_faultInstance01", &lowWaterMark);
-         if (ret != 0)
-         {
-           printf("FAULT01::The parameter tmp_lowWaterMark is not defined, defaulted to 100\n");
-           lowWaterMark = 100;
-         }
-         ret = getStringToken(js, tokens, numToken, "reportingEntityName", "tmp_directParameters", reportEName, BUFSIZE);
-         if (ret != 0)
-         {
-            printf("FAULT01::Missing mandatory parameters - reportingEntityName is not there in tmp_directParameters\n");
-            printf("FAULT01::Defaulting reportingEntityName to hostname\n");
-            strcpy(reportEName, hostname);
-         }
-         ret = getStringToken(js, tokens, numToken, "sourceName", "tmp_directParameters", srcName, BUFSIZE);
-         if (ret != 0)
-         {
-            printf("FAULT01::Missing mandatory parameters - sourceName is not there in tmp_directParameters\n");
-            printf("FAULT01::Defaulting sourceName to hostname\n");
-            strcpy(srcName, hostname);
-         }
- 
-         ret = getStringToken(js, tokens, numToken, "priority", "tmp_directParameters", prio, BUFSIZE);
-         if (ret != 0)
-         {
-            printf("FAULT01::Missing mandatory parameters - priority is not there in tmp_directParameters\nDefaulting priority to Low\n");
-            strcpy(prio, "Medium");
-         }
-         priority = get_priority(prio);
-         if(priority == -1)
-         {
-            printf("FAULT01::Fault priority value is not matching, prioirty-%s \n", prio);
-            exit(1);
-         }
- 
-         ret = getStringTokenV2(js, tokens, numToken, "specificProblem", "tmp_alarmClearParameters", "tmp_faultInstance01", specProb, BUFSIZE);
-         if (ret != 0)
-         {
-            printf("FAULT01::Missing mandatory parameters - specificProblem is not there in tmp_alarmClearParameters, exiting ...\n");
-            exit(1);
-         }
- 
-         ret = getStringTokenV2(js, tokens, numToken, "alarmCondition", "tmp_alarmClearParameters", "tmp_faultInstance01", alarmCondn, BUFSIZE);
-         if (ret != 0)
-         {
-            printf("FAULT01::Missing mandatory parameters - alarmCondition is not there in tmp_alarmClearParameters, exiting ...\n");
-            exit(1);
-         }
- 
-         ret = getStringTokenV2(js, tokens, numToken, "eventSeverity", "tmp_alarmClearParameters", "tmp_faultInstance01", eventSev, BUFSIZE);
-         if (ret != 0)
-         {
-            printf("FAULT01::Missing mandatory parameters - eventSeverity is not there in tmp_alarmClearParameters\n");
-            printf("FAULT01::Defaulting eventSeverity to MAJOR\n");
-            strcpy(eventSev, "NORMAL");
-         }
-         eSev = get_severity(eventSev);
-         if(eSev == -1)
-         {
-            printf("FAULT01::Fault eventSeverity value is not matching, eventSeverity-%s \n", eventSev);
-            exit(1);
-         }
- 
-         fault = evel_new_fault(eName, event_id, alarmCondn, 
-                               specProb, priority, eSev, srcTyp,vfStat);
+         printf("\n%s:: Clearing fault\n", job->name);
+         evel_format_event_id(event_id, sizeof(event_id), "fault", i+1, EVEL_ID_DIGITS);
+
+         fault = evel_new_fault(instance->event_name, event_id,
+                                instance->clear.alarm_condition,
+                                instance->clear.specific_problem,
+                                flt->priority, instance->clear.severity,
+                                instance->source_type, flt->vf_status);
          if (fault != NULL)
          {
-            fault_linkstat[i].fault_raised = 0;
+            job->linkstat[i].fault_raised = 0;
+
+            epoch_now = evel_time_now_usec(EVEL_CLOCK_EXACT);
 
-            struct timeval tv_now;
-            gettimeofday(&tv_now, NULL);
-            epoch_now = tv_now.tv_usec + 1000000 * tv_now.tv_sec;
-  
             fault_header = (EVENT_HEADER *)fault;
-            evel_fault_category_set(fault, eCategory);
-            evel_fault_interface_set(fault, fault_linkstat[i].linkname);
-    
-            if (eType != NULL)
-              evel_fault_type_set(fault, eType); 
-      
-            evel_start_epoch_set(&fault->header, fault_linkstat[i].last_epoch);
+            set_fault_header(fault, flt, instance);
+            evel_fault_interface_set(fault, job->linkstat[i].linkname);
+
+            evel_start_epoch_set(&fault->header, job->linkstat[i].last_epoch);
             evel_last_epoch_set(&fault->header, epoch_now);
-            fault_linkstat[i].last_epoch = 0;
-
-            if(nfcCode != NULL)
-              evel_nfcnamingcode_set(&fault->header, nfcCode);
-            if(nfCode != NULL)
-              evel_nfnamingcode_set(&fault->header, nfCode);
-            evel_reporting_entity_name_set(&fault->header, reportEName);
-            if(reportEId != NULL)
-              evel_reporting_entity_id_set(&fault->header, reportEId);
-            if(srcId != NULL )
-            evel_source_id_set(&fault->header, srcId);
-            if(srcName!= NULL )
-              evel_source_name_set(&fault->header, srcName);
-      
+            job->linkstat[i].last_epoch = 0;
+
             evel_rc = evel_post_event(fault_header);
-  
+
             if(evel_rc == EVEL_SUCCESS)
-              printf("FAULT01::Fault event is correctly sent to the collector!\n");
+              printf("%s::Fault event is correctly sent to the collector!\n", job->name);
             else
-              printf("FAULT01::Post failed %d (%s)\n", evel_rc, evel_error_string());
+              printf("%s::Post failed %d (%s)\n", job->name, evel_rc, evel_error_string());
          }
-         else 
-           printf("FAULT01::New fault failed (%s)\n", evel_error_string());
+         else
+           printf("%s::New fault failed (%s)\n", job->name, evel_error_string());
       }
    }
-
-   sleep(flt_interval);
-  }
-
-  /***************************************************************************/
-  /* Terminate                                                               */
-  /***************************************************************************/
-  sleep(1);
 }
 
-void *FaultThread02(void *faultInstanceTag)
+/**************************************************************************//**
+ * Run the instance's commands, raising its fault when the first prints 1
+ * and clearing it when it prints 0.
+ *****************************************************************************/
+void check_command_fault(FLT_JOB * job, const FLT_CONFIG * flt, const FLT_INSTANCE * instance)
 {
   EVEL_ERR_CODES evel_rc = EVEL_SUCCESS;
   EVENT_FAULT * fault = NULL;
   EVENT_HEADER* fault_header = NULL;
   unsigned long long epoch_now;
-  unsigned long long last_epoch;
 
-  struct timeval time_val;
-  char event_id1[10] = "fault";
-  char event_id2[15] = {0};
-  char event_id[BUFSIZE] = {0};
-  int fault_event_id = 0;
+  char event_id[EVEL_ID_MAX_LEN + 1] = {0};
   int i=0;
 
-   int numToken;
-   jsmntok_t tokens[MAX_TOKENS];
-   char js[MAX_BUFFER_SIZE]; 
-
-   jsmn_parser p;
-   char ch[BUFSIZE];
-   int ret = 0;
-   char eName[BUFSIZE];
-   char eType[BUFSIZE];
-   char aInterface[BUFSIZE];
-   char nfcCode[BUFSIZE];
-   char nfCode[BUFSIZE];
-   char prio[BUFSIZE];
-   char reportEId[BUFSIZE];
-   char reportEName[BUFSIZE];
-   char srcId[BUFSIZE];
-   char srcName[BUFSIZE];
-   char eCategory[BUFSIZE];
-   char eventSrcTyp[BUFSIZE];
-   char specProb[BUFSIZE];
-   char alarmCondn[BUFSIZE];
-   char eventSev[BUFSIZE];
-   char vfStatus[BUFSIZE];
-
-   int priority;
-   int srcTyp;
-   int vfStat;
-   int eSev;
-
-   char hostname[BUFSIZE];
-
-   int flt_interval;
-   KEYVALRESULT keyValResultArray[32];
-   KEYVALRESULT commandArray[32];
-   int numInitCommands = 0;
-   int numCommands = 0;
-   int fault_raised = 0;
-
-   memset(hostname, 0, BUFSIZE);
-   gethostname(hostname, BUFSIZE);
-   printf("FAULT02::The hostname is %s\n", hostname);
-
-   sleep(1);
-   printf("FAULT02::Running Fault thread \n");
-   fflush(stdout);
-
-   memset(&keyValResultArray[0],0,(sizeof(KEYVALRESULT) * 32));
-
-   memset(js, 0, MAX_BUFFER_SIZE);
-   memset(ch, 0, BUFSIZE);
-
-   FILE * file = fopen("flt_config.json", "r");
-
-   while((fgets(ch, (BUFSIZE-1), file)) !=NULL)
-   {
-      strcat(js, ch);
-      memset(ch, 0, BUFSIZE);
-   }
-//   printf("FAULT02::the file content is \n %s \n", js);
-
-   jsmn_init(&p);
-   numToken = jsmn_parse(&p, js, strlen(js), tokens, MAX_TOKENS);
-   printf("FAULT02::count-%d\n", numToken);
-
-//   printToken(js,tokens, numToken);
-
-   ret = getIntToken(js, tokens, numToken, "tmp_faultCheckInterval", "tmp_faultInstance02", &flt_interval);
-   if (ret != 0)
-   {
-      printf("FAULT02::The parameter tmp_faultCheckInterval is not defined, defaulted to 60 seconds\n");
-      flt_interval = 60;
-   }
-  
-
-  read_keyVal_params(js, tokens, numToken, "tmp_init", "tmp_faultInstance02", keyValResultArray, &numInitCommands);
-
-  memset(&commandArray[0],0,(sizeof(KEYVALRESULT) * 32));
-  memcpy(commandArray, keyValResultArray, (sizeof(KEYVALRESULT) * 32)); 
-  runCommands(commandArray, numInitCommands);
-
-  gettimeofday(&time_val, NULL);
-
-  sleep(flt_interval);
-
-  /***************************************************************************/
-  /* Collect metrics from the VNIC                                           */
-  /***************************************************************************/
-  while(1) {
-
-   ret = getIntToken(js, tokens, numToken, "tmp_faultCheckInterval", "tmp_faultInstance02", &flt_interval);
-   if (ret != 0)
-   {
-      flt_interval = 60;
-   }
+   const char * noLink = "";
 
-   ret = getStringToken(js, tokens, numToken, "eventName", "tmp_faultInstance02", eName, BUFSIZE);
-   if (ret != 0)
+   if (instance->num_commands == 0)
    {
-      printf("FAULT02::Missing mandatory parameters - eventName is not there in tmp_faultInstance02. Exiting...\n");
-      exit(1);
+      return;
    }
 
-   ret = getStringToken(js, tokens, numToken, "eventType", "tmp_directParameters", eType, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "nfcNamingCode", "tmp_directParameters", nfcCode, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "nfNamingCode", "tmp_directParameters", nfCode, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "reportingEntityId", "tmp_directParameters", reportEId, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "sourceId", "tmp_directParameters", srcId, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "eventCategory", "tmp_faultInstance02", eCategory, BUFSIZE);  
-   ret = getStringToken(js, tokens, numToken, "alarmInterfaceA", "tmp_faultInstance02", aInterface, BUFSIZE);  
-
-   ret = getStringToken(js, tokens, numToken, "eventSourceType", "tmp_faultInstance02", eventSrcTyp, BUFSIZE);
-   if (ret != 0)
-   {
-      printf("FAULT02::Missing mandatory parameters - eventSourceType is not there in tmp_directParameters, exiting..\n");
-      exit(1); 
-   }
-   srcTyp = get_source(eventSrcTyp);
-   if(srcTyp == -1)
-   {
-      printf("FAULT02::Fault eventSourceType value is not matching, eventSourceType-%s \n", eventSrcTyp);
-      exit(1);
-   }
+   runCommands(instance->commands, instance->num_commands, &noLink, 1, NULL, job->probes, job->results, job->name);
 
-   ret = getStringToken(js, tokens, numToken, "vfStatus", "tmp_directParameters", vfStatus, BUFSIZE);
-   if (ret != 0)
-   {
-      printf("FAULT02::Missing mandatory parameters - vfStatus is not there in tmp_directParameters, exiting..\n");
-      exit(1); 
-   }
-   vfStat = get_vf_status(vfStatus);
-   if(vfStat == -1)
+   /********************************************************************************
+    * A command that failed or timed out says nothing about the fault
+    *******************************************************************************/
+   if (job->probes[0].state != EVEL_PROBE_SUCCESS)
    {
-      printf("FAULT02::Fault vfStatus value is not matching, vfStatus-%s \n", vfStatus);
-      exit(1);
+      printf("%s::Fault command did not succeed, fault left as it was\n", job->name);
+      return;
    }
 
-   read_keyVal_params(js, tokens, numToken, "tmp_command", "tmp_faultInstance02", keyValResultArray, &numCommands);
-
-   memset(&commandArray[0],0,(sizeof(KEYVALRESULT) * 32));
-   memcpy(commandArray, keyValResultArray, (sizeof(KEYVALRESULT) * 32)); 
-   runCommands(commandArray, numCommands);
-
    /********************************************************************************
     * Put the condition to set the fault here
     *******************************************************************************/
-   if ((atoi(commandArray[0].resultStr) == 1) && (fault_raised == 0)) 
+   if ((atoi(job->results[0][0]) == 1) && (job->fault_raised == 0))
    {
-        printf("\nFAULT02::Raising fault\n");
-        memset(event_id, 0, BUFSIZE);
-        fault_event_id = fault_event_id+1;
-        sprintf(event_id2, "%09d", fault_event_id);
-        strcat(event_id, event_id1);
-        strcat(event_id, event_id2);
-
-        ret = getIntToken(js, tokens, numToken, "tmp_faultCheckInterval", "tmp_faultInstance02", &flt_interval);
-        if (ret != 0)
-        {
-           printf("FAULT02::The parameter tmp_faultCheckInterval is not defined, defaulted to 60 seconds\n");
-           flt_interval = 60;
-        }
-
-        ret = getStringToken(js, tokens, numToken, "reportingEntityName", "tmp_directParameters", reportEName, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT02::Missing mandatory parameters - reportingEntityName is not there in tmp_directParameters\n");
-           printf("FAULT02::Defaulting reportingEntityName to hostname\n");
-           strcpy(reportEName, hostname);
-        }
-        ret = getStringToken(js, tokens, numToken, "sourceName", "tmp_directParameters", srcName, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT02::Missing mandatory parameters - sourceName is not there in tmp_directParameters\n");
-           printf("FAULT02::Defaulting sourceName to hostname\n");
-           strcpy(srcName, hostname);
-        }
-
-        ret = getStringToken(js, tokens, numToken, "priority", "tmp_directParameters", prio, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT02::Missing mandatory parameters - priority is not there in tmp_directParameters\nDefaulting priority to Low\n");
-           strcpy(prio, "Medium");
-        }
-        priority = get_priority(prio);
-        if(priority == -1)
-        {
-           printf("FAULT02::Fault priority value is not matching, prioirty-%s \n", prio);
-           exit(1);
-        }
-
-        ret = getStringTokenV2(js, tokens, numToken, "specificProblem", "tmp_alarmSetParameters", "tmp_faultInstance02", specProb, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT02::Missing mandatory parameters - specificProblem is not there in tmp_alarmSetParameters, exiting ...\n");
-           exit(1);
-        }
-        ret = getStringTokenV2(js, tokens, numToken, "alarmCondition", "tmp_alarmSetParameters", "tmp_faultInstance02", alarmCondn, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT02::Missing mandatory parameters - alarmCondition is not there in tmp_alarmSetParameters, exiting ...\n");
-           exit(1);
-        }
-        ret = getStringTokenV2(js, tokens, numToken, "eventSeverity", "tmp_alarmSetParameters", "tmp_faultInstance02", eventSev, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT02::Missing mandatory parameters - eventSeverity is not there in tmp_alarmSetParameters\n");
-           printf("FAULT02::Defaulting eventSeverity to MAJOR\n");
-           strcpy(eventSev, "MAJOR");
-        }
-        eSev = get_severity(eventSev);
-        if(eSev == -1)
-        {
-           printf("FAULT02::Fault eventSeverity value is not matching, eventSeverity-%s \n", eventSev);
-           exit(1);
-        }
-
-        fault = evel_new_fault(eName, event_id, alarmCondn, 
-                               specProb, priority, eSev, srcTyp,vfStat);
+        printf("\n%s::Raising fault\n", job->name);
+        evel_id_generator_next(&fault_event_ids, event_id, sizeof(event_id));
+
+        fault = evel_new_fault(instance->event_name, event_id,
+                               instance->set.alarm_condition,
+                               instance->set.specific_problem,
+                               flt->priority, instance->set.severity,
+                               instance->source_type, flt->vf_status);
         if (fault != NULL)
         {
-          fault_raised = 1;
+          job->fault_raised = 1;
 
-          struct timeval tv_now;
-          gettimeofday(&tv_now, NULL);
-          epoch_now = tv_now.tv_usec + 1000000 * tv_now.tv_sec;
-          last_epoch = epoch_now;
+          epoch_now = evel_time_now_usec(EVEL_CLOCK_EXACT);
+          job->last_epoch = epoch_now;
 
           fault_header = (EVENT_HEADER *)fault;
 
-          evel_fault_category_set(fault, eCategory);
-          if (aInterface != NULL)
-            evel_fault_interface_set(fault, aInterface);
-  
-          if (eType != NULL)
-            evel_fault_type_set(fault, eType); 
-    
+          set_fault_header(fault, flt, instance);
+          if (instance->alarm_interface != NULL)
+            evel_fault_interface_set(fault, instance->alarm_interface);
+
           evel_start_epoch_set(&fault->header, epoch_now);
           evel_last_epoch_set(&fault->header, epoch_now);
-          if(nfcCode != NULL)
-            evel_nfcnamingcode_set(&fault->header, nfcCode);
-          if(nfCode != NULL)
-            evel_nfnamingcode_set(&fault->header, nfCode);
-          evel_reporting_entity_name_set(&fault->header, reportEName);
-          if(reportEId != NULL)
-            evel_reporting_entity_id_set(&fault->header, reportEId);
-          if(srcId != NULL )
-          evel_source_id_set(&fault->header, srcId);
-          if(srcName!= NULL )
-            evel_source_name_set(&fault->header, srcName);
-    
+
           evel_rc = evel_post_event(fault_header);
 
           if(evel_rc == EVEL_SUCCESS) {
-            printf("FAULT02::Fault event is correctly sent to the collector!\n");
+            printf("%s::Fault event is correctly sent to the collector!\n", job->name);
           }
           else {
-            printf("FAULT02::Post failed %d (%s)\n", evel_rc, evel_error_string());
+            printf("%s::Post failed %d (%s)\n", job->name, evel_rc, evel_error_string());
         }
       }
       else {
-        printf("FAULT02::New new fault failed (%s)\n", evel_error_string());
+        printf("%s::New new fault failed (%s)\n", job->name, evel_error_string());
       }
     }
     /********************************************************************************
      * Put the condition to clear the fault here
      *******************************************************************************/
-    else if ((atoi(commandArray[0].resultStr) == 0) && (fault_raised == 1)) 
+    else if ((atoi(job->results[0][0]) == 0) && (job->fault_raised == 1))
     {
-        printf("\nFAULT02:: Clearing fault\n");
-        memset(event_id, 0, BUFSIZE);
-        sprintf(event_id2, "%09d", (i+1));
-        strcat(event_id, event_id1);
-        strcat(event_id, event_id2);
-
-        ret = getIntToken(js, tokens, numToken, "tmp_faultCheckInterval", "tmp_faultInstance02", &flt_interval);
-        if (ret != 0)
-        {
-           printf("FAULT02::The parameter tmp_faultCheckInterval is not defined, defaulted to 60 seconds\n");
-           flt_interval = 60;
-        }
-
-        ret = getStringToken(js, tokens, numToken, "reportingEntityName", "tmp_directParameters", reportEName, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT02::Missing mandatory parameters - reportingEntityName is not there in tmp_directParameters\n");
-           printf("FAULT02::Defaulting reportingEntityName to hostname\n");
-           strcpy(reportEName, hostname);
-        }
-        ret = getStringToken(js, tokens, numToken, "sourceName", "tmp_directParameters", srcName, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT02::Missing mandatory parameters - sourceName is not there in tmp_directParameters\n");
-           printf("FAULT02::Defaulting sourceName to hostname\n");
-           strcpy(srcName, hostname);
-        }
-
-        ret = getStringToken(js, tokens, numToken, "priority", "tmp_directParameters", prio, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT02::Missing mandatory parameters - priority is not there in tmp_directParameters\nDefaulting priority to Low\n");
-           strcpy(prio, "Medium");
-        }
-        priority = get_priority(prio);
-        if(priority == -1)
-        {
-           printf("FAULT02::Fault priority value is not matching, prioirty-%s \n", prio);
-           exit(1);
-        }
-
-        ret = getStringTokenV2(js, tokens, numToken, "specificProblem", "tmp_alarmClearParameters", "tmp_faultInstance02", specProb, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT02::Missing mandatory parameters - specificProblem is not there in tmp_alarmClearParameters, exiting ...\n");
-           exit(1);
-        }
-
-        ret = getStringTokenV2(js, tokens, numToken, "alarmCondition", "tmp_alarmClearParameters", "tmp_faultInstance02", alarmCondn, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT02::Missing mandatory parameters - alarmCondition is not there in tmp_alarmClearParameters, exiting ...\n");
-           exit(1);
-        }
-
-        ret = getStringTokenV2(js, tokens, numToken, "eventSeverity", "tmp_alarmClearParameters", "tmp_faultInstance02", eventSev, BUFSIZE);
-        if (ret != 0)
-        {
-           printf("FAULT02::Missing mandatory parameters - eventSeverity is not there in tmp_alarmClearParameters\n");
-           printf("FAULT02::Defaulting eventSeverity to MAJOR\n");
-           strcpy(eventSev, "NORMAL");
-        }
-        eSev = get_severity(eventSev);
-        if(eSev == -1)
-        {
-           printf("FAULT02::Fault eventSeverity value is not matching, eventSeverity-%s \n", eventSev);
-           exit(1);
-        }
-
-        fault = evel_new_fault(eName, event_id, alarmCondn, 
-                               specProb, priority, eSev, srcTyp,vfStat);
+        printf("\n%s:: Clearing fault\n", job->name);
+        evel_format_event_id(event_id, sizeof(event_id), "fault", i+1, EVEL_ID_DIGITS);
+
+        fault = evel_new_fault(instance->event_name, event_id,
+                               instance->clear.alarm_condition,
+                               instance->clear.specific_problem,
+                               flt->priority, instance->clear.severity,
+                               instance->source_type, flt->vf_status);
         if (fault != NULL)
         {
-          fault_raised = 0;
+          job->fault_raised = 0;
 
-          struct timeval tv_now;
-          gettimeofday(&tv_now, NULL);
-          epoch_now = tv_now.tv_usec + 1000000 * tv_now.tv_sec;
+          epoch_now = evel_time_now_usec(EVEL_CLOCK_EXACT);
 
           fault_header = (EVENT_HEADER *)fault;
-          evel_fault_category_set(fault, eCategory);
-          if (aInterface != NULL)
-            evel_fault_interface_set(fault, aInterface);
-  
-          if (eType != NULL)
-            evel_fault_type_set(fault, eType); 
-    
-          evel_start_epoch_set(&fault->header, last_epoch);
+          set_fault_header(fault, flt, instance);
+          if (instance->alarm_interface != NULL)
+            evel_fault_interface_set(fault, instance->alarm_interface);
+
+          evel_start_epoch_set(&fault->header, job->last_epoch);
           evel_last_epoch_set(&fault->header, epoch_now);
-          last_epoch = 0;
-
-          if(nfcCode != NULL)
-            evel_nfcnamingcode_set(&fault->header, nfcCode);
-          if(nfCode != NULL)
-            evel_nfnamingcode_set(&fault->header, nfCode);
-          evel_reporting_entity_name_set(&fault->header, reportEName);
-          if(reportEId != NULL)
-            evel_reporting_entity_id_set(&fault->header, reportEId);
-          if(srcId != NULL )
-          evel_source_id_set(&fault->header, srcId);
-          if(srcName!= NULL )
-            evel_source_name_set(&fault->header, srcName);
-    
+          job->last_epoch = 0;
+
           evel_rc = evel_post_event(fault_header);
 
           if(evel_rc == EVEL_SUCCESS) {
-            printf("FAULT02::Fault event is correctly sent to the collector!\n");
+            printf("%s::Fault event is correctly sent to the collector!\n", job->name);
           }
           else {
-            printf("FAULT02::Post failed %d (%s)\n", evel_rc, evel_error_string());
+            printf("%s::Post failed %d (%s)\n", job->name, evel_rc, evel_error_string());
         }
       }
       else {
-        printf("FAULT02::New fault failed (%s)\n", evel_error_string());
+        printf("%s::New fault failed (%s)\n", job->name, evel_error_string());
       }
 
     }
+}
+
+/**************************************************************************//**
+ * Scheduled job for one fault instance.  The first run takes the initial
+ * readings, and each later run checks for the fault.  An instance that has
+ * been removed from flt_config.json is left idle.
+ *****************************************************************************/
+void FaultJob(void * context, unsigned long long scheduled)
+{
+  FLT_JOB * job = context;
+  FLT_CONFIG * flt;
+  const FLT_INSTANCE * instance;
+  const EVEL_IF_SNAPSHOT * snapshot;
+  int linkCount;
+  int i;
 
-    sleep(flt_interval);
+  flt = acquire_flt_config();
+  instance = find_instance(flt, job->name);
+  if (instance == NULL)
+  {
+     evel_config_watch_release(flt_config_watch, flt);
+     return;
   }
+  evel_scheduler_job_interval_set(job->job, instance->interval * 1000);
 
-  /***************************************************************************/
-  /* Terminate                                                               */
-  /***************************************************************************/
-  sleep(1);
+  if (!job->initialized)
+  {
+     if (instance->per_link)
+     {
+        linkCount = update_links(job, flt);
+        printf("%s::Array link count is %d\n", job->name, linkCount);
+        snapshot = read_if_snapshot(&job->snapshot, instance->init_commands, instance->num_init_commands);
+        runCommands(instance->init_commands, instance->num_init_commands, job->link_names, linkCount, snapshot, job->probes, job->results, job->name);
+        for(i=0;i<linkCount;i++)
+        {
+           copy_vpp_metic_data(job->intfstat, instance->init_commands, &job->probes[i * instance->num_init_commands], job->results[i], instance->num_init_commands, i);
+        }
+     }
+     else
+     {
+        const char * noLink = "";
+        runCommands(instance->init_commands, instance->num_init_commands, &noLink, 1, NULL, job->probes, job->results, job->name);
+     }
+     job->initialized = 1;
+  }
+  else if (instance->per_link)
+  {
+     check_link_faults(job, flt, instance);
+  }
+  else
+  {
+     check_command_fault(job, flt, instance);
+  }
+
+  evel_config_watch_release(flt_config_watch, flt);
+}
+
+/**************************************************************************//**
+ * Add a job for each fault instance that does not have one yet.
+ *****************************************************************************/
+void schedule_instances(const FLT_CONFIG * flt)
+{
+  const FLT_INSTANCE * instance;
+  FLT_JOB * job;
+  int i;
+
+  for (i = 0; i < flt->num_instances; i++)
+  {
+    instance = &flt->instances[i];
+    for (job = flt_jobs; job != NULL; job = job->next)
+    {
+      if (strcmp(job->name, instance->name) == 0)
+      {
+        break;
+      }
+    }
+    if (job != NULL)
+    {
+      continue;
+    }
+
+    job = calloc(1, sizeof(FLT_JOB));
+    if (job == NULL || (job->name = strdup(instance->name)) == NULL ||
+        evel_if_snapshot_init(&job->snapshot) != EVEL_SUCCESS)
+    {
+      printf("FAULT::Failed to allocate state for %s\n", instance->name);
+      if (job != NULL)
+      {
+        free(job->name);
+        free(job);
+      }
+      continue;
+    }
+    job->job = evel_scheduler_job_add(flt_scheduler, job->name, instance->interval * 1000, FaultJob, job);
+    if (job->job == NULL)
+    {
+      printf("FAULT::Failed to schedule %s\n", instance->name);
+      evel_if_snapshot_free(&job->snapshot);
+      free(job->name);
+      free(job);
+      continue;
+    }
+    job->next = flt_jobs;
+    flt_jobs = job;
+    printf("FAULT::Scheduled %s every %d seconds\n", instance->name, instance->interval);
+  }
+}
+
+/**************************************************************************//**
+ * Scheduled job to pick up changes to flt_config.json, including new fault
+ * instances, between the instances' own checks.
+ *****************************************************************************/
+void ConfigJob(void * context, unsigned long long scheduled)
+{
+  FLT_CONFIG * flt;
+
+  flt = acquire_flt_config();
+  schedule_instances(flt);
+  update_rules(flt);
+  evel_config_watch_release(flt_config_watch, flt);
+}
+
+/**************************************************************************//**
+ * Load flt_config.json and schedule its fault instances, and a job to pick
+ * up changes to it, on flt_scheduler.  The scheduler is left for the caller
+ * to start.
+ *
+ * @returns 0 on success, or -1 on failure.
+ *****************************************************************************/
+int start_faults(void)
+{
+   FLT_CONFIG * flt;
+
+   memset(fault_hostname, 0, BUFSIZE);
+   gethostname(fault_hostname, BUFSIZE);
+   printf("FAULT::The hostname is %s\n", fault_hostname);
+
+   /***************************************************************************/
+   /* The configuration is parsed once, and again only when the file changes. */
+   /***************************************************************************/
+   flt_config_watch = evel_new_config_watch(flt_config_file,
+                                            compile_flt_config,
+                                            free_flt_config,
+                                            fault_hostname);
+   if (flt_config_watch == NULL)
+   {
+      printf("FAULT::Failed to load %s\n", flt_config_file);
+      return -1;
+   }
+
+   /***************************************************************************/
+   /* Every instance is checked on its own interval's boundaries, by a small  */
+   /* pool of workers however many instances there are.                       */
+   /***************************************************************************/
+   if (flt_scheduler == NULL)
+   {
+      flt_scheduler = evel_new_scheduler(MAX_FAULT_WORKERS);
+   }
+   if (flt_scheduler == NULL)
+   {
+      printf("FAULT::Failed to create the scheduler\n");
+      evel_free_config_watch(flt_config_watch);
+      flt_config_watch = NULL;
+      return -1;
+   }
+
+   printf("FAULT::Scheduling fault instances\n");
+
+   flt = evel_config_watch_acquire(flt_config_watch);
+   schedule_instances(flt);
+   update_rules(flt);
+   evel_config_watch_release(flt_config_watch, flt);
+
+   if (evel_scheduler_job_add(flt_scheduler, "flt_config", CONFIG_CHECK_INTERVAL * 1000, ConfigJob, NULL) == NULL)
+   {
+      printf("FAULT::Failed to schedule the configuration check\n");
+      return -1;
+   }
+
+   return 0;
 }
 
-void *FaultThread03(void *faultInstanceTag)
+#ifndef VES_AGENT_PLUGIN
+void *FaultThread(void *mainFault)
 {
-  sleep(4);
-  printf("FAULT03::thread created\n");
-  fflush(stdout);
-  while (1)
-  { sleep (100); }
+   sleep(1);
+   printf("Running Main Fault thread \n");
+   fflush(stdout);
+
+   if (start_faults() != 0 ||
+       evel_scheduler_start(flt_scheduler) != EVEL_SUCCESS)
+   {
+      printf("Main Fault Thread::Failed to start checking for faults. Exiting...\n");
+      exit(1);
+   }
+
+   while(1)
+   {
+       sleep(100);
+   }
+}
+#endif
+
+#ifdef VES_AGENT_PLUGIN
+/**************************************************************************//**
+ * Start checking for faults in the VES agent.
+ *****************************************************************************/
+int flt_plugin_start(const VES_PLUGIN_HOST * host, const char * config_file)
+{
+  flt_scheduler = host->scheduler;
+  flt_config_file = config_file;
+
+  evel_id_generator_init(&fault_event_ids, "fault", 1);
+
+  /***************************************************************************/
+  /* The jobs run on the agent's scheduler, which the agent starts, so there */
+  /* is no thread of our own.                                                */
+  /***************************************************************************/
+  return start_faults();
 }
 
+const VES_PLUGIN ves_plugin = {
+  VES_PLUGIN_API_VERSION,
+  "fault",
+  flt_plugin_start
+};
+#endif
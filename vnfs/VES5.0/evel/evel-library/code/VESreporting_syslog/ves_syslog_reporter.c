@@ -21,112 +21,332 @@
 #include <pthread.h>
 #include <string.h>
 #include <netdb.h>
+#include <limits.h>
 #include <sys/time.h>
 #include <sys/stat.h>
-#include "jsmn.h"
 #include "evel.h"
+#ifdef VES_AGENT_PLUGIN
+#include "ves_plugin.h"
+#endif
 
 #define BUFSIZE 128
-#define MAX_BUFFER_SIZE 4096
-#define MAX_TOKENS 1000
+#define TAIL_TIMEOUT_MS 1000
+#define SOURCE_KEY_SIZE (2 * PATH_MAX)
+
+/*****************************************************************************/
+/* Coalescing of matching messages into batches, unless configured with     */
+/* tmp_coalesceWindowMs and tmp_coalesceMaxEvents.                           */
+/*****************************************************************************/
+#define DEFAULT_COALESCE_WINDOW_MS 250
+#define DEFAULT_COALESCE_MAX_EVENTS 50
+#define MAX_COALESCE_EVENTS 500
 
 void *SyslogThread(void *threadarg);
+int start_syslog(void);
+void free_syslog_config(void * compiled);
+
+/*****************************************************************************/
+/* Lines containing these are the reporter's own events being logged.        */
+/*****************************************************************************/
+static const char * const syslog_self_patterns[] = {
+  "EVEL", "commonEventHeader", "syslogMsg", "syslogTag"
+};
+#define NUM_SELF_PATTERNS ((int) (sizeof(syslog_self_patterns) / \
+                                  sizeof(syslog_self_patterns[0])))
+
+/**************************************************************************//**
+ * A tag reported when it is seen in the syslog file, and the severity to
+ * report it with.
+ *****************************************************************************/
+typedef struct syslog_tag {
+  const char * tag;
+  const char * severity;
+} SYSLOG_TAG;
+
+/**************************************************************************//**
+ * Syslog parameters, compiled from syslog_config.json.  The strings point
+ * into the parsed file.
+ *****************************************************************************/
+typedef struct syslog_config {
+  const char * event_name;
+  const char * event_type;
+  const char * nfc_naming_code;
+  const char * nf_naming_code;
+  const char * reporting_entity_name;
+  const char * reporting_entity_id;
+  const char * source_id;
+  const char * source_name;
+  const char * syslog_proc;
+  const char * syslog_file;
+  const char * syslog_socket;
+  const char * udp_address;
+  int udp_port;
+  int coalesce_window_ms;
+  int coalesce_max_events;
+  int source_type;
+  int num_tags;
+  SYSLOG_TAG * tags;
+  EVEL_MATCHER * matcher;     /** Tags, and exclusions, in one pass.         */
+} SYSLOG_CONFIG;
+
+/**************************************************************************//**
+ * An event held in the coalescing window, and how many times its message
+ * has been seen.
+ *****************************************************************************/
+typedef struct syslog_pending {
+  EVENT_SYSLOG * event;
+  const SYSLOG_TAG * tag;
+  unsigned long hash;
+  char * text;
+  int count;
+} SYSLOG_PENDING;
 
 unsigned long long epoch_start = 0;
-
-void report_syslog(char * js, jsmntok_t * tokens, int numToken, char * syslog_tag, char * eName, int srcTyp, char * syslog_msg)
+EVEL_ID_GENERATOR syslog_event_ids;
+
+/*****************************************************************************/
+/* Events held in the coalescing window, and when the window closes.  Only   */
+/* the syslog thread uses these.                                             */
+/*****************************************************************************/
+SYSLOG_PENDING pending[MAX_COALESCE_EVENTS];
+int num_pending = 0;
+unsigned long long pending_deadline = 0;
+
+/*****************************************************************************/
+/* syslog_config.json, reloaded on change.                                   */
+/*****************************************************************************/
+const char * syslog_config_file = "syslog_config.json";
+EVEL_CONFIG_WATCH * syslog_config_watch;
+
+/*****************************************************************************/
+/* Where messages are read from: the file followed, or the sockets received  */
+/* on, and the settings they were opened with.                               */
+/*****************************************************************************/
+EVEL_TAIL * syslog_tail = NULL;
+EVEL_SYSLOG_RECEIVER * syslog_receiver = NULL;
+char syslog_source[SOURCE_KEY_SIZE];
+
+/**************************************************************************//**
+ * Create the event for a syslog message.  received is the parsed message
+ * when it was received from a socket, and NULL when it was read from the
+ * syslog file.
+ *****************************************************************************/
+EVENT_SYSLOG * new_syslog_event(const SYSLOG_CONFIG * cfg, const SYSLOG_TAG * tag, const char * syslog_msg,
+                                const EVEL_SYSLOG_MESSAGE * received)
 {
-  EVENT_HEARTBEAT_FIELD * event = NULL;
-  EVENT_HEADER* syslog_header = NULL;
-  EVEL_ERR_CODES evel_rc = EVEL_SUCCESS;
-  char stringVal[BUFSIZE];
+  EVENT_SYSLOG * event = NULL;
 
-  char event_id1[10] = "syslog";
-  char event_id2[15] = {0};
-  int event_id3 = 0;
-  char event_id[BUFSIZE] = {0};
+  char event_id[EVEL_ID_MAX_LEN + 1] = {0};
 
-  int ret = 0;
   /***************************************************************************/
   /* Syslog                                                               */
   /***************************************************************************/
-  memset(event_id, 0, BUFSIZE);
-  memset(event_id2, 0, 15);
-  sprintf(event_id2, "%09d", event_id3++);
-  strcat(event_id, event_id1);
-  strcat(event_id, event_id2);
+  evel_id_generator_next(&syslog_event_ids, event_id, sizeof(event_id));
 
      
-  event = evel_new_syslog(eName, event_id, srcTyp, syslog_msg, syslog_tag);
+  event = evel_new_syslog(cfg->event_name, event_id, cfg->source_type, syslog_msg, tag->tag);
   
   if (event != NULL)
   {
-       syslog_header = (EVENT_HEADER *)event;
-
-       ret = getStringToken(js, tokens, numToken, "syslogProc", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-          evel_syslog_proc_set(event, stringVal);
-       evel_syslog_facility_set(event, EVEL_SYSLOG_FACILITY_LOCAL0);
-       ret = getStringToken(js, tokens, numToken, "eventType", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-         evel_header_type_set(&event->header, stringVal);
+       if (received == NULL)
+       {
+         if (cfg->syslog_proc != NULL)
+            evel_syslog_proc_set(event, cfg->syslog_proc);
+         evel_syslog_facility_set(event, EVEL_SYSLOG_FACILITY_LOCAL0);
+         if (tag->severity != NULL)
+           evel_syslog_severity_set(event, tag->severity);
+       }
+       else
+       {
+         /*********************************************************************/
+         /* A received message carries its own fields.                        */
+         /*********************************************************************/
+         if (received->app_name != NULL)
+            evel_syslog_proc_set(event, received->app_name);
+         else if (cfg->syslog_proc != NULL)
+            evel_syslog_proc_set(event, cfg->syslog_proc);
+         if (received->proc_id > 0)
+            evel_syslog_proc_id_set(event, received->proc_id);
+         evel_syslog_facility_set(event, received->facility);
+         evel_syslog_severity_set(event, (tag->severity != NULL) ?
+                                  tag->severity : evel_syslog_severity_name(received->severity));
+         if (received->hostname != NULL)
+            evel_syslog_event_source_host_set(event, received->hostname);
+         if (received->version > 0)
+            evel_syslog_version_set(event, received->version);
+         if (received->structured_data != NULL)
+            evel_syslog_s_data_set(event, received->structured_data);
+         if (received->sdid[0] != '\0')
+            evel_syslog_sdid_set(event, received->sdid);
+       }
+       if (cfg->event_type != NULL)
+         evel_header_type_set(&event->header, cfg->event_type);
 
-       struct timeval tv_now;
-       gettimeofday(&tv_now, NULL);
-       unsigned long long epoch_now = tv_now.tv_usec + 1000000 * tv_now.tv_sec;
+       unsigned long long epoch_now = evel_time_now_usec(EVEL_CLOCK_EXACT);
 
        evel_start_epoch_set(&event->header, epoch_start);
        evel_last_epoch_set(&event->header, epoch_now);
        epoch_start = epoch_now;
 
-       ret = getStringToken(js, tokens, numToken, "nfcNamingCode", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-         evel_nfcnamingcode_set(&event->header, stringVal);
+       if (cfg->nfc_naming_code != NULL)
+         evel_nfcnamingcode_set(&event->header, cfg->nfc_naming_code);
  
-       ret = getStringToken(js, tokens, numToken, "nfNamingCode", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-         evel_nfnamingcode_set(&event->header, stringVal);
-
-       ret = getStringToken(js, tokens, numToken, "reportingEntityName", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-         evel_reporting_entity_name_set(&event->header, stringVal);
-       else 
-       {
-          printf("Missing mandatory parameters - reportingEntityName is not there in tmp_directParameters\n");
-          printf("Defaulting reportingEntityName to hostname\n");
-       }
+       if (cfg->nf_naming_code != NULL)
+         evel_nfnamingcode_set(&event->header, cfg->nf_naming_code);
 
-       ret = getStringToken(js, tokens, numToken, "reportingEntityId", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-         evel_reporting_entity_id_set(&event->header, stringVal);
+       if (cfg->reporting_entity_name != NULL)
+         evel_reporting_entity_name_set(&event->header, cfg->reporting_entity_name);
 
-       ret = getStringToken(js, tokens, numToken, "sourceId", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-         evel_source_id_set(&event->header, stringVal);
+       if (cfg->reporting_entity_id != NULL)
+         evel_reporting_entity_id_set(&event->header, cfg->reporting_entity_id);
 
-       ret = getStringToken(js, tokens, numToken, "sourceName", "tmp_directParameters", stringVal, BUFSIZE);
-       if (ret == 0)
-         evel_source_name_set(&event->header, stringVal);
-       else 
-       {
-          printf("Missing mandatory parameters - sourceName is not there in tmp_directParameters\n");
-          printf("Defaulting sourceName to hostname\n");
-       }
+       if (cfg->source_id != NULL)
+         evel_source_id_set(&event->header, cfg->source_id);
 
-       evel_rc = evel_post_event(syslog_header);
-       if (evel_rc != EVEL_SUCCESS)
-       {
-         EVEL_ERROR("Post failed %d (%s)", evel_rc, evel_error_string());
-       }
+       if (cfg->source_name != NULL)
+         evel_source_name_set(&event->header, cfg->source_name);
     }
     else
     {
       EVEL_ERROR("New Syslog failed");
     }
+    return event;
+}
+
+/**************************************************************************//**
+ * Post a syslog event, or a batch of them.
+ *****************************************************************************/
+void post_syslog(EVENT_HEADER * syslog_header)
+{
+  EVEL_ERR_CODES evel_rc = EVEL_SUCCESS;
+
+  evel_rc = evel_post_event(syslog_header);
+  if (evel_rc != EVEL_SUCCESS)
+  {
+    EVEL_ERROR("Post failed %d (%s)", evel_rc, evel_error_string());
+  }
+}
+
+/**************************************************************************//**
+ * Post the events coalesced so far: alone if there is only one, otherwise
+ * together in one batch.  An event seen more than once carries a
+ * repeatCount.
+ *****************************************************************************/
+void flush_syslog()
+{
+  EVENT_HEADER * batch = NULL;
+  char batch_id[EVEL_ID_MAX_LEN + 1] = {0};
+  char count[16];
+  int ii;
+
+  if (num_pending == 0)
+  {
+    return;
+  }
+
+  if (num_pending > 1)
+  {
+    evel_id_generator_next(&syslog_event_ids, batch_id, sizeof(batch_id));
+    batch = evel_new_batch(pending[0].event->header.event_name, batch_id);
+  }
+
+  for (ii = 0; ii < num_pending; ii++)
+  {
+    if (pending[ii].count > 1)
+    {
+      snprintf(count, sizeof(count), "%d", pending[ii].count);
+      evel_syslog_addl_field_add(pending[ii].event, "repeatCount", count);
+    }
+
+    if (batch != NULL)
+    {
+      evel_batch_add_event(batch, &pending[ii].event->header);
+    }
+    else
+    {
+      post_syslog(&pending[ii].event->header);
+    }
+    free(pending[ii].text);
+  }
+
+  if (batch != NULL)
+  {
+    post_syslog(batch);
+  }
+  printf("   Processed %d Syslog\n", num_pending);
+  num_pending = 0;
+}
+
+/**************************************************************************//**
+ * Report a syslog message.  Within the coalescing window, messages are
+ * held to be posted together, and repeats of a held message are counted
+ * rather than reported again.
+ *****************************************************************************/
+void report_syslog(const SYSLOG_CONFIG * cfg, const SYSLOG_TAG * tag, const char * syslog_msg,
+                   const EVEL_SYSLOG_MESSAGE * received)
+{
+  EVENT_SYSLOG * event;
+  unsigned long hash = 5381;
+  const unsigned char * pos;
+  unsigned long long now;
+  int ii;
+
+  if (cfg->coalesce_window_ms == 0 || cfg->coalesce_max_events <= 1)
+  {
+    event = new_syslog_event(cfg, tag, syslog_msg, received);
+    if (event != NULL)
+    {
+      post_syslog(&event->header);
+    }
     printf("   Processed Syslog\n");
+    return;
+  }
+
+  for (pos = (const unsigned char *) syslog_msg; *pos != '\0'; pos++)
+  {
+    hash = hash * 33 + *pos;
+  }
+
+  now = evel_time_now_usec(EVEL_CLOCK_EXACT);
+  for (ii = 0; ii < num_pending; ii++)
+  {
+    if (pending[ii].hash == hash && pending[ii].tag == tag &&
+        strcmp(pending[ii].text, syslog_msg) == 0)
+    {
+      pending[ii].count++;
+      evel_last_epoch_set(&pending[ii].event->header, now);
+      return;
+    }
+  }
+
+  event = new_syslog_event(cfg, tag, syslog_msg, received);
+  if (event == NULL)
+  {
+    return;
+  }
+
+  pending[num_pending].event = event;
+  pending[num_pending].tag = tag;
+  pending[num_pending].hash = hash;
+  pending[num_pending].text = strdup(syslog_msg);
+  pending[num_pending].count = 1;
+  if (pending[num_pending].text == NULL)
+  {
+    post_syslog(&event->header);
+    return;
+  }
+  if (num_pending++ == 0)
+  {
+    pending_deadline = now + cfg->coalesce_window_ms * 1000ULL;
+  }
+
+  if (num_pending >= cfg->coalesce_max_events)
+  {
+    flush_syslog();
+  }
 }
 
-int get_source(char * inStr)
+int get_source(const char * inStr)
 {
    int result = -1;
 
@@ -155,6 +375,7 @@ int get_source(char * inStr)
 }
 
 
+#ifndef VES_AGENT_PLUGIN
 int main(int argc, char** argv)
 {
   char* fqdn = argv[1];
@@ -219,6 +440,14 @@ int main(int argc, char** argv)
   pthread_attr_init(&attr);
   pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
 
+  evel_id_generator_init(&syslog_event_ids, "syslog", 0);
+
+  if (start_syslog() != 0)
+  {
+    printf("Failed to start reporting syslog. Exiting...\n");
+    exit(1);
+  }
+
   printf("Main:Creating thread \n");
   rc = pthread_create(&syslog_thread, NULL, SyslogThread, &i);
   if (rc)
@@ -234,142 +463,502 @@ int main(int argc, char** argv)
   printf("Terminated\n");
   return 0;
 }
+#endif
 
-void *SyslogThread(void *threadarg)
+/**************************************************************************//**
+ * Compile the tags to report, from syslogTag and syslogTags, and the lines
+ * to ignore, from syslogExcludes, into a single matcher.
+ *
+ * syslogTags entries are either a tag, or an object giving the tag and the
+ * severity to report it with.  syslogSev is the default severity.
+ *
+ * @returns 0 on success, -1 if the tags are missing or invalid.
+ *****************************************************************************/
+int compile_syslog_tags(const EVEL_CONFIG * config,
+                        const EVEL_CONFIG_NODE * direct,
+                        SYSLOG_CONFIG * cfg)
 {
+  const EVEL_CONFIG_NODE * tags;
+  const EVEL_CONFIG_NODE * excludes;
+  const EVEL_CONFIG_NODE * node;
+  const char * single;
+  const char * severity;
+  SYSLOG_TAG * tag;
+  int max_tags = 0;
+  int ii;
+
+  single = evel_config_string(config, direct, "syslogTag", NULL);
+  severity = evel_config_string(config, direct, "syslogSev", NULL);
+  tags = evel_config_find(config, direct, "syslogTags");
+  excludes = evel_config_find(config, direct, "syslogExcludes");
+
+  if (single != NULL)
+  {
+    max_tags++;
+  }
+  if (tags != NULL && tags->type == EVEL_CONFIG_ARRAY)
+  {
+    max_tags += tags->size;
+  }
+  if (max_tags == 0)
+  {
+    printf("Missing mandatory parameters - syslogTag or syslogTags is not there in tmp_directParameters\n");
+    return -1;
+  }
 
-  int numToken;
-  jsmntok_t tokens[MAX_TOKENS];
-  char js[MAX_BUFFER_SIZE]; 
-  FILE * fp;
-  jsmn_parser p;
-  char ch[BUFSIZE];
-  int ret = 0;
-  char eName[BUFSIZE];
-  char eventSrcTyp[BUFSIZE];
-  char syslog_tag[BUFSIZE];
-  char syslog_msg[8*BUFSIZE];
-  char str[8*BUFSIZE];
-  char syslog_file[BUFSIZE];
-  int srcTyp = 0;
-  int count = 0;
-  unsigned long long pos;
-  unsigned long long prevpos = 0;
-
-  sleep(1);
-  printf("Running Syslog thread \n");
-  fflush(stdout);
+  cfg->tags = calloc(max_tags, sizeof(SYSLOG_TAG));
+  cfg->matcher = evel_new_matcher();
+  if (cfg->tags == NULL || cfg->matcher == NULL)
+  {
+    return -1;
+  }
 
-  while(1)
+  if (single != NULL)
   {
+    cfg->tags[cfg->num_tags].tag = single;
+    cfg->tags[cfg->num_tags].severity = severity;
+    cfg->num_tags++;
+  }
 
-     FILE * file = fopen("syslog_config.json", "r");
+  for (node = (tags != NULL && tags->type == EVEL_CONFIG_ARRAY) ?
+              evel_config_child(config, tags) : NULL;
+       node != NULL;
+       node = evel_config_next(config, node))
+  {
+    tag = &cfg->tags[cfg->num_tags];
+    if (node->type == EVEL_CONFIG_STRING)
+    {
+      tag->tag = node->value;
+      tag->severity = severity;
+    }
+    else
+    {
+      tag->tag = evel_config_string(config, node, "tag", NULL);
+      tag->severity = evel_config_string(config, node, "severity", severity);
+    }
+    if (tag->tag == NULL || *tag->tag == '\0')
+    {
+      printf("Invalid syslogTags entry %d in tmp_directParameters\n", cfg->num_tags);
+      return -1;
+    }
+    cfg->num_tags++;
+  }
+
+  for (ii = 0; ii < cfg->num_tags; ii++)
+  {
+    if (evel_matcher_include(cfg->matcher, cfg->tags[ii].tag, ii) != EVEL_SUCCESS)
+    {
+      return -1;
+    }
+  }
 
-     memset(js, 0, MAX_BUFFER_SIZE);
-     memset(ch, 0, BUFSIZE);
+  for (ii = 0; ii < NUM_SELF_PATTERNS; ii++)
+  {
+    if (evel_matcher_exclude(cfg->matcher, syslog_self_patterns[ii]) != EVEL_SUCCESS)
+    {
+      return -1;
+    }
+  }
 
-     while((fgets(ch, (BUFSIZE-1), file)) !=NULL)
+  for (node = (excludes != NULL && excludes->type == EVEL_CONFIG_ARRAY) ?
+              evel_config_child(config, excludes) : NULL;
+       node != NULL;
+       node = evel_config_next(config, node))
+  {
+    if (node->type != EVEL_CONFIG_STRING ||
+        evel_matcher_exclude(cfg->matcher, node->value) != EVEL_SUCCESS)
+    {
+      printf("Invalid syslogExcludes entry in tmp_directParameters\n");
+      return -1;
+    }
+  }
+
+  if (evel_matcher_compile(cfg->matcher) != EVEL_SUCCESS)
+  {
+    return -1;
+  }
+
+  return 0;
+}
+
+/**************************************************************************//**
+ * Compile syslog_config.json.
+ *****************************************************************************/
+void * compile_syslog_config(const EVEL_CONFIG * config, void * context)
+{
+  const EVEL_CONFIG_NODE * direct;
+  const EVEL_CONFIG_NODE * indirect;
+  const char * srcTyp;
+  SYSLOG_CONFIG * cfg;
+
+  direct = evel_config_find(config, NULL, "tmp_directParameters");
+  indirect = evel_config_find(config, NULL, "tmp_indirectParameters");
+  if (direct == NULL || indirect == NULL)
+  {
+    printf("Missing mandatory parameters - tmp_directParameters or tmp_indirectParameters is not there\n");
+    return NULL;
+  }
+
+  cfg = calloc(1, sizeof(SYSLOG_CONFIG));
+  if (cfg == NULL)
+  {
+    return NULL;
+  }
+
+  /***************************************************************************/
+  /* Messages are received on the syslog sockets if any are given, and       */
+  /* otherwise read from the syslog file.                                    */
+  /***************************************************************************/
+  cfg->syslog_file = evel_config_string(config, indirect, "tmp_syslogFile", NULL);
+  cfg->syslog_socket = evel_config_string(config, indirect, "tmp_syslogSocket", NULL);
+  cfg->udp_address = evel_config_string(config, indirect, "tmp_syslogUdpAddress", NULL);
+  cfg->udp_port = evel_config_int(config, indirect, "tmp_syslogUdpPort", 0);
+  if (cfg->udp_port < 0 || cfg->udp_port > 65535)
+  {
+    printf("Invalid tmp_syslogUdpPort %d in tmp_indirectParameters\n", cfg->udp_port);
+    goto error;
+  }
+  cfg->coalesce_window_ms = evel_config_int(config, indirect, "tmp_coalesceWindowMs",
+                                            DEFAULT_COALESCE_WINDOW_MS);
+  cfg->coalesce_max_events = evel_config_int(config, indirect, "tmp_coalesceMaxEvents",
+                                             DEFAULT_COALESCE_MAX_EVENTS);
+  if (cfg->coalesce_window_ms < 0 || cfg->coalesce_max_events < 0 ||
+      cfg->coalesce_max_events > MAX_COALESCE_EVENTS)
+  {
+    printf("Invalid tmp_coalesceWindowMs or tmp_coalesceMaxEvents in tmp_indirectParameters, maximum events %d\n",
+           MAX_COALESCE_EVENTS);
+    goto error;
+  }
+  if (cfg->syslog_file == NULL && cfg->syslog_socket == NULL && cfg->udp_port == 0)
+  {
+    printf("Missing mandatory parameters - tmp_syslogFile, tmp_syslogSocket or tmp_syslogUdpPort is not there in tmp_indirectParameters\n");
+    goto error;
+  }
+
+  if (compile_syslog_tags(config, direct, cfg) != 0)
+  {
+    goto error;
+  }
+
+  cfg->event_name = evel_config_string(config, direct, "eventName", NULL);
+  if (cfg->event_name == NULL)
+  {
+    printf("Missing mandatory parameters - eventName is not there in tmp_directParameters\n");
+    goto error;
+  }
+
+  srcTyp = evel_config_string(config, direct, "eventSourceType", NULL);
+  if (srcTyp == NULL)
+  {
+    printf("Missing mandatory parameters - eventSourceType is not there in tmp_directParameters\n");
+    goto error;
+  }
+  cfg->source_type = get_source(srcTyp);
+  if (cfg->source_type == -1)
+  {
+    printf("Fault eventSourceType value is not matching, eventSourceType-%s \n", srcTyp);
+    goto error;
+  }
+
+  cfg->syslog_proc = evel_config_string(config, direct, "syslogProc", NULL);
+  cfg->event_type = evel_config_string(config, direct, "eventType", NULL);
+  cfg->nfc_naming_code = evel_config_string(config, direct, "nfcNamingCode", NULL);
+  cfg->nf_naming_code = evel_config_string(config, direct, "nfNamingCode", NULL);
+  cfg->reporting_entity_id = evel_config_string(config, direct, "reportingEntityId", NULL);
+  cfg->source_id = evel_config_string(config, direct, "sourceId", NULL);
+
+  cfg->reporting_entity_name = evel_config_string(config, direct, "reportingEntityName", NULL);
+  if (cfg->reporting_entity_name == NULL)
+  {
+     printf("Missing mandatory parameters - reportingEntityName is not there in tmp_directParameters\n");
+     printf("Defaulting reportingEntityName to hostname\n");
+  }
+
+  cfg->source_name = evel_config_string(config, direct, "sourceName", NULL);
+  if (cfg->source_name == NULL)
+  {
+     printf("Missing mandatory parameters - sourceName is not there in tmp_directParameters\n");
+     printf("Defaulting sourceName to hostname\n");
+  }
+
+  return cfg;
+
+error:
+  free_syslog_config(cfg);
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Free a compiled syslog_config.json.
+ *****************************************************************************/
+void free_syslog_config(void * compiled)
+{
+  SYSLOG_CONFIG * cfg = compiled;
+
+  evel_free_matcher(cfg->matcher);
+  free(cfg->tags);
+  free(cfg);
+}
+
+/**************************************************************************//**
+ * Report a line added to the syslog file, if it has one of the configured
+ * tags and is neither excluded nor one of our own events being logged.
+ *****************************************************************************/
+void syslog_line(void * context, const char * line, size_t length)
+{
+  const SYSLOG_CONFIG * cfg = context;
+  int tag;
+
+  tag = evel_matcher_match(cfg->matcher, line, length);
+  if (tag >= 0)
+  {
+     report_syslog(cfg, &cfg->tags[tag], line, NULL);
+  }
+}
+
+/**************************************************************************//**
+ * Report a message received on a syslog socket, if it has one of the
+ * configured tags and is neither excluded nor one of our own events.
+ *****************************************************************************/
+void syslog_received(void * context, const EVEL_SYSLOG_MESSAGE * message)
+{
+  const SYSLOG_CONFIG * cfg = context;
+  int tag;
+
+  tag = evel_matcher_match(cfg->matcher, message->text, message->length);
+  if (tag >= 0)
+  {
+     report_syslog(cfg, &cfg->tags[tag],
+                   (message->message_length > 0) ? message->message : message->text,
+                   message);
+  }
+}
+
+/**************************************************************************//**
+ * Open the syslog sockets given in the configuration.
+ *****************************************************************************/
+EVEL_SYSLOG_RECEIVER * open_syslog_receiver(const SYSLOG_CONFIG * cfg)
+{
+  EVEL_SYSLOG_RECEIVER * receiver;
+
+  receiver = evel_new_syslog_receiver();
+  if (receiver == NULL)
+  {
+     return NULL;
+  }
+
+  if (cfg->syslog_socket != NULL &&
+      evel_syslog_receiver_unix(receiver, cfg->syslog_socket) != EVEL_SUCCESS)
+  {
+     printf("Error while binding %s (%s)\n", cfg->syslog_socket, evel_error_string());
+     evel_free_syslog_receiver(receiver);
+     return NULL;
+  }
+
+  if (cfg->udp_port != 0 &&
+      evel_syslog_receiver_udp(receiver, cfg->udp_address, cfg->udp_port) != EVEL_SUCCESS)
+  {
+     printf("Error while binding UDP port %d (%s)\n", cfg->udp_port, evel_error_string());
+     evel_free_syslog_receiver(receiver);
+     return NULL;
+  }
+
+  return receiver;
+}
+
+/**************************************************************************//**
+ * Open the syslog sockets or file given in the configuration, unless they
+ * are open already, closing any opened for an earlier configuration.
+ *
+ * @returns 0 on success, or -1 if they could not be opened, in which case
+ *          nothing is left open and the next call tries again.
+ *****************************************************************************/
+int open_syslog_source(const SYSLOG_CONFIG * cfg)
+{
+  char new_source[SOURCE_KEY_SIZE];
+
+  snprintf(new_source, sizeof(new_source), "%s|%s|%s|%d",
+           cfg->syslog_file ? cfg->syslog_file : "",
+           cfg->syslog_socket ? cfg->syslog_socket : "",
+           cfg->udp_address ? cfg->udp_address : "",
+           cfg->udp_port);
+  if ((syslog_tail != NULL || syslog_receiver != NULL) &&
+      strcmp(syslog_source, new_source) == 0)
+  {
+     return 0;
+  }
+
+  evel_free_tail(syslog_tail);
+  evel_free_syslog_receiver(syslog_receiver);
+  syslog_tail = NULL;
+  syslog_receiver = NULL;
+
+  if (cfg->syslog_socket != NULL || cfg->udp_port != 0)
+  {
+     syslog_receiver = open_syslog_receiver(cfg);
+     if (syslog_receiver == NULL)
+     {
+        printf("Error while opening syslog sockets\n");
+        return -1;
+     }
+  }
+  else
+  {
+     syslog_tail = evel_new_tail(cfg->syslog_file);
+     if (syslog_tail == NULL)
      {
-        strcat(js, ch);
-        memset(ch, 0, BUFSIZE);
+        printf("Error while opening file %s\n", cfg->syslog_file);
+        return -1;
      }
-//   printf("the file content is \n %s \n", js);
+  }
+  strcpy(syslog_source, new_source);
+
+  return 0;
+}
+
+/**************************************************************************//**
+ * Load syslog_config.json and open the syslog sockets or file it gives, so
+ * that SyslogThread() has only to read from them.
+ *
+ * @returns 0 on success, or -1 on failure.
+ *****************************************************************************/
+int start_syslog(void)
+{
+  SYSLOG_CONFIG * cfg;
+  int rc;
+
+  /***************************************************************************/
+  /* The configuration is parsed once, and again only when the file changes. */
+  /***************************************************************************/
+  syslog_config_watch = evel_new_config_watch(syslog_config_file,
+                                              compile_syslog_config,
+                                              free_syslog_config,
+                                              NULL);
+  if (syslog_config_watch == NULL)
+  {
+     printf("Failed to load %s\n", syslog_config_file);
+     return -1;
+  }
+
+  cfg = evel_config_watch_acquire(syslog_config_watch);
+  rc = open_syslog_source(cfg);
+  evel_config_watch_release(syslog_config_watch, cfg);
+  if (rc != 0)
+  {
+     evel_free_config_watch(syslog_config_watch);
+     syslog_config_watch = NULL;
+  }
+
+  return rc;
+}
 
-     jsmn_init(&p);
-     numToken = jsmn_parse(&p, js, strlen(js), tokens, MAX_TOKENS);
-//     printf("Token count-%d\n", numToken);
+void *SyslogThread(void *threadarg)
+{
+  SYSLOG_CONFIG * cfg;
+  SYSLOG_CONFIG * last_cfg = NULL;
+  unsigned long long now;
+  int timeout_ms;
+  EVEL_ERR_CODES rc;
 
-//   printToken(js,tokens, numToken);
+  printf("Running Syslog thread \n");
+  fflush(stdout);
 
-     ret = getStringToken(js, tokens, numToken, "tmp_syslogFile", "tmp_indirectParameters", syslog_file, BUFSIZE);
-     if (ret != 0)
+  /***************************************************************************/
+  /* Messages are reported as soon as they are received on the syslog        */
+  /* sockets, or written to the syslog file, following it when it is         */
+  /* rotated.  The source is reopened when the configuration changes it,     */
+  /* and retried until it opens if that fails.                               */
+  /***************************************************************************/
+  while(1)
+  {
+     evel_config_watch_check(syslog_config_watch);
+     cfg = evel_config_watch_acquire(syslog_config_watch);
+
+     /************************************************************************/
+     /* Held events refer to the tags of the configuration they matched.     */
+     /************************************************************************/
+     if (cfg != last_cfg)
      {
-        printf("Missing mandatory parameters - tmp_syslogFile is not there in tmp_indirectParameters. Exiting...\n");
-        exit(1);
+        flush_syslog();
+        last_cfg = cfg;
      }
 
-     ret = getStringToken(js, tokens, numToken, "syslogTag", "tmp_directParameters", syslog_tag, BUFSIZE);
-     if (ret != 0)
+     if (open_syslog_source(cfg) != 0)
      {
-        printf("Missing mandatory parameters - syslogTag is not there in tmp_directParameters, exiting..\n");
-        exit(1);
+        evel_config_watch_release(syslog_config_watch, cfg);
+        sleep(1);
+        continue;
      }
 
-     ret = getStringToken(js, tokens, numToken, "eventName", "tmp_directParameters", eName, BUFSIZE);
-     if (ret != 0)
+     /************************************************************************/
+     /* Wake in time to close the coalescing window.                         */
+     /************************************************************************/
+     timeout_ms = TAIL_TIMEOUT_MS;
+     if (num_pending > 0)
      {
-        printf("Missing mandatory parameters - eventName is not there in tmp_directParameters. Exiting...\n");
-        exit(1);
+        now = evel_time_now_usec(EVEL_CLOCK_EXACT);
+        timeout_ms = (pending_deadline <= now) ? 0 : (pending_deadline - now + 999) / 1000;
+        if (timeout_ms > TAIL_TIMEOUT_MS)
+        {
+           timeout_ms = TAIL_TIMEOUT_MS;
+        }
      }
 
-     ret = getStringToken(js, tokens, numToken, "eventSourceType", "tmp_directParameters", eventSrcTyp, BUFSIZE);
-     if (ret != 0)
+     if (syslog_receiver != NULL)
      {
-        printf("Missing mandatory parameters - eventSourceType is not there in tmp_directParameters, exiting..\n");
-        exit(1);
+        rc = evel_syslog_receiver_wait(syslog_receiver, timeout_ms, syslog_received, cfg);
      }
-     srcTyp = get_source(eventSrcTyp);
-     if(srcTyp == -1)
+     else
      {
-        printf("Fault eventSourceType value is not matching, eventSourceType-%s \n", eventSrcTyp);
-        exit(1);
+        rc = evel_tail_wait(syslog_tail, timeout_ms, syslog_line, cfg);
+     }
+     if (rc != EVEL_SUCCESS)
+     {
+        printf("Failed to read syslog (%s)\n", evel_error_string());
+        sleep(1);
      }
 
-    // Open file in read mode
-    fp = fopen(syslog_file, "r");
-    if (fp == NULL)
-    {
-        printf("Error while opening file");
-        exit(EXIT_FAILURE);
-    }
-
-     memset(str, 0, 8*BUFSIZE);
-     if (fseek(fp, 0, SEEK_END))
-        perror("fseek() failed");
-     else
+     if (num_pending > 0 && evel_time_now_usec(EVEL_CLOCK_EXACT) >= pending_deadline)
      {
-        // pos will contain no. of chars in input file.
-        int n = 8;
-        pos = ftell(fp);
+        flush_syslog();
+     }
 
-        // search for '\n' characters
-        while (pos>prevpos)
-        {
-            // Move 'pos' away from end of file.
-            if (!fseek(fp, --pos, SEEK_SET))
-            {
-                if (fgetc(fp) == '\n')
-
-                    // stop reading when n newlines is found
-                    if (count++ == n)
-                        break;
-            }
-            else
-                perror("fseek() failed");
-        }
-        //printf("pos %d prevpos %d\n",pos,prevpos);
+     evel_config_watch_release(syslog_config_watch, cfg);
+  }
+}
 
-        // print last n lines
-        prevpos = pos;
+#ifdef VES_AGENT_PLUGIN
+/**************************************************************************//**
+ * Start reporting syslog messages in the VES agent.  The messages are read
+ * by a thread of their own rather than by a scheduled job.
+ *****************************************************************************/
+int syslog_plugin_start(const VES_PLUGIN_HOST * host, const char * config_file)
+{
+  pthread_attr_t attr;
+  pthread_t syslog_thread;
 
-        while (fgets(str, sizeof(str), fp))
-        {
-            char * position;
-           // printf("str is - %s\n", str);
-            if ((position=strchr(str, '\n')) != NULL)
-               *position = '\0';
-            if(strstr(str, syslog_tag) && !strstr(str,"EVEL") && !strstr(str,"commonEventHeader") && !strstr(str,"syslogMsg") && !strstr(str,"syslogTag"))
-            {
-               memset(syslog_msg, 0, 8*BUFSIZE);
-               memcpy(syslog_msg, str, 8*BUFSIZE);
-               report_syslog(js, tokens, numToken, syslog_tag, eName, srcTyp, syslog_msg);
-            }
-       
-            prevpos += strlen(str);
-            //printf("new prevpos is %d, size of str is %d\n", prevpos, strlen(str));
-        }
-    }
-    sleep(3);
+  syslog_config_file = config_file;
+
+  evel_id_generator_init(&syslog_event_ids, "syslog", 0);
+
+  if (start_syslog() != 0)
+  {
+    return -1;
   }
+
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  if (pthread_create(&syslog_thread, &attr, SyslogThread, NULL) != 0)
+  {
+    printf("Failed to create the Syslog thread\n");
+    return -1;
+  }
+  return 0;
 }
 
+const VES_PLUGIN ves_plugin = {
+  VES_PLUGIN_API_VERSION,
+  "syslog",
+  syslog_plugin_start
+};
+#endif
@@ -23,25 +23,58 @@
 #include <netdb.h>
 #include <sys/time.h>
 #include <sys/stat.h>
-#include "jsmn.h"
 #include "evel.h"
+#ifdef VES_AGENT_PLUGIN
+#include "ves_plugin.h"
+#endif
 
 #define BUFSIZE 128
-#define MAX_BUFFER_SIZE 4096
-#define MAX_TOKENS 1000
 #define MAX_INTERFACES 40
+#define MAX_COMMANDS 32
+#define MAX_PROBE_WORKERS 8
+#define PROBE_TIMEOUT_MS 10000
 
 void *MeasThread(void *threadarg);
+int start_measurements(void);
+
+/**************************************************************************//**
+ * A command from meas_config.json, compiled with $tmp_device as its only
+ * variable.
+ *****************************************************************************/
+typedef struct meas_command {
+  const char * key;
+  EVEL_COMMAND command;
+} MEAS_COMMAND;
+
+/**************************************************************************//**
+ * Measurement parameters, compiled from meas_config.json.  The strings point
+ * into the parsed file, or to the hostname.
+ *****************************************************************************/
+typedef struct meas_config {
+  const char * event_name;
+  const char * event_type;
+  const char * nfc_naming_code;
+  const char * nf_naming_code;
+  const char * reporting_entity_name;
+  const char * reporting_entity_id;
+  const char * source_id;
+  const char * source_name;
+  int priority;
+  int interval;
+  int num_links;
+  const char * links[MAX_INTERFACES];
+  const char * metrics_registry;
+  int num_init_commands;
+  MEAS_COMMAND init_commands[MAX_COMMANDS];
+  int num_vnic_commands;
+  MEAS_COMMAND vnic_commands[MAX_COMMANDS];
+} MEAS_CONFIG;
 
 typedef struct dummy_vpp_metrics_struct {
-  int curr_bytes_in;
-  int curr_bytes_out;
-  int curr_packets_in;
-  int curr_packets_out;
-  int last_bytes_in;
-  int last_bytes_out;
-  int last_packets_in;
-  int last_packets_out;
+  EVEL_COUNTER bytes_in;
+  EVEL_COUNTER bytes_out;
+  EVEL_COUNTER packets_in;
+  EVEL_COUNTER packets_out;
 } vpp_metrics_struct;
 
 typedef struct linkstat {
@@ -56,100 +89,154 @@ typedef struct linkstat {
 vpp_metrics_struct meas_intfstat[MAX_INTERFACES];
 LINKSTAT meas_linkstat[MAX_INTERFACES];
 
+/*****************************************************************************/
+/* Which of a link's counters were read this interval.                       */
+/*****************************************************************************/
+#define MEAS_READ_BYTES_IN      0x01
+#define MEAS_READ_BYTES_OUT     0x02
+#define MEAS_READ_PACKETS_IN    0x04
+#define MEAS_READ_PACKETS_OUT   0x08
+
 unsigned long long epoch_start = 0;
 
-int format_val_params(KEYVALRESULT * keyValArray, int numElements, const char *replace, const char *search)
-{
-     char *sp;
-     int i =0;
-     int search_len;
-     int replace_len;
-     int tail_len;
-
-     for (i=0; i<numElements; i++)
-     {
-        if ((sp = strstr(keyValArray[i].valStr, search)) == NULL) {
-           printf("\n String not found\n");
-           return 1; //Error search string not found
-        }
-        
-        search_len = strlen(search);
-        replace_len = strlen(replace);
-        tail_len = strlen(sp+search_len);
-        memmove(sp+replace_len,sp+search_len,tail_len+1);
-        memcpy(sp, replace, replace_len);
-//       printf("\n Changed value for i=%d is %s", i, keyValArray[i].valStr);
-     }
-     return 0; //search and replace is successful
-}
+/*****************************************************************************/
+/* The only variable in the commands.                                        */
+/*****************************************************************************/
+static const char * const command_variables[] = { "tmp_device" };
+
+/*****************************************************************************/
+/* Interface counters, read once per interval for the commands that can be   */
+/* answered from them.                                                       */
+/*****************************************************************************/
+static EVEL_IF_SNAPSHOT if_snapshot;
+
+/*****************************************************************************/
+/* The commands for every link are run as one batch, with the result for     */
+/* each link and command at meas_results[link][command].                     */
+/*****************************************************************************/
+static EVEL_PROBE meas_probes[MAX_INTERFACES * MAX_COMMANDS];
+static char meas_results[MAX_INTERFACES][MAX_COMMANDS][BUFSIZE];
+static const char * meas_linknames[MAX_INTERFACES];
 
-void runCommands(KEYVALRESULT * commandArray, int numCommands)
+/**************************************************************************//**
+ * Run the commands for every link, several at once.  A probe that could not
+ * be run, failed or timed out is left with an empty result and a state
+ * other than EVEL_PROBE_SUCCESS.
+ *****************************************************************************/
+void runCommands(const MEAS_COMMAND * commands, int numCommands, int linkCount, const EVEL_IF_SNAPSHOT * snapshot)
 {
-
-  char buf[BUFSIZE];            /* buffer used to store VPP metrics     */
-  FILE *fp;                     /* file descriptor to pipe cmd to shell */
+  EVEL_PROBE_STATS stats;
+  EVEL_PROBE * probe;
+  int numProbes = 0;
   int i;
+  int j;
 
-  for(i = 0; i < numCommands; i++)
+  for(i = 0; i < linkCount; i++)
   {
-      memset(buf, 0, BUFSIZE);
-
-      // Open a pipe and read VPP values
-      if ((fp = popen(commandArray[i].valStr, "r")) == NULL) {
-          printf("Error opening pipe!\n");
-          return;
+      meas_linknames[i] = meas_linkstat[i].linkname;
+      for(j = 0; j < numCommands; j++)
+      {
+          probe = &meas_probes[numProbes++];
+          memset(probe, 0, sizeof(EVEL_PROBE));
+          probe->command = &commands[j].command;
+          probe->values = &meas_linknames[i];
+          probe->result = meas_results[i][j];
+          probe->result_size = BUFSIZE;
+          probe->state = EVEL_PROBE_FAILED;
+          probe->result[0] = '\0';
       }
+  }
+
+  if (evel_probe_run(meas_probes, numProbes, snapshot, MAX_PROBE_WORKERS, PROBE_TIMEOUT_MS, &stats) != EVEL_SUCCESS)
+  {
+      printf("MeasThread::Failed to run commands (%s)\n", evel_error_string());
+      return;
+  }
+  printf("MeasThread::Ran %d commands, %d natively, in %llums; %d failed, %d timed out\n",
+         stats.num_probes, stats.num_native, stats.runtime / 1000, stats.num_failed, stats.num_timed_out);
+}
 
-      while (fgets(buf, BUFSIZE, fp) != NULL);
-      strcpy(commandArray[i].resultStr, buf);
+/**************************************************************************//**
+ * Read the interface counters if any of the commands need them.
+ *
+ * @returns The snapshot, or NULL if the commands are to run in the shell.
+ *****************************************************************************/
+const EVEL_IF_SNAPSHOT * read_if_snapshot(const MEAS_COMMAND * commands, int numCommands)
+{
+  int i;
 
-      if(pclose(fp))  {
-          printf("Command not found or exited with error status\n");
-          return;
+  for(i = 0; i < numCommands; i++)
+  {
+      if (commands[i].command.type == EVEL_COMMAND_IF_STATS)
+      {
+          if (evel_ifstats_read_netlink(&if_snapshot) == EVEL_SUCCESS)
+          {
+              return &if_snapshot;
+          }
+          printf("Failed to read interface counters (%s)\n", evel_error_string());
+          return NULL;
       }
-   }
-   //for(i = 0; i < numCommands; i++)
-     // printf("-%d-valstr and resultStr is- %s - %s\n", i, commandArray[i].valStr, commandArray[i].resultStr);
-   printf("%d - %d - %d - %d\n", atoi(commandArray[0].resultStr), atoi(commandArray[1].resultStr), atoi(commandArray[2].resultStr), atoi(commandArray[3].resultStr));
+  }
+  return NULL;
 }
 
-
-void copy_vpp_metic_data(vpp_metrics_struct *intfstats, KEYVALRESULT * cmdArray, int numCmds, int linkNum)
+/**************************************************************************//**
+ * Update a link's counters from the results of its commands.  A counter
+ * whose command did not succeed, or printed no number, keeps its previous
+ * reading rather than being taken as reset to zero.
+ *
+ * @returns The MEAS_READ_ flags of the counters read.
+ *****************************************************************************/
+int copy_vpp_metic_data(vpp_metrics_struct *intfstats, const MEAS_COMMAND * cmdArray, const EVEL_PROBE * probes, char results[][BUFSIZE], int numCmds, int linkNum)
 {
     int i;
+    int read = 0;
+    char * end;
+    unsigned long long value;
+    unsigned long long now = evel_time_monotonic_usec();
 
-    // Store the current metric in the last metric
-    intfstats[linkNum].last_bytes_in = intfstats[linkNum].curr_bytes_in;
-    intfstats[linkNum].last_bytes_out = intfstats[linkNum].curr_bytes_out;
-    intfstats[linkNum].last_packets_in = intfstats[linkNum].curr_packets_in;
-    intfstats[linkNum].last_packets_out = intfstats[linkNum].curr_packets_out;
-
-    // Store metrics read from the vNIC in the current
+    // Update the counters with the metrics read from the vNIC; they keep
+    // the previous reading to work out the deltas
     for(i=0; i<numCmds; i++)
     {
-       if((strcmp(cmdArray[i].keyStr, "tmp_t0BytesIn") == 0) ||
-          (strcmp(cmdArray[i].keyStr, "tmp_t1BytesIn") == 0))
-          intfstats[linkNum].curr_bytes_in = atoi(cmdArray[i].resultStr);
-
-       if((strcmp(cmdArray[i].keyStr, "tmp_t0BytesOut") == 0) ||
-          (strcmp(cmdArray[i].keyStr, "tmp_t1BytesOut") == 0))
-          intfstats[linkNum].curr_bytes_out = atoi(cmdArray[i].resultStr);
-
-       if((strcmp(cmdArray[i].keyStr, "tmp_t0PacketsIn") == 0) ||
-          (strcmp(cmdArray[i].keyStr, "tmp_t1PacketsIn") == 0))
-          intfstats[linkNum].curr_packets_in = atoi(cmdArray[i].resultStr);
-
-       if((strcmp(cmdArray[i].keyStr, "tmp_t0PacketsOut") == 0) ||
-          (strcmp(cmdArray[i].keyStr, "tmp_t1PacketsOut") == 0))
-          intfstats[linkNum].curr_packets_out = atoi(cmdArray[i].resultStr);
+       if (probes[i].state != EVEL_PROBE_SUCCESS)
+          continue;
+       value = strtoull(results[i], &end, 10);
+       if (end == results[i])
+          continue;
+
+       if((strcmp(cmdArray[i].key, "tmp_t0BytesIn") == 0) ||
+          (strcmp(cmdArray[i].key, "tmp_t1BytesIn") == 0))
+       {
+          evel_counter_update(&intfstats[linkNum].bytes_in, value, now);
+          read |= MEAS_READ_BYTES_IN;
+       }
+
+       if((strcmp(cmdArray[i].key, "tmp_t0BytesOut") == 0) ||
+          (strcmp(cmdArray[i].key, "tmp_t1BytesOut") == 0))
+       {
+          evel_counter_update(&intfstats[linkNum].bytes_out, value, now);
+          read |= MEAS_READ_BYTES_OUT;
+       }
+
+       if((strcmp(cmdArray[i].key, "tmp_t0PacketsIn") == 0) ||
+          (strcmp(cmdArray[i].key, "tmp_t1PacketsIn") == 0))
+       {
+          evel_counter_update(&intfstats[linkNum].packets_in, value, now);
+          read |= MEAS_READ_PACKETS_IN;
+       }
+
+       if((strcmp(cmdArray[i].key, "tmp_t0PacketsOut") == 0) ||
+          (strcmp(cmdArray[i].key, "tmp_t1PacketsOut") == 0))
+       {
+          evel_counter_update(&intfstats[linkNum].packets_out, value, now);
+          read |= MEAS_READ_PACKETS_OUT;
+       }
     }
-    // printf("intfstats[%d].curr_bytes_in = %d\n", linkNum, intfstats[linkNum].curr_bytes_in);
-    // printf("intfstats[%d].curr_bytes_out = %d\n", linkNum, intfstats[linkNum].curr_bytes_out);
-    // printf("intfstats[%d].curr_packets_in = %d\n", linkNum, intfstats[linkNum].curr_packets_in);
-    // printf("intfstats[%d].curr_packets_out = %d\n", linkNum, intfstats[linkNum].curr_packets_out);
+    return read;
 }
 
-int get_priority(char * inStr)
+int get_priority(const char * inStr)
 {
    int result = -1;
 
@@ -165,54 +252,126 @@ int get_priority(char * inStr)
   return result;
 }
 
+/*****************************************************************************/
+/* CPU counters from the last two reads of /proc/stat; cpu_snapshot_current  */
+/* indexes the latest.                                                       */
+/*****************************************************************************/
+static EVEL_CPU_SNAPSHOT cpu_snapshots[2];
+static int cpu_snapshot_current = 0;
+static int cpu_snapshots_ready = 0;
+
 /**************************************************************************//**
- * tap live cpu stats
+ * Take the first reading of the cpu stats, for the first interval to be
+ * measured from.
+ *****************************************************************************/
+void evel_init_cpu_stats()
+{
+  if (evel_cpu_snapshot_init(&cpu_snapshots[0]) != EVEL_SUCCESS ||
+      evel_cpu_snapshot_init(&cpu_snapshots[1]) != EVEL_SUCCESS)
+  {
+    printf("Failed to allocate cpu stats\n");
+    return;
+  }
+  cpu_snapshots_ready = 1;
+
+  if (evel_cpustats_read_procfs(&cpu_snapshots[cpu_snapshot_current], NULL) != EVEL_SUCCESS)
+  {
+    printf("Failed to read cpu stats\n");
+  }
+}
+
+/**************************************************************************//**
+ * tap live cpu stats: one cpu use per core, over the time since the last call
  *****************************************************************************/
 void evel_get_cpu_stats(EVENT_MEASUREMENT * measurement)
 {
-  FILE *fp;
-  char path[1024];
-  double usage=0.0;
-  double idle;
-  double intrpt;
-  double nice;
-  double softirq;
-  double steal;
-  double sys;
-  double user;
-  double wait;
-  MEASUREMENT_CPU_USE *cpu_use = NULL;
-
-  /* Open the command for reading. */
-  //fp = popen("/bin/ls /etc/", "r");
-  fp = popen("/usr/bin/top -bn 2 -d 0.01 | grep '^%Cpu' | tail -n 1 ", "r");
-  if (fp == NULL) {
-    printf("Failed to run command\n" );
-    exit(1);
+  int next = 1 - cpu_snapshot_current;
+
+  if (!cpu_snapshots_ready)
+  {
+    return;
+  }
+
+  if (evel_cpustats_read_procfs(&cpu_snapshots[next], NULL) != EVEL_SUCCESS)
+  {
+    printf("Failed to read cpu stats\n");
+    return;
+  }
+
+  evel_cpustats_measurement_add(measurement,
+                                &cpu_snapshots[next],
+                                (cpu_snapshots[cpu_snapshot_current].num_cpus > 0) ?
+                                  &cpu_snapshots[cpu_snapshot_current] : NULL);
+  cpu_snapshot_current = next;
+}
+
+/*****************************************************************************/
+/* Disk samples taken through the current measurement interval.             */
+/*****************************************************************************/
+static EVEL_DISK_COLLECTOR disk_collector;
+static int disk_collector_ready = 0;
+static pthread_mutex_t disk_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**************************************************************************//**
+ * Take the first sample of the disk stats, for the first interval to be
+ * measured from.
+ *****************************************************************************/
+void evel_init_disk_stats()
+{
+  if (evel_disk_collector_init(&disk_collector) != EVEL_SUCCESS)
+  {
+    printf("Failed to allocate disk stats\n");
+    return;
+  }
+  disk_collector_ready = 1;
+
+  if (evel_diskstats_sample(&disk_collector, NULL) != EVEL_SUCCESS)
+  {
+    printf("Failed to read disk stats\n");
   }
+}
 
-  /* Read the output a line at a time - output it. */
-  while (fgets(path, sizeof(path)-1, fp) != NULL) {
-    printf("%s", path+10);
-    sscanf(path+10," %lf us, %lf sy,  %lf ni,  %lf id,  %lf wa,  %lf hi,  %lf si,  %lf st",
-    &user,&sys,&nice,&idle,&wait,&intrpt,&softirq,&steal);
+/**************************************************************************//**
+ * Scheduled every second: sample the disk stats, so that their min, max and
+ * average over the interval can be reported.
+ *****************************************************************************/
+void DiskSampleJob(void * context, unsigned long long scheduled)
+{
+  pthread_mutex_lock(&disk_mutex);
+  if (disk_collector_ready &&
+      evel_diskstats_sample(&disk_collector, NULL) != EVEL_SUCCESS)
+  {
+    printf("Failed to read disk stats\n");
   }
+  pthread_mutex_unlock(&disk_mutex);
+}
 
-  /* close */
-  pclose(fp);
+/**************************************************************************//**
+ * tap live memory, disk and filesystem stats
+ *****************************************************************************/
+void evel_get_sys_stats(EVENT_MEASUREMENT * measurement, char * vm_id)
+{
+  EVEL_MEM_STATS mem_stats;
 
-  cpu_use = evel_measurement_new_cpu_use_add(measurement, "cpu1", usage);
-  if( cpu_use != NULL ){
+  if (evel_memstats_read_procfs(&mem_stats, NULL) == EVEL_SUCCESS)
+  {
+    evel_memstats_measurement_add(measurement, &mem_stats, vm_id, vm_id);
+  }
+  else
+  {
+    printf("Failed to read memory stats\n");
+  }
+
+  pthread_mutex_lock(&disk_mutex);
+  if (disk_collector_ready)
+  {
+    evel_diskstats_measurement_add(measurement, &disk_collector);
+  }
+  pthread_mutex_unlock(&disk_mutex);
 
-  evel_measurement_cpu_use_idle_set(cpu_use,idle);
-  //evel_measurement_cpu_use_interrupt_set(cpu_use,intrpt);
-  //evel_measurement_cpu_use_nice_set(cpu_use,nice);
-  //evel_measurement_cpu_use_softirq_set(cpu_use,softirq);
-  //evel_measurement_cpu_use_steal_set(cpu_use,steal);
-  evel_measurement_cpu_use_system_set(cpu_use,sys);
-  evel_measurement_cpu_use_usageuser_set(cpu_use,user);
-  //evel_measurement_cpu_use_wait_set(cpu_use,wait);
-  //evel_measurement_cpu_use_add(measurement, "cpu2", usage,idle,intrpt,nice,softirq,steal,sys,user,wait);
+  if (evel_fsstats_measurement_add(measurement, NULL) != EVEL_SUCCESS)
+  {
+    printf("Failed to read filesystem stats\n");
   }
 }
 
@@ -267,6 +426,7 @@ int measure_traffic()
 
 
 
+#ifndef VES_AGENT_PLUGIN
 int main(int argc, char** argv)
 {
   char* fqdn = argv[1];
@@ -346,207 +506,274 @@ int main(int argc, char** argv)
   printf("Terminated\n");
   return 0;
 }
+#endif
 
-void *MeasThread(void *mainMeas)
+/**************************************************************************//**
+ * Compile a set of commands, one per member of an object.
+ *****************************************************************************/
+int compile_commands(const EVEL_CONFIG * config, const EVEL_CONFIG_NODE * commands, MEAS_COMMAND * commandArray)
 {
-  EVEL_ERR_CODES evel_rc = EVEL_SUCCESS;
-  EVENT_MEASUREMENT * vpp_m = NULL;
-  MEASUREMENT_CPU_USE *cpu_use = NULL;
-  EVENT_HEADER* vpp_m_header = NULL;
-  int bytes_in;
-  int bytes_out;
-  int packets_in;
-  int packets_out;
-  unsigned long long epoch_now;
-  int request_rate = 0;
+  const EVEL_CONFIG_NODE * command;
+  int numCommands = 0;
 
-  struct timeval time_val;
-  MEASUREMENT_VNIC_PERFORMANCE * vnic_performance = NULL;
-  char event_id1[10] = "mvfs";
-  char event_id2[15] = {0};
-  char event_id[BUFSIZE] = {0};
-  int meas_event_id = 0;
-
-   int numToken;
-   jsmntok_t tokens[MAX_TOKENS];
-   char js[MAX_BUFFER_SIZE]; 
-
-   jsmn_parser p;
-   char ch[BUFSIZE];
-   int ret = 0;
-   char eName[BUFSIZE];
-   char eType[BUFSIZE];
-   char nfcCode[BUFSIZE];
-   char nfCode[BUFSIZE];
-   char prio[BUFSIZE];
-   char reportEId[BUFSIZE];
-   char reportEName[BUFSIZE];
-   char srcId[BUFSIZE];
-   char srcName[BUFSIZE];
-   char cpuId[BUFSIZE];
-
-   int priority;
-
-   char hostname[BUFSIZE];
+  if (commands == NULL)
+  {
+    return 0;
+  }
 
-   int meas_interval;
-   ARRAYVAL intfArray[MAX_INTERFACES];
-   KEYVALRESULT keyValResultArray[32];
-   KEYVALRESULT keyValResultArray2[32];
-   KEYVALRESULT vnicCommandArray[32];
-   KEYVALRESULT cpuUsageCommandArray[32];
-   int numInitCommands = 0;
-   int numVnicCommands = 0;
-   int numCpuUsageCommands = 0;
-   int linkCount = 0;
-   double usage=0.0;
-   double cpuIdle=0.0;
-   double cpuSystem=0.0;
-   double cpuUser=0.0;
-   double intrpt;
-   double nice;
-   double softirq;
-   double steal;
-   double wait;
+  for (command = evel_config_child(config, commands);
+       command != NULL && numCommands < MAX_COMMANDS;
+       command = evel_config_next(config, command))
+  {
+    if (command->type != EVEL_CONFIG_STRING)
+    {
+      continue;
+    }
+    if (evel_command_compile(&commandArray[numCommands].command, command->value, command_variables, 1) != EVEL_SUCCESS)
+    {
+      break;
+    }
+    commandArray[numCommands].key = command->name;
+    numCommands++;
+  }
 
-   int i = 0;
+  return numCommands;
+}
 
-   memset(hostname, 0, BUFSIZE);
-   gethostname(hostname, BUFSIZE);
-   printf("MeasThread::The hostname is %s\n", hostname);
+/**************************************************************************//**
+ * Compile meas_config.json.  The context is the hostname, used where the
+ * reporting entity or source name is not given.
+ *****************************************************************************/
+void * compile_meas_config(const EVEL_CONFIG * config, void * context)
+{
+  const char * hostname = context;
+  const EVEL_CONFIG_NODE * direct;
+  const EVEL_CONFIG_NODE * indirect;
+  const EVEL_CONFIG_NODE * device;
+  const char * prio;
+  MEAS_CONFIG * meas;
+  int i;
 
-   sleep(1);
-   printf("MeasThread::Running Meas thread \n");
-   fflush(stdout);
+  direct = evel_config_find(config, NULL, "tmp_directParameters");
+  indirect = evel_config_find(config, NULL, "tmp_indirectParameters");
+  if (direct == NULL || indirect == NULL)
+  {
+    printf("MeasThread::Missing mandatory parameters - tmp_directParameters or tmp_indirectParameters is not there\n");
+    return NULL;
+  }
 
-   memset(&intfArray[0],0,(sizeof(ARRAYVAL) * MAX_INTERFACES));
-   memset(&keyValResultArray[0],0,(sizeof(KEYVALRESULT) * 32));
+  meas = calloc(1, sizeof(MEAS_CONFIG));
+  if (meas == NULL)
+  {
+    return NULL;
+  }
 
-   memset(js, 0, MAX_BUFFER_SIZE);
-   memset(ch, 0, BUFSIZE);
-   memset(&meas_intfstat[0],0,(sizeof(vpp_metrics_struct)* MAX_INTERFACES));
-   memset(&meas_linkstat[0],0,(sizeof(LINKSTAT) * MAX_INTERFACES));
+  meas->event_name = evel_config_string(config, direct, "eventName", NULL);
+  if (meas->event_name == NULL)
+  {
+    printf("MeasThread::Missing mandatory parameters - eventName is not there in tmp_directParameters\n");
+    free(meas);
+    return NULL;
+  }
 
-   FILE * file = fopen("meas_config.json", "r");
+  meas->interval = evel_config_int(config, direct, "measurementInterval", 0);
+  if (meas->interval <= 0)
+  {
+    printf("MeasThread::The parameter measurementInterval is not defined, defaulted to 60 seconds\n");
+    meas->interval = 60;
+  }
 
-   while((fgets(ch, (BUFSIZE-1), file)) !=NULL)
-   {
-      strcat(js, ch);
-      memset(ch, 0, BUFSIZE);
-   }
-//   printf("MeasThread::the file content is \n %s \n", js);
+  meas->event_type = evel_config_string(config, direct, "eventType", NULL);
+  meas->nfc_naming_code = evel_config_string(config, direct, "nfcNamingCode", NULL);
+  meas->nf_naming_code = evel_config_string(config, direct, "nfNamingCode", NULL);
+  meas->reporting_entity_id = evel_config_string(config, direct, "reportingEntityId", NULL);
+  meas->source_id = evel_config_string(config, direct, "sourceId", NULL);
 
-   jsmn_init(&p);
-   numToken = jsmn_parse(&p, js, strlen(js), tokens, MAX_TOKENS);
-   printf("MeasThread::count-%d\n", numToken);
+  meas->reporting_entity_name = evel_config_string(config, direct, "reportingEntityName", NULL);
+  if (meas->reporting_entity_name == NULL)
+  {
+    printf("MeasThread::Missing mandatory parameters - reportingEntityName is not there in tmp_directParameters\n");
+    printf("MeasThread::Defaulting reportingEntityName to hostname\n");
+    meas->reporting_entity_name = hostname;
+  }
+  meas->source_name = evel_config_string(config, direct, "sourceName", NULL);
+  if (meas->source_name == NULL)
+  {
+    printf("MeasThread::Missing mandatory parameters - sourceName is not there in tmp_directParameters\n");
+    printf("MeasThread::Defaulting sourceName to hostname\n");
+    meas->source_name = hostname;
+  }
 
-//   printToken(js,tokens, numToken);
+  prio = evel_config_string(config, direct, "priority", NULL);
+  if (prio == NULL)
+  {
+    printf("MeasThread::Missing mandatory parameters - priority is not there in tmp_directParameters\nDefaulting priority to Medium\n");
+    prio = "Medium";
+  }
+  meas->priority = get_priority(prio);
+  if (meas->priority == -1)
+  {
+    printf("MeasThread::Meas priority value is not matching, prioirty-%s \n", prio);
+    free(meas);
+    return NULL;
+  }
+
+  device = evel_config_find(config, direct, "tmp_device");
+  if (device != NULL)
+  {
+    for (device = evel_config_child(config, device);
+         device != NULL && meas->num_links < MAX_INTERFACES;
+         device = evel_config_next(config, device))
+    {
+      if (device->type == EVEL_CONFIG_STRING)
+      {
+        meas->links[meas->num_links++] = device->value;
+      }
+    }
+  }
+  printf("MeasThread::Array link count is %d\n", meas->num_links);
 
+  meas->metrics_registry = evel_config_string(config, direct, "tmp_metricsRegistry", NULL);
 
-   ret = getIntToken(js, tokens, numToken, "measurementInterval", "tmp_directParameters", &meas_interval);
-   if (ret != 0)
-   {
-      printf("MeasThread::The parameter measurementInterval is not defined, defaulted to 60 seconds\n");
-      meas_interval = 60;
-   }
+  meas->num_init_commands = compile_commands(config, evel_config_find(config, indirect, "tmp_init"), meas->init_commands);
+  meas->num_vnic_commands = compile_commands(config, evel_config_find(config, indirect, "vNicPerformance/tmp_vnic_command"), meas->vnic_commands);
+  for (i = 0; i < meas->num_vnic_commands; i++)
+  {
+    printf("MeasThread::%s %s\n", meas->vnic_commands[i].key,
+           (meas->vnic_commands[i].command.type == EVEL_COMMAND_IF_STATS) ? "read natively" : "run in the shell");
+  }
 
-  ret = getArrayTokens(js, tokens, numToken, "tmp_device", "tmp_directParameters", intfArray, &linkCount);
+  return meas;
+}
 
-  printf("MeasThread::Array link count is %d\n", linkCount); 
+/**************************************************************************//**
+ * Free a compiled meas_config.json.
+ *****************************************************************************/
+void free_meas_config(void * compiled)
+{
+  MEAS_CONFIG * meas = compiled;
+  int i;
 
-  /* Copy the link information */
-  for(i=0;i<linkCount;i++)
+  for (i = 0; i < meas->num_init_commands; i++)
   {
-     strcpy(meas_linkstat[i].linkname, &intfArray[i]);
-//     printf("MeasThread::Link name %s\n", meas_linkstat[i].linkname);
+    evel_command_free(&meas->init_commands[i].command);
   }
-  
+  for (i = 0; i < meas->num_vnic_commands; i++)
+  {
+    evel_command_free(&meas->vnic_commands[i].command);
+  }
+  free(meas);
+}
 
-  read_keyVal_params(js, tokens, numToken, "tmp_init", "tmp_indirectParameters", keyValResultArray, &numInitCommands);
+/**************************************************************************//**
+ * Track the configured links, restarting the counters of any that change.
+ *****************************************************************************/
+int update_links(const MEAS_CONFIG * meas)
+{
+  int i;
 
-  for(i=0;i<linkCount;i++)
+  for (i = 0; i < meas->num_links; i++)
   {
-     memset(&vnicCommandArray[0],0,(sizeof(KEYVALRESULT) * 32));
-     memcpy(vnicCommandArray, keyValResultArray, (sizeof(KEYVALRESULT) * 32)); 
-     format_val_params(vnicCommandArray, numInitCommands, meas_linkstat[i].linkname, "$tmp_device");
-     runCommands(vnicCommandArray, numInitCommands);
-     copy_vpp_metic_data(meas_intfstat, vnicCommandArray, numInitCommands, i); 
+    if (strcmp(meas_linkstat[i].linkname, meas->links[i]) != 0)
+    {
+      memset(&meas_linkstat[i], 0, sizeof(LINKSTAT));
+      strncpy(meas_linkstat[i].linkname, meas->links[i], sizeof(meas_linkstat[i].linkname) - 1);
+      evel_counter_init(&meas_intfstat[i].bytes_in, EVEL_COUNTER_AUTO);
+      evel_counter_init(&meas_intfstat[i].bytes_out, EVEL_COUNTER_AUTO);
+      evel_counter_init(&meas_intfstat[i].packets_in, EVEL_COUNTER_AUTO);
+      evel_counter_init(&meas_intfstat[i].packets_out, EVEL_COUNTER_AUTO);
+    }
   }
 
-  gettimeofday(&time_val, NULL);
+  return meas->num_links;
+}
 
-  sleep(meas_interval);
+/*****************************************************************************/
+/* The application metrics registry, if one is configured, and its path.     */
+/*****************************************************************************/
+EVEL_METRICS * meas_metrics = NULL;
+char meas_metrics_path[BUFSIZE];
 
-  /***************************************************************************/
-  /* Collect metrics from the VNIC                                           */
-  /***************************************************************************/
-  while(1) 
+/**************************************************************************//**
+ * Track the configured metrics registry, reopening it if it changes.
+ *****************************************************************************/
+EVEL_METRICS * update_metrics_registry(const MEAS_CONFIG * meas)
+{
+  if (meas->metrics_registry == NULL)
+  {
+    evel_free_metrics(meas_metrics);
+    meas_metrics = NULL;
+    meas_metrics_path[0] = '\0';
+  }
+  else if (meas_metrics == NULL || strcmp(meas_metrics_path, meas->metrics_registry) != 0)
   {
+    evel_free_metrics(meas_metrics);
+    meas_metrics = evel_new_metrics_reader(meas->metrics_registry);
+    strncpy(meas_metrics_path, meas->metrics_registry, sizeof(meas_metrics_path) - 1);
+    printf("MeasThread::Reading application metrics from %s\n", meas->metrics_registry);
+  }
 
-    ret = getIntToken(js, tokens, numToken, "measurementInterval", "tmp_directParameters", &meas_interval);
-   if (ret != 0)
-   {
-      meas_interval = 60;
-   }
+  return meas_metrics;
+}
 
-   ret = getStringToken(js, tokens, numToken, "eventName", "tmp_directParameters", eName, BUFSIZE);
-   if (ret != 0)
-   {
-      printf("MeasThread::Missing mandatory parameters - eventName is not there in tmp_directParameters. Exiting...\n");
-      exit(1);
-   }
+/*****************************************************************************/
+/* Measurements are sent by a scheduled job, whose interval follows          */
+/* meas_config.json when it is reloaded.  The disk stats are sampled by      */
+/* another job in between.  The scheduler is the VES agent's when running   */
+/* as a plugin.                                                              */
+/*****************************************************************************/
+const char * meas_config_file = "meas_config.json";
+EVEL_SCHEDULER * meas_scheduler = NULL;
+EVEL_CONFIG_WATCH * meas_config_watch;
+EVEL_SCHEDULER_JOB * meas_job;
+EVEL_ID_GENERATOR meas_event_ids;
+char meas_hostname[BUFSIZE];
 
-   ret = getStringToken(js, tokens, numToken, "eventType", "tmp_directParameters", eType, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "nfcNamingCode", "tmp_directParameters", nfcCode, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "nfNamingCode", "tmp_directParameters", nfCode, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "reportingEntityId", "tmp_directParameters", reportEId, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "sourceId", "tmp_directParameters", srcId, BUFSIZE);
-   ret = getStringToken(js, tokens, numToken, "reportingEntityName", "tmp_directParameters", reportEName, BUFSIZE);
-   if (ret != 0)
-   {
-      printf("MeasThread::Missing mandatory parameters - reportingEntityName is not there in tmp_directParameters\n");
-      printf("MeasThread::Defaulting reportingEntityName to hostname\n");
-      strcpy(reportEName, hostname);
-   }
-   ret = getStringToken(js, tokens, numToken, "sourceName", "tmp_directParameters", srcName, BUFSIZE);
-   if (ret != 0)
-   {
-      printf("MeasThread::Missing mandatory parameters - sourceName is not there in tmp_directParameters\n");
-      printf("MeasThread::Defaulting sourceName to hostname\n");
-      strcpy(srcName, hostname);
-   }
+/**************************************************************************//**
+ * Send one measurement, for the interval ending at the scheduled time.
+ *****************************************************************************/
+void MeasJob(void * context, unsigned long long scheduled)
+{
+  EVEL_ERR_CODES evel_rc = EVEL_SUCCESS;
+  EVENT_MEASUREMENT * vpp_m = NULL;
+  EVENT_HEADER* vpp_m_header = NULL;
+  unsigned long long bytes_in;
+  unsigned long long bytes_out;
+  unsigned long long packets_in;
+  unsigned long long packets_out;
+  int request_rate = 0;
 
-   ret = getStringToken(js, tokens, numToken, "priority", "tmp_directParameters", prio, BUFSIZE);
-   if (ret != 0)
-   {
-      printf("MeasThread::Missing mandatory parameters - priority is not there in tmp_directParameters\nDefaulting priority to Low\n");
-      strcpy(prio, "Medium");
-   }
-   priority = get_priority(prio);
-   if(priority == -1)
+  MEASUREMENT_VNIC_PERFORMANCE * vnic_performance = NULL;
+  char event_id[EVEL_ID_MAX_LEN + 1] = {0};
+
+   MEAS_CONFIG * meas;
+
+   int meas_interval;
+   const EVEL_IF_SNAPSHOT * snapshot;
+   int linkCount = 0;
+   int read[MAX_INTERFACES];
+
+   int i = 0;
+
+   if (evel_config_watch_check(meas_config_watch))
    {
-      printf("MeasThread::Meas priority value is not matching, prioirty-%s \n", prio);
-      exit(1);
+      printf("MeasThread::Reloaded meas_config.json\n");
    }
+   meas = evel_config_watch_acquire(meas_config_watch);
+   linkCount = update_links(meas);
+   update_metrics_registry(meas);
+   meas_interval = meas->interval;
 
-   read_keyVal_params(js, tokens, numToken, "tmp_vnic_command", "vNicPerformance", keyValResultArray, &numVnicCommands);
-
+   snapshot = read_if_snapshot(meas->vnic_commands, meas->num_vnic_commands);
+   runCommands(meas->vnic_commands, meas->num_vnic_commands, linkCount, snapshot);
    for(i=0;i<linkCount;i++)
    {
-       memset(&vnicCommandArray[0],0,(sizeof(KEYVALRESULT) * 32));
-       memcpy(vnicCommandArray, keyValResultArray, (sizeof(KEYVALRESULT) * 32)); 
-       format_val_params(vnicCommandArray, numVnicCommands, meas_linkstat[i].linkname, "$tmp_device");
-       runCommands(vnicCommandArray, numVnicCommands);
-       copy_vpp_metic_data(meas_intfstat, vnicCommandArray, numVnicCommands, i); 
+       read[i] = copy_vpp_metic_data(meas_intfstat, meas->vnic_commands, &meas_probes[i * meas->num_vnic_commands], meas_results[i], meas->num_vnic_commands, i);
    }
 
-   memset(event_id, 0, BUFSIZE);
-   meas_event_id = meas_event_id+1;
-   sprintf(event_id2, "%09d", meas_event_id);
-   strcat(event_id, event_id1);
-   strcat(event_id, event_id2);
+   evel_id_generator_next(&meas_event_ids, event_id, sizeof(event_id));
 
-   vpp_m = evel_new_measurement(meas_interval, eName,event_id);
+   vpp_m = evel_new_measurement(meas_interval, meas->event_name, event_id);
 
    if(vpp_m != NULL)
    {
@@ -554,37 +781,34 @@ void *MeasThread(void *mainMeas)
 
       for (int i = 0; i < linkCount; i++)
       {
-         if(meas_intfstat[i].curr_bytes_in - meas_intfstat[i].last_bytes_in > 0) {
-           bytes_in = meas_intfstat[i].curr_bytes_in - meas_intfstat[i].last_bytes_in;
-         }
-         else {
-           bytes_in = 0;
-         }
-         if(meas_intfstat[i].curr_bytes_out - meas_intfstat[i].last_bytes_out > 0) {
-           bytes_out = meas_intfstat[i].curr_bytes_out - meas_intfstat[i].last_bytes_out;
-         }
-         else {
-           bytes_out = 0;
-         }
-         if(meas_intfstat[i].curr_packets_in - meas_intfstat[i].last_packets_in > 0) {
-           packets_in = meas_intfstat[i].curr_packets_in - meas_intfstat[i].last_packets_in;
+         bytes_in = meas_intfstat[i].bytes_in.delta;
+         bytes_out = meas_intfstat[i].bytes_out.delta;
+         packets_in = meas_intfstat[i].packets_in.delta;
+         packets_out = meas_intfstat[i].packets_out.delta;
+         vnic_performance = (MEASUREMENT_VNIC_PERFORMANCE *)evel_measurement_new_vnic_performance(meas_linkstat[i].linkname, "true");
+         evel_meas_vnic_performance_add(vpp_m, vnic_performance);
+
+         // A counter that could not be read this interval is left out
+         if (read[i] & MEAS_READ_PACKETS_IN)
+         {
+           evel_vnic_performance_rx_total_pkt_delta_set(vnic_performance, packets_in);
+           evel_vnic_performance_rx_total_pkt_acc_set(vnic_performance, meas_intfstat[i].packets_in.value);
          }
-         else {
-           packets_in = 0;
+         if (read[i] & MEAS_READ_PACKETS_OUT)
+         {
+           evel_vnic_performance_tx_total_pkt_delta_set(vnic_performance, packets_out);
+           evel_vnic_performance_tx_total_pkt_acc_set(vnic_performance, meas_intfstat[i].packets_out.value);
          }
-         if(meas_intfstat[i].curr_packets_out - meas_intfstat[i].last_packets_out > 0) {
-           packets_out = meas_intfstat[i].curr_packets_out - meas_intfstat[i].last_packets_out;
+         if (read[i] & MEAS_READ_BYTES_IN)
+         {
+           evel_vnic_performance_rx_octets_delta_set(vnic_performance, bytes_in);
+           evel_vnic_performance_rx_octets_acc_set(vnic_performance, meas_intfstat[i].bytes_in.value);
          }
-         else {
-           packets_out = 0;
+         if (read[i] & MEAS_READ_BYTES_OUT)
+         {
+           evel_vnic_performance_tx_octets_delta_set(vnic_performance, bytes_out);
+           evel_vnic_performance_tx_octets_acc_set(vnic_performance, meas_intfstat[i].bytes_out.value);
          }
-         vnic_performance = (MEASUREMENT_VNIC_PERFORMANCE *)evel_measurement_new_vnic_performance(meas_linkstat[i].linkname, "true");
-         evel_meas_vnic_performance_add(vpp_m, vnic_performance);
-         evel_vnic_performance_rx_total_pkt_delta_set(vnic_performance, packets_in);
-         evel_vnic_performance_tx_total_pkt_delta_set(vnic_performance, packets_out);
-
-         evel_vnic_performance_rx_octets_delta_set(vnic_performance, bytes_in);
-         evel_vnic_performance_tx_octets_delta_set(vnic_performance, bytes_out);
 
          if (strcmp(meas_linkstat[i].linkname, "docker") == 0)
          {
@@ -594,73 +818,39 @@ void *MeasThread(void *mainMeas)
 
       evel_measurement_request_rate_set(vpp_m, request_rate);
 
-      //evel_get_cpu_stats(vpp_m);
-      memset(&keyValResultArray2[0],0,(sizeof(KEYVALRESULT) * 32));
-      memset(&cpuUsageCommandArray[0],0,(sizeof(KEYVALRESULT) * 32));
+      evel_get_cpu_stats(vpp_m);
+      evel_get_sys_stats(vpp_m, meas_hostname);
 
-      ret = getStringToken(js, tokens, numToken, "cpuIdentifier", "cpuUsage", cpuId, BUFSIZE);
-      if (ret != 0)
+      /************************************************************************/
+      /* The application's own counters and gauges, read from shared memory.  */
+      /************************************************************************/
+      if (meas_metrics != NULL)
       {
-         printf("MeasThread::Missing parameters - cpuIdentifier is not there in cpuUsage, default to Cpu1\n");
-         strcpy(cpuId, "Cpu1");
+         evel_metrics_measurement_add(meas_metrics, vpp_m);
       }
-      read_keyVal_params(js, tokens, numToken, "tmp_cpuuse_command", "cpuUsage", keyValResultArray2, &numCpuUsageCommands);
-      memcpy(cpuUsageCommandArray, keyValResultArray2, (sizeof(KEYVALRESULT) * 32)); 
-      runCommands(cpuUsageCommandArray, numCpuUsageCommands);
-
-      cpu_use = evel_measurement_new_cpu_use_add(vpp_m, cpuId, usage);
-      if( cpu_use != NULL )
-      {
-/****************************
-         for(i=0; i<numCpuUsageCommands; i++)
-         {
-            if(strcmp(cpuUsageCommandArray[i].keyStr, "tmp_cpuIdle") == 0)
-            {
-               cpuIdle = atof(cpuUsageCommandArray[i].resultStr);
-            }
-            if(strcmp(cpuUsageCommandArray[i].keyStr, "tmp_cpuUsageSystem") == 0)
-            {
-               cpuSystem = atof(cpuUsageCommandArray[i].resultStr);
-            }
-            if(strcmp(cpuUsageCommandArray[i].keyStr, "tmp_cpuUsageUser") == 0)
-            {
-               cpuUser = atof(cpuUsageCommandArray[i].resultStr);
-            }
-         } **********************/
-         printf("%s", cpuUsageCommandArray[0].resultStr);
-         sscanf(cpuUsageCommandArray[0].resultStr, " %lf us, %lf sy,  %lf ni,  %lf id,  %lf wa,  %lf hi,  %lf si,  %lf st", &cpuUser,&cpuSystem,&nice,&cpuIdle,&wait,&intrpt,&softirq,&steal);
-printf("user - %f, system - %f, idle - %f\n", cpuUser, cpuSystem, cpuIdle);
-
-         evel_measurement_cpu_use_idle_set(cpu_use, cpuIdle);
-         evel_measurement_cpu_use_system_set(cpu_use, cpuSystem);
-         evel_measurement_cpu_use_usageuser_set(cpu_use, cpuUser);
-      }
-
-      struct timeval tv_now;
-      gettimeofday(&tv_now, NULL);
-      epoch_now = tv_now.tv_usec + 1000000 * tv_now.tv_sec;
 
       vpp_m_header = (EVENT_HEADER *)vpp_m;
 
 
-      if (eType != NULL)
-          evel_measurement_type_set(vpp_m, eType); 
+      if (meas->event_type != NULL)
+          evel_measurement_type_set(vpp_m, meas->event_type);
 
+      /************************************************************************/
+      /* The window is the scheduled interval, however late the job started. */
+      /************************************************************************/
       evel_start_epoch_set(&vpp_m->header, epoch_start);
-      evel_last_epoch_set(&vpp_m->header, epoch_now);
-      epoch_start= epoch_now;
-
-      if(nfcCode != NULL)
-          evel_nfcnamingcode_set(&vpp_m->header, nfcCode);
-      if(nfCode != NULL)
-          evel_nfnamingcode_set(&vpp_m->header, nfCode);
-      evel_reporting_entity_name_set(&vpp_m->header, reportEName);
-      if(reportEId != NULL)
-          evel_reporting_entity_id_set(&vpp_m->header, reportEId);
-      if(srcId != NULL )
-          evel_source_id_set(&vpp_m->header, srcId);
-      if(srcName!= NULL )
-          evel_source_name_set(&vpp_m->header, srcName);
+      evel_last_epoch_set(&vpp_m->header, scheduled);
+
+      if(meas->nfc_naming_code != NULL)
+          evel_nfcnamingcode_set(&vpp_m->header, meas->nfc_naming_code);
+      if(meas->nf_naming_code != NULL)
+          evel_nfnamingcode_set(&vpp_m->header, meas->nf_naming_code);
+      evel_reporting_entity_name_set(&vpp_m->header, meas->reporting_entity_name);
+      if(meas->reporting_entity_id != NULL)
+          evel_reporting_entity_id_set(&vpp_m->header, meas->reporting_entity_id);
+      if(meas->source_id != NULL)
+          evel_source_id_set(&vpp_m->header, meas->source_id);
+      evel_source_name_set(&vpp_m->header, meas->source_name);
 
       evel_rc = evel_post_event(vpp_m_header);
 
@@ -673,13 +863,146 @@ printf("user - %f, system - %f, idle - %f\n", cpuUser, cpuSystem, cpuIdle);
    {
       printf("MeasThread::Measurement event creation failed (%s)\n", evel_error_string());
    }
+   epoch_start = scheduled;
+
+   evel_scheduler_job_interval_set(meas_job, meas_interval * 1000);
+   evel_config_watch_release(meas_config_watch, meas);
+}
+
+/**************************************************************************//**
+ * Load meas_config.json, take the first interface readings and schedule the
+ * measurement and disk sampling jobs on meas_scheduler.  The scheduler is
+ * left for the caller to start.
+ *
+ * @returns 0 on success, or -1 on failure.
+ *****************************************************************************/
+int start_measurements(void)
+{
+   MEAS_CONFIG * meas;
+
+   const EVEL_IF_SNAPSHOT * snapshot;
+   int linkCount = 0;
+
+   int i = 0;
+
+   evel_id_generator_init(&meas_event_ids, "mvfs", 1);
+
+   memset(meas_hostname, 0, BUFSIZE);
+   gethostname(meas_hostname, BUFSIZE);
+   printf("MeasThread::The hostname is %s\n", meas_hostname);
+
+   for(i=0;i<MAX_INTERFACES;i++)
+   {
+      evel_counter_init(&meas_intfstat[i].bytes_in, EVEL_COUNTER_AUTO);
+      evel_counter_init(&meas_intfstat[i].bytes_out, EVEL_COUNTER_AUTO);
+      evel_counter_init(&meas_intfstat[i].packets_in, EVEL_COUNTER_AUTO);
+      evel_counter_init(&meas_intfstat[i].packets_out, EVEL_COUNTER_AUTO);
+   }
+   memset(&meas_linkstat[0],0,(sizeof(LINKSTAT) * MAX_INTERFACES));
+   if (evel_if_snapshot_init(&if_snapshot) != EVEL_SUCCESS)
+   {
+      printf("MeasThread::Failed to allocate interface counters\n");
+      return -1;
+   }
+
+   /***************************************************************************/
+   /* The configuration is parsed once, and again only when the file changes. */
+   /***************************************************************************/
+   meas_config_watch = evel_new_config_watch(meas_config_file,
+                                             compile_meas_config,
+                                             free_meas_config,
+                                             meas_hostname);
+   if (meas_config_watch == NULL)
+   {
+      printf("MeasThread::Failed to load %s\n", meas_config_file);
+      evel_if_snapshot_free(&if_snapshot);
+      return -1;
+   }
 
-   sleep(meas_interval);
+   /***************************************************************************/
+   /* Measurements are sent on the interval boundaries, however long the     */
+   /* collection takes, with the disk stats sampled every second between.    */
+   /***************************************************************************/
+   if (meas_scheduler == NULL)
+   {
+      meas_scheduler = evel_new_scheduler(2);
+   }
+   if (meas_scheduler == NULL)
+   {
+      printf("MeasThread::Failed to create the scheduler\n");
+      evel_free_config_watch(meas_config_watch);
+      meas_config_watch = NULL;
+      evel_if_snapshot_free(&if_snapshot);
+      return -1;
+   }
+
+  meas = evel_config_watch_acquire(meas_config_watch);
+  linkCount = update_links(meas);
+
+  snapshot = read_if_snapshot(meas->init_commands, meas->num_init_commands);
+  runCommands(meas->init_commands, meas->num_init_commands, linkCount, snapshot);
+  for(i=0;i<linkCount;i++)
+  {
+     copy_vpp_metic_data(meas_intfstat, meas->init_commands, &meas_probes[i * meas->num_init_commands], meas_results[i], meas->num_init_commands, i); 
   }
 
+  evel_init_cpu_stats();
+  evel_init_disk_stats();
+
+  epoch_start = evel_time_now_usec(EVEL_CLOCK_EXACT);
+
+  meas_job = evel_scheduler_job_add(meas_scheduler, "measurement", meas->interval * 1000, MeasJob, NULL);
+  evel_config_watch_release(meas_config_watch, meas);
+  if (meas_job == NULL ||
+      evel_scheduler_job_add(meas_scheduler, "disk samples", 1000, DiskSampleJob, NULL) == NULL)
+  {
+     printf("MeasThread::Failed to schedule measurements\n");
+     return -1;
+  }
+
+  return 0;
+}
+
+#ifndef VES_AGENT_PLUGIN
+void *MeasThread(void *mainMeas)
+{
+   sleep(1);
+   printf("MeasThread::Running Meas thread \n");
+   fflush(stdout);
+
+   if (start_measurements() != 0 ||
+       evel_scheduler_start(meas_scheduler) != EVEL_SUCCESS)
+   {
+      printf("MeasThread::Failed to start sending measurements. Exiting...\n");
+      exit(1);
+   }
+
+   while(1)
+   {
+      sleep(100);
+   }
+}
+#endif
+
+#ifdef VES_AGENT_PLUGIN
+/**************************************************************************//**
+ * Start sending measurements in the VES agent.
+ *****************************************************************************/
+int meas_plugin_start(const VES_PLUGIN_HOST * host, const char * config_file)
+{
+  meas_scheduler = host->scheduler;
+  meas_config_file = config_file;
+
   /***************************************************************************/
-  /* Terminate                                                               */
+  /* The jobs run on the agent's scheduler, which the agent starts, so there */
+  /* is no thread of our own.                                                */
   /***************************************************************************/
-  sleep(1);
+  return start_measurements();
 }
 
+const VES_PLUGIN ves_plugin = {
+  VES_PLUGIN_API_VERSION,
+  "measurement",
+  meas_plugin_start
+};
+#endif
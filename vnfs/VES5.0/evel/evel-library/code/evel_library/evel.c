@@ -126,6 +126,7 @@ EVEL_ERR_CODES evel_initialize(const char * const fqdn,
   char version_string[10] = {0};
   int offset;
   char * bakup_coll = NULL;
+  const char * trace_path = NULL;
 
   /***************************************************************************/
   /* Check assumptions.                                                      */
@@ -146,7 +147,29 @@ EVEL_ERR_CODES evel_initialize(const char * const fqdn,
      log_initialize(verbosity, "EVEL");
   else
      log_initialize(EVEL_LOG_MIN, "EVEL");
+
+  /***************************************************************************/
+  /* Move logging off the calling threads.  Failure is not fatal: we just    */
+  /* carry on logging synchronously.                                         */
+  /***************************************************************************/
+  if (log_async_start(getenv(EVEL_LOG_FILE_ENV)) != EVEL_SUCCESS)
+  {
+    EVEL_ERROR("Failed to start asynchronous logging");
+  }
   EVEL_INFO("EVEL started");
+
+  /***************************************************************************/
+  /* Start function tracing if a trace file has been requested.              */
+  /***************************************************************************/
+  trace_path = getenv(EVEL_TRACE_FILE_ENV);
+  if (trace_path != NULL && *trace_path != '\0')
+  {
+    if (evel_trace_start(trace_path) != EVEL_SUCCESS)
+    {
+      EVEL_ERROR("Failed to start tracing to %s", trace_path);
+    }
+  }
+
   EVEL_INFO("API server is: %s", fqdn);
   EVEL_INFO("API port is: %d", port);
 
@@ -324,14 +347,15 @@ EVEL_ERR_CODES evel_initialize(const char * const fqdn,
   }
 
   /***************************************************************************/
-  /* Extract the metadata from OpenStack. If we fail to extract it, we       */
-  /* record that in the logs, but carry on, assuming we're in a test         */
-  /* without a metadata service.                                             */
+  /* Start extracting the metadata from OpenStack.  Until the service        */
+  /* responds we use the values cached by the last run, or defaults if we're */
+  /* in a test without a metadata service, so this does not block.          */
   /***************************************************************************/
-  rc = openstack_metadata(verbosity);
+  rc = openstack_metadata_start(verbosity);
   if (rc != EVEL_SUCCESS)
   {
-    EVEL_INFO("Failed to load OpenStack metadata - assuming test environment");
+    EVEL_INFO("Failed to start OpenStack metadata discovery - "
+              "assuming test environment");
     rc = EVEL_SUCCESS;
   }
 
@@ -372,6 +396,11 @@ EVEL_ERR_CODES evel_terminate(void)
     log_error_state("Failed to terminate EVEL library cleanly!");
   }
 
+  /***************************************************************************/
+  /* Stop refreshing the metadata before cURL is shut down.                  */
+  /***************************************************************************/
+  openstack_metadata_stop();
+
   /***************************************************************************/
   /* Shut down the Event Handler library in a tidy manner.                   */
   /***************************************************************************/
@@ -387,7 +416,33 @@ EVEL_ERR_CODES evel_terminate(void)
   /***************************************************************************/
   evel_throttle_terminate();
 
+  /***************************************************************************/
+  /* Stop serving the latest values to Prometheus.                           */
+  /***************************************************************************/
+  evel_prometheus_stop();
+
+  /***************************************************************************/
+  /* Forget the values remembered for delta reporting.                       */
+  /***************************************************************************/
+  evel_delta_terminate();
+
+  /***************************************************************************/
+  /* Stop the timestamp ticker if the application started it.                */
+  /***************************************************************************/
+  evel_time_ticker_stop();
+
+  /***************************************************************************/
+  /* Flush out any function trace.                                           */
+  /***************************************************************************/
+  evel_trace_stop();
+
   EVEL_INFO("EVEL stopped");
+
+  /***************************************************************************/
+  /* Flush logs last so that everything above is written out.                */
+  /***************************************************************************/
+  log_async_stop();
+
   return(rc);
 }
 
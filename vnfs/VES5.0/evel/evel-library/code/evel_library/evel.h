@@ -815,3792 +815,6594 @@ typedef struct measurement_disk_use {
 MEASUREMENT_DISK_USE * evel_measurement_new_disk_use_add(EVENT_MEASUREMENT * measurement, char * id);
 
 /**************************************************************************//**
- * Filesystem Usage.
- * JSON equivalent field: filesystemUsage
+ * Set milliseconds spent doing input/output operations over 1 sec; treat
+ * this metric as a device load percentage where 1000ms  matches 100% load;
+ * provide the average over the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct measurement_fsys_use {
-  char * filesystem_name;
-  double block_configured;
-  double block_iops;
-  double block_used;
-  double ephemeral_configured;
-  double ephemeral_iops;
-  double ephemeral_used;
-} MEASUREMENT_FSYS_USE;
+void evel_measurement_disk_use_iotimeavg_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Memory Usage.
- * JSON equivalent field: memoryUsage
+ * Set milliseconds spent doing input/output operations over 1 sec; treat
+ * this metric as a device load percentage where 1000ms  matches 100% load;
+ * provide the last value within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct measurement_mem_use {
-  char * id;
-  char * vmid;
-  double membuffsz;
-  EVEL_OPTION_DOUBLE memcache;
-  EVEL_OPTION_DOUBLE memconfig;
-  EVEL_OPTION_DOUBLE memfree;
-  EVEL_OPTION_DOUBLE slabrecl;
-  EVEL_OPTION_DOUBLE slabunrecl;
-  EVEL_OPTION_DOUBLE memused;
-} MEASUREMENT_MEM_USE;
+void evel_measurement_disk_use_iotimelast_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Add an additional Memory usage value name/value pair to the Measurement.
- *
- * The name and value are null delimited ASCII strings.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * Set milliseconds spent doing input/output operations over 1 sec; treat
+ * this metric as a device load percentage where 1000ms  matches 100% load;
+ * provide the maximum value within the measurement interval
  *
- * @param measurement   Pointer to the measurement.
- * @param id            ASCIIZ string with the Memory identifier.
- * @param vmidentifier  ASCIIZ string with the VM's identifier.
- * @param membuffsz     Memory Size.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @return  Returns pointer to memory use structure in measurements
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-MEASUREMENT_MEM_USE * evel_measurement_new_mem_use_add(EVENT_MEASUREMENT * measurement,
-                                 char * id,  char *vmidentifier,  double membuffsz);
+void evel_measurement_disk_use_iotimemax_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Set kilobytes of memory used for cache
+ * Set milliseconds spent doing input/output operations over 1 sec; treat
+ * this metric as a device load percentage where 1000ms  matches 100% load;
+ * provide the minimum value within the measurement interval
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param mem_use      Pointer to the Memory Use.
+ * @param disk_use     Pointer to the Disk Use.
  * @param val          double
  *****************************************************************************/
-void evel_measurement_mem_use_memcache_set(MEASUREMENT_MEM_USE * const mem_use,
+void evel_measurement_disk_use_iotimemin_set(MEASUREMENT_DISK_USE * const disk_use,
                                     const double val);
+
 /**************************************************************************//**
- * Set kilobytes of memory configured in the virtual machine on which the VNFC reporting
+ * Set number of logical read operations that were merged into physical read
+ * operations, e.g., two logical reads were served by one physical disk access;
+ * provide the average measurement within the measurement interval
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param mem_use      Pointer to the Memory Use.
+ * @param disk_use     Pointer to the Disk Use.
  * @param val          double
  *****************************************************************************/
-void evel_measurement_mem_use_memconfig_set(MEASUREMENT_MEM_USE * const mem_use,
+void evel_measurement_disk_use_mergereadavg_set(MEASUREMENT_DISK_USE * const disk_use,
                                     const double val);
+
 /**************************************************************************//**
- * Set kilobytes of physical RAM left unused by the system
+ * Set number of logical read operations that were merged into physical read
+ * operations, e.g., two logical reads were served by one physical disk access;
+ * provide the last measurement within the measurement interval
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param mem_use      Pointer to the Memory Use.
+ * @param disk_use     Pointer to the Disk Use.
  * @param val          double
  *****************************************************************************/
-void evel_measurement_mem_use_memfree_set(MEASUREMENT_MEM_USE * const mem_use,
+void evel_measurement_disk_use_mergereadlast_set(MEASUREMENT_DISK_USE * const disk_use,
                                     const double val);
+
 /**************************************************************************//**
- * Set the part of the slab that can be reclaimed such as caches measured in kilobytes
+ * Set number of logical read operations that were merged into physical read
+ * operations, e.g., two logical reads were served by one physical disk access;
+ * provide the maximum measurement within the measurement interval
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param mem_use      Pointer to the Memory Use.
+ * @param disk_use     Pointer to the Disk Use.
  * @param val          double
  *****************************************************************************/
-void evel_measurement_mem_use_slab_reclaimed_set(MEASUREMENT_MEM_USE * const mem_use,
+void evel_measurement_disk_use_mergereadmax_set(MEASUREMENT_DISK_USE * const disk_use,
                                     const double val);
+
 /**************************************************************************//**
- * Set the part of the slab that cannot be reclaimed such as caches measured in kilobytes
+ * Set number of logical read operations that were merged into physical read
+ * operations, e.g., two logical reads were served by one physical disk access;
+ * provide the minimum measurement within the measurement interval
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param mem_use      Pointer to the Memory Use.
+ * @param disk_use     Pointer to the Disk Use.
  * @param val          double
  *****************************************************************************/
-void evel_measurement_mem_use_slab_unreclaimable_set(MEASUREMENT_MEM_USE * const mem_use,
+void evel_measurement_disk_use_mergereadmin_set(MEASUREMENT_DISK_USE * const disk_use,
                                     const double val);
+
 /**************************************************************************//**
- * Set the total memory minus the sum of free, buffered, cached and slab memory in kilobytes
+ * Set number of logical write operations that were merged into physical read
+ * operations, e.g., two logical writes were served by one physical disk access;
+ * provide the last measurement within the measurement interval
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param mem_use      Pointer to the Memory Use.
+ * @param disk_use     Pointer to the Disk Use.
  * @param val          double
  *****************************************************************************/
-void evel_measurement_mem_use_usedup_set(MEASUREMENT_MEM_USE * const mem_use,
+void evel_measurement_disk_use_mergewritelast_set(MEASUREMENT_DISK_USE * const disk_use,
                                     const double val);
+
 /**************************************************************************//**
- * Latency Bucket.
- * JSON equivalent field: latencyBucketMeasure
+ * Set number of logical write operations that were merged into physical read
+ * operations, e.g., two logical writes were served by one physical disk access;
+ * provide the maximum measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct measurement_latency_bucket {
-  int count;
-
-  /***************************************************************************/
-  /* Optional fields                                                         */
-  /***************************************************************************/
-  EVEL_OPTION_DOUBLE high_end;
-  EVEL_OPTION_DOUBLE low_end;
-
-} MEASUREMENT_LATENCY_BUCKET;
+void evel_measurement_disk_use_mergewritemax_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Virtual NIC usage.
- * JSON equivalent field: vNicUsage
+ * Set number of logical write operations that were merged into physical read
+ * operations, e.g., two logical writes were served by one physical disk access;
+ * provide the average measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct measurement_vnic_performance {
-  /***************************************************************************/
-  /* Optional fields                                                         */
-  /***************************************************************************/
-  /*Cumulative count of broadcast packets received as read at the end of
-   the measurement interval*/
-  EVEL_OPTION_DOUBLE recvd_bcast_packets_acc;
-  /*Count of broadcast packets received within the measurement interval*/
-  EVEL_OPTION_DOUBLE recvd_bcast_packets_delta;
-  /*Cumulative count of discarded packets received as read at the end of
-   the measurement interval*/
-  EVEL_OPTION_DOUBLE recvd_discarded_packets_acc;
-  /*Count of discarded packets received within the measurement interval*/
-  EVEL_OPTION_DOUBLE recvd_discarded_packets_delta;
-  /*Cumulative count of error packets received as read at the end of
-   the measurement interval*/
-  EVEL_OPTION_DOUBLE recvd_error_packets_acc;
-  /*Count of error packets received within the measurement interval*/
-  EVEL_OPTION_DOUBLE recvd_error_packets_delta;
-  /*Cumulative count of multicast packets received as read at the end of
-   the measurement interval*/
-  EVEL_OPTION_DOUBLE recvd_mcast_packets_acc;
-  /*Count of mcast packets received within the measurement interval*/
-  EVEL_OPTION_DOUBLE recvd_mcast_packets_delta;
-  /*Cumulative count of octets received as read at the end of
-   the measurement interval*/
-  EVEL_OPTION_DOUBLE recvd_octets_acc;
-  /*Count of octets received within the measurement interval*/
-  EVEL_OPTION_DOUBLE recvd_octets_delta;
-  /*Cumulative count of all packets received as read at the end of
-   the measurement interval*/
-  EVEL_OPTION_DOUBLE recvd_total_packets_acc;
-  /*Count of all packets received within the measurement interval*/
-  EVEL_OPTION_DOUBLE recvd_total_packets_delta;
-  /*Cumulative count of unicast packets received as read at the end of
-   the measurement interval*/
-  EVEL_OPTION_DOUBLE recvd_ucast_packets_acc;
-  /*Count of unicast packets received within the measurement interval*/
-  EVEL_OPTION_DOUBLE recvd_ucast_packets_delta;
-  /*Cumulative count of transmitted broadcast packets at the end of
-   the measurement interval*/
-  EVEL_OPTION_DOUBLE tx_bcast_packets_acc;
-  /*Count of transmitted broadcast packets within the measurement interval*/
-  EVEL_OPTION_DOUBLE tx_bcast_packets_delta;
-  /*Cumulative count of transmit discarded packets at the end of
-   the measurement interval*/
-  EVEL_OPTION_DOUBLE tx_discarded_packets_acc;
-  /*Count of transmit discarded packets within the measurement interval*/
-  EVEL_OPTION_DOUBLE tx_discarded_packets_delta;
-  /*Cumulative count of transmit error packets at the end of
-   the measurement interval*/
-  EVEL_OPTION_DOUBLE tx_error_packets_acc;
-  /*Count of transmit error packets within the measurement interval*/
-  EVEL_OPTION_DOUBLE tx_error_packets_delta;
-  /*Cumulative count of transmit multicast packets at the end of
-   the measurement interval*/
-  EVEL_OPTION_DOUBLE tx_mcast_packets_acc;
-  /*Count of transmit multicast packets within the measurement interval*/
-  EVEL_OPTION_DOUBLE tx_mcast_packets_delta;
-  /*Cumulative count of transmit octets at the end of
-   the measurement interval*/
-  EVEL_OPTION_DOUBLE tx_octets_acc;
-  /*Count of transmit octets received within the measurement interval*/
-  EVEL_OPTION_DOUBLE tx_octets_delta;
-  /*Cumulative count of all transmit packets at the end of
-   the measurement interval*/
-  EVEL_OPTION_DOUBLE tx_total_packets_acc;
-  /*Count of transmit packets within the measurement interval*/
-  EVEL_OPTION_DOUBLE tx_total_packets_delta;
-  /*Cumulative count of all transmit unicast packets at the end of
-   the measurement interval*/
-  EVEL_OPTION_DOUBLE tx_ucast_packets_acc;
-  /*Count of transmit unicast packets within the measurement interval*/
-  EVEL_OPTION_DOUBLE tx_ucast_packets_delta;
-  /* Indicates whether vNicPerformance values are likely inaccurate
-           due to counter overflow or other condtions*/
-  char *valuesaresuspect;
-  char *vnic_id;
-
-} MEASUREMENT_VNIC_PERFORMANCE;
+void evel_measurement_disk_use_mergewriteavg_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Codec Usage.
- * JSON equivalent field: codecsInUse
+ * Set number of logical write operations that were merged into physical read
+ * operations, e.g., two logical writes were served by one physical disk access;
+ * provide the maximum measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct measurement_codec_use {
-  char * codec_id;
-  int number_in_use;
-} MEASUREMENT_CODEC_USE;
+void evel_measurement_disk_use_mergewritemin_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Feature Usage.
- * JSON equivalent field: featuresInUse
+ * Set number of octets per second read from a disk or partition;
+ * provide the average measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct measurement_feature_use {
-  char * feature_id;
-  int feature_utilization;
-} MEASUREMENT_FEATURE_USE;
+void evel_measurement_disk_use_octetsreadavg_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Measurement Group.
- * JSON equivalent field: additionalMeasurements
+ * Set number of octets per second read from a disk or partition;
+ * provide the last measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct measurement_group {
-  char * name;
-  DLIST measurements;
-} MEASUREMENT_GROUP;
+void evel_measurement_disk_use_octetsreadlast_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Custom Defined Measurement.
- * JSON equivalent field: measurements
+ * Set number of octets per second read from a disk or partition;
+ * provide the maximum measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct custom_measurement {
-  char * name;
-  char * value;
-} CUSTOM_MEASUREMENT;
-
-/*****************************************************************************/
-/* Supported Report version.                                                 */
-/*****************************************************************************/
-#define EVEL_REPORT_MAJOR_VERSION 1
-#define EVEL_REPORT_MINOR_VERSION 0
+void evel_measurement_disk_use_octetsreadmax_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Report.
- * JSON equivalent field: measurementsForVfReportingFields
+ * Set number of octets per second read from a disk or partition;
+ * provide the minimum measurement within the measurement interval
  *
- * @note  This is an experimental event type and is not currently a formal part
- *        of AT&T's specification.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct event_report {
-  /***************************************************************************/
-  /* Header and version                                                      */
-  /***************************************************************************/
-  EVENT_HEADER header;
-  int major_version;
-  int minor_version;
-
-  /***************************************************************************/
-  /* Mandatory fields                                                        */
-  /***************************************************************************/
-  double measurement_interval;
-
-  /***************************************************************************/
-  /* Optional fields                                                         */
-  /***************************************************************************/
-  DLIST feature_usage;
-  DLIST measurement_groups;
-
-} EVENT_REPORT;
+void evel_measurement_disk_use_octetsreadmin_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Mobile GTP Per Flow Metrics.
- * JSON equivalent field: gtpPerFlowMetrics
+ * Set number of octets per second written to a disk or partition;
+ * provide the average measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct mobile_gtp_per_flow_metrics {
-  double avg_bit_error_rate;
-  double avg_packet_delay_variation;
-  int avg_packet_latency;
-  int avg_receive_throughput;
-  int avg_transmit_throughput;
-  int flow_activation_epoch;
-  int flow_activation_microsec;
-  int flow_deactivation_epoch;
-  int flow_deactivation_microsec;
-  time_t flow_deactivation_time;
-  char * flow_status;
-  int max_packet_delay_variation;
-  int num_activation_failures;
-  int num_bit_errors;
-  int num_bytes_received;
-  int num_bytes_transmitted;
-  int num_dropped_packets;
-  int num_l7_bytes_received;
-  int num_l7_bytes_transmitted;
-  int num_lost_packets;
-  int num_out_of_order_packets;
-  int num_packet_errors;
-  int num_packets_received_excl_retrans;
-  int num_packets_received_incl_retrans;
-  int num_packets_transmitted_incl_retrans;
-  int num_retries;
-  int num_timeouts;
-  int num_tunneled_l7_bytes_received;
-  int round_trip_time;
-  int time_to_first_byte;
-
-  /***************************************************************************/
-  /* Optional fields                                                         */
-  /***************************************************************************/
-  EVEL_OPTION_INT ip_tos_counts[EVEL_TOS_SUPPORTED];
-  EVEL_OPTION_INT tcp_flag_counts[EVEL_MAX_TCP_FLAGS];
-  EVEL_OPTION_INT qci_cos_counts[EVEL_MAX_QCI_COS_TYPES];
-  EVEL_OPTION_INT dur_connection_failed_status;
-  EVEL_OPTION_INT dur_tunnel_failed_status;
-  EVEL_OPTION_STRING flow_activated_by;
-  EVEL_OPTION_TIME flow_activation_time;
-  EVEL_OPTION_STRING flow_deactivated_by;
-  EVEL_OPTION_STRING gtp_connection_status;
-  EVEL_OPTION_STRING gtp_tunnel_status;
-  EVEL_OPTION_INT large_packet_rtt;
-  EVEL_OPTION_DOUBLE large_packet_threshold;
-  EVEL_OPTION_INT max_receive_bit_rate;
-  EVEL_OPTION_INT max_transmit_bit_rate;
-  EVEL_OPTION_INT num_gtp_echo_failures;
-  EVEL_OPTION_INT num_gtp_tunnel_errors;
-  EVEL_OPTION_INT num_http_errors;
-
-} MOBILE_GTP_PER_FLOW_METRICS;
-
-/*****************************************************************************/
-/* Supported Mobile Flow version.                                            */
-/*****************************************************************************/
-#define EVEL_MOBILE_FLOW_MAJOR_VERSION 2
-#define EVEL_MOBILE_FLOW_MINOR_VERSION 0
+void evel_measurement_disk_use_octetswriteavg_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Mobile Flow.
- * JSON equivalent field: mobileFlow
+ * Set number of octets per second written to a disk or partition;
+ * provide the last measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct event_mobile_flow {
-  /***************************************************************************/
-  /* Header and version                                                      */
-  /***************************************************************************/
-  EVENT_HEADER header;
-  int major_version;
-  int minor_version;
-
-  /***************************************************************************/
-  /* Mandatory fields                                                        */
-  /***************************************************************************/
-  char * flow_direction;
-  MOBILE_GTP_PER_FLOW_METRICS * gtp_per_flow_metrics;
-  char * ip_protocol_type;
-  char * ip_version;
-  char * other_endpoint_ip_address;
-  int other_endpoint_port;
-  char * reporting_endpoint_ip_addr;
-  int reporting_endpoint_port;
-  DLIST additional_info;                         /* JSON: additionalFields */
-
-  /***************************************************************************/
-  /* Optional fields                                                         */
-  /***************************************************************************/
-  EVEL_OPTION_STRING application_type;
-  EVEL_OPTION_STRING app_protocol_type;
-  EVEL_OPTION_STRING app_protocol_version;
-  EVEL_OPTION_STRING cid;
-  EVEL_OPTION_STRING connection_type;
-  EVEL_OPTION_STRING ecgi;
-  EVEL_OPTION_STRING gtp_protocol_type;
-  EVEL_OPTION_STRING gtp_version;
-  EVEL_OPTION_STRING http_header;
-  EVEL_OPTION_STRING imei;
-  EVEL_OPTION_STRING imsi;
-  EVEL_OPTION_STRING lac;
-  EVEL_OPTION_STRING mcc;
-  EVEL_OPTION_STRING mnc;
-  EVEL_OPTION_STRING msisdn;
-  EVEL_OPTION_STRING other_functional_role;
-  EVEL_OPTION_STRING rac;
-  EVEL_OPTION_STRING radio_access_technology;
-  EVEL_OPTION_STRING sac;
-  EVEL_OPTION_INT sampling_algorithm;
-  EVEL_OPTION_STRING tac;
-  EVEL_OPTION_STRING tunnel_id;
-  EVEL_OPTION_STRING vlan_id;
-
-} EVENT_MOBILE_FLOW;
-
-/*****************************************************************************/
-/* Supported Other field version.                                            */
-/*****************************************************************************/
-#define EVEL_OTHER_EVENT_MAJOR_VERSION 1
-#define EVEL_OTHER_EVENT_MINOR_VERSION 0
+void evel_measurement_disk_use_octetswritelast_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Other.
- * JSON equivalent field: otherFields
+ * Set number of octets per second written to a disk or partition;
+ * provide the maximum measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct event_other {
-  EVENT_HEADER header;
-  int major_version;
-  int minor_version;
-
-  HASHTABLE_T *namedarrays; /* HASHTABLE_T */
-  DLIST jsonobjects; /* DLIST of EVEL_JSON_OBJECT */
-  DLIST namedvalues;
-} EVENT_OTHER;
+void evel_measurement_disk_use_octetswritemax_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Other Field.
- * JSON equivalent field: otherFields
+ * Set number of octets per second written to a disk or partition;
+ * provide the minimum measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct other_field {
-  char * name;
-  char * value;
-} OTHER_FIELD;
-
+void evel_measurement_disk_use_octetswritemin_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
-/*****************************************************************************/
-/* Supported Service Events version.                                         */
-/*****************************************************************************/
-#define EVEL_HEARTBEAT_FIELD_MAJOR_VERSION 1
-#define EVEL_HEARTBEAT_FIELD_MINOR_VERSION 0
+/**************************************************************************//**
+ * Set number of read operations per second issued to the disk;
+ * provide the average measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_disk_use_opsreadavg_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
+/**************************************************************************//**
+ * Set number of read operations per second issued to the disk;
+ * provide the last measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_disk_use_opsreadlast_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
-/*****************************************************************************/
-/* Supported Signaling version.                                              */
-/*****************************************************************************/
-#define EVEL_SIGNALING_MAJOR_VERSION 1
-#define EVEL_SIGNALING_MINOR_VERSION 0
+/**************************************************************************//**
+ * Set number of read operations per second issued to the disk;
+ * provide the maximum measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_disk_use_opsreadmax_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Vendor VNF Name fields.
- * JSON equivalent field: vendorVnfNameFields
+ * Set number of read operations per second issued to the disk;
+ * provide the minimum measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct vendor_vnfname_field {
-  char * vendorname;
-  EVEL_OPTION_STRING vfmodule;
-  EVEL_OPTION_STRING vnfname;
-} VENDOR_VNFNAME_FIELD;
+void evel_measurement_disk_use_opsreadmin_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Signaling.
- * JSON equivalent field: signalingFields
+ * Set number of write operations per second issued to the disk;
+ * provide the average measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct event_signaling {
-  /***************************************************************************/
-  /* Header and version                                                      */
-  /***************************************************************************/
-  EVENT_HEADER header;
-  int major_version;
-  int minor_version;
+void evel_measurement_disk_use_opswriteavg_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
-  /***************************************************************************/
-  /* Mandatory fields                                                        */
-  /***************************************************************************/
-  VENDOR_VNFNAME_FIELD vnfname_field;
-  EVEL_OPTION_STRING correlator;                         /* JSON: correlator */
-  EVEL_OPTION_STRING local_ip_address;               /* JSON: localIpAddress */
-  EVEL_OPTION_STRING local_port;                          /* JSON: localPort */
-  EVEL_OPTION_STRING remote_ip_address;             /* JSON: remoteIpAddress */
-  EVEL_OPTION_STRING remote_port;                        /* JSON: remotePort */
+/**************************************************************************//**
+ * Set number of write operations per second issued to the disk;
+ * provide the last measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_disk_use_opswritelast_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
-  /***************************************************************************/
-  /* Optional fields                                                         */
-  /***************************************************************************/
-  EVEL_OPTION_STRING compressed_sip;                  /* JSON: compressedSip */
-  EVEL_OPTION_STRING summary_sip;                        /* JSON: summarySip */
-  DLIST additional_info;
+/**************************************************************************//**
+ * Set number of write operations per second issued to the disk;
+ * provide the maximum measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_disk_use_opswritemax_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
-} EVENT_SIGNALING;
+/**************************************************************************//**
+ * Set number of write operations per second issued to the disk;
+ * provide the average measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_disk_use_opswritemin_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Sgnaling Additional Field.
- * JSON equivalent field: additionalFields
+ * Set queue size of pending I/O operations per second;
+ * provide the average measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct signaling_additional_field {
-  char * name;
-  char * value;
-} SIGNALING_ADDL_FIELD;
+void evel_measurement_disk_use_pendingopsavg_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
-/*****************************************************************************/
-/* Supported State Change version.                                           */
-/*****************************************************************************/
-#define EVEL_STATE_CHANGE_MAJOR_VERSION 2
-#define EVEL_STATE_CHANGE_MINOR_VERSION 0
+/**************************************************************************//**
+ * Set queue size of pending I/O operations per second;
+ * provide the last measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_disk_use_pendingopslast_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * State Change.
- * JSON equivalent field: stateChangeFields
+ * Set queue size of pending I/O operations per second;
+ * provide the maximum measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct event_state_change {
-  /***************************************************************************/
-  /* Header and version                                                      */
-  /***************************************************************************/
-  EVENT_HEADER header;
-  int major_version;
-  int minor_version;
+void evel_measurement_disk_use_pendingopsmax_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
-  /***************************************************************************/
-  /* Mandatory fields                                                        */
-  /***************************************************************************/
-  EVEL_ENTITY_STATE new_state;
-  EVEL_ENTITY_STATE old_state;
-  char * state_interface;
-  double version;
+/**************************************************************************//**
+ * Set queue size of pending I/O operations per second;
+ * provide the minimum measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_disk_use_pendingopsmin_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
-  /***************************************************************************/
-  /* Optional fields                                                         */
-  /***************************************************************************/
-  DLIST additional_fields;
+/**************************************************************************//**
+ * Set milliseconds a read operation took to complete;
+ * provide the average measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_disk_use_timereadavg_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
-} EVENT_STATE_CHANGE;
+/**************************************************************************//**
+ * Set milliseconds a read operation took to complete;
+ * provide the last measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_disk_use_timereadlast_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * State Change Additional Field.
- * JSON equivalent field: additionalFields
+ * Set milliseconds a read operation took to complete;
+ * provide the maximum measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct state_change_additional_field {
-  char * name;
-  char * value;
-} STATE_CHANGE_ADDL_FIELD;
+void evel_measurement_disk_use_timereadmax_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
-/*****************************************************************************/
-/* Supported Syslog version.                                                 */
-/*****************************************************************************/
-#define EVEL_SYSLOG_MAJOR_VERSION 3
-#define EVEL_SYSLOG_MINOR_VERSION 0
+/**************************************************************************//**
+ * Set milliseconds a read operation took to complete;
+ * provide the minimum measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_disk_use_timereadmin_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
 /**************************************************************************//**
- * Syslog.
- * JSON equivalent field: syslogFields
+ * Set milliseconds a write operation took to complete;
+ * provide the average measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
  *****************************************************************************/
-typedef struct event_syslog {
-  /***************************************************************************/
-  /* Header and version                                                      */
-  /***************************************************************************/
-  EVENT_HEADER header;
-  int major_version;
-  int minor_version;
+void evel_measurement_disk_use_timewriteavg_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
-  /***************************************************************************/
-  /* Mandatory fields                                                        */
-  /***************************************************************************/
-  EVEL_SOURCE_TYPES event_source_type;
-  char * syslog_msg;
-  char * syslog_tag;
+/**************************************************************************//**
+ * Set milliseconds a write operation took to complete;
+ * provide the last measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_disk_use_timewritelast_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
-  /***************************************************************************/
-  /* Optional fields                                                         */
-  /***************************************************************************/
-  EVEL_OPTION_STRING additional_filters;
-  EVEL_OPTION_STRING event_source_host;
-  EVEL_OPTION_INT syslog_facility;
-  EVEL_OPTION_INT syslog_priority;
-  EVEL_OPTION_STRING syslog_proc;
-  EVEL_OPTION_INT syslog_proc_id;
-  EVEL_OPTION_STRING syslog_s_data;
-  EVEL_OPTION_STRING syslog_sdid;
-  EVEL_OPTION_STRING syslog_severity;
-  double syslog_fver;
-  EVEL_OPTION_INT syslog_ver;
+/**************************************************************************//**
+ * Set milliseconds a write operation took to complete;
+ * provide the maximum measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_disk_use_timewritemax_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
 
-} EVENT_SYSLOG;
+/**************************************************************************//**
+ * Set milliseconds a write operation took to complete;
+ * provide the average measurement within the measurement interval
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param disk_use     Pointer to the Disk Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_disk_use_timewritemin_set(MEASUREMENT_DISK_USE * const disk_use,
+                                    const double val);
+
+/**************************************************************************//**
+ * Filesystem Usage.
+ * JSON equivalent field: filesystemUsage
+ *****************************************************************************/
+typedef struct measurement_fsys_use {
+  char * filesystem_name;
+  double block_configured;
+  double block_iops;
+  double block_used;
+  double ephemeral_configured;
+  double ephemeral_iops;
+  double ephemeral_used;
+} MEASUREMENT_FSYS_USE;
+
+/**************************************************************************//**
+ * Memory Usage.
+ * JSON equivalent field: memoryUsage
+ *****************************************************************************/
+typedef struct measurement_mem_use {
+  char * id;
+  char * vmid;
+  double membuffsz;
+  EVEL_OPTION_DOUBLE memcache;
+  EVEL_OPTION_DOUBLE memconfig;
+  EVEL_OPTION_DOUBLE memfree;
+  EVEL_OPTION_DOUBLE slabrecl;
+  EVEL_OPTION_DOUBLE slabunrecl;
+  EVEL_OPTION_DOUBLE memused;
+} MEASUREMENT_MEM_USE;
 
 /**************************************************************************//**
- * Copyright.
- * JSON equivalent object: attCopyrightNotice
+ * Add an additional Memory usage value name/value pair to the Measurement.
+ *
+ * The name and value are null delimited ASCII strings.  The library takes
+ * a copy so the caller does not have to preserve values after the function
+ * returns.
+ *
+ * @param measurement   Pointer to the measurement.
+ * @param id            ASCIIZ string with the Memory identifier.
+ * @param vmidentifier  ASCIIZ string with the VM's identifier.
+ * @param membuffsz     Memory Size.
+ *
+ * @return  Returns pointer to memory use structure in measurements
+ *****************************************************************************/
+MEASUREMENT_MEM_USE * evel_measurement_new_mem_use_add(EVENT_MEASUREMENT * measurement,
+                                 char * id,  char *vmidentifier,  double membuffsz);
+
+/**************************************************************************//**
+ * Set kilobytes of memory used for cache
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param mem_use      Pointer to the Memory Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_mem_use_memcache_set(MEASUREMENT_MEM_USE * const mem_use,
+                                    const double val);
+/**************************************************************************//**
+ * Set kilobytes of memory configured in the virtual machine on which the VNFC reporting
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param mem_use      Pointer to the Memory Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_mem_use_memconfig_set(MEASUREMENT_MEM_USE * const mem_use,
+                                    const double val);
+/**************************************************************************//**
+ * Set kilobytes of physical RAM left unused by the system
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param mem_use      Pointer to the Memory Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_mem_use_memfree_set(MEASUREMENT_MEM_USE * const mem_use,
+                                    const double val);
+/**************************************************************************//**
+ * Set the part of the slab that can be reclaimed such as caches measured in kilobytes
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param mem_use      Pointer to the Memory Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_mem_use_slab_reclaimed_set(MEASUREMENT_MEM_USE * const mem_use,
+                                    const double val);
+/**************************************************************************//**
+ * Set the part of the slab that cannot be reclaimed such as caches measured in kilobytes
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param mem_use      Pointer to the Memory Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_mem_use_slab_unreclaimable_set(MEASUREMENT_MEM_USE * const mem_use,
+                                    const double val);
+/**************************************************************************//**
+ * Set the total memory minus the sum of free, buffered, cached and slab memory in kilobytes
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param mem_use      Pointer to the Memory Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_mem_use_usedup_set(MEASUREMENT_MEM_USE * const mem_use,
+                                    const double val);
+/**************************************************************************//**
+ * Latency Bucket.
+ * JSON equivalent field: latencyBucketMeasure
+ *****************************************************************************/
+typedef struct measurement_latency_bucket {
+  int count;
+
+  /***************************************************************************/
+  /* Optional fields                                                         */
+  /***************************************************************************/
+  EVEL_OPTION_DOUBLE high_end;
+  EVEL_OPTION_DOUBLE low_end;
+
+} MEASUREMENT_LATENCY_BUCKET;
+
+/**************************************************************************//**
+ * Virtual NIC usage.
+ * JSON equivalent field: vNicUsage
+ *****************************************************************************/
+typedef struct measurement_vnic_performance {
+  /***************************************************************************/
+  /* Optional fields                                                         */
+  /***************************************************************************/
+  /*Cumulative count of broadcast packets received as read at the end of
+   the measurement interval*/
+  EVEL_OPTION_DOUBLE recvd_bcast_packets_acc;
+  /*Count of broadcast packets received within the measurement interval*/
+  EVEL_OPTION_DOUBLE recvd_bcast_packets_delta;
+  /*Cumulative count of discarded packets received as read at the end of
+   the measurement interval*/
+  EVEL_OPTION_DOUBLE recvd_discarded_packets_acc;
+  /*Count of discarded packets received within the measurement interval*/
+  EVEL_OPTION_DOUBLE recvd_discarded_packets_delta;
+  /*Cumulative count of error packets received as read at the end of
+   the measurement interval*/
+  EVEL_OPTION_DOUBLE recvd_error_packets_acc;
+  /*Count of error packets received within the measurement interval*/
+  EVEL_OPTION_DOUBLE recvd_error_packets_delta;
+  /*Cumulative count of multicast packets received as read at the end of
+   the measurement interval*/
+  EVEL_OPTION_DOUBLE recvd_mcast_packets_acc;
+  /*Count of mcast packets received within the measurement interval*/
+  EVEL_OPTION_DOUBLE recvd_mcast_packets_delta;
+  /*Cumulative count of octets received as read at the end of
+   the measurement interval*/
+  EVEL_OPTION_DOUBLE recvd_octets_acc;
+  /*Count of octets received within the measurement interval*/
+  EVEL_OPTION_DOUBLE recvd_octets_delta;
+  /*Cumulative count of all packets received as read at the end of
+   the measurement interval*/
+  EVEL_OPTION_DOUBLE recvd_total_packets_acc;
+  /*Count of all packets received within the measurement interval*/
+  EVEL_OPTION_DOUBLE recvd_total_packets_delta;
+  /*Cumulative count of unicast packets received as read at the end of
+   the measurement interval*/
+  EVEL_OPTION_DOUBLE recvd_ucast_packets_acc;
+  /*Count of unicast packets received within the measurement interval*/
+  EVEL_OPTION_DOUBLE recvd_ucast_packets_delta;
+  /*Cumulative count of transmitted broadcast packets at the end of
+   the measurement interval*/
+  EVEL_OPTION_DOUBLE tx_bcast_packets_acc;
+  /*Count of transmitted broadcast packets within the measurement interval*/
+  EVEL_OPTION_DOUBLE tx_bcast_packets_delta;
+  /*Cumulative count of transmit discarded packets at the end of
+   the measurement interval*/
+  EVEL_OPTION_DOUBLE tx_discarded_packets_acc;
+  /*Count of transmit discarded packets within the measurement interval*/
+  EVEL_OPTION_DOUBLE tx_discarded_packets_delta;
+  /*Cumulative count of transmit error packets at the end of
+   the measurement interval*/
+  EVEL_OPTION_DOUBLE tx_error_packets_acc;
+  /*Count of transmit error packets within the measurement interval*/
+  EVEL_OPTION_DOUBLE tx_error_packets_delta;
+  /*Cumulative count of transmit multicast packets at the end of
+   the measurement interval*/
+  EVEL_OPTION_DOUBLE tx_mcast_packets_acc;
+  /*Count of transmit multicast packets within the measurement interval*/
+  EVEL_OPTION_DOUBLE tx_mcast_packets_delta;
+  /*Cumulative count of transmit octets at the end of
+   the measurement interval*/
+  EVEL_OPTION_DOUBLE tx_octets_acc;
+  /*Count of transmit octets received within the measurement interval*/
+  EVEL_OPTION_DOUBLE tx_octets_delta;
+  /*Cumulative count of all transmit packets at the end of
+   the measurement interval*/
+  EVEL_OPTION_DOUBLE tx_total_packets_acc;
+  /*Count of transmit packets within the measurement interval*/
+  EVEL_OPTION_DOUBLE tx_total_packets_delta;
+  /*Cumulative count of all transmit unicast packets at the end of
+   the measurement interval*/
+  EVEL_OPTION_DOUBLE tx_ucast_packets_acc;
+  /*Count of transmit unicast packets within the measurement interval*/
+  EVEL_OPTION_DOUBLE tx_ucast_packets_delta;
+  /* Indicates whether vNicPerformance values are likely inaccurate
+           due to counter overflow or other condtions*/
+  char *valuesaresuspect;
+  char *vnic_id;
+
+} MEASUREMENT_VNIC_PERFORMANCE;
+
+/**************************************************************************//**
+ * Codec Usage.
+ * JSON equivalent field: codecsInUse
+ *****************************************************************************/
+typedef struct measurement_codec_use {
+  char * codec_id;
+  int number_in_use;
+} MEASUREMENT_CODEC_USE;
+
+/**************************************************************************//**
+ * Feature Usage.
+ * JSON equivalent field: featuresInUse
+ *****************************************************************************/
+typedef struct measurement_feature_use {
+  char * feature_id;
+  int feature_utilization;
+} MEASUREMENT_FEATURE_USE;
+
+/**************************************************************************//**
+ * Measurement Group.
+ * JSON equivalent field: additionalMeasurements
+ *****************************************************************************/
+typedef struct measurement_group {
+  char * name;
+  DLIST measurements;
+} MEASUREMENT_GROUP;
+
+/**************************************************************************//**
+ * Custom Defined Measurement.
+ * JSON equivalent field: measurements
+ *****************************************************************************/
+typedef struct custom_measurement {
+  char * name;
+  char * value;
+} CUSTOM_MEASUREMENT;
+
+/*****************************************************************************/
+/* Supported Report version.                                                 */
+/*****************************************************************************/
+#define EVEL_REPORT_MAJOR_VERSION 1
+#define EVEL_REPORT_MINOR_VERSION 0
+
+/**************************************************************************//**
+ * Report.
+ * JSON equivalent field: measurementsForVfReportingFields
+ *
+ * @note  This is an experimental event type and is not currently a formal part
+ *        of AT&T's specification.
+ *****************************************************************************/
+typedef struct event_report {
+  /***************************************************************************/
+  /* Header and version                                                      */
+  /***************************************************************************/
+  EVENT_HEADER header;
+  int major_version;
+  int minor_version;
+
+  /***************************************************************************/
+  /* Mandatory fields                                                        */
+  /***************************************************************************/
+  double measurement_interval;
+
+  /***************************************************************************/
+  /* Optional fields                                                         */
+  /***************************************************************************/
+  DLIST feature_usage;
+  DLIST measurement_groups;
+
+} EVENT_REPORT;
+
+/**************************************************************************//**
+ * Mobile GTP Per Flow Metrics.
+ * JSON equivalent field: gtpPerFlowMetrics
+ *****************************************************************************/
+typedef struct mobile_gtp_per_flow_metrics {
+  double avg_bit_error_rate;
+  double avg_packet_delay_variation;
+  int avg_packet_latency;
+  int avg_receive_throughput;
+  int avg_transmit_throughput;
+  int flow_activation_epoch;
+  int flow_activation_microsec;
+  int flow_deactivation_epoch;
+  int flow_deactivation_microsec;
+  time_t flow_deactivation_time;
+  char * flow_status;
+  int max_packet_delay_variation;
+  int num_activation_failures;
+  int num_bit_errors;
+  int num_bytes_received;
+  int num_bytes_transmitted;
+  int num_dropped_packets;
+  int num_l7_bytes_received;
+  int num_l7_bytes_transmitted;
+  int num_lost_packets;
+  int num_out_of_order_packets;
+  int num_packet_errors;
+  int num_packets_received_excl_retrans;
+  int num_packets_received_incl_retrans;
+  int num_packets_transmitted_incl_retrans;
+  int num_retries;
+  int num_timeouts;
+  int num_tunneled_l7_bytes_received;
+  int round_trip_time;
+  int time_to_first_byte;
+
+  /***************************************************************************/
+  /* Optional fields                                                         */
+  /***************************************************************************/
+  EVEL_OPTION_INT ip_tos_counts[EVEL_TOS_SUPPORTED];
+  EVEL_OPTION_INT tcp_flag_counts[EVEL_MAX_TCP_FLAGS];
+  EVEL_OPTION_INT qci_cos_counts[EVEL_MAX_QCI_COS_TYPES];
+  EVEL_OPTION_INT dur_connection_failed_status;
+  EVEL_OPTION_INT dur_tunnel_failed_status;
+  EVEL_OPTION_STRING flow_activated_by;
+  EVEL_OPTION_TIME flow_activation_time;
+  EVEL_OPTION_STRING flow_deactivated_by;
+  EVEL_OPTION_STRING gtp_connection_status;
+  EVEL_OPTION_STRING gtp_tunnel_status;
+  EVEL_OPTION_INT large_packet_rtt;
+  EVEL_OPTION_DOUBLE large_packet_threshold;
+  EVEL_OPTION_INT max_receive_bit_rate;
+  EVEL_OPTION_INT max_transmit_bit_rate;
+  EVEL_OPTION_INT num_gtp_echo_failures;
+  EVEL_OPTION_INT num_gtp_tunnel_errors;
+  EVEL_OPTION_INT num_http_errors;
+
+} MOBILE_GTP_PER_FLOW_METRICS;
+
+/*****************************************************************************/
+/* Supported Mobile Flow version.                                            */
+/*****************************************************************************/
+#define EVEL_MOBILE_FLOW_MAJOR_VERSION 2
+#define EVEL_MOBILE_FLOW_MINOR_VERSION 0
+
+/**************************************************************************//**
+ * Mobile Flow.
+ * JSON equivalent field: mobileFlow
+ *****************************************************************************/
+typedef struct event_mobile_flow {
+  /***************************************************************************/
+  /* Header and version                                                      */
+  /***************************************************************************/
+  EVENT_HEADER header;
+  int major_version;
+  int minor_version;
+
+  /***************************************************************************/
+  /* Mandatory fields                                                        */
+  /***************************************************************************/
+  char * flow_direction;
+  MOBILE_GTP_PER_FLOW_METRICS * gtp_per_flow_metrics;
+  char * ip_protocol_type;
+  char * ip_version;
+  char * other_endpoint_ip_address;
+  int other_endpoint_port;
+  char * reporting_endpoint_ip_addr;
+  int reporting_endpoint_port;
+  DLIST additional_info;                         /* JSON: additionalFields */
+
+  /***************************************************************************/
+  /* Optional fields                                                         */
+  /***************************************************************************/
+  EVEL_OPTION_STRING application_type;
+  EVEL_OPTION_STRING app_protocol_type;
+  EVEL_OPTION_STRING app_protocol_version;
+  EVEL_OPTION_STRING cid;
+  EVEL_OPTION_STRING connection_type;
+  EVEL_OPTION_STRING ecgi;
+  EVEL_OPTION_STRING gtp_protocol_type;
+  EVEL_OPTION_STRING gtp_version;
+  EVEL_OPTION_STRING http_header;
+  EVEL_OPTION_STRING imei;
+  EVEL_OPTION_STRING imsi;
+  EVEL_OPTION_STRING lac;
+  EVEL_OPTION_STRING mcc;
+  EVEL_OPTION_STRING mnc;
+  EVEL_OPTION_STRING msisdn;
+  EVEL_OPTION_STRING other_functional_role;
+  EVEL_OPTION_STRING rac;
+  EVEL_OPTION_STRING radio_access_technology;
+  EVEL_OPTION_STRING sac;
+  EVEL_OPTION_INT sampling_algorithm;
+  EVEL_OPTION_STRING tac;
+  EVEL_OPTION_STRING tunnel_id;
+  EVEL_OPTION_STRING vlan_id;
+
+} EVENT_MOBILE_FLOW;
+
+/*****************************************************************************/
+/* Supported Other field version.                                            */
+/*****************************************************************************/
+#define EVEL_OTHER_EVENT_MAJOR_VERSION 1
+#define EVEL_OTHER_EVENT_MINOR_VERSION 0
+
+/**************************************************************************//**
+ * Other.
+ * JSON equivalent field: otherFields
+ *****************************************************************************/
+typedef struct event_other {
+  EVENT_HEADER header;
+  int major_version;
+  int minor_version;
+
+  HASHTABLE_T *namedarrays; /* HASHTABLE_T */
+  DLIST jsonobjects; /* DLIST of EVEL_JSON_OBJECT */
+  DLIST namedvalues;
+} EVENT_OTHER;
+
+/**************************************************************************//**
+ * Other Field.
+ * JSON equivalent field: otherFields
+ *****************************************************************************/
+typedef struct other_field {
+  char * name;
+  char * value;
+} OTHER_FIELD;
+
+
+/*****************************************************************************/
+/* Supported Service Events version.                                         */
+/*****************************************************************************/
+#define EVEL_HEARTBEAT_FIELD_MAJOR_VERSION 1
+#define EVEL_HEARTBEAT_FIELD_MINOR_VERSION 0
+
+
+/*****************************************************************************/
+/* Supported Signaling version.                                              */
+/*****************************************************************************/
+#define EVEL_SIGNALING_MAJOR_VERSION 1
+#define EVEL_SIGNALING_MINOR_VERSION 0
+
+/**************************************************************************//**
+ * Vendor VNF Name fields.
+ * JSON equivalent field: vendorVnfNameFields
+ *****************************************************************************/
+typedef struct vendor_vnfname_field {
+  char * vendorname;
+  EVEL_OPTION_STRING vfmodule;
+  EVEL_OPTION_STRING vnfname;
+} VENDOR_VNFNAME_FIELD;
+
+/**************************************************************************//**
+ * Signaling.
+ * JSON equivalent field: signalingFields
+ *****************************************************************************/
+typedef struct event_signaling {
+  /***************************************************************************/
+  /* Header and version                                                      */
+  /***************************************************************************/
+  EVENT_HEADER header;
+  int major_version;
+  int minor_version;
+
+  /***************************************************************************/
+  /* Mandatory fields                                                        */
+  /***************************************************************************/
+  VENDOR_VNFNAME_FIELD vnfname_field;
+  EVEL_OPTION_STRING correlator;                         /* JSON: correlator */
+  EVEL_OPTION_STRING local_ip_address;               /* JSON: localIpAddress */
+  EVEL_OPTION_STRING local_port;                          /* JSON: localPort */
+  EVEL_OPTION_STRING remote_ip_address;             /* JSON: remoteIpAddress */
+  EVEL_OPTION_STRING remote_port;                        /* JSON: remotePort */
+
+  /***************************************************************************/
+  /* Optional fields                                                         */
+  /***************************************************************************/
+  EVEL_OPTION_STRING compressed_sip;                  /* JSON: compressedSip */
+  EVEL_OPTION_STRING summary_sip;                        /* JSON: summarySip */
+  DLIST additional_info;
+
+} EVENT_SIGNALING;
+
+/**************************************************************************//**
+ * Sgnaling Additional Field.
+ * JSON equivalent field: additionalFields
+ *****************************************************************************/
+typedef struct signaling_additional_field {
+  char * name;
+  char * value;
+} SIGNALING_ADDL_FIELD;
+
+/*****************************************************************************/
+/* Supported State Change version.                                           */
+/*****************************************************************************/
+#define EVEL_STATE_CHANGE_MAJOR_VERSION 2
+#define EVEL_STATE_CHANGE_MINOR_VERSION 0
+
+/**************************************************************************//**
+ * State Change.
+ * JSON equivalent field: stateChangeFields
+ *****************************************************************************/
+typedef struct event_state_change {
+  /***************************************************************************/
+  /* Header and version                                                      */
+  /***************************************************************************/
+  EVENT_HEADER header;
+  int major_version;
+  int minor_version;
+
+  /***************************************************************************/
+  /* Mandatory fields                                                        */
+  /***************************************************************************/
+  EVEL_ENTITY_STATE new_state;
+  EVEL_ENTITY_STATE old_state;
+  char * state_interface;
+  double version;
+
+  /***************************************************************************/
+  /* Optional fields                                                         */
+  /***************************************************************************/
+  DLIST additional_fields;
+
+} EVENT_STATE_CHANGE;
+
+/**************************************************************************//**
+ * State Change Additional Field.
+ * JSON equivalent field: additionalFields
+ *****************************************************************************/
+typedef struct state_change_additional_field {
+  char * name;
+  char * value;
+} STATE_CHANGE_ADDL_FIELD;
+
+/*****************************************************************************/
+/* Supported Syslog version.                                                 */
+/*****************************************************************************/
+#define EVEL_SYSLOG_MAJOR_VERSION 3
+#define EVEL_SYSLOG_MINOR_VERSION 0
+
+/**************************************************************************//**
+ * Syslog.
+ * JSON equivalent field: syslogFields
+ *****************************************************************************/
+typedef struct event_syslog {
+  /***************************************************************************/
+  /* Header and version                                                      */
+  /***************************************************************************/
+  EVENT_HEADER header;
+  int major_version;
+  int minor_version;
+
+  /***************************************************************************/
+  /* Mandatory fields                                                        */
+  /***************************************************************************/
+  EVEL_SOURCE_TYPES event_source_type;
+  char * syslog_msg;
+  char * syslog_tag;
+
+  /***************************************************************************/
+  /* Optional fields                                                         */
+  /***************************************************************************/
+  EVEL_OPTION_STRING additional_filters;
+  EVEL_OPTION_STRING event_source_host;
+  EVEL_OPTION_INT syslog_facility;
+  EVEL_OPTION_INT syslog_priority;
+  EVEL_OPTION_STRING syslog_proc;
+  EVEL_OPTION_INT syslog_proc_id;
+  EVEL_OPTION_STRING syslog_s_data;
+  EVEL_OPTION_STRING syslog_sdid;
+  EVEL_OPTION_STRING syslog_severity;
+  double syslog_fver;
+  EVEL_OPTION_INT syslog_ver;
+
+} EVENT_SYSLOG;
+
+/**************************************************************************//**
+ * Copyright.
+ * JSON equivalent object: attCopyrightNotice
+ *****************************************************************************/
+typedef struct copyright {
+  char * useAndRedistribution;
+  char * condition1;
+  char * condition2;
+  char * condition3;
+  char * condition4;
+  char * disclaimerLine1;
+  char * disclaimerLine2;
+  char * disclaimerLine3;
+  char * disclaimerLine4;
+} COPYRIGHT;
+
+/**************************************************************************//**
+ * Library initialization.
+ *
+ * Initialize the EVEL library.
+ *
+ * @note  This function initializes the cURL library.  Applications making use
+ *        of libcurl may need to pull the initialization out of here.  Note
+ *        also that this function is not threadsafe as a result - refer to
+ *        libcurl's API documentation for relevant warnings.
+ *
+ * @sa  Matching Term function.
+ *
+ * @param   fqdn    The API's FQDN or IP address.
+ * @param   port    The API's port.
+ * @param   bakup_fqdn    The API's FQDN or IP address.
+ * @param   bakup_port    The API's port.
+ * @param   path    The optional path (may be NULL).
+ * @param   topic   The optional topic part of the URL (may be NULL).
+ * @param   ring_buf_size   Ring buffer size (>=100) ~ Avg Messages in 1hr
+ * @param   secure  Whether to use HTTPS (0=HTTP, 1=HTTPS).
+ * @param   cert_file_path     Path to client certificate file
+ * @param   key_file_path      Path to client key file
+ * @param   ca_info            Path to CA info
+ * @param   ca_file_path       Path to CA file
+ * @param   verify_peer        SSL verification of peer 0 or 1
+ * @param   verify_host        SSL verification of host 0 or 1
+ * @param   username  Username for Basic Authentication of requests.
+ * @param   password  Password for Basic Authentication of requests.
+ * @param   bakup_username  Username for Basic Authentication of Bakup FQDN.
+ * @param   bakup_password  Password for Basic Authentication of Bakup FQDN.
+ * @param   source_ip       The ip of node we represent.(NULL for default ip)
+ * @param   bakup_source_ip The ip bakup fqdn interface.(NULL for default ip)
+ * @param   source_type The kind of node we represent.
+ * @param   role    The role this node undertakes.
+ * @param   verbosity  0 for normal operation, positive values for chattier
+ *                     logs.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS      On success
+ * @retval  ::EVEL_ERR_CODES  On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_initialize(const char * const fqdn,
+                               int port,
+                               const char * const bakup_fqdn,
+                               int bakup_port,
+                               const char * const path,
+                               const char * const topic,
+                               int ring_buf_size,
+                               int secure,
+                               const char * const cert_file_path,
+                               const char * const key_file_path,
+                               const char * const ca_info,
+                               const char * const ca_file_path,
+                               long verify_peer,
+                               long verify_host,
+                               const char * const username,
+                               const char * const password,
+                               const char * const bakup_username,
+                               const char * const bakup_password,
+                               const char * const source_ip,
+                               const char * const bakup_source_ip,
+                               EVEL_SOURCE_TYPES source_type,
+                               const char * const role,
+                               int verbosity
+                               );
+
+/**************************************************************************//**
+ * Initialize value for vm_name for all coming events
+ * @param  source_name  Source name string.
+ *                      Must confirm with EVEL source name standard
+ * @returns Status code
+ * @retval  EVEL_SUCCESS      On success
+ * @retval  ::EVEL_ERR_CODES  On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_set_source_name(char * src_name);
+
+
+/**************************************************************************//**
+ * Clean up the EVEL library.
+ *
+ * @note that at present don't expect Init/Term cycling not to leak memory!
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_terminate(void);
+
+EVEL_ERR_CODES evel_post_event(EVENT_HEADER * event);
+const char * evel_error_string(void);
+
+
+/**************************************************************************//**
+ * Free an event.
+ *
+ * Free off the event supplied.  Will free all the contained allocated memory.
+ *
+ * @note  It is safe to free a NULL pointer.
+ *****************************************************************************/
+void evel_free_event(void * event);
+
+/**************************************************************************//**
+ * Encode the event as a JSON event object according to AT&T's schema.
+ *
+ * @param json      Pointer to where to store the JSON encoded data.
+ * @param mode      Event mode or Batch mode
+ * @param max_size  Size of storage available in json_body.
+ * @param event     Pointer to the ::EVENT_HEADER to encode.
+ * @returns Number of bytes actually written.
+ *****************************************************************************/
+int evel_json_encode_event(char * json,
+                           int max_size,
+                           EVENT_HEADER * event);
+int evel_json_encode_batch_event(char * json,
+                           int max_size,
+                           EVENT_HEADER * event);
+/**************************************************************************//**
+ * Initialize an event instance id.
+ *
+ * @param vfield        Pointer to the event vnfname field being initialized.
+ * @param vendor_id     The vendor id to encode in the event instance id.
+ * @param event_id      The event id to encode in the event instance id.
+ *****************************************************************************/
+void evel_init_vendor_field(VENDOR_VNFNAME_FIELD * const vfield,
+                                 const char * const vendor_name);
+
+/**************************************************************************//**
+ * Set the Vendor module property of the Vendor.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vfield        Pointer to the Vendor field.
+ * @param module_name   The module name to be set. ASCIIZ string. The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
+ *****************************************************************************/
+void evel_vendor_field_module_set(VENDOR_VNFNAME_FIELD * const vfield,
+                                    const char * const module_name);
+/**************************************************************************//**
+ * Set the Vendor module property of the Vendor.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vfield        Pointer to the Vendor field.
+ * @param module_name   The module name to be set. ASCIIZ string. The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
+ *****************************************************************************/
+void evel_vendor_field_vnfname_set(VENDOR_VNFNAME_FIELD * const vfield,
+                                    const char * const vnfname);
+/**************************************************************************//**
+ * Free an event instance id.
+ *
+ * @param vfield   Pointer to the event vnfname_field being freed.
+ *****************************************************************************/
+void evel_free_event_vendor_field(VENDOR_VNFNAME_FIELD * const vfield);
+
+/**************************************************************************//**
+ * Callback function to provide returned data.
+ *
+ * Copy data into the supplied buffer, write_callback::ptr, checking size
+ * limits.
+ *
+ * @returns   Number of bytes placed into write_callback::ptr. 0 for EOF.
+ *****************************************************************************/
+size_t evel_write_callback(void *contents,
+                           size_t size,
+                           size_t nmemb,
+                           void *userp);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   HEARTBEAT - (includes common header, too)                               */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/**************************************************************************//**
+ * Create a new heartbeat event.
+ *
+ * @note that the heartbeat is just a "naked" commonEventHeader!
+ *
+ * @returns pointer to the newly manufactured ::EVENT_HEADER.  If the event is
+ *          not used it must be released using ::evel_free_event
+ * @retval  NULL  Failed to create the event.
+ *****************************************************************************/
+EVENT_HEADER * evel_new_heartbeat(void);
+
+/**************************************************************************//**
+ * Create a new heartbeat event of given name and type.
+ *
+ * @note that the heartbeat is just a "naked" commonEventHeader!
+ *
+ * @param event_name    Unique Event Name: {DomainAbbreviation}_{AsdcModel or ApplicationPlatform}_{DescriptionOfInfoBeingConveyed}
+ * @param event_id    A universal identifier of the event for: troubleshooting, cross-referencing of alarms for alarm correlation, offline log analysis, etc
+ *
+ * @returns pointer to the newly manufactured ::EVENT_HEADER.  If the event is
+ *          not used it must be released using ::evel_free_event
+ * @retval  NULL  Failed to create the event.
+ *****************************************************************************/
+EVENT_HEADER * evel_new_heartbeat_nameid(const char* ev_name, const char *ev_id);
+
+/**************************************************************************//**
+ * Create a new Heartbeat fields event.
+ *
+ * @note    The mandatory fields on the Heartbeat fields must be supplied to
+ *          this factory function and are immutable once set.  Optional fields
+ *          have explicit setter functions, but again values may only be set
+ *          once so that the event has immutable properties.
+ * @param ev_name  Unique Event Name confirming Domain AsdcModel Description
+ * @param ev_id    A universal identifier of the event for: troubleshooting correlation, analysis, etc
+ * @param interval    heartbeat interval
+ * @returns pointer to the newly manufactured ::EVENT_HEARTBEAT_FIELD.  If the event
+ *          is not used (i.e. posted) it must be released using
+ *          ::evel_free_hrtbt_field.
+ * @retval  NULL  Failed to create the event.
+ *****************************************************************************/
+EVENT_HEARTBEAT_FIELD * evel_new_heartbeat_field(int interval,const char* ev_name, const char *ev_id);
+
+/**************************************************************************//**
+ * Free an event header.
+ *
+ * Free off the event header supplied.  Will free all the contained allocated
+ * memory.
+ *
+ * @note It does not free the header itself, since that may be part of a
+ * larger structure.
+ *****************************************************************************/
+void evel_free_header(EVENT_HEADER * const event);
+
+/**************************************************************************//**
+ * Initialize a newly created event header.
+ *
+ * @param header  Pointer to the header being initialized.
+ *****************************************************************************/
+void evel_init_header(EVENT_HEADER * const header,const char *const eventname);
+
+/**************************************************************************//**
+ * Set the Event Type property of the event header.
+ *
+ * @param header        Pointer to the ::EVENT_HEADER.
+ * @param type          The Event Type to be set. ASCIIZ string. The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
+ *****************************************************************************/
+void evel_header_type_set(EVENT_HEADER * const header,
+                          const char * const type);
+
+/**************************************************************************//**
+ * Set the next event_sequence to use.
+ *
+ * @param sequence      The next sequence number to use.
+ *****************************************************************************/
+void evel_set_global_event_sequence(const int sequence);
+
+/*****************************************************************************/
+/* Event sequence and Event ID generation.                                   */
+/*****************************************************************************/
+#define EVEL_ID_BLOCK_SIZE 64
+#define EVEL_ID_DIGITS 9
+#define EVEL_ID_MAX_DIGITS 20
+#define EVEL_ID_MAX_PREFIX 32
+#define EVEL_ID_MAX_LEN (EVEL_ID_MAX_PREFIX + EVEL_ID_MAX_DIGITS)
+
+/**************************************************************************//**
+ * Event ID generator.
+ * Produces IDs of the form prefix + zero-padded number, e.g. "fault000000001".
+ * A generator may be shared between threads.
+ *****************************************************************************/
+typedef struct evel_id_generator {
+  char prefix[EVEL_ID_MAX_PREFIX + 1];
+  size_t prefix_len;
+  unsigned long long next;
+} EVEL_ID_GENERATOR;
+
+/**************************************************************************//**
+ * Get the next event sequence number.
+ *
+ * Lock-free: each thread reserves blocks of ::EVEL_ID_BLOCK_SIZE numbers from
+ * the global sequence, so numbers are unique within the process and
+ * monotonic within a thread.
+ *
+ * @returns The sequence number.
+ *****************************************************************************/
+unsigned long long evel_next_event_sequence(void);
+
+/**************************************************************************//**
+ * Format an Event ID as a prefix followed by a zero-padded decimal number.
+ *
+ * Equivalent to sprintf(buffer, "%s%0*llu", prefix, width, value).
+ *
+ * @param buffer        Buffer to receive the null-terminated ID.
+ * @param size          Size of the buffer, including the terminator.
+ * @param prefix        ASCIIZ prefix, may be an empty string.
+ * @param value         The number to append.
+ * @param width         Minimum number of digits, e.g. ::EVEL_ID_DIGITS.
+ *
+ * @returns Length of the ID written, excluding the terminator.
+ * @retval  0  The buffer is too small to hold the ID.
+ *****************************************************************************/
+size_t evel_format_event_id(char * const buffer,
+                            const size_t size,
+                            const char * const prefix,
+                            const unsigned long long value,
+                            const size_t width);
+
+/**************************************************************************//**
+ * Initialize an Event ID generator.
+ *
+ * @param generator     Pointer to the ::EVEL_ID_GENERATOR to initialize.
+ * @param prefix        ASCIIZ prefix for the generated IDs, truncated to
+ *                      ::EVEL_ID_MAX_PREFIX characters.
+ * @param first         The first number to be issued.
+ *****************************************************************************/
+void evel_id_generator_init(EVEL_ID_GENERATOR * const generator,
+                            const char * const prefix,
+                            const unsigned long long first);
+
+/**************************************************************************//**
+ * Generate the next Event ID from a generator.
+ *
+ * @param generator     Pointer to the ::EVEL_ID_GENERATOR.
+ * @param buffer        Buffer to receive the null-terminated ID.  A buffer
+ *                      of ::EVEL_ID_MAX_LEN + 1 bytes is always large enough.
+ * @param size          Size of the buffer, including the terminator.
+ *
+ * @returns The number embedded in the ID.
+ *****************************************************************************/
+unsigned long long evel_id_generator_next(EVEL_ID_GENERATOR * const generator,
+                                          char * const buffer,
+                                          const size_t size);
+
+/*****************************************************************************/
+/* Timestamps.                                                               */
+/*****************************************************************************/
+
+/**************************************************************************//**
+ * Grades of wall-clock timestamp.
+ *****************************************************************************/
+typedef enum {
+  EVEL_CLOCK_EXACT,
+  EVEL_CLOCK_COARSE,
+  EVEL_CLOCK_CACHED,
+  EVEL_MAX_CLOCK_TYPES
+} EVEL_CLOCK_TYPES;
+
+/**************************************************************************//**
+ * Get the current wall-clock time.
+ *
+ * ::EVEL_CLOCK_EXACT reads CLOCK_REALTIME.  ::EVEL_CLOCK_COARSE reads
+ * CLOCK_REALTIME_COARSE, which is cheaper but only updated every kernel tick.
+ * ::EVEL_CLOCK_CACHED returns the value last published by the ticker thread,
+ * falling back to coarse if the ticker is not running.
+ *
+ * @param clock     Which grade of clock to use.
+ *
+ * @returns Microseconds since the epoch, suitable for the epoch setters.
+ *****************************************************************************/
+unsigned long long evel_time_now_usec(const EVEL_CLOCK_TYPES clock);
+
+/**************************************************************************//**
+ * Get the current monotonic time, for measuring intervals.
+ *
+ * Unlike the wall-clock, this is not affected by NTP steps.
+ *
+ * @returns Microseconds since an arbitrary fixed point.
+ *****************************************************************************/
+unsigned long long evel_time_monotonic_usec(void);
+
+/**************************************************************************//**
+ * Refresh the cached timestamp returned for ::EVEL_CLOCK_CACHED.
+ *****************************************************************************/
+void evel_time_tick(void);
+
+/**************************************************************************//**
+ * Start a thread refreshing the cached timestamp every period_ms.
+ *
+ * @param period_ms   Refresh period in milliseconds.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_time_ticker_start(const int period_ms);
+
+/**************************************************************************//**
+ * Stop the ticker thread.
+ *****************************************************************************/
+void evel_time_ticker_stop(void);
+
+/**************************************************************************//**
+ * Set the clock used to timestamp new event headers.
+ *
+ * @note The default is ::EVEL_CLOCK_COARSE.
+ *
+ * @param clock     Which grade of clock to use.
+ *****************************************************************************/
+void evel_header_clock_set(const EVEL_CLOCK_TYPES clock);
+
+/**************************************************************************//**
+ * Set the Event Sequence property of the event header.
+ *
+ * @note This is mainly for tracking fault event sequence numbers
+ *
+ * @param header        Pointer to the ::EVENT_HEADER.
+ * @param sequence_number
+ * 
+ *****************************************************************************/
+void evel_event_sequence_set(EVENT_HEADER * const header,const int sequence_number);
+
+/**************************************************************************//**
+ * Set the Start Epoch property of the event header.
+ *
+ * @note The Start Epoch defaults to the time of event creation.
+ *
+ * @param header        Pointer to the ::EVENT_HEADER.
+ * @param start_epoch_microsec
+ *                      The start epoch to set, in microseconds.
+ *****************************************************************************/
+void evel_start_epoch_set(EVENT_HEADER * const header,
+                          const unsigned long long start_epoch_microsec);
+
+/**************************************************************************//**
+ * Set the Last Epoch property of the event header.
+ *
+ * @note The Last Epoch defaults to the time of event creation.
+ *
+ * @param header        Pointer to the ::EVENT_HEADER.
+ * @param last_epoch_microsec
+ *                      The last epoch to set, in microseconds.
+ *****************************************************************************/
+void evel_last_epoch_set(EVENT_HEADER * const header,
+                         const unsigned long long last_epoch_microsec);
+
+/**************************************************************************//**
+ * Set the Reporting Entity Name property of the event header.
+ *
+ * @note The Reporting Entity Name defaults to the OpenStack VM Name.
+ *
+ * @param header        Pointer to the ::EVENT_HEADER.
+ * @param entity_name   The entity name to set.
+ *****************************************************************************/
+void evel_reporting_entity_name_set(EVENT_HEADER * const header,
+                                    const char * const entity_name);
+
+/**************************************************************************//**
+ * Set the Source Name property of the event header.
+ *
+ * @note The Source Name defaults to the OpenStack VM Name.
+ *
+ * @param header        Pointer to the ::EVENT_HEADER.
+ * @param entity_name   The source name to set.
+ *****************************************************************************/
+void evel_source_name_set(EVENT_HEADER * const header,
+                          const char * const source_name);
+
+/**************************************************************************//**
+ * Set the Reporting Entity Id property of the event header.
+ *
+ * @note The Reporting Entity Id defaults to the OpenStack VM UUID.
+ *
+ * @param header        Pointer to the ::EVENT_HEADER.
+ * @param entity_id     The entity id to set.
+ *****************************************************************************/
+void evel_reporting_entity_id_set(EVENT_HEADER * const header,
+                                  const char * const entity_id);
+
+/**************************************************************************//**
+ * Set the Source Id property of the event header.
+ *
+ * @note The Source Id defaults to the OpenStack VM UUID.
+ *
+ * @param header        Pointer to the ::EVENT_HEADER.
+ * @param entity_id     The Source id to set.
+ *****************************************************************************/
+void evel_source_id_set(EVENT_HEADER * const header,
+                        const char * const source_id);
+
+/**************************************************************************//**
+ * Set the NFC Naming code property of the event header.
+ *
+ * @param header        Pointer to the ::EVENT_HEADER.
+ * @param nfcnamingcode String
+ *****************************************************************************/
+void evel_nfcnamingcode_set(EVENT_HEADER * const header,
+                         const char * const nfcnam);
+/**************************************************************************//**
+ * Set the NF Naming code property of the event header.
+ *
+ * @param header        Pointer to the ::EVENT_HEADER.
+ * @param nfnamingcode String
+ *****************************************************************************/
+void evel_nfnamingcode_set(EVENT_HEADER * const header,
+                         const char * const nfnam);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   FAULT                                                                   */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/**************************************************************************//**
+ * Create a new fault event.
+ *
+ * @note    The mandatory fields on the Fault must be supplied to this factory
+ *          function and are immutable once set.  Optional fields have explicit
+ *          setter functions, but again values may only be set once so that the
+ *          Fault has immutable properties.
+ * @param event_name    Unique Event Name
+ * @param event_id    A universal identifier of the event for analysis etc
+ * @param   condition   The condition indicated by the Fault.
+ * @param   specific_problem  The specific problem triggering the fault.
+ * @param   priority    The priority of the event.
+ * @param   severity    The severity of the Fault.
+ * @param   ev_source_type    Source of Alarm event
+ * @param   version     fault version
+ * @param   status      status of Virtual Function
+ * @returns pointer to the newly manufactured ::EVENT_FAULT.  If the event is
+ *          not used (i.e. posted) it must be released using ::evel_free_fault.
+ * @retval  NULL  Failed to create the event.
+ *****************************************************************************/
+EVENT_FAULT * evel_new_fault(const char* ev_name, const char *ev_id,
+			     const char * const condition,
+                             const char * const specific_problem,
+                             EVEL_EVENT_PRIORITIES priority,
+                             EVEL_SEVERITIES severity,
+                             EVEL_SOURCE_TYPES ev_source_type,
+                             EVEL_VF_STATUSES status);
+
+/**************************************************************************//**
+ * Free a Fault.
+ *
+ * Free off the Fault supplied.  Will free all the contained allocated memory.
+ *
+ * @note It does not free the Fault itself, since that may be part of a
+ * larger structure.
+ *****************************************************************************/
+void evel_free_fault(EVENT_FAULT * event);
+
+/**************************************************************************//**
+ * Set the Fault Category property of the Fault.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param fault      Pointer to the fault.
+ * @param category   Category : license, link, routing, security, signaling.
+ *                       ASCIIZ string. The caller
+ *                   does not need to preserve the value once the function
+ *                   returns.
+ *****************************************************************************/
+void evel_fault_category_set(EVENT_FAULT * fault,
+                              const char * const category);
+
+/**************************************************************************//**
+ * Set the Alarm Interface A property of the Fault.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param fault      Pointer to the fault.
+ * @param interface  The Alarm Interface A to be set. ASCIIZ string. The caller
+ *                   does not need to preserve the value once the function
+ *                   returns.
+ *****************************************************************************/
+void evel_fault_interface_set(EVENT_FAULT * fault,
+                              const char * const interface);
+
+/**************************************************************************//**
+ * Add an additional value name/value pair to the Fault.
+ *
+ * The name and value are null delimited ASCII strings.  The library takes
+ * a copy so the caller does not have to preserve values after the function
+ * returns.
+ *
+ * @param fault     Pointer to the fault.
+ * @param name      ASCIIZ string with the attribute's name.
+ * @param value     ASCIIZ string with the attribute's value.
+ *****************************************************************************/
+void evel_fault_addl_info_add(EVENT_FAULT * fault, char * name, char * value);
+
+/**************************************************************************//**
+ * Set the Event Type property of the Fault.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param fault      Pointer to the fault.
+ * @param type       The Event Type to be set. ASCIIZ string. The caller
+ *                   does not need to preserve the value once the function
+ *                   returns.
+ *****************************************************************************/
+void evel_fault_type_set(EVENT_FAULT * fault, const char * const type);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   MEASUREMENT                                                             */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/**************************************************************************//**
+ * Create a new Measurement event.
+ *
+ * @note    The mandatory fields on the Measurement must be supplied to this
+ *          factory function and are immutable once set.  Optional fields have
+ *          explicit setter functions, but again values may only be set once so
+ *          that the Measurement has immutable properties.
+ *
+ * @param   measurement_interval
+ * @param event_name    Unique Event Name
+ * @param event_id    A universal identifier of the event for analysis etc
+ *
+ * @returns pointer to the newly manufactured ::EVENT_MEASUREMENT.  If the
+ *          event is not used (i.e. posted) it must be released using
+ *          ::evel_free_event.
+ * @retval  NULL  Failed to create the event.
+ *****************************************************************************/
+EVENT_MEASUREMENT * evel_new_measurement(double measurement_interval,const char* ev_name, const char *ev_id);
+
+/**************************************************************************//**
+ * Free a Measurement.
+ *
+ * Free off the Measurement supplied.  Will free all the contained allocated
+ * memory.
+ *
+ * @note It does not free the Measurement itself, since that may be part of a
+ * larger structure.
+ *****************************************************************************/
+void evel_free_measurement(EVENT_MEASUREMENT * event);
+
+/**************************************************************************//**
+ * Set the Event Type property of the Measurement.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param measurement Pointer to the Measurement.
+ * @param type        The Event Type to be set. ASCIIZ string. The caller
+ *                    does not need to preserve the value once the function
+ *                    returns.
+ *****************************************************************************/
+void evel_measurement_type_set(EVENT_MEASUREMENT * measurement,
+                               const char * const type);
+
+/**************************************************************************//**
+ * Set the Concurrent Sessions property of the Measurement.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param measurement         Pointer to the Measurement.
+ * @param concurrent_sessions The Concurrent Sessions to be set.
+ *****************************************************************************/
+void evel_measurement_conc_sess_set(EVENT_MEASUREMENT * measurement,
+                                    int concurrent_sessions);
+
+/**************************************************************************//**
+ * Set the Configured Entities property of the Measurement.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param measurement         Pointer to the Measurement.
+ * @param configured_entities The Configured Entities to be set.
+ *****************************************************************************/
+void evel_measurement_cfg_ents_set(EVENT_MEASUREMENT * measurement,
+                                   int configured_entities);
+
+/**************************************************************************//**
+ * Add an additional set of Errors to the Measurement.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param measurement       Pointer to the measurement.
+ * @param receive_discards  The number of receive discards.
+ * @param receive_errors    The number of receive errors.
+ * @param transmit_discards The number of transmit discards.
+ * @param transmit_errors   The number of transmit errors.
+ *****************************************************************************/
+void evel_measurement_errors_set(EVENT_MEASUREMENT * measurement,
+                                 int receive_discards,
+                                 int receive_errors,
+                                 int transmit_discards,
+                                 int transmit_errors);
+
+/**************************************************************************//**
+ * Set the Mean Request Latency property of the Measurement.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param measurement          Pointer to the Measurement.
+ * @param mean_request_latency The Mean Request Latency to be set.
+ *****************************************************************************/
+void evel_measurement_mean_req_lat_set(EVENT_MEASUREMENT * measurement,
+                                       double mean_request_latency);
+
+/**************************************************************************//**
+ * Set the Request Rate property of the Measurement.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param measurement  Pointer to the Measurement.
+ * @param request_rate The Request Rate to be set.
+ *****************************************************************************/
+void evel_measurement_request_rate_set(EVENT_MEASUREMENT * measurement,
+                                       int request_rate);
+
+/**************************************************************************//**
+ * Add an additional CPU usage value name/value pair to the Measurement.
+ *
+ * The name and value are null delimited ASCII strings.  The library takes
+ * a copy so the caller does not have to preserve values after the function
+ * returns.
+ *
+ * @param measurement   Pointer to the measurement.
+ * @param id            ASCIIZ string with the CPU's identifier.
+ * @param usage         CPU utilization.
+ *****************************************************************************/
+MEASUREMENT_CPU_USE * evel_measurement_new_cpu_use_add(EVENT_MEASUREMENT * measurement, char * id, double usage);
+
+/**************************************************************************//**
+ * Set the CPU Idle value in measurement interval
+ *   percentage of CPU time spent in the idle task
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param cpu_use      Pointer to the CPU Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_cpu_use_idle_set(MEASUREMENT_CPU_USE *const cpu_use,
+                                    const double val);
+
+/**************************************************************************//**
+ * Set the percentage of time spent servicing interrupts
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param cpu_use      Pointer to the CPU Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_cpu_use_interrupt_set(MEASUREMENT_CPU_USE * const cpu_use,
+                                    const double val);
+
+/**************************************************************************//**
+ * Set the percentage of time spent running user space processes that have been niced
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param cpu_use      Pointer to the CPU Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_cpu_use_nice_set(MEASUREMENT_CPU_USE * const cpu_use,
+                                    const double val);
+
+/**************************************************************************//**
+ * Set the percentage of time spent handling soft irq interrupts
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param cpu_use      Pointer to the CPU Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_cpu_use_softirq_set(MEASUREMENT_CPU_USE * const cpu_use,
+                                    const double val);
+/**************************************************************************//**
+ * Set the percentage of time spent in involuntary wait
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param cpu_use      Pointer to the CPU Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_cpu_use_steal_set(MEASUREMENT_CPU_USE * const cpu_use,
+                                    const double val);
+/**************************************************************************//**
+ * Set the percentage of time spent on system tasks running the kernel
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param cpu_use      Pointer to the CPU Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_cpu_use_system_set(MEASUREMENT_CPU_USE * const cpu_use,
+                                    const double val);
+/**************************************************************************//**
+ * Set the percentage of time spent running un-niced user space processes
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param cpu_use      Pointer to the CPU Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_cpu_use_usageuser_set(MEASUREMENT_CPU_USE * const cpu_use,
+                                    const double val);
+/**************************************************************************//**
+ * Set the percentage of CPU time spent waiting for I/O operations to complete
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param cpu_use      Pointer to the CPU Use.
+ * @param val          double
+ *****************************************************************************/
+void evel_measurement_cpu_use_wait_set(MEASUREMENT_CPU_USE * const cpu_use,
+                                    const double val);
+
+/**************************************************************************//**
+ * Add an additional File System usage value name/value pair to the
+ * Measurement.
+ *
+ * The filesystem_name is null delimited ASCII string.  The library takes a
+ * copy so the caller does not have to preserve values after the function
+ * returns.
+ *
+ * @param measurement     Pointer to the measurement.
+ * @param filesystem_name   ASCIIZ string with the file-system's UUID.
+ * @param block_configured  Block storage configured.
+ * @param block_used        Block storage in use.
+ * @param block_iops        Block storage IOPS.
+ * @param ephemeral_configured  Ephemeral storage configured.
+ * @param ephemeral_used        Ephemeral storage in use.
+ * @param ephemeral_iops        Ephemeral storage IOPS.
+ *****************************************************************************/
+void evel_measurement_fsys_use_add(EVENT_MEASUREMENT * measurement,
+                                   char * filesystem_name,
+                                   double block_configured,
+                                   double block_used,
+                                   double block_iops,
+                                   double ephemeral_configured,
+                                   double ephemeral_used,
+                                   double ephemeral_iops);
+
+/**************************************************************************//**
+ * Add a Feature usage value name/value pair to the Measurement.
+ *
+ * The name is null delimited ASCII string.  The library takes
+ * a copy so the caller does not have to preserve values after the function
+ * returns.
+ *
+ * @param measurement     Pointer to the measurement.
+ * @param feature         ASCIIZ string with the feature's name.
+ * @param utilization     Utilization of the feature.
+ *****************************************************************************/
+void evel_measurement_feature_use_add(EVENT_MEASUREMENT * measurement,
+                                      char * feature,
+                                      int utilization);
+
+/**************************************************************************//**
+ * Add a Additional Measurement value name/value pair to the Measurement.
+ *
+ * The name is null delimited ASCII string.  The library takes
+ * a copy so the caller does not have to preserve values after the function
+ * returns.
+ *
+ * @param measurement   Pointer to the Measurement.
+ * @param group    ASCIIZ string with the measurement group's name.
+ * @param name     ASCIIZ string containing the measurement's name.
+ * @param name     ASCIIZ string containing the measurement's value.
+ *****************************************************************************/
+void evel_measurement_custom_measurement_add(EVENT_MEASUREMENT * measurement,
+                                             const char * const group,
+                                             const char * const name,
+                                             const char * const value);
+
+/**************************************************************************//**
+ * Add a Codec usage value name/value pair to the Measurement.
+ *
+ * The name is null delimited ASCII string.  The library takes
+ * a copy so the caller does not have to preserve values after the function
+ * returns.
+ *
+ * @param measurement     Pointer to the measurement.
+ * @param codec           ASCIIZ string with the codec's name.
+ * @param utilization     Utilization of the feature.
+ *****************************************************************************/
+void evel_measurement_codec_use_add(EVENT_MEASUREMENT * measurement,
+                                    char * codec,
+                                    int utilization);
+
+/**************************************************************************//**
+ * Set the Media Ports in Use property of the Measurement.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param measurement         Pointer to the measurement.
+ * @param media_ports_in_use  The media port usage to set.
+ *****************************************************************************/
+void evel_measurement_media_port_use_set(EVENT_MEASUREMENT * measurement,
+                                         int media_ports_in_use);
+
+/**************************************************************************//**
+ * Set the VNFC Scaling Metric property of the Measurement.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param measurement     Pointer to the measurement.
+ * @param scaling_metric  The scaling metric to set.
+ *****************************************************************************/
+void evel_measurement_vnfc_scaling_metric_set(EVENT_MEASUREMENT * measurement,
+                                              int scaling_metric);
+
+/**************************************************************************//**
+ * Create a new Latency Bucket to be added to a Measurement event.
+ *
+ * @note    The mandatory fields on the ::MEASUREMENT_LATENCY_BUCKET must be
+ *          supplied to this factory function and are immutable once set.
+ *          Optional fields have explicit setter functions, but again values
+ *          may only be set once so that the ::MEASUREMENT_LATENCY_BUCKET has
+ *          immutable properties.
+ *
+ * @param count         Count of events in this bucket.
+ *
+ * @returns pointer to the newly manufactured ::MEASUREMENT_LATENCY_BUCKET.
+ * @retval  NULL  Failed to create the Latency Bucket.
+ *****************************************************************************/
+MEASUREMENT_LATENCY_BUCKET * evel_new_meas_latency_bucket(const int count);
+
+/**************************************************************************//**
+ * Set the High End property of the Measurement Latency Bucket.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param bucket        Pointer to the Measurement Latency Bucket.
+ * @param high_end      High end of the bucket's range.
+ *****************************************************************************/
+void evel_meas_latency_bucket_high_end_set(
+                                     MEASUREMENT_LATENCY_BUCKET * const bucket,
+                                     const double high_end);
+
+/**************************************************************************//**
+ * Set the Low End property of the Measurement Latency Bucket.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param bucket        Pointer to the Measurement Latency Bucket.
+ * @param low_end       Low end of the bucket's range.
+ *****************************************************************************/
+void evel_meas_latency_bucket_low_end_set(
+                                     MEASUREMENT_LATENCY_BUCKET * const bucket,
+                                     const double low_end);
+
+/**************************************************************************//**
+ * Add an additional Measurement Latency Bucket to the specified event.
+ *
+ * @param measurement   Pointer to the Measurement event.
+ * @param bucket        Pointer to the Measurement Latency Bucket to add.
+ *****************************************************************************/
+void evel_meas_latency_bucket_add(EVENT_MEASUREMENT * const measurement,
+                                  MEASUREMENT_LATENCY_BUCKET * const bucket);
+
+/**************************************************************************//**
+ * Add an additional Latency Distribution bucket to the Measurement.
+ *
+ * This function implements the previous API, purely for convenience.
+ *
+ * @param measurement   Pointer to the measurement.
+ * @param low_end       Low end of the bucket's range.
+ * @param high_end      High end of the bucket's range.
+ * @param count         Count of events in this bucket.
+ *****************************************************************************/
+void evel_measurement_latency_add(EVENT_MEASUREMENT * const measurement,
+                                  const double low_end,
+                                  const double high_end,
+                                  const int count);
+
+/**************************************************************************//**
+ * Create a new vNIC Use to be added to a Measurement event.
+ *
+ * @note    The mandatory fields on the ::MEASUREMENT_VNIC_PERFORMANCE must be supplied
+ *          to this factory function and are immutable once set. Optional
+ *          fields have explicit setter functions, but again values may only be
+ *          set once so that the ::MEASUREMENT_VNIC_PERFORMANCE has immutable
+ *          properties.
+ *
+ * @param vnic_id               ASCIIZ string with the vNIC's ID.
+ * @param val_suspect           True or false confidence in data.
+ *
+ * @returns pointer to the newly manufactured ::MEASUREMENT_VNIC_PERFORMANCE.
+ *          If the structure is not used it must be released using
+ *          ::evel_measurement_free_vnic_performance.
+ * @retval  NULL  Failed to create the vNIC Use.
+ *****************************************************************************/
+MEASUREMENT_VNIC_PERFORMANCE * evel_measurement_new_vnic_performance(char * const vnic_id, char * const val_suspect);
+
+/**************************************************************************//**
+ * Free a vNIC Use.
+ *
+ * Free off the ::MEASUREMENT_VNIC_PERFORMANCE supplied.  Will free all the contained
+ * allocated memory.
+ *
+ * @note It does not free the vNIC Use itself, since that may be part of a
+ * larger structure.
+ *****************************************************************************/
+void evel_measurement_free_vnic_performance(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance);
+
+/**************************************************************************//**
+ * Set the Accumulated Broadcast Packets Received in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param recvd_bcast_packets_acc
+ *****************************************************************************/
+void evel_vnic_performance_rx_bcast_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double recvd_bcast_packets_acc);
+/**************************************************************************//**
+ * Set the Delta Broadcast Packets Received in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param recvd_bcast_packets_delta
+ *****************************************************************************/
+void evel_vnic_performance_rx_bcast_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double recvd_bcast_packets_delta);
+/**************************************************************************//**
+ * Set the Discarded Packets Received in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param recvd_discard_packets_acc
+ *****************************************************************************/
+void evel_vnic_performance_rx_discard_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double recvd_discard_packets_acc);
+/**************************************************************************//**
+ * Set the Delta Discarded Packets Received in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param recvd_discard_packets_delta
+ *****************************************************************************/
+void evel_vnic_performance_rx_discard_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double recvd_discard_packets_delta);
+/**************************************************************************//**
+ * Set the Error Packets Received in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param recvd_error_packets_acc
+ *****************************************************************************/
+void evel_vnic_performance_rx_error_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double recvd_error_packets_acc);
+/**************************************************************************//**
+ * Set the Delta Error Packets Received in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param recvd_error_packets_delta
+ *****************************************************************************/
+void evel_vnic_performance_rx_error_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double recvd_error_packets_delta);
+/**************************************************************************//**
+ * Set the Accumulated Multicast Packets Received in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param recvd_mcast_packets_acc
+ *****************************************************************************/
+void evel_vnic_performance_rx_mcast_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double recvd_mcast_packets_acc);
+/**************************************************************************//**
+ * Set the Delta Multicast Packets Received in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param recvd_mcast_packets_delta
+ *****************************************************************************/
+void evel_vnic_performance_rx_mcast_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double recvd_mcast_packets_delta);
+/**************************************************************************//**
+ * Set the Accumulated Octets Received in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param recvd_octets_acc
+ *****************************************************************************/
+void evel_vnic_performance_rx_octets_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double recvd_octets_acc);
+/**************************************************************************//**
+ * Set the Delta Octets Received in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param recvd_octets_delta
+ *****************************************************************************/
+void evel_vnic_performance_rx_octets_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double recvd_octets_delta);
+/**************************************************************************//**
+ * Set the Accumulated Total Packets Received in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param recvd_total_packets_acc
+ *****************************************************************************/
+void evel_vnic_performance_rx_total_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double recvd_total_packets_acc);
+/**************************************************************************//**
+ * Set the Delta Total Packets Received in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param recvd_total_packets_delta
+ *****************************************************************************/
+void evel_vnic_performance_rx_total_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double recvd_total_packets_delta);
+/**************************************************************************//**
+ * Set the Accumulated Unicast Packets Received in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param recvd_ucast_packets_acc
+ *****************************************************************************/
+void evel_vnic_performance_rx_ucast_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double recvd_ucast_packets_acc);
+/**************************************************************************//**
+ * Set the Delta Unicast packets Received in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param recvd_ucast_packets_delta
+ *****************************************************************************/
+void evel_vnic_performance_rx_ucast_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double recvd_ucast_packets_delta);
+/**************************************************************************//**
+ * Set the Transmitted Broadcast Packets in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param tx_bcast_packets_acc
+ *****************************************************************************/
+void evel_vnic_performance_tx_bcast_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double tx_bcast_packets_acc);
+/**************************************************************************//**
+ * Set the Delta Broadcast packets Transmitted in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param tx_bcast_packets_delta
  *****************************************************************************/
-typedef struct copyright {
-  char * useAndRedistribution;
-  char * condition1;
-  char * condition2;
-  char * condition3;
-  char * condition4;
-  char * disclaimerLine1;
-  char * disclaimerLine2;
-  char * disclaimerLine3;
-  char * disclaimerLine4;
-} COPYRIGHT;
-
+void evel_vnic_performance_tx_bcast_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double tx_bcast_packets_delta);
 /**************************************************************************//**
- * Library initialization.
+ * Set the Transmitted Discarded Packets in measurement interval
+ * property of the vNIC performance.
  *
- * Initialize the EVEL library.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @note  This function initializes the cURL library.  Applications making use
- *        of libcurl may need to pull the initialization out of here.  Note
- *        also that this function is not threadsafe as a result - refer to
- *        libcurl's API documentation for relevant warnings.
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param tx_discarded_packets_acc
+ *****************************************************************************/
+void evel_vnic_performance_tx_discarded_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double tx_discarded_packets_acc);
+/**************************************************************************//**
+ * Set the Delta Discarded packets Transmitted in measurement interval
+ * property of the vNIC performance.
  *
- * @sa  Matching Term function.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @param   fqdn    The API's FQDN or IP address.
- * @param   port    The API's port.
- * @param   bakup_fqdn    The API's FQDN or IP address.
- * @param   bakup_port    The API's port.
- * @param   path    The optional path (may be NULL).
- * @param   topic   The optional topic part of the URL (may be NULL).
- * @param   ring_buf_size   Ring buffer size (>=100) ~ Avg Messages in 1hr
- * @param   secure  Whether to use HTTPS (0=HTTP, 1=HTTPS).
- * @param   cert_file_path     Path to client certificate file
- * @param   key_file_path      Path to client key file
- * @param   ca_info            Path to CA info
- * @param   ca_file_path       Path to CA file
- * @param   verify_peer        SSL verification of peer 0 or 1
- * @param   verify_host        SSL verification of host 0 or 1
- * @param   username  Username for Basic Authentication of requests.
- * @param   password  Password for Basic Authentication of requests.
- * @param   bakup_username  Username for Basic Authentication of Bakup FQDN.
- * @param   bakup_password  Password for Basic Authentication of Bakup FQDN.
- * @param   source_ip       The ip of node we represent.(NULL for default ip)
- * @param   bakup_source_ip The ip bakup fqdn interface.(NULL for default ip)
- * @param   source_type The kind of node we represent.
- * @param   role    The role this node undertakes.
- * @param   verbosity  0 for normal operation, positive values for chattier
- *                     logs.
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param tx_discarded_packets_delta
+ *****************************************************************************/
+void evel_vnic_performance_tx_discarded_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double tx_discarded_packets_delta);
+/**************************************************************************//**
+ * Set the Transmitted Errored Packets in measurement interval
+ * property of the vNIC performance.
  *
- * @returns Status code
- * @retval  EVEL_SUCCESS      On success
- * @retval  ::EVEL_ERR_CODES  On failure.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param tx_error_packets_acc
  *****************************************************************************/
-EVEL_ERR_CODES evel_initialize(const char * const fqdn,
-                               int port,
-                               const char * const bakup_fqdn,
-                               int bakup_port,
-                               const char * const path,
-                               const char * const topic,
-                               int ring_buf_size,
-                               int secure,
-                               const char * const cert_file_path,
-                               const char * const key_file_path,
-                               const char * const ca_info,
-                               const char * const ca_file_path,
-                               long verify_peer,
-                               long verify_host,
-                               const char * const username,
-                               const char * const password,
-                               const char * const bakup_username,
-                               const char * const bakup_password,
-                               const char * const source_ip,
-                               const char * const bakup_source_ip,
-                               EVEL_SOURCE_TYPES source_type,
-                               const char * const role,
-                               int verbosity
-                               );
-
+void evel_vnic_performance_tx_error_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double tx_error_packets_acc);
 /**************************************************************************//**
- * Initialize value for vm_name for all coming events
- * @param  source_name  Source name string.
- *                      Must confirm with EVEL source name standard
- * @returns Status code
- * @retval  EVEL_SUCCESS      On success
- * @retval  ::EVEL_ERR_CODES  On failure.
+ * Set the Delta Errored packets Transmitted in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param tx_error_packets_delta
  *****************************************************************************/
-EVEL_ERR_CODES evel_set_source_name(char * src_name);
-
-
+void evel_vnic_performance_tx_error_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double tx_error_packets_delta);
 /**************************************************************************//**
- * Clean up the EVEL library.
+ * Set the Transmitted Multicast Packets in measurement interval
+ * property of the vNIC performance.
  *
- * @note that at present don't expect Init/Term cycling not to leak memory!
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @returns Status code
- * @retval  EVEL_SUCCESS On success
- * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param tx_mcast_packets_acc
  *****************************************************************************/
-EVEL_ERR_CODES evel_terminate(void);
-
-EVEL_ERR_CODES evel_post_event(EVENT_HEADER * event);
-const char * evel_error_string(void);
-
-
+void evel_vnic_performance_tx_mcast_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double tx_mcast_packets_acc);
 /**************************************************************************//**
- * Free an event.
+ * Set the Delta Multicast packets Transmitted in measurement interval
+ * property of the vNIC performance.
  *
- * Free off the event supplied.  Will free all the contained allocated memory.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @note  It is safe to free a NULL pointer.
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param tx_mcast_packets_delta
  *****************************************************************************/
-void evel_free_event(void * event);
-
+void evel_vnic_performance_tx_mcast_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double tx_mcast_packets_delta);
 /**************************************************************************//**
- * Encode the event as a JSON event object according to AT&T's schema.
+ * Set the Transmitted Octets in measurement interval
+ * property of the vNIC performance.
  *
- * @param json      Pointer to where to store the JSON encoded data.
- * @param mode      Event mode or Batch mode
- * @param max_size  Size of storage available in json_body.
- * @param event     Pointer to the ::EVENT_HEADER to encode.
- * @returns Number of bytes actually written.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param tx_octets_acc
  *****************************************************************************/
-int evel_json_encode_event(char * json,
-                           int max_size,
-                           EVENT_HEADER * event);
-int evel_json_encode_batch_event(char * json,
-                           int max_size,
-                           EVENT_HEADER * event);
+void evel_vnic_performance_tx_octets_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double tx_octets_acc);
 /**************************************************************************//**
- * Initialize an event instance id.
+ * Set the Delta Octets Transmitted in measurement interval
+ * property of the vNIC performance.
  *
- * @param vfield        Pointer to the event vnfname field being initialized.
- * @param vendor_id     The vendor id to encode in the event instance id.
- * @param event_id      The event id to encode in the event instance id.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param tx_octets_delta
  *****************************************************************************/
-void evel_init_vendor_field(VENDOR_VNFNAME_FIELD * const vfield,
-                                 const char * const vendor_name);
-
+void evel_vnic_performance_tx_octets_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double tx_octets_delta);
 /**************************************************************************//**
- * Set the Vendor module property of the Vendor.
+ * Set the Transmitted Total Packets in measurement interval
+ * property of the vNIC performance.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vfield        Pointer to the Vendor field.
- * @param module_name   The module name to be set. ASCIIZ string. The caller
- *                      does not need to preserve the value once the function
- *                      returns.
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param tx_total_packets_acc
  *****************************************************************************/
-void evel_vendor_field_module_set(VENDOR_VNFNAME_FIELD * const vfield,
-                                    const char * const module_name);
+void evel_vnic_performance_tx_total_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double tx_total_packets_acc);
 /**************************************************************************//**
- * Set the Vendor module property of the Vendor.
+ * Set the Delta Total Packets Transmitted in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param tx_total_packets_delta
+ *****************************************************************************/
+void evel_vnic_performance_tx_total_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double tx_total_packets_delta);
+/**************************************************************************//**
+ * Set the Transmitted Unicast Packets in measurement interval
+ * property of the vNIC performance.
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param tx_ucast_packets_acc
+ *****************************************************************************/
+void evel_vnic_performance_tx_ucast_packets_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double tx_ucast_packets_acc);
+/**************************************************************************//**
+ * Set the Delta Octets Transmitted in measurement interval
+ * property of the vNIC performance.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vfield        Pointer to the Vendor field.
- * @param module_name   The module name to be set. ASCIIZ string. The caller
- *                      does not need to preserve the value once the function
- *                      returns.
+ * @param vnic_performance      Pointer to the vNIC Use.
+ * @param tx_ucast_packets_delta
  *****************************************************************************/
-void evel_vendor_field_vnfname_set(VENDOR_VNFNAME_FIELD * const vfield,
-                                    const char * const vnfname);
+void evel_vnic_performance_tx_ucast_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                                    const double tx_ucast_packets_delta);
+
 /**************************************************************************//**
- * Free an event instance id.
+ * Add an additional vNIC Use to the specified Measurement event.
  *
- * @param vfield   Pointer to the event vnfname_field being freed.
+ * @param measurement   Pointer to the measurement.
+ * @param vnic_performance      Pointer to the vNIC Use to add.
  *****************************************************************************/
-void evel_free_event_vendor_field(VENDOR_VNFNAME_FIELD * const vfield);
+void evel_meas_vnic_performance_add(EVENT_MEASUREMENT * const measurement,
+                            MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance);
 
 /**************************************************************************//**
- * Callback function to provide returned data.
+ * Add an additional vNIC usage record Measurement.
  *
- * Copy data into the supplied buffer, write_callback::ptr, checking size
- * limits.
+ * This function implements the previous API, purely for convenience.
  *
- * @returns   Number of bytes placed into write_callback::ptr. 0 for EOF.
+ * The ID is null delimited ASCII string.  The library takes a copy so the
+ * caller does not have to preserve values after the function returns.
+ *
+ * @param measurement           Pointer to the measurement.
+ * @param vnic_id               ASCIIZ string with the vNIC's ID.
+ * @param valset                true or false confidence level
+ * @param recvd_bcast_packets_acc         Recieved broadcast packets
+ * @param recvd_bcast_packets_delta       Received delta broadcast packets
+ * @param recvd_discarded_packets_acc     Recieved discarded packets
+ * @param recvd_discarded_packets_delta   Received discarded delta packets
+ * @param recvd_error_packets_acc         Received error packets
+ * @param recvd_error_packets_delta,      Received delta error packets
+ * @param recvd_mcast_packets_acc         Received multicast packets
+ * @param recvd_mcast_packets_delta       Received delta multicast packets
+ * @param recvd_octets_acc                Received octets
+ * @param recvd_octets_delta              Received delta octets
+ * @param recvd_total_packets_acc         Received total packets
+ * @param recvd_total_packets_delta       Received delta total packets
+ * @param recvd_ucast_packets_acc         Received Unicast packets
+ * @param recvd_ucast_packets_delta       Received delta unicast packets
+ * @param tx_bcast_packets_acc            Transmitted broadcast packets
+ * @param tx_bcast_packets_delta          Transmitted delta broadcast packets
+ * @param tx_discarded_packets_acc        Transmitted packets discarded
+ * @param tx_discarded_packets_delta      Transmitted delta discarded packets
+ * @param tx_error_packets_acc            Transmitted error packets
+ * @param tx_error_packets_delta          Transmitted delta error packets
+ * @param tx_mcast_packets_acc            Transmitted multicast packets accumulated
+ * @param tx_mcast_packets_delta          Transmitted delta multicast packets
+ * @param tx_octets_acc                   Transmitted octets
+ * @param tx_octets_delta                 Transmitted delta octets
+ * @param tx_total_packets_acc            Transmitted total packets
+ * @param tx_total_packets_delta          Transmitted delta total packets
+ * @param tx_ucast_packets_acc            Transmitted Unicast packets
+ * @param tx_ucast_packets_delta          Transmitted delta Unicast packets
  *****************************************************************************/
-size_t evel_write_callback(void *contents,
-                           size_t size,
-                           size_t nmemb,
-                           void *userp);
+void evel_measurement_vnic_performance_add(EVENT_MEASUREMENT * const measurement,
+                               char * const vnic_id,
+                               char * valset,
+                               double recvd_bcast_packets_acc,
+                               double recvd_bcast_packets_delta,
+                               double recvd_discarded_packets_acc,
+                               double recvd_discarded_packets_delta,
+                               double recvd_error_packets_acc,
+                               double recvd_error_packets_delta,
+                               double recvd_mcast_packets_acc,
+                               double recvd_mcast_packets_delta,
+                               double recvd_octets_acc,
+                               double recvd_octets_delta,
+                               double recvd_total_packets_acc,
+                               double recvd_total_packets_delta,
+                               double recvd_ucast_packets_acc,
+                               double recvd_ucast_packets_delta,
+                               double tx_bcast_packets_acc,
+                               double tx_bcast_packets_delta,
+                               double tx_discarded_packets_acc,
+                               double tx_discarded_packets_delta,
+                               double tx_error_packets_acc,
+                               double tx_error_packets_delta,
+                               double tx_mcast_packets_acc,
+                               double tx_mcast_packets_delta,
+                               double tx_octets_acc,
+                               double tx_octets_delta,
+                               double tx_total_packets_acc,
+                               double tx_total_packets_delta,
+                               double tx_ucast_packets_acc,
+                               double tx_ucast_packets_delta);
 
 /*****************************************************************************/
 /*****************************************************************************/
 /*                                                                           */
-/*   HEARTBEAT - (includes common header, too)                               */
+/*   REPORT                                                                  */
 /*                                                                           */
 /*****************************************************************************/
 /*****************************************************************************/
 
 /**************************************************************************//**
- * Create a new heartbeat event.
+ * Create a new Report event.
  *
- * @note that the heartbeat is just a "naked" commonEventHeader!
+ * @note    The mandatory fields on the Report must be supplied to this
+ *          factory function and are immutable once set.  Optional fields have
+ *          explicit setter functions, but again values may only be set once so
+ *          that the Report has immutable properties.
  *
- * @returns pointer to the newly manufactured ::EVENT_HEADER.  If the event is
- *          not used it must be released using ::evel_free_event
+ * @param   measurement_interval
+ * @param event_name    Unique Event Name
+ * @param event_id    A universal identifier of the event for analysis etc
+ *
+ * @returns pointer to the newly manufactured ::EVENT_REPORT.  If the event is
+ *          not used (i.e. posted) it must be released using
+ *          ::evel_free_report.
  * @retval  NULL  Failed to create the event.
  *****************************************************************************/
-EVENT_HEADER * evel_new_heartbeat(void);
+EVENT_REPORT * evel_new_report(double measurement_interval,const char* ev_name, const char *ev_id);
 
 /**************************************************************************//**
- * Create a new heartbeat event of given name and type.
- *
- * @note that the heartbeat is just a "naked" commonEventHeader!
+ * Free a Report.
  *
- * @param event_name    Unique Event Name: {DomainAbbreviation}_{AsdcModel or ApplicationPlatform}_{DescriptionOfInfoBeingConveyed}
- * @param event_id    A universal identifier of the event for: troubleshooting, cross-referencing of alarms for alarm correlation, offline log analysis, etc
+ * Free off the Report supplied.  Will free all the contained allocated memory.
  *
- * @returns pointer to the newly manufactured ::EVENT_HEADER.  If the event is
- *          not used it must be released using ::evel_free_event
- * @retval  NULL  Failed to create the event.
+ * @note It does not free the Report itself, since that may be part of a
+ * larger structure.
  *****************************************************************************/
-EVENT_HEADER * evel_new_heartbeat_nameid(const char* ev_name, const char *ev_id);
+void evel_free_report(EVENT_REPORT * event);
 
 /**************************************************************************//**
- * Create a new Heartbeat fields event.
+ * Set the Event Type property of the Report.
  *
- * @note    The mandatory fields on the Heartbeat fields must be supplied to
- *          this factory function and are immutable once set.  Optional fields
- *          have explicit setter functions, but again values may only be set
- *          once so that the event has immutable properties.
- * @param ev_name  Unique Event Name confirming Domain AsdcModel Description
- * @param ev_id    A universal identifier of the event for: troubleshooting correlation, analysis, etc
- * @param interval    heartbeat interval
- * @returns pointer to the newly manufactured ::EVENT_HEARTBEAT_FIELD.  If the event
- *          is not used (i.e. posted) it must be released using
- *          ::evel_free_hrtbt_field.
- * @retval  NULL  Failed to create the event.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param report Pointer to the Report.
+ * @param type        The Event Type to be set. ASCIIZ string. The caller
+ *                    does not need to preserve the value once the function
+ *                    returns.
  *****************************************************************************/
-EVENT_HEARTBEAT_FIELD * evel_new_heartbeat_field(int interval,const char* ev_name, const char *ev_id);
+void evel_report_type_set(EVENT_REPORT * report, const char * const type);
 
 /**************************************************************************//**
- * Free an event header.
+ * Add a Feature usage value name/value pair to the Report.
  *
- * Free off the event header supplied.  Will free all the contained allocated
- * memory.
+ * The name is null delimited ASCII string.  The library takes
+ * a copy so the caller does not have to preserve values after the function
+ * returns.
  *
- * @note It does not free the header itself, since that may be part of a
- * larger structure.
+ * @param report          Pointer to the report.
+ * @param feature         ASCIIZ string with the feature's name.
+ * @param utilization     Utilization of the feature.
  *****************************************************************************/
-void evel_free_header(EVENT_HEADER * const event);
+void evel_report_feature_use_add(EVENT_REPORT * report,
+                                 char * feature,
+                                 int utilization);
 
 /**************************************************************************//**
- * Initialize a newly created event header.
+ * Add a Additional Measurement value name/value pair to the Report.
  *
- * @param header  Pointer to the header being initialized.
- *****************************************************************************/
-void evel_init_header(EVENT_HEADER * const header,const char *const eventname);
-
-/**************************************************************************//**
- * Set the Event Type property of the event header.
+ * The name is null delimited ASCII string.  The library takes
+ * a copy so the caller does not have to preserve values after the function
+ * returns.
  *
- * @param header        Pointer to the ::EVENT_HEADER.
- * @param type          The Event Type to be set. ASCIIZ string. The caller
- *                      does not need to preserve the value once the function
- *                      returns.
+ * @param report   Pointer to the report.
+ * @param group    ASCIIZ string with the measurement group's name.
+ * @param name     ASCIIZ string containing the measurement's name.
+ * @param value    ASCIIZ string containing the measurement's value.
  *****************************************************************************/
-void evel_header_type_set(EVENT_HEADER * const header,
-                          const char * const type);
+void evel_report_custom_measurement_add(EVENT_REPORT * report,
+                                        const char * const group,
+                                        const char * const name,
+                                        const char * const value);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   MOBILE_FLOW                                                             */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
 
 /**************************************************************************//**
- * Set the next event_sequence to use.
+ * Create a new Mobile Flow event.
  *
- * @param sequence      The next sequence number to use.
+ * @note    The mandatory fields on the Mobile Flow must be supplied to this
+ *          factory function and are immutable once set.  Optional fields have
+ *          explicit setter functions, but again values may only be set once so
+ *          that the Mobile Flow has immutable properties.
+ *
+ * @param event_name    Unique Event Name
+ * @param event_id    A universal identifier of the event for analysis etc
+ * @param   flow_direction
+ * @param   gtp_per_flow_metrics
+ * @param   ip_protocol_type
+ * @param   ip_version
+ * @param   other_endpoint_ip_address
+ * @param   other_endpoint_port
+ * @param   reporting_endpoint_ip_addr
+ * @param   reporting_endpoint_port
+ *
+ * @returns pointer to the newly manufactured ::EVENT_MOBILE_FLOW.  If the
+ *          event is not used (i.e. posted) it must be released using
+ *          ::evel_free_mobile_flow.
+ * @retval  NULL  Failed to create the event.
  *****************************************************************************/
-void evel_set_global_event_sequence(const int sequence);
+EVENT_MOBILE_FLOW * evel_new_mobile_flow(
+		      const char* ev_name, const char *ev_id,
+                      const char * const flow_direction,
+                      MOBILE_GTP_PER_FLOW_METRICS * gtp_per_flow_metrics,
+                      const char * const ip_protocol_type,
+                      const char * const ip_version,
+                      const char * const other_endpoint_ip_address,
+                      int other_endpoint_port,
+                      const char * const reporting_endpoint_ip_addr,
+                      int reporting_endpoint_port);
 
 /**************************************************************************//**
- * Set the Event Sequence property of the event header.
+ * Free a Mobile Flow.
  *
- * @note This is mainly for tracking fault event sequence numbers
+ * Free off the Mobile Flow supplied.  Will free all the contained allocated
+ * memory.
  *
- * @param header        Pointer to the ::EVENT_HEADER.
- * @param sequence_number
- * 
+ * @note It does not free the Mobile Flow itself, since that may be part of a
+ * larger structure.
  *****************************************************************************/
-void evel_event_sequence_set(EVENT_HEADER * const header,const int sequence_number);
+void evel_free_mobile_flow(EVENT_MOBILE_FLOW * event);
 
 /**************************************************************************//**
- * Set the Start Epoch property of the event header.
- *
- * @note The Start Epoch defaults to the time of event creation.
+ * Set the Event Type property of the Mobile Flow.
  *
- * @param header        Pointer to the ::EVENT_HEADER.
- * @param start_epoch_microsec
- *                      The start epoch to set, in microseconds.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param type        The Event Type to be set. ASCIIZ string. The caller
+ *                    does not need to preserve the value once the function
+ *                    returns.
  *****************************************************************************/
-void evel_start_epoch_set(EVENT_HEADER * const header,
-                          const unsigned long long start_epoch_microsec);
+void evel_mobile_flow_type_set(EVENT_MOBILE_FLOW * mobile_flow,
+                               const char * const type);
 
 /**************************************************************************//**
- * Set the Last Epoch property of the event header.
+ * Set the Application Type property of the Mobile Flow.
  *
- * @note The Last Epoch defaults to the time of event creation.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @param header        Pointer to the ::EVENT_HEADER.
- * @param last_epoch_microsec
- *                      The last epoch to set, in microseconds.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param type        The Application Type to be set. ASCIIZ string. The caller
+ *                    does not need to preserve the value once the function
+ *                    returns.
  *****************************************************************************/
-void evel_last_epoch_set(EVENT_HEADER * const header,
-                         const unsigned long long last_epoch_microsec);
+void evel_mobile_flow_app_type_set(EVENT_MOBILE_FLOW * mobile_flow,
+                                   const char * const type);
 
 /**************************************************************************//**
- * Set the Reporting Entity Name property of the event header.
+ * Set the Application Protocol Type property of the Mobile Flow.
  *
- * @note The Reporting Entity Name defaults to the OpenStack VM Name.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @param header        Pointer to the ::EVENT_HEADER.
- * @param entity_name   The entity name to set.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param type        The Application Protocol Type to be set. ASCIIZ string.
+ *                    The caller does not need to preserve the value once the
+ *                    function returns.
  *****************************************************************************/
-void evel_reporting_entity_name_set(EVENT_HEADER * const header,
-                                    const char * const entity_name);
+void evel_mobile_flow_app_prot_type_set(EVENT_MOBILE_FLOW * mobile_flow,
+                                        const char * const type);
 
 /**************************************************************************//**
- * Set the Source Name property of the event header.
+ * Set the Application Protocol Version property of the Mobile Flow.
  *
- * @note The Source Name defaults to the OpenStack VM Name.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @param header        Pointer to the ::EVENT_HEADER.
- * @param entity_name   The source name to set.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param version     The Application Protocol Version to be set. ASCIIZ
+ *                    string.  The caller does not need to preserve the value
+ *                    once the function returns.
  *****************************************************************************/
-void evel_source_name_set(EVENT_HEADER * const header,
-                          const char * const source_name);
+void evel_mobile_flow_app_prot_ver_set(EVENT_MOBILE_FLOW * mobile_flow,
+                                       const char * const version);
 
 /**************************************************************************//**
- * Set the Reporting Entity Id property of the event header.
+ * Set the CID property of the Mobile Flow.
  *
- * @note The Reporting Entity Id defaults to the OpenStack VM UUID.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @param header        Pointer to the ::EVENT_HEADER.
- * @param entity_id     The entity id to set.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param cid         The CID to be set. ASCIIZ string.  The caller does not
+ *                    need to preserve the value once the function returns.
  *****************************************************************************/
-void evel_reporting_entity_id_set(EVENT_HEADER * const header,
-                                  const char * const entity_id);
+void evel_mobile_flow_cid_set(EVENT_MOBILE_FLOW * mobile_flow,
+                              const char * const cid);
 
 /**************************************************************************//**
- * Set the Source Id property of the event header.
+ * Set the Connection Type property of the Mobile Flow.
  *
- * @note The Source Id defaults to the OpenStack VM UUID.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @param header        Pointer to the ::EVENT_HEADER.
- * @param entity_id     The Source id to set.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param type        The Connection Type to be set. ASCIIZ string. The caller
+ *                    does not need to preserve the value once the function
+ *                    returns.
  *****************************************************************************/
-void evel_source_id_set(EVENT_HEADER * const header,
-                        const char * const source_id);
+void evel_mobile_flow_con_type_set(EVENT_MOBILE_FLOW * mobile_flow,
+                                   const char * const type);
 
 /**************************************************************************//**
- * Set the NFC Naming code property of the event header.
+ * Set the ECGI property of the Mobile Flow.
  *
- * @param header        Pointer to the ::EVENT_HEADER.
- * @param nfcnamingcode String
- *****************************************************************************/
-void evel_nfcnamingcode_set(EVENT_HEADER * const header,
-                         const char * const nfcnam);
-/**************************************************************************//**
- * Set the NF Naming code property of the event header.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @param header        Pointer to the ::EVENT_HEADER.
- * @param nfnamingcode String
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param ecgi        The ECGI to be set. ASCIIZ string.  The caller does not
+ *                    need to preserve the value once the function returns.
  *****************************************************************************/
-void evel_nfnamingcode_set(EVENT_HEADER * const header,
-                         const char * const nfnam);
-
-/*****************************************************************************/
-/*****************************************************************************/
-/*                                                                           */
-/*   FAULT                                                                   */
-/*                                                                           */
-/*****************************************************************************/
-/*****************************************************************************/
+void evel_mobile_flow_ecgi_set(EVENT_MOBILE_FLOW * mobile_flow,
+                               const char * const ecgi);
 
 /**************************************************************************//**
- * Create a new fault event.
+ * Set the GTP Protocol Type property of the Mobile Flow.
  *
- * @note    The mandatory fields on the Fault must be supplied to this factory
- *          function and are immutable once set.  Optional fields have explicit
- *          setter functions, but again values may only be set once so that the
- *          Fault has immutable properties.
- * @param event_name    Unique Event Name
- * @param event_id    A universal identifier of the event for analysis etc
- * @param   condition   The condition indicated by the Fault.
- * @param   specific_problem  The specific problem triggering the fault.
- * @param   priority    The priority of the event.
- * @param   severity    The severity of the Fault.
- * @param   ev_source_type    Source of Alarm event
- * @param   version     fault version
- * @param   status      status of Virtual Function
- * @returns pointer to the newly manufactured ::EVENT_FAULT.  If the event is
- *          not used (i.e. posted) it must be released using ::evel_free_fault.
- * @retval  NULL  Failed to create the event.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param type        The GTP Protocol Type to be set. ASCIIZ string.  The
+ *                    caller does not need to preserve the value once the
+ *                    function returns.
  *****************************************************************************/
-EVENT_FAULT * evel_new_fault(const char* ev_name, const char *ev_id,
-			     const char * const condition,
-                             const char * const specific_problem,
-                             EVEL_EVENT_PRIORITIES priority,
-                             EVEL_SEVERITIES severity,
-                             EVEL_SOURCE_TYPES ev_source_type,
-                             EVEL_VF_STATUSES status);
+void evel_mobile_flow_gtp_prot_type_set(EVENT_MOBILE_FLOW * mobile_flow,
+                                        const char * const type);
 
 /**************************************************************************//**
- * Free a Fault.
+ * Set the GTP Protocol Version property of the Mobile Flow.
  *
- * Free off the Fault supplied.  Will free all the contained allocated memory.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @note It does not free the Fault itself, since that may be part of a
- * larger structure.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param version     The GTP Protocol Version to be set. ASCIIZ string.  The
+ *                    caller does not need to preserve the value once the
+ *                    function returns.
  *****************************************************************************/
-void evel_free_fault(EVENT_FAULT * event);
+void evel_mobile_flow_gtp_prot_ver_set(EVENT_MOBILE_FLOW * mobile_flow,
+                                       const char * const version);
 
 /**************************************************************************//**
- * Set the Fault Category property of the Fault.
+ * Set the HTTP Header property of the Mobile Flow.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param fault      Pointer to the fault.
- * @param category   Category : license, link, routing, security, signaling.
- *                       ASCIIZ string. The caller
- *                   does not need to preserve the value once the function
- *                   returns.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param header      The HTTP header to be set. ASCIIZ string. The caller does
+ *                    not need to preserve the value once the function returns.
  *****************************************************************************/
-void evel_fault_category_set(EVENT_FAULT * fault,
-                              const char * const category);
+void evel_mobile_flow_http_header_set(EVENT_MOBILE_FLOW * mobile_flow,
+                                      const char * const header);
 
 /**************************************************************************//**
- * Set the Alarm Interface A property of the Fault.
+ * Set the IMEI property of the Mobile Flow.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param fault      Pointer to the fault.
- * @param interface  The Alarm Interface A to be set. ASCIIZ string. The caller
- *                   does not need to preserve the value once the function
- *                   returns.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param imei        The IMEI to be set. ASCIIZ string.  The caller does not
+ *                    need to preserve the value once the function returns.
  *****************************************************************************/
-void evel_fault_interface_set(EVENT_FAULT * fault,
-                              const char * const interface);
+void evel_mobile_flow_imei_set(EVENT_MOBILE_FLOW * mobile_flow,
+                               const char * const imei);
 
 /**************************************************************************//**
- * Add an additional value name/value pair to the Fault.
+ * Set the IMSI property of the Mobile Flow.
  *
- * The name and value are null delimited ASCII strings.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @param fault     Pointer to the fault.
- * @param name      ASCIIZ string with the attribute's name.
- * @param value     ASCIIZ string with the attribute's value.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param imsi        The IMSI to be set. ASCIIZ string.  The caller does not
+ *                    need to preserve the value once the function returns.
  *****************************************************************************/
-void evel_fault_addl_info_add(EVENT_FAULT * fault, char * name, char * value);
+void evel_mobile_flow_imsi_set(EVENT_MOBILE_FLOW * mobile_flow,
+                               const char * const imsi);
 
 /**************************************************************************//**
- * Set the Event Type property of the Fault.
+ * Set the LAC property of the Mobile Flow.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param fault      Pointer to the fault.
- * @param type       The Event Type to be set. ASCIIZ string. The caller
- *                   does not need to preserve the value once the function
- *                   returns.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param lac         The LAC to be set. ASCIIZ string.  The caller does not
+ *                    need to preserve the value once the function returns.
  *****************************************************************************/
-void evel_fault_type_set(EVENT_FAULT * fault, const char * const type);
-
-/*****************************************************************************/
-/*****************************************************************************/
-/*                                                                           */
-/*   MEASUREMENT                                                             */
-/*                                                                           */
-/*****************************************************************************/
-/*****************************************************************************/
+void evel_mobile_flow_lac_set(EVENT_MOBILE_FLOW * mobile_flow,
+                              const char * const lac);
 
 /**************************************************************************//**
- * Create a new Measurement event.
- *
- * @note    The mandatory fields on the Measurement must be supplied to this
- *          factory function and are immutable once set.  Optional fields have
- *          explicit setter functions, but again values may only be set once so
- *          that the Measurement has immutable properties.
+ * Set the MCC property of the Mobile Flow.
  *
- * @param   measurement_interval
- * @param event_name    Unique Event Name
- * @param event_id    A universal identifier of the event for analysis etc
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @returns pointer to the newly manufactured ::EVENT_MEASUREMENT.  If the
- *          event is not used (i.e. posted) it must be released using
- *          ::evel_free_event.
- * @retval  NULL  Failed to create the event.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param mcc         The MCC to be set. ASCIIZ string.  The caller does not
+ *                    need to preserve the value once the function returns.
  *****************************************************************************/
-EVENT_MEASUREMENT * evel_new_measurement(double measurement_interval,const char* ev_name, const char *ev_id);
+void evel_mobile_flow_mcc_set(EVENT_MOBILE_FLOW * mobile_flow,
+                              const char * const mcc);
 
 /**************************************************************************//**
- * Free a Measurement.
+ * Set the MNC property of the Mobile Flow.
  *
- * Free off the Measurement supplied.  Will free all the contained allocated
- * memory.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @note It does not free the Measurement itself, since that may be part of a
- * larger structure.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param mnc         The MNC to be set. ASCIIZ string.  The caller does not
+ *                    need to preserve the value once the function returns.
  *****************************************************************************/
-void evel_free_measurement(EVENT_MEASUREMENT * event);
+void evel_mobile_flow_mnc_set(EVENT_MOBILE_FLOW * mobile_flow,
+                              const char * const mnc);
 
 /**************************************************************************//**
- * Set the Event Type property of the Measurement.
+ * Set the MSISDN property of the Mobile Flow.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param measurement Pointer to the Measurement.
- * @param type        The Event Type to be set. ASCIIZ string. The caller
- *                    does not need to preserve the value once the function
- *                    returns.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param msisdn      The MSISDN to be set. ASCIIZ string.  The caller does not
+ *                    need to preserve the value once the function returns.
  *****************************************************************************/
-void evel_measurement_type_set(EVENT_MEASUREMENT * measurement,
-                               const char * const type);
+void evel_mobile_flow_msisdn_set(EVENT_MOBILE_FLOW * mobile_flow,
+                                 const char * const msisdn);
 
 /**************************************************************************//**
- * Set the Concurrent Sessions property of the Measurement.
+ * Set the Other Functional Role property of the Mobile Flow.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param measurement         Pointer to the Measurement.
- * @param concurrent_sessions The Concurrent Sessions to be set.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param role        The Other Functional Role to be set. ASCIIZ string. The
+ *                    caller does not need to preserve the value once the
+ *                    function returns.
  *****************************************************************************/
-void evel_measurement_conc_sess_set(EVENT_MEASUREMENT * measurement,
-                                    int concurrent_sessions);
+void evel_mobile_flow_other_func_role_set(EVENT_MOBILE_FLOW * mobile_flow,
+                                          const char * const role);
 
 /**************************************************************************//**
- * Set the Configured Entities property of the Measurement.
+ * Set the RAC property of the Mobile Flow.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param measurement         Pointer to the Measurement.
- * @param configured_entities The Configured Entities to be set.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param rac         The RAC to be set. ASCIIZ string.  The caller does not
+ *                    need to preserve the value once the function returns.
  *****************************************************************************/
-void evel_measurement_cfg_ents_set(EVENT_MEASUREMENT * measurement,
-                                   int configured_entities);
+void evel_mobile_flow_rac_set(EVENT_MOBILE_FLOW * mobile_flow,
+                              const char * const rac);
 
 /**************************************************************************//**
- * Add an additional set of Errors to the Measurement.
+ * Set the Radio Access Technology property of the Mobile Flow.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param measurement       Pointer to the measurement.
- * @param receive_discards  The number of receive discards.
- * @param receive_errors    The number of receive errors.
- * @param transmit_discards The number of transmit discards.
- * @param transmit_errors   The number of transmit errors.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param tech        The Radio Access Technology to be set. ASCIIZ string. The
+ *                    caller does not need to preserve the value once the
+ *                    function returns.
  *****************************************************************************/
-void evel_measurement_errors_set(EVENT_MEASUREMENT * measurement,
-                                 int receive_discards,
-                                 int receive_errors,
-                                 int transmit_discards,
-                                 int transmit_errors);
+void evel_mobile_flow_radio_acc_tech_set(EVENT_MOBILE_FLOW * mobile_flow,
+                                         const char * const tech);
 
 /**************************************************************************//**
- * Set the Mean Request Latency property of the Measurement.
+ * Set the SAC property of the Mobile Flow.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param measurement          Pointer to the Measurement.
- * @param mean_request_latency The Mean Request Latency to be set.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param sac         The SAC to be set. ASCIIZ string.  The caller does not
+ *                    need to preserve the value once the function returns.
  *****************************************************************************/
-void evel_measurement_mean_req_lat_set(EVENT_MEASUREMENT * measurement,
-                                       double mean_request_latency);
+void evel_mobile_flow_sac_set(EVENT_MOBILE_FLOW * mobile_flow,
+                              const char * const sac);
 
 /**************************************************************************//**
- * Set the Request Rate property of the Measurement.
+ * Set the Sampling Algorithm property of the Mobile Flow.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param measurement  Pointer to the Measurement.
- * @param request_rate The Request Rate to be set.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param algorithm   The Sampling Algorithm to be set.
  *****************************************************************************/
-void evel_measurement_request_rate_set(EVENT_MEASUREMENT * measurement,
-                                       int request_rate);
+void evel_mobile_flow_samp_alg_set(EVENT_MOBILE_FLOW * mobile_flow,
+                                   int algorithm);
 
 /**************************************************************************//**
- * Add an additional CPU usage value name/value pair to the Measurement.
+ * Set the TAC property of the Mobile Flow.
  *
- * The name and value are null delimited ASCII strings.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @param measurement   Pointer to the measurement.
- * @param id            ASCIIZ string with the CPU's identifier.
- * @param usage         CPU utilization.
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param tac         The TAC to be set. ASCIIZ string.  The caller does not
+ *                    need to preserve the value once the function returns.
  *****************************************************************************/
-MEASUREMENT_CPU_USE * evel_measurement_new_cpu_use_add(EVENT_MEASUREMENT * measurement, char * id, double usage);
+void evel_mobile_flow_tac_set(EVENT_MOBILE_FLOW * mobile_flow,
+                              const char * const tac);
 
 /**************************************************************************//**
- * Set the CPU Idle value in measurement interval
- *   percentage of CPU time spent in the idle task
+ * Set the Tunnel ID property of the Mobile Flow.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param cpu_use      Pointer to the CPU Use.
- * @param val          double
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param tunnel_id   The Tunnel ID to be set. ASCIIZ string.  The caller does
+ *                    not need to preserve the value once the function returns.
  *****************************************************************************/
-void evel_measurement_cpu_use_idle_set(MEASUREMENT_CPU_USE *const cpu_use,
-                                    const double val);
+void evel_mobile_flow_tunnel_id_set(EVENT_MOBILE_FLOW * mobile_flow,
+                                    const char * const tunnel_id);
 
 /**************************************************************************//**
- * Set the percentage of time spent servicing interrupts
+ * Set the VLAN ID property of the Mobile Flow.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param cpu_use      Pointer to the CPU Use.
- * @param val          double
+ * @param mobile_flow Pointer to the Mobile Flow.
+ * @param vlan_id     The VLAN ID to be set. ASCIIZ string.  The caller does
+ *                    not need to preserve the value once the function returns.
  *****************************************************************************/
-void evel_measurement_cpu_use_interrupt_set(MEASUREMENT_CPU_USE * const cpu_use,
-                                    const double val);
+void evel_mobile_flow_vlan_id_set(EVENT_MOBILE_FLOW * mobile_flow,
+                                  const char * const vlan_id);
 
 /**************************************************************************//**
- * Set the percentage of time spent running user space processes that have been niced
+ * Create a new Mobile GTP Per Flow Metrics.
+ *
+ * @note    The mandatory fields on the Mobile GTP Per Flow Metrics must be
+ *          supplied to this factory function and are immutable once set.
+ *          Optional fields have explicit setter functions, but again values
+ *          may only be set once so that the Mobile GTP Per Flow Metrics has
+ *          immutable properties.
+ *
+ * @param   avg_bit_error_rate
+ * @param   avg_packet_delay_variation
+ * @param   avg_packet_latency
+ * @param   avg_receive_throughput
+ * @param   avg_transmit_throughput
+ * @param   flow_activation_epoch
+ * @param   flow_activation_microsec
+ * @param   flow_deactivation_epoch
+ * @param   flow_deactivation_microsec
+ * @param   flow_deactivation_time
+ * @param   flow_status
+ * @param   max_packet_delay_variation
+ * @param   num_activation_failures
+ * @param   num_bit_errors
+ * @param   num_bytes_received
+ * @param   num_bytes_transmitted
+ * @param   num_dropped_packets
+ * @param   num_l7_bytes_received
+ * @param   num_l7_bytes_transmitted
+ * @param   num_lost_packets
+ * @param   num_out_of_order_packets
+ * @param   num_packet_errors
+ * @param   num_packets_received_excl_retrans
+ * @param   num_packets_received_incl_retrans
+ * @param   num_packets_transmitted_incl_retrans
+ * @param   num_retries
+ * @param   num_timeouts
+ * @param   num_tunneled_l7_bytes_received
+ * @param   round_trip_time
+ * @param   time_to_first_byte
+ *
+ * @returns pointer to the newly manufactured ::MOBILE_GTP_PER_FLOW_METRICS.
+ *          If the structure is not used it must be released using
+ *          ::evel_free_mobile_gtp_flow_metrics.
+ * @retval  NULL  Failed to create the event.
+ *****************************************************************************/
+MOBILE_GTP_PER_FLOW_METRICS * evel_new_mobile_gtp_flow_metrics(
+                                      double avg_bit_error_rate,
+                                      double avg_packet_delay_variation,
+                                      int avg_packet_latency,
+                                      int avg_receive_throughput,
+                                      int avg_transmit_throughput,
+                                      int flow_activation_epoch,
+                                      int flow_activation_microsec,
+                                      int flow_deactivation_epoch,
+                                      int flow_deactivation_microsec,
+                                      time_t flow_deactivation_time,
+                                      const char * const flow_status,
+                                      int max_packet_delay_variation,
+                                      int num_activation_failures,
+                                      int num_bit_errors,
+                                      int num_bytes_received,
+                                      int num_bytes_transmitted,
+                                      int num_dropped_packets,
+                                      int num_l7_bytes_received,
+                                      int num_l7_bytes_transmitted,
+                                      int num_lost_packets,
+                                      int num_out_of_order_packets,
+                                      int num_packet_errors,
+                                      int num_packets_received_excl_retrans,
+                                      int num_packets_received_incl_retrans,
+                                      int num_packets_transmitted_incl_retrans,
+                                      int num_retries,
+                                      int num_timeouts,
+                                      int num_tunneled_l7_bytes_received,
+                                      int round_trip_time,
+                                      int time_to_first_byte);
+
+/**************************************************************************//**
+ * Free a Mobile GTP Per Flow Metrics.
+ *
+ * Free off the Mobile GTP Per Flow Metrics supplied.  Will free all the
+ * contained allocated memory.
+ *
+ * @note It does not free the Mobile GTP Per Flow Metrics itself, since that
+ * may be part of a larger structure.
+ *****************************************************************************/
+void evel_free_mobile_gtp_flow_metrics(MOBILE_GTP_PER_FLOW_METRICS * metrics);
+
+/**************************************************************************//**
+ * Set the Duration of Connection Failed Status property of the Mobile GTP Per
+ * Flow Metrics.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param cpu_use      Pointer to the CPU Use.
- * @param val          double
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param duration    The Duration of Connection Failed Status to be set.
  *****************************************************************************/
-void evel_measurement_cpu_use_nice_set(MEASUREMENT_CPU_USE * const cpu_use,
-                                    const double val);
+void evel_mobile_gtp_metrics_dur_con_fail_set(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         int duration);
 
 /**************************************************************************//**
- * Set the percentage of time spent handling soft irq interrupts
+ * Set the Duration of Tunnel Failed Status property of the Mobile GTP Per Flow
+ * Metrics.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param cpu_use      Pointer to the CPU Use.
- * @param val          double
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param duration    The Duration of Tunnel Failed Status to be set.
  *****************************************************************************/
-void evel_measurement_cpu_use_softirq_set(MEASUREMENT_CPU_USE * const cpu_use,
-                                    const double val);
+void evel_mobile_gtp_metrics_dur_tun_fail_set(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         int duration);
+
 /**************************************************************************//**
- * Set the percentage of time spent in involuntary wait
+ * Set the Activated By property of the Mobile GTP Per Flow metrics.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param cpu_use      Pointer to the CPU Use.
- * @param val          double
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param act_by      The Activated By to be set.  ASCIIZ string. The caller
+ *                    does not need to preserve the value once the function
+ *                    returns.
  *****************************************************************************/
-void evel_measurement_cpu_use_steal_set(MEASUREMENT_CPU_USE * const cpu_use,
-                                    const double val);
+void evel_mobile_gtp_metrics_act_by_set(MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                        const char * const act_by);
+
 /**************************************************************************//**
- * Set the percentage of time spent on system tasks running the kernel
+ * Set the Activation Time property of the Mobile GTP Per Flow metrics.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param cpu_use      Pointer to the CPU Use.
- * @param val          double
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param act_time    The Activation Time to be set.  ASCIIZ string. The caller
+ *                    does not need to preserve the value once the function
+ *                    returns.
  *****************************************************************************/
-void evel_measurement_cpu_use_system_set(MEASUREMENT_CPU_USE * const cpu_use,
-                                    const double val);
+void evel_mobile_gtp_metrics_act_time_set(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         time_t act_time);
+
 /**************************************************************************//**
- * Set the percentage of time spent running un-niced user space processes
+ * Set the Deactivated By property of the Mobile GTP Per Flow metrics.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param cpu_use      Pointer to the CPU Use.
- * @param val          double
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param deact_by    The Deactivated By to be set.  ASCIIZ string. The caller
+ *                    does not need to preserve the value once the function
+ *                    returns.
  *****************************************************************************/
-void evel_measurement_cpu_use_usageuser_set(MEASUREMENT_CPU_USE * const cpu_use,
-                                    const double val);
+void evel_mobile_gtp_metrics_deact_by_set(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         const char * const deact_by);
+
 /**************************************************************************//**
- * Set the percentage of CPU time spent waiting for I/O operations to complete
+ * Set the GTP Connection Status property of the Mobile GTP Per Flow metrics.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param cpu_use      Pointer to the CPU Use.
- * @param val          double
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param status      The GTP Connection Status to be set.  ASCIIZ string. The
+ *                    caller does not need to preserve the value once the
+ *                    function returns.
  *****************************************************************************/
-void evel_measurement_cpu_use_wait_set(MEASUREMENT_CPU_USE * const cpu_use,
-                                    const double val);
+void evel_mobile_gtp_metrics_con_status_set(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         const char * const status);
 
 /**************************************************************************//**
- * Add an additional File System usage value name/value pair to the
- * Measurement.
+ * Set the GTP Tunnel Status property of the Mobile GTP Per Flow metrics.
  *
- * The filesystem_name is null delimited ASCII string.  The library takes a
- * copy so the caller does not have to preserve values after the function
- * returns.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @param measurement     Pointer to the measurement.
- * @param filesystem_name   ASCIIZ string with the file-system's UUID.
- * @param block_configured  Block storage configured.
- * @param block_used        Block storage in use.
- * @param block_iops        Block storage IOPS.
- * @param ephemeral_configured  Ephemeral storage configured.
- * @param ephemeral_used        Ephemeral storage in use.
- * @param ephemeral_iops        Ephemeral storage IOPS.
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param status      The GTP Tunnel Status to be set.  ASCIIZ string. The
+ *                    caller does not need to preserve the value once the
+ *                    function returns.
  *****************************************************************************/
-void evel_measurement_fsys_use_add(EVENT_MEASUREMENT * measurement,
-                                   char * filesystem_name,
-                                   double block_configured,
-                                   double block_used,
-                                   double block_iops,
-                                   double ephemeral_configured,
-                                   double ephemeral_used,
-                                   double ephemeral_iops);
+void evel_mobile_gtp_metrics_tun_status_set(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         const char * const status);
 
 /**************************************************************************//**
- * Add a Feature usage value name/value pair to the Measurement.
- *
- * The name is null delimited ASCII string.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * Set an IP Type-of-Service count property of the Mobile GTP Per Flow metrics.
  *
- * @param measurement     Pointer to the measurement.
- * @param feature         ASCIIZ string with the feature's name.
- * @param utilization     Utilization of the feature.
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param index       The index of the IP Type-of-Service.
+ * @param count       The count.
  *****************************************************************************/
-void evel_measurement_feature_use_add(EVENT_MEASUREMENT * measurement,
-                                      char * feature,
-                                      int utilization);
+void evel_mobile_gtp_metrics_iptos_set(MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                       int index,
+                                       int count);
 
 /**************************************************************************//**
- * Add a Additional Measurement value name/value pair to the Measurement.
+ * Set the Large Packet Round-Trip Time property of the Mobile GTP Per Flow
+ * Metrics.
  *
- * The name is null delimited ASCII string.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @param measurement   Pointer to the Measurement.
- * @param group    ASCIIZ string with the measurement group's name.
- * @param name     ASCIIZ string containing the measurement's name.
- * @param name     ASCIIZ string containing the measurement's value.
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param rtt         The Large Packet Round-Trip Time to be set.
  *****************************************************************************/
-void evel_measurement_custom_measurement_add(EVENT_MEASUREMENT * measurement,
-                                             const char * const group,
-                                             const char * const name,
-                                             const char * const value);
+void evel_mobile_gtp_metrics_large_pkt_rtt_set(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         int rtt);
 
 /**************************************************************************//**
- * Add a Codec usage value name/value pair to the Measurement.
+ * Set the Large Packet Threshold property of the Mobile GTP Per Flow Metrics.
  *
- * The name is null delimited ASCII string.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @param measurement     Pointer to the measurement.
- * @param codec           ASCIIZ string with the codec's name.
- * @param utilization     Utilization of the feature.
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param threshold   The Large Packet Threshold to be set.
  *****************************************************************************/
-void evel_measurement_codec_use_add(EVENT_MEASUREMENT * measurement,
-                                    char * codec,
-                                    int utilization);
+void evel_mobile_gtp_metrics_large_pkt_thresh_set(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         double threshold);
 
 /**************************************************************************//**
- * Set the Media Ports in Use property of the Measurement.
+ * Set the Max Receive Bit Rate property of the Mobile GTP Per Flow Metrics.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param measurement         Pointer to the measurement.
- * @param media_ports_in_use  The media port usage to set.
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param rate        The Max Receive Bit Rate to be set.
  *****************************************************************************/
-void evel_measurement_media_port_use_set(EVENT_MEASUREMENT * measurement,
-                                         int media_ports_in_use);
+void evel_mobile_gtp_metrics_max_rcv_bit_rate_set(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         int rate);
 
 /**************************************************************************//**
- * Set the VNFC Scaling Metric property of the Measurement.
+ * Set the Max Transmit Bit Rate property of the Mobile GTP Per Flow Metrics.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param measurement     Pointer to the measurement.
- * @param scaling_metric  The scaling metric to set.
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param rate        The Max Transmit Bit Rate to be set.
  *****************************************************************************/
-void evel_measurement_vnfc_scaling_metric_set(EVENT_MEASUREMENT * measurement,
-                                              int scaling_metric);
+void evel_mobile_gtp_metrics_max_trx_bit_rate_set(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         int rate);
 
 /**************************************************************************//**
- * Create a new Latency Bucket to be added to a Measurement event.
- *
- * @note    The mandatory fields on the ::MEASUREMENT_LATENCY_BUCKET must be
- *          supplied to this factory function and are immutable once set.
- *          Optional fields have explicit setter functions, but again values
- *          may only be set once so that the ::MEASUREMENT_LATENCY_BUCKET has
- *          immutable properties.
+ * Set the Number of GTP Echo Failures property of the Mobile GTP Per Flow
+ * Metrics.
  *
- * @param count         Count of events in this bucket.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @returns pointer to the newly manufactured ::MEASUREMENT_LATENCY_BUCKET.
- * @retval  NULL  Failed to create the Latency Bucket.
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param num         The Number of GTP Echo Failures to be set.
  *****************************************************************************/
-MEASUREMENT_LATENCY_BUCKET * evel_new_meas_latency_bucket(const int count);
+void evel_mobile_gtp_metrics_num_echo_fail_set(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         int num);
 
 /**************************************************************************//**
- * Set the High End property of the Measurement Latency Bucket.
+ * Set the Number of GTP Tunnel Errors property of the Mobile GTP Per Flow
+ * Metrics.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param bucket        Pointer to the Measurement Latency Bucket.
- * @param high_end      High end of the bucket's range.
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param num         The Number of GTP Tunnel Errors to be set.
  *****************************************************************************/
-void evel_meas_latency_bucket_high_end_set(
-                                     MEASUREMENT_LATENCY_BUCKET * const bucket,
-                                     const double high_end);
+void evel_mobile_gtp_metrics_num_tun_fail_set(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         int num);
 
 /**************************************************************************//**
- * Set the Low End property of the Measurement Latency Bucket.
+ * Set the Number of HTTP Errors property of the Mobile GTP Per Flow Metrics.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param bucket        Pointer to the Measurement Latency Bucket.
- * @param low_end       Low end of the bucket's range.
+ * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
+ * @param num         The Number of HTTP Errors to be set.
  *****************************************************************************/
-void evel_meas_latency_bucket_low_end_set(
-                                     MEASUREMENT_LATENCY_BUCKET * const bucket,
-                                     const double low_end);
+void evel_mobile_gtp_metrics_num_http_errors_set(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         int num);
 
 /**************************************************************************//**
- * Add an additional Measurement Latency Bucket to the specified event.
+ * Add a TCP flag count to the metrics.
  *
- * @param measurement   Pointer to the Measurement event.
- * @param bucket        Pointer to the Measurement Latency Bucket to add.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param metrics       Pointer to the Mobile GTP Per Flow Metrics.
+ * @param tcp_flag      The TCP flag count to be updated.
+ * @param count         The associated flag count.
  *****************************************************************************/
-void evel_meas_latency_bucket_add(EVENT_MEASUREMENT * const measurement,
-                                  MEASUREMENT_LATENCY_BUCKET * const bucket);
+void evel_mobile_gtp_metrics_tcp_flag_count_add(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         const EVEL_TCP_FLAGS tcp_flag,
+                                         const int count);
 
 /**************************************************************************//**
- * Add an additional Latency Distribution bucket to the Measurement.
+ * Add a QCI COS count to the metrics.
  *
- * This function implements the previous API, purely for convenience.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @param measurement   Pointer to the measurement.
- * @param low_end       Low end of the bucket's range.
- * @param high_end      High end of the bucket's range.
- * @param count         Count of events in this bucket.
+ * @param metrics       Pointer to the Mobile GTP Per Flow Metrics.
+ * @param qci_cos       The QCI COS count to be updated.
+ * @param count         The associated QCI COS count.
  *****************************************************************************/
-void evel_measurement_latency_add(EVENT_MEASUREMENT * const measurement,
-                                  const double low_end,
-                                  const double high_end,
-                                  const int count);
+void evel_mobile_gtp_metrics_qci_cos_count_add(
+                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
+                                         const EVEL_QCI_COS_TYPES qci_cos,
+                                         const int count);
 
-/**************************************************************************//**
- * Create a new vNIC Use to be added to a Measurement event.
- *
- * @note    The mandatory fields on the ::MEASUREMENT_VNIC_PERFORMANCE must be supplied
- *          to this factory function and are immutable once set. Optional
- *          fields have explicit setter functions, but again values may only be
- *          set once so that the ::MEASUREMENT_VNIC_PERFORMANCE has immutable
- *          properties.
- *
- * @param vnic_id               ASCIIZ string with the vNIC's ID.
- * @param val_suspect           True or false confidence in data.
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   SIGNALING                                                               */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/**************************************************************************//**
+ * Create a new Signaling event.
  *
- * @returns pointer to the newly manufactured ::MEASUREMENT_VNIC_PERFORMANCE.
- *          If the structure is not used it must be released using
- *          ::evel_measurement_free_vnic_performance.
- * @retval  NULL  Failed to create the vNIC Use.
+ * @note    The mandatory fields on the Signaling must be supplied to
+ *          this factory function and are immutable once set.  Optional fields
+ *          have explicit setter functions, but again values may only be set
+ *          once so that the event has immutable properties.
+ * @param event_name    Unique Event Name
+ * @param event_id    A universal identifier of the event for analysis etc
+ * @param vendor_name   The vendor id to encode in the event vnf field.
+ * @param module        The module to encode in the event.
+ * @param vnfname       The Virtual network function to encode in the event.
+ * @returns pointer to the newly manufactured ::EVENT_SIGNALING.  If the event
+ *          is not used (i.e. posted) it must be released using
+ *          ::evel_free_signaling.
+ * @retval  NULL  Failed to create the event.
  *****************************************************************************/
-MEASUREMENT_VNIC_PERFORMANCE * evel_measurement_new_vnic_performance(char * const vnic_id, char * const val_suspect);
+EVENT_SIGNALING * evel_new_signaling(const char* ev_name, const char *ev_id,
+				     const char * const vendor_name,
+                                     const char * const correlator,
+				     const char * const local_ip_address,
+				     const char * const local_port,
+				     const char * const remote_ip_address,
+				     const char * const remote_port);
 
 /**************************************************************************//**
- * Free a vNIC Use.
+ * Free a Signaling event.
  *
- * Free off the ::MEASUREMENT_VNIC_PERFORMANCE supplied.  Will free all the contained
- * allocated memory.
+ * Free off the event supplied.  Will free all the contained allocated memory.
  *
- * @note It does not free the vNIC Use itself, since that may be part of a
- * larger structure.
+ * @note It does not free the event itself, since that may be part of a larger
+ * structure.
  *****************************************************************************/
-void evel_measurement_free_vnic_performance(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance);
+void evel_free_signaling(EVENT_SIGNALING * const event);
 
 /**************************************************************************//**
- * Set the Accumulated Broadcast Packets Received in measurement interval
- * property of the vNIC performance.
+ * Set the Event Type property of the Signaling event.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param recvd_bcast_packets_acc
+ * @param event         Pointer to the Signaling event.
+ * @param type          The Event Type to be set. ASCIIZ string. The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
  *****************************************************************************/
-void evel_vnic_performance_rx_bcast_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double recvd_bcast_packets_acc);
+void evel_signaling_type_set(EVENT_SIGNALING * const event,
+                             const char * const type);
+
 /**************************************************************************//**
- * Set the Delta Broadcast Packets Received in measurement interval
- * property of the vNIC performance.
+ * Add an additional value name/value pair to the SIP signaling.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * The name and value are null delimited ASCII strings.  The library takes
+ * a copy so the caller does not have to preserve values after the function
+ * returns.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param recvd_bcast_packets_delta
+ * @param event     Pointer to the fault.
+ * @param name      ASCIIZ string with the attribute's name.  The caller
+ *                  does not need to preserve the value once the function
+ *                  returns.
+ * @param value     ASCIIZ string with the attribute's value.  The caller
+ *                  does not need to preserve the value once the function
+ *                  returns.
  *****************************************************************************/
-void evel_vnic_performance_rx_bcast_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double recvd_bcast_packets_delta);
+void evel_signaling_addl_info_add(EVENT_SIGNALING * event, char * name, char * value);
+
 /**************************************************************************//**
- * Set the Discarded Packets Received in measurement interval
- * property of the vNIC performance.
+ * Set the Correlator property of the Signaling event.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param recvd_discard_packets_acc
+ * @param event         Pointer to the Signaling event.
+ * @param correlator    The correlator to be set. ASCIIZ string. The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
  *****************************************************************************/
-void evel_vnic_performance_rx_discard_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double recvd_discard_packets_acc);
+void evel_signaling_correlator_set(EVENT_SIGNALING * const event,
+                                   const char * const correlator);
+
 /**************************************************************************//**
- * Set the Delta Discarded Packets Received in measurement interval
- * property of the vNIC performance.
+ * Set the Local Ip Address property of the Signaling event.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param recvd_discard_packets_delta
+ * @param event         Pointer to the Signaling event.
+ * @param local_ip_address
+ *                      The Local Ip Address to be set. ASCIIZ string. The
+ *                      caller does not need to preserve the value once the
+ *                      function returns.
  *****************************************************************************/
-void evel_vnic_performance_rx_discard_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double recvd_discard_packets_delta);
+void evel_signaling_local_ip_address_set(EVENT_SIGNALING * const event,
+                                         const char * const local_ip_address);
+
 /**************************************************************************//**
- * Set the Error Packets Received in measurement interval
- * property of the vNIC performance.
+ * Set the Local Port property of the Signaling event.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param recvd_error_packets_acc
+ * @param event         Pointer to the Signaling event.
+ * @param local_port    The Local Port to be set. ASCIIZ string. The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
  *****************************************************************************/
-void evel_vnic_performance_rx_error_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double recvd_error_packets_acc);
+void evel_signaling_local_port_set(EVENT_SIGNALING * const event,
+                                   const char * const local_port);
+
 /**************************************************************************//**
- * Set the Delta Error Packets Received in measurement interval
- * property of the vNIC performance.
+ * Set the Remote Ip Address property of the Signaling event.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param recvd_error_packets_delta
+ * @param event         Pointer to the Signaling event.
+ * @param remote_ip_address
+ *                      The Remote Ip Address to be set. ASCIIZ string. The
+ *                      caller does not need to preserve the value once the
+ *                      function returns.
  *****************************************************************************/
-void evel_vnic_performance_rx_error_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double recvd_error_packets_delta);
+void evel_signaling_remote_ip_address_set(EVENT_SIGNALING * const event,
+                                         const char * const remote_ip_address);
+
 /**************************************************************************//**
- * Set the Accumulated Multicast Packets Received in measurement interval
- * property of the vNIC performance.
+ * Set the Remote Port property of the Signaling event.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param recvd_mcast_packets_acc
+ * @param event         Pointer to the Signaling event.
+ * @param remote_port   The Remote Port to be set. ASCIIZ string. The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
  *****************************************************************************/
-void evel_vnic_performance_rx_mcast_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double recvd_mcast_packets_acc);
+void evel_signaling_remote_port_set(EVENT_SIGNALING * const event,
+                                    const char * const remote_port);
 /**************************************************************************//**
- * Set the Delta Multicast Packets Received in measurement interval
- * property of the vNIC performance.
+ * Set the Vendor module property of the Signaling event.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param recvd_mcast_packets_delta
+ * @param event         Pointer to the Signaling event.
+ * @param modulename    The module name to be set. ASCIIZ string. The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
  *****************************************************************************/
-void evel_vnic_performance_rx_mcast_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double recvd_mcast_packets_delta);
+void evel_signaling_vnfmodule_name_set(EVENT_SIGNALING * const event,
+                                    const char * const module_name);
 /**************************************************************************//**
- * Set the Accumulated Octets Received in measurement interval
- * property of the vNIC performance.
+ * Set the Vendor module property of the Signaling event.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param recvd_octets_acc
+ * @param event         Pointer to the Signaling event.
+ * @param vnfname       The Virtual Network function to be set. ASCIIZ string.
+ *                      The caller does not need to preserve the value once
+ *                      the function returns.
  *****************************************************************************/
-void evel_vnic_performance_rx_octets_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double recvd_octets_acc);
+void evel_signaling_vnfname_set(EVENT_SIGNALING * const event,
+                                    const char * const vnfname);
+
 /**************************************************************************//**
- * Set the Delta Octets Received in measurement interval
- * property of the vNIC performance.
+ * Set the Compressed SIP property of the Signaling event.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param recvd_octets_delta
+ * @param event         Pointer to the Signaling event.
+ * @param compressed_sip
+ *                      The Compressed SIP to be set. ASCIIZ string. The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
  *****************************************************************************/
-void evel_vnic_performance_rx_octets_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double recvd_octets_delta);
+void evel_signaling_compressed_sip_set(EVENT_SIGNALING * const event,
+                                       const char * const compressed_sip);
+
 /**************************************************************************//**
- * Set the Accumulated Total Packets Received in measurement interval
- * property of the vNIC performance.
+ * Set the Summary SIP property of the Signaling event.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param recvd_total_packets_acc
+ * @param event         Pointer to the Signaling event.
+ * @param summary_sip   The Summary SIP to be set. ASCIIZ string. The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
  *****************************************************************************/
-void evel_vnic_performance_rx_total_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double recvd_total_packets_acc);
+void evel_signaling_summary_sip_set(EVENT_SIGNALING * const event,
+                                    const char * const summary_sip);
+
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   STATE CHANGE                                                            */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
 /**************************************************************************//**
- * Set the Delta Total Packets Received in measurement interval
- * property of the vNIC performance.
+ * Create a new State Change event.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @note    The mandatory fields on the Syslog must be supplied to this factory
+ *          function and are immutable once set.  Optional fields have explicit
+ *          setter functions, but again values may only be set once so that the
+ *          Syslog has immutable properties.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param recvd_total_packets_delta
+ * @param event_name    Unique Event Name
+ * @param event_id    A universal identifier of the event for analysis etc
+ * @param new_state     The new state of the reporting entity.
+ * @param old_state     The old state of the reporting entity.
+ * @param interface     The card or port name of the reporting entity.
+ *
+ * @returns pointer to the newly manufactured ::EVENT_STATE_CHANGE.  If the
+ *          event is not used it must be released using
+ *          ::evel_free_state_change
+ * @retval  NULL  Failed to create the event.
  *****************************************************************************/
-void evel_vnic_performance_rx_total_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double recvd_total_packets_delta);
+EVENT_STATE_CHANGE * evel_new_state_change(const char* ev_name, const char *ev_id,
+					   const EVEL_ENTITY_STATE new_state,
+                                           const EVEL_ENTITY_STATE old_state,
+                                           const char * const interface);
+
 /**************************************************************************//**
- * Set the Accumulated Unicast Packets Received in measurement interval
- * property of the vNIC performance.
+ * Free a State Change.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Free off the State Change supplied.  Will free all the contained allocated
+ * memory.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param recvd_ucast_packets_acc
+ * @note It does not free the State Change itself, since that may be part of a
+ * larger structure.
  *****************************************************************************/
-void evel_vnic_performance_rx_ucast_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double recvd_ucast_packets_acc);
+void evel_free_state_change(EVENT_STATE_CHANGE * const state_change);
+
 /**************************************************************************//**
- * Set the Delta Unicast packets Received in measurement interval
- * property of the vNIC performance.
+ * Set the Event Type property of the State Change.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param recvd_ucast_packets_delta
+ * @param state_change  Pointer to the ::EVENT_STATE_CHANGE.
+ * @param type          The Event Type to be set. ASCIIZ string. The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
  *****************************************************************************/
-void evel_vnic_performance_rx_ucast_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double recvd_ucast_packets_delta);
+void evel_state_change_type_set(EVENT_STATE_CHANGE * const state_change,
+                                const char * const type);
+
 /**************************************************************************//**
- * Set the Transmitted Broadcast Packets in measurement interval
- * property of the vNIC performance.
+ * Add an additional field name/value pair to the State Change.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * The name and value are null delimited ASCII strings.  The library takes
+ * a copy so the caller does not have to preserve values after the function
+ * returns.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param tx_bcast_packets_acc
+ * @param state_change  Pointer to the ::EVENT_STATE_CHANGE.
+ * @param name          ASCIIZ string with the attribute's name.  The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
+ * @param value         ASCIIZ string with the attribute's value.  The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
  *****************************************************************************/
-void evel_vnic_performance_tx_bcast_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double tx_bcast_packets_acc);
+void evel_state_change_addl_field_add(EVENT_STATE_CHANGE * const state_change,
+                                      const char * const name,
+                                      const char * const value);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   SYSLOG                                                                  */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
 /**************************************************************************//**
- * Set the Delta Broadcast packets Transmitted in measurement interval
- * property of the vNIC performance.
+ * Create a new syslog event.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @note    The mandatory fields on the Syslog must be supplied to this factory
+ *          function and are immutable once set.  Optional fields have explicit
+ *          setter functions, but again values may only be set once so that the
+ *          Syslog has immutable properties.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param tx_bcast_packets_delta
+ * @param event_name    Unique Event Name
+ * @param event_id    A universal identifier of the event for analysis etc
+ * @param   event_source_type
+ * @param   syslog_msg
+ * @param   syslog_tag
+ * @param   version
+ *
+ * @returns pointer to the newly manufactured ::EVENT_SYSLOG.  If the event is
+ *          not used it must be released using ::evel_free_syslog
+ * @retval  NULL  Failed to create the event.
  *****************************************************************************/
-void evel_vnic_performance_tx_bcast_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double tx_bcast_packets_delta);
+EVENT_SYSLOG * evel_new_syslog(const char* ev_name, const char *ev_id,
+				EVEL_SOURCE_TYPES event_source_type,
+                               const char * const syslog_msg,
+                               const char * const syslog_tag);
+
 /**************************************************************************//**
- * Set the Transmitted Discarded Packets in measurement interval
- * property of the vNIC performance.
+ * Set the Event Type property of the Syslog.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param tx_discarded_packets_acc
+ * @param syslog      Pointer to the syslog.
+ * @param type        The Event Type to be set. ASCIIZ string. The caller
+ *                    does not need to preserve the value once the function
+ *                    returns.
  *****************************************************************************/
-void evel_vnic_performance_tx_discarded_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double tx_discarded_packets_acc);
+void evel_syslog_type_set(EVENT_SYSLOG * syslog,
+                          const char * const type);
+
 /**************************************************************************//**
- * Set the Delta Discarded packets Transmitted in measurement interval
- * property of the vNIC performance.
+ * Free a Syslog.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Free off the Syslog supplied.  Will free all the contained allocated memory.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param tx_discarded_packets_delta
+ * @note It does not free the Syslog itself, since that may be part of a
+ * larger structure.
  *****************************************************************************/
-void evel_vnic_performance_tx_discarded_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double tx_discarded_packets_delta);
+void evel_free_syslog(EVENT_SYSLOG * event);
+
 /**************************************************************************//**
- * Set the Transmitted Errored Packets in measurement interval
- * property of the vNIC performance.
+ * Add an additional field name/value pair to the Syslog.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * The name and value are null delimited ASCII strings.  The library takes
+ * a copy so the caller does not have to preserve values after the function
+ * returns.  The pairs are encoded as additionalFields, "name=value"
+ * delimited by '|'.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param tx_error_packets_acc
+ * @param syslog    Pointer to the syslog.
+ * @param name      ASCIIZ string with the attribute's name.  The caller
+ *                  does not need to preserve the value once the function
+ *                  returns.
+ * @param value     ASCIIZ string with the attribute's value.  The caller
+ *                  does not need to preserve the value once the function
+ *                  returns.
  *****************************************************************************/
-void evel_vnic_performance_tx_error_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double tx_error_packets_acc);
+void evel_syslog_addl_field_add(EVENT_SYSLOG * syslog,
+                                char * name,
+                                char * value);
+
 /**************************************************************************//**
- * Set the Delta Errored packets Transmitted in measurement interval
- * property of the vNIC performance.
+ * Set the Event Source Host property of the Syslog.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param tx_error_packets_delta
+ * @param syslog      Pointer to the Syslog.
+ * @param host        The Event Source Host to be set.  ASCIIZ string. The
+ *                    caller does not need to preserve the value once the
+ *                    function returns.
  *****************************************************************************/
-void evel_vnic_performance_tx_error_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double tx_error_packets_delta);
+void evel_syslog_event_source_host_set(EVENT_SYSLOG * syslog,
+                                       const char * const host);
+
 /**************************************************************************//**
- * Set the Transmitted Multicast Packets in measurement interval
- * property of the vNIC performance.
+ * Set the Syslog Facility property of the Syslog.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param tx_mcast_packets_acc
+ * @param syslog      Pointer to the Syslog.
+ * @param facility    The Syslog Facility to be set.  ASCIIZ string. The caller
+ *                    does not need to preserve the value once the function
+ *                    returns.
  *****************************************************************************/
-void evel_vnic_performance_tx_mcast_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double tx_mcast_packets_acc);
+void evel_syslog_facility_set(EVENT_SYSLOG * syslog,
+                              EVEL_SYSLOG_FACILITIES facility);
+
 /**************************************************************************//**
- * Set the Delta Multicast packets Transmitted in measurement interval
- * property of the vNIC performance.
+ * Set the Process property of the Syslog.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param tx_mcast_packets_delta
+ * @param syslog      Pointer to the Syslog.
+ * @param proc        The Process to be set.  ASCIIZ string. The caller does
+ *                    not need to preserve the value once the function returns.
  *****************************************************************************/
-void evel_vnic_performance_tx_mcast_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double tx_mcast_packets_delta);
+void evel_syslog_proc_set(EVENT_SYSLOG * syslog, const char * const proc);
+
 /**************************************************************************//**
- * Set the Transmitted Octets in measurement interval
- * property of the vNIC performance.
+ * Set the Process ID property of the Syslog.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param tx_octets_acc
+ * @param syslog      Pointer to the Syslog.
+ * @param proc_id     The Process ID to be set.
  *****************************************************************************/
-void evel_vnic_performance_tx_octets_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double tx_octets_acc);
+void evel_syslog_proc_id_set(EVENT_SYSLOG * syslog, int proc_id);
+
 /**************************************************************************//**
- * Set the Delta Octets Transmitted in measurement interval
- * property of the vNIC performance.
+ * Set the Version property of the Syslog.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param tx_octets_delta
+ * @param syslog      Pointer to the Syslog.
+ * @param version     The Version to be set.
  *****************************************************************************/
-void evel_vnic_performance_tx_octets_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double tx_octets_delta);
+void evel_syslog_version_set(EVENT_SYSLOG * syslog, int version);
+
 /**************************************************************************//**
- * Set the Transmitted Total Packets in measurement interval
- * property of the vNIC performance.
+ * Set the Structured Data property of the Syslog.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param tx_total_packets_acc
+ * @param syslog      Pointer to the Syslog.
+ * @param s_data      The Structured Data to be set.  ASCIIZ string. The caller
+ *                    does not need to preserve the value once the function
+ *                    returns.
  *****************************************************************************/
-void evel_vnic_performance_tx_total_pkt_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double tx_total_packets_acc);
+void evel_syslog_s_data_set(EVENT_SYSLOG * syslog, const char * const s_data);
+
 /**************************************************************************//**
- * Set the Delta Total Packets Transmitted in measurement interval
- * property of the vNIC performance.
+ * Set the Structured SDID property of the Syslog.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param tx_total_packets_delta
+ * @param syslog     Pointer to the Syslog.
+ * @param sdid     The Structured Data to be set. ASCIIZ string. name@number
+ *                 Caller does not need to preserve the value once the function
+ *                   returns.
  *****************************************************************************/
-void evel_vnic_performance_tx_total_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double tx_total_packets_delta);
+void evel_syslog_sdid_set(EVENT_SYSLOG * syslog, const char * const sdid);
+
 /**************************************************************************//**
- * Set the Transmitted Unicast Packets in measurement interval
- * property of the vNIC performance.
+ * Set the Structured Severity property of the Syslog.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param tx_ucast_packets_acc
+ * @param syslog     Pointer to the Syslog.
+ * @param sdid     The Structured Data to be set. ASCIIZ string. 
+ *                 Caller does not need to preserve the value once the function
+ *                   returns.
  *****************************************************************************/
-void evel_vnic_performance_tx_ucast_packets_acc_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double tx_ucast_packets_acc);
+void evel_syslog_severity_set(EVENT_SYSLOG * syslog, const char * const severty);
+
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   OTHER                                                                   */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/**************************************************************************//**
+ * Create a new other event.
+ *
+ * @param event_name    Unique Event Name
+ * @param event_id    A universal identifier of the event for analysis etc
+ *
+ * @returns pointer to the newly manufactured ::EVENT_OTHER.  If the event is
+ *          not used it must be released using ::evel_free_other.
+ * @retval  NULL  Failed to create the event.
+ *****************************************************************************/
+EVENT_OTHER * evel_new_other(const char* ev_name, const char *ev_id);
+
+/**************************************************************************//**
+ * Free an Other.
+ *
+ * Free off the Other supplied.  Will free all the contained allocated memory.
+ *
+ * @note It does not free the Other itself, since that may be part of a
+ * larger structure.
+ *****************************************************************************/
+void evel_free_other(EVENT_OTHER * event);
+
 /**************************************************************************//**
- * Set the Delta Octets Transmitted in measurement interval
- * property of the vNIC performance.
+ * Set the Event Type property of the Other.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param vnic_performance      Pointer to the vNIC Use.
- * @param tx_ucast_packets_delta
- *****************************************************************************/
-void evel_vnic_performance_tx_ucast_pkt_delta_set(MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
-                                    const double tx_ucast_packets_delta);
-
-/**************************************************************************//**
- * Add an additional vNIC Use to the specified Measurement event.
- *
- * @param measurement   Pointer to the measurement.
- * @param vnic_performance      Pointer to the vNIC Use to add.
+ * @param other       Pointer to the Other.
+ * @param type        The Event Type to be set. ASCIIZ string. The caller
+ *                    does not need to preserve the value once the function
+ *                    returns.
  *****************************************************************************/
-void evel_meas_vnic_performance_add(EVENT_MEASUREMENT * const measurement,
-                            MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance);
+void evel_other_type_set(EVENT_OTHER * other,
+                         const char * const type);
 
 /**************************************************************************//**
- * Add an additional vNIC usage record Measurement.
- *
- * This function implements the previous API, purely for convenience.
+ * Add a value name/value pair to the Other.
  *
- * The ID is null delimited ASCII string.  The library takes a copy so the
- * caller does not have to preserve values after the function returns.
+ * The name and value are null delimited ASCII strings.  The library takes
+ * a copy so the caller does not have to preserve values after the function
+ * returns.
  *
- * @param measurement           Pointer to the measurement.
- * @param vnic_id               ASCIIZ string with the vNIC's ID.
- * @param valset                true or false confidence level
- * @param recvd_bcast_packets_acc         Recieved broadcast packets
- * @param recvd_bcast_packets_delta       Received delta broadcast packets
- * @param recvd_discarded_packets_acc     Recieved discarded packets
- * @param recvd_discarded_packets_delta   Received discarded delta packets
- * @param recvd_error_packets_acc         Received error packets
- * @param recvd_error_packets_delta,      Received delta error packets
- * @param recvd_mcast_packets_acc         Received multicast packets
- * @param recvd_mcast_packets_delta       Received delta multicast packets
- * @param recvd_octets_acc                Received octets
- * @param recvd_octets_delta              Received delta octets
- * @param recvd_total_packets_acc         Received total packets
- * @param recvd_total_packets_delta       Received delta total packets
- * @param recvd_ucast_packets_acc         Received Unicast packets
- * @param recvd_ucast_packets_delta       Received delta unicast packets
- * @param tx_bcast_packets_acc            Transmitted broadcast packets
- * @param tx_bcast_packets_delta          Transmitted delta broadcast packets
- * @param tx_discarded_packets_acc        Transmitted packets discarded
- * @param tx_discarded_packets_delta      Transmitted delta discarded packets
- * @param tx_error_packets_acc            Transmitted error packets
- * @param tx_error_packets_delta          Transmitted delta error packets
- * @param tx_mcast_packets_acc            Transmitted multicast packets accumulated
- * @param tx_mcast_packets_delta          Transmitted delta multicast packets
- * @param tx_octets_acc                   Transmitted octets
- * @param tx_octets_delta                 Transmitted delta octets
- * @param tx_total_packets_acc            Transmitted total packets
- * @param tx_total_packets_delta          Transmitted delta total packets
- * @param tx_ucast_packets_acc            Transmitted Unicast packets
- * @param tx_ucast_packets_delta          Transmitted delta Unicast packets
+ * @param other     Pointer to the Other.
+ * @param name      ASCIIZ string with the attribute's name.
+ * @param value     ASCIIZ string with the attribute's value.
  *****************************************************************************/
-void evel_measurement_vnic_performance_add(EVENT_MEASUREMENT * const measurement,
-                               char * const vnic_id,
-                               char * valset,
-                               double recvd_bcast_packets_acc,
-                               double recvd_bcast_packets_delta,
-                               double recvd_discarded_packets_acc,
-                               double recvd_discarded_packets_delta,
-                               double recvd_error_packets_acc,
-                               double recvd_error_packets_delta,
-                               double recvd_mcast_packets_acc,
-                               double recvd_mcast_packets_delta,
-                               double recvd_octets_acc,
-                               double recvd_octets_delta,
-                               double recvd_total_packets_acc,
-                               double recvd_total_packets_delta,
-                               double recvd_ucast_packets_acc,
-                               double recvd_ucast_packets_delta,
-                               double tx_bcast_packets_acc,
-                               double tx_bcast_packets_delta,
-                               double tx_discarded_packets_acc,
-                               double tx_discarded_packets_delta,
-                               double tx_error_packets_acc,
-                               double tx_error_packets_delta,
-                               double tx_mcast_packets_acc,
-                               double tx_mcast_packets_delta,
-                               double tx_octets_acc,
-                               double tx_octets_delta,
-                               double tx_total_packets_acc,
-                               double tx_total_packets_delta,
-                               double tx_ucast_packets_acc,
-                               double tx_ucast_packets_delta);
+void evel_other_field_add(EVENT_OTHER * other,
+                          char * name,
+                          char * value);
 
 /*****************************************************************************/
 /*****************************************************************************/
 /*                                                                           */
-/*   REPORT                                                                  */
+/*   THROTTLING                                                              */
 /*                                                                           */
 /*****************************************************************************/
 /*****************************************************************************/
 
 /**************************************************************************//**
- * Create a new Report event.
+ * Return the current measurement interval provided by the Event Listener.
  *
- * @note    The mandatory fields on the Report must be supplied to this
- *          factory function and are immutable once set.  Optional fields have
- *          explicit setter functions, but again values may only be set once so
- *          that the Report has immutable properties.
+ * @returns The current measurement interval
+ * @retval  EVEL_MEASUREMENT_INTERVAL_UKNOWN (0) - interval has not been
+ *          specified
+ *****************************************************************************/
+int evel_get_measurement_interval();
+
+/*****************************************************************************/
+/* Supported Report version.                                                 */
+/*****************************************************************************/
+#define EVEL_VOICEQ_MAJOR_VERSION 1
+#define EVEL_VOICEQ_MINOR_VERSION 0
+
+/**************************************************************************//**
+ * End of Call Voice Quality Metrices
+ * JSON equivalent field: endOfCallVqmSummaries
+ *****************************************************************************/
+typedef struct end_of_call_vqm_summaries {
+	/***************************************************************************/
+	/* Mandatory fields                                                        */
+	/***************************************************************************/
+	char* adjacencyName;
+	char* endpointDescription;
+
+	/***************************************************************************/
+	/* Optional fields                                                         */
+	/***************************************************************************/
+	EVEL_OPTION_INT endpointJitter;
+	EVEL_OPTION_INT endpointRtpOctetsDiscarded;
+	EVEL_OPTION_INT endpointRtpOctetsReceived;
+	EVEL_OPTION_INT endpointRtpOctetsSent;
+	EVEL_OPTION_INT endpointRtpPacketsDiscarded;
+	EVEL_OPTION_INT endpointRtpPacketsReceived;
+	EVEL_OPTION_INT endpointRtpPacketsSent;
+	EVEL_OPTION_INT localJitter;
+	EVEL_OPTION_INT localRtpOctetsDiscarded;
+	EVEL_OPTION_INT localRtpOctetsReceived;
+	EVEL_OPTION_INT localRtpOctetsSent;
+	EVEL_OPTION_INT localRtpPacketsDiscarded;
+	EVEL_OPTION_INT localRtpPacketsReceived;
+	EVEL_OPTION_INT localRtpPacketsSent;
+	EVEL_OPTION_INT mosCqe;
+	EVEL_OPTION_INT packetsLost;
+	EVEL_OPTION_INT packetLossPercent;
+	EVEL_OPTION_INT rFactor;
+	EVEL_OPTION_INT roundTripDelay;
+
+} END_OF_CALL_VOICE_QUALITY_METRICS;
+
+/**************************************************************************//**
+* Voice QUality.
+* JSON equivalent field: voiceQualityFields
+*****************************************************************************/
+
+typedef struct event_voiceQuality {
+	/***************************************************************************/
+	/* Header and version                                                      */
+	/***************************************************************************/
+	EVENT_HEADER header;
+	int major_version;
+	int minor_version;
+
+	/***************************************************************************/
+	/* Mandatory fields                                                        */
+	/***************************************************************************/
+	
+	char *calleeSideCodec;
+	char *callerSideCodec;
+	char *correlator;
+	char *midCallRtcp;
+	VENDOR_VNFNAME_FIELD vendorVnfNameFields;
+	END_OF_CALL_VOICE_QUALITY_METRICS *endOfCallVqmSummaries;
+
+	/***************************************************************************/
+	/* Optional fields                                                         */
+	/***************************************************************************/
+	EVEL_OPTION_STRING phoneNumber;
+	DLIST additionalInformation;
+
+} EVENT_VOICE_QUALITY;
+/**************************************************************************//**
+ * Voice Quality Additional Info.
+ * JSON equivalent field: additionalInformation
+ *****************************************************************************/
+typedef struct voice_quality_additional_info {
+  char * name;
+  char * value;
+} VOICE_QUALITY_ADDL_INFO;
+
+/**************************************************************************//**
+ * Create a new voice quality event.
  *
- * @param   measurement_interval
+ * @note    The mandatory fields on the Voice Quality must be supplied to this 
+ *          factory function and are immutable once set.  Optional fields have 
+ *          explicit setter functions, but again values may only be set once 
+ *          so that the Voice Quality has immutable properties.
  * @param event_name    Unique Event Name
  * @param event_id    A universal identifier of the event for analysis etc
+ * @param   calleeSideCodec			Callee codec for the call.
+ * @param   callerSideCodec			Caller codec for the call.
+ * @param   correlator				Constant across all events on this call.
+ * @param   midCallRtcp				Base64 encoding of the binary RTCP data
+ *									(excluding Eth/IP/UDP headers).
+ * @param   vendorVnfNameFields		Vendor, VNF and VfModule names.
+ * @returns pointer to the newly manufactured ::EVENT_VOICE_QUALITY.  If the 
+ *          event is not used (i.e. posted) it must be released using
+			::evel_free_voice_quality.
+ * @retval  NULL  Failed to create the event.
+ *****************************************************************************/
+EVENT_VOICE_QUALITY * evel_new_voice_quality(const char* ev_name, const char *ev_id,
+	const char * const calleeSideCodec,
+	const char * const callerSideCodec, const char * const correlator,
+	const char * const midCallRtcp, const char * const vendorVnfNameFields);
+
+/**************************************************************************//**
+ * Set the Callee side codec for Call for domain Voice Quality
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param voiceQuality				Pointer to the Voice Quality Event.
+ * @param calleeCodecForCall		The Callee Side Codec to be set.  ASCIIZ 
+ *									string. The caller does not need to 
+ *									preserve the value once the function
+ *									returns.
+ *****************************************************************************/
+void evel_voice_quality_callee_codec_set(EVENT_VOICE_QUALITY * voiceQuality,
+									const char * const calleeCodecForCall);
+
+/**************************************************************************//**
+ * Set the Caller side codec for Call for domain Voice Quality
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
+ *
+ * @param voiceQuality				Pointer to the Voice Quality Event.
+ * @param callerCodecForCall		The Caller Side Codec to be set.  ASCIIZ 
+ *									string. The caller does not need to 
+ *									preserve the value once the function
+ *									returns.
+ *****************************************************************************/
+void evel_voice_quality_caller_codec_set(EVENT_VOICE_QUALITY * voiceQuality,
+									const char * const callerCodecForCall);
+
+/**************************************************************************//**
+ * Set the correlator for domain Voice Quality
+ *
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @returns pointer to the newly manufactured ::EVENT_REPORT.  If the event is
- *          not used (i.e. posted) it must be released using
- *          ::evel_free_report.
- * @retval  NULL  Failed to create the event.
+ * @param voiceQuality				Pointer to the Voice Quality Event.
+ * @param correlator				The correlator value to be set.  ASCIIZ 
+ *									string. The caller does not need to 
+ *									preserve the value once the function
+ *									returns.
  *****************************************************************************/
-EVENT_REPORT * evel_new_report(double measurement_interval,const char* ev_name, const char *ev_id);
+void evel_voice_quality_correlator_set(EVENT_VOICE_QUALITY * voiceQuality,
+									const char * const vCorrelator);
 
 /**************************************************************************//**
- * Free a Report.
+ * Set the RTCP Call Data for domain Voice Quality
  *
- * Free off the Report supplied.  Will free all the contained allocated memory.
+ * @note  The property is treated as immutable: it is only valid to call
+ *        the setter once.  However, we don't assert if the caller tries to
+ *        overwrite, just ignoring the update instead.
  *
- * @note It does not free the Report itself, since that may be part of a
- * larger structure.
+ * @param voiceQuality				Pointer to the Voice Quality Event.
+ * @param rtcpCallData		        The RTCP Call Data to be set.  ASCIIZ 
+ *									string. The caller does not need to 
+ *									preserve the value once the function
+ *									returns.
  *****************************************************************************/
-void evel_free_report(EVENT_REPORT * event);
+void evel_voice_quality_rtcp_data_set(EVENT_VOICE_QUALITY * voiceQuality,
+									const char * const rtcpCallData);
 
 /**************************************************************************//**
- * Set the Event Type property of the Report.
+ * Set the Vendor VNF Name fields for domain Voice Quality
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param report Pointer to the Report.
- * @param type        The Event Type to be set. ASCIIZ string. The caller
- *                    does not need to preserve the value once the function
- *                    returns.
+ * @param voiceQuality				Pointer to the Voice Quality Event.
+ * @param nameFields		        The Vendor, VNF and VfModule names to be set.   
+ *									ASCIIZ string. The caller does not need to 
+ *									preserve the value once the function
+ *									returns.
  *****************************************************************************/
-void evel_report_type_set(EVENT_REPORT * report, const char * const type);
+void evel_voice_quality_name_fields_set(EVENT_VOICE_QUALITY * voiceQuality,
+									const char * const nameFields);
 
 /**************************************************************************//**
- * Add a Feature usage value name/value pair to the Report.
+ * Add an End of Call Voice Quality Metrices
+
+ * The adjacencyName and endpointDescription is null delimited ASCII string.  
+ * The library takes a copy so the caller does not have to preserve values
+ * after the function returns.
  *
- * The name is null delimited ASCII string.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * @param voiceQuality     Pointer to the measurement.
+ * @param adjacencyName						Adjacency name
+ * @param endpointDescription				Enumeration: ‘Caller’, ‘Callee’.
+ * @param endpointJitter					Endpoint jitter
+ * @param endpointRtpOctetsDiscarded        Endpoint RTP octets discarded.
+ * @param endpointRtpOctetsReceived			Endpoint RTP octets received.
+ * @param endpointRtpOctetsSent				Endpoint RTP octets sent
+ * @param endpointRtpPacketsDiscarded		Endpoint RTP packets discarded.
+ * @param endpointRtpPacketsReceived		Endpoint RTP packets received.
+ * @param endpointRtpPacketsSent			Endpoint RTP packets sent.
+ * @param localJitter						Local jitter.
+ * @param localRtpOctetsDiscarded			Local RTP octets discarded.
+ * @param localRtpOctetsReceived			Local RTP octets received.
+ * @param localRtpOctetsSent				Local RTP octets sent.
+ * @param localRtpPacketsDiscarded			Local RTP packets discarded.
+ * @param localRtpPacketsReceived			Local RTP packets received.
+ * @param localRtpPacketsSent				Local RTP packets sent.
+ * @param mosCqe							Decimal range from 1 to 5
+ *											(1 decimal place)
+ * @param packetsLost						No	Packets lost
+ * @param packetLossPercent					Calculated percentage packet loss 
+ * @param rFactor							rFactor from 0 to 100
+ * @param roundTripDelay					Round trip delay in milliseconds
+ *****************************************************************************/
+void evel_voice_quality_end_metrics_add(EVENT_VOICE_QUALITY * voiceQuality,
+	const char * adjacencyName, EVEL_SERVICE_ENDPOINT_DESC endpointDescription,
+	int endpointJitter,
+	int endpointRtpOctetsDiscarded,
+	int endpointRtpOctetsReceived,
+	int endpointRtpOctetsSent,
+	int endpointRtpPacketsDiscarded,
+	int endpointRtpPacketsReceived,
+	int endpointRtpPacketsSent,
+	int localJitter,
+	int localRtpOctetsDiscarded,
+	int localRtpOctetsReceived,
+	int localRtpOctetsSent,
+	int localRtpPacketsDiscarded,
+	int localRtpPacketsReceived,
+	int localRtpPacketsSent,
+	int mosCqe,
+	int packetsLost,
+	int packetLossPercent,
+	int rFactor,
+	int roundTripDelay);
+
+/**************************************************************************//**
+ * Free a Voice Quality.
  *
- * @param report          Pointer to the report.
- * @param feature         ASCIIZ string with the feature's name.
- * @param utilization     Utilization of the feature.
+ * Free off the Voce Quality supplied.  Will free all the contained allocated
+ * memory.
+ *
+ * @note It does not free the Voice Quality itself, since that may be part of a
+ * larger structure.
  *****************************************************************************/
-void evel_report_feature_use_add(EVENT_REPORT * report,
-                                 char * feature,
-                                 int utilization);
+void evel_free_voice_quality(EVENT_VOICE_QUALITY * voiceQuality);
 
 /**************************************************************************//**
- * Add a Additional Measurement value name/value pair to the Report.
+ * Add an additional value name/value pair to the Voice Quality.
  *
- * The name is null delimited ASCII string.  The library takes
+ * The name and value are null delimited ASCII strings.  The library takes
  * a copy so the caller does not have to preserve values after the function
  * returns.
  *
- * @param report   Pointer to the report.
- * @param group    ASCIIZ string with the measurement group's name.
- * @param name     ASCIIZ string containing the measurement's name.
- * @param value    ASCIIZ string containing the measurement's value.
+ * @param fault     Pointer to the fault.
+ * @param name      ASCIIZ string with the attribute's name.  The caller
+ *                  does not need to preserve the value once the function
+ *                  returns.
+ * @param value     ASCIIZ string with the attribute's value.  The caller
+ *                  does not need to preserve the value once the function
+ *                  returns.
  *****************************************************************************/
-void evel_report_custom_measurement_add(EVENT_REPORT * report,
-                                        const char * const group,
-                                        const char * const name,
-                                        const char * const value);
+void evel_voice_quality_addl_info_add(EVENT_VOICE_QUALITY * voiceQuality, char * name, char * value);
+
 
 /*****************************************************************************/
 /*****************************************************************************/
 /*                                                                           */
-/*   MOBILE_FLOW                                                             */
+/*   THRESHOLD CROSSING ALERT                                                */
 /*                                                                           */
 /*****************************************************************************/
 /*****************************************************************************/
 
-/**************************************************************************//**
- * Create a new Mobile Flow event.
- *
- * @note    The mandatory fields on the Mobile Flow must be supplied to this
- *          factory function and are immutable once set.  Optional fields have
- *          explicit setter functions, but again values may only be set once so
- *          that the Mobile Flow has immutable properties.
- *
- * @param event_name    Unique Event Name
- * @param event_id    A universal identifier of the event for analysis etc
- * @param   flow_direction
- * @param   gtp_per_flow_metrics
- * @param   ip_protocol_type
- * @param   ip_version
- * @param   other_endpoint_ip_address
- * @param   other_endpoint_port
- * @param   reporting_endpoint_ip_addr
- * @param   reporting_endpoint_port
- *
- * @returns pointer to the newly manufactured ::EVENT_MOBILE_FLOW.  If the
- *          event is not used (i.e. posted) it must be released using
- *          ::evel_free_mobile_flow.
- * @retval  NULL  Failed to create the event.
- *****************************************************************************/
-EVENT_MOBILE_FLOW * evel_new_mobile_flow(
-		      const char* ev_name, const char *ev_id,
-                      const char * const flow_direction,
-                      MOBILE_GTP_PER_FLOW_METRICS * gtp_per_flow_metrics,
-                      const char * const ip_protocol_type,
-                      const char * const ip_version,
-                      const char * const other_endpoint_ip_address,
-                      int other_endpoint_port,
-                      const char * const reporting_endpoint_ip_addr,
-                      int reporting_endpoint_port);
+typedef enum evel_event_action {
+	  EVEL_EVENT_ACTION_CLEAR,
+	  EVEL_EVENT_ACTION_CONTINUE,
+	  EVEL_EVENT_ACTION_SET,
+	  EVEL_MAX_EVENT_ACTION
+}EVEL_EVENT_ACTION;
+	
+typedef enum evel_alert_type {
+         EVEL_CARD_ANOMALY, 
+   	 EVEL_ELEMENT_ANOMALY, 
+    	 EVEL_INTERFACE_ANOMALY, 
+    	 EVEL_SERVICE_ANOMALY,
+         EVEL_MAX_ANOMALY
+}EVEL_ALERT_TYPE;
 
-/**************************************************************************//**
- * Free a Mobile Flow.
- *
- * Free off the Mobile Flow supplied.  Will free all the contained allocated
- * memory.
- *
- * @note It does not free the Mobile Flow itself, since that may be part of a
- * larger structure.
- *****************************************************************************/
-void evel_free_mobile_flow(EVENT_MOBILE_FLOW * event);
+
+typedef struct perf_counter {
+	char * criticality;
+	char * name;
+	char * thresholdCrossed;
+	char * value;
+}PERF_COUNTER;
+
+
+/*****************************************************************************/
+/* Supported Threshold Crossing version.                                     */
+/*****************************************************************************/
+#define EVEL_THRESHOLD_CROSS_MAJOR_VERSION 2
+#define EVEL_THRESHOLD_CROSS_MINOR_VERSION 0
 
 /**************************************************************************//**
- * Set the Event Type property of the Mobile Flow.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
- *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param type        The Event Type to be set. ASCIIZ string. The caller
- *                    does not need to preserve the value once the function
- *                    returns.
+ * Threshold Crossing.
+ * JSON equivalent field: Threshold Cross Fields
  *****************************************************************************/
-void evel_mobile_flow_type_set(EVENT_MOBILE_FLOW * mobile_flow,
-                               const char * const type);
+typedef struct event_threshold_cross {
+  /***************************************************************************/
+  /* Header and version                                                      */
+  /***************************************************************************/
+  EVENT_HEADER header;
+  int major_version;
+  int minor_version;
+
+  /***************************************************************************/
+  /* Mandatory fields                                                        */
+  /***************************************************************************/
+  PERF_COUNTER additionalParameters;
+  EVEL_EVENT_ACTION  alertAction;
+  char *             alertDescription; 
+  EVEL_ALERT_TYPE    alertType;
+  unsigned long long collectionTimestamp; 
+  EVEL_SEVERITIES    eventSeverity;
+  unsigned long long eventStartTimestamp;
+
+  /***************************************************************************/
+  /* Optional fields                                                         */
+  /***************************************************************************/
+  DLIST additional_info;
+  EVEL_OPTION_STRING    alertValue;
+  DLIST     alertidList;
+  EVEL_OPTION_STRING    dataCollector;
+  EVEL_OPTION_STRING    elementType;
+  EVEL_OPTION_STRING    interfaceName;
+  EVEL_OPTION_STRING    networkService;
+  EVEL_OPTION_STRING    possibleRootCause;
+
+} EVENT_THRESHOLD_CROSS;
+
 
 /**************************************************************************//**
- * Set the Application Type property of the Mobile Flow.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Create a new Threshold Crossing Alert event.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param type        The Application Type to be set. ASCIIZ string. The caller
- *                    does not need to preserve the value once the function
- *                    returns.
- *****************************************************************************/
-void evel_mobile_flow_app_type_set(EVENT_MOBILE_FLOW * mobile_flow,
-                                   const char * const type);
-
-/**************************************************************************//**
- * Set the Application Protocol Type property of the Mobile Flow.
+ * @note    The mandatory fields on the TCA must be supplied to this factory
+ *          function and are immutable once set.  Optional fields have explicit
+ *          setter functions, but again values may only be set once so that the
+ *          TCA has immutable properties.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param event_name    Unique Event Name
+ * @param event_id    A universal identifier of the event for analysis etc
+ * @param char* tcriticality   Performance Counter Criticality MAJ MIN,
+ * @param char* tname          Performance Counter Threshold name
+ * @param char* tthresholdCrossed  Counter Threshold crossed value
+ * @param char* tvalue             Counter actual value
+ * @param EVEL_EVENT_ACTION talertAction   Alert set continue or clear
+ * @param char*  talertDescription
+ * @param EVEL_ALERT_TYPE     talertType    Kind of anamoly
+ * @param unsigned long long  tcollectionTimestamp time at which alert was collected
+ * @param EVEL_SEVERITIES     teventSeverity  Severity of Alert
+ * @param unsigned long long  teventStartTimestamp Time when this alert started
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param type        The Application Protocol Type to be set. ASCIIZ string.
- *                    The caller does not need to preserve the value once the
- *                    function returns.
+ * @returns pointer to the newly manufactured ::EVENT_THRESHOLD_CROSS.  If the
+ *          event is not used it must be released using
+ *          ::evel_free_threshold_cross
+ * @retval  NULL  Failed to create the event.
  *****************************************************************************/
-void evel_mobile_flow_app_prot_type_set(EVENT_MOBILE_FLOW * mobile_flow,
-                                        const char * const type);
+EVENT_THRESHOLD_CROSS * evel_new_threshold_cross(
+				const char* ev_name, const char *ev_id,
+                               char * tcriticality,
+	                       char * tname,
+	                       char * tthresholdCrossed,
+	                       char * tvalue,
+                               EVEL_EVENT_ACTION  talertAction,
+                               char *             talertDescription, 
+                               EVEL_ALERT_TYPE    talertType,
+                               unsigned long long tcollectionTimestamp, 
+                               EVEL_SEVERITIES    teventSeverity,
+                               unsigned long long teventStartTimestamp);
 
 /**************************************************************************//**
- * Set the Application Protocol Version property of the Mobile Flow.
+ * Free a Threshold cross event.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Free off the Threshold crossing event supplied.  Will free all the contained allocated
+ * memory.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param version     The Application Protocol Version to be set. ASCIIZ
- *                    string.  The caller does not need to preserve the value
- *                    once the function returns.
+ * @note It does not free the Threshold Cross itself, since that may be part of a
+ * larger structure.
  *****************************************************************************/
-void evel_mobile_flow_app_prot_ver_set(EVENT_MOBILE_FLOW * mobile_flow,
-                                       const char * const version);
+void evel_free_threshold_cross(EVENT_THRESHOLD_CROSS * const tcp);
 
 /**************************************************************************//**
- * Set the CID property of the Mobile Flow.
+ * Set the Event Type property of the Threshold Cross.
  *
  * @note  The property is treated as immutable: it is only valid to call
  *        the setter once.  However, we don't assert if the caller tries to
  *        overwrite, just ignoring the update instead.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param cid         The CID to be set. ASCIIZ string.  The caller does not
- *                    need to preserve the value once the function returns.
+ * @param tcp  Pointer to the ::EVENT_THRESHOLD_CROSS.
+ * @param type          The Event Type to be set. ASCIIZ string. The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
  *****************************************************************************/
-void evel_mobile_flow_cid_set(EVENT_MOBILE_FLOW * mobile_flow,
-                              const char * const cid);
+void evel_threshold_cross_type_set(EVENT_THRESHOLD_CROSS * const tcp, char * type);
 
 /**************************************************************************//**
- * Set the Connection Type property of the Mobile Flow.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Add an optional additional alertid value to Alert.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param type        The Connection Type to be set. ASCIIZ string. The caller
- *                    does not need to preserve the value once the function
- *                    returns.
+ * @param alertid  Adds Alert ID
  *****************************************************************************/
-void evel_mobile_flow_con_type_set(EVENT_MOBILE_FLOW * mobile_flow,
-                                   const char * const type);
+void evel_threshold_cross_alertid_add(EVENT_THRESHOLD_CROSS * const event,char *  alertid);
 
-/**************************************************************************//**
- * Set the ECGI property of the Mobile Flow.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
- *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param ecgi        The ECGI to be set. ASCIIZ string.  The caller does not
- *                    need to preserve the value once the function returns.
- *****************************************************************************/
-void evel_mobile_flow_ecgi_set(EVENT_MOBILE_FLOW * mobile_flow,
-                               const char * const ecgi);
+  /**************************************************************************//**
+   * Set the TCA probable Root cause.
+   *
+   * @param sheader     Possible root cause to Threshold
+   *****************************************************************************/
+  void evel_threshold_cross_possible_rootcause_set(EVENT_THRESHOLD_CROSS * const event, char *  sheader);
+  /**************************************************************************//**
+   * Set the TCA networking cause.
+   *
+   * @param sheader     Possible networking service value to Threshold
+   *****************************************************************************/
+  void evel_threshold_cross_networkservice_set(EVENT_THRESHOLD_CROSS * const event, char *  sheader);
+  /**************************************************************************//**
+   * Set the TCA Interface name.
+   *
+   * @param sheader     Interface name to threshold
+   *****************************************************************************/
+  void evel_threshold_cross_interfacename_set(EVENT_THRESHOLD_CROSS * const event,char *  sheader);
+  /**************************************************************************//**
+   * Set the TCA Data element type.
+   *
+   * @param sheader     element type of Threshold
+   *****************************************************************************/
+  void evel_threshold_cross_data_elementtype_set(EVENT_THRESHOLD_CROSS * const event,char *  sheader);
+  /**************************************************************************//**
+   * Set the TCA Data collector value.
+   *
+   * @param sheader     Data collector value
+   *****************************************************************************/
+  void evel_threshold_cross_data_collector_set(EVENT_THRESHOLD_CROSS * const event,char *  sheader);
+  /**************************************************************************//**
+   * Set the TCA alert value.
+   *
+   * @param sheader     Possible alert value
+   *****************************************************************************/
+  void evel_threshold_cross_alertvalue_set(EVENT_THRESHOLD_CROSS * const event,char *  sheader);
 
 /**************************************************************************//**
- * Set the GTP Protocol Type property of the Mobile Flow.
+ * Add an additional field name/value pair to the THRESHOLD CROSS event.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * The name and value are null delimited ASCII strings.  The library takes
+ * a copy so the caller does not have to preserve values after the function
+ * returns.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param type        The GTP Protocol Type to be set. ASCIIZ string.  The
- *                    caller does not need to preserve the value once the
- *                    function returns.
+ * @param state_change  Pointer to the ::EVENT_THRESHOLD_CROSS.
+ * @param name          ASCIIZ string with the attribute's name.  The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
+ * @param value         ASCIIZ string with the attribute's value.  The caller
+ *                      does not need to preserve the value once the function
+ *                      returns.
  *****************************************************************************/
-void evel_mobile_flow_gtp_prot_type_set(EVENT_MOBILE_FLOW * mobile_flow,
-                                        const char * const type);
+void evel_threshold_cross_addl_info_add(EVENT_THRESHOLD_CROSS * const tcp,
+                                      const char * const name,
+                                      const char * const value);
 
-/**************************************************************************//**
- * Set the GTP Protocol Version property of the Mobile Flow.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
- *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param version     The GTP Protocol Version to be set. ASCIIZ string.  The
- *                    caller does not need to preserve the value once the
- *                    function returns.
- *****************************************************************************/
-void evel_mobile_flow_gtp_prot_ver_set(EVENT_MOBILE_FLOW * mobile_flow,
-                                       const char * const version);
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   COUNTERS                                                                */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Counter width to use when it is not known whether a counter is 32 or     */
+/* 64 bits.                                                                  */
+/*****************************************************************************/
+#define EVEL_COUNTER_AUTO 0
 
 /**************************************************************************//**
- * Set the HTTP Header property of the Mobile Flow.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * A monotonically increasing counter, such as an interface octet count.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param header      The HTTP header to be set. ASCIIZ string. The caller does
- *                    not need to preserve the value once the function returns.
+ * value is the latest reading, which reporters send as the accumulated
+ * ("_acc") figure; delta is the increase since the reading before, allowing
+ * for the counter wrapping or being reset, and rate is delta per second of
+ * monotonic time.
  *****************************************************************************/
-void evel_mobile_flow_http_header_set(EVENT_MOBILE_FLOW * mobile_flow,
-                                      const char * const header);
+typedef struct evel_counter {
+  int width;
+  int valid;
+  int reset;
+  unsigned long long value;
+  unsigned long long timestamp;
+  unsigned long long delta;
+  double rate;
+} EVEL_COUNTER;
 
 /**************************************************************************//**
- * Set the IMEI property of the Mobile Flow.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Initialize a counter with no readings.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param imei        The IMEI to be set. ASCIIZ string.  The caller does not
- *                    need to preserve the value once the function returns.
+ * @param counter   The counter.
+ * @param width     Width of the counter in bits: 32, 64, or
+ *                  ::EVEL_COUNTER_AUTO if it is not known.
  *****************************************************************************/
-void evel_mobile_flow_imei_set(EVENT_MOBILE_FLOW * mobile_flow,
-                               const char * const imei);
+void evel_counter_init(EVEL_COUNTER * const counter, const int width);
 
 /**************************************************************************//**
- * Set the IMSI property of the Mobile Flow.
+ * Work out how much a counter has increased between two readings.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * A lower reading is a wrap if the earlier one was in the top half of the
+ * counter's range, otherwise a reset.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param imsi        The IMSI to be set. ASCIIZ string.  The caller does not
- *                    need to preserve the value once the function returns.
+ * @param previous  The earlier reading.
+ * @param current   The later reading.
+ * @param width     Width of the counter in bits: 32, 64, or
+ *                  ::EVEL_COUNTER_AUTO.
+ * @param[out] reset  Set non-zero if the counter appears to have been reset,
+ *                  in which case the increase is counted from zero.  May be
+ *                  NULL.
+ *
+ * @returns The increase.
  *****************************************************************************/
-void evel_mobile_flow_imsi_set(EVENT_MOBILE_FLOW * mobile_flow,
-                               const char * const imsi);
+unsigned long long evel_counter_delta(const unsigned long long previous,
+                                      const unsigned long long current,
+                                      const int width,
+                                      int * const reset);
 
 /**************************************************************************//**
- * Set the LAC property of the Mobile Flow.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Record a new reading of a counter, updating its delta and rate.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param lac         The LAC to be set. ASCIIZ string.  The caller does not
- *                    need to preserve the value once the function returns.
+ * @param counter   The counter.
+ * @param value     The new reading.
+ * @param timestamp When the reading was taken, in microseconds from
+ *                  evel_time_monotonic_usec().
  *****************************************************************************/
-void evel_mobile_flow_lac_set(EVENT_MOBILE_FLOW * mobile_flow,
-                              const char * const lac);
+void evel_counter_update(EVEL_COUNTER * const counter,
+                         const unsigned long long value,
+                         const unsigned long long timestamp);
 
-/**************************************************************************//**
- * Set the MCC property of the Mobile Flow.
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   INTERFACE STATISTICS                                                    */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Longest interface name, as IFNAMSIZ less the terminator.                  */
+/*****************************************************************************/
+#define EVEL_IF_NAME_MAX 15
+
+/*****************************************************************************/
+/* Default source of interface counters.                                     */
+/*****************************************************************************/
+#define EVEL_IF_PROC_NET_DEV "/proc/net/dev"
+
+/**************************************************************************//**
+ * Counters for one network interface, as accumulated by the kernel.
+ *****************************************************************************/
+typedef struct evel_if_stats {
+  char name[EVEL_IF_NAME_MAX + 1];
+  int present;
+  unsigned long long rx_bytes;
+  unsigned long long rx_packets;
+  unsigned long long rx_errors;
+  unsigned long long rx_dropped;
+  unsigned long long rx_fifo_errors;
+  unsigned long long rx_frame_errors;
+  unsigned long long rx_compressed;
+  unsigned long long rx_multicast;
+  unsigned long long tx_bytes;
+  unsigned long long tx_packets;
+  unsigned long long tx_errors;
+  unsigned long long tx_dropped;
+  unsigned long long tx_fifo_errors;
+  unsigned long long tx_collisions;
+  unsigned long long tx_carrier_errors;
+  unsigned long long tx_compressed;
+} EVEL_IF_STATS;
+
+/**************************************************************************//**
+ * Counters for every interface, all read at the same instant.
+ *
+ * A snapshot is reused from one read to the next: interfaces are looked up
+ * by name in a hashtable, and keep their position in interfaces[] for the
+ * life of the snapshot.  Interfaces which have gone away are kept with
+ * present set to zero.
+ *****************************************************************************/
+typedef struct evel_if_snapshot {
+  unsigned long long timestamp;
+  int num_interfaces;
+  int max_interfaces;
+  EVEL_IF_STATS ** interfaces;
+  HASHTABLE_T * index;
+  char * buffer;
+  size_t buffer_size;
+} EVEL_IF_SNAPSHOT;
+
+/**************************************************************************//**
+ * Initialize an empty interface snapshot.
+ *
+ * @param snapshot  The snapshot to initialize.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_OUT_OF_MEMORY On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_if_snapshot_init(EVEL_IF_SNAPSHOT * const snapshot);
+
+/**************************************************************************//**
+ * Free the memory held by an interface snapshot.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param mcc         The MCC to be set. ASCIIZ string.  The caller does not
- *                    need to preserve the value once the function returns.
+ * @param snapshot  The snapshot to free.
  *****************************************************************************/
-void evel_mobile_flow_mcc_set(EVENT_MOBILE_FLOW * mobile_flow,
-                              const char * const mcc);
+void evel_if_snapshot_free(EVEL_IF_SNAPSHOT * const snapshot);
 
 /**************************************************************************//**
- * Set the MNC property of the Mobile Flow.
+ * Read the counters for every interface from /proc/net/dev.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * The file is read with a single system call where possible, so all of the
+ * counters are from the same instant.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param mnc         The MNC to be set. ASCIIZ string.  The caller does not
- *                    need to preserve the value once the function returns.
+ * @param snapshot  The snapshot to update.
+ * @param path      File to read, or NULL for ::EVEL_IF_PROC_NET_DEV.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
  *****************************************************************************/
-void evel_mobile_flow_mnc_set(EVENT_MOBILE_FLOW * mobile_flow,
-                              const char * const mnc);
+EVEL_ERR_CODES evel_ifstats_read_procfs(EVEL_IF_SNAPSHOT * const snapshot,
+                                        const char * const path);
 
 /**************************************************************************//**
- * Set the MSISDN property of the Mobile Flow.
+ * Read the counters for every interface with a single netlink dump.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Uses RTM_GETLINK and the 64-bit IFLA_STATS64 counters, so it needs no
+ * privileges, no text parsing, and one round trip however many interfaces
+ * there are.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param msisdn      The MSISDN to be set. ASCIIZ string.  The caller does not
- *                    need to preserve the value once the function returns.
+ * @param snapshot  The snapshot to update.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
  *****************************************************************************/
-void evel_mobile_flow_msisdn_set(EVENT_MOBILE_FLOW * mobile_flow,
-                                 const char * const msisdn);
+EVEL_ERR_CODES evel_ifstats_read_netlink(EVEL_IF_SNAPSHOT * const snapshot);
 
 /**************************************************************************//**
- * Set the Other Functional Role property of the Mobile Flow.
+ * Look up an interface in a snapshot.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param snapshot  The snapshot.
+ * @param name      The interface name.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param role        The Other Functional Role to be set. ASCIIZ string. The
- *                    caller does not need to preserve the value once the
- *                    function returns.
+ * @returns The interface's counters, or NULL if it was not present at the
+ *          last read.
  *****************************************************************************/
-void evel_mobile_flow_other_func_role_set(EVENT_MOBILE_FLOW * mobile_flow,
-                                          const char * const role);
+const EVEL_IF_STATS * evel_if_snapshot_get(
+                                       const EVEL_IF_SNAPSHOT * const snapshot,
+                                       const char * const name);
 
 /**************************************************************************//**
- * Set the RAC property of the Mobile Flow.
+ * Set the vNIC performance counters from interface statistics.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Every accumulated field the interface counters provide is set from
+ * @p current, and the matching delta from the change since @p previous.
+ * Broadcast counts are not available from the kernel, so are not set; the
+ * received unicast count is the received packets less multicast, and the
+ * kernel's multicast count is for received packets only.  Deltas allow
+ * for counters wrapping or being reset; see evel_counter_delta().
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param rac         The RAC to be set. ASCIIZ string.  The caller does not
- *                    need to preserve the value once the function returns.
+ * @param vnic_performance  The vNIC performance to fill in.
+ * @param current           Counters at the end of the interval.
+ * @param previous          Counters at the start of the interval, or NULL
+ *                          to set only the accumulated fields.
  *****************************************************************************/
-void evel_mobile_flow_rac_set(EVENT_MOBILE_FLOW * mobile_flow,
-                              const char * const rac);
+void evel_vnic_performance_if_stats_set(
+                          MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                          const EVEL_IF_STATS * const current,
+                          const EVEL_IF_STATS * const previous);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   CPU STATISTICS                                                          */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Longest CPU identifier, such as "cpu1023".                                */
+/*****************************************************************************/
+#define EVEL_CPU_ID_MAX 15
+
+/*****************************************************************************/
+/* Default source of CPU counters.                                           */
+/*****************************************************************************/
+#define EVEL_CPU_PROC_STAT "/proc/stat"
 
 /**************************************************************************//**
- * Set the Radio Access Technology property of the Mobile Flow.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Time one CPU has spent in each state, in jiffies since boot.
+ *****************************************************************************/
+typedef struct evel_cpu_stats {
+  char id[EVEL_CPU_ID_MAX + 1];
+  unsigned long long user;
+  unsigned long long nice;
+  unsigned long long system;
+  unsigned long long idle;
+  unsigned long long iowait;
+  unsigned long long irq;
+  unsigned long long softirq;
+  unsigned long long steal;
+} EVEL_CPU_STATS;
+
+/**************************************************************************//**
+ * Counters for every online CPU, all read at the same instant.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param tech        The Radio Access Technology to be set. ASCIIZ string. The
- *                    caller does not need to preserve the value once the
- *                    function returns.
+ * A snapshot is reused from one read to the next, so that the steady state
+ * does no allocation.
  *****************************************************************************/
-void evel_mobile_flow_radio_acc_tech_set(EVENT_MOBILE_FLOW * mobile_flow,
-                                         const char * const tech);
+typedef struct evel_cpu_snapshot {
+  unsigned long long timestamp;
+  int num_cpus;
+  int max_cpus;
+  EVEL_CPU_STATS * cpus;
+  char * buffer;
+  size_t buffer_size;
+} EVEL_CPU_SNAPSHOT;
 
 /**************************************************************************//**
- * Set the SAC property of the Mobile Flow.
+ * Initialize an empty CPU snapshot.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param snapshot  The snapshot to initialize.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param sac         The SAC to be set. ASCIIZ string.  The caller does not
- *                    need to preserve the value once the function returns.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_OUT_OF_MEMORY On failure.
  *****************************************************************************/
-void evel_mobile_flow_sac_set(EVENT_MOBILE_FLOW * mobile_flow,
-                              const char * const sac);
+EVEL_ERR_CODES evel_cpu_snapshot_init(EVEL_CPU_SNAPSHOT * const snapshot);
 
 /**************************************************************************//**
- * Set the Sampling Algorithm property of the Mobile Flow.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Free the memory held by a CPU snapshot.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param algorithm   The Sampling Algorithm to be set.
+ * @param snapshot  The snapshot to free.
  *****************************************************************************/
-void evel_mobile_flow_samp_alg_set(EVENT_MOBILE_FLOW * mobile_flow,
-                                   int algorithm);
+void evel_cpu_snapshot_free(EVEL_CPU_SNAPSHOT * const snapshot);
 
 /**************************************************************************//**
- * Set the TAC property of the Mobile Flow.
+ * Read the counters for every CPU from /proc/stat.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param snapshot  The snapshot to update.
+ * @param path      File to read, or NULL for ::EVEL_CPU_PROC_STAT.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param tac         The TAC to be set. ASCIIZ string.  The caller does not
- *                    need to preserve the value once the function returns.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
  *****************************************************************************/
-void evel_mobile_flow_tac_set(EVENT_MOBILE_FLOW * mobile_flow,
-                              const char * const tac);
+EVEL_ERR_CODES evel_cpustats_read_procfs(EVEL_CPU_SNAPSHOT * const snapshot,
+                                         const char * const path);
 
 /**************************************************************************//**
- * Set the Tunnel ID property of the Mobile Flow.
+ * Add a CPU Use to a Measurement for each CPU, giving the percentage of
+ * time spent in each state between two snapshots.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
- *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param tunnel_id   The Tunnel ID to be set. ASCIIZ string.  The caller does
- *                    not need to preserve the value once the function returns.
+ * @param measurement   Pointer to the Measurement.
+ * @param current       The later snapshot.
+ * @param previous      The earlier snapshot, or NULL for the whole time
+ *                      since boot.
  *****************************************************************************/
-void evel_mobile_flow_tunnel_id_set(EVENT_MOBILE_FLOW * mobile_flow,
-                                    const char * const tunnel_id);
+void evel_cpustats_measurement_add(EVENT_MEASUREMENT * const measurement,
+                                   const EVEL_CPU_SNAPSHOT * const current,
+                                   const EVEL_CPU_SNAPSHOT * const previous);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   MEMORY STATISTICS                                                       */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Default source of memory usage.                                           */
+/*****************************************************************************/
+#define EVEL_MEM_PROC_MEMINFO "/proc/meminfo"
 
 /**************************************************************************//**
- * Set the VLAN ID property of the Mobile Flow.
+ * Memory usage, in kilobytes.
+ *****************************************************************************/
+typedef struct evel_mem_stats {
+  unsigned long long total;
+  unsigned long long free;
+  unsigned long long buffers;
+  unsigned long long cached;
+  unsigned long long slab_reclaimable;
+  unsigned long long slab_unreclaimable;
+} EVEL_MEM_STATS;
+
+/**************************************************************************//**
+ * Read memory usage from /proc/meminfo.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param stats     The figures to fill in.
+ * @param path      File to read, or NULL for ::EVEL_MEM_PROC_MEMINFO.
  *
- * @param mobile_flow Pointer to the Mobile Flow.
- * @param vlan_id     The VLAN ID to be set. ASCIIZ string.  The caller does
- *                    not need to preserve the value once the function returns.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
  *****************************************************************************/
-void evel_mobile_flow_vlan_id_set(EVENT_MOBILE_FLOW * mobile_flow,
-                                  const char * const vlan_id);
+EVEL_ERR_CODES evel_memstats_read_procfs(EVEL_MEM_STATS * const stats,
+                                         const char * const path);
 
 /**************************************************************************//**
- * Create a new Mobile GTP Per Flow Metrics.
- *
- * @note    The mandatory fields on the Mobile GTP Per Flow Metrics must be
- *          supplied to this factory function and are immutable once set.
- *          Optional fields have explicit setter functions, but again values
- *          may only be set once so that the Mobile GTP Per Flow Metrics has
- *          immutable properties.
+ * Add a Memory Use to a Measurement.
  *
- * @param   avg_bit_error_rate
- * @param   avg_packet_delay_variation
- * @param   avg_packet_latency
- * @param   avg_receive_throughput
- * @param   avg_transmit_throughput
- * @param   flow_activation_epoch
- * @param   flow_activation_microsec
- * @param   flow_deactivation_epoch
- * @param   flow_deactivation_microsec
- * @param   flow_deactivation_time
- * @param   flow_status
- * @param   max_packet_delay_variation
- * @param   num_activation_failures
- * @param   num_bit_errors
- * @param   num_bytes_received
- * @param   num_bytes_transmitted
- * @param   num_dropped_packets
- * @param   num_l7_bytes_received
- * @param   num_l7_bytes_transmitted
- * @param   num_lost_packets
- * @param   num_out_of_order_packets
- * @param   num_packet_errors
- * @param   num_packets_received_excl_retrans
- * @param   num_packets_received_incl_retrans
- * @param   num_packets_transmitted_incl_retrans
- * @param   num_retries
- * @param   num_timeouts
- * @param   num_tunneled_l7_bytes_received
- * @param   round_trip_time
- * @param   time_to_first_byte
+ * @param measurement   Pointer to the Measurement.
+ * @param stats         The figures from evel_memstats_read_procfs().
+ * @param id            ASCIIZ identifier for the memory.
+ * @param vm_id         ASCIIZ identifier of the VM.
+ *****************************************************************************/
+void evel_memstats_measurement_add(EVENT_MEASUREMENT * const measurement,
+                                   const EVEL_MEM_STATS * const stats,
+                                   const char * const id,
+                                   const char * const vm_id);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   DISK STATISTICS                                                         */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Longest block device name kept.                                           */
+/*****************************************************************************/
+#define EVEL_DISK_NAME_MAX 31
+
+/*****************************************************************************/
+/* Default source of disk counters.                                          */
+/*****************************************************************************/
+#define EVEL_DISK_PROC_DISKSTATS "/proc/diskstats"
+
+/*****************************************************************************/
+/* Number of figures summarized for each disk: octets, operations and        */
+/* merges, read and written; milliseconds per read and per write; I/O time   */
+/* and pending operations.                                                   */
+/*****************************************************************************/
+#define EVEL_DISK_METRICS 10
+
+/**************************************************************************//**
+ * Counters for one block device, as accumulated by the kernel, except for
+ * in_progress which is the current queue.
+ *****************************************************************************/
+typedef struct evel_disk_stats {
+  char name[EVEL_DISK_NAME_MAX + 1];
+  unsigned long long reads;
+  unsigned long long reads_merged;
+  unsigned long long sectors_read;
+  unsigned long long read_ms;
+  unsigned long long writes;
+  unsigned long long writes_merged;
+  unsigned long long sectors_written;
+  unsigned long long write_ms;
+  unsigned long long in_progress;
+  unsigned long long io_ms;
+} EVEL_DISK_STATS;
+
+/**************************************************************************//**
+ * Summary of the samples of one figure over a measurement interval.
+ *****************************************************************************/
+typedef struct evel_disk_summary {
+  int count;
+  double min;
+  double max;
+  double sum;
+  double last;
+} EVEL_DISK_SUMMARY;
+
+/**************************************************************************//**
+ * A block device, with its latest counters and the summaries of the
+ * samples taken since the last measurement.
+ *****************************************************************************/
+typedef struct evel_disk_usage {
+  EVEL_DISK_STATS counters;
+  int present;
+  EVEL_DISK_SUMMARY summaries[EVEL_DISK_METRICS];
+} EVEL_DISK_USAGE;
+
+/**************************************************************************//**
+ * Disk samples for every block device that has done any I/O.
  *
- * @returns pointer to the newly manufactured ::MOBILE_GTP_PER_FLOW_METRICS.
- *          If the structure is not used it must be released using
- *          ::evel_free_mobile_gtp_flow_metrics.
- * @retval  NULL  Failed to create the event.
+ * A collector is reused from one measurement interval to the next, so
+ * that the steady state does no allocation.
  *****************************************************************************/
-MOBILE_GTP_PER_FLOW_METRICS * evel_new_mobile_gtp_flow_metrics(
-                                      double avg_bit_error_rate,
-                                      double avg_packet_delay_variation,
-                                      int avg_packet_latency,
-                                      int avg_receive_throughput,
-                                      int avg_transmit_throughput,
-                                      int flow_activation_epoch,
-                                      int flow_activation_microsec,
-                                      int flow_deactivation_epoch,
-                                      int flow_deactivation_microsec,
-                                      time_t flow_deactivation_time,
-                                      const char * const flow_status,
-                                      int max_packet_delay_variation,
-                                      int num_activation_failures,
-                                      int num_bit_errors,
-                                      int num_bytes_received,
-                                      int num_bytes_transmitted,
-                                      int num_dropped_packets,
-                                      int num_l7_bytes_received,
-                                      int num_l7_bytes_transmitted,
-                                      int num_lost_packets,
-                                      int num_out_of_order_packets,
-                                      int num_packet_errors,
-                                      int num_packets_received_excl_retrans,
-                                      int num_packets_received_incl_retrans,
-                                      int num_packets_transmitted_incl_retrans,
-                                      int num_retries,
-                                      int num_timeouts,
-                                      int num_tunneled_l7_bytes_received,
-                                      int round_trip_time,
-                                      int time_to_first_byte);
+typedef struct evel_disk_collector {
+  unsigned long long timestamp;
+  int num_disks;
+  int max_disks;
+  EVEL_DISK_USAGE * disks;
+  char * buffer;
+  size_t buffer_size;
+} EVEL_DISK_COLLECTOR;
 
 /**************************************************************************//**
- * Free a Mobile GTP Per Flow Metrics.
+ * Initialize an empty disk collector.
  *
- * Free off the Mobile GTP Per Flow Metrics supplied.  Will free all the
- * contained allocated memory.
+ * @param collector The collector to initialize.
  *
- * @note It does not free the Mobile GTP Per Flow Metrics itself, since that
- * may be part of a larger structure.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_OUT_OF_MEMORY On failure.
  *****************************************************************************/
-void evel_free_mobile_gtp_flow_metrics(MOBILE_GTP_PER_FLOW_METRICS * metrics);
+EVEL_ERR_CODES evel_disk_collector_init(EVEL_DISK_COLLECTOR * const collector);
 
 /**************************************************************************//**
- * Set the Duration of Connection Failed Status property of the Mobile GTP Per
- * Flow Metrics.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Free the memory held by a disk collector.
  *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param duration    The Duration of Connection Failed Status to be set.
+ * @param collector The collector to free.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_dur_con_fail_set(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         int duration);
+void evel_disk_collector_free(EVEL_DISK_COLLECTOR * const collector);
 
 /**************************************************************************//**
- * Set the Duration of Tunnel Failed Status property of the Mobile GTP Per Flow
- * Metrics.
+ * Sample every block device: read /proc/diskstats and add the rates since
+ * the last sample to each device's summaries.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param collector The collector.
+ * @param path      File to read, or NULL for ::EVEL_DISK_PROC_DISKSTATS.
  *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param duration    The Duration of Tunnel Failed Status to be set.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_dur_tun_fail_set(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         int duration);
+EVEL_ERR_CODES evel_diskstats_sample(EVEL_DISK_COLLECTOR * const collector,
+                                     const char * const path);
 
 /**************************************************************************//**
- * Set the Activated By property of the Mobile GTP Per Flow metrics.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Add a Disk Use to a Measurement for each block device sampled since the
+ * last call, with the min, max, average and last of its samples, then start
+ * a new interval.
  *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param act_by      The Activated By to be set.  ASCIIZ string. The caller
- *                    does not need to preserve the value once the function
- *                    returns.
+ * @param measurement   Pointer to the Measurement.
+ * @param collector     The collector.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_act_by_set(MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                        const char * const act_by);
+void evel_diskstats_measurement_add(EVENT_MEASUREMENT * const measurement,
+                                    EVEL_DISK_COLLECTOR * const collector);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   FILESYSTEM STATISTICS                                                   */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Default source of mounted filesystems.                                    */
+/*****************************************************************************/
+#define EVEL_FS_PROC_MOUNTS "/proc/self/mounts"
 
 /**************************************************************************//**
- * Set the Activation Time property of the Mobile GTP Per Flow metrics.
+ * Add a Filesystem Use to a Measurement for each mounted filesystem backed
+ * by a block device, with its configured and used space in gigabytes.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param measurement   Pointer to the Measurement.
+ * @param path          Mount table to read, or NULL for
+ *                      ::EVEL_FS_PROC_MOUNTS.
  *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param act_time    The Activation Time to be set.  ASCIIZ string. The caller
- *                    does not need to preserve the value once the function
- *                    returns.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_act_time_set(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         time_t act_time);
+EVEL_ERR_CODES evel_fsstats_measurement_add(
+                                       EVENT_MEASUREMENT * const measurement,
+                                       const char * const path);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   SAMPLING                                                                */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Shape of the ::EVEL_STATS histogram: values below 1 share the first       */
+/* bucket, then each power of two from 1 up to 2^EVEL_STATS_MAX_EXPONENT is  */
+/* split into EVEL_STATS_SUB_BUCKETS equal buckets, so a bucket is never     */
+/* wider than 1/EVEL_STATS_SUB_BUCKETS of its low end.  Larger values are    */
+/* counted in the last bucket.                                               */
+/*****************************************************************************/
+#define EVEL_STATS_SUB_BUCKETS 8
+#define EVEL_STATS_MAX_EXPONENT 48
+#define EVEL_STATS_BUCKETS                                                    \
+                    (1 + EVEL_STATS_SUB_BUCKETS * EVEL_STATS_MAX_EXPONENT)
 
 /**************************************************************************//**
- * Set the Deactivated By property of the Mobile GTP Per Flow metrics.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Summary statistics of a series of samples.
  *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param deact_by    The Deactivated By to be set.  ASCIIZ string. The caller
- *                    does not need to preserve the value once the function
- *                    returns.
+ * Takes the same fixed space however many samples are added: the count,
+ * minimum, maximum and sum are exact, and percentiles come from a
+ * log-linear histogram.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_deact_by_set(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         const char * const deact_by);
+typedef struct evel_stats {
+  unsigned long long count;
+  double min;
+  double max;
+  double sum;
+  unsigned int buckets[EVEL_STATS_BUCKETS];
+} EVEL_STATS;
 
 /**************************************************************************//**
- * Set the GTP Connection Status property of the Mobile GTP Per Flow metrics.
+ * Sampled metric types.
+ *****************************************************************************/
+typedef enum {
+  EVEL_SAMPLE_GAUGE,          /** Sample the value as read.                  */
+  EVEL_SAMPLE_RATE,           /** Sample the per-second rate of a counter.   */
+  EVEL_MAX_SAMPLE_TYPES
+} EVEL_SAMPLE_TYPES;
+
+/**************************************************************************//**
+ * Function called by the sampler to read a metric.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param context   The context given when the metric was added.
+ * @param[out] value  The value read.
  *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param status      The GTP Connection Status to be set.  ASCIIZ string. The
- *                    caller does not need to preserve the value once the
- *                    function returns.
+ * @returns Status code.  Anything other than ::EVEL_SUCCESS skips the
+ *          sample.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_con_status_set(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         const char * const status);
+typedef EVEL_ERR_CODES (*EVEL_SAMPLE_READ_FN)(void * context,
+                                              unsigned long long * value);
 
 /**************************************************************************//**
- * Set the GTP Tunnel Status property of the Mobile GTP Per Flow metrics.
+ * Function called by the sampler before each round of reads, for example to
+ * take one ::EVEL_IF_SNAPSHOT that the metrics then read from.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param context   The context given when the sampler was created.
  *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param status      The GTP Tunnel Status to be set.  ASCIIZ string. The
- *                    caller does not need to preserve the value once the
- *                    function returns.
+ * @returns Status code.  Anything other than ::EVEL_SUCCESS skips the
+ *          round.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_tun_status_set(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         const char * const status);
+typedef EVEL_ERR_CODES (*EVEL_SAMPLE_ROUND_FN)(void * context);
 
 /**************************************************************************//**
- * Set an IP Type-of-Service count property of the Mobile GTP Per Flow metrics.
- *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param index       The index of the IP Type-of-Service.
- * @param count       The count.
+ * A thread sampling metrics at a sub-second period, aggregating the samples
+ * into ::EVEL_STATS until they are collected into a measurement.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_iptos_set(MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                       int index,
-                                       int count);
+typedef struct evel_sampler EVEL_SAMPLER;
 
 /**************************************************************************//**
- * Set the Large Packet Round-Trip Time property of the Mobile GTP Per Flow
- * Metrics.
+ * Clear a set of statistics.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param stats     The statistics.
+ *****************************************************************************/
+void evel_stats_reset(EVEL_STATS * const stats);
+
+/**************************************************************************//**
+ * Add a sample to a set of statistics.
  *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param rtt         The Large Packet Round-Trip Time to be set.
+ * @param stats     The statistics.
+ * @param value     The sample.  Negative values count as zero in the
+ *                  histogram.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_large_pkt_rtt_set(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         int rtt);
+void evel_stats_add(EVEL_STATS * const stats, const double value);
 
 /**************************************************************************//**
- * Set the Large Packet Threshold property of the Mobile GTP Per Flow Metrics.
+ * Get the mean of a set of statistics.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param stats     The statistics.
  *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param threshold   The Large Packet Threshold to be set.
+ * @returns The mean, or 0 if there are no samples.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_large_pkt_thresh_set(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         double threshold);
+double evel_stats_mean(const EVEL_STATS * const stats);
 
 /**************************************************************************//**
- * Set the Max Receive Bit Rate property of the Mobile GTP Per Flow Metrics.
+ * Estimate a percentile of a set of statistics.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param stats       The statistics.
+ * @param percentile  The percentile, from 0 to 100.
  *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param rate        The Max Receive Bit Rate to be set.
+ * @returns The estimate, interpolated within its histogram bucket, or 0 if
+ *          there are no samples.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_max_rcv_bit_rate_set(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         int rate);
+double evel_stats_percentile(const EVEL_STATS * const stats,
+                             const double percentile);
 
 /**************************************************************************//**
- * Set the Max Transmit Bit Rate property of the Mobile GTP Per Flow Metrics.
+ * Add a set of statistics to a Measurement as an Additional Measurements
+ * group, with the sample count, min, max, mean, and 50th, 90th and 99th
+ * percentiles.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param measurement   Pointer to the Measurement.
+ * @param group         ASCIIZ name of the group.
+ * @param stats         The statistics.
+ *****************************************************************************/
+void evel_stats_measurement_add(EVENT_MEASUREMENT * const measurement,
+                                const char * const group,
+                                const EVEL_STATS * const stats);
+
+/**************************************************************************//**
+ * Add the histogram of a set of statistics to a Measurement's Latency
+ * Distribution, one bucket for each non-empty histogram bucket.
  *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param rate        The Max Transmit Bit Rate to be set.
+ * @param measurement   Pointer to the Measurement.
+ * @param stats         The statistics.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_max_trx_bit_rate_set(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         int rate);
+void evel_stats_latency_buckets_add(EVENT_MEASUREMENT * const measurement,
+                                    const EVEL_STATS * const stats);
 
 /**************************************************************************//**
- * Set the Number of GTP Echo Failures property of the Mobile GTP Per Flow
- * Metrics.
+ * Create a sampler.  Metrics are added with evel_sampler_metric_add(), then
+ * sampling starts with evel_sampler_start().
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param period_ms   Sampling period in milliseconds.
+ * @param round       Function to call before each round of reads, or NULL.
+ * @param context     Context passed to round.
  *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param num         The Number of GTP Echo Failures to be set.
+ * @returns pointer to the new sampler.
+ * @retval  NULL  Failed to create the sampler.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_num_echo_fail_set(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         int num);
+EVEL_SAMPLER * evel_new_sampler(const int period_ms,
+                                EVEL_SAMPLE_ROUND_FN round,
+                                void * context);
 
 /**************************************************************************//**
- * Set the Number of GTP Tunnel Errors property of the Mobile GTP Per Flow
- * Metrics.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Stop a sampler if it is running, and free it.
  *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param num         The Number of GTP Tunnel Errors to be set.
+ * @param sampler   The sampler.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_num_tun_fail_set(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         int num);
+void evel_free_sampler(EVEL_SAMPLER * sampler);
 
 /**************************************************************************//**
- * Set the Number of HTTP Errors property of the Mobile GTP Per Flow Metrics.
+ * Add a metric to a sampler.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * The library takes a copy of the name, which is used as the name of the
+ * Additional Measurements group when the metric is collected.
  *
- * @param metrics     Pointer to the Mobile GTP Per Flow Metrics.
- * @param num         The Number of HTTP Errors to be set.
+ * @param sampler       The sampler.
+ * @param name          ASCIIZ name of the metric.
+ * @param type          Whether to sample the value or its rate.
+ * @param distribution  Non-zero to also collect the metric's histogram as
+ *                      the Measurement's Latency Distribution.  At most one
+ *                      metric should do so.
+ * @param read          Function to read the metric.
+ * @param context       Context passed to read.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success.
+ * @retval  EVEL_OUT_OF_MEMORY The metric could not be added.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_num_http_errors_set(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         int num);
+EVEL_ERR_CODES evel_sampler_metric_add(EVEL_SAMPLER * const sampler,
+                                       const char * const name,
+                                       const EVEL_SAMPLE_TYPES type,
+                                       const int distribution,
+                                       EVEL_SAMPLE_READ_FN read,
+                                       void * context);
 
 /**************************************************************************//**
- * Add a TCP flag count to the metrics.
+ * Start the sampling thread.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param sampler   The sampler.
  *
- * @param metrics       Pointer to the Mobile GTP Per Flow Metrics.
- * @param tcp_flag      The TCP flag count to be updated.
- * @param count         The associated flag count.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success, or if the sampler is already running.
+ * @retval  EVEL_PTHREAD_LIBRARY_FAIL The thread could not be started.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_tcp_flag_count_add(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         const EVEL_TCP_FLAGS tcp_flag,
-                                         const int count);
+EVEL_ERR_CODES evel_sampler_start(EVEL_SAMPLER * const sampler);
 
 /**************************************************************************//**
- * Add a QCI COS count to the metrics.
+ * Stop the sampling thread.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param sampler   The sampler.
+ *****************************************************************************/
+void evel_sampler_stop(EVEL_SAMPLER * const sampler);
+
+/**************************************************************************//**
+ * Add the statistics of each metric since the last collection to a
+ * Measurement, then start a new interval.
  *
- * @param metrics       Pointer to the Mobile GTP Per Flow Metrics.
- * @param qci_cos       The QCI COS count to be updated.
- * @param count         The associated QCI COS count.
+ * @param sampler       The sampler.
+ * @param measurement   Pointer to the Measurement.
  *****************************************************************************/
-void evel_mobile_gtp_metrics_qci_cos_count_add(
-                                         MOBILE_GTP_PER_FLOW_METRICS * metrics,
-                                         const EVEL_QCI_COS_TYPES qci_cos,
-                                         const int count);
+void evel_sampler_collect(EVEL_SAMPLER * const sampler,
+                          EVENT_MEASUREMENT * const measurement);
 
 /*****************************************************************************/
 /*****************************************************************************/
 /*                                                                           */
-/*   SIGNALING                                                               */
+/*   CONFIGURATION                                                           */
 /*                                                                           */
 /*****************************************************************************/
 /*****************************************************************************/
 
 /**************************************************************************//**
- * Create a new Signaling event.
- *
- * @note    The mandatory fields on the Signaling must be supplied to
- *          this factory function and are immutable once set.  Optional fields
- *          have explicit setter functions, but again values may only be set
- *          once so that the event has immutable properties.
- * @param event_name    Unique Event Name
- * @param event_id    A universal identifier of the event for analysis etc
- * @param vendor_name   The vendor id to encode in the event vnf field.
- * @param module        The module to encode in the event.
- * @param vnfname       The Virtual network function to encode in the event.
- * @returns pointer to the newly manufactured ::EVENT_SIGNALING.  If the event
- *          is not used (i.e. posted) it must be released using
- *          ::evel_free_signaling.
- * @retval  NULL  Failed to create the event.
+ * JSON value types in a parsed configuration.
  *****************************************************************************/
-EVENT_SIGNALING * evel_new_signaling(const char* ev_name, const char *ev_id,
-				     const char * const vendor_name,
-                                     const char * const correlator,
-				     const char * const local_ip_address,
-				     const char * const local_port,
-				     const char * const remote_ip_address,
-				     const char * const remote_port);
+typedef enum {
+  EVEL_CONFIG_OBJECT,
+  EVEL_CONFIG_ARRAY,
+  EVEL_CONFIG_STRING,
+  EVEL_CONFIG_PRIMITIVE       /** Number, true, false or null.               */
+} EVEL_CONFIG_TYPES;
+
+/**************************************************************************//**
+ * A value in a parsed configuration.  Children are linked by index into
+ * ::EVEL_CONFIG::nodes, -1 ending each list.
+ *****************************************************************************/
+typedef struct evel_config_node {
+  EVEL_CONFIG_TYPES type;
+  char * name;                /** Member name, NULL outside objects.         */
+  char * value;               /** Text of a string or primitive, else NULL.  */
+  int size;                   /** Number of children.                        */
+  int child;                  /** First child.                               */
+  int next;                   /** Next sibling.                              */
+} EVEL_CONFIG_NODE;
+
+/**************************************************************************//**
+ * A configuration file, parsed once into a tree of nodes whose names and
+ * values point into the file's text, unescaped in place.
+ *****************************************************************************/
+typedef struct evel_config {
+  char * text;
+  int num_nodes;
+  int max_nodes;
+  EVEL_CONFIG_NODE * nodes;   /** nodes[0] is the top-level value.           */
+} EVEL_CONFIG;
+
+/**************************************************************************//**
+ * Compile a parsed configuration into the form the caller uses, checking
+ * that it is complete.
+ *
+ * The compiled form may point into the configuration, which is kept for as
+ * long as it is.
+ *
+ * @param config    The parsed configuration.
+ * @param context   The context given when the watch was created.
+ *
+ * @returns The compiled configuration, or NULL if the configuration is
+ *          unusable.
+ *****************************************************************************/
+typedef void * (*EVEL_CONFIG_COMPILE_FN)(const EVEL_CONFIG * config,
+                                         void * context);
 
 /**************************************************************************//**
- * Free a Signaling event.
- *
- * Free off the event supplied.  Will free all the contained allocated memory.
+ * Free a compiled configuration.
  *
- * @note It does not free the event itself, since that may be part of a larger
- * structure.
+ * @param compiled  The compiled configuration.
  *****************************************************************************/
-void evel_free_signaling(EVENT_SIGNALING * const event);
+typedef void (*EVEL_CONFIG_FREE_FN)(void * compiled);
 
 /**************************************************************************//**
- * Set the Event Type property of the Signaling event.
+ * A configuration file, compiled on load and recompiled whenever the file
+ * is replaced or rewritten.
+ *****************************************************************************/
+typedef struct evel_config_watch EVEL_CONFIG_WATCH;
+
+/**************************************************************************//**
+ * Read and parse a JSON configuration file.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param path      The file.
  *
- * @param event         Pointer to the Signaling event.
- * @param type          The Event Type to be set. ASCIIZ string. The caller
- *                      does not need to preserve the value once the function
- *                      returns.
+ * @returns pointer to the new configuration.
+ * @retval  NULL  The file could not be read or is not valid JSON.
  *****************************************************************************/
-void evel_signaling_type_set(EVENT_SIGNALING * const event,
-                             const char * const type);
+EVEL_CONFIG * evel_new_config(const char * const path);
 
 /**************************************************************************//**
- * Add an additional value name/value pair to the SIP signaling.
- *
- * The name and value are null delimited ASCII strings.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * Free a configuration.
  *
- * @param event     Pointer to the fault.
- * @param name      ASCIIZ string with the attribute's name.  The caller
- *                  does not need to preserve the value once the function
- *                  returns.
- * @param value     ASCIIZ string with the attribute's value.  The caller
- *                  does not need to preserve the value once the function
- *                  returns.
+ * @param config    The configuration.  May be NULL.
  *****************************************************************************/
-void evel_signaling_addl_info_add(EVENT_SIGNALING * event, char * name, char * value);
+void evel_free_config(EVEL_CONFIG * const config);
 
 /**************************************************************************//**
- * Set the Correlator property of the Signaling event.
+ * Find a value by its path of member names, such as
+ * "tmp_directParameters/eventName".
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param config    The configuration.
+ * @param node      Where the path starts, or NULL for the top level.
+ * @param path      Member names separated by '/'.
  *
- * @param event         Pointer to the Signaling event.
- * @param correlator    The correlator to be set. ASCIIZ string. The caller
- *                      does not need to preserve the value once the function
- *                      returns.
+ * @returns The value, or NULL if there is none.
  *****************************************************************************/
-void evel_signaling_correlator_set(EVENT_SIGNALING * const event,
-                                   const char * const correlator);
+const EVEL_CONFIG_NODE * evel_config_find(const EVEL_CONFIG * const config,
+                                          const EVEL_CONFIG_NODE * node,
+                                          const char * const path);
 
 /**************************************************************************//**
- * Set the Local Ip Address property of the Signaling event.
+ * Get a string or primitive by path.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param config    The configuration.
+ * @param node      Where the path starts, or NULL for the top level.
+ * @param path      Member names separated by '/'.
+ * @param default_value  Value if the path is missing or not a string.
  *
- * @param event         Pointer to the Signaling event.
- * @param local_ip_address
- *                      The Local Ip Address to be set. ASCIIZ string. The
- *                      caller does not need to preserve the value once the
- *                      function returns.
+ * @returns The value, owned by the configuration.
  *****************************************************************************/
-void evel_signaling_local_ip_address_set(EVENT_SIGNALING * const event,
-                                         const char * const local_ip_address);
+const char * evel_config_string(const EVEL_CONFIG * const config,
+                                const EVEL_CONFIG_NODE * const node,
+                                const char * const path,
+                                const char * const default_value);
 
 /**************************************************************************//**
- * Set the Local Port property of the Signaling event.
+ * Get an integer by path.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param config    The configuration.
+ * @param node      Where the path starts, or NULL for the top level.
+ * @param path      Member names separated by '/'.
+ * @param default_value  Value if the path is missing or not an integer.
  *
- * @param event         Pointer to the Signaling event.
- * @param local_port    The Local Port to be set. ASCIIZ string. The caller
- *                      does not need to preserve the value once the function
- *                      returns.
+ * @returns The value.
  *****************************************************************************/
-void evel_signaling_local_port_set(EVENT_SIGNALING * const event,
-                                   const char * const local_port);
+int evel_config_int(const EVEL_CONFIG * const config,
+                    const EVEL_CONFIG_NODE * const node,
+                    const char * const path,
+                    const int default_value);
 
 /**************************************************************************//**
- * Set the Remote Ip Address property of the Signaling event.
+ * Get the first child of an object or array.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param config    The configuration.
+ * @param node      The object or array.
  *
- * @param event         Pointer to the Signaling event.
- * @param remote_ip_address
- *                      The Remote Ip Address to be set. ASCIIZ string. The
- *                      caller does not need to preserve the value once the
- *                      function returns.
+ * @returns The child, or NULL if there is none.
  *****************************************************************************/
-void evel_signaling_remote_ip_address_set(EVENT_SIGNALING * const event,
-                                         const char * const remote_ip_address);
+const EVEL_CONFIG_NODE * evel_config_child(const EVEL_CONFIG * const config,
+                                           const EVEL_CONFIG_NODE * node);
 
 /**************************************************************************//**
- * Set the Remote Port property of the Signaling event.
+ * Get the next sibling of a member or array element.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param config    The configuration.
+ * @param node      The member or element.
  *
- * @param event         Pointer to the Signaling event.
- * @param remote_port   The Remote Port to be set. ASCIIZ string. The caller
- *                      does not need to preserve the value once the function
- *                      returns.
+ * @returns The sibling, or NULL if there is none.
  *****************************************************************************/
-void evel_signaling_remote_port_set(EVENT_SIGNALING * const event,
-                                    const char * const remote_port);
+const EVEL_CONFIG_NODE * evel_config_next(const EVEL_CONFIG * const config,
+                                          const EVEL_CONFIG_NODE * node);
+
 /**************************************************************************//**
- * Set the Vendor module property of the Signaling event.
+ * Load and compile a configuration file, and watch it for changes.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * The file's directory is watched with inotify, so that the file being
+ * replaced by rename, as editors and configuration management tools do, is
+ * seen as well as it being rewritten.
  *
- * @param event         Pointer to the Signaling event.
- * @param modulename    The module name to be set. ASCIIZ string. The caller
- *                      does not need to preserve the value once the function
- *                      returns.
+ * @param path      The file.
+ * @param compile   Function compiling each version of the file.
+ * @param free_compiled  Function freeing a compiled version.
+ * @param context   Context passed to compile.
+ *
+ * @returns pointer to the new watch.
+ * @retval  NULL  The file could not be loaded or compiled.
  *****************************************************************************/
-void evel_signaling_vnfmodule_name_set(EVENT_SIGNALING * const event,
-                                    const char * const module_name);
+EVEL_CONFIG_WATCH * evel_new_config_watch(const char * const path,
+                                          EVEL_CONFIG_COMPILE_FN compile,
+                                          EVEL_CONFIG_FREE_FN free_compiled,
+                                          void * const context);
+
 /**************************************************************************//**
- * Set the Vendor module property of the Signaling event.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Free a watch and its compiled configuration.  Any compiled version must
+ * have been released first.
  *
- * @param event         Pointer to the Signaling event.
- * @param vnfname       The Virtual Network function to be set. ASCIIZ string.
- *                      The caller does not need to preserve the value once
- *                      the function returns.
+ * @param watch     The watch.  May be NULL.
  *****************************************************************************/
-void evel_signaling_vnfname_set(EVENT_SIGNALING * const event,
-                                    const char * const vnfname);
+void evel_free_config_watch(EVEL_CONFIG_WATCH * const watch);
 
 /**************************************************************************//**
- * Set the Compressed SIP property of the Signaling event.
+ * Reload the configuration if the file has changed.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * This costs one non-blocking read() when nothing has changed, so may be
+ * called every time round a reporting loop.  If the new version fails to
+ * parse or compile, the current one is kept.
  *
- * @param event         Pointer to the Signaling event.
- * @param compressed_sip
- *                      The Compressed SIP to be set. ASCIIZ string. The caller
- *                      does not need to preserve the value once the function
- *                      returns.
+ * @param watch     The watch.
+ *
+ * @returns Non-zero if a new version was loaded.
  *****************************************************************************/
-void evel_signaling_compressed_sip_set(EVENT_SIGNALING * const event,
-                                       const char * const compressed_sip);
+int evel_config_watch_check(EVEL_CONFIG_WATCH * const watch);
 
 /**************************************************************************//**
- * Set the Summary SIP property of the Signaling event.
+ * Get the current compiled configuration.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * It stays valid, even if a new version is loaded, until it is released
+ * with evel_config_watch_release().
  *
- * @param event         Pointer to the Signaling event.
- * @param summary_sip   The Summary SIP to be set. ASCIIZ string. The caller
- *                      does not need to preserve the value once the function
- *                      returns.
+ * @param watch     The watch.
+ *
+ * @returns The compiled configuration.
  *****************************************************************************/
-void evel_signaling_summary_sip_set(EVENT_SIGNALING * const event,
-                                    const char * const summary_sip);
+void * evel_config_watch_acquire(EVEL_CONFIG_WATCH * const watch);
 
+/**************************************************************************//**
+ * Release a compiled configuration from evel_config_watch_acquire().
+ *
+ * @param watch     The watch.
+ * @param compiled  The compiled configuration.
+ *****************************************************************************/
+void evel_config_watch_release(EVEL_CONFIG_WATCH * const watch,
+                               void * const compiled);
 
 /*****************************************************************************/
 /*****************************************************************************/
 /*                                                                           */
-/*   STATE CHANGE                                                            */
+/*   COMMAND TEMPLATES                                                       */
 /*                                                                           */
 /*****************************************************************************/
 /*****************************************************************************/
 
 /**************************************************************************//**
- * Create a new State Change event.
+ * How a compiled command is run.
+ *****************************************************************************/
+typedef enum {
+  EVEL_COMMAND_SHELL,         /** Rendered and run by the shell.             */
+  EVEL_COMMAND_IF_STATS       /** Read from an ::EVEL_IF_SNAPSHOT.           */
+} EVEL_COMMAND_TYPES;
+
+/**************************************************************************//**
+ * Part of a command template: either literal text or a variable.
+ *****************************************************************************/
+typedef struct evel_command_segment {
+  const char * text;          /** Literal text, not NUL-terminated.          */
+  size_t length;
+  int variable;               /** Index of the variable, or -1 if literal.   */
+} EVEL_COMMAND_SEGMENT;
+
+/**************************************************************************//**
+ * A command template such as:
  *
- * @note    The mandatory fields on the Syslog must be supplied to this factory
- *          function and are immutable once set.  Optional fields have explicit
- *          setter functions, but again values may only be set once so that the
- *          Syslog has immutable properties.
+ *   cat /proc/net/dev | grep $tmp_device | ... | cut -d ' ' -f2
  *
- * @param event_name    Unique Event Name
- * @param event_id    A universal identifier of the event for analysis etc
- * @param new_state     The new state of the reporting entity.
- * @param old_state     The old state of the reporting entity.
- * @param interface     The card or port name of the reporting entity.
+ * split once into literal and variable segments, so that it can be
+ * rendered for each set of values without searching the text again.
  *
- * @returns pointer to the newly manufactured ::EVENT_STATE_CHANGE.  If the
- *          event is not used it must be released using
- *          ::evel_free_state_change
- * @retval  NULL  Failed to create the event.
+ * Commands which read a counter from /proc/net/dev for the interface named
+ * by a variable are recognised, and can be answered from an interface
+ * snapshot instead of a shell pipeline.
  *****************************************************************************/
-EVENT_STATE_CHANGE * evel_new_state_change(const char* ev_name, const char *ev_id,
-					   const EVEL_ENTITY_STATE new_state,
-                                           const EVEL_ENTITY_STATE old_state,
-                                           const char * const interface);
+typedef struct evel_command {
+  EVEL_COMMAND_TYPES type;
+  char * text;                /** Copy of the template.                      */
+  int num_segments;
+  EVEL_COMMAND_SEGMENT * segments;
+  size_t literal_length;      /** Total length of the literal segments.      */
+  int if_variable;            /** Variable naming the interface.             */
+  size_t if_field;            /** Offset of the counter in ::EVEL_IF_STATS.  */
+} EVEL_COMMAND;
 
 /**************************************************************************//**
- * Free a State Change.
+ * Compile a command template.
  *
- * Free off the State Change supplied.  Will free all the contained allocated
- * memory.
+ * Variables are written as "$name" in the template, and must not be
+ * followed by a letter, digit or underscore.
  *
- * @note It does not free the State Change itself, since that may be part of a
- * larger structure.
+ * @param command   The command to initialize.
+ * @param text      The template.
+ * @param variables Names of the variables, without the '$'.
+ * @param num_variables  Number of variables.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_OUT_OF_MEMORY On failure.
  *****************************************************************************/
-void evel_free_state_change(EVENT_STATE_CHANGE * const state_change);
+EVEL_ERR_CODES evel_command_compile(EVEL_COMMAND * const command,
+                                    const char * const text,
+                                    const char * const * variables,
+                                    const int num_variables);
 
 /**************************************************************************//**
- * Set the Event Type property of the State Change.
+ * Free the memory held by a compiled command.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param command   The command.
+ *****************************************************************************/
+void evel_command_free(EVEL_COMMAND * const command);
+
+/**************************************************************************//**
+ * Render a command with values for its variables.
  *
- * @param state_change  Pointer to the ::EVENT_STATE_CHANGE.
- * @param type          The Event Type to be set. ASCIIZ string. The caller
- *                      does not need to preserve the value once the function
- *                      returns.
+ * @param command   The command.
+ * @param values    Values of the variables, in the order they were named.
+ * @param buffer    Where to put the command, NUL-terminated.
+ * @param size      Size of @p buffer.
+ *
+ * @returns Length of the whole command, which was truncated if this is not
+ *          less than @p size.
  *****************************************************************************/
-void evel_state_change_type_set(EVENT_STATE_CHANGE * const state_change,
-                                const char * const type);
+size_t evel_command_render(const EVEL_COMMAND * const command,
+                           const char * const * values,
+                           char * const buffer,
+                           const size_t size);
 
 /**************************************************************************//**
- * Add an additional field name/value pair to the State Change.
+ * Run a command and get the last line of its output.
  *
- * The name and value are null delimited ASCII strings.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * A command recognised as reading an interface counter is answered from
+ * @p snapshot without starting a process, if one is given.
  *
- * @param state_change  Pointer to the ::EVENT_STATE_CHANGE.
- * @param name          ASCIIZ string with the attribute's name.  The caller
- *                      does not need to preserve the value once the function
- *                      returns.
- * @param value         ASCIIZ string with the attribute's value.  The caller
- *                      does not need to preserve the value once the function
- *                      returns.
+ * @param command   The command.
+ * @param values    Values of the variables, in the order they were named.
+ * @param snapshot  Interface counters, or NULL to always use the shell.
+ * @param result    Where to put the output, NUL-terminated.
+ * @param size      Size of @p result.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
  *****************************************************************************/
-void evel_state_change_addl_field_add(EVENT_STATE_CHANGE * const state_change,
-                                      const char * const name,
-                                      const char * const value);
+EVEL_ERR_CODES evel_command_run(const EVEL_COMMAND * const command,
+                                const char * const * values,
+                                const EVEL_IF_SNAPSHOT * const snapshot,
+                                char * const result,
+                                const size_t size);
 
 /*****************************************************************************/
 /*****************************************************************************/
 /*                                                                           */
-/*   SYSLOG                                                                  */
+/*   PROBES                                                                  */
 /*                                                                           */
 /*****************************************************************************/
 /*****************************************************************************/
 
 /**************************************************************************//**
- * Create a new syslog event.
+ * How a probe ended.
+ *****************************************************************************/
+typedef enum {
+  EVEL_PROBE_SUCCESS,         /** Ran, and exited with status 0.             */
+  EVEL_PROBE_FAILED,          /** Could not be run, or exited with an error. */
+  EVEL_PROBE_TIMED_OUT        /** Killed for running too long.               */
+} EVEL_PROBE_STATES;
+
+/**************************************************************************//**
+ * One command to run as part of a batch, with where its result goes.
  *
- * @note    The mandatory fields on the Syslog must be supplied to this factory
- *          function and are immutable once set.  Optional fields have explicit
- *          setter functions, but again values may only be set once so that the
- *          Syslog has immutable properties.
+ * The caller keeps the probes in whatever order suits it, typically one per
+ * link and key, so each result can be found by its index.
+ *****************************************************************************/
+typedef struct evel_probe {
+  const EVEL_COMMAND * command;
+  const char * const * values;  /** Values of the command's variables.       */
+  char * result;              /** Last line of output, NUL-terminated.       */
+  size_t result_size;
+  EVEL_PROBE_STATES state;
+  int exit_status;            /** Exit status, if the command exited.        */
+} EVEL_PROBE;
+
+/**************************************************************************//**
+ * What running a batch of probes cost.
+ *****************************************************************************/
+typedef struct evel_probe_stats {
+  unsigned long long runtime; /** Microseconds from start to last result.    */
+  int num_probes;
+  int num_native;             /** Answered from interface counters.          */
+  int num_failed;
+  int num_timed_out;
+} EVEL_PROBE_STATS;
+
+/**************************************************************************//**
+ * Run a batch of probes, at most @p max_workers at a time.
  *
- * @param event_name    Unique Event Name
- * @param event_id    A universal identifier of the event for analysis etc
- * @param   event_source_type
- * @param   syslog_msg
- * @param   syslog_tag
- * @param   version
+ * Commands recognised as reading interface counters are answered from
+ * @p snapshot, if given.  The rest are started with posix_spawn() through
+ * the shell, and their output collected through non-blocking pipes watched
+ * by a single epoll set.  A command still running after @p timeout_ms is
+ * killed, along with any pipeline it started.
  *
- * @returns pointer to the newly manufactured ::EVENT_SYSLOG.  If the event is
- *          not used it must be released using ::evel_free_syslog
- * @retval  NULL  Failed to create the event.
+ * @param probes    The probes.
+ * @param num_probes  Number of probes.
+ * @param snapshot  Interface counters, or NULL to always use the shell.
+ * @param max_workers  Most commands to run at once.
+ * @param timeout_ms  Longest each command may run, in milliseconds.
+ * @param stats     Where to put what the batch cost, or NULL.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS If every probe was run, whatever its result.
+ * @retval  "One of ::EVEL_ERR_CODES" If the batch could not be run.
  *****************************************************************************/
-EVENT_SYSLOG * evel_new_syslog(const char* ev_name, const char *ev_id,
-				EVEL_SOURCE_TYPES event_source_type,
-                               const char * const syslog_msg,
-                               const char * const syslog_tag);
+EVEL_ERR_CODES evel_probe_run(EVEL_PROBE * const probes,
+                              const int num_probes,
+                              const EVEL_IF_SNAPSHOT * const snapshot,
+                              const int max_workers,
+                              const int timeout_ms,
+                              EVEL_PROBE_STATS * const stats);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   SCHEDULING                                                              */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Resolution of the scheduler, in milliseconds.  Job intervals are rounded  */
+/* up to a whole number of ticks.                                            */
+/*****************************************************************************/
+#define EVEL_SCHEDULER_TICK_MS 100
 
 /**************************************************************************//**
- * Set the Event Type property of the Syslog.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Function run by the scheduler for a job.
  *
- * @param syslog      Pointer to the syslog.
- * @param type        The Event Type to be set. ASCIIZ string. The caller
- *                    does not need to preserve the value once the function
- *                    returns.
+ * @param context     The context given when the job was added.
+ * @param scheduled   Wall-clock time, in microseconds since the epoch, of
+ *                    the interval boundary that the run is for.  Successive
+ *                    runs are exactly one interval apart, however late each
+ *                    one starts.
+ *****************************************************************************/
+typedef void (*EVEL_SCHEDULER_FN)(void * context,
+                                  unsigned long long scheduled);
+
+/**************************************************************************//**
+ * Periodic jobs, each run at the boundaries of its interval on the wall
+ * clock, by a small pool of worker threads.
  *****************************************************************************/
-void evel_syslog_type_set(EVENT_SYSLOG * syslog,
-                          const char * const type);
+typedef struct evel_scheduler EVEL_SCHEDULER;
 
 /**************************************************************************//**
- * Free a Syslog.
- *
- * Free off the Syslog supplied.  Will free all the contained allocated memory.
- *
- * @note It does not free the Syslog itself, since that may be part of a
- * larger structure.
+ * A job added to a scheduler.  Owned by the scheduler.
  *****************************************************************************/
-void evel_free_syslog(EVENT_SYSLOG * event);
+typedef struct evel_scheduler_job EVEL_SCHEDULER_JOB;
 
 /**************************************************************************//**
- * Add an additional field name/value pair to the Syslog.
+ * Create a scheduler.  Jobs are added with evel_scheduler_job_add(), and
+ * run once evel_scheduler_start() is called.
  *
- * The name and value are null delimited ASCII strings.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * @param num_workers   Number of jobs that can run at the same time.
  *
- * @param syslog    Pointer to the syslog.
- * @param name      ASCIIZ string with the attribute's name.  The caller
- *                  does not need to preserve the value once the function
- *                  returns.
- * @param value     ASCIIZ string with the attribute's value.  The caller
- *                  does not need to preserve the value once the function
- *                  returns.
+ * @returns pointer to the new scheduler.
+ * @retval  NULL  Failed to create the scheduler.
  *****************************************************************************/
-void evel_syslog_addl_field_add(EVENT_SYSLOG * syslog,
-                                char * name,
-                                char * value);
+EVEL_SCHEDULER * evel_new_scheduler(const int num_workers);
 
 /**************************************************************************//**
- * Set the Event Source Host property of the Syslog.
+ * Stop a scheduler if it is running, and free it and its jobs.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
- *
- * @param syslog      Pointer to the Syslog.
- * @param host        The Event Source Host to be set.  ASCIIZ string. The
- *                    caller does not need to preserve the value once the
- *                    function returns.
+ * @param scheduler   The scheduler.
  *****************************************************************************/
-void evel_syslog_event_source_host_set(EVENT_SYSLOG * syslog,
-                                       const char * const host);
+void evel_free_scheduler(EVEL_SCHEDULER * scheduler);
 
 /**************************************************************************//**
- * Set the Syslog Facility property of the Syslog.
+ * Add a periodic job.  It is first run at the next multiple of its interval
+ * on the wall clock, so that for example a 60 second job runs on the
+ * minute.  A run that comes due while the previous one is still going is
+ * skipped.  Jobs may be added while the scheduler is running.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param scheduler     The scheduler.
+ * @param name          ASCIIZ name of the job, for logging.
+ * @param interval_ms   Interval in milliseconds.
+ * @param function      Function to run.
+ * @param context       Context passed to function.
  *
- * @param syslog      Pointer to the Syslog.
- * @param facility    The Syslog Facility to be set.  ASCIIZ string. The caller
- *                    does not need to preserve the value once the function
- *                    returns.
+ * @returns pointer to the job.
+ * @retval  NULL  Failed to add the job.
  *****************************************************************************/
-void evel_syslog_facility_set(EVENT_SYSLOG * syslog,
-                              EVEL_SYSLOG_FACILITIES facility);
+EVEL_SCHEDULER_JOB * evel_scheduler_job_add(EVEL_SCHEDULER * const scheduler,
+                                            const char * const name,
+                                            const int interval_ms,
+                                            EVEL_SCHEDULER_FN function,
+                                            void * context);
 
 /**************************************************************************//**
- * Set the Process property of the Syslog.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Change the interval of a job, for example when its configuration is
+ * reloaded.  Its next run after the current one is at the next multiple of
+ * the new interval.
  *
- * @param syslog      Pointer to the Syslog.
- * @param proc        The Process to be set.  ASCIIZ string. The caller does
- *                    not need to preserve the value once the function returns.
+ * @param job           The job.
+ * @param interval_ms   Interval in milliseconds.
  *****************************************************************************/
-void evel_syslog_proc_set(EVENT_SYSLOG * syslog, const char * const proc);
+void evel_scheduler_job_interval_set(EVEL_SCHEDULER_JOB * const job,
+                                     const int interval_ms);
 
 /**************************************************************************//**
- * Set the Process ID property of the Syslog.
+ * Start the timer and worker threads.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param scheduler   The scheduler.
  *
- * @param syslog      Pointer to the Syslog.
- * @param proc_id     The Process ID to be set.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success, or if the scheduler is already running.
+ * @retval  EVEL_PTHREAD_LIBRARY_FAIL The threads could not be started.
+ * @retval  EVEL_ERR_GEN_FAIL The timer could not be set.
  *****************************************************************************/
-void evel_syslog_proc_id_set(EVENT_SYSLOG * syslog, int proc_id);
+EVEL_ERR_CODES evel_scheduler_start(EVEL_SCHEDULER * const scheduler);
 
 /**************************************************************************//**
- * Set the Version property of the Syslog.
+ * Stop the timer and worker threads, waiting for any running jobs.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param scheduler   The scheduler.
+ *****************************************************************************/
+void evel_scheduler_stop(EVEL_SCHEDULER * const scheduler);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   LOG TAILING                                                             */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/**************************************************************************//**
+ * Function given each line added to a followed file.
  *
- * @param syslog      Pointer to the Syslog.
- * @param version     The Version to be set.
+ * @param context   The context given to evel_tail_wait().
+ * @param line      The line, NUL-terminated and without its newline.  Only
+ *                  valid during the call.
+ * @param length    Length of the line.
  *****************************************************************************/
-void evel_syslog_version_set(EVENT_SYSLOG * syslog, int version);
+typedef void (*EVEL_TAIL_LINE_FN)(void * context,
+                                  const char * line,
+                                  size_t length);
 
 /**************************************************************************//**
- * Set the Structured Data property of the Syslog.
+ * A log file being followed through writes, truncation and rotation.
+ *****************************************************************************/
+typedef struct evel_tail EVEL_TAIL;
+
+/**************************************************************************//**
+ * Start following a file.  Only lines added after this call are handed on.
+ * The file need not exist yet, but its directory must.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param path      Path of the file.
  *
- * @param syslog      Pointer to the Syslog.
- * @param s_data      The Structured Data to be set.  ASCIIZ string. The caller
- *                    does not need to preserve the value once the function
- *                    returns.
+ * @returns pointer to the new tail.
+ * @retval  NULL  Failed to create the tail.
  *****************************************************************************/
-void evel_syslog_s_data_set(EVENT_SYSLOG * syslog, const char * const s_data);
+EVEL_TAIL * evel_new_tail(const char * const path);
 
 /**************************************************************************//**
- * Set the Structured SDID property of the Syslog.
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Stop following a file, and free the tail.
  *
- * @param syslog     Pointer to the Syslog.
- * @param sdid     The Structured Data to be set. ASCIIZ string. name@number
- *                 Caller does not need to preserve the value once the function
- *                   returns.
+ * @param tail      The tail.
  *****************************************************************************/
-void evel_syslog_sdid_set(EVENT_SYSLOG * syslog, const char * const sdid);
+void evel_free_tail(EVEL_TAIL * tail);
 
 /**************************************************************************//**
- * Set the Structured Severity property of the Syslog.
+ * Wait until the file is written to, or replaced by rotation, and hand on
+ * each complete line added since the last call.  When the file is rotated,
+ * the rest of the old file is handed on before the new one.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param tail        The tail.
+ * @param timeout_ms  Longest time to wait, in milliseconds.
+ * @param function    Function to hand lines to.
+ * @param context     Context passed to function.
  *
- * @param syslog     Pointer to the Syslog.
- * @param sdid     The Structured Data to be set. ASCIIZ string. 
- *                 Caller does not need to preserve the value once the function
- *                   returns.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success, including when the wait times out.
+ * @retval  EVEL_ERR_GEN_FAIL Waiting failed.
  *****************************************************************************/
-void evel_syslog_severity_set(EVENT_SYSLOG * syslog, const char * const severty);
-
+EVEL_ERR_CODES evel_tail_wait(EVEL_TAIL * const tail,
+                              const int timeout_ms,
+                              EVEL_TAIL_LINE_FN function,
+                              void * context);
 
 /*****************************************************************************/
 /*****************************************************************************/
 /*                                                                           */
-/*   OTHER                                                                   */
+/*   LINE MATCHING                                                           */
 /*                                                                           */
 /*****************************************************************************/
 /*****************************************************************************/
 
 /**************************************************************************//**
- * Create a new other event.
+ * A set of include and exclude substrings, compiled so that a line is
+ * matched against all of them in a single pass.
+ *****************************************************************************/
+typedef struct evel_matcher EVEL_MATCHER;
+
+/**************************************************************************//**
+ * Create a matcher with no patterns.
  *
- * @param event_name    Unique Event Name
- * @param event_id    A universal identifier of the event for analysis etc
+ * @returns pointer to the new matcher.
+ * @retval  NULL  Failed to allocate the matcher.
+ *****************************************************************************/
+EVEL_MATCHER * evel_new_matcher(void);
+
+/**************************************************************************//**
+ * Free a matcher.
  *
- * @returns pointer to the newly manufactured ::EVENT_OTHER.  If the event is
- *          not used it must be released using ::evel_free_other.
- * @retval  NULL  Failed to create the event.
+ * @param matcher   The matcher.  May be NULL.
  *****************************************************************************/
-EVENT_OTHER * evel_new_other(const char* ev_name, const char *ev_id);
+void evel_free_matcher(EVEL_MATCHER * matcher);
 
 /**************************************************************************//**
- * Free an Other.
+ * Add a pattern which makes a line match.
  *
- * Free off the Other supplied.  Will free all the contained allocated memory.
+ * @param matcher   The matcher.
+ * @param pattern   The pattern, matched anywhere in the line.
+ * @param id        Identifier returned when this pattern decides the match.
+ *                  Must not be negative.
  *
- * @note It does not free the Other itself, since that may be part of a
- * larger structure.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_ERR_GEN_FAIL The pattern is empty.
+ * @retval  EVEL_OUT_OF_MEMORY Failed to allocate the pattern.
  *****************************************************************************/
-void evel_free_other(EVENT_OTHER * event);
+EVEL_ERR_CODES evel_matcher_include(EVEL_MATCHER * const matcher,
+                                    const char * const pattern,
+                                    const int id);
 
 /**************************************************************************//**
- * Set the Event Type property of the Other.
+ * Add a pattern which stops a line matching, whatever else it contains.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param matcher   The matcher.
+ * @param pattern   The pattern, matched anywhere in the line.
  *
- * @param other       Pointer to the Other.
- * @param type        The Event Type to be set. ASCIIZ string. The caller
- *                    does not need to preserve the value once the function
- *                    returns.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_ERR_GEN_FAIL The pattern is empty.
+ * @retval  EVEL_OUT_OF_MEMORY Failed to allocate the pattern.
  *****************************************************************************/
-void evel_other_type_set(EVENT_OTHER * other,
-                         const char * const type);
+EVEL_ERR_CODES evel_matcher_exclude(EVEL_MATCHER * const matcher,
+                                    const char * const pattern);
 
 /**************************************************************************//**
- * Add a value name/value pair to the Other.
+ * Compile the patterns added so far.  Must be called before matching, and
+ * again after adding more patterns.
  *
- * The name and value are null delimited ASCII strings.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * @param matcher   The matcher.
  *
- * @param other     Pointer to the Other.
- * @param name      ASCIIZ string with the attribute's name.
- * @param value     ASCIIZ string with the attribute's value.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_OUT_OF_MEMORY Failed to allocate the automaton.
  *****************************************************************************/
-void evel_other_field_add(EVENT_OTHER * other,
-                          char * name,
-                          char * value);
+EVEL_ERR_CODES evel_matcher_compile(EVEL_MATCHER * const matcher);
+
+/**************************************************************************//**
+ * Match a line in one pass.  A compiled matcher may be used by several
+ * threads at once.
+ *
+ * @param matcher   The compiled matcher.
+ * @param text      The line.
+ * @param length    Length of the line.
+ *
+ * @returns Identifier of the first-added include pattern in the line, or -1
+ *          if the line contains no include pattern or any exclude pattern.
+ *****************************************************************************/
+int evel_matcher_match(const EVEL_MATCHER * const matcher,
+                       const char * const text,
+                       const size_t length);
 
 /*****************************************************************************/
 /*****************************************************************************/
 /*                                                                           */
-/*   THROTTLING                                                              */
+/*   SYSLOG RECEIVER                                                         */
 /*                                                                           */
 /*****************************************************************************/
 /*****************************************************************************/
 
 /**************************************************************************//**
- * Return the current measurement interval provided by the Event Listener.
+ * A received syslog message, parsed as RFC 5424 or RFC 3164.  Fields the
+ * message does not have are NULL, or 0 for proc_id.
+ *****************************************************************************/
+typedef struct evel_syslog_message {
+  const char * text;          /** The message as received, NUL-terminated.   */
+  size_t length;
+  int facility;               /** ::EVEL_SYSLOG_FACILITIES value.            */
+  int severity;               /** 0 (emergency) to 7 (debug).                */
+  int version;                /** 1 for RFC 5424, 0 for RFC 3164.            */
+  const char * timestamp;
+  const char * hostname;
+  const char * app_name;      /** APP-NAME, or the RFC 3164 tag.             */
+  int proc_id;
+  const char * msg_id;
+  const char * structured_data;
+  char sdid[33];              /** First SD-ID, or empty.                     */
+  const char * message;       /** MSG, NUL-terminated.                       */
+  size_t message_length;
+} EVEL_SYSLOG_MESSAGE;
+
+/**************************************************************************//**
+ * Function given each message received.
  *
- * @returns The current measurement interval
- * @retval  EVEL_MEASUREMENT_INTERVAL_UKNOWN (0) - interval has not been
- *          specified
+ * @param context   The context given to evel_syslog_receiver_wait().
+ * @param message   The message.  Only valid during the call.
  *****************************************************************************/
-int evel_get_measurement_interval();
+typedef void (*EVEL_SYSLOG_MESSAGE_FN)(void * context,
+                                       const EVEL_SYSLOG_MESSAGE * message);
 
-/*****************************************************************************/
-/* Supported Report version.                                                 */
-/*****************************************************************************/
-#define EVEL_VOICEQ_MAJOR_VERSION 1
-#define EVEL_VOICEQ_MINOR_VERSION 0
+/**************************************************************************//**
+ * Sockets on which syslog messages are received.
+ *****************************************************************************/
+typedef struct evel_syslog_receiver EVEL_SYSLOG_RECEIVER;
 
 /**************************************************************************//**
- * End of Call Voice Quality Metrices
- * JSON equivalent field: endOfCallVqmSummaries
+ * Get the VES name of a syslog severity.
+ *
+ * @param severity  The severity, 0 (emergency) to 7 (debug).
+ *
+ * @returns The name, such as "Warning".
  *****************************************************************************/
-typedef struct end_of_call_vqm_summaries {
-	/***************************************************************************/
-	/* Mandatory fields                                                        */
-	/***************************************************************************/
-	char* adjacencyName;
-	char* endpointDescription;
+const char * evel_syslog_severity_name(const int severity);
 
-	/***************************************************************************/
-	/* Optional fields                                                         */
-	/***************************************************************************/
-	EVEL_OPTION_INT endpointJitter;
-	EVEL_OPTION_INT endpointRtpOctetsDiscarded;
-	EVEL_OPTION_INT endpointRtpOctetsReceived;
-	EVEL_OPTION_INT endpointRtpOctetsSent;
-	EVEL_OPTION_INT endpointRtpPacketsDiscarded;
-	EVEL_OPTION_INT endpointRtpPacketsReceived;
-	EVEL_OPTION_INT endpointRtpPacketsSent;
-	EVEL_OPTION_INT localJitter;
-	EVEL_OPTION_INT localRtpOctetsDiscarded;
-	EVEL_OPTION_INT localRtpOctetsReceived;
-	EVEL_OPTION_INT localRtpOctetsSent;
-	EVEL_OPTION_INT localRtpPacketsDiscarded;
-	EVEL_OPTION_INT localRtpPacketsReceived;
-	EVEL_OPTION_INT localRtpPacketsSent;
-	EVEL_OPTION_INT mosCqe;
-	EVEL_OPTION_INT packetsLost;
-	EVEL_OPTION_INT packetLossPercent;
-	EVEL_OPTION_INT rFactor;
-	EVEL_OPTION_INT roundTripDelay;
+/**************************************************************************//**
+ * Parse a syslog message.
+ *
+ * @param text      The message as received.
+ * @param length    Length of the message.
+ * @param fields    Space for the parsed fields, at least length + 1 bytes.
+ * @param message   The message to fill in.  Its strings point into fields
+ *                  and text.
+ *****************************************************************************/
+void evel_syslog_parse(const char * const text,
+                       const size_t length,
+                       char * const fields,
+                       EVEL_SYSLOG_MESSAGE * const message);
 
-} END_OF_CALL_VOICE_QUALITY_METRICS;
+/**************************************************************************//**
+ * Create a receiver with no sockets.
+ *
+ * @returns pointer to the new receiver.
+ * @retval  NULL  Failed to allocate the receiver.
+ *****************************************************************************/
+EVEL_SYSLOG_RECEIVER * evel_new_syslog_receiver(void);
 
 /**************************************************************************//**
-* Voice QUality.
-* JSON equivalent field: voiceQualityFields
-*****************************************************************************/
+ * Close a receiver's sockets, removing its Unix sockets, and free it.
+ *
+ * @param receiver  The receiver.  May be NULL.
+ *****************************************************************************/
+void evel_free_syslog_receiver(EVEL_SYSLOG_RECEIVER * receiver);
 
-typedef struct event_voiceQuality {
-	/***************************************************************************/
-	/* Header and version                                                      */
-	/***************************************************************************/
-	EVENT_HEADER header;
-	int major_version;
-	int minor_version;
+/**************************************************************************//**
+ * Listen on a Unix datagram socket, such as /dev/log.  A socket left at the
+ * path by an earlier run is replaced.
+ *
+ * @param receiver  The receiver.
+ * @param path      Path of the socket.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_ERR_GEN_FAIL The socket could not be created.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_syslog_receiver_unix(EVEL_SYSLOG_RECEIVER * const receiver,
+                                         const char * const path);
+
+/**************************************************************************//**
+ * Listen on UDP, on each address the name resolves to.
+ *
+ * @param receiver  The receiver.
+ * @param address   Address or host name to bind to, or NULL for all.
+ * @param port      The port, usually 514.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_ERR_GEN_FAIL No socket could be bound.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_syslog_receiver_udp(EVEL_SYSLOG_RECEIVER * const receiver,
+                                        const char * const address,
+                                        const int port);
+
+/**************************************************************************//**
+ * Wait for messages, and hand on each one received.  Messages waiting on
+ * a socket are read in batches.
+ *
+ * @param receiver    The receiver.
+ * @param timeout_ms  Longest time to wait, in milliseconds.
+ * @param function    Function to hand messages to.
+ * @param context     Context passed to function.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success, including when the wait times out.
+ * @retval  EVEL_ERR_GEN_FAIL Waiting failed.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_syslog_receiver_wait(EVEL_SYSLOG_RECEIVER * const receiver,
+                                         const int timeout_ms,
+                                         EVEL_SYSLOG_MESSAGE_FN function,
+                                         void * context);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   THRESHOLD RULES                                                         */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/**************************************************************************//**
+ * What a threshold rule compares.
+ *****************************************************************************/
+typedef enum {
+  EVEL_RULE_ABSOLUTE,         /** The metric's latest sample.                */
+  EVEL_RULE_RATE,             /** The per-second change between the latest   */
+                              /** two samples of the metric.                 */
+  EVEL_RULE_RATIO,            /** The metric's latest sample divided by the  */
+                              /** denominator's.                             */
+  EVEL_MAX_RULE_TYPES
+} EVEL_RULE_TYPES;
 
-	/***************************************************************************/
-	/* Mandatory fields                                                        */
-	/***************************************************************************/
-	
-	char *calleeSideCodec;
-	char *callerSideCodec;
-	char *correlator;
-	char *midCallRtcp;
-	VENDOR_VNFNAME_FIELD vendorVnfNameFields;
-	END_OF_CALL_VOICE_QUALITY_METRICS *endOfCallVqmSummaries;
+/**************************************************************************//**
+ * Which side of the set threshold raises a rule.
+ *****************************************************************************/
+typedef enum {
+  EVEL_RULE_ABOVE,
+  EVEL_RULE_BELOW,
+  EVEL_MAX_RULE_DIRECTIONS
+} EVEL_RULE_DIRECTIONS;
 
-	/***************************************************************************/
-	/* Optional fields                                                         */
-	/***************************************************************************/
-	EVEL_OPTION_STRING phoneNumber;
-	DLIST additionalInformation;
+/**************************************************************************//**
+ * A threshold rule.
+ *
+ * A rule above its threshold is raised once the value has been above
+ * set_threshold for set_after_ms, and cleared once it has been at or below
+ * clear_threshold for clear_after_ms; a rule below its threshold is the
+ * mirror image.  Setting clear_threshold short of set_threshold gives the
+ * rule hysteresis, and the delays debounce it.
+ *****************************************************************************/
+typedef struct evel_rule_spec {
+  const char * name;
+  const char * metric;
+  const char * denominator;   /** Only for ::EVEL_RULE_RATIO.                */
+  EVEL_RULE_TYPES type;
+  EVEL_RULE_DIRECTIONS direction;
+  double set_threshold;
+  double clear_threshold;
+  int set_after_ms;
+  int clear_after_ms;
+  EVEL_SEVERITIES severity;
+  EVEL_ALERT_TYPE alert_type;
+  const char * description;   /** Defaults to the name if NULL.              */
+  void * context;             /** Passed back in each ::EVEL_RULE_ALERT.     */
+} EVEL_RULE_SPEC;
 
-} EVENT_VOICE_QUALITY;
 /**************************************************************************//**
- * Voice Quality Additional Info.
- * JSON equivalent field: additionalInformation
+ * A rule being raised or cleared.  Times are in microseconds from
+ * evel_time_monotonic_usec(); the strings last as long as the rule set.
  *****************************************************************************/
-typedef struct voice_quality_additional_info {
-  char * name;
-  char * value;
-} VOICE_QUALITY_ADDL_INFO;
+typedef struct evel_rule_alert {
+  const char * rule;
+  const char * metric;
+  const char * description;
+  EVEL_EVENT_ACTION action;   /** ::EVEL_EVENT_ACTION_SET or _CLEAR.         */
+  double value;               /** The value which raised or cleared it.      */
+  double threshold;           /** The threshold it crossed.                  */
+  EVEL_SEVERITIES severity;   /** ::EVEL_SEVERITY_NORMAL when cleared.       */
+  EVEL_ALERT_TYPE alert_type;
+  void * context;
+  unsigned long long start_usec;
+  unsigned long long now_usec;
+} EVEL_RULE_ALERT;
 
 /**************************************************************************//**
- * Create a new voice quality event.
+ * Function called as soon as a sample, or for a ratio the end of a round of
+ * samples, raises or clears a rule.  It is
+ * called with the rule set locked, so must not call back into the rule set.
  *
- * @note    The mandatory fields on the Voice Quality must be supplied to this 
- *          factory function and are immutable once set.  Optional fields have 
- *          explicit setter functions, but again values may only be set once 
- *          so that the Voice Quality has immutable properties.
- * @param event_name    Unique Event Name
- * @param event_id    A universal identifier of the event for analysis etc
- * @param   calleeSideCodec			Callee codec for the call.
- * @param   callerSideCodec			Caller codec for the call.
- * @param   correlator				Constant across all events on this call.
- * @param   midCallRtcp				Base64 encoding of the binary RTCP data
- *									(excluding Eth/IP/UDP headers).
- * @param   vendorVnfNameFields		Vendor, VNF and VfModule names.
- * @returns pointer to the newly manufactured ::EVENT_VOICE_QUALITY.  If the 
- *          event is not used (i.e. posted) it must be released using
-			::evel_free_voice_quality.
- * @retval  NULL  Failed to create the event.
+ * @param context   The context given when the rule set was created.
+ * @param alert     The alert.
  *****************************************************************************/
-EVENT_VOICE_QUALITY * evel_new_voice_quality(const char* ev_name, const char *ev_id,
-	const char * const calleeSideCodec,
-	const char * const callerSideCodec, const char * const correlator,
-	const char * const midCallRtcp, const char * const vendorVnfNameFields);
+typedef void (*EVEL_RULE_ALERT_FN)(void * context,
+                                   const EVEL_RULE_ALERT * const alert);
 
 /**************************************************************************//**
- * Set the Callee side codec for Call for domain Voice Quality
+ * A set of threshold rules, evaluated as their metrics are sampled.  Each
+ * sample only evaluates the rules which read that metric, except ratios,
+ * which are evaluated by evel_rules_round_end() once both metrics have been
+ * sampled in the same round.
+ *****************************************************************************/
+typedef struct evel_rules EVEL_RULES;
+
+/**************************************************************************//**
+ * Create an empty rule set.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param alert     Function to call when a rule is raised or cleared.
+ * @param context   Context passed to alert.
  *
- * @param voiceQuality				Pointer to the Voice Quality Event.
- * @param calleeCodecForCall		The Callee Side Codec to be set.  ASCIIZ 
- *									string. The caller does not need to 
- *									preserve the value once the function
- *									returns.
+ * @returns pointer to the new rule set.
+ * @retval  NULL  Failed to create the rule set.
  *****************************************************************************/
-void evel_voice_quality_callee_codec_set(EVENT_VOICE_QUALITY * voiceQuality,
-									const char * const calleeCodecForCall);
+EVEL_RULES * evel_new_rules(EVEL_RULE_ALERT_FN alert, void * context);
 
 /**************************************************************************//**
- * Set the Caller side codec for Call for domain Voice Quality
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Free a rule set.  No alert is raised for rules which are still raised.
  *
- * @param voiceQuality				Pointer to the Voice Quality Event.
- * @param callerCodecForCall		The Caller Side Codec to be set.  ASCIIZ 
- *									string. The caller does not need to 
- *									preserve the value once the function
- *									returns.
+ * @param rules     The rule set.  May be NULL.
  *****************************************************************************/
-void evel_voice_quality_caller_codec_set(EVENT_VOICE_QUALITY * voiceQuality,
-									const char * const callerCodecForCall);
+void evel_free_rules(EVEL_RULES * rules);
 
 /**************************************************************************//**
- * Set the correlator for domain Voice Quality
+ * Add a rule.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param rules     The rule set.
+ * @param spec      The rule.  The library takes copies of the strings.
  *
- * @param voiceQuality				Pointer to the Voice Quality Event.
- * @param correlator				The correlator value to be set.  ASCIIZ 
- *									string. The caller does not need to 
- *									preserve the value once the function
- *									returns.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success.
+ * @retval  EVEL_OUT_OF_MEMORY The rule could not be added.
  *****************************************************************************/
-void evel_voice_quality_correlator_set(EVENT_VOICE_QUALITY * voiceQuality,
-									const char * const vCorrelator);
+EVEL_ERR_CODES evel_rules_add(EVEL_RULES * const rules,
+                              const EVEL_RULE_SPEC * const spec);
 
 /**************************************************************************//**
- * Set the RTCP Call Data for domain Voice Quality
+ * Get the identifier of a metric, for passing samples of it to
+ * evel_rules_sample().  A metric no rule reads yet may still be looked up,
+ * and rules added for it later will see its samples.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param rules     The rule set.
+ * @param name      ASCIIZ name of the metric.
  *
- * @param voiceQuality				Pointer to the Voice Quality Event.
- * @param rtcpCallData		        The RTCP Call Data to be set.  ASCIIZ 
- *									string. The caller does not need to 
- *									preserve the value once the function
- *									returns.
+ * @returns The identifier, or -1 if the metric could not be added.
  *****************************************************************************/
-void evel_voice_quality_rtcp_data_set(EVENT_VOICE_QUALITY * voiceQuality,
-									const char * const rtcpCallData);
+int evel_rules_metric(EVEL_RULES * const rules, const char * const name);
 
 /**************************************************************************//**
- * Set the Vendor VNF Name fields for domain Voice Quality
- *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * Record a sample of a metric, and evaluate the rules other than ratios
+ * which read it, calling the alert function for any raised or cleared.
  *
- * @param voiceQuality				Pointer to the Voice Quality Event.
- * @param nameFields		        The Vendor, VNF and VfModule names to be set.   
- *									ASCIIZ string. The caller does not need to 
- *									preserve the value once the function
- *									returns.
+ * @param rules     The rule set.
+ * @param metric    Identifier of the metric, from evel_rules_metric().
+ * @param value     The sample.
+ * @param timestamp When the sample was taken, in microseconds from
+ *                  evel_time_monotonic_usec().
  *****************************************************************************/
-void evel_voice_quality_name_fields_set(EVENT_VOICE_QUALITY * voiceQuality,
-									const char * const nameFields);
+void evel_rules_sample(EVEL_RULES * const rules,
+                       const int metric,
+                       const double value,
+                       const unsigned long long timestamp);
 
 /**************************************************************************//**
- * Add an End of Call Voice Quality Metrices
+ * End a round of samples, evaluating the ratio rules both of whose metrics
+ * were sampled since the last round ended, and calling the alert function
+ * for any raised or cleared.  A sampler ends a round after each time it
+ * samples all its metrics.
+ *
+ * @param rules     The rule set.
+ *****************************************************************************/
+void evel_rules_round_end(EVEL_RULES * const rules);
 
- * The adjacencyName and endpointDescription is null delimited ASCII string.  
- * The library takes a copy so the caller does not have to preserve values
- * after the function returns.
+/**************************************************************************//**
+ * Create a Threshold Crossing Alert for a rule being raised or cleared,
+ * with wall-clock times.  The metric is the performance counter name, and
+ * the rule name the alert ID.
  *
- * @param voiceQuality     Pointer to the measurement.
- * @param adjacencyName						Adjacency name
- * @param endpointDescription				Enumeration: ‘Caller’, ‘Callee’.
- * @param endpointJitter					Endpoint jitter
- * @param endpointRtpOctetsDiscarded        Endpoint RTP octets discarded.
- * @param endpointRtpOctetsReceived			Endpoint RTP octets received.
- * @param endpointRtpOctetsSent				Endpoint RTP octets sent
- * @param endpointRtpPacketsDiscarded		Endpoint RTP packets discarded.
- * @param endpointRtpPacketsReceived		Endpoint RTP packets received.
- * @param endpointRtpPacketsSent			Endpoint RTP packets sent.
- * @param localJitter						Local jitter.
- * @param localRtpOctetsDiscarded			Local RTP octets discarded.
- * @param localRtpOctetsReceived			Local RTP octets received.
- * @param localRtpOctetsSent				Local RTP octets sent.
- * @param localRtpPacketsDiscarded			Local RTP packets discarded.
- * @param localRtpPacketsReceived			Local RTP packets received.
- * @param localRtpPacketsSent				Local RTP packets sent.
- * @param mosCqe							Decimal range from 1 to 5
- *											(1 decimal place)
- * @param packetsLost						No	Packets lost
- * @param packetLossPercent					Calculated percentage packet loss 
- * @param rFactor							rFactor from 0 to 100
- * @param roundTripDelay					Round trip delay in milliseconds
+ * @param alert       The alert.
+ * @param ev_name     ASCIIZ event name.
+ * @param ev_id       ASCIIZ event identifier.
+ *
+ * @returns pointer to the new event, which the caller posts or frees.
+ * @retval  NULL  Failed to create the event.
  *****************************************************************************/
-void evel_voice_quality_end_metrics_add(EVENT_VOICE_QUALITY * voiceQuality,
-	const char * adjacencyName, EVEL_SERVICE_ENDPOINT_DESC endpointDescription,
-	int endpointJitter,
-	int endpointRtpOctetsDiscarded,
-	int endpointRtpOctetsReceived,
-	int endpointRtpOctetsSent,
-	int endpointRtpPacketsDiscarded,
-	int endpointRtpPacketsReceived,
-	int endpointRtpPacketsSent,
-	int localJitter,
-	int localRtpOctetsDiscarded,
-	int localRtpOctetsReceived,
-	int localRtpOctetsSent,
-	int localRtpPacketsDiscarded,
-	int localRtpPacketsReceived,
-	int localRtpPacketsSent,
-	int mosCqe,
-	int packetsLost,
-	int packetLossPercent,
-	int rFactor,
-	int roundTripDelay);
+EVENT_THRESHOLD_CROSS * evel_rules_new_threshold_cross(
+                                          const EVEL_RULE_ALERT * const alert,
+                                          const char * const ev_name,
+                                          const char * const ev_id);
 
 /**************************************************************************//**
- * Free a Voice Quality.
+ * Evaluate a rule set on every sample a sampler takes, ending a round of the
+ * rule set after each round of samples.  Each of the sampler's metrics,
+ * including those added later, is passed to the rule set under its own
+ * name; a rate metric is passed as its rate.
  *
- * Free off the Voce Quality supplied.  Will free all the contained allocated
- * memory.
+ * @param sampler   The sampler.
+ * @param rules     The rule set, which must outlive the sampler, or NULL to
+ *                  stop evaluating rules.
  *
- * @note It does not free the Voice Quality itself, since that may be part of a
- * larger structure.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success.
+ * @retval  EVEL_OUT_OF_MEMORY A metric could not be added to the rule set.
  *****************************************************************************/
-void evel_free_voice_quality(EVENT_VOICE_QUALITY * voiceQuality);
+EVEL_ERR_CODES evel_sampler_rules_set(EVEL_SAMPLER * const sampler,
+                                      EVEL_RULES * const rules);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   DELTA REPORTING                                                         */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
 
 /**************************************************************************//**
- * Add an additional value name/value pair to the Voice Quality.
+ * Enable delta reporting for a domain.
  *
- * The name and value are null delimited ASCII strings.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * Each identified object in an event's lists, such as a vNIC or CPU in a
+ * measurement, is then sent only if one of its fields has changed since the
+ * last event of the same name, and then with only its mandatory fields and
+ * the optional fields which changed.  The first event of each name, and
+ * every refresh_intervals'th after it, is sent in full.
  *
- * @param fault     Pointer to the fault.
- * @param name      ASCIIZ string with the attribute's name.  The caller
- *                  does not need to preserve the value once the function
- *                  returns.
- * @param value     ASCIIZ string with the attribute's value.  The caller
- *                  does not need to preserve the value once the function
- *                  returns.
+ * Calling this again changes the refresh interval only.
+ *
+ * @param domain            The domain.
+ * @param refresh_intervals Send every this many events of the same name in
+ *                          full.  1 sends every event in full.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success.
+ * @retval  EVEL_OUT_OF_MEMORY The state could not be allocated.
  *****************************************************************************/
-void evel_voice_quality_addl_info_add(EVENT_VOICE_QUALITY * voiceQuality, char * name, char * value);
+EVEL_ERR_CODES evel_delta_enable(const EVEL_EVENT_DOMAINS domain,
+                                 const int refresh_intervals);
 
+/**************************************************************************//**
+ * Disable delta reporting for a domain, so that every event is sent in full.
+ *
+ * @param domain        The domain.
+ *****************************************************************************/
+void evel_delta_disable(const EVEL_EVENT_DOMAINS domain);
 
 /*****************************************************************************/
 /*****************************************************************************/
 /*                                                                           */
-/*   THRESHOLD CROSSING ALERT                                                */
+/*   METRICS REGISTRY                                                        */
 /*                                                                           */
 /*****************************************************************************/
 /*****************************************************************************/
 
-typedef enum evel_event_action {
-	  EVEL_EVENT_ACTION_CLEAR,
-	  EVEL_EVENT_ACTION_CONTINUE,
-	  EVEL_EVENT_ACTION_SET,
-	  EVEL_MAX_EVENT_ACTION
-}EVEL_EVENT_ACTION;
-	
-typedef enum evel_alert_type {
-         EVEL_CARD_ANOMALY, 
-   	 EVEL_ELEMENT_ANOMALY, 
-    	 EVEL_INTERFACE_ANOMALY, 
-    	 EVEL_SERVICE_ANOMALY,
-         EVEL_MAX_ANOMALY
-}EVEL_ALERT_TYPE;
+/*****************************************************************************/
+/* Space for a metric's group and name, including the terminating NUL.       */
+/*****************************************************************************/
+#define EVEL_METRICS_GROUP_LEN 32
+#define EVEL_METRICS_NAME_LEN 64
+
+/**************************************************************************//**
+ * Types of metric.
+ *****************************************************************************/
+typedef enum {
+  EVEL_METRIC_COUNTER,
+  EVEL_METRIC_GAUGE,
+  EVEL_MAX_METRIC_TYPES
+} EVEL_METRIC_TYPES;
+
+/*****************************************************************************/
+/* A registry of metrics in shared memory, and one of its metrics.           */
+/*****************************************************************************/
+typedef struct evel_metrics EVEL_METRICS;
+typedef struct evel_metric EVEL_METRIC;
+
+/**************************************************************************//**
+ * A metric as read by ::evel_metrics_snapshot.  Counters are in counter,
+ * gauges in gauge.
+ *****************************************************************************/
+typedef struct evel_metric_value {
+  char group[EVEL_METRICS_GROUP_LEN];
+  char name[EVEL_METRICS_NAME_LEN];
+  EVEL_METRIC_TYPES type;
+  unsigned long long counter;
+  double gauge;
+} EVEL_METRIC_VALUE;
+
+/**************************************************************************//**
+ * Create a registry for an application to add metrics to, replacing any
+ * existing registry at the same path.
+ *
+ * The application updates its metrics with ::evel_metric_increment and
+ * ::evel_metric_set, which are single atomic operations on shared memory,
+ * and a reporter opened with ::evel_new_metrics_reader reads them.  Only one
+ * process should add metrics to a registry, though any of its threads may.
+ *
+ * @param path          The file, normally on /dev/shm.
+ * @param max_metrics   The number of metrics there is room for.
+ *
+ * @returns pointer to the new registry.
+ * @retval  NULL  The file could not be created.
+ *****************************************************************************/
+EVEL_METRICS * evel_new_metrics(const char * const path,
+                                const int max_metrics);
+
+/**************************************************************************//**
+ * Open a registry for reading.  The file need not exist yet: it is mapped
+ * when it is first read, and again whenever the application recreates it.
+ *
+ * @param path          The file.
+ *
+ * @returns pointer to the new registry.
+ * @retval  NULL  Failed to allocate the registry.
+ *****************************************************************************/
+EVEL_METRICS * evel_new_metrics_reader(const char * const path);
+
+/**************************************************************************//**
+ * Free a registry.  An application's registry file is removed.
+ *
+ * @param metrics       The registry.  May be NULL.
+ *****************************************************************************/
+void evel_free_metrics(EVEL_METRICS * const metrics);
+
+/**************************************************************************//**
+ * Add a metric to an application's registry.  Adding a metric with the same
+ * group and name again returns the same metric.
+ *
+ * @param metrics       The registry.
+ * @param group         ASCIIZ group name, shorter than
+ *                      ::EVEL_METRICS_GROUP_LEN.
+ * @param name          ASCIIZ metric name, shorter than
+ *                      ::EVEL_METRICS_NAME_LEN.
+ * @param type          Whether the metric is a counter or a gauge.
+ *
+ * @returns pointer to the metric.
+ * @retval  NULL  The names are too long, the registry is full, or the
+ *                metric exists with the other type.
+ *****************************************************************************/
+EVEL_METRIC * evel_metrics_add(EVEL_METRICS * const metrics,
+                               const char * const group,
+                               const char * const name,
+                               const EVEL_METRIC_TYPES type);
+
+/**************************************************************************//**
+ * Add to a counter.
+ *
+ * @param metric        The counter.
+ * @param delta         The amount to add.
+ *****************************************************************************/
+void evel_metric_increment(EVEL_METRIC * const metric,
+                           const unsigned long long delta);
+
+/**************************************************************************//**
+ * Set a gauge.
+ *
+ * @param metric        The gauge.
+ * @param value         The value.
+ *****************************************************************************/
+void evel_metric_set(EVEL_METRIC * const metric, const double value);
+
+/**************************************************************************//**
+ * Read every metric in a registry in one pass.
+ *
+ * @param metrics       The registry.
+ * @param[out] values   Where to store the values.
+ * @param max_values    The number of values there is room for.
+ *
+ * @returns The number of values stored, which is 0 if a reporter's
+ *          registry file does not exist.
+ *****************************************************************************/
+int evel_metrics_snapshot(EVEL_METRICS * const metrics,
+                          EVEL_METRIC_VALUE * const values,
+                          const int max_values);
 
+/**************************************************************************//**
+ * Add every metric in a registry to a measurement, as a custom measurement
+ * in the metric's group.
+ *
+ * @param metrics       The registry.
+ * @param measurement   The measurement.
+ *
+ * @returns The number of metrics added.
+ *****************************************************************************/
+int evel_metrics_measurement_add(EVEL_METRICS * const metrics,
+                                 EVENT_MEASUREMENT * const measurement);
 
-typedef struct perf_counter {
-	char * criticality;
-	char * name;
-	char * thresholdCrossed;
-	char * value;
-}PERF_COUNTER;
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   COLLECTD RECEIVER                                                       */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
 
+/*****************************************************************************/
+/* Port collectd's network plugin sends to by default.                       */
+/*****************************************************************************/
+#define EVEL_COLLECTD_PORT 25826
 
 /*****************************************************************************/
-/* Supported Threshold Crossing version.                                     */
+/* Space for collectd's names, including the terminating NUL, and the most   */
+/* values in one value list.                                                 */
 /*****************************************************************************/
-#define EVEL_THRESHOLD_CROSS_MAJOR_VERSION 2
-#define EVEL_THRESHOLD_CROSS_MINOR_VERSION 0
+#define EVEL_COLLECTD_NAME_LEN 128
+#define EVEL_COLLECTD_MAX_VALUES 16
 
 /**************************************************************************//**
- * Threshold Crossing.
- * JSON equivalent field: Threshold Cross Fields
+ * Types of collectd value, as numbered by its protocol.
  *****************************************************************************/
-typedef struct event_threshold_cross {
-  /***************************************************************************/
-  /* Header and version                                                      */
-  /***************************************************************************/
-  EVENT_HEADER header;
-  int major_version;
-  int minor_version;
+typedef enum {
+  EVEL_COLLECTD_COUNTER,
+  EVEL_COLLECTD_GAUGE,
+  EVEL_COLLECTD_DERIVE,
+  EVEL_COLLECTD_ABSOLUTE,
+  EVEL_MAX_COLLECTD_TYPES
+} EVEL_COLLECTD_DS_TYPES;
 
-  /***************************************************************************/
-  /* Mandatory fields                                                        */
-  /***************************************************************************/
-  PERF_COUNTER additionalParameters;
-  EVEL_EVENT_ACTION  alertAction;
-  char *             alertDescription; 
-  EVEL_ALERT_TYPE    alertType;
-  unsigned long long collectionTimestamp; 
-  EVEL_SEVERITIES    eventSeverity;
-  unsigned long long eventStartTimestamp;
+/**************************************************************************//**
+ * A value list received from collectd.  Instances it does not have are
+ * empty strings, and times it does not have are 0.  Values other than
+ * gauges are in counters, a derive's as its two's complement.
+ *****************************************************************************/
+typedef struct evel_collectd_values {
+  const char * host;
+  const char * plugin;
+  const char * plugin_instance;
+  const char * type;
+  const char * type_instance;
+  unsigned long long time;        /** Microseconds since the epoch.          */
+  unsigned long long interval;    /** Microseconds.                          */
+  int num_values;
+  EVEL_COLLECTD_DS_TYPES types[EVEL_COLLECTD_MAX_VALUES];
+  unsigned long long counters[EVEL_COLLECTD_MAX_VALUES];
+  double gauges[EVEL_COLLECTD_MAX_VALUES];
+} EVEL_COLLECTD_VALUES;
 
-  /***************************************************************************/
-  /* Optional fields                                                         */
-  /***************************************************************************/
-  DLIST additional_info;
-  EVEL_OPTION_STRING    alertValue;
-  DLIST     alertidList;
-  EVEL_OPTION_STRING    dataCollector;
-  EVEL_OPTION_STRING    elementType;
-  EVEL_OPTION_STRING    interfaceName;
-  EVEL_OPTION_STRING    networkService;
-  EVEL_OPTION_STRING    possibleRootCause;
+/**************************************************************************//**
+ * Function given each value list decoded.
+ *
+ * @param context   The context given to evel_collectd_parse().
+ * @param values    The value list.  Only valid during the call.
+ *****************************************************************************/
+typedef void (*EVEL_COLLECTD_VALUES_FN)(void * context,
+                                        const EVEL_COLLECTD_VALUES * values);
 
-} EVENT_THRESHOLD_CROSS;
+/**************************************************************************//**
+ * Function creating the measurement for a host's values.
+ *
+ * @param context   The context given to evel_collectd_report().
+ * @param host      The host, as collectd named it.
+ *
+ * @returns The measurement to add the host's values to, which the caller
+ *          still owns, or NULL to skip the host.
+ *****************************************************************************/
+typedef EVENT_MEASUREMENT * (*EVEL_COLLECTD_MEASUREMENT_FN)(void * context,
+                                                        const char * host);
 
+/**************************************************************************//**
+ * Sockets on which collectd's metrics are received, and the latest values
+ * received.
+ *****************************************************************************/
+typedef struct evel_collectd EVEL_COLLECTD;
 
 /**************************************************************************//**
- * Create a new Threshold Crossing Alert event.
+ * Decode a datagram of collectd's binary protocol, and hand on each value
+ * list in it.
  *
- * @note    The mandatory fields on the TCA must be supplied to this factory
- *          function and are immutable once set.  Optional fields have explicit
- *          setter functions, but again values may only be set once so that the
- *          TCA has immutable properties.
+ * @param packet    The datagram.
+ * @param length    Length of the datagram.
+ * @param function  Function to hand value lists to.
+ * @param context   Context passed to function.
  *
- * @param event_name    Unique Event Name
- * @param event_id    A universal identifier of the event for analysis etc
- * @param char* tcriticality   Performance Counter Criticality MAJ MIN,
- * @param char* tname          Performance Counter Threshold name
- * @param char* tthresholdCrossed  Counter Threshold crossed value
- * @param char* tvalue             Counter actual value
- * @param EVEL_EVENT_ACTION talertAction   Alert set continue or clear
- * @param char*  talertDescription
- * @param EVEL_ALERT_TYPE     talertType    Kind of anamoly
- * @param unsigned long long  tcollectionTimestamp time at which alert was collected
- * @param EVEL_SEVERITIES     teventSeverity  Severity of Alert
- * @param unsigned long long  teventStartTimestamp Time when this alert started
+ * @returns The number of value lists handed on.
+ * @retval  -1  The datagram is malformed.  Value lists before the fault
+ *              have been handed on.
+ *****************************************************************************/
+int evel_collectd_parse(const void * const packet,
+                        const size_t length,
+                        EVEL_COLLECTD_VALUES_FN function,
+                        void * context);
+
+/**************************************************************************//**
+ * Create a receiver with no sockets.
  *
- * @returns pointer to the newly manufactured ::EVENT_THRESHOLD_CROSS.  If the
- *          event is not used it must be released using
- *          ::evel_free_threshold_cross
- * @retval  NULL  Failed to create the event.
+ * @returns pointer to the new receiver.
+ * @retval  NULL  Failed to allocate the receiver.
  *****************************************************************************/
-EVENT_THRESHOLD_CROSS * evel_new_threshold_cross(
-				const char* ev_name, const char *ev_id,
-                               char * tcriticality,
-	                       char * tname,
-	                       char * tthresholdCrossed,
-	                       char * tvalue,
-                               EVEL_EVENT_ACTION  talertAction,
-                               char *             talertDescription, 
-                               EVEL_ALERT_TYPE    talertType,
-                               unsigned long long tcollectionTimestamp, 
-                               EVEL_SEVERITIES    teventSeverity,
-                               unsigned long long teventStartTimestamp);
+EVEL_COLLECTD * evel_new_collectd(void);
 
 /**************************************************************************//**
- * Free a Threshold cross event.
+ * Close a receiver's sockets and free it, with the values it holds.
  *
- * Free off the Threshold crossing event supplied.  Will free all the contained allocated
- * memory.
+ * @param collectd  The receiver.  May be NULL.
+ *****************************************************************************/
+void evel_free_collectd(EVEL_COLLECTD * collectd);
+
+/**************************************************************************//**
+ * Listen on UDP, on each address the name resolves to.  A multicast
+ * address, such as collectd's default 239.192.74.66, is joined.
  *
- * @note It does not free the Threshold Cross itself, since that may be part of a
- * larger structure.
+ * @param collectd  The receiver.
+ * @param address   Address or host name to bind to, or NULL for all.
+ * @param port      The port, usually ::EVEL_COLLECTD_PORT.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_ERR_GEN_FAIL No socket could be bound.
  *****************************************************************************/
-void evel_free_threshold_cross(EVENT_THRESHOLD_CROSS * const tcp);
+EVEL_ERR_CODES evel_collectd_udp(EVEL_COLLECTD * const collectd,
+                                 const char * const address,
+                                 const int port);
 
 /**************************************************************************//**
- * Set the Event Type property of the Threshold Cross.
+ * Wait for datagrams, and keep the value lists in each one received.
+ * Datagrams waiting on a socket are read in batches.
  *
- * @note  The property is treated as immutable: it is only valid to call
- *        the setter once.  However, we don't assert if the caller tries to
- *        overwrite, just ignoring the update instead.
+ * @param collectd    The receiver.
+ * @param timeout_ms  Longest time to wait, in milliseconds.
  *
- * @param tcp  Pointer to the ::EVENT_THRESHOLD_CROSS.
- * @param type          The Event Type to be set. ASCIIZ string. The caller
- *                      does not need to preserve the value once the function
- *                      returns.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success, including when the wait times out.
+ * @retval  EVEL_ERR_GEN_FAIL Waiting failed.
  *****************************************************************************/
-void evel_threshold_cross_type_set(EVENT_THRESHOLD_CROSS * const tcp, char * type);
+EVEL_ERR_CODES evel_collectd_wait(EVEL_COLLECTD * const collectd,
+                                  const int timeout_ms);
 
 /**************************************************************************//**
- * Add an optional additional alertid value to Alert.
+ * Keep a value list, as the latest values for its identity.
  *
- * @param alertid  Adds Alert ID
+ * @param collectd  The receiver.
+ * @param values    The value list.
  *****************************************************************************/
-void evel_threshold_cross_alertid_add(EVENT_THRESHOLD_CROSS * const event,char *  alertid);
+void evel_collectd_add(EVEL_COLLECTD * const collectd,
+                       const EVEL_COLLECTD_VALUES * const values);
 
-  /**************************************************************************//**
-   * Set the TCA probable Root cause.
-   *
-   * @param sheader     Possible root cause to Threshold
-   *****************************************************************************/
-  void evel_threshold_cross_possible_rootcause_set(EVENT_THRESHOLD_CROSS * const event, char *  sheader);
-  /**************************************************************************//**
-   * Set the TCA networking cause.
-   *
-   * @param sheader     Possible networking service value to Threshold
-   *****************************************************************************/
-  void evel_threshold_cross_networkservice_set(EVENT_THRESHOLD_CROSS * const event, char *  sheader);
-  /**************************************************************************//**
-   * Set the TCA Interface name.
-   *
-   * @param sheader     Interface name to threshold
-   *****************************************************************************/
-  void evel_threshold_cross_interfacename_set(EVENT_THRESHOLD_CROSS * const event,char *  sheader);
-  /**************************************************************************//**
-   * Set the TCA Data element type.
-   *
-   * @param sheader     element type of Threshold
-   *****************************************************************************/
-  void evel_threshold_cross_data_elementtype_set(EVENT_THRESHOLD_CROSS * const event,char *  sheader);
-  /**************************************************************************//**
-   * Set the TCA Data collector value.
-   *
-   * @param sheader     Data collector value
-   *****************************************************************************/
-  void evel_threshold_cross_data_collector_set(EVENT_THRESHOLD_CROSS * const event,char *  sheader);
-  /**************************************************************************//**
-   * Set the TCA alert value.
-   *
-   * @param sheader     Possible alert value
-   *****************************************************************************/
-  void evel_threshold_cross_alertvalue_set(EVENT_THRESHOLD_CROSS * const event,char *  sheader);
+/**************************************************************************//**
+ * Report the values received since the last report, as one measurement per
+ * host.
+ *
+ * The cpu plugin's values are reported as CPU usage, each state as its
+ * share of the CPU's total, the interface plugin's as vNIC performance,
+ * and the memory plugin's as memory usage in kilobytes.  Other plugins'
+ * values are reported as custom measurements, grouped by plugin and plugin
+ * instance, with counters and derives as rates per second.
+ *
+ * @param collectd  The receiver.
+ * @param function  Function creating the measurement for a host, which the
+ *                  values are then added to, or returning NULL to skip it.
+ * @param context   Context passed to function.
+ *
+ * @returns The number of hosts reported.
+ *****************************************************************************/
+int evel_collectd_report(EVEL_COLLECTD * const collectd,
+                         EVEL_COLLECTD_MEASUREMENT_FN function,
+                         void * context);
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                                                                           */
+/*   PROMETHEUS ENDPOINT                                                     */
+/*                                                                           */
+/*****************************************************************************/
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Most series the endpoint exposes; values of further series are dropped.   */
+/*****************************************************************************/
+#define EVEL_PROMETHEUS_MAX_SERIES 4096
 
 /**************************************************************************//**
- * Add an additional field name/value pair to the THRESHOLD CROSS event.
+ * Start serving, over HTTP at /metrics in the Prometheus text format, the
+ * latest value of every numeric measurement field and the library's own
+ * counters, for consumers which scrape rather than listen for events.
  *
- * The name and value are null delimited ASCII strings.  The library takes
- * a copy so the caller does not have to preserve values after the function
- * returns.
+ * Each field is a gauge named ves_ followed by its JSON key, such as
+ * ves_cpuIdle, labelled with the event's name and source, and with the id
+ * of the CPU, disk, vNIC or other object it belongs to.  Custom measurements
+ * with numeric values are ves_additionalMeasurements, labelled with their
+ * group and name.  Values are taken as the event handler encodes each
+ * measurement for the collector, so a field suppressed by throttling keeps
+ * its last value.
  *
- * @param state_change  Pointer to the ::EVENT_THRESHOLD_CROSS.
- * @param name          ASCIIZ string with the attribute's name.  The caller
- *                      does not need to preserve the value once the function
- *                      returns.
- * @param value         ASCIIZ string with the attribute's value.  The caller
- *                      does not need to preserve the value once the function
- *                      returns.
+ * The endpoint has a thread of its own, which reads the values without
+ * locking, so scraping never delays posting or sending events.
+ *
+ * @param address   Address to listen on, or NULL for all addresses.
+ * @param port      TCP port to listen on.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success.
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
  *****************************************************************************/
-void evel_threshold_cross_addl_info_add(EVENT_THRESHOLD_CROSS * const tcp,
-                                      const char * const name,
-                                      const char * const value);
+EVEL_ERR_CODES evel_prometheus_start(const char * const address,
+                                     const int port);
+
+/**************************************************************************//**
+ * Stop the Prometheus endpoint, if it is running.  Called from
+ * ::evel_terminate.
+ *****************************************************************************/
+void evel_prometheus_stop(void);
 
 /*****************************************************************************/
 /*****************************************************************************/
@@ -4618,16 +7420,90 @@ void evel_threshold_cross_addl_info_add(EVENT_THRESHOLD_CROSS * const tcp,
 #define EVEL_SPAMMY(FMT, ...)  log_debug(EVEL_LOG_SPAMMY, (FMT), ##__VA_ARGS__)
 #define EVEL_ERROR(FMT, ...)   log_debug(EVEL_LOG_ERROR, "ERROR: " FMT, \
                                          ##__VA_ARGS__)
+
+/*****************************************************************************/
+/* Function entry/exit trace points.  Building with EVEL_TRACE_DISABLED      */
+/* compiles them out entirely; otherwise a disabled trace point costs a      */
+/* single test of evel_trace_flags.                                          */
+/*****************************************************************************/
+#ifdef EVEL_TRACE_DISABLED
+#define EVEL_ENTER() {}
+#define EVEL_EXIT() {}
+#else
 #define EVEL_ENTER()                                                          \
         {                                                                     \
-          log_debug(EVEL_LOG_DEBUG, "Enter %s {", __FUNCTION__);              \
-          debug_indent += 2;                                                  \
+          if (__builtin_expect(evel_trace_flags != 0, 0))                     \
+          {                                                                   \
+            evel_trace_point(EVEL_TRACE_KIND_ENTER, __FUNCTION__);            \
+          }                                                                   \
         }
 #define EVEL_EXIT()                                                           \
         {                                                                     \
-          debug_indent -= 2;                                                  \
-          log_debug(EVEL_LOG_DEBUG, "Exit %s }", __FUNCTION__);               \
+          if (__builtin_expect(evel_trace_flags != 0, 0))                     \
+          {                                                                   \
+            evel_trace_point(EVEL_TRACE_KIND_EXIT, __FUNCTION__);             \
+          }                                                                   \
         }
+#endif
+
+/*****************************************************************************/
+/* Forms of function tracing, combined in evel_trace_flags.                  */
+/*****************************************************************************/
+typedef enum {
+  EVEL_TRACE_MODE_RING = 0x01,
+  EVEL_TRACE_MODE_SYSLOG = 0x02
+} EVEL_TRACE_MODES;
+
+/*****************************************************************************/
+/* Trace point kinds - also used as record kinds in evel_trace.h.            */
+/*****************************************************************************/
+#define EVEL_TRACE_KIND_ENTER 1
+#define EVEL_TRACE_KIND_EXIT 2
+
+/*****************************************************************************/
+/* Environment variable naming a trace file to start tracing at initialize.  */
+/*****************************************************************************/
+#define EVEL_TRACE_FILE_ENV "EVEL_TRACE_FILE"
+
+extern unsigned int evel_trace_flags;
+
+/**************************************************************************//**
+ * Record a trace point.  Use ::EVEL_ENTER and ::EVEL_EXIT, not this.
+ *
+ * @param kind      EVEL_TRACE_KIND_ENTER or EVEL_TRACE_KIND_EXIT.
+ * @param function  The function name; must have static storage duration.
+ *****************************************************************************/
+void evel_trace_point(const int kind, const char * const function);
+
+/**************************************************************************//**
+ * Start binary ring tracing to a file.
+ *
+ * Each thread records entry/exit into its own lock-free ring, which a
+ * background thread drains into the file every few milliseconds.  Use the
+ * evel_trace_decode tool to read the file.
+ *
+ * @param path  Path of the trace file to create.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_trace_start(const char * const path);
+
+/**************************************************************************//**
+ * Stop binary ring tracing, draining outstanding records and closing the
+ * trace file.
+ *****************************************************************************/
+void evel_trace_stop(void);
+
+/**************************************************************************//**
+ * Enable or disable the "Enter xxx {" / "Exit xxx }" debug logs.
+ *
+ * These are off by default since each one costs a syslog call.
+ *
+ * @param enable    Non-zero to enable, zero to disable.
+ *****************************************************************************/
+void evel_trace_syslog_set(const int enable);
 
 #define INDENT_SEPARATORS                                                     \
         "| | | | | | | | | | | | | | | | | | | | | | | | | | | | | | | | "
@@ -4665,6 +7541,47 @@ void log_debug(EVEL_LOG_LEVELS level, char * format, ...);
  *****************************************************************************/
 void log_error_state(char * format, ...);
 
+/*****************************************************************************/
+/* Environment variable naming a file to log to instead of syslog.           */
+/*****************************************************************************/
+#define EVEL_LOG_FILE_ENV "EVEL_LOG_FILE"
+
+/**************************************************************************//**
+ * Start asynchronous logging.
+ *
+ * Log calls then format into a lock-free queue and return immediately; a
+ * writer thread empties the queue.  If the queue is full, messages are
+ * dropped and counted rather than blocking.  Bursts of identical errors
+ * are rate-limited.
+ *
+ * @param path  File to append logs to, or NULL to write to syslog.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES log_async_start(const char * const path);
+
+/**************************************************************************//**
+ * Wait until everything logged so far has been written out.
+ *****************************************************************************/
+void log_async_flush(void);
+
+/**************************************************************************//**
+ * Stop asynchronous logging, flushing the queue.  Later messages are
+ * written synchronously.
+ *****************************************************************************/
+void log_async_stop(void);
+
+/**************************************************************************//**
+ * Report asynchronous logging counters.
+ *
+ * @param[out] dropped      Messages dropped because the queue was full.
+ * @param[out] suppressed   Error messages suppressed by rate limiting.
+ *****************************************************************************/
+void log_async_stats(unsigned long long * const dropped,
+                     unsigned long long * const suppressed);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,1413 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Receiving metrics from collectd's network plugin, and reporting them as
+ * measurements.
+ *
+ * collectd sends its binary protocol over UDP: each datagram is a sequence
+ * of parts, each a type, a length and a body.  The host, plugin, type,
+ * instances, time and interval parts set the identity of the value lists
+ * that follow, until the next part of the same type, and each values part
+ * is one value list.  Signatures are not verified, encrypted parts are
+ * skipped, and notifications are ignored.
+ *
+ * Datagrams are read with recvmmsg() a batch at a time.  The latest values
+ * of each value list are kept, by host and by plugin instance, and those
+ * received since the last report are reported as one measurement per host:
+ * the cpu plugin's as CPU usage, the interface plugin's as vNIC
+ * performance, the memory plugin's as memory usage, and the rest as custom
+ * measurements grouped by plugin instance.
+ ****************************************************************************/
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "evel.h"
+#include "double_list.h"
+#include "hashtable.h"
+
+/*****************************************************************************/
+/* Sockets one receiver can listen on.                                       */
+/*****************************************************************************/
+#define EVEL_COLLECTD_MAX_SOCKETS 8
+
+/*****************************************************************************/
+/* Datagrams read by each recvmmsg(), and batches read from one socket       */
+/* before the others get a turn.                                             */
+/*****************************************************************************/
+#define EVEL_COLLECTD_BATCH 64
+#define EVEL_COLLECTD_MAX_BATCHES 16
+
+/*****************************************************************************/
+/* Largest datagram: collectd sends at most 1452 bytes by default, and 64k  */
+/* at most.                                                                  */
+/*****************************************************************************/
+#define EVEL_COLLECTD_MAX_PACKET 65536
+
+/*****************************************************************************/
+/* Socket receive buffer asked for, to ride out bursts.                      */
+/*****************************************************************************/
+#define EVEL_COLLECTD_SOCKET_BUFFER (4 * 1024 * 1024)
+
+/*****************************************************************************/
+/* Value lists kept, so that a misbehaving sender cannot use up memory.      */
+/*****************************************************************************/
+#define EVEL_COLLECTD_MAX_LISTS 8192
+#define EVEL_COLLECTD_HASH_SIZE 1024
+
+/*****************************************************************************/
+/* Space for a value list's key and a custom measurement's name and value.   */
+/*****************************************************************************/
+#define EVEL_COLLECTD_KEY_LEN (5 * EVEL_COLLECTD_NAME_LEN)
+#define EVEL_COLLECTD_VALUE_LEN 32
+#define EVEL_COLLECTD_SEPARATOR "\x1f"
+
+/*****************************************************************************/
+/* Part types of the binary protocol.                                        */
+/*****************************************************************************/
+#define EVEL_COLLECTD_PART_HOST 0x0000
+#define EVEL_COLLECTD_PART_TIME 0x0001
+#define EVEL_COLLECTD_PART_PLUGIN 0x0002
+#define EVEL_COLLECTD_PART_PLUGIN_INSTANCE 0x0003
+#define EVEL_COLLECTD_PART_TYPE 0x0004
+#define EVEL_COLLECTD_PART_TYPE_INSTANCE 0x0005
+#define EVEL_COLLECTD_PART_VALUES 0x0006
+#define EVEL_COLLECTD_PART_INTERVAL 0x0007
+#define EVEL_COLLECTD_PART_TIME_HR 0x0008
+#define EVEL_COLLECTD_PART_INTERVAL_HR 0x0009
+
+/*****************************************************************************/
+/* Kilobytes, in which memory usage is reported; collectd sends bytes.       */
+/*****************************************************************************/
+#define EVEL_COLLECTD_KB 1024.0
+
+/**************************************************************************//**
+ * The latest values of one value list, and the host it is from.  Counters
+ * are kept as counters, which only go up, so that their change since the
+ * reading before is known however they wrap or are reset.  Derives may go
+ * down, so their change is the signed difference.  Gauges and absolutes,
+ * which collectd resets as it sends them, are kept as they are.
+ *****************************************************************************/
+typedef struct evel_collectd_list {
+  struct evel_collectd_host * host;
+  char type[EVEL_COLLECTD_NAME_LEN];
+  char type_instance[EVEL_COLLECTD_NAME_LEN];
+  int num_values;
+  int readings;
+  bool updated;
+  unsigned long long timestamp;
+  EVEL_COLLECTD_DS_TYPES types[EVEL_COLLECTD_MAX_VALUES];
+  EVEL_COUNTER counters[EVEL_COLLECTD_MAX_VALUES];
+  long long derives[EVEL_COLLECTD_MAX_VALUES];
+  long long derive_deltas[EVEL_COLLECTD_MAX_VALUES];
+  double derive_rates[EVEL_COLLECTD_MAX_VALUES];
+  double gauges[EVEL_COLLECTD_MAX_VALUES];
+} EVEL_COLLECTD_LIST;
+
+/**************************************************************************//**
+ * The value lists of one plugin instance on one host.
+ *****************************************************************************/
+typedef struct evel_collectd_instance {
+  char plugin[EVEL_COLLECTD_NAME_LEN];
+  char plugin_instance[EVEL_COLLECTD_NAME_LEN];
+  DLIST lists;
+} EVEL_COLLECTD_INSTANCE;
+
+/**************************************************************************//**
+ * The plugin instances of one host, and whether any of its value lists have
+ * been received since it was last reported.
+ *****************************************************************************/
+typedef struct evel_collectd_host {
+  char name[EVEL_COLLECTD_NAME_LEN];
+  bool updated;
+  DLIST instances;
+} EVEL_COLLECTD_HOST;
+
+/**************************************************************************//**
+ * Receiver state.  The table owns the value lists, and the hosts and their
+ * instances refer to them in the order they were first received.
+ *****************************************************************************/
+struct evel_collectd {
+  int num_sockets;
+  int sockets[EVEL_COLLECTD_MAX_SOCKETS];
+  struct mmsghdr messages[EVEL_COLLECTD_BATCH];
+  struct iovec iovecs[EVEL_COLLECTD_BATCH];
+  unsigned char * buffers;
+  DLIST hosts;
+  HASHTABLE_T * lists;
+  int num_lists;
+};
+
+/*****************************************************************************/
+/* CPU states, in the order of the values collected for each CPU.            */
+/*****************************************************************************/
+typedef enum {
+  EVEL_COLLECTD_CPU_IDLE,
+  EVEL_COLLECTD_CPU_USER,
+  EVEL_COLLECTD_CPU_SYSTEM,
+  EVEL_COLLECTD_CPU_NICE,
+  EVEL_COLLECTD_CPU_INTERRUPT,
+  EVEL_COLLECTD_CPU_SOFTIRQ,
+  EVEL_COLLECTD_CPU_STEAL,
+  EVEL_COLLECTD_CPU_WAIT,
+  EVEL_COLLECTD_MAX_CPU_STATES
+} EVEL_COLLECTD_CPU_STATES;
+
+static const char * const evel_collectd_cpu_states[] = {
+  "idle", "user", "system", "nice", "interrupt", "softirq", "steal", "wait"
+};
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static unsigned long long evel_collectd_be64(const unsigned char * bytes);
+static unsigned long long evel_collectd_le64(const unsigned char * bytes);
+static unsigned long long evel_collectd_usec(const unsigned long long value,
+                                             const int high_resolution);
+static int evel_collectd_string(const unsigned char * const body,
+                                const size_t length,
+                                char * const string);
+static int evel_collectd_values(const unsigned char * const body,
+                                const size_t length,
+                                EVEL_COLLECTD_VALUES * const values);
+static void evel_collectd_received(void * context,
+                                   const EVEL_COLLECTD_VALUES * values);
+static EVEL_COLLECTD_LIST * evel_collectd_new_list(
+                                     EVEL_COLLECTD * const collectd,
+                                     const EVEL_COLLECTD_VALUES * const values);
+static void evel_collectd_drain(EVEL_COLLECTD * const collectd,
+                                const int fd);
+static double evel_collectd_value(const EVEL_COLLECTD_LIST * const list,
+                                  const int index);
+static void evel_collectd_report_cpu(EVENT_MEASUREMENT * const measurement,
+                               const EVEL_COLLECTD_INSTANCE * const instance);
+static void evel_collectd_report_interface(
+                               EVENT_MEASUREMENT * const measurement,
+                               const EVEL_COLLECTD_INSTANCE * const instance);
+static void evel_collectd_report_memory(
+                               EVENT_MEASUREMENT * const measurement,
+                               const EVEL_COLLECTD_HOST * const host,
+                               const EVEL_COLLECTD_INSTANCE * const instance);
+static void evel_collectd_report_custom(
+                               EVENT_MEASUREMENT * const measurement,
+                               const EVEL_COLLECTD_INSTANCE * const instance);
+
+/**************************************************************************//**
+ * Read a big-endian 64-bit integer, as collectd sends all but gauges.
+ *****************************************************************************/
+static unsigned long long evel_collectd_be64(const unsigned char * bytes)
+{
+  unsigned long long value = 0;
+  int ii;
+
+  for (ii = 0; ii < 8; ii++)
+  {
+    value = (value << 8) | bytes[ii];
+  }
+  return value;
+}
+
+/**************************************************************************//**
+ * Read a little-endian 64-bit integer, as collectd sends gauges' doubles.
+ *****************************************************************************/
+static unsigned long long evel_collectd_le64(const unsigned char * bytes)
+{
+  unsigned long long value = 0;
+  int ii;
+
+  for (ii = 7; ii >= 0; ii--)
+  {
+    value = (value << 8) | bytes[ii];
+  }
+  return value;
+}
+
+/**************************************************************************//**
+ * Convert a time or interval to microseconds.  High resolution times are in
+ * units of 2^-30 seconds, the others in seconds.
+ *****************************************************************************/
+static unsigned long long evel_collectd_usec(const unsigned long long value,
+                                             const int high_resolution)
+{
+  if (!high_resolution)
+  {
+    return value * 1000000ULL;
+  }
+  return (value >> 30) * 1000000ULL +
+         (((value & 0x3fffffffULL) * 1000000ULL) >> 30);
+}
+
+/**************************************************************************//**
+ * Copy a string part's body, which must be NUL-terminated and fit.
+ *
+ * @returns 0 on success, -1 if the part is malformed.
+ *****************************************************************************/
+static int evel_collectd_string(const unsigned char * const body,
+                                const size_t length,
+                                char * const string)
+{
+  if (length == 0 || length > EVEL_COLLECTD_NAME_LEN ||
+      body[length - 1] != '\0')
+  {
+    return -1;
+  }
+  memcpy(string, body, length);
+  return 0;
+}
+
+/**************************************************************************//**
+ * Decode a values part's body: a count, the type of each value, then the
+ * values.
+ *
+ * @returns 0 on success, -1 if the part is malformed.
+ *****************************************************************************/
+static int evel_collectd_values(const unsigned char * const body,
+                                const size_t length,
+                                EVEL_COLLECTD_VALUES * const values)
+{
+  const unsigned char * data;
+  unsigned long long bits;
+  int num_values;
+  int ii;
+
+  if (length < 2)
+  {
+    return -1;
+  }
+  num_values = (body[0] << 8) | body[1];
+  if (num_values == 0 || num_values > EVEL_COLLECTD_MAX_VALUES ||
+      length != 2 + (size_t) num_values * 9)
+  {
+    return -1;
+  }
+
+  data = body + 2 + num_values;
+  for (ii = 0; ii < num_values; ii++, data += 8)
+  {
+    if (body[2 + ii] >= EVEL_MAX_COLLECTD_TYPES)
+    {
+      return -1;
+    }
+    values->types[ii] = body[2 + ii];
+    if (values->types[ii] == EVEL_COLLECTD_GAUGE)
+    {
+      bits = evel_collectd_le64(data);
+      memcpy(&values->gauges[ii], &bits, sizeof(values->gauges[ii]));
+      values->counters[ii] = 0;
+    }
+    else
+    {
+      values->counters[ii] = evel_collectd_be64(data);
+      values->gauges[ii] = (double) values->counters[ii];
+    }
+  }
+  values->num_values = num_values;
+
+  return 0;
+}
+
+/**************************************************************************//**
+ * Decode a datagram of collectd's binary protocol, and hand on each value
+ * list in it.
+ *
+ * @param packet    The datagram.
+ * @param length    Length of the datagram.
+ * @param function  Function to hand value lists to.
+ * @param context   Context passed to function.
+ *
+ * @returns The number of value lists handed on.
+ * @retval  -1  The datagram is malformed.  Value lists before the fault
+ *              have been handed on.
+ *****************************************************************************/
+int evel_collectd_parse(const void * const packet,
+                        const size_t length,
+                        EVEL_COLLECTD_VALUES_FN function,
+                        void * context)
+{
+  const unsigned char * pos = packet;
+  const unsigned char * const end = pos + length;
+  char host[EVEL_COLLECTD_NAME_LEN] = "";
+  char plugin[EVEL_COLLECTD_NAME_LEN] = "";
+  char plugin_instance[EVEL_COLLECTD_NAME_LEN] = "";
+  char type[EVEL_COLLECTD_NAME_LEN] = "";
+  char type_instance[EVEL_COLLECTD_NAME_LEN] = "";
+  EVEL_COLLECTD_VALUES values;
+  unsigned int part_type;
+  size_t part_length;
+  int num_lists = 0;
+  int rc = 0;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(packet != NULL);
+  assert(function != NULL);
+
+  memset(&values, 0, sizeof(values));
+  values.host = host;
+  values.plugin = plugin;
+  values.plugin_instance = plugin_instance;
+  values.type = type;
+  values.type_instance = type_instance;
+
+  while (rc == 0 && end - pos >= 4)
+  {
+    part_type = (pos[0] << 8) | pos[1];
+    part_length = (pos[2] << 8) | pos[3];
+    if (part_length < 4 || part_length > (size_t) (end - pos))
+    {
+      rc = -1;
+      break;
+    }
+
+    switch (part_type)
+    {
+      case EVEL_COLLECTD_PART_HOST:
+        rc = evel_collectd_string(pos + 4, part_length - 4, host);
+        break;
+
+      case EVEL_COLLECTD_PART_PLUGIN:
+        rc = evel_collectd_string(pos + 4, part_length - 4, plugin);
+        break;
+
+      case EVEL_COLLECTD_PART_PLUGIN_INSTANCE:
+        rc = evel_collectd_string(pos + 4, part_length - 4, plugin_instance);
+        break;
+
+      case EVEL_COLLECTD_PART_TYPE:
+        rc = evel_collectd_string(pos + 4, part_length - 4, type);
+        break;
+
+      case EVEL_COLLECTD_PART_TYPE_INSTANCE:
+        rc = evel_collectd_string(pos + 4, part_length - 4, type_instance);
+        break;
+
+      case EVEL_COLLECTD_PART_TIME:
+      case EVEL_COLLECTD_PART_TIME_HR:
+      case EVEL_COLLECTD_PART_INTERVAL:
+      case EVEL_COLLECTD_PART_INTERVAL_HR:
+        if (part_length != 12)
+        {
+          rc = -1;
+          break;
+        }
+        if (part_type == EVEL_COLLECTD_PART_TIME ||
+            part_type == EVEL_COLLECTD_PART_TIME_HR)
+        {
+          values.time = evel_collectd_usec(evel_collectd_be64(pos + 4),
+                                  part_type == EVEL_COLLECTD_PART_TIME_HR);
+        }
+        else
+        {
+          values.interval = evel_collectd_usec(evel_collectd_be64(pos + 4),
+                                  part_type == EVEL_COLLECTD_PART_INTERVAL_HR);
+        }
+        break;
+
+      case EVEL_COLLECTD_PART_VALUES:
+        rc = evel_collectd_values(pos + 4, part_length - 4, &values);
+        if (rc == 0 && host[0] != '\0' && plugin[0] != '\0' &&
+            type[0] != '\0')
+        {
+          (*function)(context, &values);
+          num_lists++;
+        }
+        break;
+
+      default:
+        /*********************************************************************/
+        /* Signatures, encrypted parts and notifications.                    */
+        /*********************************************************************/
+        break;
+    }
+    pos += part_length;
+  }
+
+  if (rc != 0)
+  {
+    EVEL_DEBUG("Malformed collectd packet after %d value lists", num_lists);
+    num_lists = -1;
+  }
+
+  EVEL_EXIT();
+
+  return num_lists;
+}
+
+/**************************************************************************//**
+ * Create a receiver with no sockets.
+ *
+ * @returns pointer to the new receiver.
+ * @retval  NULL  Failed to allocate the receiver.
+ *****************************************************************************/
+EVEL_COLLECTD * evel_new_collectd(void)
+{
+  EVEL_COLLECTD * collectd = NULL;
+  int ii;
+
+  EVEL_ENTER();
+
+  collectd = calloc(1, sizeof(EVEL_COLLECTD));
+  if (collectd == NULL)
+  {
+    log_error_state("Failed to allocate collectd receiver");
+    goto exit_label;
+  }
+  dlist_initialize(&collectd->hosts);
+
+  collectd->buffers = malloc(EVEL_COLLECTD_BATCH * EVEL_COLLECTD_MAX_PACKET);
+  collectd->lists = ht_create(EVEL_COLLECTD_HASH_SIZE);
+  if (collectd->buffers == NULL || collectd->lists == NULL)
+  {
+    log_error_state("Failed to allocate collectd receiver buffers");
+    evel_free_collectd(collectd);
+    collectd = NULL;
+    goto exit_label;
+  }
+
+  for (ii = 0; ii < EVEL_COLLECTD_BATCH; ii++)
+  {
+    collectd->iovecs[ii].iov_base =
+                             collectd->buffers + ii * EVEL_COLLECTD_MAX_PACKET;
+    collectd->iovecs[ii].iov_len = EVEL_COLLECTD_MAX_PACKET;
+    collectd->messages[ii].msg_hdr.msg_iov = &collectd->iovecs[ii];
+    collectd->messages[ii].msg_hdr.msg_iovlen = 1;
+  }
+
+exit_label:
+  EVEL_EXIT();
+  return collectd;
+}
+
+/**************************************************************************//**
+ * Close a receiver's sockets and free it, with the values it holds.
+ *
+ * @param collectd  The receiver.  May be NULL.
+ *****************************************************************************/
+void evel_free_collectd(EVEL_COLLECTD * collectd)
+{
+  EVEL_COLLECTD_HOST * host;
+  EVEL_COLLECTD_INSTANCE * instance;
+  int ii;
+
+  EVEL_ENTER();
+
+  if (collectd != NULL)
+  {
+    for (ii = 0; ii < collectd->num_sockets; ii++)
+    {
+      close(collectd->sockets[ii]);
+    }
+
+    /*************************************************************************/
+    /* The instances' lists only refer to the value lists in the table.      */
+    /*************************************************************************/
+    while ((host = dlist_pop_last(&collectd->hosts)) != NULL)
+    {
+      while ((instance = dlist_pop_last(&host->instances)) != NULL)
+      {
+        while (dlist_pop_last(&instance->lists) != NULL)
+        {
+        }
+        free(instance);
+      }
+      free(host);
+    }
+    if (collectd->lists != NULL)
+    {
+      ht_destroy(collectd->lists);
+    }
+    free(collectd->buffers);
+    free(collectd);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Listen on UDP, on each address the name resolves to.  A multicast
+ * address, such as collectd's default 239.192.74.66, is joined.
+ *
+ * @param collectd  The receiver.
+ * @param address   Address or host name to bind to, or NULL for all.
+ * @param port      The port, usually ::EVEL_COLLECTD_PORT.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_ERR_GEN_FAIL No socket could be bound.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_collectd_udp(EVEL_COLLECTD * const collectd,
+                                 const char * const address,
+                                 const int port)
+{
+  EVEL_ERR_CODES rc = EVEL_ERR_GEN_FAIL;
+  struct addrinfo hints;
+  struct addrinfo * addresses = NULL;
+  struct addrinfo * ai;
+  struct ip_mreq mreq;
+  struct ipv6_mreq mreq6;
+  const struct sockaddr_in * sin;
+  const struct sockaddr_in6 * sin6;
+  char service[16];
+  int size = EVEL_COLLECTD_SOCKET_BUFFER;
+  int on = 1;
+  int error;
+  int fd;
+
+  EVEL_ENTER();
+
+  assert(collectd != NULL);
+  assert(port > 0 && port < 65536);
+
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_DGRAM;
+  hints.ai_flags = AI_PASSIVE | AI_NUMERICSERV;
+  snprintf(service, sizeof(service), "%d", port);
+
+  error = getaddrinfo(address, service, &hints, &addresses);
+  if (error != 0)
+  {
+    log_error_state("Failed to resolve %s: %s",
+                    (address != NULL) ? address : "*", gai_strerror(error));
+    goto exit_label;
+  }
+
+  for (ai = addresses; ai != NULL; ai = ai->ai_next)
+  {
+    if (collectd->num_sockets == EVEL_COLLECTD_MAX_SOCKETS)
+    {
+      EVEL_ERROR("Too many collectd receiver sockets");
+      break;
+    }
+
+    fd = socket(ai->ai_family,
+                ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                ai->ai_protocol);
+    if (fd < 0)
+    {
+      continue;
+    }
+
+    /*************************************************************************/
+    /* Keep IPv6 sockets to IPv6, so the IPv4 wildcard can be bound too.     */
+    /*************************************************************************/
+    if (ai->ai_family == AF_INET6)
+    {
+      setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &on, sizeof(on));
+    }
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+
+    if (bind(fd, ai->ai_addr, ai->ai_addrlen) != 0)
+    {
+      EVEL_ERROR("Failed to bind collectd UDP port %d: %s",
+                 port, strerror(errno));
+      close(fd);
+      continue;
+    }
+
+    error = 0;
+    if (ai->ai_family == AF_INET)
+    {
+      sin = (const struct sockaddr_in *) ai->ai_addr;
+      if (IN_MULTICAST(ntohl(sin->sin_addr.s_addr)))
+      {
+        mreq.imr_multiaddr = sin->sin_addr;
+        mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+        error = setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP,
+                           &mreq, sizeof(mreq));
+      }
+    }
+    else if (ai->ai_family == AF_INET6)
+    {
+      sin6 = (const struct sockaddr_in6 *) ai->ai_addr;
+      if (IN6_IS_ADDR_MULTICAST(&sin6->sin6_addr))
+      {
+        mreq6.ipv6mr_multiaddr = sin6->sin6_addr;
+        mreq6.ipv6mr_interface = 0;
+        error = setsockopt(fd, IPPROTO_IPV6, IPV6_JOIN_GROUP,
+                           &mreq6, sizeof(mreq6));
+      }
+    }
+    if (error != 0)
+    {
+      EVEL_ERROR("Failed to join collectd multicast group: %s",
+                 strerror(errno));
+      close(fd);
+      continue;
+    }
+
+    collectd->sockets[collectd->num_sockets++] = fd;
+    rc = EVEL_SUCCESS;
+  }
+
+  if (rc == EVEL_SUCCESS)
+  {
+    EVEL_INFO("Receiving collectd on UDP port %d", port);
+  }
+  else
+  {
+    log_error_state("Failed to listen on collectd UDP port %d", port);
+  }
+
+exit_label:
+  if (addresses != NULL)
+  {
+    freeaddrinfo(addresses);
+  }
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Keep a value list, as the latest values for its identity.
+ *
+ * @param collectd  The receiver.
+ * @param values    The value list.
+ *****************************************************************************/
+void evel_collectd_add(EVEL_COLLECTD * const collectd,
+                       const EVEL_COLLECTD_VALUES * const values)
+{
+  char key[EVEL_COLLECTD_KEY_LEN];
+  EVEL_COLLECTD_LIST * list;
+  unsigned long long timestamp;
+  long long derive;
+  int ii;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(collectd != NULL);
+  assert(values != NULL);
+  assert(values->num_values > 0 &&
+         values->num_values <= EVEL_COLLECTD_MAX_VALUES);
+
+  snprintf(key, sizeof(key),
+           "%s" EVEL_COLLECTD_SEPARATOR "%s" EVEL_COLLECTD_SEPARATOR
+           "%s" EVEL_COLLECTD_SEPARATOR "%s" EVEL_COLLECTD_SEPARATOR "%s",
+           values->host, values->plugin, values->plugin_instance,
+           values->type, values->type_instance);
+
+  list = ht_get(collectd->lists, key);
+  if (list == NULL)
+  {
+    list = evel_collectd_new_list(collectd, values);
+    if (list == NULL)
+    {
+      goto exit_label;
+    }
+    ht_set(collectd->lists, key, list);
+  }
+
+  /***************************************************************************/
+  /* A list whose values change in number or type starts again.              */
+  /***************************************************************************/
+  if (list->num_values != values->num_values ||
+      memcmp(list->types, values->types,
+             values->num_values * sizeof(values->types[0])) != 0)
+  {
+    list->num_values = values->num_values;
+    memcpy(list->types, values->types,
+           values->num_values * sizeof(values->types[0]));
+    for (ii = 0; ii < list->num_values; ii++)
+    {
+      evel_counter_init(&list->counters[ii], EVEL_COUNTER_AUTO);
+    }
+    list->readings = 0;
+  }
+
+  /***************************************************************************/
+  /* Readings are timed by the wall-clock, collectd's if it sent the time.   */
+  /***************************************************************************/
+  timestamp = (values->time != 0) ? values->time :
+                                    evel_time_now_usec(EVEL_CLOCK_EXACT);
+  for (ii = 0; ii < list->num_values; ii++)
+  {
+    switch (list->types[ii])
+    {
+      case EVEL_COLLECTD_COUNTER:
+        evel_counter_update(&list->counters[ii],
+                            values->counters[ii],
+                            timestamp);
+        break;
+
+      case EVEL_COLLECTD_DERIVE:
+        derive = (long long) values->counters[ii];
+        if (list->readings > 0)
+        {
+          list->derive_deltas[ii] = (long long) ((unsigned long long) derive -
+                                  (unsigned long long) list->derives[ii]);
+          list->derive_rates[ii] = (timestamp > list->timestamp) ?
+                       (double) list->derive_deltas[ii] * 1000000.0 /
+                       (double) (timestamp - list->timestamp) : 0.0;
+        }
+        else
+        {
+          list->derive_deltas[ii] = 0;
+          list->derive_rates[ii] = 0.0;
+        }
+        list->derives[ii] = derive;
+        break;
+
+      default:
+        list->gauges[ii] = values->gauges[ii];
+        break;
+    }
+  }
+  list->timestamp = timestamp;
+  list->readings++;
+  list->updated = true;
+  list->host->updated = true;
+
+exit_label:
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Keep a value list received.
+ *****************************************************************************/
+static void evel_collectd_received(void * context,
+                                   const EVEL_COLLECTD_VALUES * values)
+{
+  evel_collectd_add(context, values);
+}
+
+/**************************************************************************//**
+ * Add a value list not seen before under its host and plugin instance,
+ * adding those too if they are new.
+ *
+ * @returns pointer to the list, to be added to the table.
+ * @retval  NULL  There are too many lists, or no memory.
+ *****************************************************************************/
+static EVEL_COLLECTD_LIST * evel_collectd_new_list(
+                                     EVEL_COLLECTD * const collectd,
+                                     const EVEL_COLLECTD_VALUES * const values)
+{
+  EVEL_COLLECTD_HOST * host = NULL;
+  EVEL_COLLECTD_INSTANCE * instance = NULL;
+  EVEL_COLLECTD_LIST * list = NULL;
+  DLIST_ITEM * item;
+
+  EVEL_ENTER();
+
+  if (collectd->num_lists >= EVEL_COLLECTD_MAX_LISTS)
+  {
+    EVEL_DEBUG("Too many collectd value lists, ignoring %s %s %s",
+               values->host, values->plugin, values->type);
+    goto exit_label;
+  }
+
+  for (item = dlist_get_first(&collectd->hosts);
+       item != NULL && host == NULL;
+       item = dlist_get_next(item))
+  {
+    if (strcmp(((EVEL_COLLECTD_HOST *) item->item)->name, values->host) == 0)
+    {
+      host = item->item;
+    }
+  }
+  if (host == NULL)
+  {
+    host = calloc(1, sizeof(EVEL_COLLECTD_HOST));
+    if (host == NULL)
+    {
+      log_error_state("Failed to allocate collectd host");
+      goto exit_label;
+    }
+    strcpy(host->name, values->host);
+    dlist_initialize(&host->instances);
+    dlist_push_last(&collectd->hosts, host);
+  }
+
+  for (item = dlist_get_first(&host->instances);
+       item != NULL && instance == NULL;
+       item = dlist_get_next(item))
+  {
+    if (strcmp(((EVEL_COLLECTD_INSTANCE *) item->item)->plugin,
+               values->plugin) == 0 &&
+        strcmp(((EVEL_COLLECTD_INSTANCE *) item->item)->plugin_instance,
+               values->plugin_instance) == 0)
+    {
+      instance = item->item;
+    }
+  }
+  if (instance == NULL)
+  {
+    instance = calloc(1, sizeof(EVEL_COLLECTD_INSTANCE));
+    if (instance == NULL)
+    {
+      log_error_state("Failed to allocate collectd plugin instance");
+      goto exit_label;
+    }
+    strcpy(instance->plugin, values->plugin);
+    strcpy(instance->plugin_instance, values->plugin_instance);
+    dlist_initialize(&instance->lists);
+    dlist_push_last(&host->instances, instance);
+  }
+
+  list = calloc(1, sizeof(EVEL_COLLECTD_LIST));
+  if (list == NULL)
+  {
+    log_error_state("Failed to allocate collectd value list");
+    goto exit_label;
+  }
+  list->host = host;
+  strcpy(list->type, values->type);
+  strcpy(list->type_instance, values->type_instance);
+  dlist_push_last(&instance->lists, list);
+  collectd->num_lists++;
+
+exit_label:
+  EVEL_EXIT();
+  return list;
+}
+
+/**************************************************************************//**
+ * Read what is waiting on a socket, a batch at a time, and keep the value
+ * lists in each datagram.
+ *****************************************************************************/
+static void evel_collectd_drain(EVEL_COLLECTD * const collectd,
+                                const int fd)
+{
+  int received;
+  int batches;
+  int ii;
+
+  for (batches = 0; batches < EVEL_COLLECTD_MAX_BATCHES; batches++)
+  {
+    received = recvmmsg(fd,
+                        collectd->messages,
+                        EVEL_COLLECTD_BATCH,
+                        MSG_DONTWAIT,
+                        NULL);
+    if (received <= 0)
+    {
+      if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK &&
+          errno != EINTR)
+      {
+        EVEL_ERROR("Failed to receive collectd: %s", strerror(errno));
+      }
+      break;
+    }
+
+    for (ii = 0; ii < received; ii++)
+    {
+      evel_collectd_parse(collectd->iovecs[ii].iov_base,
+                          collectd->messages[ii].msg_len,
+                          evel_collectd_received,
+                          collectd);
+    }
+
+    if (received < EVEL_COLLECTD_BATCH)
+    {
+      break;
+    }
+  }
+}
+
+/**************************************************************************//**
+ * Wait for datagrams, and keep the value lists in each one received.
+ *
+ * @param collectd    The receiver.
+ * @param timeout_ms  Longest time to wait, in milliseconds.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success, including when the wait times out.
+ * @retval  EVEL_ERR_GEN_FAIL Waiting failed.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_collectd_wait(EVEL_COLLECTD * const collectd,
+                                  const int timeout_ms)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  struct pollfd fds[EVEL_COLLECTD_MAX_SOCKETS];
+  int ready;
+  int ii;
+
+  EVEL_ENTER();
+
+  assert(collectd != NULL);
+
+  for (ii = 0; ii < collectd->num_sockets; ii++)
+  {
+    fds[ii].fd = collectd->sockets[ii];
+    fds[ii].events = POLLIN;
+    fds[ii].revents = 0;
+  }
+
+  ready = poll(fds, collectd->num_sockets, timeout_ms);
+  if (ready < 0 && errno != EINTR)
+  {
+    log_error_state("Failed to wait for collectd: %s", strerror(errno));
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  for (ii = 0; ready > 0 && ii < collectd->num_sockets; ii++)
+  {
+    if (fds[ii].revents & POLLIN)
+    {
+      evel_collectd_drain(collectd, fds[ii].fd);
+    }
+  }
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Get a value to report: a gauge as it is, a counter or derive as its rate
+ * per second, and an absolute as it is.
+ *****************************************************************************/
+static double evel_collectd_value(const EVEL_COLLECTD_LIST * const list,
+                                  const int index)
+{
+  switch (list->types[index])
+  {
+    case EVEL_COLLECTD_COUNTER:
+      return list->counters[index].rate;
+
+    case EVEL_COLLECTD_DERIVE:
+      return list->derive_rates[index];
+
+    default:
+      return list->gauges[index];
+  }
+}
+
+/**************************************************************************//**
+ * Check whether a value can be reported: a counter or derive needs a
+ * reading before it to have a rate.
+ *****************************************************************************/
+static bool evel_collectd_ready(const EVEL_COLLECTD_LIST * const list,
+                                const int index)
+{
+  return (list->types[index] != EVEL_COLLECTD_COUNTER &&
+          list->types[index] != EVEL_COLLECTD_DERIVE) || list->readings > 1;
+}
+
+/**************************************************************************//**
+ * Report a CPU from the cpu plugin, sent either as percentages or as
+ * jiffies.  Either way, each state is reported as its share of the total
+ * of the states, so that jiffies need not be per hundredth of a second.
+ *****************************************************************************/
+static void evel_collectd_report_cpu(EVENT_MEASUREMENT * const measurement,
+                               const EVEL_COLLECTD_INSTANCE * const instance)
+{
+  double states[EVEL_COLLECTD_MAX_CPU_STATES] = {0.0};
+  bool found[EVEL_COLLECTD_MAX_CPU_STATES] = {false};
+  const EVEL_COLLECTD_LIST * list;
+  MEASUREMENT_CPU_USE * cpu_use;
+  DLIST_ITEM * item;
+  char id[EVEL_COLLECTD_NAME_LEN];
+  double total = 0.0;
+  double usage;
+  int ii;
+
+  for (item = dlist_get_first((DLIST *) &instance->lists);
+       item != NULL;
+       item = dlist_get_next(item))
+  {
+    list = item->item;
+    if (!list->updated || !evel_collectd_ready(list, 0))
+    {
+      continue;
+    }
+    for (ii = 0; ii < EVEL_COLLECTD_MAX_CPU_STATES; ii++)
+    {
+      if (strcmp(list->type_instance, evel_collectd_cpu_states[ii]) == 0)
+      {
+        states[ii] = evel_collectd_value(list, 0);
+        found[ii] = true;
+        total += states[ii];
+      }
+    }
+  }
+  if (total <= 0.0)
+  {
+    return;
+  }
+  for (ii = 0; ii < EVEL_COLLECTD_MAX_CPU_STATES; ii++)
+  {
+    states[ii] = states[ii] * 100.0 / total;
+  }
+
+  usage = found[EVEL_COLLECTD_CPU_IDLE] ?
+                                  100.0 - states[EVEL_COLLECTD_CPU_IDLE] : 100.0;
+  snprintf(id, sizeof(id), "%s",
+           (instance->plugin_instance[0] != '\0') ?
+           instance->plugin_instance : instance->plugin);
+  cpu_use = evel_measurement_new_cpu_use_add(measurement, id, usage);
+  if (cpu_use == NULL)
+  {
+    return;
+  }
+
+  if (found[EVEL_COLLECTD_CPU_IDLE])
+    evel_measurement_cpu_use_idle_set(cpu_use,
+                                      states[EVEL_COLLECTD_CPU_IDLE]);
+  if (found[EVEL_COLLECTD_CPU_USER])
+    evel_measurement_cpu_use_usageuser_set(cpu_use,
+                                           states[EVEL_COLLECTD_CPU_USER]);
+  if (found[EVEL_COLLECTD_CPU_SYSTEM])
+    evel_measurement_cpu_use_system_set(cpu_use,
+                                        states[EVEL_COLLECTD_CPU_SYSTEM]);
+  if (found[EVEL_COLLECTD_CPU_NICE])
+    evel_measurement_cpu_use_nice_set(cpu_use,
+                                      states[EVEL_COLLECTD_CPU_NICE]);
+  if (found[EVEL_COLLECTD_CPU_INTERRUPT])
+    evel_measurement_cpu_use_interrupt_set(cpu_use,
+                                     states[EVEL_COLLECTD_CPU_INTERRUPT]);
+  if (found[EVEL_COLLECTD_CPU_SOFTIRQ])
+    evel_measurement_cpu_use_softirq_set(cpu_use,
+                                     states[EVEL_COLLECTD_CPU_SOFTIRQ]);
+  if (found[EVEL_COLLECTD_CPU_STEAL])
+    evel_measurement_cpu_use_steal_set(cpu_use,
+                                       states[EVEL_COLLECTD_CPU_STEAL]);
+  if (found[EVEL_COLLECTD_CPU_WAIT])
+    evel_measurement_cpu_use_wait_set(cpu_use,
+                                      states[EVEL_COLLECTD_CPU_WAIT]);
+}
+
+/**************************************************************************//**
+ * Report an interface from the interface plugin, whose types each have a
+ * received and a transmitted counter or derive.
+ *****************************************************************************/
+static void evel_collectd_report_interface(
+                               EVENT_MEASUREMENT * const measurement,
+                               const EVEL_COLLECTD_INSTANCE * const instance)
+{
+  MEASUREMENT_VNIC_PERFORMANCE * vnic = NULL;
+  const EVEL_COLLECTD_LIST * list;
+  double rx;
+  double tx;
+  double rx_delta;
+  double tx_delta;
+  DLIST_ITEM * item;
+  bool delta;
+
+  for (item = dlist_get_first((DLIST *) &instance->lists);
+       item != NULL;
+       item = dlist_get_next(item))
+  {
+    list = item->item;
+    if (!list->updated || list->num_values != 2 ||
+        (list->types[0] != EVEL_COLLECTD_COUNTER &&
+         list->types[0] != EVEL_COLLECTD_DERIVE) ||
+        list->types[1] != list->types[0])
+    {
+      continue;
+    }
+    if (vnic == NULL)
+    {
+      vnic = evel_measurement_new_vnic_performance(
+                                   (char *) instance->plugin_instance, "false");
+      if (vnic == NULL)
+      {
+        return;
+      }
+    }
+
+    if (list->types[0] == EVEL_COLLECTD_COUNTER)
+    {
+      rx = (double) list->counters[0].value;
+      tx = (double) list->counters[1].value;
+      rx_delta = (double) list->counters[0].delta;
+      tx_delta = (double) list->counters[1].delta;
+    }
+    else
+    {
+      rx = (double) list->derives[0];
+      tx = (double) list->derives[1];
+      rx_delta = (double) list->derive_deltas[0];
+      tx_delta = (double) list->derive_deltas[1];
+    }
+    delta = (list->readings > 1);
+    if (strcmp(list->type, "if_octets") == 0)
+    {
+      evel_vnic_performance_rx_octets_acc_set(vnic, rx);
+      evel_vnic_performance_tx_octets_acc_set(vnic, tx);
+      if (delta)
+      {
+        evel_vnic_performance_rx_octets_delta_set(vnic, rx_delta);
+        evel_vnic_performance_tx_octets_delta_set(vnic, tx_delta);
+      }
+    }
+    else if (strcmp(list->type, "if_packets") == 0)
+    {
+      evel_vnic_performance_rx_total_pkt_acc_set(vnic, rx);
+      evel_vnic_performance_tx_total_pkt_acc_set(vnic, tx);
+      if (delta)
+      {
+        evel_vnic_performance_rx_total_pkt_delta_set(vnic, rx_delta);
+        evel_vnic_performance_tx_total_pkt_delta_set(vnic, tx_delta);
+      }
+    }
+    else if (strcmp(list->type, "if_errors") == 0)
+    {
+      evel_vnic_performance_rx_error_pkt_acc_set(vnic, rx);
+      evel_vnic_performance_tx_error_pkt_acc_set(vnic, tx);
+      if (delta)
+      {
+        evel_vnic_performance_rx_error_pkt_delta_set(vnic, rx_delta);
+        evel_vnic_performance_tx_error_pkt_delta_set(vnic, tx_delta);
+      }
+    }
+    else if (strcmp(list->type, "if_dropped") == 0)
+    {
+      evel_vnic_performance_rx_discard_pkt_acc_set(vnic, rx);
+      evel_vnic_performance_tx_discarded_pkt_acc_set(vnic, tx);
+      if (delta)
+      {
+        evel_vnic_performance_rx_discard_pkt_delta_set(vnic, rx_delta);
+        evel_vnic_performance_tx_discarded_pkt_delta_set(vnic, tx_delta);
+      }
+    }
+  }
+
+  if (vnic != NULL)
+  {
+    evel_meas_vnic_performance_add(measurement, vnic);
+  }
+}
+
+/**************************************************************************//**
+ * Report the memory plugin's gauges, in bytes, as memory usage in
+ * kilobytes.  Memory usage is identified by the VM, which is the host.
+ *****************************************************************************/
+static void evel_collectd_report_memory(
+                               EVENT_MEASUREMENT * const measurement,
+                               const EVEL_COLLECTD_HOST * const host,
+                               const EVEL_COLLECTD_INSTANCE * const instance)
+{
+  MEASUREMENT_MEM_USE * mem_use;
+  const EVEL_COLLECTD_LIST * list;
+  DLIST_ITEM * item;
+  double buffered = 0.0;
+  double kb;
+  bool updated = false;
+
+  for (item = dlist_get_first((DLIST *) &instance->lists);
+       item != NULL;
+       item = dlist_get_next(item))
+  {
+    list = item->item;
+    updated = updated || list->updated;
+    if (list->updated && strcmp(list->type_instance, "buffered") == 0)
+    {
+      buffered = evel_collectd_value(list, 0) / EVEL_COLLECTD_KB;
+    }
+  }
+  if (!updated)
+  {
+    return;
+  }
+
+  mem_use = evel_measurement_new_mem_use_add(measurement,
+                                             (char *) host->name,
+                                             (char *) host->name,
+                                             buffered);
+  if (mem_use == NULL)
+  {
+    return;
+  }
+
+  for (item = dlist_get_first((DLIST *) &instance->lists);
+       item != NULL;
+       item = dlist_get_next(item))
+  {
+    list = item->item;
+    if (!list->updated)
+    {
+      continue;
+    }
+    kb = evel_collectd_value(list, 0) / EVEL_COLLECTD_KB;
+    if (strcmp(list->type_instance, "used") == 0)
+      evel_measurement_mem_use_usedup_set(mem_use, kb);
+    else if (strcmp(list->type_instance, "free") == 0)
+      evel_measurement_mem_use_memfree_set(mem_use, kb);
+    else if (strcmp(list->type_instance, "cached") == 0)
+      evel_measurement_mem_use_memcache_set(mem_use, kb);
+    else if (strcmp(list->type_instance, "slab_recl") == 0)
+      evel_measurement_mem_use_slab_reclaimed_set(mem_use, kb);
+    else if (strcmp(list->type_instance, "slab_unrecl") == 0)
+      evel_measurement_mem_use_slab_unreclaimable_set(mem_use, kb);
+  }
+}
+
+/**************************************************************************//**
+ * Report any other plugin's values as custom measurements, grouped by
+ * plugin instance and named by type, type instance and, where a list has
+ * several values, index.  Counters and derives are reported as rates, so
+ * only from their second reading.
+ *****************************************************************************/
+static void evel_collectd_report_custom(
+                               EVENT_MEASUREMENT * const measurement,
+                               const EVEL_COLLECTD_INSTANCE * const instance)
+{
+  const EVEL_COLLECTD_LIST * list;
+  DLIST_ITEM * item;
+  char group[2 * EVEL_COLLECTD_NAME_LEN];
+  char name[2 * EVEL_COLLECTD_NAME_LEN + EVEL_COLLECTD_VALUE_LEN];
+  char value[EVEL_COLLECTD_VALUE_LEN];
+  int ii;
+
+  if (instance->plugin_instance[0] != '\0')
+  {
+    snprintf(group, sizeof(group), "%s-%s",
+             instance->plugin, instance->plugin_instance);
+  }
+  else
+  {
+    snprintf(group, sizeof(group), "%s", instance->plugin);
+  }
+
+  for (item = dlist_get_first((DLIST *) &instance->lists);
+       item != NULL;
+       item = dlist_get_next(item))
+  {
+    list = item->item;
+    if (!list->updated)
+    {
+      continue;
+    }
+    for (ii = 0; ii < list->num_values; ii++)
+    {
+      if (!evel_collectd_ready(list, ii))
+      {
+        continue;
+      }
+      snprintf(name, sizeof(name), "%s%s%s",
+               list->type,
+               (list->type_instance[0] != '\0') ? "-" : "",
+               list->type_instance);
+      if (list->num_values > 1)
+      {
+        snprintf(name + strlen(name), sizeof(name) - strlen(name),
+                 ".%d", ii);
+      }
+      snprintf(value, sizeof(value), "%.15g", evel_collectd_value(list, ii));
+      evel_measurement_custom_measurement_add(measurement, group, name, value);
+    }
+  }
+}
+
+/**************************************************************************//**
+ * Report the values received since the last report, as one measurement per
+ * host.
+ *
+ * @param collectd  The receiver.
+ * @param function  Function creating the measurement for a host, which the
+ *                  values are then added to, or returning NULL to skip it.
+ * @param context   Context passed to function.
+ *
+ * @returns The number of hosts reported.
+ *****************************************************************************/
+int evel_collectd_report(EVEL_COLLECTD * const collectd,
+                         EVEL_COLLECTD_MEASUREMENT_FN function,
+                         void * context)
+{
+  EVEL_COLLECTD_HOST * host;
+  EVEL_COLLECTD_INSTANCE * instance;
+  EVEL_COLLECTD_LIST * list;
+  EVENT_MEASUREMENT * measurement;
+  DLIST_ITEM * host_item;
+  DLIST_ITEM * instance_item;
+  DLIST_ITEM * list_item;
+  int num_hosts = 0;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(collectd != NULL);
+  assert(function != NULL);
+
+  for (host_item = dlist_get_first(&collectd->hosts);
+       host_item != NULL;
+       host_item = dlist_get_next(host_item))
+  {
+    host = host_item->item;
+    if (!host->updated)
+    {
+      continue;
+    }
+
+    measurement = (*function)(context, host->name);
+    for (instance_item = dlist_get_first(&host->instances);
+         instance_item != NULL;
+         instance_item = dlist_get_next(instance_item))
+    {
+      instance = instance_item->item;
+      if (measurement != NULL)
+      {
+        if (strcmp(instance->plugin, "cpu") == 0)
+        {
+          evel_collectd_report_cpu(measurement, instance);
+        }
+        else if (strcmp(instance->plugin, "interface") == 0)
+        {
+          evel_collectd_report_interface(measurement, instance);
+        }
+        else if (strcmp(instance->plugin, "memory") == 0)
+        {
+          evel_collectd_report_memory(measurement, host, instance);
+        }
+        else
+        {
+          evel_collectd_report_custom(measurement, instance);
+        }
+      }
+
+      for (list_item = dlist_get_first(&instance->lists);
+           list_item != NULL;
+           list_item = dlist_get_next(list_item))
+      {
+        list = list_item->item;
+        list->updated = false;
+      }
+    }
+    host->updated = false;
+
+    if (measurement != NULL)
+    {
+      num_hosts++;
+    }
+  }
+
+  EVEL_EXIT();
+
+  return num_hosts;
+}
@@ -0,0 +1,650 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Reporter command templates, compiled once and rendered per interface.
+ *
+ * The reporters' configuration gives shell commands with variables such as
+ * $tmp_device in them.  Rather than copying each template and searching it
+ * for the variable every time it is run, a template is split once into
+ * literal and variable segments.
+ *
+ * Most of the templates shipped read one counter out of /proc/net/dev with
+ * a pipeline of the form:
+ *
+ *   [sudo] cat /proc/net/dev | grep $tmp_device | tr -s ' ' |
+ *                                       cut -d ':' -f2 | cut -d ' ' -f<n>
+ *
+ * Those are recognised when compiled, and answered from an interface
+ * snapshot rather than by starting six processes.  The snapshot matches the
+ * interface name exactly, where grep would match any line containing it,
+ * and does not depend on the kernel leaving a space after the colon.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Longest word, and most words, in a pipeline that can be recognised.       */
+/*****************************************************************************/
+#define EVEL_COMMAND_WORD_MAX 32
+#define EVEL_COMMAND_MAX_WORDS 24
+
+/*****************************************************************************/
+/* Commands up to this length are rendered on the stack.                     */
+/*****************************************************************************/
+#define EVEL_COMMAND_BUFFER 512
+
+/**************************************************************************//**
+ * A shell word, or a pipe.
+ *****************************************************************************/
+typedef struct evel_command_word {
+  char text[EVEL_COMMAND_WORD_MAX];
+  int pipe;
+} EVEL_COMMAND_WORD;
+
+/*****************************************************************************/
+/* The counters in a /proc/net/dev line, from the second field on once the   */
+/* interface name and colon are cut off.                                     */
+/*****************************************************************************/
+static const size_t evel_command_if_fields[] = {
+  offsetof(EVEL_IF_STATS, rx_bytes),
+  offsetof(EVEL_IF_STATS, rx_packets),
+  offsetof(EVEL_IF_STATS, rx_errors),
+  offsetof(EVEL_IF_STATS, rx_dropped),
+  offsetof(EVEL_IF_STATS, rx_fifo_errors),
+  offsetof(EVEL_IF_STATS, rx_frame_errors),
+  offsetof(EVEL_IF_STATS, rx_compressed),
+  offsetof(EVEL_IF_STATS, rx_multicast),
+  offsetof(EVEL_IF_STATS, tx_bytes),
+  offsetof(EVEL_IF_STATS, tx_packets),
+  offsetof(EVEL_IF_STATS, tx_errors),
+  offsetof(EVEL_IF_STATS, tx_dropped),
+  offsetof(EVEL_IF_STATS, tx_fifo_errors),
+  offsetof(EVEL_IF_STATS, tx_collisions),
+  offsetof(EVEL_IF_STATS, tx_carrier_errors),
+  offsetof(EVEL_IF_STATS, tx_compressed)
+};
+#define EVEL_COMMAND_NUM_IF_FIELDS ((int) (sizeof(evel_command_if_fields) / \
+                                          sizeof(evel_command_if_fields[0])))
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static int evel_command_is_name_char(const char c);
+static void evel_command_recognise(EVEL_COMMAND * const command,
+                                   const char * const * variables,
+                                   const int num_variables);
+static int evel_command_split(const char * text,
+                              EVEL_COMMAND_WORD * words,
+                              const int max_words);
+static int evel_command_cut(const EVEL_COMMAND_WORD * words,
+                            const int num_words,
+                            char * const delimiter);
+
+/**************************************************************************//**
+ * Compile a command template.
+ *
+ * @param command   The command to initialize.
+ * @param text      The template.
+ * @param variables Names of the variables, without the '$'.
+ * @param num_variables  Number of variables.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_OUT_OF_MEMORY On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_command_compile(EVEL_COMMAND * const command,
+                                    const char * const text,
+                                    const char * const * variables,
+                                    const int num_variables)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  EVEL_COMMAND_SEGMENT * segment = NULL;
+  const char * pos;
+  const char * literal;
+  size_t name_length;
+  size_t match_length;
+  int max_segments = 1;
+  int match;
+  int ii;
+
+  EVEL_ENTER();
+
+  assert(command != NULL);
+  assert(text != NULL);
+  assert(num_variables == 0 || variables != NULL);
+
+  memset(command, 0, sizeof(EVEL_COMMAND));
+  command->type = EVEL_COMMAND_SHELL;
+  command->if_variable = -1;
+
+  command->text = strdup(text);
+  for (pos = text; *pos != '\0'; pos++)
+  {
+    if (*pos == '$')
+    {
+      max_segments += 2;
+    }
+  }
+  command->segments = calloc(max_segments, sizeof(EVEL_COMMAND_SEGMENT));
+  if (command->text == NULL || command->segments == NULL)
+  {
+    log_error_state("Failed to allocate command");
+    evel_command_free(command);
+    rc = EVEL_OUT_OF_MEMORY;
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Split at each "$name" that is one of the variables, taking the longest  */
+  /* name that matches.                                                      */
+  /***************************************************************************/
+  literal = command->text;
+  for (pos = command->text; *pos != '\0'; pos++)
+  {
+    if (*pos != '$')
+    {
+      continue;
+    }
+    match = -1;
+    match_length = 0;
+    for (ii = 0; ii < num_variables; ii++)
+    {
+      name_length = strlen(variables[ii]);
+      if (name_length > match_length &&
+          strncmp(pos + 1, variables[ii], name_length) == 0 &&
+          !evel_command_is_name_char(pos[1 + name_length]))
+      {
+        match = ii;
+        match_length = name_length;
+      }
+    }
+    if (match < 0)
+    {
+      continue;
+    }
+
+    if (pos > literal)
+    {
+      segment = &command->segments[command->num_segments++];
+      segment->text = literal;
+      segment->length = pos - literal;
+      segment->variable = -1;
+      command->literal_length += segment->length;
+    }
+    segment = &command->segments[command->num_segments++];
+    segment->variable = match;
+    literal = pos + 1 + match_length;
+    pos += match_length;
+  }
+  if (*literal != '\0')
+  {
+    segment = &command->segments[command->num_segments++];
+    segment->text = literal;
+    segment->length = strlen(literal);
+    segment->variable = -1;
+    command->literal_length += segment->length;
+  }
+
+  evel_command_recognise(command, variables, num_variables);
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Free the memory held by a compiled command.
+ *
+ * @param command   The command.
+ *****************************************************************************/
+void evel_command_free(EVEL_COMMAND * const command)
+{
+  assert(command != NULL);
+
+  free(command->text);
+  free(command->segments);
+  command->text = NULL;
+  command->segments = NULL;
+  command->num_segments = 0;
+}
+
+/**************************************************************************//**
+ * Render a command with values for its variables.
+ *
+ * @param command   The command.
+ * @param values    Values of the variables, in the order they were named.
+ * @param buffer    Where to put the command, NUL-terminated.
+ * @param size      Size of @p buffer.
+ *
+ * @returns Length of the whole command, which was truncated if this is not
+ *          less than @p size.
+ *****************************************************************************/
+size_t evel_command_render(const EVEL_COMMAND * const command,
+                           const char * const * values,
+                           char * const buffer,
+                           const size_t size)
+{
+  const EVEL_COMMAND_SEGMENT * segment;
+  const char * text;
+  size_t length = 0;
+  size_t part;
+  size_t copy;
+  int ii;
+
+  assert(command != NULL);
+  assert(buffer != NULL);
+  assert(size > 0);
+
+  for (ii = 0; ii < command->num_segments; ii++)
+  {
+    segment = &command->segments[ii];
+    if (segment->variable < 0)
+    {
+      text = segment->text;
+      part = segment->length;
+    }
+    else
+    {
+      assert(values != NULL);
+      text = values[segment->variable];
+      part = strlen(text);
+    }
+
+    if (length < size - 1)
+    {
+      copy = (part < size - 1 - length) ? part : size - 1 - length;
+      memcpy(buffer + length, text, copy);
+    }
+    length += part;
+  }
+  buffer[(length < size) ? length : size - 1] = '\0';
+
+  return length;
+}
+
+/**************************************************************************//**
+ * Run a command and get the last line of its output.
+ *
+ * @param command   The command.
+ * @param values    Values of the variables, in the order they were named.
+ * @param snapshot  Interface counters, or NULL to always use the shell.
+ * @param result    Where to put the output, NUL-terminated.
+ * @param size      Size of @p result.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_command_run(const EVEL_COMMAND * const command,
+                                const char * const * values,
+                                const EVEL_IF_SNAPSHOT * const snapshot,
+                                char * const result,
+                                const size_t size)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  const EVEL_IF_STATS * stats;
+  const unsigned long long * counter;
+  char stack_buffer[EVEL_COMMAND_BUFFER];
+  char * buffer = stack_buffer;
+  size_t length;
+  FILE * fp;
+  int status;
+
+  EVEL_ENTER();
+
+  assert(command != NULL);
+  assert(result != NULL);
+  assert(size > 0);
+
+  result[0] = '\0';
+
+  if (command->type == EVEL_COMMAND_IF_STATS && snapshot != NULL)
+  {
+    stats = evel_if_snapshot_get(snapshot, values[command->if_variable]);
+    if (stats == NULL)
+    {
+      log_error_state("No interface %s", values[command->if_variable]);
+      rc = EVEL_ERR_GEN_FAIL;
+      goto exit_label;
+    }
+    counter = (const unsigned long long *)
+                              ((const char *) stats + command->if_field);
+    snprintf(result, size, "%llu", *counter);
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Render the command, on the heap if it is too long for the stack.        */
+  /***************************************************************************/
+  length = evel_command_render(command, values, buffer, sizeof(stack_buffer));
+  if (length >= sizeof(stack_buffer))
+  {
+    buffer = malloc(length + 1);
+    if (buffer == NULL)
+    {
+      log_error_state("Failed to allocate command");
+      rc = EVEL_OUT_OF_MEMORY;
+      goto exit_label;
+    }
+    evel_command_render(command, values, buffer, length + 1);
+  }
+
+  fp = popen(buffer, "r");
+  if (fp == NULL)
+  {
+    log_error_state("Failed to run %s", buffer);
+    rc = EVEL_ERR_GEN_FAIL;
+    goto free_label;
+  }
+  while (fgets(result, size, fp) != NULL)
+  {
+  }
+  result[strcspn(result, "\n")] = '\0';
+
+  status = pclose(fp);
+  if (status != 0)
+  {
+    log_error_state("Command %s failed with status %d",
+                    buffer, WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+    rc = EVEL_ERR_GEN_FAIL;
+  }
+
+free_label:
+  if (buffer != stack_buffer)
+  {
+    free(buffer);
+  }
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Check whether a character can be part of a variable name.
+ *****************************************************************************/
+static int evel_command_is_name_char(const char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '_';
+}
+
+/**************************************************************************//**
+ * Recognise a pipeline which reads an interface counter from /proc/net/dev.
+ *
+ * @param command   The compiled command, updated if it is recognised.
+ * @param variables Names of the variables.
+ * @param num_variables  Number of variables.
+ *****************************************************************************/
+static void evel_command_recognise(EVEL_COMMAND * const command,
+                                   const char * const * variables,
+                                   const int num_variables)
+{
+  EVEL_COMMAND_WORD words[EVEL_COMMAND_MAX_WORDS];
+  const EVEL_COMMAND_WORD * stage[5];
+  int stage_words[5];
+  int num_words;
+  int num_stages = 0;
+  int variable = -1;
+  int field;
+  int first;
+  char delimiter;
+  int ii;
+
+  num_words = evel_command_split(command->text,
+                                 words,
+                                 EVEL_COMMAND_MAX_WORDS);
+  if (num_words <= 0)
+  {
+    return;
+  }
+
+  /***************************************************************************/
+  /* Break the words into the stages of the pipeline.                        */
+  /***************************************************************************/
+  for (first = 0, ii = 0; ii <= num_words; ii++)
+  {
+    if (ii == num_words || words[ii].pipe)
+    {
+      if (num_stages == 5 || ii == first)
+      {
+        return;
+      }
+      stage[num_stages] = &words[first];
+      stage_words[num_stages++] = ii - first;
+      first = ii + 1;
+    }
+  }
+  if (num_stages != 5)
+  {
+    return;
+  }
+
+  /***************************************************************************/
+  /* [sudo] cat /proc/net/dev                                                */
+  /***************************************************************************/
+  if (strcmp(stage[0][0].text, "sudo") == 0)
+  {
+    stage[0]++;
+    stage_words[0]--;
+  }
+  if (stage_words[0] != 2 ||
+      strcmp(stage[0][0].text, "cat") != 0 ||
+      strcmp(stage[0][1].text, EVEL_IF_PROC_NET_DEV) != 0)
+  {
+    return;
+  }
+
+  /***************************************************************************/
+  /* grep $variable                                                          */
+  /***************************************************************************/
+  if (stage_words[1] != 2 ||
+      strcmp(stage[1][0].text, "grep") != 0 ||
+      stage[1][1].text[0] != '$')
+  {
+    return;
+  }
+  for (ii = 0; ii < num_variables; ii++)
+  {
+    if (strcmp(stage[1][1].text + 1, variables[ii]) == 0)
+    {
+      variable = ii;
+    }
+  }
+  if (variable < 0)
+  {
+    return;
+  }
+
+  /***************************************************************************/
+  /* tr -s ' '                                                               */
+  /***************************************************************************/
+  if (stage_words[2] != 3 ||
+      strcmp(stage[2][0].text, "tr") != 0 ||
+      strcmp(stage[2][1].text, "-s") != 0 ||
+      strcmp(stage[2][2].text, " ") != 0)
+  {
+    return;
+  }
+
+  /***************************************************************************/
+  /* cut -d ':' -f2 | cut -d ' ' -f<n>                                       */
+  /***************************************************************************/
+  if (evel_command_cut(stage[3], stage_words[3], &delimiter) != 2 ||
+      delimiter != ':')
+  {
+    return;
+  }
+  field = evel_command_cut(stage[4], stage_words[4], &delimiter);
+  if (delimiter != ' ' ||
+      field < 2 ||
+      field - 2 >= EVEL_COMMAND_NUM_IF_FIELDS)
+  {
+    return;
+  }
+
+  command->type = EVEL_COMMAND_IF_STATS;
+  command->if_variable = variable;
+  command->if_field = evel_command_if_fields[field - 2];
+}
+
+/**************************************************************************//**
+ * Split a command into shell words, with unquoted pipes as words of their
+ * own.
+ *
+ * @param text      The command.
+ * @param words     Where to put the words.
+ * @param max_words Size of @p words.
+ *
+ * @returns Number of words, or -1 if the command is too long or uses any
+ *          shell syntax other than quotes and pipes.
+ *****************************************************************************/
+static int evel_command_split(const char * text,
+                              EVEL_COMMAND_WORD * words,
+                              const int max_words)
+{
+  int num_words = 0;
+  size_t length;
+  char quote;
+
+  while (*text != '\0')
+  {
+    if (*text == ' ' || *text == '\t')
+    {
+      text++;
+      continue;
+    }
+    if (num_words == max_words)
+    {
+      return -1;
+    }
+    memset(&words[num_words], 0, sizeof(EVEL_COMMAND_WORD));
+    if (*text == '|')
+    {
+      words[num_words++].pipe = 1;
+      text++;
+      continue;
+    }
+
+    length = 0;
+    while (*text != '\0' && *text != ' ' && *text != '\t' && *text != '|')
+    {
+      if (strchr(";&<>`\\(){}", *text) != NULL)
+      {
+        return -1;
+      }
+      if (*text == '\'' || *text == '"')
+      {
+        quote = *text++;
+        while (*text != quote)
+        {
+          if (*text == '\0' || length + 1 >= EVEL_COMMAND_WORD_MAX)
+          {
+            return -1;
+          }
+          words[num_words].text[length++] = *text++;
+        }
+        text++;
+      }
+      else
+      {
+        if (length + 1 >= EVEL_COMMAND_WORD_MAX)
+        {
+          return -1;
+        }
+        words[num_words].text[length++] = *text++;
+      }
+    }
+    num_words++;
+  }
+
+  return num_words;
+}
+
+/**************************************************************************//**
+ * Parse a "cut -d<delimiter> -f<field>" stage, with each option's value
+ * either attached or as the next word.
+ *
+ * @param words     The words of the stage.
+ * @param num_words Number of words.
+ * @param delimiter Where to put the delimiter, or '\0' if there is none.
+ *
+ * @returns The field, or -1 if the stage is not of that form.
+ *****************************************************************************/
+static int evel_command_cut(const EVEL_COMMAND_WORD * words,
+                            const int num_words,
+                            char * const delimiter)
+{
+  const char * value;
+  char * end;
+  char option;
+  int field = -1;
+  int ii;
+
+  *delimiter = '\0';
+  if (num_words < 3 || strcmp(words[0].text, "cut") != 0)
+  {
+    return -1;
+  }
+
+  for (ii = 1; ii < num_words; ii++)
+  {
+    option = words[ii].text[1];
+    if (words[ii].text[0] != '-' || (option != 'd' && option != 'f'))
+    {
+      return -1;
+    }
+    value = words[ii].text + 2;
+    if (*value == '\0')
+    {
+      if (++ii == num_words)
+      {
+        return -1;
+      }
+      value = words[ii].text;
+    }
+
+    if (option == 'd')
+    {
+      if (strlen(value) != 1)
+      {
+        return -1;
+      }
+      *delimiter = value[0];
+    }
+    else
+    {
+      field = (int) strtol(value, &end, 10);
+      if (end == value || *end != '\0')
+      {
+        return -1;
+      }
+    }
+  }
+
+  return field;
+}
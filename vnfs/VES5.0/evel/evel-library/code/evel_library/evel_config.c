@@ -0,0 +1,1120 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Reporter configuration files, parsed once and reloaded on change.
+ *
+ * The reporters' JSON configuration used to be looked up by scanning the
+ * whole token array for every parameter on every pass of their loops.  Here
+ * a file is parsed once into a tree, the reporter compiles the tree into its
+ * own typed structure, and the file is only read again when inotify says it
+ * has changed.  A new version is swapped in under a mutex, while versions
+ * still in use by other threads are kept until they are released.
+ *
+ * The parser is self-contained rather than using jsmn, because the
+ * reporters link their own jsmn with a different token layout.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/inotify.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Initial sizes, grown as needed.                                           */
+/*****************************************************************************/
+#define EVEL_CONFIG_INITIAL_BUFFER 4096
+#define EVEL_CONFIG_INITIAL_NODES 64
+
+/*****************************************************************************/
+/* Deepest nesting of objects and arrays accepted.                           */
+/*****************************************************************************/
+#define EVEL_CONFIG_MAX_DEPTH 32
+
+/*****************************************************************************/
+/* Space for a batch of inotify events.                                      */
+/*****************************************************************************/
+#define EVEL_CONFIG_EVENT_BUFFER 4096
+
+/**************************************************************************//**
+ * Parser state.  Names and values are unescaped in place as they are
+ * parsed, and NUL-terminated once the whole file has been parsed, as the
+ * character after a primitive is still needed until then.
+ *****************************************************************************/
+typedef struct evel_config_parser {
+  EVEL_CONFIG * config;
+  char * pos;
+  char * end;
+  int * lengths;              /** Name and value lengths, two per node.      */
+} EVEL_CONFIG_PARSER;
+
+/**************************************************************************//**
+ * One version of a watched configuration, with the number of holders: the
+ * watch while it is current, and each acquirer.
+ *****************************************************************************/
+typedef struct evel_config_version {
+  EVEL_CONFIG * config;
+  void * compiled;
+  int references;
+  struct evel_config_version * next;
+} EVEL_CONFIG_VERSION;
+
+/**************************************************************************//**
+ * Watch state.  The mutex protects the versions.
+ *****************************************************************************/
+struct evel_config_watch {
+  char * path;
+  const char * file_name;
+  int inotify_fd;
+  EVEL_CONFIG_COMPILE_FN compile;
+  EVEL_CONFIG_FREE_FN free_compiled;
+  void * context;
+  pthread_mutex_t mutex;
+  EVEL_CONFIG_VERSION * current;
+  EVEL_CONFIG_VERSION * retired;
+};
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static char * evel_config_read_file(const char * path, size_t * length);
+static int evel_config_parse_value(EVEL_CONFIG_PARSER * parser,
+                                   char * name,
+                                   int name_length,
+                                   int depth);
+static int evel_config_parse_string(EVEL_CONFIG_PARSER * parser,
+                                    char ** start,
+                                    int * length);
+static int evel_config_new_node(EVEL_CONFIG_PARSER * parser);
+static void evel_config_skip_space(EVEL_CONFIG_PARSER * parser);
+static int evel_config_hex(const char * pos);
+static EVEL_CONFIG_VERSION * evel_config_load(EVEL_CONFIG_WATCH * watch);
+static void evel_config_version_free(EVEL_CONFIG_WATCH * watch,
+                                     EVEL_CONFIG_VERSION * version);
+
+/**************************************************************************//**
+ * Read and parse a JSON configuration file.
+ *
+ * @param path      The file.
+ *
+ * @returns pointer to the new configuration.
+ * @retval  NULL  The file could not be read or is not valid JSON.
+ *****************************************************************************/
+EVEL_CONFIG * evel_new_config(const char * const path)
+{
+  EVEL_CONFIG * config = NULL;
+  EVEL_CONFIG_PARSER parser;
+  EVEL_CONFIG_NODE * node;
+  size_t length;
+  int i;
+
+  EVEL_ENTER();
+
+  assert(path != NULL);
+
+  memset(&parser, 0, sizeof(EVEL_CONFIG_PARSER));
+  config = calloc(1, sizeof(EVEL_CONFIG));
+  if (config == NULL)
+  {
+    log_error_state("Failed to allocate configuration");
+    goto exit_label;
+  }
+  config->text = evel_config_read_file(path, &length);
+  if (config->text == NULL)
+  {
+    goto error_label;
+  }
+
+  parser.config = config;
+  parser.pos = config->text;
+  parser.end = config->text + length;
+  evel_config_skip_space(&parser);
+  if (parser.pos == parser.end || (*parser.pos != '{' && *parser.pos != '['))
+  {
+    log_error_state("%s is not a JSON object or array", path);
+    goto error_label;
+  }
+  if (evel_config_parse_value(&parser, NULL, 0, 0) < 0)
+  {
+    log_error_state("%s is not valid JSON, at offset %ld",
+                    path, (long) (parser.pos - config->text));
+    goto error_label;
+  }
+  evel_config_skip_space(&parser);
+  if (parser.pos != parser.end)
+  {
+    log_error_state("%s has data after the JSON, at offset %ld",
+                    path, (long) (parser.pos - config->text));
+    goto error_label;
+  }
+
+  for (i = 0; i < config->num_nodes; i++)
+  {
+    node = &config->nodes[i];
+    if (node->name != NULL)
+    {
+      node->name[parser.lengths[2 * i]] = '\0';
+    }
+    if (node->value != NULL)
+    {
+      node->value[parser.lengths[2 * i + 1]] = '\0';
+    }
+  }
+  goto exit_label;
+
+error_label:
+  evel_free_config(config);
+  config = NULL;
+
+exit_label:
+  free(parser.lengths);
+  EVEL_EXIT();
+  return config;
+}
+
+/**************************************************************************//**
+ * Free a configuration.
+ *
+ * @param config    The configuration.  May be NULL.
+ *****************************************************************************/
+void evel_free_config(EVEL_CONFIG * const config)
+{
+  EVEL_ENTER();
+
+  if (config != NULL)
+  {
+    free(config->text);
+    free(config->nodes);
+    free(config);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Find a value by its path of member names.
+ *
+ * @param config    The configuration.
+ * @param node      Where the path starts, or NULL for the top level.
+ * @param path      Member names separated by '/'.
+ *
+ * @returns The value, or NULL if there is none.
+ *****************************************************************************/
+const EVEL_CONFIG_NODE * evel_config_find(const EVEL_CONFIG * const config,
+                                          const EVEL_CONFIG_NODE * node,
+                                          const char * const path)
+{
+  const EVEL_CONFIG_NODE * child;
+  const char * name = path;
+  size_t name_length;
+
+  assert(config != NULL);
+  assert(path != NULL);
+
+  if (node == NULL)
+  {
+    node = &config->nodes[0];
+  }
+
+  while (node != NULL && *name != '\0')
+  {
+    name_length = strcspn(name, "/");
+    if (node->type != EVEL_CONFIG_OBJECT)
+    {
+      return NULL;
+    }
+    for (child = evel_config_child(config, node);
+         child != NULL;
+         child = evel_config_next(config, child))
+    {
+      if (strncmp(child->name, name, name_length) == 0 &&
+          child->name[name_length] == '\0')
+      {
+        break;
+      }
+    }
+    node = child;
+    name += name_length;
+    if (*name == '/')
+    {
+      name++;
+    }
+  }
+
+  return node;
+}
+
+/**************************************************************************//**
+ * Get a string or primitive by path.
+ *
+ * @param config    The configuration.
+ * @param node      Where the path starts, or NULL for the top level.
+ * @param path      Member names separated by '/'.
+ * @param default_value  Value if the path is missing or not a string.
+ *
+ * @returns The value, owned by the configuration.
+ *****************************************************************************/
+const char * evel_config_string(const EVEL_CONFIG * const config,
+                                const EVEL_CONFIG_NODE * const node,
+                                const char * const path,
+                                const char * const default_value)
+{
+  const EVEL_CONFIG_NODE * value = evel_config_find(config, node, path);
+
+  return (value != NULL && value->value != NULL) ?
+                                                 value->value : default_value;
+}
+
+/**************************************************************************//**
+ * Get an integer by path.
+ *
+ * @param config    The configuration.
+ * @param node      Where the path starts, or NULL for the top level.
+ * @param path      Member names separated by '/'.
+ * @param default_value  Value if the path is missing or not an integer.
+ *
+ * @returns The value.
+ *****************************************************************************/
+int evel_config_int(const EVEL_CONFIG * const config,
+                    const EVEL_CONFIG_NODE * const node,
+                    const char * const path,
+                    const int default_value)
+{
+  const EVEL_CONFIG_NODE * value = evel_config_find(config, node, path);
+  char * end;
+  long result;
+
+  if (value == NULL || value->type != EVEL_CONFIG_PRIMITIVE)
+  {
+    return default_value;
+  }
+
+  errno = 0;
+  result = strtol(value->value, &end, 10);
+  if (errno != 0 || *end != '\0' || end == value->value ||
+      result < INT_MIN || result > INT_MAX)
+  {
+    return default_value;
+  }
+
+  return (int) result;
+}
+
+/**************************************************************************//**
+ * Get the first child of an object or array.
+ *
+ * @param config    The configuration.
+ * @param node      The object or array.
+ *
+ * @returns The child, or NULL if there is none.
+ *****************************************************************************/
+const EVEL_CONFIG_NODE * evel_config_child(const EVEL_CONFIG * const config,
+                                           const EVEL_CONFIG_NODE * node)
+{
+  assert(config != NULL);
+  assert(node != NULL);
+
+  return (node->child >= 0) ? &config->nodes[node->child] : NULL;
+}
+
+/**************************************************************************//**
+ * Get the next sibling of a member or array element.
+ *
+ * @param config    The configuration.
+ * @param node      The member or element.
+ *
+ * @returns The sibling, or NULL if there is none.
+ *****************************************************************************/
+const EVEL_CONFIG_NODE * evel_config_next(const EVEL_CONFIG * const config,
+                                          const EVEL_CONFIG_NODE * node)
+{
+  assert(config != NULL);
+  assert(node != NULL);
+
+  return (node->next >= 0) ? &config->nodes[node->next] : NULL;
+}
+
+/**************************************************************************//**
+ * Load and compile a configuration file, and watch it for changes.
+ *
+ * @param path      The file.
+ * @param compile   Function compiling each version of the file.
+ * @param free_compiled  Function freeing a compiled version.
+ * @param context   Context passed to compile.
+ *
+ * @returns pointer to the new watch.
+ * @retval  NULL  The file could not be loaded or compiled.
+ *****************************************************************************/
+EVEL_CONFIG_WATCH * evel_new_config_watch(const char * const path,
+                                          EVEL_CONFIG_COMPILE_FN compile,
+                                          EVEL_CONFIG_FREE_FN free_compiled,
+                                          void * const context)
+{
+  EVEL_CONFIG_WATCH * watch = NULL;
+  char * slash;
+
+  EVEL_ENTER();
+
+  assert(path != NULL);
+  assert(compile != NULL);
+  assert(free_compiled != NULL);
+
+  watch = calloc(1, sizeof(EVEL_CONFIG_WATCH));
+  if (watch == NULL)
+  {
+    log_error_state("Failed to allocate configuration watch");
+    goto exit_label;
+  }
+  watch->inotify_fd = -1;
+  watch->compile = compile;
+  watch->free_compiled = free_compiled;
+  watch->context = context;
+  pthread_mutex_init(&watch->mutex, NULL);
+
+  /***************************************************************************/
+  /* Keep the path as "directory\0file" so both halves are to hand.          */
+  /***************************************************************************/
+  watch->path = malloc(strlen(path) + 3);
+  if (watch->path == NULL)
+  {
+    log_error_state("Failed to allocate configuration watch");
+    goto error_label;
+  }
+  slash = strrchr(path, '/');
+  if (slash == NULL)
+  {
+    strcpy(watch->path, ".");
+    strcpy(watch->path + 2, path);
+    watch->file_name = watch->path + 2;
+  }
+  else if (slash == path)
+  {
+    strcpy(watch->path, "/");
+    strcpy(watch->path + 2, path + 1);
+    watch->file_name = watch->path + 2;
+  }
+  else
+  {
+    strcpy(watch->path, path);
+    watch->path[slash - path] = '\0';
+    watch->file_name = watch->path + (slash - path) + 1;
+  }
+
+  watch->current = evel_config_load(watch);
+  if (watch->current == NULL)
+  {
+    goto error_label;
+  }
+
+  /***************************************************************************/
+  /* Without inotify the configuration still works, it just never reloads.   */
+  /***************************************************************************/
+  watch->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (watch->inotify_fd < 0)
+  {
+    EVEL_ERROR("Failed to create inotify for %s: %s",
+               path, strerror(errno));
+  }
+  else if (inotify_add_watch(watch->inotify_fd,
+                             watch->path,
+                             IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+  {
+    EVEL_ERROR("Failed to watch %s: %s", watch->path, strerror(errno));
+    close(watch->inotify_fd);
+    watch->inotify_fd = -1;
+  }
+  goto exit_label;
+
+error_label:
+  evel_free_config_watch(watch);
+  watch = NULL;
+
+exit_label:
+  EVEL_EXIT();
+  return watch;
+}
+
+/**************************************************************************//**
+ * Free a watch and its compiled configuration.
+ *
+ * @param watch     The watch.  May be NULL.
+ *****************************************************************************/
+void evel_free_config_watch(EVEL_CONFIG_WATCH * const watch)
+{
+  EVEL_CONFIG_VERSION * version;
+
+  EVEL_ENTER();
+
+  if (watch != NULL)
+  {
+    if (watch->inotify_fd >= 0)
+    {
+      close(watch->inotify_fd);
+    }
+    if (watch->current != NULL)
+    {
+      evel_config_version_free(watch, watch->current);
+    }
+    while (watch->retired != NULL)
+    {
+      version = watch->retired;
+      watch->retired = version->next;
+      EVEL_ERROR("Freeing configuration still in use");
+      evel_config_version_free(watch, version);
+    }
+    pthread_mutex_destroy(&watch->mutex);
+    free(watch->path);
+    free(watch);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Reload the configuration if the file has changed.
+ *
+ * @param watch     The watch.
+ *
+ * @returns Non-zero if a new version was loaded.
+ *****************************************************************************/
+int evel_config_watch_check(EVEL_CONFIG_WATCH * const watch)
+{
+  char events[EVEL_CONFIG_EVENT_BUFFER]
+                 __attribute__ ((aligned(__alignof__(struct inotify_event))));
+  const struct inotify_event * event;
+  EVEL_CONFIG_VERSION * version;
+  EVEL_CONFIG_VERSION * old = NULL;
+  ssize_t bytes;
+  ssize_t offset;
+  int changed = 0;
+
+  assert(watch != NULL);
+
+  if (watch->inotify_fd < 0)
+  {
+    return 0;
+  }
+
+  /***************************************************************************/
+  /* Drain the events, noting whether any were for our file.                 */
+  /***************************************************************************/
+  for (;;)
+  {
+    bytes = read(watch->inotify_fd, events, sizeof(events));
+    if (bytes <= 0)
+    {
+      break;
+    }
+    for (offset = 0; offset < bytes; )
+    {
+      event = (const struct inotify_event *) (events + offset);
+      if (event->len > 0 && strcmp(event->name, watch->file_name) == 0)
+      {
+        changed = 1;
+      }
+      offset += sizeof(struct inotify_event) + event->len;
+    }
+  }
+  if (!changed)
+  {
+    return 0;
+  }
+
+  EVEL_INFO("Reloading %s/%s", watch->path, watch->file_name);
+  version = evel_config_load(watch);
+  if (version == NULL)
+  {
+    EVEL_ERROR("Keeping the current configuration");
+    return 0;
+  }
+
+  /***************************************************************************/
+  /* Swap in the new version.  The old one is freed now if nobody else has   */
+  /* it, or when the last holder releases it.                                */
+  /***************************************************************************/
+  pthread_mutex_lock(&watch->mutex);
+  old = watch->current;
+  watch->current = version;
+  if (--old->references > 0)
+  {
+    old->next = watch->retired;
+    watch->retired = old;
+    old = NULL;
+  }
+  pthread_mutex_unlock(&watch->mutex);
+
+  if (old != NULL)
+  {
+    evel_config_version_free(watch, old);
+  }
+
+  return 1;
+}
+
+/**************************************************************************//**
+ * Get the current compiled configuration.
+ *
+ * @param watch     The watch.
+ *
+ * @returns The compiled configuration.
+ *****************************************************************************/
+void * evel_config_watch_acquire(EVEL_CONFIG_WATCH * const watch)
+{
+  void * compiled;
+
+  assert(watch != NULL);
+
+  pthread_mutex_lock(&watch->mutex);
+  watch->current->references++;
+  compiled = watch->current->compiled;
+  pthread_mutex_unlock(&watch->mutex);
+
+  return compiled;
+}
+
+/**************************************************************************//**
+ * Release a compiled configuration from evel_config_watch_acquire().
+ *
+ * @param watch     The watch.
+ * @param compiled  The compiled configuration.
+ *****************************************************************************/
+void evel_config_watch_release(EVEL_CONFIG_WATCH * const watch,
+                               void * const compiled)
+{
+  EVEL_CONFIG_VERSION ** link;
+  EVEL_CONFIG_VERSION * version = NULL;
+
+  assert(watch != NULL);
+  assert(compiled != NULL);
+
+  pthread_mutex_lock(&watch->mutex);
+  if (watch->current->compiled == compiled)
+  {
+    watch->current->references--;
+  }
+  else
+  {
+    for (link = &watch->retired; *link != NULL; link = &(*link)->next)
+    {
+      if ((*link)->compiled == compiled)
+      {
+        if (--(*link)->references == 0)
+        {
+          version = *link;
+          *link = version->next;
+        }
+        break;
+      }
+    }
+  }
+  pthread_mutex_unlock(&watch->mutex);
+
+  if (version != NULL)
+  {
+    evel_config_version_free(watch, version);
+  }
+}
+
+/**************************************************************************//**
+ * Load and compile a version of a watched configuration.
+ *
+ * @param watch     The watch.
+ *
+ * @returns The version, held once, or NULL on failure.
+ *****************************************************************************/
+static EVEL_CONFIG_VERSION * evel_config_load(EVEL_CONFIG_WATCH * watch)
+{
+  EVEL_CONFIG_VERSION * version;
+  char path[PATH_MAX];
+
+  if (strcmp(watch->path, "/") == 0)
+  {
+    snprintf(path, sizeof(path), "/%s", watch->file_name);
+  }
+  else
+  {
+    snprintf(path, sizeof(path), "%s/%s", watch->path, watch->file_name);
+  }
+
+  version = calloc(1, sizeof(EVEL_CONFIG_VERSION));
+  if (version == NULL)
+  {
+    log_error_state("Failed to allocate configuration version");
+    return NULL;
+  }
+  version->references = 1;
+  version->config = evel_new_config(path);
+  if (version->config != NULL)
+  {
+    version->compiled = watch->compile(version->config, watch->context);
+  }
+  if (version->compiled == NULL)
+  {
+    log_error_state("Failed to load configuration %s", path);
+    evel_free_config(version->config);
+    free(version);
+    return NULL;
+  }
+
+  return version;
+}
+
+/**************************************************************************//**
+ * Free a version of a watched configuration.
+ *
+ * @param watch     The watch.
+ * @param version   The version.
+ *****************************************************************************/
+static void evel_config_version_free(EVEL_CONFIG_WATCH * watch,
+                                     EVEL_CONFIG_VERSION * version)
+{
+  watch->free_compiled(version->compiled);
+  evel_free_config(version->config);
+  free(version);
+}
+
+/**************************************************************************//**
+ * Read a whole file.
+ *
+ * @param path        The file.
+ * @param[out] length Length of the contents.
+ *
+ * @returns The contents, NUL-terminated, which the caller must free, or
+ *          NULL on failure.
+ *****************************************************************************/
+static char * evel_config_read_file(const char * path, size_t * length)
+{
+  char * buffer = NULL;
+  char * new_buffer;
+  size_t buffer_size = EVEL_CONFIG_INITIAL_BUFFER;
+  ssize_t bytes;
+  int fd;
+
+  *length = 0;
+  fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    log_error_state("Failed to open %s: %s", path, strerror(errno));
+    goto exit_label;
+  }
+
+  buffer = malloc(buffer_size);
+  while (buffer != NULL)
+  {
+    if (*length + 1 >= buffer_size)
+    {
+      new_buffer = realloc(buffer, buffer_size * 2);
+      if (new_buffer == NULL)
+      {
+        log_error_state("Failed to grow buffer for %s", path);
+        free(buffer);
+        buffer = NULL;
+        break;
+      }
+      buffer = new_buffer;
+      buffer_size *= 2;
+    }
+
+    bytes = read(fd, buffer + *length, buffer_size - *length - 1);
+    if (bytes < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (bytes < 0)
+    {
+      log_error_state("Failed to read %s: %s", path, strerror(errno));
+      free(buffer);
+      buffer = NULL;
+      break;
+    }
+    if (bytes == 0)
+    {
+      buffer[*length] = '\0';
+      break;
+    }
+    *length += bytes;
+  }
+  close(fd);
+
+exit_label:
+  return buffer;
+}
+
+/**************************************************************************//**
+ * Parse a value and everything in it.
+ *
+ * @param parser      The parser, positioned at the value.
+ * @param name        The value's member name, or NULL.
+ * @param name_length Length of the name.
+ * @param depth       Nesting depth of the value.
+ *
+ * @returns Index of the value's node, or -1 on error.
+ *****************************************************************************/
+static int evel_config_parse_value(EVEL_CONFIG_PARSER * parser,
+                                   char * name,
+                                   int name_length,
+                                   int depth)
+{
+  EVEL_CONFIG_NODE * nodes;
+  char * member_name;
+  char * start;
+  int member_length;
+  int length;
+  int index;
+  int child;
+  int last = -1;
+  char close;
+
+  if (depth > EVEL_CONFIG_MAX_DEPTH)
+  {
+    return -1;
+  }
+
+  index = evel_config_new_node(parser);
+  if (index < 0)
+  {
+    return -1;
+  }
+  nodes = parser->config->nodes;
+  nodes[index].name = name;
+  parser->lengths[2 * index] = name_length;
+
+  evel_config_skip_space(parser);
+  if (parser->pos == parser->end)
+  {
+    return -1;
+  }
+
+  switch (*parser->pos)
+  {
+    case '{':
+    case '[':
+      close = (*parser->pos == '{') ? '}' : ']';
+      nodes[index].type = (close == '}') ? EVEL_CONFIG_OBJECT :
+                                           EVEL_CONFIG_ARRAY;
+      parser->pos++;
+      evel_config_skip_space(parser);
+      if (parser->pos < parser->end && *parser->pos == close)
+      {
+        parser->pos++;
+        break;
+      }
+      for (;;)
+      {
+        member_name = NULL;
+        member_length = 0;
+        if (close == '}')
+        {
+          evel_config_skip_space(parser);
+          if (parser->pos == parser->end || *parser->pos != '"' ||
+              evel_config_parse_string(parser,
+                                       &member_name,
+                                       &member_length) < 0)
+          {
+            return -1;
+          }
+          evel_config_skip_space(parser);
+          if (parser->pos == parser->end || *parser->pos != ':')
+          {
+            return -1;
+          }
+          parser->pos++;
+        }
+
+        child = evel_config_parse_value(parser,
+                                        member_name,
+                                        member_length,
+                                        depth + 1);
+        if (child < 0)
+        {
+          return -1;
+        }
+
+        /*********************************************************************/
+        /* Nodes may have moved as children were added.                      */
+        /*********************************************************************/
+        nodes = parser->config->nodes;
+        if (last < 0)
+        {
+          nodes[index].child = child;
+        }
+        else
+        {
+          nodes[last].next = child;
+        }
+        nodes[index].size++;
+        last = child;
+
+        evel_config_skip_space(parser);
+        if (parser->pos == parser->end)
+        {
+          return -1;
+        }
+        if (*parser->pos == close)
+        {
+          parser->pos++;
+          break;
+        }
+        if (*parser->pos != ',')
+        {
+          return -1;
+        }
+        parser->pos++;
+      }
+      break;
+
+    case '"':
+      nodes[index].type = EVEL_CONFIG_STRING;
+      if (evel_config_parse_string(parser, &start, &length) < 0)
+      {
+        return -1;
+      }
+      parser->config->nodes[index].value = start;
+      parser->lengths[2 * index + 1] = length;
+      break;
+
+    default:
+      nodes[index].type = EVEL_CONFIG_PRIMITIVE;
+      start = parser->pos;
+      if (strchr("-0123456789tfn", *start) == NULL)
+      {
+        return -1;
+      }
+      while (parser->pos < parser->end &&
+             strchr(" \t\r\n,]}", *parser->pos) == NULL)
+      {
+        parser->pos++;
+      }
+      if (parser->pos == start)
+      {
+        return -1;
+      }
+      nodes[index].value = start;
+      parser->lengths[2 * index + 1] = parser->pos - start;
+      break;
+  }
+
+  return index;
+}
+
+/**************************************************************************//**
+ * Parse a string, unescaping it in place.
+ *
+ * @param parser      The parser, positioned at the opening quote.
+ * @param[out] start  Start of the unescaped string.
+ * @param[out] length Length of the unescaped string.
+ *
+ * @returns 0 on success, or -1 on error.
+ *****************************************************************************/
+static int evel_config_parse_string(EVEL_CONFIG_PARSER * parser,
+                                    char ** start,
+                                    int * length)
+{
+  char * out;
+  int code;
+
+  parser->pos++;
+  *start = out = parser->pos;
+
+  for (;;)
+  {
+    if (parser->pos == parser->end || (unsigned char) *parser->pos < ' ')
+    {
+      return -1;
+    }
+    if (*parser->pos == '"')
+    {
+      parser->pos++;
+      break;
+    }
+    if (*parser->pos != '\\')
+    {
+      *out++ = *parser->pos++;
+      continue;
+    }
+
+    if (parser->end - parser->pos < 2)
+    {
+      return -1;
+    }
+    parser->pos++;
+    switch (*parser->pos)
+    {
+      case '"':
+      case '\\':
+      case '/':
+        *out++ = *parser->pos;
+        break;
+      case 'b':
+        *out++ = '\b';
+        break;
+      case 'f':
+        *out++ = '\f';
+        break;
+      case 'n':
+        *out++ = '\n';
+        break;
+      case 'r':
+        *out++ = '\r';
+        break;
+      case 't':
+        *out++ = '\t';
+        break;
+      case 'u':
+        /*********************************************************************/
+        /* Characters in the Basic Multilingual Plane, as UTF-8, which is    */
+        /* never longer than the escape.                                     */
+        /*********************************************************************/
+        if (parser->end - parser->pos < 5)
+        {
+          return -1;
+        }
+        code = evel_config_hex(parser->pos + 1);
+        if (code <= 0)
+        {
+          return -1;
+        }
+        if (code < 0x80)
+        {
+          *out++ = (char) code;
+        }
+        else if (code < 0x800)
+        {
+          *out++ = (char) (0xC0 | (code >> 6));
+          *out++ = (char) (0x80 | (code & 0x3F));
+        }
+        else
+        {
+          *out++ = (char) (0xE0 | (code >> 12));
+          *out++ = (char) (0x80 | ((code >> 6) & 0x3F));
+          *out++ = (char) (0x80 | (code & 0x3F));
+        }
+        parser->pos += 4;
+        break;
+      default:
+        return -1;
+    }
+    parser->pos++;
+  }
+
+  *length = out - *start;
+  return 0;
+}
+
+/**************************************************************************//**
+ * Add a node, growing the arrays if needed.
+ *
+ * @param parser    The parser.
+ *
+ * @returns Index of the new node, or -1 on allocation failure.
+ *****************************************************************************/
+static int evel_config_new_node(EVEL_CONFIG_PARSER * parser)
+{
+  EVEL_CONFIG * config = parser->config;
+  EVEL_CONFIG_NODE * new_nodes;
+  int * new_lengths;
+  int new_max;
+
+  if (config->num_nodes == config->max_nodes)
+  {
+    new_max = (config->max_nodes == 0) ? EVEL_CONFIG_INITIAL_NODES :
+                                         2 * config->max_nodes;
+    new_nodes = realloc(config->nodes, new_max * sizeof(EVEL_CONFIG_NODE));
+    if (new_nodes == NULL)
+    {
+      log_error_state("Failed to grow configuration");
+      return -1;
+    }
+    config->nodes = new_nodes;
+    new_lengths = realloc(parser->lengths, 2 * new_max * sizeof(int));
+    if (new_lengths == NULL)
+    {
+      log_error_state("Failed to grow configuration");
+      return -1;
+    }
+    parser->lengths = new_lengths;
+    config->max_nodes = new_max;
+  }
+
+  memset(&config->nodes[config->num_nodes], 0, sizeof(EVEL_CONFIG_NODE));
+  config->nodes[config->num_nodes].child = -1;
+  config->nodes[config->num_nodes].next = -1;
+  parser->lengths[2 * config->num_nodes] = 0;
+  parser->lengths[2 * config->num_nodes + 1] = 0;
+  return config->num_nodes++;
+}
+
+/**************************************************************************//**
+ * Skip whitespace.
+ *
+ * @param parser    The parser.
+ *****************************************************************************/
+static void evel_config_skip_space(EVEL_CONFIG_PARSER * parser)
+{
+  while (parser->pos < parser->end &&
+         (*parser->pos == ' ' || *parser->pos == '\t' ||
+          *parser->pos == '\r' || *parser->pos == '\n'))
+  {
+    parser->pos++;
+  }
+}
+
+/**************************************************************************//**
+ * Decode four hex digits.
+ *
+ * @param pos   The digits.
+ *
+ * @returns The value, or -1 if they are not all hex digits.
+ *****************************************************************************/
+static int evel_config_hex(const char * pos)
+{
+  int value = 0;
+  int i;
+
+  for (i = 0; i < 4; i++)
+  {
+    value <<= 4;
+    if (pos[i] >= '0' && pos[i] <= '9')
+    {
+      value |= pos[i] - '0';
+    }
+    else if (pos[i] >= 'a' && pos[i] <= 'f')
+    {
+      value |= pos[i] - 'a' + 10;
+    }
+    else if (pos[i] >= 'A' && pos[i] <= 'F')
+    {
+      value |= pos[i] - 'A' + 10;
+    }
+    else
+    {
+      return -1;
+    }
+  }
+
+  return value;
+}
@@ -0,0 +1,173 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Wrap-aware deltas and rates for monotonically increasing counters.
+ *
+ * When a reading is lower than the one before, the counter has either
+ * wrapped past its maximum or been reset to zero.  A counter only wraps
+ * between two readings if it was in the top half of its range, assuming it
+ * grows by less than half its range per interval, so that is taken as a
+ * wrap and anything else as a reset.  Counters of unknown width are taken
+ * as 32-bit until they exceed 32 bits.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <string.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Largest value of a 32-bit counter.                                        */
+/*****************************************************************************/
+#define EVEL_COUNTER_MAX_32 0xFFFFFFFFULL
+
+/**************************************************************************//**
+ * Initialize a counter with no readings.
+ *
+ * @param counter   The counter.
+ * @param width     Width of the counter in bits: 32, 64, or
+ *                  ::EVEL_COUNTER_AUTO if it is not known.
+ *****************************************************************************/
+void evel_counter_init(EVEL_COUNTER * const counter, const int width)
+{
+  EVEL_ENTER();
+
+  assert(counter != NULL);
+  assert(width == EVEL_COUNTER_AUTO || width == 32 || width == 64);
+
+  memset(counter, 0, sizeof(EVEL_COUNTER));
+  counter->width = width;
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Work out how much a counter has increased between two readings.
+ *
+ * @param previous  The earlier reading.
+ * @param current   The later reading.
+ * @param width     Width of the counter in bits: 32, 64, or
+ *                  ::EVEL_COUNTER_AUTO.
+ * @param[out] reset  Set non-zero if the counter appears to have been reset,
+ *                  in which case the increase is counted from zero.  May be
+ *                  NULL.
+ *
+ * @returns The increase.
+ *****************************************************************************/
+unsigned long long evel_counter_delta(const unsigned long long previous,
+                                      const unsigned long long current,
+                                      const int width,
+                                      int * const reset)
+{
+  unsigned long long prev = previous;
+  unsigned long long curr = current;
+  unsigned long long top_half;
+  int bits = width;
+
+  if (reset != NULL)
+  {
+    *reset = 0;
+  }
+
+  if (bits == EVEL_COUNTER_AUTO)
+  {
+    bits = (prev <= EVEL_COUNTER_MAX_32) ? 32 : 64;
+  }
+  if (bits == 32)
+  {
+    prev &= EVEL_COUNTER_MAX_32;
+    curr &= EVEL_COUNTER_MAX_32;
+  }
+
+  if (curr >= prev)
+  {
+    return curr - prev;
+  }
+
+  /***************************************************************************/
+  /* Gone backwards: a wrap if it was close enough to the top, else a reset. */
+  /***************************************************************************/
+  top_half = 1ULL << (bits - 1);
+  if (prev >= top_half)
+  {
+    if (bits == 32)
+    {
+      return (EVEL_COUNTER_MAX_32 - prev) + curr + 1;
+    }
+    return curr - prev;
+  }
+
+  if (reset != NULL)
+  {
+    *reset = 1;
+  }
+  return curr;
+}
+
+/**************************************************************************//**
+ * Record a new reading of a counter.
+ *
+ * Afterwards, value holds the reading for use as an accumulated ("_acc")
+ * figure, and, from the second reading on, delta and rate hold the increase
+ * since the last reading and that increase per second.
+ *
+ * @param counter   The counter.
+ * @param value     The new reading.
+ * @param timestamp When the reading was taken, in microseconds from
+ *                  evel_time_monotonic_usec().
+ *****************************************************************************/
+void evel_counter_update(EVEL_COUNTER * const counter,
+                         const unsigned long long value,
+                         const unsigned long long timestamp)
+{
+  unsigned long long elapsed;
+
+  EVEL_ENTER();
+
+  assert(counter != NULL);
+
+  if (counter->valid)
+  {
+    counter->delta = evel_counter_delta(counter->value,
+                                        value,
+                                        counter->width,
+                                        &counter->reset);
+    elapsed = timestamp - counter->timestamp;
+    counter->rate = (timestamp > counter->timestamp) ?
+                      (double) counter->delta * 1000000.0 / (double) elapsed :
+                      0.0;
+    if (counter->reset)
+    {
+      EVEL_DEBUG("Counter reset from %llu to %llu", counter->value, value);
+    }
+  }
+  else
+  {
+    counter->delta = 0;
+    counter->rate = 0.0;
+    counter->reset = 0;
+  }
+
+  counter->value = value;
+  counter->timestamp = timestamp;
+  counter->valid = 1;
+
+  EVEL_EXIT();
+}
@@ -0,0 +1,494 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Per-CPU usage from /proc/stat.
+ *
+ * /proc/stat starts like this:
+ *
+ *   cpu  10132153 290696 3084719 46828483 16683 0 25195 0 0 0
+ *   cpu0 1393280 32966 572056 13343292 6130 0 17875 0 0 0
+ *   cpu1 1335339 38296 490542 13436683 3637 0 3211 0 0 0
+ *   intr 199292 ...
+ *
+ * where the first line is the total and the counters are the jiffies spent
+ * in user, nice, system, idle, iowait, irq, softirq and steal, followed by
+ * guest time which is already included in user.  Only the per-CPU lines
+ * are kept, and the file is only read as far as the end of them, which is
+ * normally a single read() however many interrupts the system has.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Initial sizes, grown as needed.                                           */
+/*****************************************************************************/
+#define EVEL_CPU_INITIAL_CPUS 16
+#define EVEL_CPU_INITIAL_BUFFER 4096
+
+/*****************************************************************************/
+/* Number of counters kept from each line, and how many a line must have:    */
+/* kernels before 2.6 stop after idle.                                       */
+/*****************************************************************************/
+#define EVEL_CPU_COUNTERS 8
+#define EVEL_CPU_MIN_COUNTERS 4
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static EVEL_ERR_CODES evel_cpu_read_file(EVEL_CPU_SNAPSHOT * snapshot,
+                                         const char * path);
+static int evel_cpu_lines_complete(const char * buffer);
+static const char * evel_cpu_parse_counter(const char * pos,
+                                           unsigned long long * value);
+static EVEL_CPU_STATS * evel_cpu_snapshot_add(EVEL_CPU_SNAPSHOT * snapshot);
+static const EVEL_CPU_STATS * evel_cpu_snapshot_find(
+                                      const EVEL_CPU_SNAPSHOT * snapshot,
+                                      const EVEL_CPU_STATS * cpu,
+                                      int hint);
+static unsigned long long evel_cpu_delta(unsigned long long current,
+                                         unsigned long long previous);
+
+/**************************************************************************//**
+ * Initialize an empty CPU snapshot.
+ *
+ * @param snapshot  The snapshot to initialize.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_OUT_OF_MEMORY On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_cpu_snapshot_init(EVEL_CPU_SNAPSHOT * const snapshot)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+
+  EVEL_ENTER();
+
+  assert(snapshot != NULL);
+
+  memset(snapshot, 0, sizeof(EVEL_CPU_SNAPSHOT));
+  snapshot->cpus = malloc(EVEL_CPU_INITIAL_CPUS * sizeof(EVEL_CPU_STATS));
+  snapshot->buffer = malloc(EVEL_CPU_INITIAL_BUFFER);
+  if (snapshot->cpus == NULL || snapshot->buffer == NULL)
+  {
+    log_error_state("Failed to allocate CPU snapshot");
+    evel_cpu_snapshot_free(snapshot);
+    rc = EVEL_OUT_OF_MEMORY;
+    goto exit_label;
+  }
+  snapshot->max_cpus = EVEL_CPU_INITIAL_CPUS;
+  snapshot->buffer_size = EVEL_CPU_INITIAL_BUFFER;
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Free the memory held by a CPU snapshot.
+ *
+ * @param snapshot  The snapshot to free.
+ *****************************************************************************/
+void evel_cpu_snapshot_free(EVEL_CPU_SNAPSHOT * const snapshot)
+{
+  EVEL_ENTER();
+
+  assert(snapshot != NULL);
+
+  free(snapshot->cpus);
+  free(snapshot->buffer);
+  memset(snapshot, 0, sizeof(EVEL_CPU_SNAPSHOT));
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Read the counters for every CPU from /proc/stat.
+ *
+ * @param snapshot  The snapshot to update.
+ * @param path      File to read, or NULL for ::EVEL_CPU_PROC_STAT.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_cpustats_read_procfs(EVEL_CPU_SNAPSHOT * const snapshot,
+                                         const char * const path)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  EVEL_CPU_STATS * cpu;
+  unsigned long long counters[EVEL_CPU_COUNTERS];
+  const char * file = (path != NULL) ? path : EVEL_CPU_PROC_STAT;
+  const char * line;
+  const char * pos;
+  size_t id_len;
+  int i;
+
+  EVEL_ENTER();
+
+  assert(snapshot != NULL);
+  assert(snapshot->cpus != NULL);
+
+  rc = evel_cpu_read_file(snapshot, file);
+  if (rc != EVEL_SUCCESS)
+  {
+    goto exit_label;
+  }
+  snapshot->timestamp = evel_time_monotonic_usec();
+  snapshot->num_cpus = 0;
+
+  /***************************************************************************/
+  /* Take the "cpuN" lines, skipping the "cpu" total, and stop at the first  */
+  /* line that is neither.                                                   */
+  /***************************************************************************/
+  for (line = snapshot->buffer;
+       line != NULL && strncmp(line, "cpu", 3) == 0;
+       line = (pos != NULL) ? pos + 1 : NULL)
+  {
+    pos = strchr(line, '\n');
+    if (line[3] < '0' || line[3] > '9')
+    {
+      continue;
+    }
+
+    id_len = strcspn(line, " \n");
+    pos = line + id_len;
+    memset(counters, 0, sizeof(counters));
+    for (i = 0; i < EVEL_CPU_COUNTERS; i++)
+    {
+      pos = evel_cpu_parse_counter(pos, &counters[i]);
+      if (pos == NULL)
+      {
+        break;
+      }
+    }
+    if (i < EVEL_CPU_MIN_COUNTERS || id_len > EVEL_CPU_ID_MAX)
+    {
+      EVEL_ERROR("Skipping malformed CPU line in %s", file);
+    }
+    else
+    {
+      cpu = evel_cpu_snapshot_add(snapshot);
+      if (cpu == NULL)
+      {
+        rc = EVEL_OUT_OF_MEMORY;
+        goto exit_label;
+      }
+      memcpy(cpu->id, line, id_len);
+      cpu->id[id_len] = '\0';
+      cpu->user = counters[0];
+      cpu->nice = counters[1];
+      cpu->system = counters[2];
+      cpu->idle = counters[3];
+      cpu->iowait = counters[4];
+      cpu->irq = counters[5];
+      cpu->softirq = counters[6];
+      cpu->steal = counters[7];
+    }
+    pos = strchr(line, '\n');
+  }
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Add a CPU Use to a Measurement for each CPU.
+ *
+ * CPUs which are not in the earlier snapshot, having just come online, are
+ * left out, as are CPUs which have not ticked since.
+ *
+ * @param measurement   Pointer to the Measurement.
+ * @param current       The later snapshot.
+ * @param previous      The earlier snapshot, or NULL for the whole time
+ *                      since boot.
+ *****************************************************************************/
+void evel_cpustats_measurement_add(EVENT_MEASUREMENT * const measurement,
+                                   const EVEL_CPU_SNAPSHOT * const current,
+                                   const EVEL_CPU_SNAPSHOT * const previous)
+{
+  static const EVEL_CPU_STATS zero;
+  MEASUREMENT_CPU_USE * cpu_use;
+  const EVEL_CPU_STATS * now;
+  const EVEL_CPU_STATS * then;
+  unsigned long long user;
+  unsigned long long nice;
+  unsigned long long system;
+  unsigned long long idle;
+  unsigned long long iowait;
+  unsigned long long irq;
+  unsigned long long softirq;
+  unsigned long long steal;
+  double total;
+  int i;
+
+  EVEL_ENTER();
+
+  assert(measurement != NULL);
+  assert(current != NULL);
+
+  for (i = 0; i < current->num_cpus; i++)
+  {
+    now = &current->cpus[i];
+    then = (previous != NULL) ?
+             evel_cpu_snapshot_find(previous, now, i) : &zero;
+    if (then == NULL)
+    {
+      continue;
+    }
+
+    user = evel_cpu_delta(now->user, then->user);
+    nice = evel_cpu_delta(now->nice, then->nice);
+    system = evel_cpu_delta(now->system, then->system);
+    idle = evel_cpu_delta(now->idle, then->idle);
+    iowait = evel_cpu_delta(now->iowait, then->iowait);
+    irq = evel_cpu_delta(now->irq, then->irq);
+    softirq = evel_cpu_delta(now->softirq, then->softirq);
+    steal = evel_cpu_delta(now->steal, then->steal);
+    total = (double) (user + nice + system + idle +
+                      iowait + irq + softirq + steal);
+    if (total == 0.0)
+    {
+      continue;
+    }
+
+    cpu_use = evel_measurement_new_cpu_use_add(
+                         measurement,
+                         (char *) now->id,
+                         100.0 * (total - idle - iowait) / total);
+    evel_measurement_cpu_use_idle_set(cpu_use, 100.0 * idle / total);
+    evel_measurement_cpu_use_interrupt_set(cpu_use, 100.0 * irq / total);
+    evel_measurement_cpu_use_nice_set(cpu_use, 100.0 * nice / total);
+    evel_measurement_cpu_use_softirq_set(cpu_use, 100.0 * softirq / total);
+    evel_measurement_cpu_use_steal_set(cpu_use, 100.0 * steal / total);
+    evel_measurement_cpu_use_system_set(cpu_use, 100.0 * system / total);
+    evel_measurement_cpu_use_usageuser_set(cpu_use, 100.0 * user / total);
+    evel_measurement_cpu_use_wait_set(cpu_use, 100.0 * iowait / total);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Read /proc/stat into the snapshot's buffer, as far as the end of the CPU
+ * lines, and NUL-terminate it.
+ *
+ * @param snapshot  The snapshot whose buffer to use.
+ * @param path      File to read.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+static EVEL_ERR_CODES evel_cpu_read_file(EVEL_CPU_SNAPSHOT * snapshot,
+                                         const char * path)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  char * new_buffer;
+  size_t length = 0;
+  ssize_t bytes;
+  int fd;
+
+  fd = open(path, O_RDONLY);
+  if (fd < 0)
+  {
+    log_error_state("Failed to open %s: %s", path, strerror(errno));
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  for (;;)
+  {
+    if (length + 1 >= snapshot->buffer_size)
+    {
+      new_buffer = realloc(snapshot->buffer, snapshot->buffer_size * 2);
+      if (new_buffer == NULL)
+      {
+        log_error_state("Failed to grow buffer for %s", path);
+        rc = EVEL_OUT_OF_MEMORY;
+        break;
+      }
+      snapshot->buffer = new_buffer;
+      snapshot->buffer_size *= 2;
+    }
+
+    bytes = read(fd,
+                 snapshot->buffer + length,
+                 snapshot->buffer_size - length - 1);
+    if (bytes < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (bytes < 0)
+    {
+      log_error_state("Failed to read %s: %s", path, strerror(errno));
+      rc = EVEL_ERR_GEN_FAIL;
+      break;
+    }
+    length += bytes;
+    snapshot->buffer[length] = '\0';
+    if (bytes == 0 || evel_cpu_lines_complete(snapshot->buffer))
+    {
+      break;
+    }
+  }
+  snapshot->buffer[length] = '\0';
+  close(fd);
+
+exit_label:
+  return rc;
+}
+
+/**************************************************************************//**
+ * Check whether a buffer holds all of the CPU lines: that is, whether the
+ * start of a later line has been read.
+ *
+ * @param buffer    The NUL-terminated buffer.
+ *
+ * @returns Non-zero if all the CPU lines are in the buffer.
+ *****************************************************************************/
+static int evel_cpu_lines_complete(const char * buffer)
+{
+  const char * line = buffer;
+
+  while ((line = strchr(line, '\n')) != NULL)
+  {
+    line++;
+    if (strnlen(line, 3) == 3 && strncmp(line, "cpu", 3) != 0)
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**************************************************************************//**
+ * Parse one decimal counter, skipping leading spaces.
+ *
+ * @param pos         Where to start.
+ * @param[out] value  The counter.
+ *
+ * @returns The position after the counter, or NULL if there is none.
+ *****************************************************************************/
+static const char * evel_cpu_parse_counter(const char * pos,
+                                           unsigned long long * value)
+{
+  unsigned long long result = 0;
+
+  while (*pos == ' ')
+  {
+    pos++;
+  }
+  if (*pos < '0' || *pos > '9')
+  {
+    return NULL;
+  }
+  while (*pos >= '0' && *pos <= '9')
+  {
+    result = result * 10 + (*pos - '0');
+    pos++;
+  }
+
+  *value = result;
+  return pos;
+}
+
+/**************************************************************************//**
+ * Add a CPU to the end of the snapshot, growing it if need be.
+ *
+ * @param snapshot  The snapshot.
+ *
+ * @returns The new, uninitialized, entry, or NULL on allocation failure.
+ *****************************************************************************/
+static EVEL_CPU_STATS * evel_cpu_snapshot_add(EVEL_CPU_SNAPSHOT * snapshot)
+{
+  EVEL_CPU_STATS * new_cpus;
+
+  if (snapshot->num_cpus == snapshot->max_cpus)
+  {
+    new_cpus = realloc(snapshot->cpus,
+                       2 * snapshot->max_cpus * sizeof(EVEL_CPU_STATS));
+    if (new_cpus == NULL)
+    {
+      log_error_state("Failed to grow CPU snapshot");
+      return NULL;
+    }
+    snapshot->cpus = new_cpus;
+    snapshot->max_cpus *= 2;
+  }
+
+  return &snapshot->cpus[snapshot->num_cpus++];
+}
+
+/**************************************************************************//**
+ * Find a CPU in another snapshot.
+ *
+ * @param snapshot  The snapshot to search.
+ * @param cpu       The CPU to find.
+ * @param hint      Where the CPU is likely to be, as CPUs seldom go offline.
+ *
+ * @returns The CPU's counters, or NULL if it is not in the snapshot.
+ *****************************************************************************/
+static const EVEL_CPU_STATS * evel_cpu_snapshot_find(
+                                      const EVEL_CPU_SNAPSHOT * snapshot,
+                                      const EVEL_CPU_STATS * cpu,
+                                      int hint)
+{
+  int i;
+
+  if (hint < snapshot->num_cpus &&
+      strcmp(snapshot->cpus[hint].id, cpu->id) == 0)
+  {
+    return &snapshot->cpus[hint];
+  }
+
+  for (i = 0; i < snapshot->num_cpus; i++)
+  {
+    if (strcmp(snapshot->cpus[i].id, cpu->id) == 0)
+    {
+      return &snapshot->cpus[i];
+    }
+  }
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Work out the jiffies spent in a state between two readings.
+ *
+ * The counters are 64-bit so do not wrap, but iowait is known to go
+ * backwards on some kernels, which counts as no time.
+ *
+ * @param current   The later reading.
+ * @param previous  The earlier reading.
+ *
+ * @returns The difference.
+ *****************************************************************************/
+static unsigned long long evel_cpu_delta(unsigned long long current,
+                                         unsigned long long previous)
+{
+  return (current > previous) ? current - previous : 0;
+}
@@ -0,0 +1,361 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Delta reporting: leaving out what has not changed since it was last sent.
+ *
+ * For each domain with delta reporting enabled we remember the text last
+ * encoded for every field of every identified object, keyed by event name,
+ * list, object identifier and field.  While an event is encoded, optional
+ * fields whose text is unchanged are left out, and an object none of whose
+ * fields changed is left out altogether.  Every so many events of the same
+ * name are sent in full, so that a collector which missed an event, or has
+ * just started, catches up.
+ *
+ * Values are remembered as they are encoded, so an event which is encoded
+ * but never reaches the collector is only made good by the next full event.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "evel.h"
+#include "evel_internal.h"
+#include "hashtable.h"
+
+/*****************************************************************************/
+/* Size of the table of values remembered for each domain.                   */
+/*****************************************************************************/
+#define EVEL_DELTA_HASH_SIZE 1024
+
+/**************************************************************************//**
+ * Delta reporting state for one domain.
+ *
+ * The table maps each field key to the text last encoded for it, and each
+ * event name to the number of events of that name encoded so far.
+ *****************************************************************************/
+struct evel_delta {
+  int refresh_intervals;
+  HASHTABLE_T * values;
+};
+
+/*****************************************************************************/
+/* Delta reporting state for each domain, NULL where it is not enabled.      */
+/*****************************************************************************/
+static EVEL_DELTA * evel_delta[EVEL_MAX_DOMAINS] = {NULL};
+
+/*****************************************************************************/
+/* Mutex protecting the state, held while an event is being encoded.         */
+/*****************************************************************************/
+static pthread_mutex_t evel_delta_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static void evel_delta_free(EVEL_DELTA * const delta);
+
+/**************************************************************************//**
+ * Enable delta reporting for a domain.
+ *
+ * @param domain            The domain.
+ * @param refresh_intervals Send every this many events of the same name in
+ *                          full.  1 sends every event in full.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success.
+ * @retval  EVEL_OUT_OF_MEMORY The state could not be allocated.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_delta_enable(const EVEL_EVENT_DOMAINS domain,
+                                 const int refresh_intervals)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  EVEL_DELTA * delta = NULL;
+  int pthread_rc;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(domain >= 0 && domain < EVEL_MAX_DOMAINS);
+  assert(refresh_intervals > 0);
+
+  pthread_rc = pthread_mutex_lock(&evel_delta_mutex);
+  assert(pthread_rc == 0);
+
+  /***************************************************************************/
+  /* Changing the refresh interval keeps the values already remembered.      */
+  /***************************************************************************/
+  if (evel_delta[domain] != NULL)
+  {
+    evel_delta[domain]->refresh_intervals = refresh_intervals;
+    goto exit_label;
+  }
+
+  delta = malloc(sizeof(EVEL_DELTA));
+  if (delta == NULL)
+  {
+    log_error_state("Failed to allocate delta reporting state");
+    rc = EVEL_OUT_OF_MEMORY;
+    goto exit_label;
+  }
+  delta->refresh_intervals = refresh_intervals;
+  delta->values = ht_create(EVEL_DELTA_HASH_SIZE);
+  if (delta->values == NULL)
+  {
+    log_error_state("Failed to allocate delta reporting table");
+    free(delta);
+    rc = EVEL_OUT_OF_MEMORY;
+    goto exit_label;
+  }
+  evel_delta[domain] = delta;
+  EVEL_INFO("Delta reporting domain %d, refresh every %d",
+            domain, refresh_intervals);
+
+exit_label:
+  pthread_rc = pthread_mutex_unlock(&evel_delta_mutex);
+  assert(pthread_rc == 0);
+
+  EVEL_EXIT();
+
+  return rc;
+}
+
+/**************************************************************************//**
+ * Disable delta reporting for a domain, forgetting the values sent.
+ *
+ * @param domain        The domain.
+ *****************************************************************************/
+void evel_delta_disable(const EVEL_EVENT_DOMAINS domain)
+{
+  int pthread_rc;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(domain >= 0 && domain < EVEL_MAX_DOMAINS);
+
+  pthread_rc = pthread_mutex_lock(&evel_delta_mutex);
+  assert(pthread_rc == 0);
+
+  evel_delta_free(evel_delta[domain]);
+  evel_delta[domain] = NULL;
+
+  pthread_rc = pthread_mutex_unlock(&evel_delta_mutex);
+  assert(pthread_rc == 0);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Clean up delta reporting.
+ *
+ * Called from ::evel_terminate.
+ *****************************************************************************/
+void evel_delta_terminate()
+{
+  int ii;
+
+  EVEL_ENTER();
+
+  for (ii = 0; ii < EVEL_MAX_DOMAINS; ii++)
+  {
+    evel_delta_disable(ii);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Start encoding an event, applying the delta reporting state for its
+ * domain if there is one.  Must be paired with ::evel_json_delta_end.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param event         Pointer to the ::EVENT_HEADER about to be encoded.
+ *****************************************************************************/
+void evel_json_delta_begin(EVEL_JSON_BUFFER * jbuf,
+                           const EVENT_HEADER * const event)
+{
+  EVEL_DELTA * delta;
+  unsigned int * count;
+  int pthread_rc;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(jbuf != NULL);
+  assert(event != NULL);
+  assert(event->event_domain < EVEL_MAX_DOMAINS);
+
+  pthread_rc = pthread_mutex_lock(&evel_delta_mutex);
+  assert(pthread_rc == 0);
+
+  jbuf->delta = NULL;
+  jbuf->delta_object_offset = -1;
+
+  delta = evel_delta[event->event_domain];
+  if ((delta == NULL) || (event->event_name == NULL))
+  {
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* The first event of each name, and every refresh_intervals'th after it,  */
+  /* is sent in full.  If we cannot count, send it in full anyway.           */
+  /***************************************************************************/
+  count = ht_get(delta->values, event->event_name);
+  if (count == NULL)
+  {
+    count = malloc(sizeof(unsigned int));
+    if (count == NULL)
+    {
+      log_error_state("Failed to allocate delta reporting count");
+      goto exit_label;
+    }
+    *count = 0;
+    ht_set(delta->values, event->event_name, count);
+  }
+  jbuf->delta = delta;
+  jbuf->delta_event = event->event_name;
+  jbuf->delta_refresh = ((*count % delta->refresh_intervals) == 0);
+  (*count)++;
+  EVEL_DEBUG("Delta encoding %s, refresh %d",
+             event->event_name, jbuf->delta_refresh);
+
+exit_label:
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Finish encoding an event started with ::evel_json_delta_begin.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ *****************************************************************************/
+void evel_json_delta_end(EVEL_JSON_BUFFER * jbuf)
+{
+  int pthread_rc;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(jbuf != NULL);
+  assert(jbuf->delta_object_offset < 0);
+
+  jbuf->delta = NULL;
+
+  pthread_rc = pthread_mutex_unlock(&evel_delta_mutex);
+  assert(pthread_rc == 0);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Remember the text just encoded for a field of the current object.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The field's key.
+ * @param text          The encoded text.
+ * @returns true if the text differs from what was last encoded for the
+ *          field, or the field has not been encoded before.
+ *****************************************************************************/
+bool evel_delta_changed(EVEL_JSON_BUFFER * jbuf,
+                        const char * const field,
+                        const char * const text)
+{
+  char key[EVEL_DELTA_KEY_LEN];
+  char * last;
+  char * copy;
+  bool changed = true;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(jbuf != NULL);
+  assert(jbuf->delta != NULL);
+  assert(field != NULL);
+  assert(text != NULL);
+
+  /***************************************************************************/
+  /* A key that does not fit could match another field's, so always send    */
+  /* the field rather than risk leaving it out.                              */
+  /***************************************************************************/
+  if (snprintf(key, sizeof(key), "%s" EVEL_DELTA_SEPARATOR "%s"
+               EVEL_DELTA_SEPARATOR "%s",
+               jbuf->delta_event, jbuf->delta_object, field) >=
+                                                              (int) sizeof(key))
+  {
+    EVEL_DEBUG("Delta key for field %s too long - always sent", field);
+    goto exit_label;
+  }
+
+  last = ht_get(jbuf->delta->values, key);
+  if ((last != NULL) && (strcmp(last, text) == 0))
+  {
+    changed = false;
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* If we cannot remember the new text, forget the old, so the field is     */
+  /* sent again next time.                                                   */
+  /***************************************************************************/
+  copy = strdup(text);
+  if ((copy == NULL) && (last != NULL))
+  {
+    last[0] = '\0';
+  }
+  else if (copy != NULL)
+  {
+    ht_set(jbuf->delta->values, key, copy);
+  }
+
+exit_label:
+  EVEL_EXIT();
+
+  return changed;
+}
+
+/**************************************************************************//**
+ * Free the delta reporting state for a domain.
+ *
+ * @param delta         The state, which may be NULL.
+ *****************************************************************************/
+static void evel_delta_free(EVEL_DELTA * const delta)
+{
+  EVEL_ENTER();
+
+  if (delta != NULL)
+  {
+    ht_destroy(delta->values);
+    free(delta);
+  }
+
+  EVEL_EXIT();
+}
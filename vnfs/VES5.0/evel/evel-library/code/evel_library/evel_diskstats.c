@@ -0,0 +1,656 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Block device usage from /proc/diskstats.
+ *
+ * /proc/diskstats has a line per block device:
+ *
+ *   8  0 sda 2237 512 190226 1310 4016 3005 118408 5340 0 4444 6650 ...
+ *
+ * giving the major and minor numbers, the name, then reads completed,
+ * reads merged, sectors read, milliseconds reading, the same four for
+ * writes, I/Os in progress, and milliseconds doing I/O.  Later kernels add
+ * more fields, which are ignored.
+ *
+ * The VES Disk Use reports the min, max, average and last of each figure
+ * over the measurement interval, so the collector is sampled several times
+ * per interval and keeps a running summary of the rates between samples.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Initial sizes, grown as needed.                                           */
+/*****************************************************************************/
+#define EVEL_DISK_INITIAL_DISKS 16
+#define EVEL_DISK_INITIAL_BUFFER 4096
+
+/*****************************************************************************/
+/* Number of counters used from each line, after the name.                   */
+/*****************************************************************************/
+#define EVEL_DISK_COUNTERS 10
+
+/*****************************************************************************/
+/* /proc/diskstats counts sectors of 512 bytes whatever the device's own     */
+/* sector size.                                                              */
+/*****************************************************************************/
+#define EVEL_DISK_SECTOR_SIZE 512
+
+/**************************************************************************//**
+ * Figures summarized for each disk, indexing EVEL_DISK_USAGE::summaries.
+ *****************************************************************************/
+typedef enum {
+  EVEL_DISK_OCTETS_READ,
+  EVEL_DISK_OCTETS_WRITE,
+  EVEL_DISK_OPS_READ,
+  EVEL_DISK_OPS_WRITE,
+  EVEL_DISK_MERGE_READ,
+  EVEL_DISK_MERGE_WRITE,
+  EVEL_DISK_TIME_READ,
+  EVEL_DISK_TIME_WRITE,
+  EVEL_DISK_IO_TIME,
+  EVEL_DISK_PENDING_OPS
+} EVEL_DISK_METRIC_TYPES;
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static EVEL_ERR_CODES evel_disk_read_file(EVEL_DISK_COLLECTOR * collector,
+                                          const char * path);
+static const char * evel_disk_parse_counter(const char * pos,
+                                            unsigned long long * value);
+static EVEL_DISK_USAGE * evel_disk_collector_find(
+                                            EVEL_DISK_COLLECTOR * collector,
+                                            const char * name,
+                                            size_t name_len,
+                                            int hint);
+static void evel_disk_usage_sample(EVEL_DISK_USAGE * disk,
+                                   const EVEL_DISK_STATS * counters,
+                                   double elapsed);
+static void evel_disk_summary_add(EVEL_DISK_SUMMARY * summary,
+                                  double value);
+static double evel_disk_average(const EVEL_DISK_SUMMARY * summary);
+static unsigned long long evel_disk_delta(unsigned long long current,
+                                          unsigned long long previous);
+
+/**************************************************************************//**
+ * Initialize an empty disk collector.
+ *
+ * @param collector The collector to initialize.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_OUT_OF_MEMORY On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_disk_collector_init(EVEL_DISK_COLLECTOR * const collector)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+
+  EVEL_ENTER();
+
+  assert(collector != NULL);
+
+  memset(collector, 0, sizeof(EVEL_DISK_COLLECTOR));
+  collector->disks = malloc(EVEL_DISK_INITIAL_DISKS * sizeof(EVEL_DISK_USAGE));
+  collector->buffer = malloc(EVEL_DISK_INITIAL_BUFFER);
+  if (collector->disks == NULL || collector->buffer == NULL)
+  {
+    log_error_state("Failed to allocate disk collector");
+    evel_disk_collector_free(collector);
+    rc = EVEL_OUT_OF_MEMORY;
+    goto exit_label;
+  }
+  collector->max_disks = EVEL_DISK_INITIAL_DISKS;
+  collector->buffer_size = EVEL_DISK_INITIAL_BUFFER;
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Free the memory held by a disk collector.
+ *
+ * @param collector The collector to free.
+ *****************************************************************************/
+void evel_disk_collector_free(EVEL_DISK_COLLECTOR * const collector)
+{
+  EVEL_ENTER();
+
+  assert(collector != NULL);
+
+  free(collector->disks);
+  free(collector->buffer);
+  memset(collector, 0, sizeof(EVEL_DISK_COLLECTOR));
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Sample every block device.
+ *
+ * Devices which have never done any I/O, such as unused loop and ram
+ * devices, are skipped.  A device's first sample only sets the baseline
+ * for the next.
+ *
+ * @param collector The collector.
+ * @param path      File to read, or NULL for ::EVEL_DISK_PROC_DISKSTATS.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_diskstats_sample(EVEL_DISK_COLLECTOR * const collector,
+                                     const char * const path)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  EVEL_DISK_USAGE * disk;
+  EVEL_DISK_STATS counters;
+  unsigned long long values[EVEL_DISK_COUNTERS];
+  unsigned long long dev_number;
+  unsigned long long now;
+  const char * file = (path != NULL) ? path : EVEL_DISK_PROC_DISKSTATS;
+  const char * line;
+  const char * name;
+  const char * pos;
+  double elapsed;
+  size_t name_len;
+  int index = 0;
+  int i;
+
+  EVEL_ENTER();
+
+  assert(collector != NULL);
+  assert(collector->disks != NULL);
+
+  rc = evel_disk_read_file(collector, file);
+  if (rc != EVEL_SUCCESS)
+  {
+    goto exit_label;
+  }
+  now = evel_time_monotonic_usec();
+  elapsed = (collector->timestamp != 0 && now > collector->timestamp) ?
+              (double) (now - collector->timestamp) / 1000000.0 : 0.0;
+  collector->timestamp = now;
+
+  for (i = 0; i < collector->num_disks; i++)
+  {
+    collector->disks[i].present = 0;
+  }
+
+  for (line = collector->buffer; line != NULL && *line != '\0'; )
+  {
+    /*************************************************************************/
+    /* Major and minor numbers, then the name.                               */
+    /*************************************************************************/
+    pos = evel_disk_parse_counter(line, &dev_number);
+    if (pos != NULL)
+    {
+      pos = evel_disk_parse_counter(pos, &dev_number);
+    }
+    if (pos != NULL)
+    {
+      while (*pos == ' ')
+      {
+        pos++;
+      }
+      name = pos;
+      name_len = strcspn(name, " \n");
+      pos = name + name_len;
+      for (i = 0; i < EVEL_DISK_COUNTERS && pos != NULL; i++)
+      {
+        pos = evel_disk_parse_counter(pos, &values[i]);
+      }
+    }
+
+    if (pos == NULL || name_len > EVEL_DISK_NAME_MAX)
+    {
+      EVEL_ERROR("Skipping malformed disk line in %s", file);
+    }
+    else if (values[0] != 0 || values[4] != 0)
+    {
+      memcpy(counters.name, name, name_len);
+      counters.name[name_len] = '\0';
+      counters.reads = values[0];
+      counters.reads_merged = values[1];
+      counters.sectors_read = values[2];
+      counters.read_ms = values[3];
+      counters.writes = values[4];
+      counters.writes_merged = values[5];
+      counters.sectors_written = values[6];
+      counters.write_ms = values[7];
+      counters.in_progress = values[8];
+      counters.io_ms = values[9];
+
+      disk = evel_disk_collector_find(collector, name, name_len, index);
+      if (disk == NULL)
+      {
+        rc = EVEL_OUT_OF_MEMORY;
+        goto exit_label;
+      }
+      if (disk->present < 0)
+      {
+        disk->counters = counters;
+      }
+      else
+      {
+        evel_disk_usage_sample(disk, &counters, elapsed);
+      }
+      disk->present = 1;
+      index = (int) (disk - collector->disks) + 1;
+    }
+
+    line = strchr(line, '\n');
+    if (line != NULL)
+    {
+      line++;
+    }
+  }
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Add a Disk Use to a Measurement for each block device sampled since the
+ * last call, then start a new interval.
+ *
+ * @param measurement   Pointer to the Measurement.
+ * @param collector     The collector.
+ *****************************************************************************/
+void evel_diskstats_measurement_add(EVENT_MEASUREMENT * const measurement,
+                                    EVEL_DISK_COLLECTOR * const collector)
+{
+  MEASUREMENT_DISK_USE * disk_use;
+  EVEL_DISK_USAGE * disk;
+  const EVEL_DISK_SUMMARY * s;
+  int i;
+
+  EVEL_ENTER();
+
+  assert(measurement != NULL);
+  assert(collector != NULL);
+
+  for (i = 0; i < collector->num_disks; i++)
+  {
+    disk = &collector->disks[i];
+    s = disk->summaries;
+    if (!disk->present || s[EVEL_DISK_OCTETS_READ].count == 0)
+    {
+      continue;
+    }
+
+    disk_use = evel_measurement_new_disk_use_add(measurement,
+                                                 disk->counters.name);
+
+    evel_measurement_disk_use_octetsreadavg_set(
+                   disk_use, evel_disk_average(&s[EVEL_DISK_OCTETS_READ]));
+    evel_measurement_disk_use_octetsreadlast_set(
+                   disk_use, s[EVEL_DISK_OCTETS_READ].last);
+    evel_measurement_disk_use_octetsreadmax_set(
+                   disk_use, s[EVEL_DISK_OCTETS_READ].max);
+    evel_measurement_disk_use_octetsreadmin_set(
+                   disk_use, s[EVEL_DISK_OCTETS_READ].min);
+
+    evel_measurement_disk_use_octetswriteavg_set(
+                   disk_use, evel_disk_average(&s[EVEL_DISK_OCTETS_WRITE]));
+    evel_measurement_disk_use_octetswritelast_set(
+                   disk_use, s[EVEL_DISK_OCTETS_WRITE].last);
+    evel_measurement_disk_use_octetswritemax_set(
+                   disk_use, s[EVEL_DISK_OCTETS_WRITE].max);
+    evel_measurement_disk_use_octetswritemin_set(
+                   disk_use, s[EVEL_DISK_OCTETS_WRITE].min);
+
+    evel_measurement_disk_use_opsreadavg_set(
+                   disk_use, evel_disk_average(&s[EVEL_DISK_OPS_READ]));
+    evel_measurement_disk_use_opsreadlast_set(
+                   disk_use, s[EVEL_DISK_OPS_READ].last);
+    evel_measurement_disk_use_opsreadmax_set(
+                   disk_use, s[EVEL_DISK_OPS_READ].max);
+    evel_measurement_disk_use_opsreadmin_set(
+                   disk_use, s[EVEL_DISK_OPS_READ].min);
+
+    evel_measurement_disk_use_opswriteavg_set(
+                   disk_use, evel_disk_average(&s[EVEL_DISK_OPS_WRITE]));
+    evel_measurement_disk_use_opswritelast_set(
+                   disk_use, s[EVEL_DISK_OPS_WRITE].last);
+    evel_measurement_disk_use_opswritemax_set(
+                   disk_use, s[EVEL_DISK_OPS_WRITE].max);
+    evel_measurement_disk_use_opswritemin_set(
+                   disk_use, s[EVEL_DISK_OPS_WRITE].min);
+
+    evel_measurement_disk_use_mergereadavg_set(
+                   disk_use, evel_disk_average(&s[EVEL_DISK_MERGE_READ]));
+    evel_measurement_disk_use_mergereadlast_set(
+                   disk_use, s[EVEL_DISK_MERGE_READ].last);
+    evel_measurement_disk_use_mergereadmax_set(
+                   disk_use, s[EVEL_DISK_MERGE_READ].max);
+    evel_measurement_disk_use_mergereadmin_set(
+                   disk_use, s[EVEL_DISK_MERGE_READ].min);
+
+    evel_measurement_disk_use_mergewriteavg_set(
+                   disk_use, evel_disk_average(&s[EVEL_DISK_MERGE_WRITE]));
+    evel_measurement_disk_use_mergewritelast_set(
+                   disk_use, s[EVEL_DISK_MERGE_WRITE].last);
+    evel_measurement_disk_use_mergewritemax_set(
+                   disk_use, s[EVEL_DISK_MERGE_WRITE].max);
+    evel_measurement_disk_use_mergewritemin_set(
+                   disk_use, s[EVEL_DISK_MERGE_WRITE].min);
+
+    evel_measurement_disk_use_timereadavg_set(
+                   disk_use, evel_disk_average(&s[EVEL_DISK_TIME_READ]));
+    evel_measurement_disk_use_timereadlast_set(
+                   disk_use, s[EVEL_DISK_TIME_READ].last);
+    evel_measurement_disk_use_timereadmax_set(
+                   disk_use, s[EVEL_DISK_TIME_READ].max);
+    evel_measurement_disk_use_timereadmin_set(
+                   disk_use, s[EVEL_DISK_TIME_READ].min);
+
+    evel_measurement_disk_use_timewriteavg_set(
+                   disk_use, evel_disk_average(&s[EVEL_DISK_TIME_WRITE]));
+    evel_measurement_disk_use_timewritelast_set(
+                   disk_use, s[EVEL_DISK_TIME_WRITE].last);
+    evel_measurement_disk_use_timewritemax_set(
+                   disk_use, s[EVEL_DISK_TIME_WRITE].max);
+    evel_measurement_disk_use_timewritemin_set(
+                   disk_use, s[EVEL_DISK_TIME_WRITE].min);
+
+    evel_measurement_disk_use_iotimeavg_set(
+                   disk_use, evel_disk_average(&s[EVEL_DISK_IO_TIME]));
+    evel_measurement_disk_use_iotimelast_set(
+                   disk_use, s[EVEL_DISK_IO_TIME].last);
+    evel_measurement_disk_use_iotimemax_set(
+                   disk_use, s[EVEL_DISK_IO_TIME].max);
+    evel_measurement_disk_use_iotimemin_set(
+                   disk_use, s[EVEL_DISK_IO_TIME].min);
+
+    evel_measurement_disk_use_pendingopsavg_set(
+                   disk_use, evel_disk_average(&s[EVEL_DISK_PENDING_OPS]));
+    evel_measurement_disk_use_pendingopslast_set(
+                   disk_use, s[EVEL_DISK_PENDING_OPS].last);
+    evel_measurement_disk_use_pendingopsmax_set(
+                   disk_use, s[EVEL_DISK_PENDING_OPS].max);
+    evel_measurement_disk_use_pendingopsmin_set(
+                   disk_use, s[EVEL_DISK_PENDING_OPS].min);
+
+    memset(disk->summaries, 0, sizeof(disk->summaries));
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Read /proc/diskstats into the collector's buffer and NUL-terminate it.
+ *
+ * @param collector The collector whose buffer to use.
+ * @param path      File to read.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+static EVEL_ERR_CODES evel_disk_read_file(EVEL_DISK_COLLECTOR * collector,
+                                          const char * path)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  char * new_buffer;
+  size_t length = 0;
+  ssize_t bytes;
+  int fd;
+
+  fd = open(path, O_RDONLY);
+  if (fd < 0)
+  {
+    log_error_state("Failed to open %s: %s", path, strerror(errno));
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  for (;;)
+  {
+    if (length + 1 >= collector->buffer_size)
+    {
+      new_buffer = realloc(collector->buffer, collector->buffer_size * 2);
+      if (new_buffer == NULL)
+      {
+        log_error_state("Failed to grow buffer for %s", path);
+        rc = EVEL_OUT_OF_MEMORY;
+        break;
+      }
+      collector->buffer = new_buffer;
+      collector->buffer_size *= 2;
+    }
+
+    bytes = read(fd,
+                 collector->buffer + length,
+                 collector->buffer_size - length - 1);
+    if (bytes < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (bytes < 0)
+    {
+      log_error_state("Failed to read %s: %s", path, strerror(errno));
+      rc = EVEL_ERR_GEN_FAIL;
+      break;
+    }
+    if (bytes == 0)
+    {
+      break;
+    }
+    length += bytes;
+  }
+  collector->buffer[length] = '\0';
+  close(fd);
+
+exit_label:
+  return rc;
+}
+
+/**************************************************************************//**
+ * Parse one decimal counter, skipping leading spaces.
+ *
+ * @param pos         Where to start.
+ * @param[out] value  The counter.
+ *
+ * @returns The position after the counter, or NULL if there is none.
+ *****************************************************************************/
+static const char * evel_disk_parse_counter(const char * pos,
+                                            unsigned long long * value)
+{
+  unsigned long long result = 0;
+
+  while (*pos == ' ')
+  {
+    pos++;
+  }
+  if (*pos < '0' || *pos > '9')
+  {
+    return NULL;
+  }
+  while (*pos >= '0' && *pos <= '9')
+  {
+    result = result * 10 + (*pos - '0');
+    pos++;
+  }
+
+  *value = result;
+  return pos;
+}
+
+/**************************************************************************//**
+ * Find a device in the collector, adding it if it is new.
+ *
+ * A new device has present set to -1, and no counters yet.
+ *
+ * @param collector The collector.
+ * @param name      The device name; need not be NUL-terminated.
+ * @param name_len  Length of @p name.
+ * @param hint      Where the device is likely to be, as the devices are
+ *                  listed in the same order each time.
+ *
+ * @returns The device, or NULL on allocation failure.
+ *****************************************************************************/
+static EVEL_DISK_USAGE * evel_disk_collector_find(
+                                            EVEL_DISK_COLLECTOR * collector,
+                                            const char * name,
+                                            size_t name_len,
+                                            int hint)
+{
+  EVEL_DISK_USAGE * new_disks;
+  EVEL_DISK_USAGE * disk;
+  int i;
+
+  for (i = 0; i < collector->num_disks; i++)
+  {
+    disk = &collector->disks[(hint + i) % collector->num_disks];
+    if (strncmp(disk->counters.name, name, name_len) == 0 &&
+        disk->counters.name[name_len] == '\0')
+    {
+      return disk;
+    }
+  }
+
+  if (collector->num_disks == collector->max_disks)
+  {
+    new_disks = realloc(collector->disks,
+                        2 * collector->max_disks * sizeof(EVEL_DISK_USAGE));
+    if (new_disks == NULL)
+    {
+      log_error_state("Failed to grow disk collector");
+      return NULL;
+    }
+    collector->disks = new_disks;
+    collector->max_disks *= 2;
+  }
+
+  disk = &collector->disks[collector->num_disks++];
+  memset(disk, 0, sizeof(EVEL_DISK_USAGE));
+  disk->present = -1;
+  return disk;
+}
+
+/**************************************************************************//**
+ * Add the rates since a device's last sample to its summaries, and keep the
+ * new counters.
+ *
+ * @param disk      The device.
+ * @param counters  The new counters.
+ * @param elapsed   Seconds since the last sample.
+ *****************************************************************************/
+static void evel_disk_usage_sample(EVEL_DISK_USAGE * disk,
+                                   const EVEL_DISK_STATS * counters,
+                                   double elapsed)
+{
+  const EVEL_DISK_STATS * last = &disk->counters;
+  EVEL_DISK_SUMMARY * s = disk->summaries;
+  unsigned long long reads;
+  unsigned long long writes;
+
+  if (elapsed > 0.0)
+  {
+    reads = evel_disk_delta(counters->reads, last->reads);
+    writes = evel_disk_delta(counters->writes, last->writes);
+
+    evel_disk_summary_add(&s[EVEL_DISK_OCTETS_READ],
+      (double) evel_disk_delta(counters->sectors_read, last->sectors_read) *
+      EVEL_DISK_SECTOR_SIZE / elapsed);
+    evel_disk_summary_add(&s[EVEL_DISK_OCTETS_WRITE],
+      (double) evel_disk_delta(counters->sectors_written,
+                               last->sectors_written) *
+      EVEL_DISK_SECTOR_SIZE / elapsed);
+    evel_disk_summary_add(&s[EVEL_DISK_OPS_READ], reads / elapsed);
+    evel_disk_summary_add(&s[EVEL_DISK_OPS_WRITE], writes / elapsed);
+    evel_disk_summary_add(&s[EVEL_DISK_MERGE_READ],
+      evel_disk_delta(counters->reads_merged, last->reads_merged) / elapsed);
+    evel_disk_summary_add(&s[EVEL_DISK_MERGE_WRITE],
+      evel_disk_delta(counters->writes_merged, last->writes_merged) /
+      elapsed);
+    evel_disk_summary_add(&s[EVEL_DISK_TIME_READ], (reads == 0) ? 0.0 :
+      (double) evel_disk_delta(counters->read_ms, last->read_ms) / reads);
+    evel_disk_summary_add(&s[EVEL_DISK_TIME_WRITE], (writes == 0) ? 0.0 :
+      (double) evel_disk_delta(counters->write_ms, last->write_ms) / writes);
+    evel_disk_summary_add(&s[EVEL_DISK_IO_TIME],
+      evel_disk_delta(counters->io_ms, last->io_ms) / elapsed);
+    evel_disk_summary_add(&s[EVEL_DISK_PENDING_OPS],
+      (double) counters->in_progress);
+  }
+
+  disk->counters = *counters;
+}
+
+/**************************************************************************//**
+ * Add a sample to a summary.
+ *
+ * @param summary   The summary.
+ * @param value     The sample.
+ *****************************************************************************/
+static void evel_disk_summary_add(EVEL_DISK_SUMMARY * summary,
+                                  double value)
+{
+  if (summary->count == 0 || value < summary->min)
+  {
+    summary->min = value;
+  }
+  if (summary->count == 0 || value > summary->max)
+  {
+    summary->max = value;
+  }
+  summary->sum += value;
+  summary->last = value;
+  summary->count++;
+}
+
+/**************************************************************************//**
+ * Get the average of a summary.
+ *
+ * @param summary   The summary.
+ *
+ * @returns The average, or 0 if there are no samples.
+ *****************************************************************************/
+static double evel_disk_average(const EVEL_DISK_SUMMARY * summary)
+{
+  return (summary->count == 0) ? 0.0 : summary->sum / summary->count;
+}
+
+/**************************************************************************//**
+ * Work out the increase in a counter between two samples.
+ *
+ * The counters are unsigned long in the kernel, so wrap at 32 bits on
+ * 32-bit systems; a device being removed and re-added resets them.
+ *
+ * @param current   The later sample.
+ * @param previous  The earlier sample.
+ *
+ * @returns The increase.
+ *****************************************************************************/
+static unsigned long long evel_disk_delta(unsigned long long current,
+                                          unsigned long long previous)
+{
+  return evel_counter_delta(previous, current, EVEL_COUNTER_AUTO, NULL);
+}
@@ -26,34 +26,12 @@
 #include <string.h>
 #include <assert.h>
 #include <stdlib.h>
-#include <sys/time.h>
 
 #include "evel.h"
 #include "evel_internal.h"
 #include "evel_throttle.h"
 #include "metadata.h"
 
-/**************************************************************************//**
- * Unique sequence number for events from this VNF.
- *****************************************************************************/
-static int event_sequence = 1;
-
-/**************************************************************************//**
- * Set the next event_sequence to use.
- *
- * @param sequence      The next sequence number to use.
- *****************************************************************************/
-void evel_set_global_event_sequence(const int sequence)
-{
-  EVEL_ENTER();
-
-  EVEL_INFO("Setting event sequence to %d, was %d ", sequence, event_sequence);
-  event_sequence = sequence;
-
-  EVEL_EXIT();
-}
-
-
 /**************************************************************************//**
  * Create a new heartbeat event of given name and type.
  *
@@ -143,14 +121,14 @@ exit_label:
  *****************************************************************************/
 void evel_init_header(EVENT_HEADER * const header,const char *const eventname)
 {
-  char scratchpad[EVEL_MAX_STRING_LEN + 1] = {0};
-  struct timeval tv;
+  char scratchpad[EVEL_ID_MAX_LEN + 1];
+  unsigned long long now;
 
   EVEL_ENTER();
 
   assert(header != NULL);
 
-  gettimeofday(&tv, NULL);
+  now = evel_time_header_usec();
 
   /***************************************************************************/
   /* Initialize the header.  Get a new event sequence number.  Note that if  */
@@ -158,13 +136,17 @@ void evel_init_header(EVENT_HEADER * const header,const char *const eventname)
   /* everything downstream can cope with NULLs.                              */
   /***************************************************************************/
   header->event_domain = EVEL_DOMAIN_HEARTBEAT;
-  snprintf(scratchpad, EVEL_MAX_STRING_LEN, "%d", event_sequence);
+  evel_format_event_id(scratchpad,
+                       sizeof(scratchpad),
+                       "",
+                       evel_next_event_sequence(),
+                       1);
   header->event_id = strdup(scratchpad);
   if( eventname == NULL )
      header->event_name = strdup(functional_role);
   else
      header->event_name = strdup(eventname);
-  header->last_epoch_microsec = tv.tv_usec + 1000000 * tv.tv_sec;
+  header->last_epoch_microsec = now;
   header->priority = EVEL_PRIORITY_NORMAL;
   header->reporting_entity_name = strdup(openstack_vm_name());
   header->source_name = strdup(openstack_vm_name());
@@ -172,7 +154,6 @@ void evel_init_header(EVENT_HEADER * const header,const char *const eventname)
   header->start_epoch_microsec = header->last_epoch_microsec;
   header->major_version = EVEL_HEADER_MAJOR_VERSION;
   header->minor_version = EVEL_HEADER_MINOR_VERSION;
-  event_sequence++;
 
   /***************************************************************************/
   /* Optional parameters.                                                    */
@@ -199,7 +180,7 @@ void evel_init_header(EVENT_HEADER * const header,const char *const eventname)
  *****************************************************************************/
 void evel_init_header_nameid(EVENT_HEADER * const header,const char *const eventname, const char *eventid)
 {
-  struct timeval tv;
+  unsigned long long now;
 
   EVEL_ENTER();
 
@@ -207,7 +188,7 @@ void evel_init_header_nameid(EVENT_HEADER * const header,const char *const event
   assert(eventname != NULL);
   assert(eventid != NULL);
 
-  gettimeofday(&tv, NULL);
+  now = evel_time_header_usec();
 
   /***************************************************************************/
   /* Initialize the header.  Reset event sequence number.  Note that if      */
@@ -217,7 +198,7 @@ void evel_init_header_nameid(EVENT_HEADER * const header,const char *const event
   header->event_domain = EVEL_DOMAIN_HEARTBEAT;
   header->event_id = strdup(eventid);
   header->event_name = strdup(eventname);
-  header->last_epoch_microsec = tv.tv_usec + 1000000 * tv.tv_sec;
+  header->last_epoch_microsec = now;
   header->priority = EVEL_PRIORITY_NORMAL;
   header->reporting_entity_name = strdup(openstack_vm_name());
   header->source_name = strdup(openstack_vm_name());
@@ -692,7 +673,15 @@ int evel_json_encode_event(char * json,
   evel_json_open_object(jbuf);
   evel_json_open_named_object(jbuf, "event");
 
+  /***************************************************************************/
+  /* Encode the event, leaving out what has not changed if the domain uses   */
+  /* delta reporting, and exposing its values to Prometheus.                 */
+  /***************************************************************************/
+  evel_json_delta_begin(jbuf, event);
+  evel_json_prometheus_begin(jbuf, event);
   evel_json_encode_eventtype(jbuf, event);
+  evel_json_prometheus_end(jbuf);
+  evel_json_delta_end(jbuf);
 
   evel_json_close_object(jbuf);
   evel_json_close_object(jbuf);
@@ -753,7 +742,11 @@ int evel_json_encode_batch_event(char * json,
      if(batch_field != NULL){
        EVEL_DEBUG("Batch Event %p %p added curr fsize %d offset %d depth %d check %d", batch_field_item->item, batch_field, tot_size,jbuf->offset,jbuf->depth,jbuf->checkpoint);
        evel_json_open_object(jbuf);
+       evel_json_delta_begin(jbuf, batch_field);
+       evel_json_prometheus_begin(jbuf, batch_field);
        evel_json_encode_eventtype(jbuf, batch_field);
+       evel_json_prometheus_end(jbuf);
+       evel_json_delta_end(jbuf);
        evel_json_close_object(jbuf);
 
        tot_size += jbuf->offset;
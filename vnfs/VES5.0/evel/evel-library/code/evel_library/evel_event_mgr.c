@@ -105,6 +105,15 @@ static pthread_t evt_handler_thread;
  *****************************************************************************/
 static EVT_HANDLER_STATE evt_handler_state = EVT_HANDLER_UNINITIALIZED;
 
+/**************************************************************************//**
+ * Counts of events queued and dropped, and of posts sent and failed, updated
+ * atomically since events are posted from any thread.
+ *****************************************************************************/
+static unsigned long long events_posted = 0;
+static unsigned long long events_dropped = 0;
+static unsigned long long posts_sent = 0;
+static unsigned long long posts_failed = 0;
+
 /**************************************************************************//**
  * The configured API URL for event and throttling.
  *****************************************************************************/
@@ -858,6 +867,11 @@ EVEL_ERR_CODES evel_post_event(EVENT_HEADER * event)
       log_error_state("Failed to write event to buffer - event dropped!");
       rc = EVEL_EVENT_BUFFER_FULL;
       evel_free_event(event);
+      __atomic_add_fetch(&events_dropped, 1, __ATOMIC_RELAXED);
+    }
+    else
+    {
+      __atomic_add_fetch(&events_posted, 1, __ATOMIC_RELAXED);
     }
   }
   else
@@ -868,12 +882,37 @@ EVEL_ERR_CODES evel_post_event(EVENT_HEADER * event)
     log_error_state("Event Handler system not active - event dropped!");
     rc = EVEL_EVENT_HANDLER_INACTIVE;
     evel_free_event(event);
+    __atomic_add_fetch(&events_dropped, 1, __ATOMIC_RELAXED);
   }
 
   EVEL_EXIT();
   return (rc);
 }
 
+/**************************************************************************//**
+ * Report the event handler's counters.
+ *
+ * @param[out] posted   Events queued for sending.
+ * @param[out] dropped  Events dropped because they could not be queued.
+ * @param[out] sent     Posts accepted by a collector.
+ * @param[out] failed   Posts which failed or a collector refused.
+ *****************************************************************************/
+void event_handler_stats(unsigned long long * const posted,
+                         unsigned long long * const dropped,
+                         unsigned long long * const sent,
+                         unsigned long long * const failed)
+{
+  assert(posted != NULL);
+  assert(dropped != NULL);
+  assert(sent != NULL);
+  assert(failed != NULL);
+
+  *posted = __atomic_load_n(&events_posted, __ATOMIC_RELAXED);
+  *dropped = __atomic_load_n(&events_dropped, __ATOMIC_RELAXED);
+  *sent = __atomic_load_n(&posts_sent, __ATOMIC_RELAXED);
+  *failed = __atomic_load_n(&posts_failed, __ATOMIC_RELAXED);
+}
+
 /**************************************************************************//**
  * Post an event to the Vendor Event Listener API.
  *
@@ -968,6 +1007,8 @@ static EVEL_ERR_CODES evel_post_api(char * msg, size_t size)
   EVEL_DEBUG("HTTP response code: %d", http_response_code);
   if ((http_response_code / 100) == 2)
   {
+    __atomic_add_fetch(&posts_sent, 1, __ATOMIC_RELAXED);
+
     /*************************************************************************/
     /* If the server responded with data it may be interesting but not a     */
     /* problem.                                                              */
@@ -1001,6 +1042,10 @@ static EVEL_ERR_CODES evel_post_api(char * msg, size_t size)
   }
 
 exit_label:
+  if ((rc != EVEL_SUCCESS) || ((http_response_code / 100) != 2))
+  {
+    __atomic_add_fetch(&posts_failed, 1, __ATOMIC_RELAXED);
+  }
   free(rx_chunk.memory);
   EVEL_EXIT();
   return(rc);
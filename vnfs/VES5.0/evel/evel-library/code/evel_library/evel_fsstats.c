@@ -0,0 +1,290 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Filesystem usage from statvfs() on each mounted block device.
+ *
+ * The mount table is read whole, without forking df; its lines are:
+ *
+ *   /dev/sda1 /var/log ext4 rw,relatime 0 0
+ *
+ * with spaces and other awkward characters in the paths escaped as octal,
+ * e.g. "\040".  Pseudo filesystems such as proc, sysfs and tmpfs have a
+ * source that is not a path, and are skipped.  A device mounted more than
+ * once, e.g. by bind mounts, is reported only at its first mount point.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Initial space to read the mount table into, grown as needed.              */
+/*****************************************************************************/
+#define EVEL_FS_INITIAL_BUFFER 4096
+
+/*****************************************************************************/
+/* Bytes per gigabyte, as the VES schema counts storage.                     */
+/*****************************************************************************/
+#define EVEL_FS_GIGABYTE 1000000000.0
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static char * evel_fs_read_mounts(const char * path);
+static size_t evel_fs_unescape(const char * field, char * out, size_t size);
+static int evel_fs_source_seen(const char * buffer,
+                               const char * line,
+                               size_t source_len);
+
+/**************************************************************************//**
+ * Add a Filesystem Use to a Measurement for each mounted filesystem backed
+ * by a block device, with its configured and used space in gigabytes.
+ *
+ * @param measurement   Pointer to the Measurement.
+ * @param path          Mount table to read, or NULL for
+ *                      ::EVEL_FS_PROC_MOUNTS.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_fsstats_measurement_add(
+                                       EVENT_MEASUREMENT * const measurement,
+                                       const char * const path)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  const char * file = (path != NULL) ? path : EVEL_FS_PROC_MOUNTS;
+  struct statvfs fs;
+  char mount_point[PATH_MAX];
+  char * buffer;
+  const char * line;
+  const char * next;
+  size_t source_len;
+  double configured;
+  double used;
+
+  EVEL_ENTER();
+
+  assert(measurement != NULL);
+
+  buffer = evel_fs_read_mounts(file);
+  if (buffer == NULL)
+  {
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  for (line = buffer; *line != '\0'; line = next)
+  {
+    next = strchr(line, '\n');
+    next = (next != NULL) ? next + 1 : line + strlen(line);
+
+    /*************************************************************************/
+    /* Only sources which are paths are block devices.  The table is left    */
+    /* as read, so earlier sources can be compared in their escaped form.    */
+    /*************************************************************************/
+    if (line[0] != '/')
+    {
+      continue;
+    }
+    source_len = strcspn(line, " \n");
+    if (line[source_len] != ' ' ||
+        evel_fs_source_seen(buffer, line, source_len))
+    {
+      continue;
+    }
+    if (evel_fs_unescape(line + source_len + 1,
+                         mount_point,
+                         sizeof(mount_point)) == 0)
+    {
+      continue;
+    }
+
+    if (statvfs(mount_point, &fs) != 0)
+    {
+      EVEL_DEBUG("Failed to statvfs %s: %s", mount_point, strerror(errno));
+      continue;
+    }
+    if (fs.f_blocks == 0)
+    {
+      continue;
+    }
+
+    configured = (double) fs.f_blocks * fs.f_frsize / EVEL_FS_GIGABYTE;
+    used = (double) (fs.f_blocks - fs.f_bfree) * fs.f_frsize /
+                                                            EVEL_FS_GIGABYTE;
+    evel_measurement_fsys_use_add(measurement,
+                                  mount_point,
+                                  configured,
+                                  used,
+                                  0, 0, 0, 0);
+  }
+
+  free(buffer);
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Read the mount table.
+ *
+ * @param path      File to read.
+ *
+ * @returns The NUL-terminated contents, which the caller must free, or NULL
+ *          on failure.
+ *****************************************************************************/
+static char * evel_fs_read_mounts(const char * path)
+{
+  char * buffer = NULL;
+  char * new_buffer;
+  size_t buffer_size = EVEL_FS_INITIAL_BUFFER;
+  size_t length = 0;
+  ssize_t bytes;
+  int fd;
+
+  fd = open(path, O_RDONLY);
+  if (fd < 0)
+  {
+    log_error_state("Failed to open %s: %s", path, strerror(errno));
+    goto exit_label;
+  }
+
+  buffer = malloc(buffer_size);
+  while (buffer != NULL)
+  {
+    if (length + 1 >= buffer_size)
+    {
+      new_buffer = realloc(buffer, buffer_size * 2);
+      if (new_buffer == NULL)
+      {
+        log_error_state("Failed to grow buffer for %s", path);
+        free(buffer);
+        buffer = NULL;
+        break;
+      }
+      buffer = new_buffer;
+      buffer_size *= 2;
+    }
+
+    bytes = read(fd, buffer + length, buffer_size - length - 1);
+    if (bytes < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (bytes < 0)
+    {
+      log_error_state("Failed to read %s: %s", path, strerror(errno));
+      free(buffer);
+      buffer = NULL;
+      break;
+    }
+    if (bytes == 0)
+    {
+      buffer[length] = '\0';
+      break;
+    }
+    length += bytes;
+  }
+  close(fd);
+
+exit_label:
+  return buffer;
+}
+
+/**************************************************************************//**
+ * Copy a field from the mount table, undoing its octal escapes.
+ *
+ * @param field     Start of the field, ended by a space or newline.
+ * @param out       Where to put the field, NUL-terminated.
+ * @param size      Size of @p out.
+ *
+ * @returns Length of the field, or 0 if it is empty or does not fit.
+ *****************************************************************************/
+static size_t evel_fs_unescape(const char * field, char * out, size_t size)
+{
+  size_t length = 0;
+
+  while (*field != '\0' && *field != ' ' && *field != '\n')
+  {
+    if (length + 1 >= size)
+    {
+      return 0;
+    }
+    if (field[0] == '\\' &&
+        field[1] >= '0' && field[1] <= '3' &&
+        field[2] >= '0' && field[2] <= '7' &&
+        field[3] >= '0' && field[3] <= '7')
+    {
+      out[length++] = (char) (((field[1] - '0') << 6) |
+                              ((field[2] - '0') << 3) |
+                               (field[3] - '0'));
+      field += 4;
+    }
+    else
+    {
+      out[length++] = *field++;
+    }
+  }
+
+  out[length] = '\0';
+  return length;
+}
+
+/**************************************************************************//**
+ * Check whether a line's source is also the source of an earlier line.
+ *
+ * @param buffer      Start of the mount table.
+ * @param line        The line, starting with its source.
+ * @param source_len  Length of the source.
+ *
+ * @returns Non-zero if the source is a duplicate.
+ *****************************************************************************/
+static int evel_fs_source_seen(const char * buffer,
+                               const char * line,
+                               size_t source_len)
+{
+  const char * earlier;
+
+  for (earlier = buffer; earlier < line; )
+  {
+    if (strncmp(earlier, line, source_len) == 0 &&
+        earlier[source_len] == ' ')
+    {
+      return 1;
+    }
+    earlier = strchr(earlier, '\n');
+    if (earlier == NULL)
+    {
+      break;
+    }
+    earlier++;
+  }
+
+  return 0;
+}
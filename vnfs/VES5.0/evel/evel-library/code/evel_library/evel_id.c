@@ -0,0 +1,250 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Event sequence and Event ID generation.
+ *
+ * The global event sequence is a single 64-bit counter updated with atomic
+ * operations.  To keep threads which create many events from contending on
+ * its cache line, each thread reserves a block of ::EVEL_ID_BLOCK_SIZE
+ * sequence numbers at a time and hands them out locally.  Sequence numbers
+ * are therefore unique across the process and monotonic within a thread,
+ * but numbers reserved by a thread which exits before using them are
+ * never issued.
+ *
+ * Event IDs are rendered as a prefix followed by a fixed-width, zero-padded
+ * decimal number without going through the printf family.
+ *****************************************************************************/
+
+#include <string.h>
+#include <assert.h>
+
+#include "evel.h"
+#include "evel_internal.h"
+
+/**************************************************************************//**
+ * Next unreserved global event sequence number.
+ *****************************************************************************/
+static unsigned long long evel_sequence_next = 1;
+
+/**************************************************************************//**
+ * Generation of the global sequence, bumped each time it is reset so that
+ * threads discard any block reserved before the reset.
+ *****************************************************************************/
+static unsigned int evel_sequence_generation = 0;
+
+/**************************************************************************//**
+ * Per-thread block of reserved sequence numbers: [block_next, block_end).
+ *****************************************************************************/
+static __thread unsigned long long block_next = 0;
+static __thread unsigned long long block_end = 0;
+static __thread unsigned int block_generation = 0;
+
+/**************************************************************************//**
+ * Set the next event sequence to be handed out.
+ *
+ * Blocks already reserved by other threads are abandoned the next time those
+ * threads ask for a sequence number.
+ *
+ * @param sequence      The next sequence number to use.
+ *****************************************************************************/
+void evel_set_global_event_sequence(const int sequence)
+{
+  EVEL_ENTER();
+
+  EVEL_INFO("Setting event sequence to %d, was %llu ",
+            sequence,
+            __atomic_load_n(&evel_sequence_next, __ATOMIC_RELAXED));
+  __atomic_store_n(&evel_sequence_next,
+                   (unsigned long long) sequence,
+                   __ATOMIC_RELAXED);
+  __atomic_add_fetch(&evel_sequence_generation, 1, __ATOMIC_RELEASE);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get the next event sequence number.
+ *
+ * Lock-free: the common case touches only thread-local state, and one
+ * atomic add is made every ::EVEL_ID_BLOCK_SIZE calls.
+ *
+ * @returns The sequence number, unique within this process.
+ *****************************************************************************/
+unsigned long long evel_next_event_sequence(void)
+{
+  unsigned int generation;
+
+  generation = __atomic_load_n(&evel_sequence_generation, __ATOMIC_ACQUIRE);
+  if (block_next >= block_end || block_generation != generation)
+  {
+    block_next = __atomic_fetch_add(&evel_sequence_next,
+                                    EVEL_ID_BLOCK_SIZE,
+                                    __ATOMIC_RELAXED);
+    block_end = block_next + EVEL_ID_BLOCK_SIZE;
+    block_generation = generation;
+  }
+
+  return block_next++;
+}
+
+/**************************************************************************//**
+ * Format an Event ID as a prefix followed by a zero-padded decimal number.
+ *
+ * The number is written right to left into a field of at least width
+ * digits, widening only if the value does not fit.
+ *
+ * @param buffer        Buffer to receive the null-terminated ID.
+ * @param size          Size of the buffer, including the terminator.
+ * @param prefix        ASCIIZ prefix, may be an empty string.
+ * @param prefix_len    Length of the prefix in bytes.
+ * @param value         The number to append.
+ * @param min_width     Minimum number of digits.
+ *
+ * @returns Length of the ID written, excluding the terminator.
+ * @retval  0  The buffer is too small to hold the ID.
+ *****************************************************************************/
+static size_t evel_format_id(char * const buffer,
+                             const size_t size,
+                             const char * const prefix,
+                             const size_t prefix_len,
+                             unsigned long long value,
+                             const size_t min_width)
+{
+  char digits[EVEL_ID_MAX_DIGITS];
+  size_t num_digits = 0;
+  size_t width;
+
+  do
+  {
+    digits[sizeof(digits) - 1 - num_digits] = '0' + (char) (value % 10);
+    value /= 10;
+    num_digits++;
+  } while (value != 0);
+
+  width = (num_digits > min_width) ? num_digits : min_width;
+  if (prefix_len + width + 1 > size)
+  {
+    return 0;
+  }
+
+  memcpy(buffer, prefix, prefix_len);
+  memset(buffer + prefix_len, '0', width - num_digits);
+  memcpy(buffer + prefix_len + width - num_digits,
+         digits + sizeof(digits) - num_digits,
+         num_digits);
+  buffer[prefix_len + width] = '\0';
+
+  return prefix_len + width;
+}
+
+/**************************************************************************//**
+ * Format an Event ID as a prefix followed by a zero-padded decimal number.
+ *
+ * Equivalent to sprintf(buffer, "%s%0*llu", prefix, width, value).
+ *
+ * @param buffer        Buffer to receive the null-terminated ID.
+ * @param size          Size of the buffer, including the terminator.
+ * @param prefix        ASCIIZ prefix, may be an empty string.
+ * @param value         The number to append.
+ * @param width         Minimum number of digits, e.g. ::EVEL_ID_DIGITS.
+ *
+ * @returns Length of the ID written, excluding the terminator.
+ * @retval  0  The buffer is too small to hold the ID.
+ *****************************************************************************/
+size_t evel_format_event_id(char * const buffer,
+                            const size_t size,
+                            const char * const prefix,
+                            const unsigned long long value,
+                            const size_t width)
+{
+  assert(buffer != NULL);
+  assert(prefix != NULL);
+
+  return evel_format_id(buffer, size, prefix, strlen(prefix), value, width);
+}
+
+/**************************************************************************//**
+ * Initialize an Event ID generator.
+ *
+ * @param generator     Pointer to the ::EVEL_ID_GENERATOR to initialize.
+ * @param prefix        ASCIIZ prefix for the generated IDs, truncated to
+ *                      ::EVEL_ID_MAX_PREFIX characters.
+ * @param first         The first number to be issued.
+ *****************************************************************************/
+void evel_id_generator_init(EVEL_ID_GENERATOR * const generator,
+                            const char * const prefix,
+                            const unsigned long long first)
+{
+  EVEL_ENTER();
+
+  assert(generator != NULL);
+  assert(prefix != NULL);
+
+  generator->prefix_len = strlen(prefix);
+  if (generator->prefix_len > EVEL_ID_MAX_PREFIX)
+  {
+    generator->prefix_len = EVEL_ID_MAX_PREFIX;
+  }
+  memcpy(generator->prefix, prefix, generator->prefix_len);
+  generator->prefix[generator->prefix_len] = '\0';
+  __atomic_store_n(&generator->next, first, __ATOMIC_RELAXED);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Generate the next Event ID from a generator.
+ *
+ * Safe to call concurrently from any number of threads sharing the
+ * generator: each call claims its number with a single atomic add.
+ *
+ * @param generator     Pointer to the ::EVEL_ID_GENERATOR.
+ * @param buffer        Buffer to receive the null-terminated ID.  A buffer
+ *                      of ::EVEL_ID_MAX_LEN + 1 bytes is always large enough.
+ * @param size          Size of the buffer, including the terminator.
+ *
+ * @returns The number embedded in the ID.
+ *****************************************************************************/
+unsigned long long evel_id_generator_next(EVEL_ID_GENERATOR * const generator,
+                                          char * const buffer,
+                                          const size_t size)
+{
+  unsigned long long value;
+
+  assert(generator != NULL);
+  assert(buffer != NULL);
+
+  value = __atomic_fetch_add(&generator->next, 1, __ATOMIC_RELAXED);
+  if (evel_format_id(buffer,
+                     size,
+                     generator->prefix,
+                     generator->prefix_len,
+                     value,
+                     EVEL_ID_DIGITS) == 0)
+  {
+    EVEL_ERROR("Event ID buffer of %zu bytes too small", size);
+    if (size > 0)
+    {
+      buffer[0] = '\0';
+    }
+  }
+
+  return value;
+}
@@ -0,0 +1,828 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Network interface counters.
+ *
+ * Reads the counters for every interface in one pass, into an
+ * ::EVEL_IF_SNAPSHOT which is reused between reads so that the steady state
+ * does no allocation.
+ *
+ * /proc/net/dev looks like this:
+ *
+ *   Inter-|   Receive                            ...|  Transmit
+ *    face |bytes    packets errs drop fifo frame ...|bytes    packets ...
+ *       lo: 2776770   11307    0    0    0     0 ...   2776770   11307 ...
+ *
+ * with eight receive and eight transmit counters per interface.
+ *
+ * The same counters, and more, are available as 64-bit values from a
+ * netlink RTM_GETLINK dump, which is what evel_ifstats_read_netlink() uses.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_link.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Initial sizes, grown as needed.                                           */
+/*****************************************************************************/
+#define EVEL_IF_INITIAL_INTERFACES 16
+#define EVEL_IF_INITIAL_BUFFER 8192
+#define EVEL_IF_HASH_SIZE 256
+
+/*****************************************************************************/
+/* Receive buffer for netlink dumps.  The kernel sends at most 32KB in each  */
+/* datagram, so one buffer of this size can take any of them.               */
+/*****************************************************************************/
+#define EVEL_IF_NETLINK_BUFFER 65536
+
+/*****************************************************************************/
+/* Number of counters on each line of /proc/net/dev.                         */
+/*****************************************************************************/
+#define EVEL_IF_PROC_COUNTERS 16
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static EVEL_IF_STATS * evel_if_snapshot_entry(EVEL_IF_SNAPSHOT * snapshot,
+                                              const char * name,
+                                              size_t name_len);
+static EVEL_ERR_CODES evel_if_read_file(EVEL_IF_SNAPSHOT * snapshot,
+                                        const char * path,
+                                        size_t * length);
+static const char * evel_if_parse_counter(const char * pos,
+                                          unsigned long long * value);
+static EVEL_ERR_CODES evel_if_netlink_link(EVEL_IF_SNAPSHOT * snapshot,
+                                           const struct nlmsghdr * header);
+static void evel_if_snapshot_begin(EVEL_IF_SNAPSHOT * snapshot);
+static double evel_if_delta(unsigned long long current,
+                            unsigned long long previous);
+
+/**************************************************************************//**
+ * Initialize an empty interface snapshot.
+ *
+ * @param snapshot  The snapshot to initialize.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_OUT_OF_MEMORY On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_if_snapshot_init(EVEL_IF_SNAPSHOT * const snapshot)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+
+  EVEL_ENTER();
+
+  assert(snapshot != NULL);
+
+  memset(snapshot, 0, sizeof(EVEL_IF_SNAPSHOT));
+  snapshot->interfaces = malloc(EVEL_IF_INITIAL_INTERFACES *
+                                sizeof(EVEL_IF_STATS *));
+  snapshot->index = ht_create(EVEL_IF_HASH_SIZE);
+  snapshot->buffer = malloc(EVEL_IF_INITIAL_BUFFER);
+  if (snapshot->interfaces == NULL ||
+      snapshot->index == NULL ||
+      snapshot->buffer == NULL)
+  {
+    log_error_state("Failed to allocate interface snapshot");
+    evel_if_snapshot_free(snapshot);
+    rc = EVEL_OUT_OF_MEMORY;
+    goto exit_label;
+  }
+  snapshot->max_interfaces = EVEL_IF_INITIAL_INTERFACES;
+  snapshot->buffer_size = EVEL_IF_INITIAL_BUFFER;
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Free the memory held by an interface snapshot.
+ *
+ * The ::EVEL_IF_STATS themselves are owned by the index, so are freed with
+ * it.
+ *
+ * @param snapshot  The snapshot to free.
+ *****************************************************************************/
+void evel_if_snapshot_free(EVEL_IF_SNAPSHOT * const snapshot)
+{
+  EVEL_ENTER();
+
+  assert(snapshot != NULL);
+
+  ht_destroy(snapshot->index);
+  free(snapshot->interfaces);
+  free(snapshot->buffer);
+  memset(snapshot, 0, sizeof(EVEL_IF_SNAPSHOT));
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Look up an interface in a snapshot.
+ *
+ * @param snapshot  The snapshot.
+ * @param name      The interface name.
+ *
+ * @returns The interface's counters, or NULL if it was not present at the
+ *          last read.
+ *****************************************************************************/
+const EVEL_IF_STATS * evel_if_snapshot_get(
+                                       const EVEL_IF_SNAPSHOT * const snapshot,
+                                       const char * const name)
+{
+  EVEL_IF_STATS * stats;
+
+  assert(snapshot != NULL);
+  assert(name != NULL);
+
+  stats = ht_get(snapshot->index, (char *) name);
+  if (stats == NULL || !stats->present)
+  {
+    return NULL;
+  }
+  return stats;
+}
+
+/**************************************************************************//**
+ * Read the counters for every interface from /proc/net/dev.
+ *
+ * The file is read with a single system call where possible, so all of the
+ * counters are from the same instant.
+ *
+ * @param snapshot  The snapshot to update.
+ * @param path      File to read, or NULL for ::EVEL_IF_PROC_NET_DEV.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_ifstats_read_procfs(EVEL_IF_SNAPSHOT * const snapshot,
+                                        const char * const path)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  EVEL_IF_STATS * stats;
+  unsigned long long counters[EVEL_IF_PROC_COUNTERS];
+  const char * file = (path != NULL) ? path : EVEL_IF_PROC_NET_DEV;
+  const char * line;
+  const char * name;
+  const char * colon;
+  const char * pos;
+  size_t length = 0;
+  int i;
+
+  EVEL_ENTER();
+
+  assert(snapshot != NULL);
+  assert(snapshot->index != NULL);
+
+  rc = evel_if_read_file(snapshot, file, &length);
+  if (rc != EVEL_SUCCESS)
+  {
+    goto exit_label;
+  }
+  evel_if_snapshot_begin(snapshot);
+
+  /***************************************************************************/
+  /* Interface lines are the ones with a colon; the two header lines have    */
+  /* none.                                                                   */
+  /***************************************************************************/
+  for (line = snapshot->buffer; line != NULL && *line != '\0'; )
+  {
+    colon = strchr(line, ':');
+    pos = strchr(line, '\n');
+    if (colon == NULL || (pos != NULL && colon > pos))
+    {
+      line = (pos != NULL) ? pos + 1 : NULL;
+      continue;
+    }
+
+    name = line;
+    while (*name == ' ')
+    {
+      name++;
+    }
+
+    pos = colon + 1;
+    for (i = 0; i < EVEL_IF_PROC_COUNTERS && pos != NULL; i++)
+    {
+      pos = evel_if_parse_counter(pos, &counters[i]);
+    }
+    if (pos == NULL || colon - name > EVEL_IF_NAME_MAX)
+    {
+      EVEL_ERROR("Skipping malformed interface line in %s", file);
+    }
+    else
+    {
+      stats = evel_if_snapshot_entry(snapshot, name, colon - name);
+      if (stats == NULL)
+      {
+        rc = EVEL_OUT_OF_MEMORY;
+        goto exit_label;
+      }
+      stats->present = 1;
+      stats->rx_bytes = counters[0];
+      stats->rx_packets = counters[1];
+      stats->rx_errors = counters[2];
+      stats->rx_dropped = counters[3];
+      stats->rx_fifo_errors = counters[4];
+      stats->rx_frame_errors = counters[5];
+      stats->rx_compressed = counters[6];
+      stats->rx_multicast = counters[7];
+      stats->tx_bytes = counters[8];
+      stats->tx_packets = counters[9];
+      stats->tx_errors = counters[10];
+      stats->tx_dropped = counters[11];
+      stats->tx_fifo_errors = counters[12];
+      stats->tx_collisions = counters[13];
+      stats->tx_carrier_errors = counters[14];
+      stats->tx_compressed = counters[15];
+    }
+
+    line = strchr(colon, '\n');
+    if (line != NULL)
+    {
+      line++;
+    }
+  }
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Read the counters for every interface with a single netlink dump.
+ *
+ * Uses RTM_GETLINK and the 64-bit IFLA_STATS64 counters, so it needs no
+ * privileges, no text parsing, and one round trip however many interfaces
+ * there are.
+ *
+ * @param snapshot  The snapshot to update.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_ifstats_read_netlink(EVEL_IF_SNAPSHOT * const snapshot)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  struct {
+    struct nlmsghdr header;
+    struct ifinfomsg info;
+  } request;
+  struct sockaddr_nl kernel;
+  struct iovec iov;
+  struct msghdr msg;
+  struct nlmsghdr * header;
+  struct nlmsgerr * error;
+  char * new_buffer;
+  ssize_t bytes;
+  unsigned int sequence;
+  int done = 0;
+  int fd;
+
+  EVEL_ENTER();
+
+  assert(snapshot != NULL);
+  assert(snapshot->index != NULL);
+
+  if (snapshot->buffer_size < EVEL_IF_NETLINK_BUFFER)
+  {
+    new_buffer = realloc(snapshot->buffer, EVEL_IF_NETLINK_BUFFER);
+    if (new_buffer == NULL)
+    {
+      log_error_state("Failed to grow buffer for netlink");
+      rc = EVEL_OUT_OF_MEMORY;
+      goto exit_label;
+    }
+    snapshot->buffer = new_buffer;
+    snapshot->buffer_size = EVEL_IF_NETLINK_BUFFER;
+  }
+
+  fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+  if (fd < 0)
+  {
+    log_error_state("Failed to open netlink socket: %s", strerror(errno));
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Ask for every link.                                                     */
+  /***************************************************************************/
+  sequence = (unsigned int) evel_time_monotonic_usec();
+  memset(&request, 0, sizeof(request));
+  request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+  request.header.nlmsg_type = RTM_GETLINK;
+  request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+  request.header.nlmsg_seq = sequence;
+  request.info.ifi_family = AF_UNSPEC;
+
+  memset(&kernel, 0, sizeof(kernel));
+  kernel.nl_family = AF_NETLINK;
+
+  if (sendto(fd, &request, request.header.nlmsg_len, 0,
+             (struct sockaddr *) &kernel, sizeof(kernel)) < 0)
+  {
+    log_error_state("Failed to send netlink request: %s", strerror(errno));
+    rc = EVEL_ERR_GEN_FAIL;
+    goto close_label;
+  }
+
+  evel_if_snapshot_begin(snapshot);
+
+  /***************************************************************************/
+  /* The reply arrives in as many datagrams as it takes, ending with         */
+  /* NLMSG_DONE.                                                             */
+  /***************************************************************************/
+  while (!done)
+  {
+    iov.iov_base = snapshot->buffer;
+    iov.iov_len = snapshot->buffer_size;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = &kernel;
+    msg.msg_namelen = sizeof(kernel);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    bytes = recvmsg(fd, &msg, 0);
+    if (bytes < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (bytes < 0)
+    {
+      log_error_state("Failed to read netlink reply: %s", strerror(errno));
+      rc = EVEL_ERR_GEN_FAIL;
+      goto close_label;
+    }
+    if (msg.msg_flags & MSG_TRUNC)
+    {
+      log_error_state("Netlink reply truncated");
+      rc = EVEL_ERR_GEN_FAIL;
+      goto close_label;
+    }
+
+    for (header = (struct nlmsghdr *) snapshot->buffer;
+         NLMSG_OK(header, (unsigned int) bytes);
+         header = NLMSG_NEXT(header, bytes))
+    {
+      if (header->nlmsg_seq != sequence)
+      {
+        continue;
+      }
+
+      if (header->nlmsg_type == NLMSG_DONE)
+      {
+        done = 1;
+        break;
+      }
+      else if (header->nlmsg_type == NLMSG_ERROR)
+      {
+        error = NLMSG_DATA(header);
+        log_error_state("Netlink link dump failed: %s",
+                        strerror(-error->error));
+        rc = EVEL_ERR_GEN_FAIL;
+        goto close_label;
+      }
+      else if (header->nlmsg_type == RTM_NEWLINK)
+      {
+        rc = evel_if_netlink_link(snapshot, header);
+        if (rc != EVEL_SUCCESS)
+        {
+          goto close_label;
+        }
+      }
+    }
+  }
+
+close_label:
+  close(fd);
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Record the counters from one RTM_NEWLINK message.
+ *
+ * Prefers IFLA_STATS64, falling back to the 32-bit IFLA_STATS on kernels
+ * which do not provide it.
+ *
+ * @param snapshot  The snapshot to update.
+ * @param header    The message.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success, including messages without counters.
+ * @retval  EVEL_OUT_OF_MEMORY If a new interface could not be added.
+ *****************************************************************************/
+static EVEL_ERR_CODES evel_if_netlink_link(EVEL_IF_SNAPSHOT * snapshot,
+                                           const struct nlmsghdr * header)
+{
+  struct ifinfomsg * info = NLMSG_DATA(header);
+  struct rtattr * attribute;
+  struct rtnl_link_stats64 stats64;
+  struct rtnl_link_stats stats32;
+  EVEL_IF_STATS * stats;
+  const char * name = NULL;
+  size_t name_len = 0;
+  int have_stats = 0;
+  int length;
+
+  length = IFLA_PAYLOAD(header);
+  for (attribute = IFLA_RTA(info);
+       RTA_OK(attribute, length);
+       attribute = RTA_NEXT(attribute, length))
+  {
+    switch (attribute->rta_type)
+    {
+    case IFLA_IFNAME:
+      name = RTA_DATA(attribute);
+      name_len = strnlen(name, RTA_PAYLOAD(attribute));
+      break;
+
+    case IFLA_STATS64:
+      /***********************************************************************/
+      /* Attributes are only 4-byte aligned, so copy the 64-bit counters.    */
+      /***********************************************************************/
+      memset(&stats64, 0, sizeof(stats64));
+      memcpy(&stats64,
+             RTA_DATA(attribute),
+             (RTA_PAYLOAD(attribute) < sizeof(stats64)) ?
+                                     RTA_PAYLOAD(attribute) : sizeof(stats64));
+      have_stats = 64;
+      break;
+
+    case IFLA_STATS:
+      if (have_stats == 0)
+      {
+        memset(&stats32, 0, sizeof(stats32));
+        memcpy(&stats32,
+               RTA_DATA(attribute),
+               (RTA_PAYLOAD(attribute) < sizeof(stats32)) ?
+                                     RTA_PAYLOAD(attribute) : sizeof(stats32));
+        have_stats = 32;
+      }
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  if (name == NULL || name_len == 0 || name_len > EVEL_IF_NAME_MAX ||
+      have_stats == 0)
+  {
+    EVEL_DEBUG("Skipping link %d without name or counters", info->ifi_index);
+    return EVEL_SUCCESS;
+  }
+
+  stats = evel_if_snapshot_entry(snapshot, name, name_len);
+  if (stats == NULL)
+  {
+    return EVEL_OUT_OF_MEMORY;
+  }
+
+  if (have_stats == 32)
+  {
+    stats64.rx_bytes = stats32.rx_bytes;
+    stats64.rx_packets = stats32.rx_packets;
+    stats64.rx_errors = stats32.rx_errors;
+    stats64.rx_dropped = stats32.rx_dropped;
+    stats64.rx_fifo_errors = stats32.rx_fifo_errors;
+    stats64.rx_frame_errors = stats32.rx_frame_errors;
+    stats64.rx_compressed = stats32.rx_compressed;
+    stats64.multicast = stats32.multicast;
+    stats64.tx_bytes = stats32.tx_bytes;
+    stats64.tx_packets = stats32.tx_packets;
+    stats64.tx_errors = stats32.tx_errors;
+    stats64.tx_dropped = stats32.tx_dropped;
+    stats64.tx_fifo_errors = stats32.tx_fifo_errors;
+    stats64.collisions = stats32.collisions;
+    stats64.tx_carrier_errors = stats32.tx_carrier_errors;
+    stats64.tx_compressed = stats32.tx_compressed;
+  }
+
+  stats->present = 1;
+  stats->rx_bytes = stats64.rx_bytes;
+  stats->rx_packets = stats64.rx_packets;
+  stats->rx_errors = stats64.rx_errors;
+  stats->rx_dropped = stats64.rx_dropped;
+  stats->rx_fifo_errors = stats64.rx_fifo_errors;
+  stats->rx_frame_errors = stats64.rx_frame_errors;
+  stats->rx_compressed = stats64.rx_compressed;
+  stats->rx_multicast = stats64.multicast;
+  stats->tx_bytes = stats64.tx_bytes;
+  stats->tx_packets = stats64.tx_packets;
+  stats->tx_errors = stats64.tx_errors;
+  stats->tx_dropped = stats64.tx_dropped;
+  stats->tx_fifo_errors = stats64.tx_fifo_errors;
+  stats->tx_collisions = stats64.collisions;
+  stats->tx_carrier_errors = stats64.tx_carrier_errors;
+  stats->tx_compressed = stats64.tx_compressed;
+
+  return EVEL_SUCCESS;
+}
+
+/**************************************************************************//**
+ * Set the vNIC performance counters from interface statistics.
+ *
+ * Every accumulated field the interface counters provide is set from
+ * @p current, and the matching delta from the change since @p previous.
+ * Broadcast counts are not available from the kernel, so are not set; the
+ * received unicast count is the received packets less multicast, and the
+ * kernel's multicast count is for received packets only.  Deltas allow
+ * for counters wrapping or being reset; see evel_counter_delta().
+ *
+ * @param vnic_performance  The vNIC performance to fill in.
+ * @param current           Counters at the end of the interval.
+ * @param previous          Counters at the start of the interval, or NULL
+ *                          to set only the accumulated fields.
+ *****************************************************************************/
+void evel_vnic_performance_if_stats_set(
+                          MEASUREMENT_VNIC_PERFORMANCE * const vnic_performance,
+                          const EVEL_IF_STATS * const current,
+                          const EVEL_IF_STATS * const previous)
+{
+  unsigned long long rx_ucast;
+  unsigned long long prev_rx_ucast;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(vnic_performance != NULL);
+  assert(current != NULL);
+
+  rx_ucast = (current->rx_packets > current->rx_multicast) ?
+                             current->rx_packets - current->rx_multicast : 0;
+
+  evel_vnic_performance_rx_octets_acc_set(vnic_performance,
+                                          current->rx_bytes);
+  evel_vnic_performance_rx_total_pkt_acc_set(vnic_performance,
+                                             current->rx_packets);
+  evel_vnic_performance_rx_ucast_pkt_acc_set(vnic_performance, rx_ucast);
+  evel_vnic_performance_rx_mcast_pkt_acc_set(vnic_performance,
+                                             current->rx_multicast);
+  evel_vnic_performance_rx_discard_pkt_acc_set(vnic_performance,
+                                               current->rx_dropped);
+  evel_vnic_performance_rx_error_pkt_acc_set(vnic_performance,
+                                             current->rx_errors);
+  evel_vnic_performance_tx_octets_acc_set(vnic_performance,
+                                          current->tx_bytes);
+  evel_vnic_performance_tx_total_pkt_acc_set(vnic_performance,
+                                             current->tx_packets);
+  evel_vnic_performance_tx_discarded_pkt_acc_set(vnic_performance,
+                                                 current->tx_dropped);
+  evel_vnic_performance_tx_error_pkt_acc_set(vnic_performance,
+                                             current->tx_errors);
+
+  if (previous != NULL)
+  {
+    prev_rx_ucast = (previous->rx_packets > previous->rx_multicast) ?
+                             previous->rx_packets - previous->rx_multicast : 0;
+
+    evel_vnic_performance_rx_octets_delta_set(vnic_performance,
+                     evel_if_delta(current->rx_bytes, previous->rx_bytes));
+    evel_vnic_performance_rx_total_pkt_delta_set(vnic_performance,
+                     evel_if_delta(current->rx_packets, previous->rx_packets));
+    evel_vnic_performance_rx_ucast_pkt_delta_set(vnic_performance,
+                     evel_if_delta(rx_ucast, prev_rx_ucast));
+    evel_vnic_performance_rx_mcast_pkt_delta_set(vnic_performance,
+                     evel_if_delta(current->rx_multicast,
+                                   previous->rx_multicast));
+    evel_vnic_performance_rx_discard_pkt_delta_set(vnic_performance,
+                     evel_if_delta(current->rx_dropped, previous->rx_dropped));
+    evel_vnic_performance_rx_error_pkt_delta_set(vnic_performance,
+                     evel_if_delta(current->rx_errors, previous->rx_errors));
+    evel_vnic_performance_tx_octets_delta_set(vnic_performance,
+                     evel_if_delta(current->tx_bytes, previous->tx_bytes));
+    evel_vnic_performance_tx_total_pkt_delta_set(vnic_performance,
+                     evel_if_delta(current->tx_packets, previous->tx_packets));
+    evel_vnic_performance_tx_discarded_pkt_delta_set(vnic_performance,
+                     evel_if_delta(current->tx_dropped, previous->tx_dropped));
+    evel_vnic_performance_tx_error_pkt_delta_set(vnic_performance,
+                     evel_if_delta(current->tx_errors, previous->tx_errors));
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Change in a counter over an interval.
+ *
+ * @returns The increase, allowing for the counter wrapping or being reset.
+ *****************************************************************************/
+static double evel_if_delta(unsigned long long current,
+                            unsigned long long previous)
+{
+  return (double) evel_counter_delta(previous,
+                                     current,
+                                     EVEL_COUNTER_AUTO,
+                                     NULL);
+}
+
+/**************************************************************************//**
+ * Start a new read: timestamp the snapshot and mark every interface absent
+ * until it is seen again.
+ *
+ * @param snapshot  The snapshot.
+ *****************************************************************************/
+static void evel_if_snapshot_begin(EVEL_IF_SNAPSHOT * snapshot)
+{
+  int i;
+
+  snapshot->timestamp = evel_time_monotonic_usec();
+  for (i = 0; i < snapshot->num_interfaces; i++)
+  {
+    snapshot->interfaces[i]->present = 0;
+  }
+}
+
+/**************************************************************************//**
+ * Read a whole file into the snapshot's buffer, growing it as needed.
+ *
+ * @param snapshot  The snapshot holding the buffer.
+ * @param path      The file to read.
+ * @param[out] length  Number of bytes read.  The buffer is NUL-terminated.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+static EVEL_ERR_CODES evel_if_read_file(EVEL_IF_SNAPSHOT * snapshot,
+                                        const char * path,
+                                        size_t * length)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  char * new_buffer;
+  ssize_t bytes;
+  int fd;
+
+  *length = 0;
+
+  fd = open(path, O_RDONLY);
+  if (fd < 0)
+  {
+    log_error_state("Failed to open %s: %s", path, strerror(errno));
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  for (;;)
+  {
+    if (*length + 1 >= snapshot->buffer_size)
+    {
+      new_buffer = realloc(snapshot->buffer, snapshot->buffer_size * 2);
+      if (new_buffer == NULL)
+      {
+        log_error_state("Failed to grow buffer for %s", path);
+        rc = EVEL_OUT_OF_MEMORY;
+        break;
+      }
+      snapshot->buffer = new_buffer;
+      snapshot->buffer_size *= 2;
+    }
+
+    bytes = read(fd,
+                 snapshot->buffer + *length,
+                 snapshot->buffer_size - *length - 1);
+    if (bytes < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (bytes < 0)
+    {
+      log_error_state("Failed to read %s: %s", path, strerror(errno));
+      rc = EVEL_ERR_GEN_FAIL;
+      break;
+    }
+    if (bytes == 0)
+    {
+      break;
+    }
+    *length += bytes;
+  }
+  snapshot->buffer[*length] = '\0';
+  close(fd);
+
+exit_label:
+  return rc;
+}
+
+/**************************************************************************//**
+ * Parse one decimal counter, skipping leading spaces.
+ *
+ * @param pos         Where to start.
+ * @param[out] value  The counter.
+ *
+ * @returns The position after the counter, or NULL if there is none.
+ *****************************************************************************/
+static const char * evel_if_parse_counter(const char * pos,
+                                          unsigned long long * value)
+{
+  unsigned long long result = 0;
+
+  while (*pos == ' ' || *pos == '\t')
+  {
+    pos++;
+  }
+  if (*pos < '0' || *pos > '9')
+  {
+    return NULL;
+  }
+  while (*pos >= '0' && *pos <= '9')
+  {
+    result = result * 10 + (*pos - '0');
+    pos++;
+  }
+
+  *value = result;
+  return pos;
+}
+
+/**************************************************************************//**
+ * Find an interface in the snapshot, adding it if it is new.
+ *
+ * @param snapshot  The snapshot.
+ * @param name      The interface name; need not be NUL-terminated.
+ * @param name_len  Length of @p name.
+ *
+ * @returns The interface's counters, or NULL on allocation failure.
+ *****************************************************************************/
+static EVEL_IF_STATS * evel_if_snapshot_entry(EVEL_IF_SNAPSHOT * snapshot,
+                                              const char * name,
+                                              size_t name_len)
+{
+  EVEL_IF_STATS * stats;
+  EVEL_IF_STATS ** new_interfaces;
+  char key[EVEL_IF_NAME_MAX + 1];
+
+  assert(name_len <= EVEL_IF_NAME_MAX);
+
+  memcpy(key, name, name_len);
+  key[name_len] = '\0';
+
+  stats = ht_get(snapshot->index, key);
+  if (stats != NULL)
+  {
+    return stats;
+  }
+
+  if (snapshot->num_interfaces == snapshot->max_interfaces)
+  {
+    new_interfaces = realloc(snapshot->interfaces,
+                             2 * snapshot->max_interfaces *
+                                                      sizeof(EVEL_IF_STATS *));
+    if (new_interfaces == NULL)
+    {
+      log_error_state("Failed to grow interface snapshot");
+      return NULL;
+    }
+    snapshot->interfaces = new_interfaces;
+    snapshot->max_interfaces *= 2;
+  }
+
+  stats = calloc(1, sizeof(EVEL_IF_STATS));
+  if (stats == NULL)
+  {
+    log_error_state("Failed to allocate interface counters");
+    return NULL;
+  }
+  strcpy(stats->name, key);
+  ht_set(snapshot->index, key, stats);
+  snapshot->interfaces[snapshot->num_interfaces++] = stats;
+
+  EVEL_DEBUG("New interface %s", key);
+  return stats;
+}
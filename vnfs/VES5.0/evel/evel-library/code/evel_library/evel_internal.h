@@ -241,6 +241,19 @@ EVEL_ERR_CODES event_handler_terminate();
  *****************************************************************************/
 EVEL_ERR_CODES event_handler_run();
 
+/**************************************************************************//**
+ * Report the event handler's counters.
+ *
+ * @param[out] posted   Events queued for sending.
+ * @param[out] dropped  Events dropped because they could not be queued.
+ * @param[out] sent     Posts accepted by a collector.
+ * @param[out] failed   Posts which failed or a collector refused.
+ *****************************************************************************/
+void event_handler_stats(unsigned long long * const posted,
+                         unsigned long long * const dropped,
+                         unsigned long long * const sent,
+                         unsigned long long * const failed);
+
 /**************************************************************************//**
  * Create a new internal event.
  *
@@ -266,6 +279,22 @@ EVENT_INTERNAL * evel_new_internal_event(EVT_HANDLER_COMMAND command,const char*
  *****************************************************************************/
 void evel_free_internal_event(EVENT_INTERNAL * event);
 
+/*****************************************************************************/
+/* Delta reporting state for a domain, space for the keys it remembers, and  */
+/* the separator between the parts of a key, which cannot appear in a name.  */
+/*****************************************************************************/
+typedef struct evel_delta EVEL_DELTA;
+#define EVEL_DELTA_KEY_LEN 256
+#define EVEL_DELTA_SEPARATOR "\x1f"
+
+/*****************************************************************************/
+/* The Prometheus endpoint's series, space for the labels of a series, and   */
+/* how deeply the objects whose fields are exposed can be nested.            */
+/*****************************************************************************/
+typedef struct evel_prometheus EVEL_PROMETHEUS;
+#define EVEL_PROMETHEUS_LABELS_LEN 256
+#define EVEL_PROMETHEUS_OBJECTS 2
+
 /*****************************************************************************/
 /* Structure to hold JSON buffer and associated tracking, as it is written.  */
 /*****************************************************************************/
@@ -290,8 +319,128 @@ typedef struct evel_json_buffer
   /***************************************************************************/
   int checkpoint;
 
+  /***************************************************************************/
+  /* The delta reporting state for the event being encoded, which can be     */
+  /* NULL, the event's name, and whether it is being sent in full.           */
+  /***************************************************************************/
+  EVEL_DELTA * delta;
+  const char * delta_event;
+  bool delta_refresh;
+
+  /***************************************************************************/
+  /* The identified object being encoded: its key, the offset and depth at   */
+  /* which it was opened (offset -1 when there is none), whether any of its  */
+  /* fields changed, and whether the last field encoded was unchanged.       */
+  /***************************************************************************/
+  char delta_object[EVEL_DELTA_KEY_LEN];
+  int delta_object_offset;
+  int delta_depth;
+  bool delta_changed;
+  bool delta_same;
+
+  /***************************************************************************/
+  /* The Prometheus series updated as the event is encoded, which can be     */
+  /* NULL, the event's labels, and the objects whose numeric fields are      */
+  /* exposed: the depth at which each was opened and its fields' labels.     */
+  /***************************************************************************/
+  EVEL_PROMETHEUS * prometheus;
+  char prometheus_event[EVEL_PROMETHEUS_LABELS_LEN];
+  int prometheus_objects;
+  int prometheus_depth[EVEL_PROMETHEUS_OBJECTS];
+  char prometheus_labels[EVEL_PROMETHEUS_OBJECTS][EVEL_PROMETHEUS_LABELS_LEN];
+
 } EVEL_JSON_BUFFER;
 
+/**************************************************************************//**
+ * Start encoding an event, applying the delta reporting state for its
+ * domain if there is one.  Must be paired with ::evel_json_delta_end.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param event         Pointer to the ::EVENT_HEADER about to be encoded.
+ *****************************************************************************/
+void evel_json_delta_begin(EVEL_JSON_BUFFER * jbuf,
+                           const EVENT_HEADER * const event);
+
+/**************************************************************************//**
+ * Finish encoding an event started with ::evel_json_delta_begin.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ *****************************************************************************/
+void evel_json_delta_end(EVEL_JSON_BUFFER * jbuf);
+
+/**************************************************************************//**
+ * Remember the text just encoded for a field of the current object.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param field         The field's key.
+ * @param text          The encoded text.
+ * @returns true if the text differs from what was last encoded for the
+ *          field, or the field has not been encoded before.
+ *****************************************************************************/
+bool evel_delta_changed(EVEL_JSON_BUFFER * jbuf,
+                        const char * const field,
+                        const char * const text);
+
+/**************************************************************************//**
+ * Clean up delta reporting.
+ *
+ * Called from ::evel_terminate.
+ *****************************************************************************/
+void evel_delta_terminate();
+
+/**************************************************************************//**
+ * Start encoding an event, updating the Prometheus endpoint's series with
+ * its fields if it is a measurement and the endpoint is running.  Must be
+ * paired with ::evel_json_prometheus_end.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param event         Pointer to the ::EVENT_HEADER about to be encoded.
+ *****************************************************************************/
+void evel_json_prometheus_begin(EVEL_JSON_BUFFER * jbuf,
+                                const EVENT_HEADER * const event);
+
+/**************************************************************************//**
+ * Finish encoding an event started with ::evel_json_prometheus_begin.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ *****************************************************************************/
+void evel_json_prometheus_end(EVEL_JSON_BUFFER * jbuf);
+
+/**************************************************************************//**
+ * Expose the numeric fields encoded directly within the object just opened,
+ * until it is closed.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param id            The object's identifier within its list, or NULL.
+ *****************************************************************************/
+void evel_json_expose_object(EVEL_JSON_BUFFER * jbuf,
+                             const char * const id);
+
+/**************************************************************************//**
+ * Expose a numeric field just encoded, if it is directly within the
+ * innermost exposed object.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param key           The field's key.
+ * @param value         The field's value.
+ *****************************************************************************/
+void evel_json_expose_field(EVEL_JSON_BUFFER * jbuf,
+                            const char * const key,
+                            const double value);
+
+/**************************************************************************//**
+ * Expose a custom measurement whose value is numeric.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param group         The measurement's group.
+ * @param name          The measurement's name.
+ * @param value         The measurement's value, as text.
+ *****************************************************************************/
+void evel_json_expose_custom(EVEL_JSON_BUFFER * jbuf,
+                             const char * const group,
+                             const char * const name,
+                             const char * const value);
+
 /**************************************************************************//**
  * Encode the event as a JSON event object according to AT&T's schema.
  *
@@ -627,6 +776,28 @@ void evel_json_checkpoint(EVEL_JSON_BUFFER * jbuf);
  *****************************************************************************/
 void evel_json_rewind(EVEL_JSON_BUFFER * jbuf);
 
+/**************************************************************************//**
+ * Add the opening bracket of an object identified within a list, whose
+ * unchanged fields are left out under delta reporting, and whose numeric
+ * fields are exposed by the Prometheus endpoint.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param list          The key of the list containing the object.
+ * @param id            The object's identifier within the list.
+ *****************************************************************************/
+void evel_json_open_delta_object(EVEL_JSON_BUFFER * jbuf,
+                                 const char * const list,
+                                 const char * const id);
+
+/**************************************************************************//**
+ * Add the closing bracket of an object opened with
+ * ::evel_json_open_delta_object, or drop the object if it is unchanged.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @returns true if the object was kept, false if it was dropped.
+ *****************************************************************************/
+bool evel_json_close_delta_object(EVEL_JSON_BUFFER * jbuf);
+
 /**************************************************************************//**
  * Free the underlying resources of an ::EVEL_OPTION_STRING.
  *
@@ -883,4 +1054,12 @@ void evel_set_option_intheader(EVEL_OPTION_INTHEADER_FIELDS * const option,
  *****************************************************************************/
 void evel_free_option_intheader(EVEL_OPTION_INTHEADER_FIELDS * const option);
 
+/**************************************************************************//**
+ * Get the current wall-clock time for a new event header, using the clock
+ * chosen with ::evel_header_clock_set.
+ *
+ * @returns Microseconds since the epoch.
+ *****************************************************************************/
+unsigned long long evel_time_header_usec(void);
+
 #endif
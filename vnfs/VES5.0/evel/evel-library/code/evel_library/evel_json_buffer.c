@@ -31,6 +31,9 @@
 /* Local prototypes.                                                         */
 /*****************************************************************************/
 static char * evel_json_kv_comma(EVEL_JSON_BUFFER * jbuf);
+static void evel_json_delta_field(EVEL_JSON_BUFFER * jbuf,
+                                  const char * const key,
+                                  const int start);
 
 /**************************************************************************//**
  * Initialize a ::EVEL_JSON_BUFFER.
@@ -55,6 +58,17 @@ void evel_json_buffer_init(EVEL_JSON_BUFFER * jbuf,
   jbuf->throttle_spec = throttle_spec;
   jbuf->depth = 0;
   jbuf->checkpoint = -1;
+  jbuf->delta = NULL;
+  jbuf->delta_event = NULL;
+  jbuf->delta_refresh = true;
+  jbuf->delta_object[0] = '\0';
+  jbuf->delta_object_offset = -1;
+  jbuf->delta_depth = 0;
+  jbuf->delta_changed = false;
+  jbuf->delta_same = false;
+  jbuf->prometheus = NULL;
+  jbuf->prometheus_event[0] = '\0';
+  jbuf->prometheus_objects = 0;
 
   EVEL_EXIT();
 }
@@ -95,6 +109,7 @@ bool evel_enc_kv_opt_string(EVEL_JSON_BUFFER * jbuf,
                             const EVEL_OPTION_STRING * const option)
 {
   bool added = false;
+  int start;
 
   EVEL_ENTER();
 
@@ -114,8 +129,21 @@ bool evel_enc_kv_opt_string(EVEL_JSON_BUFFER * jbuf,
     else
     {
       EVEL_DEBUG("Encoded: %s, %s", key, option->value);
+      start = jbuf->offset;
       evel_enc_kv_string(jbuf, key, option->value);
-      added = true;
+
+      /*********************************************************************/
+      /* Under delta reporting, leave out a value which has not changed.   */
+      /*********************************************************************/
+      if (jbuf->delta_same && !jbuf->delta_refresh)
+      {
+        EVEL_DEBUG("Unchanged: %s", key);
+        jbuf->offset = start;
+      }
+      else
+      {
+        added = true;
+      }
     }
   }
 
@@ -137,6 +165,7 @@ void evel_enc_kv_string(EVEL_JSON_BUFFER * jbuf,
 {
   int index;
   int length;
+  int start;
 
   EVEL_ENTER();
 
@@ -146,6 +175,7 @@ void evel_enc_kv_string(EVEL_JSON_BUFFER * jbuf,
   assert(jbuf != NULL);
   assert(key != NULL);
 
+  start = jbuf->offset;
   jbuf->offset += snprintf(jbuf->json + jbuf->offset,
                            jbuf->max_size - jbuf->offset,
                            "%s\"%s\": \"",
@@ -185,6 +215,8 @@ void evel_enc_kv_string(EVEL_JSON_BUFFER * jbuf,
                            jbuf->max_size - jbuf->offset,
                            "\"");
 
+  evel_json_delta_field(jbuf, key, start);
+
   EVEL_EXIT();
 }
 
@@ -202,6 +234,7 @@ bool evel_enc_kv_opt_int(EVEL_JSON_BUFFER * jbuf,
                          const EVEL_OPTION_INT * const option)
 {
   bool added = false;
+  int start;
 
   EVEL_ENTER();
 
@@ -221,8 +254,21 @@ bool evel_enc_kv_opt_int(EVEL_JSON_BUFFER * jbuf,
     else
     {
       EVEL_DEBUG("Encoded: %s, %d", key, option->value);
+      start = jbuf->offset;
       evel_enc_kv_int(jbuf, key, option->value);
-      added = true;
+
+      /*********************************************************************/
+      /* Under delta reporting, leave out a value which has not changed.   */
+      /*********************************************************************/
+      if (jbuf->delta_same && !jbuf->delta_refresh)
+      {
+        EVEL_DEBUG("Unchanged: %s", key);
+        jbuf->offset = start;
+      }
+      else
+      {
+        added = true;
+      }
     }
   }
 
@@ -242,6 +288,8 @@ void evel_enc_kv_int(EVEL_JSON_BUFFER * jbuf,
                      const char * const key,
                      const int value)
 {
+  int start;
+
   EVEL_ENTER();
 
   /***************************************************************************/
@@ -250,6 +298,7 @@ void evel_enc_kv_int(EVEL_JSON_BUFFER * jbuf,
   assert(jbuf != NULL);
   assert(key != NULL);
 
+  start = jbuf->offset;
   jbuf->offset += snprintf(jbuf->json + jbuf->offset,
                            jbuf->max_size - jbuf->offset,
                            "%s\"%s\": %d",
@@ -257,6 +306,9 @@ void evel_enc_kv_int(EVEL_JSON_BUFFER * jbuf,
                            key,
                            value);
 
+  evel_json_delta_field(jbuf, key, start);
+  evel_json_expose_field(jbuf, key, value);
+
   EVEL_EXIT();
 }
 
@@ -302,6 +354,7 @@ bool evel_enc_kv_opt_double(EVEL_JSON_BUFFER * jbuf,
                             const EVEL_OPTION_DOUBLE * const option)
 {
   bool added = false;
+  int start;
 
   EVEL_ENTER();
 
@@ -321,8 +374,21 @@ bool evel_enc_kv_opt_double(EVEL_JSON_BUFFER * jbuf,
     else
     {
       EVEL_DEBUG("Encoded: %s, %1f", key, option->value);
+      start = jbuf->offset;
       evel_enc_kv_double(jbuf, key, option->value);
-      added = true;
+
+      /*********************************************************************/
+      /* Under delta reporting, leave out a value which has not changed.   */
+      /*********************************************************************/
+      if (jbuf->delta_same && !jbuf->delta_refresh)
+      {
+        EVEL_DEBUG("Unchanged: %s", key);
+        jbuf->offset = start;
+      }
+      else
+      {
+        added = true;
+      }
     }
   }
 
@@ -342,6 +408,8 @@ void evel_enc_kv_double(EVEL_JSON_BUFFER * jbuf,
                         const char * const key,
                         const double value)
 {
+  int start;
+
   EVEL_ENTER();
 
   /***************************************************************************/
@@ -350,6 +418,7 @@ void evel_enc_kv_double(EVEL_JSON_BUFFER * jbuf,
   assert(jbuf != NULL);
   assert(key != NULL);
 
+  start = jbuf->offset;
   jbuf->offset += snprintf(jbuf->json + jbuf->offset,
                            jbuf->max_size - jbuf->offset,
                            "%s\"%s\": %1f",
@@ -357,6 +426,9 @@ void evel_enc_kv_double(EVEL_JSON_BUFFER * jbuf,
                            key,
                            value);
 
+  evel_json_delta_field(jbuf, key, start);
+  evel_json_expose_field(jbuf, key, value);
+
   EVEL_EXIT();
 }
 
@@ -373,6 +445,7 @@ bool evel_enc_kv_opt_ull(EVEL_JSON_BUFFER * jbuf,
                          const EVEL_OPTION_ULL * const option)
 {
   bool added = false;
+  int start;
 
   EVEL_ENTER();
 
@@ -392,8 +465,21 @@ bool evel_enc_kv_opt_ull(EVEL_JSON_BUFFER * jbuf,
     else
     {
       EVEL_DEBUG("Encoded: %s, %1lu", key, option->value);
+      start = jbuf->offset;
       evel_enc_kv_ull(jbuf, key, option->value);
-      added = true;
+
+      /*********************************************************************/
+      /* Under delta reporting, leave out a value which has not changed.   */
+      /*********************************************************************/
+      if (jbuf->delta_same && !jbuf->delta_refresh)
+      {
+        EVEL_DEBUG("Unchanged: %s", key);
+        jbuf->offset = start;
+      }
+      else
+      {
+        added = true;
+      }
     }
   }
 
@@ -413,6 +499,8 @@ void evel_enc_kv_ull(EVEL_JSON_BUFFER * jbuf,
                      const char * const key,
                      const unsigned long long value)
 {
+  int start;
+
   EVEL_ENTER();
 
   /***************************************************************************/
@@ -421,6 +509,7 @@ void evel_enc_kv_ull(EVEL_JSON_BUFFER * jbuf,
   assert(jbuf != NULL);
   assert(key != NULL);
 
+  start = jbuf->offset;
   jbuf->offset += snprintf(jbuf->json + jbuf->offset,
                            jbuf->max_size - jbuf->offset,
                            "%s\"%s\": %llu",
@@ -428,6 +517,9 @@ void evel_enc_kv_ull(EVEL_JSON_BUFFER * jbuf,
                            key,
                            value);
 
+  evel_json_delta_field(jbuf, key, start);
+  evel_json_expose_field(jbuf, key, value);
+
   EVEL_EXIT();
 }
 
@@ -444,6 +536,7 @@ bool evel_enc_kv_opt_time(EVEL_JSON_BUFFER * jbuf,
                           const EVEL_OPTION_TIME * const option)
 {
   bool added = false;
+  int start;
 
   EVEL_ENTER();
 
@@ -463,8 +556,21 @@ bool evel_enc_kv_opt_time(EVEL_JSON_BUFFER * jbuf,
     else
     {
       EVEL_DEBUG("Encoded time: %s", key);
+      start = jbuf->offset;
       evel_enc_kv_time(jbuf, key, &option->value);
-      added = true;
+
+      /*********************************************************************/
+      /* Under delta reporting, leave out a value which has not changed.   */
+      /*********************************************************************/
+      if (jbuf->delta_same && !jbuf->delta_refresh)
+      {
+        EVEL_DEBUG("Unchanged: %s", key);
+        jbuf->offset = start;
+      }
+      else
+      {
+        added = true;
+      }
     }
   }
 
@@ -484,6 +590,8 @@ void evel_enc_kv_time(EVEL_JSON_BUFFER * jbuf,
                       const char * const key,
                       const time_t * time)
 {
+  int start;
+
   EVEL_ENTER();
 
   /***************************************************************************/
@@ -493,6 +601,7 @@ void evel_enc_kv_time(EVEL_JSON_BUFFER * jbuf,
   assert(key != NULL);
   assert(time != NULL);
 
+  start = jbuf->offset;
   jbuf->offset += snprintf(jbuf->json + jbuf->offset,
                            jbuf->max_size - jbuf->offset,
                            "%s\"%s\": \"",
@@ -505,6 +614,9 @@ void evel_enc_kv_time(EVEL_JSON_BUFFER * jbuf,
   jbuf->offset += snprintf(jbuf->json + jbuf->offset,
                            jbuf->max_size - jbuf->offset,
                            "\"");
+
+  evel_json_delta_field(jbuf, key, start);
+
   EVEL_EXIT();
 }
 
@@ -788,7 +900,94 @@ void evel_json_close_object(EVEL_JSON_BUFFER * jbuf)
                            "}");
   jbuf->depth--;
 
+  /***************************************************************************/
+  /* Stop exposing the fields of an exposed object once it is closed.        */
+  /***************************************************************************/
+  if ((jbuf->prometheus_objects > 0) &&
+      (jbuf->depth < jbuf->prometheus_depth[jbuf->prometheus_objects - 1]))
+  {
+    jbuf->prometheus_objects--;
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Add the opening bracket of an object identified within a list, whose
+ * unchanged fields are left out under delta reporting, and whose numeric
+ * fields are exposed by the Prometheus endpoint.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param list          The key of the list containing the object.
+ * @param id            The object's identifier within the list.
+ *****************************************************************************/
+void evel_json_open_delta_object(EVEL_JSON_BUFFER * jbuf,
+                                 const char * const list,
+                                 const char * const id)
+{
+  int offset;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(jbuf != NULL);
+  assert(list != NULL);
+  assert(id != NULL);
+  assert(jbuf->delta_object_offset < 0);
+
+  offset = jbuf->offset;
+  evel_json_open_object(jbuf);
+  evel_json_expose_object(jbuf, id);
+
+  if (jbuf->delta != NULL)
+  {
+    snprintf(jbuf->delta_object, sizeof(jbuf->delta_object),
+             "%s" EVEL_DELTA_SEPARATOR "%s", list, id);
+    jbuf->delta_object_offset = offset;
+    jbuf->delta_depth = jbuf->depth;
+    jbuf->delta_changed = false;
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Add the closing bracket of an object opened with
+ * ::evel_json_open_delta_object, or drop the object if it is unchanged.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @returns true if the object was kept, false if it was dropped.
+ *****************************************************************************/
+bool evel_json_close_delta_object(EVEL_JSON_BUFFER * jbuf)
+{
+  bool kept = true;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(jbuf != NULL);
+
+  evel_json_close_object(jbuf);
+
+  if (jbuf->delta_object_offset >= 0)
+  {
+    if (!jbuf->delta_changed && !jbuf->delta_refresh)
+    {
+      EVEL_DEBUG("Unchanged object: %s", jbuf->delta_object);
+      jbuf->offset = jbuf->delta_object_offset;
+      kept = false;
+    }
+    jbuf->delta_object_offset = -1;
+    jbuf->delta_same = false;
+  }
+
   EVEL_EXIT();
+
+  return kept;
 }
 
 /**************************************************************************//**
@@ -870,3 +1069,47 @@ void evel_json_rewind(EVEL_JSON_BUFFER * jbuf)
 
   EVEL_EXIT();
 }
+
+/**************************************************************************//**
+ * Under delta reporting, note whether a field just encoded directly within
+ * the current identified object has changed since it was last encoded.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param key           The field's key.
+ * @param start         The offset at which the field was encoded.
+ *****************************************************************************/
+static void evel_json_delta_field(EVEL_JSON_BUFFER * jbuf,
+                                  const char * const key,
+                                  const int start)
+{
+  const char * text;
+
+  EVEL_ENTER();
+
+  jbuf->delta_same = false;
+
+  if ((jbuf->delta_object_offset >= 0) &&
+      (jbuf->depth == jbuf->delta_depth) &&
+      (jbuf->offset < jbuf->max_size))
+  {
+    /*************************************************************************/
+    /* Compare the key and value only, not any comma before them.            */
+    /*************************************************************************/
+    text = jbuf->json + start;
+    if (text[0] == ',')
+    {
+      text += 2;
+    }
+
+    if (evel_delta_changed(jbuf, key, text))
+    {
+      jbuf->delta_changed = true;
+    }
+    else
+    {
+      jbuf->delta_same = true;
+    }
+  }
+
+  EVEL_EXIT();
+}
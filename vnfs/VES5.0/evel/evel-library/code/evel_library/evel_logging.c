@@ -19,12 +19,28 @@
  * @file
  * Wrapper for event logging built on syslog.
  *
+ * Once log_async_start() has been called, log_debug() formats each message
+ * into a slot of a bounded lock-free queue and returns; a dedicated writer
+ * thread empties the queue to syslog or to a file.  The queue is a bounded
+ * multi-producer queue in the style of Dmitry Vyukov: each slot carries a
+ * sequence number which tells producers and the writer whose turn it is.
+ * If the queue is full the message is dropped and counted rather than
+ * blocking the caller.  The writer also rate-limits bursts of identical
+ * error messages.
+ *
+ * Before log_async_start() and after log_async_stop(), messages are written
+ * synchronously as before.
  ****************************************************************************/
 
 #include <string.h>
 #include <assert.h>
 #include <syslog.h>
 #include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <semaphore.h>
 #include <sys/time.h>
 
 #include <curl/curl.h>
@@ -45,6 +61,66 @@ int debug_indent = 0;
 /*****************************************************************************/
 static char evel_err_string[EVEL_MAX_ERROR_STRING_LEN] = "<NULL>";
 
+/*****************************************************************************/
+/* Asynchronous logging queue sizing.  Slots must be a power of two.         */
+/*****************************************************************************/
+#define EVEL_LOG_QUEUE_SLOTS 1024
+#define EVEL_LOG_QUEUE_MASK (EVEL_LOG_QUEUE_SLOTS - 1)
+#define EVEL_LOG_MAX_MESSAGE 1024
+
+/*****************************************************************************/
+/* Error rate limiting: at most EVEL_LOG_ERROR_BURST identical errors are    */
+/* written in each EVEL_LOG_ERROR_WINDOW seconds.                            */
+/*****************************************************************************/
+#define EVEL_LOG_ERROR_BURST 5
+#define EVEL_LOG_ERROR_WINDOW 10
+#define EVEL_LOG_ERROR_TRACKED 64
+
+/**************************************************************************//**
+ * A queued log message.
+ *****************************************************************************/
+typedef struct log_slot {
+  unsigned long long sequence;
+  int priority;
+  struct timespec time;
+  char message[EVEL_LOG_MAX_MESSAGE];
+} LOG_SLOT;
+
+/**************************************************************************//**
+ * Rate-limiting state for one distinct error message.
+ *****************************************************************************/
+typedef struct log_error_entry {
+  unsigned long hash;
+  time_t window_start;
+  int count;
+  unsigned long long suppressed;
+  char message[EVEL_MAX_ERROR_STRING_LEN];
+} LOG_ERROR_ENTRY;
+
+/*****************************************************************************/
+/* Asynchronous logging state.                                               */
+/*****************************************************************************/
+static int log_async_active = 0;
+static int log_async_stopping = 0;
+static LOG_SLOT * log_slots = NULL;
+static unsigned long long log_enqueue_pos = 0;
+static unsigned long long log_dequeue_pos = 0;
+static sem_t log_sem;
+static pthread_t log_thread;
+static FILE * log_file = NULL;
+static char log_ident[EVEL_MAX_STRING_LEN + 1] = "EVEL";
+
+/*****************************************************************************/
+/* Counters, readable through log_async_stats().                             */
+/*****************************************************************************/
+static unsigned long long log_dropped = 0;
+static unsigned long long log_dropped_reported = 0;
+static unsigned long long log_suppressed = 0;
+
+/*****************************************************************************/
+/* Writer-thread only rate-limiting table.                                   */
+/*****************************************************************************/
+static LOG_ERROR_ENTRY log_errors[EVEL_LOG_ERROR_TRACKED];
 
 /**************************************************************************//**
  * Initialize logging
@@ -58,6 +134,7 @@ void log_initialize(EVEL_LOG_LEVELS level, const char * ident)
   assert(ident != NULL);
 
   debug_level = level;
+  strncpy(log_ident, ident, EVEL_MAX_STRING_LEN);
   openlog(ident, LOG_PID, LOG_USER);
 }
 
@@ -93,6 +170,397 @@ void log_error_state(char * format, ...)
   EVEL_ERROR("%s", evel_err_string);
 }
 
+/**************************************************************************//**
+ * Write one formatted message to the configured destination.
+ *
+ * @param priority  The syslog priority.
+ * @param time      When the message was logged.
+ * @param message   The formatted message.
+ *****************************************************************************/
+static void log_write(const int priority,
+                      const struct timespec * const time,
+                      const char * const message)
+{
+  struct tm tm;
+  char date[32];
+
+  if (log_file != NULL)
+  {
+    localtime_r(&time->tv_sec, &tm);
+    strftime(date, sizeof(date), "%b %e %H:%M:%S", &tm);
+    fprintf(log_file, "%s.%06ld %s[%d]: %s\n",
+            date,
+            time->tv_nsec / 1000,
+            log_ident,
+            (int) getpid(),
+            message);
+  }
+  else
+  {
+    syslog(priority, "%s", message);
+  }
+}
+
+/**************************************************************************//**
+ * Decide whether an error message should be written or suppressed.
+ *
+ * Identical errors are counted in a small table keyed by a hash of the
+ * message.  Once ::EVEL_LOG_ERROR_BURST have been written within a window,
+ * further repeats are suppressed until the window expires, at which point
+ * a summary of the suppressed count is written.  Called only from the
+ * writer thread.
+ *
+ * @param time      When the message was logged.
+ * @param message   The formatted error message.
+ *
+ * @returns 1 if the message should be written, 0 if suppressed.
+ *****************************************************************************/
+static int log_error_allowed(const struct timespec * const time,
+                             const char * const message)
+{
+  LOG_ERROR_ENTRY * entry;
+  unsigned long hash = 5381;
+  const char * cp;
+  char summary[EVEL_MAX_ERROR_STRING_LEN + 64];
+
+  for (cp = message; *cp != '\0'; cp++)
+  {
+    hash = hash * 33 + (unsigned char) *cp;
+  }
+
+  entry = &log_errors[hash % EVEL_LOG_ERROR_TRACKED];
+  if (entry->hash != hash ||
+      time->tv_sec - entry->window_start >= EVEL_LOG_ERROR_WINDOW)
+  {
+    if (entry->suppressed != 0)
+    {
+      snprintf(summary, sizeof(summary),
+               "Suppressed %llu repeats of: %s",
+               entry->suppressed,
+               entry->message);
+      log_write(LOG_ERR, time, summary);
+    }
+    entry->hash = hash;
+    entry->window_start = time->tv_sec;
+    entry->count = 0;
+    entry->suppressed = 0;
+    strncpy(entry->message, message, EVEL_MAX_ERROR_STRING_LEN - 1);
+  }
+
+  if (entry->count < EVEL_LOG_ERROR_BURST)
+  {
+    entry->count++;
+    return 1;
+  }
+
+  entry->suppressed++;
+  __atomic_add_fetch(&log_suppressed, 1, __ATOMIC_RELAXED);
+  return 0;
+}
+
+/**************************************************************************//**
+ * Write summaries for any errors still being suppressed.  Called when
+ * asynchronous logging stops so that suppressed counts are not lost.
+ *****************************************************************************/
+static void log_error_summaries(void)
+{
+  LOG_ERROR_ENTRY * entry;
+  struct timespec now;
+  char summary[EVEL_MAX_ERROR_STRING_LEN + 64];
+  int i;
+
+  clock_gettime(CLOCK_REALTIME, &now);
+  for (i = 0; i < EVEL_LOG_ERROR_TRACKED; i++)
+  {
+    entry = &log_errors[i];
+    if (entry->suppressed != 0)
+    {
+      snprintf(summary, sizeof(summary),
+               "Suppressed %llu repeats of: %s",
+               entry->suppressed,
+               entry->message);
+      log_write(LOG_ERR, &now, summary);
+      entry->suppressed = 0;
+    }
+  }
+}
+
+/**************************************************************************//**
+ * Write out everything currently in the queue.  Called only from the
+ * writer thread, or once the writer thread has stopped.
+ *****************************************************************************/
+static void log_drain(void)
+{
+  LOG_SLOT * slot;
+  unsigned long long dropped;
+  char summary[64];
+  struct timespec now;
+
+  for (;;)
+  {
+    slot = &log_slots[log_dequeue_pos & EVEL_LOG_QUEUE_MASK];
+    if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) !=
+        log_dequeue_pos + 1)
+    {
+      break;
+    }
+
+    if (slot->priority != LOG_ERR ||
+        log_error_allowed(&slot->time, slot->message))
+    {
+      log_write(slot->priority, &slot->time, slot->message);
+    }
+
+    __atomic_store_n(&slot->sequence,
+                     log_dequeue_pos + EVEL_LOG_QUEUE_SLOTS,
+                     __ATOMIC_RELEASE);
+    log_dequeue_pos++;
+  }
+
+  /***************************************************************************/
+  /* Report overflow once the queue has room again.                          */
+  /***************************************************************************/
+  dropped = __atomic_load_n(&log_dropped, __ATOMIC_RELAXED);
+  if (dropped != log_dropped_reported)
+  {
+    clock_gettime(CLOCK_REALTIME, &now);
+    snprintf(summary, sizeof(summary),
+             "Log queue full: %llu messages dropped",
+             dropped - log_dropped_reported);
+    log_write(LOG_WARNING, &now, summary);
+    log_dropped_reported = dropped;
+  }
+
+  if (log_file != NULL)
+  {
+    fflush(log_file);
+  }
+}
+
+/**************************************************************************//**
+ * Log writer thread.
+ *
+ * @param arg   Unused.
+ *****************************************************************************/
+static void * log_writer_thread(void * arg)
+{
+  (void) arg;
+
+  while (!__atomic_load_n(&log_async_stopping, __ATOMIC_ACQUIRE))
+  {
+    while (sem_wait(&log_sem) != 0)
+    {
+    }
+    log_drain();
+  }
+  log_drain();
+
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Place a message on the asynchronous queue.
+ *
+ * @param priority  The syslog priority.
+ * @param indent    Number of indent markers to prefix.
+ * @param format    The output formatting in printf style.
+ * @param largs     Variable arguments as specified in the format string.
+ *****************************************************************************/
+static void log_enqueue(const int priority,
+                        const int indent,
+                        const char * const format,
+                        va_list largs)
+{
+  LOG_SLOT * slot;
+  unsigned long long pos;
+  unsigned long long sequence;
+  long long difference;
+  int offset = 0;
+
+  pos = __atomic_load_n(&log_enqueue_pos, __ATOMIC_RELAXED);
+  for (;;)
+  {
+    slot = &log_slots[pos & EVEL_LOG_QUEUE_MASK];
+    sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+    difference = (long long) (sequence - pos);
+    if (difference == 0)
+    {
+      if (__atomic_compare_exchange_n(&log_enqueue_pos, &pos, pos + 1, 1,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+      {
+        break;
+      }
+    }
+    else if (difference < 0)
+    {
+      /***********************************************************************/
+      /* Queue full: drop rather than block the caller.                      */
+      /***********************************************************************/
+      __atomic_add_fetch(&log_dropped, 1, __ATOMIC_RELAXED);
+      return;
+    }
+    else
+    {
+      pos = __atomic_load_n(&log_enqueue_pos, __ATOMIC_RELAXED);
+    }
+  }
+
+  slot->priority = priority;
+  clock_gettime(CLOCK_REALTIME, &slot->time);
+  if (indent > 0)
+  {
+    offset = snprintf(slot->message, EVEL_LOG_MAX_MESSAGE, "%.*s",
+                      indent, INDENT_SEPARATORS);
+  }
+  vsnprintf(slot->message + offset,
+            EVEL_LOG_MAX_MESSAGE - offset,
+            format,
+            largs);
+
+  __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+  sem_post(&log_sem);
+}
+
+/**************************************************************************//**
+ * Start asynchronous logging.
+ *
+ * @param path  File to append logs to, or NULL or "" to write to syslog.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_OUT_OF_MEMORY The queue could not be allocated.
+ * @retval  EVEL_ERR_GEN_FAIL The file could not be opened.
+ * @retval  EVEL_PTHREAD_LIBRARY_FAIL The writer thread could not be started.
+ *****************************************************************************/
+EVEL_ERR_CODES log_async_start(const char * const path)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  int i;
+
+  if (log_async_active)
+  {
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* The queue and semaphore are kept after log_async_stop() since a         */
+  /* producer may still be part way through queueing a message.              */
+  /***************************************************************************/
+  if (log_slots == NULL)
+  {
+    log_slots = malloc(sizeof(LOG_SLOT) * EVEL_LOG_QUEUE_SLOTS);
+    if (log_slots == NULL)
+    {
+      log_error_state("Failed to allocate log queue");
+      rc = EVEL_OUT_OF_MEMORY;
+      goto exit_label;
+    }
+    for (i = 0; i < EVEL_LOG_QUEUE_SLOTS; i++)
+    {
+      log_slots[i].sequence = i;
+    }
+    sem_init(&log_sem, 0, 0);
+  }
+  memset(log_errors, 0, sizeof(log_errors));
+
+  if (path != NULL && *path != '\0')
+  {
+    log_file = fopen(path, "a");
+    if (log_file == NULL)
+    {
+      log_error_state("Failed to open log file %s", path);
+      rc = EVEL_ERR_GEN_FAIL;
+      goto exit_label;
+    }
+  }
+
+  log_async_stopping = 0;
+  if (pthread_create(&log_thread, NULL, log_writer_thread, NULL) != 0)
+  {
+    log_error_state("Failed to start log writer thread");
+    if (log_file != NULL)
+    {
+      fclose(log_file);
+      log_file = NULL;
+    }
+    rc = EVEL_PTHREAD_LIBRARY_FAIL;
+    goto exit_label;
+  }
+
+  __atomic_store_n(&log_async_active, 1, __ATOMIC_RELEASE);
+
+exit_label:
+  return rc;
+}
+
+/**************************************************************************//**
+ * Wait until everything logged so far has been written out.
+ *
+ * Does nothing if asynchronous logging is not running.
+ *****************************************************************************/
+void log_async_flush(void)
+{
+  unsigned long long target;
+  struct timespec pause = {0, 1000000};
+
+  if (!__atomic_load_n(&log_async_active, __ATOMIC_ACQUIRE))
+  {
+    return;
+  }
+
+  target = __atomic_load_n(&log_enqueue_pos, __ATOMIC_ACQUIRE);
+  sem_post(&log_sem);
+  while (__atomic_load_n(&log_dequeue_pos, __ATOMIC_ACQUIRE) < target &&
+         __atomic_load_n(&log_async_active, __ATOMIC_ACQUIRE))
+  {
+    nanosleep(&pause, NULL);
+  }
+}
+
+/**************************************************************************//**
+ * Stop asynchronous logging, flushing the queue.  Later messages are
+ * written synchronously.
+ *****************************************************************************/
+void log_async_stop(void)
+{
+  if (!__atomic_load_n(&log_async_active, __ATOMIC_ACQUIRE))
+  {
+    return;
+  }
+
+  __atomic_store_n(&log_async_active, 0, __ATOMIC_RELEASE);
+  __atomic_store_n(&log_async_stopping, 1, __ATOMIC_RELEASE);
+  sem_post(&log_sem);
+  pthread_join(log_thread, NULL);
+
+  /***************************************************************************/
+  /* Catch any message queued as the writer was finishing.                   */
+  /***************************************************************************/
+  log_drain();
+  log_error_summaries();
+
+  if (log_file != NULL)
+  {
+    fclose(log_file);
+    log_file = NULL;
+  }
+}
+
+/**************************************************************************//**
+ * Report asynchronous logging counters.
+ *
+ * @param[out] dropped      Messages dropped because the queue was full.
+ * @param[out] suppressed   Error messages suppressed by rate limiting.
+ *****************************************************************************/
+void log_async_stats(unsigned long long * const dropped,
+                     unsigned long long * const suppressed)
+{
+  assert(dropped != NULL);
+  assert(suppressed != NULL);
+
+  *dropped = __atomic_load_n(&log_dropped, __ATOMIC_RELAXED);
+  *suppressed = __atomic_load_n(&log_suppressed, __ATOMIC_RELAXED);
+}
 
 /**************************************************************************//**
  *  Generate a debug log.
@@ -108,6 +576,7 @@ void log_debug(EVEL_LOG_LEVELS level, char * format, ...)
 {
   va_list largs;
   int priority;
+  int indent;
   char indent_fmt[1024];
   char *syslog_fmt = NULL;
 
@@ -119,25 +588,6 @@ void log_debug(EVEL_LOG_LEVELS level, char * format, ...)
 
   if (level >= debug_level)
   {
-    if ((debug_level == EVEL_LOG_INFO) || (debug_indent == 0))
-    {
-      /***********************************************************************/
-      /* Just use the format as is.                                          */
-      /***********************************************************************/
-      syslog_fmt = format;
-    }
-    else
-    {
-      /***********************************************************************/
-      /* Combine the format with a preceding number of indent markers.       */
-      /***********************************************************************/
-      sprintf(indent_fmt, "%.*s%s",
-              debug_indent,
-              INDENT_SEPARATORS,
-              format);
-      syslog_fmt = indent_fmt;
-    }
-
     /*************************************************************************/
     /* Work out the syslog priority value.                                   */
     /*************************************************************************/
@@ -158,6 +608,35 @@ void log_debug(EVEL_LOG_LEVELS level, char * format, ...)
       break;
     }
 
+    indent = (debug_level == EVEL_LOG_INFO) ? 0 : debug_indent;
+
+    if (__atomic_load_n(&log_async_active, __ATOMIC_ACQUIRE))
+    {
+      va_start(largs, format);
+      log_enqueue(priority, indent, format, largs);
+      va_end(largs);
+      return;
+    }
+
+    if (indent == 0)
+    {
+      /***********************************************************************/
+      /* Just use the format as is.                                          */
+      /***********************************************************************/
+      syslog_fmt = format;
+    }
+    else
+    {
+      /***********************************************************************/
+      /* Combine the format with a preceding number of indent markers.       */
+      /***********************************************************************/
+      snprintf(indent_fmt, sizeof(indent_fmt), "%.*s%s",
+               indent,
+               INDENT_SEPARATORS,
+               format);
+      syslog_fmt = indent_fmt;
+    }
+
     /*************************************************************************/
     /* Write the log to the file next, which requires the var args list.     */
     /*************************************************************************/
@@ -0,0 +1,442 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Matching a line against many substrings at once.
+ *
+ * The patterns are compiled into an Aho-Corasick automaton, with the
+ * failure links folded into a full transition table so that each byte of
+ * the line costs one table lookup however many patterns there are.  Each
+ * state records the first-added include pattern, and whether any exclude
+ * pattern, ends there or at any of its suffixes, so nothing is followed at
+ * match time beyond the transitions.
+ *
+ * The table has 256 entries per state, one state per distinct pattern
+ * prefix: a few dozen tags of a few dozen bytes take some hundreds of
+ * kilobytes.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Transitions from each state.                                              */
+/*****************************************************************************/
+#define EVEL_MATCHER_ALPHABET 256
+
+/**************************************************************************//**
+ * A pattern, and the caller's identifier for it.  Exclude patterns have an
+ * identifier of -1.
+ *****************************************************************************/
+typedef struct evel_matcher_pattern {
+  char * text;
+  size_t length;
+  int id;
+} EVEL_MATCHER_PATTERN;
+
+/**************************************************************************//**
+ * Matcher state.  The automaton is only valid while compiled is set.
+ *****************************************************************************/
+struct evel_matcher {
+  EVEL_MATCHER_PATTERN * patterns;
+  int num_patterns;
+  int max_patterns;
+  int compiled;
+  int num_states;
+  int * next;                 /** num_states rows of transitions.            */
+  int * include;              /** Lowest include pattern index, else -1.     */
+  char * exclude;
+};
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static EVEL_ERR_CODES evel_matcher_add(EVEL_MATCHER * const matcher,
+                                       const char * const pattern,
+                                       const int id);
+static void evel_matcher_discard(EVEL_MATCHER * const matcher);
+
+/**************************************************************************//**
+ * Create a matcher with no patterns.
+ *
+ * @returns pointer to the new matcher.
+ * @retval  NULL  Failed to allocate the matcher.
+ *****************************************************************************/
+EVEL_MATCHER * evel_new_matcher(void)
+{
+  EVEL_MATCHER * matcher = NULL;
+
+  EVEL_ENTER();
+
+  matcher = calloc(1, sizeof(EVEL_MATCHER));
+  if (matcher == NULL)
+  {
+    log_error_state("Failed to allocate matcher");
+  }
+
+  EVEL_EXIT();
+
+  return matcher;
+}
+
+/**************************************************************************//**
+ * Free a matcher.
+ *
+ * @param matcher   The matcher.  May be NULL.
+ *****************************************************************************/
+void evel_free_matcher(EVEL_MATCHER * matcher)
+{
+  int ii;
+
+  EVEL_ENTER();
+
+  if (matcher != NULL)
+  {
+    evel_matcher_discard(matcher);
+    for (ii = 0; ii < matcher->num_patterns; ii++)
+    {
+      free(matcher->patterns[ii].text);
+    }
+    free(matcher->patterns);
+    free(matcher);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Add a pattern which makes a line match.
+ *
+ * @param matcher   The matcher.
+ * @param pattern   The pattern, matched anywhere in the line.
+ * @param id        Identifier returned when this pattern decides the match.
+ *                  Must not be negative.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_ERR_GEN_FAIL The pattern is empty.
+ * @retval  EVEL_OUT_OF_MEMORY Failed to allocate the pattern.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_matcher_include(EVEL_MATCHER * const matcher,
+                                    const char * const pattern,
+                                    const int id)
+{
+  EVEL_ERR_CODES rc;
+
+  EVEL_ENTER();
+
+  assert(id >= 0);
+
+  rc = evel_matcher_add(matcher, pattern, id);
+
+  EVEL_EXIT();
+
+  return rc;
+}
+
+/**************************************************************************//**
+ * Add a pattern which stops a line matching, whatever else it contains.
+ *
+ * @param matcher   The matcher.
+ * @param pattern   The pattern, matched anywhere in the line.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_ERR_GEN_FAIL The pattern is empty.
+ * @retval  EVEL_OUT_OF_MEMORY Failed to allocate the pattern.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_matcher_exclude(EVEL_MATCHER * const matcher,
+                                    const char * const pattern)
+{
+  EVEL_ERR_CODES rc;
+
+  EVEL_ENTER();
+
+  rc = evel_matcher_add(matcher, pattern, -1);
+
+  EVEL_EXIT();
+
+  return rc;
+}
+
+/**************************************************************************//**
+ * Add a pattern, invalidating any compiled automaton.
+ *
+ * @param matcher   The matcher.
+ * @param pattern   The pattern.
+ * @param id        Identifier, or -1 for an exclude pattern.
+ *
+ * @returns Status code
+ *****************************************************************************/
+static EVEL_ERR_CODES evel_matcher_add(EVEL_MATCHER * const matcher,
+                                       const char * const pattern,
+                                       const int id)
+{
+  EVEL_MATCHER_PATTERN * patterns;
+  int max_patterns;
+
+  assert(matcher != NULL);
+  assert(pattern != NULL);
+
+  if (*pattern == '\0')
+  {
+    log_error_state("Empty matcher pattern");
+    return EVEL_ERR_GEN_FAIL;
+  }
+
+  if (matcher->num_patterns == matcher->max_patterns)
+  {
+    max_patterns = (matcher->max_patterns == 0) ?
+                   8 : matcher->max_patterns * 2;
+    patterns = realloc(matcher->patterns,
+                       max_patterns * sizeof(EVEL_MATCHER_PATTERN));
+    if (patterns == NULL)
+    {
+      log_error_state("Failed to allocate matcher patterns");
+      return EVEL_OUT_OF_MEMORY;
+    }
+    matcher->patterns = patterns;
+    matcher->max_patterns = max_patterns;
+  }
+
+  patterns = &matcher->patterns[matcher->num_patterns];
+  patterns->text = strdup(pattern);
+  if (patterns->text == NULL)
+  {
+    log_error_state("Failed to allocate matcher pattern");
+    return EVEL_OUT_OF_MEMORY;
+  }
+  patterns->length = strlen(pattern);
+  patterns->id = id;
+  matcher->num_patterns++;
+
+  evel_matcher_discard(matcher);
+
+  return EVEL_SUCCESS;
+}
+
+/**************************************************************************//**
+ * Free the compiled automaton.
+ *
+ * @param matcher   The matcher.
+ *****************************************************************************/
+static void evel_matcher_discard(EVEL_MATCHER * const matcher)
+{
+  free(matcher->next);
+  free(matcher->include);
+  free(matcher->exclude);
+  matcher->next = NULL;
+  matcher->include = NULL;
+  matcher->exclude = NULL;
+  matcher->num_states = 0;
+  matcher->compiled = 0;
+}
+
+/**************************************************************************//**
+ * Compile the patterns added so far.  Must be called before matching, and
+ * again after adding more patterns.
+ *
+ * @param matcher   The matcher.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_OUT_OF_MEMORY Failed to allocate the automaton.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_matcher_compile(EVEL_MATCHER * const matcher)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  const EVEL_MATCHER_PATTERN * pattern;
+  int * fail = NULL;
+  int * queue = NULL;
+  int * row;
+  int max_states = 1;
+  int head = 0;
+  int tail = 0;
+  int state;
+  int child;
+  int ii;
+  size_t jj;
+  int cc;
+
+  EVEL_ENTER();
+
+  assert(matcher != NULL);
+
+  evel_matcher_discard(matcher);
+
+  for (ii = 0; ii < matcher->num_patterns; ii++)
+  {
+    max_states += matcher->patterns[ii].length;
+  }
+
+  matcher->next = malloc((size_t) max_states * EVEL_MATCHER_ALPHABET *
+                         sizeof(int));
+  matcher->include = malloc(max_states * sizeof(int));
+  matcher->exclude = calloc(max_states, sizeof(char));
+  fail = calloc(max_states, sizeof(int));
+  queue = malloc(max_states * sizeof(int));
+  if (matcher->next == NULL || matcher->include == NULL ||
+      matcher->exclude == NULL || fail == NULL || queue == NULL)
+  {
+    log_error_state("Failed to allocate matcher automaton");
+    evel_matcher_discard(matcher);
+    rc = EVEL_OUT_OF_MEMORY;
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Build the trie of patterns, -1 marking the transitions still to fill.   */
+  /***************************************************************************/
+  matcher->num_states = 1;
+  memset(matcher->next, -1, EVEL_MATCHER_ALPHABET * sizeof(int));
+  matcher->include[0] = -1;
+
+  for (ii = 0; ii < matcher->num_patterns; ii++)
+  {
+    pattern = &matcher->patterns[ii];
+    state = 0;
+    for (jj = 0; jj < pattern->length; jj++)
+    {
+      row = &matcher->next[state * EVEL_MATCHER_ALPHABET];
+      cc = (unsigned char) pattern->text[jj];
+      if (row[cc] < 0)
+      {
+        child = matcher->num_states++;
+        memset(&matcher->next[child * EVEL_MATCHER_ALPHABET],
+               -1,
+               EVEL_MATCHER_ALPHABET * sizeof(int));
+        matcher->include[child] = -1;
+        row[cc] = child;
+      }
+      state = row[cc];
+    }
+
+    if (pattern->id < 0)
+    {
+      matcher->exclude[state] = 1;
+    }
+    else if (matcher->include[state] < 0)
+    {
+      matcher->include[state] = ii;
+    }
+  }
+
+  /***************************************************************************/
+  /* Walk the trie breadth first, so that each state's failure state, being  */
+  /* shallower, is complete before the state is.  Missing transitions are    */
+  /* taken from the failure state, and its matches merged in.                */
+  /***************************************************************************/
+  row = matcher->next;
+  for (cc = 0; cc < EVEL_MATCHER_ALPHABET; cc++)
+  {
+    if (row[cc] < 0)
+    {
+      row[cc] = 0;
+    }
+    else
+    {
+      fail[row[cc]] = 0;
+      queue[tail++] = row[cc];
+    }
+  }
+
+  while (head < tail)
+  {
+    state = queue[head++];
+    row = &matcher->next[state * EVEL_MATCHER_ALPHABET];
+    for (cc = 0; cc < EVEL_MATCHER_ALPHABET; cc++)
+    {
+      child = row[cc];
+      if (child < 0)
+      {
+        row[cc] = matcher->next[fail[state] * EVEL_MATCHER_ALPHABET + cc];
+        continue;
+      }
+
+      fail[child] = matcher->next[fail[state] * EVEL_MATCHER_ALPHABET + cc];
+      if (matcher->exclude[fail[child]])
+      {
+        matcher->exclude[child] = 1;
+      }
+      if (matcher->include[fail[child]] >= 0 &&
+          (matcher->include[child] < 0 ||
+           matcher->include[fail[child]] < matcher->include[child]))
+      {
+        matcher->include[child] = matcher->include[fail[child]];
+      }
+      queue[tail++] = child;
+    }
+  }
+
+  matcher->compiled = 1;
+  EVEL_DEBUG("Compiled %d matcher patterns into %d states",
+             matcher->num_patterns, matcher->num_states);
+
+exit_label:
+  free(fail);
+  free(queue);
+  EVEL_EXIT();
+
+  return rc;
+}
+
+/**************************************************************************//**
+ * Match a line in one pass.
+ *
+ * @param matcher   The compiled matcher.
+ * @param text      The line.
+ * @param length    Length of the line.
+ *
+ * @returns Identifier of the first-added include pattern in the line, or -1
+ *          if the line contains no include pattern or any exclude pattern.
+ *****************************************************************************/
+int evel_matcher_match(const EVEL_MATCHER * const matcher,
+                       const char * const text,
+                       const size_t length)
+{
+  const unsigned char * pos = (const unsigned char *) text;
+  const unsigned char * end = pos + length;
+  const int * next;
+  int best = -1;
+  int state = 0;
+
+  assert(matcher != NULL);
+  assert(matcher->compiled);
+  assert(text != NULL || length == 0);
+
+  next = matcher->next;
+  while (pos < end)
+  {
+    state = next[state * EVEL_MATCHER_ALPHABET + *pos++];
+    if (matcher->exclude[state])
+    {
+      return -1;
+    }
+    if (matcher->include[state] >= 0 &&
+        (best < 0 || matcher->include[state] < best))
+    {
+      best = matcher->include[state];
+    }
+  }
+
+  return (best < 0) ? -1 : matcher->patterns[best].id;
+}
@@ -0,0 +1,204 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Memory usage from /proc/meminfo.
+ *
+ * /proc/meminfo has one "Name:   value kB" line per figure.  It is small
+ * enough to read into a stack buffer in one read(), and the figures used
+ * here are all near the top.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Space to read /proc/meminfo into.                                         */
+/*****************************************************************************/
+#define EVEL_MEM_BUFFER 4096
+
+/**************************************************************************//**
+ * Read memory usage from /proc/meminfo.
+ *
+ * @param stats     The figures to fill in.
+ * @param path      File to read, or NULL for ::EVEL_MEM_PROC_MEMINFO.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  "One of ::EVEL_ERR_CODES" On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_memstats_read_procfs(EVEL_MEM_STATS * const stats,
+                                         const char * const path)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  const char * file = (path != NULL) ? path : EVEL_MEM_PROC_MEMINFO;
+  char buffer[EVEL_MEM_BUFFER];
+  const char * line;
+  const char * colon;
+  unsigned long long * field;
+  unsigned long long value;
+  size_t name_len;
+  ssize_t bytes;
+  int fd;
+
+  EVEL_ENTER();
+
+  assert(stats != NULL);
+
+  fd = open(file, O_RDONLY);
+  if (fd < 0)
+  {
+    log_error_state("Failed to open %s: %s", file, strerror(errno));
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+  do
+  {
+    bytes = read(fd, buffer, sizeof(buffer) - 1);
+  } while (bytes < 0 && errno == EINTR);
+  close(fd);
+  if (bytes < 0)
+  {
+    log_error_state("Failed to read %s: %s", file, strerror(errno));
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+  buffer[bytes] = '\0';
+
+  memset(stats, 0, sizeof(EVEL_MEM_STATS));
+  for (line = buffer; line != NULL && *line != '\0'; )
+  {
+    colon = strchr(line, ':');
+    if (colon == NULL)
+    {
+      break;
+    }
+    name_len = colon - line;
+
+    field = NULL;
+    if (name_len == 8 && strncmp(line, "MemTotal", 8) == 0)
+    {
+      field = &stats->total;
+    }
+    else if (name_len == 7 && strncmp(line, "MemFree", 7) == 0)
+    {
+      field = &stats->free;
+    }
+    else if (name_len == 7 && strncmp(line, "Buffers", 7) == 0)
+    {
+      field = &stats->buffers;
+    }
+    else if (name_len == 6 && strncmp(line, "Cached", 6) == 0)
+    {
+      field = &stats->cached;
+    }
+    else if (name_len == 12 && strncmp(line, "SReclaimable", 12) == 0)
+    {
+      field = &stats->slab_reclaimable;
+    }
+    else if (name_len == 10 && strncmp(line, "SUnreclaim", 10) == 0)
+    {
+      field = &stats->slab_unreclaimable;
+    }
+
+    if (field != NULL)
+    {
+      value = 0;
+      for (line = colon + 1; *line == ' '; line++)
+      {
+      }
+      for (; *line >= '0' && *line <= '9'; line++)
+      {
+        value = value * 10 + (*line - '0');
+      }
+      *field = value;
+    }
+
+    line = strchr(colon, '\n');
+    if (line != NULL)
+    {
+      line++;
+    }
+  }
+
+  if (stats->total == 0)
+  {
+    log_error_state("No MemTotal in %s", file);
+    rc = EVEL_ERR_GEN_FAIL;
+  }
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Add a Memory Use to a Measurement.
+ *
+ * Used memory is the total less free, buffers, page cache and slab, as the
+ * VES schema defines it.
+ *
+ * @param measurement   Pointer to the Measurement.
+ * @param stats         The figures from evel_memstats_read_procfs().
+ * @param id            ASCIIZ identifier for the memory.
+ * @param vm_id         ASCIIZ identifier of the VM.
+ *****************************************************************************/
+void evel_memstats_measurement_add(EVENT_MEASUREMENT * const measurement,
+                                   const EVEL_MEM_STATS * const stats,
+                                   const char * const id,
+                                   const char * const vm_id)
+{
+  MEASUREMENT_MEM_USE * mem_use;
+  unsigned long long unused;
+  unsigned long long used = 0;
+
+  EVEL_ENTER();
+
+  assert(measurement != NULL);
+  assert(stats != NULL);
+  assert(id != NULL);
+  assert(vm_id != NULL);
+
+  unused = stats->free + stats->buffers + stats->cached +
+           stats->slab_reclaimable + stats->slab_unreclaimable;
+  if (stats->total > unused)
+  {
+    used = stats->total - unused;
+  }
+
+  mem_use = evel_measurement_new_mem_use_add(measurement,
+                                             (char *) id,
+                                             (char *) vm_id,
+                                             (double) stats->buffers);
+  evel_measurement_mem_use_memconfig_set(mem_use, (double) stats->total);
+  evel_measurement_mem_use_memfree_set(mem_use, (double) stats->free);
+  evel_measurement_mem_use_memcache_set(mem_use, (double) stats->cached);
+  evel_measurement_mem_use_slab_reclaimed_set(
+                                   mem_use, (double) stats->slab_reclaimable);
+  evel_measurement_mem_use_slab_unreclaimable_set(
+                                 mem_use, (double) stats->slab_unreclaimable);
+  evel_measurement_mem_use_usedup_set(mem_use, (double) used);
+
+  EVEL_EXIT();
+}
@@ -0,0 +1,785 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * A registry of counters and gauges in shared memory.
+ *
+ * An application creates the registry, a file normally on /dev/shm, and
+ * updates its metrics in place with atomic operations, so an update is a
+ * single instruction with no system call.  A reporter maps the same file
+ * read-only and copies every value in one pass.
+ *
+ * The file is laid out as:
+ *  - an ::EVEL_METRICS_HEADER, identifying the layout and its version;
+ *  - the name index, one ::EVEL_METRICS_ENTRY for each metric that may be
+ *    added;
+ *  - the values, one ::EVEL_METRIC per metric, each on its own cache line so
+ *    that metrics updated from different CPUs do not contend.
+ *
+ * Metrics are only ever added, never removed.  The header's sequence is a
+ * seqlock over the index: it is odd while a metric is being added, and a
+ * reader which sees it change during its pass tries again.  Each value is
+ * read with a single atomic load.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Identifies a registry file, and the version of its layout.                */
+/*****************************************************************************/
+#define EVEL_METRICS_MAGIC 0x45564d52
+#define EVEL_METRICS_VERSION 1
+
+/*****************************************************************************/
+/* Size of a cache line, to which the header and each value are aligned.     */
+/*****************************************************************************/
+#define EVEL_METRICS_LINE 64
+
+/*****************************************************************************/
+/* Number of times a reader retries a pass interrupted by a metric being     */
+/* added before giving up.                                                   */
+/*****************************************************************************/
+#define EVEL_METRICS_MAX_RETRIES 1000
+
+/*****************************************************************************/
+/* Space for a value formatted for a custom measurement.                     */
+/*****************************************************************************/
+#define EVEL_METRICS_VALUE_LEN 32
+
+/**************************************************************************//**
+ * The registry header, at the start of the file.  The offsets are from the
+ * start of the file.
+ *****************************************************************************/
+typedef struct evel_metrics_header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t max_metrics;
+  uint32_t num_metrics;
+  uint64_t sequence;
+  uint64_t entries_offset;
+  uint64_t values_offset;
+  uint64_t size;
+} __attribute__((aligned(EVEL_METRICS_LINE))) EVEL_METRICS_HEADER;
+
+/**************************************************************************//**
+ * A metric's entry in the name index.  Its value is at the same index.
+ *****************************************************************************/
+typedef struct evel_metrics_entry {
+  char group[EVEL_METRICS_GROUP_LEN];
+  char name[EVEL_METRICS_NAME_LEN];
+  uint32_t type;
+} EVEL_METRICS_ENTRY;
+
+/**************************************************************************//**
+ * A metric's value: a counter, or the bits of a gauge's double.
+ *****************************************************************************/
+struct evel_metric {
+  uint64_t value;
+} __attribute__((aligned(EVEL_METRICS_LINE)));
+
+/**************************************************************************//**
+ * A registry, as created by an application or opened by a reporter.  A
+ * reporter maps the file when it is first read, and again whenever it has
+ * been recreated.  The layout is copied from the header once it has been
+ * checked, so that the header changing later cannot move a reader outside
+ * the mapping.
+ *****************************************************************************/
+struct evel_metrics {
+  char * path;
+  bool writer;
+  EVEL_METRICS_HEADER * header;
+  size_t size;
+  uint32_t max_metrics;
+  uint64_t entries_offset;
+  uint64_t values_offset;
+  dev_t dev;
+  ino_t ino;
+  EVEL_METRIC_VALUE * values;
+  pthread_mutex_t mutex;
+};
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static EVEL_METRICS * evel_metrics_alloc(const char * const path,
+                                         const bool writer);
+static void evel_metrics_unmap(EVEL_METRICS * const metrics);
+static void evel_metrics_remap(EVEL_METRICS * const metrics);
+static EVEL_METRICS_ENTRY * evel_metrics_entries(
+                                        const EVEL_METRICS * const metrics);
+static EVEL_METRIC * evel_metrics_values(const EVEL_METRICS * const metrics);
+
+/**************************************************************************//**
+ * Create a registry for an application to add metrics to, replacing any
+ * existing registry at the same path.
+ *
+ * @param path          The file, normally on /dev/shm.
+ * @param max_metrics   The number of metrics there is room for.
+ *
+ * @returns pointer to the new registry.
+ * @retval  NULL  The file could not be created.
+ *****************************************************************************/
+EVEL_METRICS * evel_new_metrics(const char * const path,
+                                const int max_metrics)
+{
+  EVEL_METRICS * metrics = NULL;
+  EVEL_METRICS_HEADER * header;
+  size_t entries_offset;
+  size_t values_offset;
+  size_t size;
+  struct stat st;
+  int fd = -1;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(path != NULL);
+  assert(max_metrics > 0);
+
+  entries_offset = sizeof(EVEL_METRICS_HEADER);
+  values_offset = entries_offset + max_metrics * sizeof(EVEL_METRICS_ENTRY);
+  values_offset = (values_offset + EVEL_METRICS_LINE - 1) &
+                  ~((size_t) EVEL_METRICS_LINE - 1);
+  size = values_offset + max_metrics * sizeof(EVEL_METRIC);
+
+  metrics = evel_metrics_alloc(path, true);
+  if (metrics == NULL)
+  {
+    goto error;
+  }
+
+  /***************************************************************************/
+  /* A new file, rather than the old one truncated, so that a reporter still */
+  /* mapping the old one sees that it has been replaced.                     */
+  /***************************************************************************/
+  if (unlink(path) != 0 && errno != ENOENT)
+  {
+    log_error_state("Failed to remove old metrics registry %s: %s",
+                    path, strerror(errno));
+    goto error;
+  }
+  fd = open(path, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+  if (fd < 0)
+  {
+    log_error_state("Failed to create metrics registry %s: %s",
+                    path, strerror(errno));
+    goto error;
+  }
+  if (ftruncate(fd, size) != 0 || fstat(fd, &st) != 0)
+  {
+    log_error_state("Failed to size metrics registry %s: %s",
+                    path, strerror(errno));
+    goto error;
+  }
+
+  header = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (header == MAP_FAILED)
+  {
+    log_error_state("Failed to map metrics registry %s: %s",
+                    path, strerror(errno));
+    goto error;
+  }
+  close(fd);
+  fd = -1;
+
+  metrics->header = header;
+  metrics->size = size;
+  metrics->max_metrics = max_metrics;
+  metrics->entries_offset = entries_offset;
+  metrics->values_offset = values_offset;
+  metrics->dev = st.st_dev;
+  metrics->ino = st.st_ino;
+
+  /***************************************************************************/
+  /* The file starts zeroed.  The magic number is written last, so that a    */
+  /* reader never sees a partly written header.                              */
+  /***************************************************************************/
+  header->version = EVEL_METRICS_VERSION;
+  header->max_metrics = max_metrics;
+  header->entries_offset = entries_offset;
+  header->values_offset = values_offset;
+  header->size = size;
+  __atomic_store_n(&header->magic, EVEL_METRICS_MAGIC, __ATOMIC_RELEASE);
+  EVEL_INFO("Created metrics registry %s for %d metrics", path, max_metrics);
+
+  EVEL_EXIT();
+
+  return metrics;
+
+error:
+  if (fd >= 0)
+  {
+    close(fd);
+    unlink(path);
+  }
+  evel_free_metrics(metrics);
+
+  EVEL_EXIT();
+
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Open a registry for reading.  The file need not exist yet: it is mapped
+ * when it is first read, and again whenever the application recreates it.
+ *
+ * @param path          The file.
+ *
+ * @returns pointer to the new registry.
+ * @retval  NULL  Failed to allocate the registry.
+ *****************************************************************************/
+EVEL_METRICS * evel_new_metrics_reader(const char * const path)
+{
+  EVEL_METRICS * metrics;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(path != NULL);
+
+  metrics = evel_metrics_alloc(path, false);
+
+  EVEL_EXIT();
+
+  return metrics;
+}
+
+/**************************************************************************//**
+ * Free a registry.  An application's registry file is removed, since its
+ * values are no longer being updated.
+ *
+ * @param metrics       The registry.  May be NULL.
+ *****************************************************************************/
+void evel_free_metrics(EVEL_METRICS * const metrics)
+{
+  EVEL_ENTER();
+
+  if (metrics != NULL)
+  {
+    if (metrics->writer && metrics->header != NULL)
+    {
+      unlink(metrics->path);
+    }
+    evel_metrics_unmap(metrics);
+    pthread_mutex_destroy(&metrics->mutex);
+    free(metrics->path);
+    free(metrics);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Add a metric to an application's registry.  Adding a metric with the same
+ * group and name again returns the same metric.
+ *
+ * @param metrics       The registry.
+ * @param group         ASCIIZ group name, shorter than
+ *                      ::EVEL_METRICS_GROUP_LEN.
+ * @param name          ASCIIZ metric name, shorter than
+ *                      ::EVEL_METRICS_NAME_LEN.
+ * @param type          Whether the metric is a counter or a gauge.
+ *
+ * @returns pointer to the metric, to pass to ::evel_metric_increment or
+ *          ::evel_metric_set.
+ * @retval  NULL  The names are too long, the registry is full, or the
+ *                metric exists with the other type.
+ *****************************************************************************/
+EVEL_METRIC * evel_metrics_add(EVEL_METRICS * const metrics,
+                               const char * const group,
+                               const char * const name,
+                               const EVEL_METRIC_TYPES type)
+{
+  EVEL_METRICS_HEADER * header;
+  EVEL_METRICS_ENTRY * entries;
+  EVEL_METRIC * values;
+  EVEL_METRIC * metric = NULL;
+  uint64_t sequence;
+  uint32_t ii;
+  int pthread_rc;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(metrics != NULL);
+  assert(metrics->writer);
+  assert(group != NULL);
+  assert(name != NULL);
+  assert(type < EVEL_MAX_METRIC_TYPES);
+
+  if (strlen(group) >= EVEL_METRICS_GROUP_LEN ||
+      strlen(name) >= EVEL_METRICS_NAME_LEN)
+  {
+    log_error_state("Metric name too long: %s %s", group, name);
+    goto exit_label;
+  }
+
+  pthread_rc = pthread_mutex_lock(&metrics->mutex);
+  assert(pthread_rc == 0);
+
+  header = metrics->header;
+  entries = evel_metrics_entries(metrics);
+  values = evel_metrics_values(metrics);
+
+  for (ii = 0; ii < header->num_metrics; ii++)
+  {
+    if (strcmp(entries[ii].group, group) == 0 &&
+        strcmp(entries[ii].name, name) == 0)
+    {
+      if (entries[ii].type == (uint32_t) type)
+      {
+        metric = &values[ii];
+      }
+      else
+      {
+        log_error_state("Metric %s %s exists with another type", group, name);
+      }
+      goto unlock;
+    }
+  }
+
+  if (header->num_metrics >= metrics->max_metrics)
+  {
+    log_error_state("Metrics registry %s is full", metrics->path);
+    goto unlock;
+  }
+
+  /***************************************************************************/
+  /* Readers retry a pass that overlaps this.                                */
+  /***************************************************************************/
+  sequence = header->sequence;
+  __atomic_store_n(&header->sequence, sequence + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  strcpy(entries[ii].group, group);
+  strcpy(entries[ii].name, name);
+  entries[ii].type = type;
+  values[ii].value = 0;
+  __atomic_store_n(&header->num_metrics, ii + 1, __ATOMIC_RELEASE);
+
+  __atomic_store_n(&header->sequence, sequence + 2, __ATOMIC_RELEASE);
+  metric = &values[ii];
+  EVEL_DEBUG("Added metric %s %s at %d", group, name, ii);
+
+unlock:
+  pthread_rc = pthread_mutex_unlock(&metrics->mutex);
+  assert(pthread_rc == 0);
+
+exit_label:
+  EVEL_EXIT();
+
+  return metric;
+}
+
+/**************************************************************************//**
+ * Add to a counter.  This is on the application's data path, so is a single
+ * atomic add, without tracing.
+ *
+ * @param metric        The counter.
+ * @param delta         The amount to add.
+ *****************************************************************************/
+void evel_metric_increment(EVEL_METRIC * const metric,
+                           const unsigned long long delta)
+{
+  __atomic_fetch_add(&metric->value, delta, __ATOMIC_RELAXED);
+}
+
+/**************************************************************************//**
+ * Set a gauge.  This is on the application's data path, so is a single
+ * atomic store, without tracing.
+ *
+ * @param metric        The gauge.
+ * @param value         The value.
+ *****************************************************************************/
+void evel_metric_set(EVEL_METRIC * const metric, const double value)
+{
+  uint64_t bits;
+
+  memcpy(&bits, &value, sizeof(bits));
+  __atomic_store_n(&metric->value, bits, __ATOMIC_RELAXED);
+}
+
+/**************************************************************************//**
+ * Read every metric in a registry in one pass.
+ *
+ * @param metrics       The registry.
+ * @param[out] values   Where to store the values.
+ * @param max_values    The number of values there is room for.
+ *
+ * @returns The number of values stored, which is 0 if a reporter's
+ *          registry file does not exist.
+ *****************************************************************************/
+int evel_metrics_snapshot(EVEL_METRICS * const metrics,
+                          EVEL_METRIC_VALUE * const values,
+                          const int max_values)
+{
+  const EVEL_METRICS_HEADER * header;
+  const EVEL_METRICS_ENTRY * entries;
+  const EVEL_METRIC * slots;
+  uint64_t sequence;
+  uint64_t bits;
+  uint32_t num_values = 0;
+  uint32_t ii;
+  int retries;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(metrics != NULL);
+  assert(values != NULL);
+  assert(max_values >= 0);
+
+  if (!metrics->writer)
+  {
+    evel_metrics_remap(metrics);
+  }
+  header = metrics->header;
+  if (header == NULL)
+  {
+    goto exit_label;
+  }
+  entries = evel_metrics_entries(metrics);
+  slots = evel_metrics_values(metrics);
+
+  for (retries = 0; retries < EVEL_METRICS_MAX_RETRIES; retries++)
+  {
+    sequence = __atomic_load_n(&header->sequence, __ATOMIC_ACQUIRE);
+    if (sequence & 1)
+    {
+      continue;
+    }
+
+    num_values = __atomic_load_n(&header->num_metrics, __ATOMIC_ACQUIRE);
+    if (num_values > metrics->max_metrics)
+    {
+      num_values = metrics->max_metrics;
+    }
+    if (num_values > (uint32_t) max_values)
+    {
+      num_values = max_values;
+    }
+
+    for (ii = 0; ii < num_values; ii++)
+    {
+      memcpy(values[ii].group, entries[ii].group, EVEL_METRICS_GROUP_LEN);
+      values[ii].group[EVEL_METRICS_GROUP_LEN - 1] = '\0';
+      memcpy(values[ii].name, entries[ii].name, EVEL_METRICS_NAME_LEN);
+      values[ii].name[EVEL_METRICS_NAME_LEN - 1] = '\0';
+      values[ii].type = (entries[ii].type == EVEL_METRIC_GAUGE) ?
+                        EVEL_METRIC_GAUGE : EVEL_METRIC_COUNTER;
+
+      bits = __atomic_load_n(&slots[ii].value, __ATOMIC_RELAXED);
+      values[ii].counter = bits;
+      memcpy(&values[ii].gauge, &bits, sizeof(values[ii].gauge));
+    }
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&header->sequence, __ATOMIC_RELAXED) == sequence)
+    {
+      goto exit_label;
+    }
+  }
+
+  EVEL_ERROR("Metrics registry %s is being updated, skipped",
+             metrics->path);
+  num_values = 0;
+
+exit_label:
+  EVEL_EXIT();
+
+  return num_values;
+}
+
+/**************************************************************************//**
+ * Add every metric in a registry to a measurement, as a custom measurement
+ * in the metric's group.
+ *
+ * @param metrics       The registry.
+ * @param measurement   The measurement.
+ *
+ * @returns The number of metrics added.
+ *****************************************************************************/
+int evel_metrics_measurement_add(EVEL_METRICS * const metrics,
+                                 EVENT_MEASUREMENT * const measurement)
+{
+  char value[EVEL_METRICS_VALUE_LEN];
+  int num_values = 0;
+  int ii;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(metrics != NULL);
+  assert(measurement != NULL);
+
+  if (!metrics->writer)
+  {
+    evel_metrics_remap(metrics);
+  }
+  if (metrics->header == NULL)
+  {
+    goto exit_label;
+  }
+
+  num_values = evel_metrics_snapshot(metrics,
+                                     metrics->values,
+                                     metrics->max_metrics);
+  for (ii = 0; ii < num_values; ii++)
+  {
+    if (metrics->values[ii].type == EVEL_METRIC_GAUGE)
+    {
+      snprintf(value, sizeof(value), "%.15g", metrics->values[ii].gauge);
+    }
+    else
+    {
+      snprintf(value, sizeof(value), "%llu", metrics->values[ii].counter);
+    }
+    evel_measurement_custom_measurement_add(measurement,
+                                            metrics->values[ii].group,
+                                            metrics->values[ii].name,
+                                            value);
+  }
+
+exit_label:
+  EVEL_EXIT();
+
+  return num_values;
+}
+
+/**************************************************************************//**
+ * Allocate a registry, not yet mapped.
+ *
+ * @param path          The file.
+ * @param writer        Whether it is an application's registry.
+ *
+ * @returns pointer to the registry.
+ * @retval  NULL  Failed to allocate the registry.
+ *****************************************************************************/
+static EVEL_METRICS * evel_metrics_alloc(const char * const path,
+                                         const bool writer)
+{
+  EVEL_METRICS * metrics;
+  int pthread_rc;
+
+  EVEL_ENTER();
+
+  metrics = calloc(1, sizeof(EVEL_METRICS));
+  if (metrics == NULL)
+  {
+    log_error_state("Failed to allocate metrics registry");
+    goto exit_label;
+  }
+  metrics->path = strdup(path);
+  if (metrics->path == NULL)
+  {
+    log_error_state("Failed to allocate metrics registry");
+    free(metrics);
+    metrics = NULL;
+    goto exit_label;
+  }
+  metrics->writer = writer;
+  pthread_rc = pthread_mutex_init(&metrics->mutex, NULL);
+  assert(pthread_rc == 0);
+
+exit_label:
+  EVEL_EXIT();
+
+  return metrics;
+}
+
+/**************************************************************************//**
+ * Unmap a registry's file, if it is mapped.
+ *
+ * @param metrics       The registry.
+ *****************************************************************************/
+static void evel_metrics_unmap(EVEL_METRICS * const metrics)
+{
+  EVEL_ENTER();
+
+  if (metrics->header != NULL)
+  {
+    munmap(metrics->header, metrics->size);
+    metrics->header = NULL;
+    metrics->size = 0;
+  }
+  free(metrics->values);
+  metrics->values = NULL;
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Map a reporter's registry file if it has been created or recreated since
+ * it was last mapped, or unmap it if it has been removed or has shrunk.
+ *
+ * The layout in the header is checked, offset by offset so that no sum can
+ * overflow, before anything beyond the header is read.  An application
+ * never resizes a registry, only replaces it, and a file found to be
+ * smaller than its mapping is unmapped before it is read.  That leaves only
+ * a file truncated during a pass, which raises SIGBUS in the reporter:
+ * registries must be writable only by the applications they trust.
+ *
+ * @param metrics       The registry.
+ *****************************************************************************/
+static void evel_metrics_remap(EVEL_METRICS * const metrics)
+{
+  EVEL_METRICS_HEADER * header = MAP_FAILED;
+  struct stat st;
+  uint32_t max_metrics;
+  uint64_t entries_offset;
+  uint64_t values_offset;
+  uint64_t size;
+  int fd = -1;
+
+  EVEL_ENTER();
+
+  if (stat(metrics->path, &st) != 0)
+  {
+    evel_metrics_unmap(metrics);
+    goto exit_label;
+  }
+  if (metrics->header != NULL &&
+      st.st_dev == metrics->dev && st.st_ino == metrics->ino &&
+      st.st_size >= (off_t) metrics->size)
+  {
+    goto exit_label;
+  }
+  evel_metrics_unmap(metrics);
+
+  fd = open(metrics->path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0 || fstat(fd, &st) != 0 ||
+      st.st_size < (off_t) sizeof(EVEL_METRICS_HEADER))
+  {
+    goto exit_label;
+  }
+  header = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  if (header == MAP_FAILED)
+  {
+    EVEL_ERROR("Failed to map metrics registry %s: %s",
+               metrics->path, strerror(errno));
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* The application may not have finished writing the header yet, in which  */
+  /* case we try again next time.                                            */
+  /***************************************************************************/
+  if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != EVEL_METRICS_MAGIC)
+  {
+    goto unmap;
+  }
+
+  /***************************************************************************/
+  /* Read the layout once, and check that the index and the values each fit  */
+  /* in the file, in that order, with the values on cache lines.             */
+  /***************************************************************************/
+  max_metrics = __atomic_load_n(&header->max_metrics, __ATOMIC_RELAXED);
+  entries_offset = __atomic_load_n(&header->entries_offset, __ATOMIC_RELAXED);
+  values_offset = __atomic_load_n(&header->values_offset, __ATOMIC_RELAXED);
+  size = __atomic_load_n(&header->size, __ATOMIC_RELAXED);
+  if (header->version != EVEL_METRICS_VERSION ||
+      size > (uint64_t) st.st_size ||
+      entries_offset < sizeof(EVEL_METRICS_HEADER) ||
+      entries_offset % EVEL_METRICS_LINE != 0 ||
+      values_offset % EVEL_METRICS_LINE != 0 ||
+      entries_offset > values_offset ||
+      values_offset > size ||
+      max_metrics > (values_offset - entries_offset) /
+                                                 sizeof(EVEL_METRICS_ENTRY) ||
+      max_metrics > (size - values_offset) / sizeof(EVEL_METRIC))
+  {
+    EVEL_ERROR("Metrics registry %s has an unknown layout", metrics->path);
+    goto unmap;
+  }
+
+  metrics->values = calloc(max_metrics, sizeof(EVEL_METRIC_VALUE));
+  if (metrics->values == NULL)
+  {
+    log_error_state("Failed to allocate metrics registry values");
+    goto unmap;
+  }
+  metrics->header = header;
+  metrics->size = st.st_size;
+  metrics->max_metrics = max_metrics;
+  metrics->entries_offset = entries_offset;
+  metrics->values_offset = values_offset;
+  metrics->dev = st.st_dev;
+  metrics->ino = st.st_ino;
+  EVEL_INFO("Mapped metrics registry %s", metrics->path);
+  goto exit_label;
+
+unmap:
+  munmap(header, st.st_size);
+
+exit_label:
+  if (fd >= 0)
+  {
+    close(fd);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Find a registry's name index.
+ *
+ * @param metrics       The registry, which must be mapped.
+ *
+ * @returns pointer to the first entry.
+ *****************************************************************************/
+static EVEL_METRICS_ENTRY * evel_metrics_entries(
+                                         const EVEL_METRICS * const metrics)
+{
+  return (EVEL_METRICS_ENTRY *) ((char *) metrics->header +
+                                 metrics->entries_offset);
+}
+
+/**************************************************************************//**
+ * Find a registry's values.
+ *
+ * @param metrics       The registry, which must be mapped.
+ *
+ * @returns pointer to the first value.
+ *****************************************************************************/
+static EVEL_METRIC * evel_metrics_values(const EVEL_METRICS * const metrics)
+{
+  return (EVEL_METRIC *) ((char *) metrics->header + metrics->values_offset);
+}
@@ -0,0 +1,541 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Running batches of reporter probe commands in parallel.
+ *
+ * The reporters used to popen() each command for each link in turn and
+ * wait for it, so an interval's collection took the sum of every command's
+ * run time.  Here the commands of a batch are started with posix_spawn(),
+ * up to a limit at a time, each in its own process group so that a whole
+ * pipeline can be killed if it overruns.  Their output comes back through
+ * non-blocking pipes, all watched by one epoll set, keeping only the last
+ * line of each as popen() and fgets() did.
+ *
+ * The pipes are close-on-exec, so that other threads starting processes at
+ * the same time cannot hold a write end open and delay end of file.
+ ****************************************************************************/
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/wait.h>
+
+#include "evel.h"
+
+extern char ** environ;
+
+/*****************************************************************************/
+/* How much output to read at once.                                          */
+/*****************************************************************************/
+#define EVEL_PROBE_READ_SIZE 4096
+
+/*****************************************************************************/
+/* How often to look for a process that has closed its output but not yet    */
+/* exited, in milliseconds.                                                  */
+/*****************************************************************************/
+#define EVEL_PROBE_REAP_INTERVAL 5
+
+/**************************************************************************//**
+ * A running command.  The fd is -1 once its output has ended, while it is
+ * waited for.
+ *****************************************************************************/
+typedef struct evel_probe_worker {
+  EVEL_PROBE * probe;
+  pid_t pid;
+  int fd;
+  unsigned long long deadline;
+  char * line;                /** The line being read.                       */
+  size_t line_length;
+} EVEL_PROBE_WORKER;
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static int evel_probe_start(EVEL_PROBE_WORKER * worker,
+                            EVEL_PROBE * probe,
+                            int epoll_fd);
+static void evel_probe_read(EVEL_PROBE_WORKER * worker, int epoll_fd);
+static void evel_probe_line(EVEL_PROBE_WORKER * worker);
+static int evel_probe_reap(pid_t pid, int * status, int options);
+static void evel_probe_finish(EVEL_PROBE_WORKER * worker,
+                              int status,
+                              EVEL_PROBE_STATES state);
+
+/**************************************************************************//**
+ * Run a batch of probes, at most @p max_workers at a time.
+ *
+ * @param probes    The probes.
+ * @param num_probes  Number of probes.
+ * @param snapshot  Interface counters, or NULL to always use the shell.
+ * @param max_workers  Most commands to run at once.
+ * @param timeout_ms  Longest each command may run, in milliseconds.
+ * @param stats     Where to put what the batch cost, or NULL.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS If every probe was run, whatever its result.
+ * @retval  "One of ::EVEL_ERR_CODES" If the batch could not be run.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_probe_run(EVEL_PROBE * const probes,
+                              const int num_probes,
+                              const EVEL_IF_SNAPSHOT * const snapshot,
+                              const int max_workers,
+                              const int timeout_ms,
+                              EVEL_PROBE_STATS * const stats)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  EVEL_PROBE_STATS batch;
+  EVEL_PROBE_WORKER * workers = NULL;
+  EVEL_PROBE_WORKER * worker;
+  struct epoll_event * events = NULL;
+  EVEL_PROBE * probe;
+  unsigned long long start;
+  unsigned long long now;
+  unsigned long long wait;
+  size_t line_size = 1;
+  int epoll_fd = -1;
+  int next = 0;
+  int running = 0;
+  int reaping;
+  int num_events;
+  int status;
+  int ii;
+
+  EVEL_ENTER();
+
+  assert(num_probes == 0 || probes != NULL);
+  assert(max_workers > 0);
+  assert(timeout_ms > 0);
+
+  memset(&batch, 0, sizeof(batch));
+  batch.num_probes = num_probes;
+  start = evel_time_monotonic_usec();
+
+  for (ii = 0; ii < num_probes; ii++)
+  {
+    assert(probes[ii].command != NULL);
+    assert(probes[ii].result != NULL && probes[ii].result_size > 0);
+    if (probes[ii].result_size > line_size)
+    {
+      line_size = probes[ii].result_size;
+    }
+  }
+
+  workers = calloc(max_workers, sizeof(EVEL_PROBE_WORKER));
+  events = calloc(max_workers, sizeof(struct epoll_event));
+  if (workers == NULL || events == NULL)
+  {
+    log_error_state("Failed to allocate probe workers");
+    rc = EVEL_OUT_OF_MEMORY;
+    goto exit_label;
+  }
+  for (ii = 0; ii < max_workers; ii++)
+  {
+    workers[ii].fd = -1;
+    workers[ii].line = malloc(line_size);
+    if (workers[ii].line == NULL)
+    {
+      log_error_state("Failed to allocate probe workers");
+      rc = EVEL_OUT_OF_MEMORY;
+      goto exit_label;
+    }
+  }
+
+  epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd < 0)
+  {
+    log_error_state("Failed to create epoll: %s", strerror(errno));
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  while (next < num_probes || running > 0)
+  {
+    /*************************************************************************/
+    /* Answer what can be answered natively, and start commands while there  */
+    /* are workers free.                                                     */
+    /*************************************************************************/
+    for (ii = 0; ii < max_workers && next < num_probes; ii++)
+    {
+      if (workers[ii].probe != NULL)
+      {
+        continue;
+      }
+      probe = &probes[next++];
+      probe->result[0] = '\0';
+      probe->exit_status = 0;
+
+      if (probe->command->type == EVEL_COMMAND_IF_STATS && snapshot != NULL)
+      {
+        probe->state = (evel_command_run(probe->command,
+                                         probe->values,
+                                         snapshot,
+                                         probe->result,
+                                         probe->result_size) == EVEL_SUCCESS) ?
+                                      EVEL_PROBE_SUCCESS : EVEL_PROBE_FAILED;
+        batch.num_native++;
+        ii--;
+        continue;
+      }
+
+      if (evel_probe_start(&workers[ii], probe, epoll_fd) != 0)
+      {
+        probe->state = EVEL_PROBE_FAILED;
+        ii--;
+        continue;
+      }
+      workers[ii].deadline = evel_time_monotonic_usec() +
+                             (unsigned long long) timeout_ms * 1000;
+      running++;
+    }
+    if (running == 0)
+    {
+      continue;
+    }
+
+    /*************************************************************************/
+    /* Wait for output, or until the next deadline.                          */
+    /*************************************************************************/
+    now = evel_time_monotonic_usec();
+    wait = (unsigned long long) timeout_ms * 1000;
+    reaping = 0;
+    for (ii = 0; ii < max_workers; ii++)
+    {
+      worker = &workers[ii];
+      if (worker->probe == NULL)
+      {
+        continue;
+      }
+      if (worker->fd < 0)
+      {
+        reaping = 1;
+      }
+      if (worker->deadline <= now)
+      {
+        wait = 0;
+      }
+      else if (worker->deadline - now < wait)
+      {
+        wait = worker->deadline - now;
+      }
+    }
+    wait = (wait + 999) / 1000;
+    if (reaping && wait > EVEL_PROBE_REAP_INTERVAL)
+    {
+      wait = EVEL_PROBE_REAP_INTERVAL;
+    }
+
+    num_events = epoll_wait(epoll_fd, events, max_workers, (int) wait);
+    for (ii = 0; ii < num_events; ii++)
+    {
+      evel_probe_read((EVEL_PROBE_WORKER *) events[ii].data.ptr, epoll_fd);
+    }
+
+    /*************************************************************************/
+    /* Collect the commands that have finished, and kill those overrunning.  */
+    /*************************************************************************/
+    now = evel_time_monotonic_usec();
+    for (ii = 0; ii < max_workers; ii++)
+    {
+      worker = &workers[ii];
+      if (worker->probe == NULL)
+      {
+        continue;
+      }
+      if (worker->fd < 0 && evel_probe_reap(worker->pid, &status, WNOHANG))
+      {
+        evel_probe_finish(worker,
+                          status,
+                          (WIFEXITED(status) && WEXITSTATUS(status) == 0) ?
+                                      EVEL_PROBE_SUCCESS : EVEL_PROBE_FAILED);
+        running--;
+      }
+      else if (worker->deadline <= now)
+      {
+        EVEL_ERROR("Probe timed out after %dms: %s",
+                   timeout_ms, worker->probe->command->text);
+        kill(-worker->pid, SIGKILL);
+        if (worker->fd >= 0)
+        {
+          epoll_ctl(epoll_fd, EPOLL_CTL_DEL, worker->fd, NULL);
+          close(worker->fd);
+          worker->fd = -1;
+        }
+        evel_probe_reap(worker->pid, &status, 0);
+        evel_probe_finish(worker, status, EVEL_PROBE_TIMED_OUT);
+        running--;
+      }
+    }
+  }
+
+  for (ii = 0; ii < num_probes; ii++)
+  {
+    if (probes[ii].state == EVEL_PROBE_FAILED)
+    {
+      batch.num_failed++;
+    }
+    else if (probes[ii].state == EVEL_PROBE_TIMED_OUT)
+    {
+      batch.num_timed_out++;
+    }
+  }
+
+exit_label:
+  if (epoll_fd >= 0)
+  {
+    close(epoll_fd);
+  }
+  if (workers != NULL)
+  {
+    for (ii = 0; ii < max_workers; ii++)
+    {
+      free(workers[ii].line);
+    }
+  }
+  free(workers);
+  free(events);
+
+  batch.runtime = evel_time_monotonic_usec() - start;
+  if (stats != NULL)
+  {
+    *stats = batch;
+  }
+
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Start a probe's command through the shell.
+ *
+ * @param worker    A free worker, which is given the command.
+ * @param probe     The probe.
+ * @param epoll_fd  The epoll set to add the command's output to.
+ *
+ * @returns 0 on success, -1 if the command could not be started.
+ *****************************************************************************/
+static int evel_probe_start(EVEL_PROBE_WORKER * worker,
+                            EVEL_PROBE * probe,
+                            int epoll_fd)
+{
+  posix_spawn_file_actions_t actions;
+  posix_spawnattr_t attributes;
+  struct epoll_event event;
+  sigset_t signals;
+  char * argv[4];
+  char * buffer;
+  char empty[1];
+  size_t length;
+  int fds[2];
+  int result = -1;
+  int error;
+
+  length = evel_command_render(probe->command, probe->values, empty, 1);
+  buffer = malloc(length + 1);
+  if (buffer == NULL)
+  {
+    log_error_state("Failed to allocate command");
+    return -1;
+  }
+  evel_command_render(probe->command, probe->values, buffer, length + 1);
+
+  /***************************************************************************/
+  /* Only our end of the pipe is non-blocking; the command's stdout is left  */
+  /* as it expects.                                                          */
+  /***************************************************************************/
+  if (pipe2(fds, O_CLOEXEC) != 0)
+  {
+    log_error_state("Failed to create pipe: %s", strerror(errno));
+    free(buffer);
+    return -1;
+  }
+  fcntl(fds[0], F_SETFL, O_NONBLOCK);
+
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_addopen(&actions, 0, "/dev/null", O_RDONLY, 0);
+  posix_spawn_file_actions_adddup2(&actions, fds[1], 1);
+
+  posix_spawnattr_init(&attributes);
+  posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP |
+                                        POSIX_SPAWN_SETSIGMASK |
+                                        POSIX_SPAWN_SETSIGDEF);
+  posix_spawnattr_setpgroup(&attributes, 0);
+  sigemptyset(&signals);
+  posix_spawnattr_setsigmask(&attributes, &signals);
+  sigaddset(&signals, SIGPIPE);
+  posix_spawnattr_setsigdefault(&attributes, &signals);
+
+  argv[0] = "sh";
+  argv[1] = "-c";
+  argv[2] = buffer;
+  argv[3] = NULL;
+  error = posix_spawn(&worker->pid, "/bin/sh", &actions, &attributes,
+                      argv, environ);
+  posix_spawn_file_actions_destroy(&actions);
+  posix_spawnattr_destroy(&attributes);
+  close(fds[1]);
+  if (error != 0)
+  {
+    log_error_state("Failed to start %s: %s", buffer, strerror(error));
+    close(fds[0]);
+    goto exit_label;
+  }
+
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN;
+  event.data.ptr = worker;
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fds[0], &event) != 0)
+  {
+    log_error_state("Failed to watch %s: %s", buffer, strerror(errno));
+    kill(-worker->pid, SIGKILL);
+    close(fds[0]);
+    evel_probe_reap(worker->pid, &error, 0);
+    goto exit_label;
+  }
+
+  worker->probe = probe;
+  worker->fd = fds[0];
+  worker->line_length = 0;
+  result = 0;
+
+exit_label:
+  free(buffer);
+  return result;
+}
+
+/**************************************************************************//**
+ * Read what a command has written, keeping the last line.
+ *
+ * @param worker    The worker running the command.
+ * @param epoll_fd  The epoll set, which the output is removed from when it
+ *                  ends.
+ *****************************************************************************/
+static void evel_probe_read(EVEL_PROBE_WORKER * worker, int epoll_fd)
+{
+  char buffer[EVEL_PROBE_READ_SIZE];
+  size_t space = worker->probe->result_size - 1;
+  ssize_t bytes;
+  ssize_t ii;
+
+  for (;;)
+  {
+    bytes = read(worker->fd, buffer, sizeof(buffer));
+    if (bytes < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (bytes < 0 && errno == EAGAIN)
+    {
+      return;
+    }
+    if (bytes <= 0)
+    {
+      break;
+    }
+
+    for (ii = 0; ii < bytes; ii++)
+    {
+      if (buffer[ii] == '\n')
+      {
+        evel_probe_line(worker);
+      }
+      else if (worker->line_length < space)
+      {
+        worker->line[worker->line_length++] = buffer[ii];
+      }
+    }
+  }
+
+  /***************************************************************************/
+  /* End of output, or an error reading it, which is treated the same.       */
+  /***************************************************************************/
+  if (worker->line_length > 0)
+  {
+    evel_probe_line(worker);
+  }
+  epoll_ctl(epoll_fd, EPOLL_CTL_DEL, worker->fd, NULL);
+  close(worker->fd);
+  worker->fd = -1;
+}
+
+/**************************************************************************//**
+ * Make the line just read the probe's result.
+ *
+ * @param worker    The worker running the command.
+ *****************************************************************************/
+static void evel_probe_line(EVEL_PROBE_WORKER * worker)
+{
+  memcpy(worker->probe->result, worker->line, worker->line_length);
+  worker->probe->result[worker->line_length] = '\0';
+  worker->line_length = 0;
+}
+
+/**************************************************************************//**
+ * Wait for a command to exit.
+ *
+ * @param pid       The command's process.
+ * @param status    Where to put its status, or -1 if it cannot be waited
+ *                  for, as when something else has already reaped it.
+ * @param options   Options for waitpid().
+ *
+ * @returns Non-zero if the command has gone.
+ *****************************************************************************/
+static int evel_probe_reap(pid_t pid, int * status, int options)
+{
+  pid_t result;
+
+  do
+  {
+    result = waitpid(pid, status, options);
+  } while (result < 0 && errno == EINTR);
+
+  if (result < 0)
+  {
+    *status = -1;
+  }
+  return result != 0;
+}
+
+/**************************************************************************//**
+ * Record how a probe ended, and free its worker.
+ *
+ * @param worker    The worker running the command.
+ * @param status    Status from waitpid().
+ * @param state     How the probe ended.
+ *****************************************************************************/
+static void evel_probe_finish(EVEL_PROBE_WORKER * worker,
+                              int status,
+                              EVEL_PROBE_STATES state)
+{
+  worker->probe->state = state;
+  worker->probe->exit_status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+  if (state == EVEL_PROBE_FAILED)
+  {
+    EVEL_DEBUG("Probe exited with status %d: %s",
+               worker->probe->exit_status, worker->probe->command->text);
+  }
+  worker->probe = NULL;
+}
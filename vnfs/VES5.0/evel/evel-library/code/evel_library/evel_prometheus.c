@@ -0,0 +1,1063 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Prometheus endpoint: the latest measurement values, for scraping.
+ *
+ * As each measurement is encoded for the collector, the numeric fields of
+ * the measurement and of its identified objects, such as CPUs and vNICs,
+ * are written to a table of series.  Series are only ever added: a new
+ * series is filled in before the count of series is published, and its
+ * name and labels never change after, so that its value is the only part
+ * updated, with a single atomic store.
+ *
+ * A thread of the endpoint's own accepts HTTP connections, and answers each
+ * scrape of /metrics by reading the published series without locking,
+ * sorting them into families and rendering them in the Prometheus text
+ * format, after the library's own counters.  Neither the threads posting
+ * events nor the event handler ever wait for a scrape.  Scrapes are served
+ * one at a time, with a timeout, so a slow scraper only delays the others.
+ ****************************************************************************/
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#include "evel.h"
+#include "evel_internal.h"
+#include "hashtable.h"
+
+/*****************************************************************************/
+/* Space for a metric name, size of the index of series, most of a request   */
+/* that is read, and how long a scraper has to send its request and read     */
+/* the response, in seconds.                                                 */
+/*****************************************************************************/
+#define EVEL_PROMETHEUS_NAME_LEN 64
+#define EVEL_PROMETHEUS_HASH_SIZE 1024
+#define EVEL_PROMETHEUS_REQUEST_LEN 1024
+#define EVEL_PROMETHEUS_TIMEOUT 5
+
+/*****************************************************************************/
+/* Initial size of the rendered text, which grows as needed.                 */
+/*****************************************************************************/
+#define EVEL_PROMETHEUS_TEXT_SIZE 65536
+
+/*****************************************************************************/
+/* Content type of the Prometheus text format.                               */
+/*****************************************************************************/
+#define EVEL_PROMETHEUS_CONTENT_TYPE "text/plain; version=0.0.4; charset=utf-8"
+
+/**************************************************************************//**
+ * A series: a metric name and labels, and the bits of its latest value.
+ *****************************************************************************/
+typedef struct evel_prometheus_series {
+  char name[EVEL_PROMETHEUS_NAME_LEN];
+  char labels[EVEL_PROMETHEUS_LABELS_LEN];
+  uint64_t value;
+} EVEL_PROMETHEUS_SERIES;
+
+/**************************************************************************//**
+ * The endpoint.
+ *
+ * The index, mapping each series' name and labels to its position, is only
+ * used by encoders, which hold the mutex.  The server thread reads the
+ * first num_series series, and owns the working storage for a scrape.
+ *****************************************************************************/
+struct evel_prometheus {
+  EVEL_PROMETHEUS_SERIES * series;
+  HASHTABLE_T * index;
+  int num_series;
+  unsigned long long series_dropped;
+
+  int socket;
+  int stop_fd;
+  pthread_t thread;
+  unsigned long long scrapes;
+
+  const EVEL_PROMETHEUS_SERIES ** order;
+  char * text;
+  size_t text_size;
+  size_t text_length;
+};
+
+/*****************************************************************************/
+/* The running endpoint, or NULL.                                            */
+/*****************************************************************************/
+static EVEL_PROMETHEUS * evel_prometheus = NULL;
+
+/*****************************************************************************/
+/* Mutex protecting the pointer to the endpoint and its index, held while an */
+/* event is being encoded.  The server thread never takes it.                */
+/*****************************************************************************/
+static pthread_mutex_t evel_prometheus_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static void evel_prometheus_free(EVEL_PROMETHEUS * const prometheus);
+static bool evel_prometheus_label(char * const labels,
+                                  const size_t size,
+                                  const char * const name,
+                                  const char * const value);
+static void evel_prometheus_set(EVEL_PROMETHEUS * const prometheus,
+                                const char * const key,
+                                const char * const labels,
+                                const double value);
+static void * evel_prometheus_server(void * arg);
+static bool evel_prometheus_send(const int fd,
+                                 const char * data,
+                                 size_t length);
+static void evel_prometheus_serve(EVEL_PROMETHEUS * const prometheus,
+                                  const int fd);
+static bool evel_prometheus_append(EVEL_PROMETHEUS * const prometheus,
+                                   const char * const format, ...)
+  __attribute__ ((format (printf, 2, 3)));
+static bool evel_prometheus_counter(EVEL_PROMETHEUS * const prometheus,
+                                    const char * const name,
+                                    const char * const help,
+                                    const unsigned long long value);
+static int evel_prometheus_compare(const void * a, const void * b);
+static bool evel_prometheus_render(EVEL_PROMETHEUS * const prometheus);
+
+/**************************************************************************//**
+ * Start serving the latest value of every numeric measurement field, and
+ * the library's own counters, over HTTP in the Prometheus text format.
+ *
+ * @param address   Address to listen on, or NULL for all addresses.
+ * @param port      TCP port to listen on.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success.
+ * @retval  EVEL_OUT_OF_MEMORY The endpoint could not be allocated.
+ * @retval  EVEL_PTHREAD_LIBRARY_FAIL The server thread could not be started.
+ * @retval  EVEL_ERR_GEN_FAIL The endpoint is already running, or could not
+ *                            listen on the port.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_prometheus_start(const char * const address,
+                                     const int port)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  EVEL_PROMETHEUS * prometheus = NULL;
+  struct addrinfo hints;
+  struct addrinfo * addresses = NULL;
+  struct addrinfo * ai;
+  char service[16];
+  bool running;
+  int on = 1;
+  int error;
+  int fd;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(port > 0 && port < 65536);
+
+  pthread_mutex_lock(&evel_prometheus_mutex);
+  running = (evel_prometheus != NULL);
+  pthread_mutex_unlock(&evel_prometheus_mutex);
+  if (running)
+  {
+    rc = EVEL_ERR_GEN_FAIL;
+    log_error_state("Prometheus endpoint is already running");
+    goto exit_label;
+  }
+
+  prometheus = calloc(1, sizeof(EVEL_PROMETHEUS));
+  if (prometheus == NULL)
+  {
+    rc = EVEL_OUT_OF_MEMORY;
+    log_error_state("Failed to allocate Prometheus endpoint");
+    goto exit_label;
+  }
+  prometheus->socket = -1;
+  prometheus->stop_fd = -1;
+
+  prometheus->series = calloc(EVEL_PROMETHEUS_MAX_SERIES,
+                              sizeof(EVEL_PROMETHEUS_SERIES));
+  prometheus->order = calloc(EVEL_PROMETHEUS_MAX_SERIES,
+                             sizeof(EVEL_PROMETHEUS_SERIES *));
+  prometheus->text = malloc(EVEL_PROMETHEUS_TEXT_SIZE);
+  prometheus->text_size = EVEL_PROMETHEUS_TEXT_SIZE;
+  prometheus->index = ht_create(EVEL_PROMETHEUS_HASH_SIZE);
+  if ((prometheus->series == NULL) ||
+      (prometheus->order == NULL) ||
+      (prometheus->text == NULL) ||
+      (prometheus->index == NULL))
+  {
+    rc = EVEL_OUT_OF_MEMORY;
+    log_error_state("Failed to allocate Prometheus series");
+    goto exit_label;
+  }
+
+  prometheus->stop_fd = eventfd(0, EFD_CLOEXEC);
+  if (prometheus->stop_fd < 0)
+  {
+    rc = EVEL_ERR_GEN_FAIL;
+    log_error_state("Failed to create Prometheus stop event: %s",
+                    strerror(errno));
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Listen on the first address which can be bound.  The listening socket   */
+  /* is non-blocking, so that a connection which goes away before it is      */
+  /* accepted cannot stall the server.                                       */
+  /***************************************************************************/
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_PASSIVE | AI_NUMERICSERV;
+  snprintf(service, sizeof(service), "%d", port);
+
+  error = getaddrinfo(address, service, &hints, &addresses);
+  if (error != 0)
+  {
+    rc = EVEL_ERR_GEN_FAIL;
+    log_error_state("Failed to resolve %s: %s",
+                    (address != NULL) ? address : "*", gai_strerror(error));
+    goto exit_label;
+  }
+
+  for (ai = addresses; ai != NULL; ai = ai->ai_next)
+  {
+    fd = socket(ai->ai_family,
+                ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                ai->ai_protocol);
+    if (fd < 0)
+    {
+      continue;
+    }
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    if ((bind(fd, ai->ai_addr, ai->ai_addrlen) == 0) &&
+        (listen(fd, SOMAXCONN) == 0))
+    {
+      prometheus->socket = fd;
+      break;
+    }
+    EVEL_ERROR("Failed to listen on Prometheus port %d: %s",
+               port, strerror(errno));
+    close(fd);
+  }
+
+  if (prometheus->socket < 0)
+  {
+    rc = EVEL_ERR_GEN_FAIL;
+    log_error_state("Failed to listen on Prometheus port %d", port);
+    goto exit_label;
+  }
+
+  if (pthread_create(&prometheus->thread,
+                     NULL,
+                     evel_prometheus_server,
+                     prometheus) != 0)
+  {
+    rc = EVEL_PTHREAD_LIBRARY_FAIL;
+    log_error_state("Failed to start Prometheus server thread");
+    goto exit_label;
+  }
+
+  pthread_mutex_lock(&evel_prometheus_mutex);
+  evel_prometheus = prometheus;
+  pthread_mutex_unlock(&evel_prometheus_mutex);
+  prometheus = NULL;
+  EVEL_INFO("Serving Prometheus metrics on port %d", port);
+
+exit_label:
+  if (addresses != NULL)
+  {
+    freeaddrinfo(addresses);
+  }
+  evel_prometheus_free(prometheus);
+  EVEL_EXIT();
+
+  return rc;
+}
+
+/**************************************************************************//**
+ * Stop the Prometheus endpoint, if it is running.
+ *****************************************************************************/
+void evel_prometheus_stop(void)
+{
+  EVEL_PROMETHEUS * prometheus;
+  uint64_t value = 1;
+  ssize_t bytes;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Once the endpoint is taken away, no encoder can be using it.            */
+  /***************************************************************************/
+  pthread_mutex_lock(&evel_prometheus_mutex);
+  prometheus = evel_prometheus;
+  evel_prometheus = NULL;
+  pthread_mutex_unlock(&evel_prometheus_mutex);
+
+  if (prometheus != NULL)
+  {
+    bytes = write(prometheus->stop_fd, &value, sizeof(value));
+    assert(bytes == sizeof(value));
+    (void) bytes;
+    pthread_join(prometheus->thread, NULL);
+    evel_prometheus_free(prometheus);
+    EVEL_INFO("Prometheus endpoint stopped");
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Free an endpoint whose server thread is not running.
+ *
+ * @param prometheus    The endpoint, which may be NULL.
+ *****************************************************************************/
+static void evel_prometheus_free(EVEL_PROMETHEUS * const prometheus)
+{
+  if (prometheus == NULL)
+  {
+    return;
+  }
+
+  if (prometheus->socket >= 0)
+  {
+    close(prometheus->socket);
+  }
+  if (prometheus->stop_fd >= 0)
+  {
+    close(prometheus->stop_fd);
+  }
+  ht_destroy(prometheus->index);
+  free(prometheus->text);
+  free(prometheus->order);
+  free(prometheus->series);
+  free(prometheus);
+}
+
+/**************************************************************************//**
+ * Start encoding an event, updating the Prometheus endpoint's series with
+ * its fields if it is a measurement and the endpoint is running.  Must be
+ * paired with ::evel_json_prometheus_end.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param event         Pointer to the ::EVENT_HEADER about to be encoded.
+ *****************************************************************************/
+void evel_json_prometheus_begin(EVEL_JSON_BUFFER * jbuf,
+                                const EVENT_HEADER * const event)
+{
+  int pthread_rc;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(jbuf != NULL);
+  assert(event != NULL);
+
+  pthread_rc = pthread_mutex_lock(&evel_prometheus_mutex);
+  assert(pthread_rc == 0);
+  (void) pthread_rc;
+
+  jbuf->prometheus = NULL;
+  jbuf->prometheus_event[0] = '\0';
+  jbuf->prometheus_objects = 0;
+
+  if ((evel_prometheus == NULL) ||
+      (event->event_domain != EVEL_DOMAIN_MEASUREMENT))
+  {
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Every series of the event is labelled with its name and source.         */
+  /***************************************************************************/
+  if (!evel_prometheus_label(jbuf->prometheus_event,
+                             sizeof(jbuf->prometheus_event),
+                             "event",
+                             (event->event_name != NULL) ?
+                             event->event_name : "") ||
+      !evel_prometheus_label(jbuf->prometheus_event,
+                             sizeof(jbuf->prometheus_event),
+                             "source",
+                             (event->source_name != NULL) ?
+                             event->source_name : ""))
+  {
+    EVEL_DEBUG("Labels too long to expose %s", event->event_name);
+    goto exit_label;
+  }
+  jbuf->prometheus = evel_prometheus;
+
+exit_label:
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Finish encoding an event started with ::evel_json_prometheus_begin.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ *****************************************************************************/
+void evel_json_prometheus_end(EVEL_JSON_BUFFER * jbuf)
+{
+  int pthread_rc;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(jbuf != NULL);
+
+  jbuf->prometheus = NULL;
+  jbuf->prometheus_objects = 0;
+
+  pthread_rc = pthread_mutex_unlock(&evel_prometheus_mutex);
+  assert(pthread_rc == 0);
+  (void) pthread_rc;
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Expose the numeric fields encoded directly within the object just opened,
+ * until it is closed.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param id            The object's identifier within its list, or NULL.
+ *****************************************************************************/
+void evel_json_expose_object(EVEL_JSON_BUFFER * jbuf,
+                             const char * const id)
+{
+  char * labels;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(jbuf != NULL);
+
+  if ((jbuf->prometheus == NULL) ||
+      (jbuf->prometheus_objects == EVEL_PROMETHEUS_OBJECTS))
+  {
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* An object whose labels do not fit is not exposed: its fields are then   */
+  /* deeper than the innermost exposed object, so they are ignored.          */
+  /***************************************************************************/
+  labels = jbuf->prometheus_labels[jbuf->prometheus_objects];
+  strcpy(labels, jbuf->prometheus_event);
+  if ((id != NULL) &&
+      !evel_prometheus_label(labels, EVEL_PROMETHEUS_LABELS_LEN, "id", id))
+  {
+    EVEL_DEBUG("Labels too long to expose %s", id);
+    goto exit_label;
+  }
+  jbuf->prometheus_depth[jbuf->prometheus_objects] = jbuf->depth;
+  jbuf->prometheus_objects++;
+
+exit_label:
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Expose a numeric field just encoded, if it is directly within the
+ * innermost exposed object.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param key           The field's key.
+ * @param value         The field's value.
+ *****************************************************************************/
+void evel_json_expose_field(EVEL_JSON_BUFFER * jbuf,
+                            const char * const key,
+                            const double value)
+{
+  int top;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(jbuf != NULL);
+  assert(key != NULL);
+
+  top = jbuf->prometheus_objects - 1;
+  if ((jbuf->prometheus != NULL) &&
+      (top >= 0) &&
+      (jbuf->depth == jbuf->prometheus_depth[top]))
+  {
+    evel_prometheus_set(jbuf->prometheus,
+                        key,
+                        jbuf->prometheus_labels[top],
+                        value);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Expose a custom measurement whose value is numeric.
+ *
+ * @param jbuf          Pointer to working ::EVEL_JSON_BUFFER.
+ * @param group         The measurement's group.
+ * @param name          The measurement's name.
+ * @param value         The measurement's value, as text.
+ *****************************************************************************/
+void evel_json_expose_custom(EVEL_JSON_BUFFER * jbuf,
+                             const char * const group,
+                             const char * const name,
+                             const char * const value)
+{
+  char labels[EVEL_PROMETHEUS_LABELS_LEN];
+  char * end;
+  double number;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(jbuf != NULL);
+  assert(group != NULL);
+  assert(name != NULL);
+  assert(value != NULL);
+
+  if (jbuf->prometheus == NULL)
+  {
+    goto exit_label;
+  }
+
+  number = strtod(value, &end);
+  if ((end == value) || (*end != '\0'))
+  {
+    goto exit_label;
+  }
+
+  strcpy(labels, jbuf->prometheus_event);
+  if (evel_prometheus_label(labels, sizeof(labels), "group", group) &&
+      evel_prometheus_label(labels, sizeof(labels), "name", name))
+  {
+    evel_prometheus_set(jbuf->prometheus,
+                        "additionalMeasurements",
+                        labels,
+                        number);
+  }
+  else
+  {
+    EVEL_DEBUG("Labels too long to expose %s %s", group, name);
+  }
+
+exit_label:
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Append a label to a series' labels, escaping its value.
+ *
+ * @param labels    The labels so far.
+ * @param size      Space for the labels.
+ * @param name      The label's name.
+ * @param value     The label's value.
+ * @returns true if the label was added, false if it did not fit, leaving
+ *          the labels as they were.
+ *****************************************************************************/
+static bool evel_prometheus_label(char * const labels,
+                                  const size_t size,
+                                  const char * const name,
+                                  const char * const value)
+{
+  const char * next;
+  size_t start = strlen(labels);
+  size_t length = start;
+  int written;
+
+  written = snprintf(labels + length, size - length, "%s%s=\"",
+                     (length > 0) ? "," : "", name);
+  if ((written < 0) || ((size_t) written >= size - length))
+  {
+    goto truncated;
+  }
+  length += written;
+
+  /***************************************************************************/
+  /* Each character takes at most two, leaving room for the closing quote.   */
+  /***************************************************************************/
+  for (next = value; *next != '\0'; next++)
+  {
+    if (length + 4 > size)
+    {
+      goto truncated;
+    }
+    if ((*next == '\\') || (*next == '"'))
+    {
+      labels[length++] = '\\';
+      labels[length++] = *next;
+    }
+    else if (*next == '\n')
+    {
+      labels[length++] = '\\';
+      labels[length++] = 'n';
+    }
+    else
+    {
+      labels[length++] = *next;
+    }
+  }
+  labels[length++] = '"';
+  labels[length] = '\0';
+
+  return true;
+
+truncated:
+  labels[start] = '\0';
+  return false;
+}
+
+/**************************************************************************//**
+ * Set the value of a series, adding it if it is new.  Called with the mutex
+ * held.
+ *
+ * @param prometheus    The endpoint.
+ * @param key           The field's key, from which the metric is named.
+ * @param labels        The series' labels.
+ * @param value         The value.
+ *****************************************************************************/
+static void evel_prometheus_set(EVEL_PROMETHEUS * const prometheus,
+                                const char * const key,
+                                const char * const labels,
+                                const double value)
+{
+  char name[EVEL_PROMETHEUS_NAME_LEN];
+  char index_key[EVEL_PROMETHEUS_NAME_LEN + EVEL_PROMETHEUS_LABELS_LEN];
+  EVEL_PROMETHEUS_SERIES * series;
+  uint64_t bits;
+  int * index;
+  char * next;
+
+  /***************************************************************************/
+  /* Metric names may only contain letters, digits, underscores and colons.  */
+  /***************************************************************************/
+  snprintf(name, sizeof(name), "ves_%s", key);
+  for (next = name; *next != '\0'; next++)
+  {
+    if (!(((*next >= 'a') && (*next <= 'z')) ||
+          ((*next >= 'A') && (*next <= 'Z')) ||
+          ((*next >= '0') && (*next <= '9')) ||
+          (*next == '_') || (*next == ':')))
+    {
+      *next = '_';
+    }
+  }
+
+  memcpy(&bits, &value, sizeof(bits));
+  snprintf(index_key, sizeof(index_key), "%s{%s}", name, labels);
+  index = ht_get(prometheus->index, index_key);
+  if (index != NULL)
+  {
+    __atomic_store_n(&prometheus->series[*index].value,
+                     bits,
+                     __ATOMIC_RELAXED);
+    return;
+  }
+
+  if (prometheus->num_series == EVEL_PROMETHEUS_MAX_SERIES)
+  {
+    if (__atomic_fetch_add(&prometheus->series_dropped,
+                           1,
+                           __ATOMIC_RELAXED) == 0)
+    {
+      EVEL_ERROR("Prometheus endpoint is full, with %d series",
+                 EVEL_PROMETHEUS_MAX_SERIES);
+    }
+    return;
+  }
+
+  index = malloc(sizeof(int));
+  if (index == NULL)
+  {
+    log_error_state("Failed to allocate Prometheus series index");
+    return;
+  }
+  *index = prometheus->num_series;
+  ht_set(prometheus->index, index_key, index);
+
+  /***************************************************************************/
+  /* Fill in the series before publishing it.                                */
+  /***************************************************************************/
+  series = &prometheus->series[*index];
+  strcpy(series->name, name);
+  strcpy(series->labels, labels);
+  series->value = bits;
+  __atomic_store_n(&prometheus->num_series, *index + 1, __ATOMIC_RELEASE);
+}
+
+/**************************************************************************//**
+ * Server thread: serve each connection in turn until stopped.
+ *
+ * @param arg   The endpoint.
+ *****************************************************************************/
+static void * evel_prometheus_server(void * arg)
+{
+  EVEL_PROMETHEUS * prometheus = (EVEL_PROMETHEUS *) arg;
+  struct pollfd fds[2];
+  int fd;
+
+  fds[0].fd = prometheus->socket;
+  fds[0].events = POLLIN;
+  fds[1].fd = prometheus->stop_fd;
+  fds[1].events = POLLIN;
+
+  while (1)
+  {
+    if (poll(fds, 2, -1) < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      log_error_state("Prometheus server failed to poll: %s",
+                      strerror(errno));
+      break;
+    }
+    if (fds[1].revents != 0)
+    {
+      break;
+    }
+
+    fd = accept4(prometheus->socket, NULL, NULL, SOCK_CLOEXEC);
+    if (fd < 0)
+    {
+      continue;
+    }
+    evel_prometheus_serve(prometheus, fd);
+    close(fd);
+  }
+
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Send all of a buffer, giving up if the connection fails or times out.
+ *
+ * @param fd        The connection.
+ * @param data      What to send.
+ * @param length    Its length.
+ * @returns true if it was all sent.
+ *****************************************************************************/
+static bool evel_prometheus_send(const int fd,
+                                 const char * data,
+                                 size_t length)
+{
+  ssize_t bytes;
+
+  while (length > 0)
+  {
+    bytes = send(fd, data, length, MSG_NOSIGNAL);
+    if (bytes < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      EVEL_DEBUG("Failed to send Prometheus response: %s", strerror(errno));
+      return false;
+    }
+    data += bytes;
+    length -= bytes;
+  }
+
+  return true;
+}
+
+/**************************************************************************//**
+ * Serve one connection: read its request and send the response.
+ *
+ * @param prometheus    The endpoint.
+ * @param fd            The connection.
+ *****************************************************************************/
+static void evel_prometheus_serve(EVEL_PROMETHEUS * const prometheus,
+                                  const int fd)
+{
+  char request[EVEL_PROMETHEUS_REQUEST_LEN];
+  char header[256];
+  struct timeval timeout = {EVEL_PROMETHEUS_TIMEOUT, 0};
+  const char * status = "200 OK";
+  const char * body;
+  size_t body_length;
+  size_t length = 0;
+  ssize_t bytes;
+  int header_length;
+
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+  /***************************************************************************/
+  /* Read up to the end of the request's headers; only its first line is     */
+  /* needed, and anything after the headers is ignored.                      */
+  /***************************************************************************/
+  request[0] = '\0';
+  while ((strstr(request, "\r\n\r\n") == NULL) &&
+         (strstr(request, "\n\n") == NULL) &&
+         (length < sizeof(request) - 1))
+  {
+    bytes = recv(fd, request + length, sizeof(request) - 1 - length, 0);
+    if (bytes < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (bytes <= 0)
+    {
+      EVEL_DEBUG("Prometheus scraper sent no request");
+      return;
+    }
+    length += bytes;
+    request[length] = '\0';
+  }
+
+  if (strncmp(request, "GET ", 4) != 0)
+  {
+    status = "405 Method Not Allowed";
+    body = "Method Not Allowed\n";
+  }
+  else if ((strncmp(request + 4, "/metrics", 8) != 0) ||
+           ((request[12] != ' ') && (request[12] != '?')))
+  {
+    status = "404 Not Found";
+    body = "Not Found\n";
+  }
+  else
+  {
+    prometheus->scrapes++;
+    if (evel_prometheus_render(prometheus))
+    {
+      body = prometheus->text;
+    }
+    else
+    {
+      status = "500 Internal Server Error";
+      body = "Internal Server Error\n";
+    }
+  }
+  body_length = (body == prometheus->text) ?
+                prometheus->text_length : strlen(body);
+
+  header_length = snprintf(header, sizeof(header),
+                           "HTTP/1.1 %s\r\n"
+                           "Content-Type: %s\r\n"
+                           "Content-Length: %zu\r\n"
+                           "Connection: close\r\n"
+                           "\r\n",
+                           status,
+                           (body == prometheus->text) ?
+                           EVEL_PROMETHEUS_CONTENT_TYPE : "text/plain",
+                           body_length);
+  if (evel_prometheus_send(fd, header, header_length))
+  {
+    evel_prometheus_send(fd, body, body_length);
+  }
+}
+
+/**************************************************************************//**
+ * Append to the rendered text, growing it as needed.
+ *
+ * @param prometheus    The endpoint.
+ * @param format        printf format.
+ * @returns true on success, false if the text could not grow.
+ *****************************************************************************/
+static bool evel_prometheus_append(EVEL_PROMETHEUS * const prometheus,
+                                   const char * const format, ...)
+{
+  va_list args;
+  size_t size;
+  char * text;
+  int written;
+
+  while (1)
+  {
+    va_start(args, format);
+    written = vsnprintf(prometheus->text + prometheus->text_length,
+                        prometheus->text_size - prometheus->text_length,
+                        format,
+                        args);
+    va_end(args);
+    if (written < 0)
+    {
+      return false;
+    }
+    if ((size_t) written < prometheus->text_size - prometheus->text_length)
+    {
+      prometheus->text_length += written;
+      return true;
+    }
+
+    size = prometheus->text_size * 2;
+    text = realloc(prometheus->text, size);
+    if (text == NULL)
+    {
+      log_error_state("Failed to grow Prometheus text to %zu bytes", size);
+      return false;
+    }
+    prometheus->text = text;
+    prometheus->text_size = size;
+  }
+}
+
+/**************************************************************************//**
+ * Append one of the library's counters.
+ *****************************************************************************/
+static bool evel_prometheus_counter(EVEL_PROMETHEUS * const prometheus,
+                                    const char * const name,
+                                    const char * const help,
+                                    const unsigned long long value)
+{
+  return evel_prometheus_append(prometheus,
+                                "# HELP %s %s\n# TYPE %s counter\n%s %llu\n",
+                                name, help, name, name, value);
+}
+
+/**************************************************************************//**
+ * Order series by metric name, so that each family is rendered together.
+ *****************************************************************************/
+static int evel_prometheus_compare(const void * a, const void * b)
+{
+  const EVEL_PROMETHEUS_SERIES * const * first = a;
+  const EVEL_PROMETHEUS_SERIES * const * second = b;
+
+  return strcmp((*first)->name, (*second)->name);
+}
+
+/**************************************************************************//**
+ * Render the library's counters and every published series.
+ *
+ * @param prometheus    The endpoint.
+ * @returns true on success, false if the text could not grow.
+ *****************************************************************************/
+static bool evel_prometheus_render(EVEL_PROMETHEUS * const prometheus)
+{
+  const EVEL_PROMETHEUS_SERIES * series;
+  const char * family = "";
+  unsigned long long posted;
+  unsigned long long dropped;
+  unsigned long long sent;
+  unsigned long long failed;
+  unsigned long long log_dropped;
+  unsigned long long log_suppressed;
+  char text[32];
+  uint64_t bits;
+  double value;
+  bool ok;
+  int num_series;
+  int ii;
+
+  prometheus->text_length = 0;
+  prometheus->text[0] = '\0';
+
+  event_handler_stats(&posted, &dropped, &sent, &failed);
+  log_async_stats(&log_dropped, &log_suppressed);
+  num_series = __atomic_load_n(&prometheus->num_series, __ATOMIC_ACQUIRE);
+
+  ok = evel_prometheus_counter(prometheus, "evel_events_posted_total",
+                               "Events queued for sending.", posted) &&
+       evel_prometheus_counter(prometheus, "evel_events_dropped_total",
+                               "Events dropped because they could not be "
+                               "queued.", dropped) &&
+       evel_prometheus_counter(prometheus, "evel_posts_sent_total",
+                               "Posts accepted by a collector.", sent) &&
+       evel_prometheus_counter(prometheus, "evel_posts_failed_total",
+                               "Posts which failed or a collector refused.",
+                               failed) &&
+       evel_prometheus_counter(prometheus, "evel_log_dropped_total",
+                               "Log messages dropped because the queue was "
+                               "full.", log_dropped) &&
+       evel_prometheus_counter(prometheus, "evel_log_suppressed_total",
+                               "Error messages suppressed by rate limiting.",
+                               log_suppressed) &&
+       evel_prometheus_counter(prometheus, "evel_prometheus_scrapes_total",
+                               "Scrapes of this endpoint.",
+                               prometheus->scrapes) &&
+       evel_prometheus_counter(prometheus,
+                               "evel_prometheus_series_dropped_total",
+                               "Values not exposed because the endpoint was "
+                               "full.",
+                               __atomic_load_n(&prometheus->series_dropped,
+                                               __ATOMIC_RELAXED)) &&
+       evel_prometheus_append(prometheus,
+                              "# HELP evel_prometheus_series Series exposed."
+                              "\n# TYPE evel_prometheus_series gauge\n"
+                              "evel_prometheus_series %d\n", num_series);
+
+  /***************************************************************************/
+  /* Published series' names and labels never change, so only their values  */
+  /* need to be read atomically.                                             */
+  /***************************************************************************/
+  for (ii = 0; ii < num_series; ii++)
+  {
+    prometheus->order[ii] = &prometheus->series[ii];
+  }
+  qsort(prometheus->order,
+        num_series,
+        sizeof(prometheus->order[0]),
+        evel_prometheus_compare);
+
+  for (ii = 0; ok && (ii < num_series); ii++)
+  {
+    series = prometheus->order[ii];
+    if (strcmp(series->name, family) != 0)
+    {
+      family = series->name;
+      ok = evel_prometheus_append(prometheus, "# TYPE %s gauge\n", family);
+    }
+
+    bits = __atomic_load_n(&series->value, __ATOMIC_RELAXED);
+    memcpy(&value, &bits, sizeof(value));
+    if (isnan(value))
+    {
+      strcpy(text, "NaN");
+    }
+    else if (isinf(value))
+    {
+      strcpy(text, (value > 0) ? "+Inf" : "-Inf");
+    }
+    else
+    {
+      snprintf(text, sizeof(text), "%.15g", value);
+    }
+    ok = ok && evel_prometheus_append(prometheus, "%s{%s} %s\n",
+                                      series->name, series->labels, text);
+  }
+
+  return ok;
+}
@@ -0,0 +1,825 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Receiving syslog messages directly, as a syslog daemon does.
+ *
+ * Messages arrive as datagrams on Unix sockets, such as /dev/log where the
+ * C library's syslog() sends them, and on UDP sockets, where remote hosts
+ * send them.  Each socket is drained with recvmmsg() a batch at a time, so
+ * a burst of messages costs a few system calls rather than one each.
+ *
+ * Each message is parsed as RFC 5424 if it has a version after its
+ * priority, and otherwise as RFC 3164, as sent by syslog() and most network
+ * equipment.  RFC 3164 does not fix the format beyond the priority, so as
+ * the common daemons do, a timestamp is only taken if it has the expected
+ * form, a hostname only follows a timestamp, and a word is only taken as
+ * the tag if it ends in ':' or a bracketed process ID.  Anything not
+ * recognised is left in the message.
+ ****************************************************************************/
+
+#define _GNU_SOURCE
+#include <assert.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Sockets one receiver can listen on.                                       */
+/*****************************************************************************/
+#define EVEL_RECEIVER_MAX_SOCKETS 8
+
+/*****************************************************************************/
+/* Messages read by each recvmmsg(), and batches read from one socket before */
+/* the others get a turn.                                                    */
+/*****************************************************************************/
+#define EVEL_RECEIVER_BATCH 64
+#define EVEL_RECEIVER_MAX_BATCHES 16
+
+/*****************************************************************************/
+/* Longest message kept.  Longer datagrams are cut short.                    */
+/*****************************************************************************/
+#define EVEL_RECEIVER_MAX_MESSAGE 8192
+
+/*****************************************************************************/
+/* Socket receive buffer asked for, to ride out bursts.                      */
+/*****************************************************************************/
+#define EVEL_RECEIVER_SOCKET_BUFFER (4 * 1024 * 1024)
+
+/*****************************************************************************/
+/* RFC 3164 limits the tag to 32 characters; some senders use more.          */
+/*****************************************************************************/
+#define EVEL_RECEIVER_MAX_TAG 48
+
+/*****************************************************************************/
+/* Priority used for messages without one, from RFC 3164: user.notice.       */
+/*****************************************************************************/
+#define EVEL_RECEIVER_DEFAULT_FACILITY EVEL_SYSLOG_FACILITY_USER
+#define EVEL_RECEIVER_DEFAULT_SEVERITY 5
+
+/**************************************************************************//**
+ * Receiver state.  Unix socket paths are kept so that the sockets can be
+ * removed again.
+ *****************************************************************************/
+struct evel_syslog_receiver {
+  int num_sockets;
+  int sockets[EVEL_RECEIVER_MAX_SOCKETS];
+  char * paths[EVEL_RECEIVER_MAX_SOCKETS];
+  struct mmsghdr messages[EVEL_RECEIVER_BATCH];
+  struct iovec iovecs[EVEL_RECEIVER_BATCH];
+  char * buffers;
+  char * fields;
+};
+
+/*****************************************************************************/
+/* VES names of the syslog severities, by value.                             */
+/*****************************************************************************/
+static const char * const evel_receiver_severities[] = {
+  "Emergency", "Alert", "Critical", "Error",
+  "Warning", "Notice", "Info", "Debug"
+};
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static EVEL_ERR_CODES evel_receiver_add(EVEL_SYSLOG_RECEIVER * const receiver,
+                                        const int fd,
+                                        const char * const path);
+static char * evel_receiver_word(char ** pos, char * const end);
+static char * evel_receiver_nil(char * const word);
+static int evel_receiver_is_timestamp(const char * pos,
+                                      const char * const end);
+static void evel_receiver_tag(EVEL_SYSLOG_MESSAGE * const message,
+                              char ** pos,
+                              char * const end);
+static void evel_receiver_structured_data(EVEL_SYSLOG_MESSAGE * const message,
+                                          char ** pos,
+                                          char * const end);
+static void evel_receiver_drain(EVEL_SYSLOG_RECEIVER * const receiver,
+                                const int fd,
+                                EVEL_SYSLOG_MESSAGE_FN function,
+                                void * context);
+
+/**************************************************************************//**
+ * Get the VES name of a syslog severity.
+ *
+ * @param severity  The severity, 0 (emergency) to 7 (debug).
+ *
+ * @returns The name, such as "Warning".
+ *****************************************************************************/
+const char * evel_syslog_severity_name(const int severity)
+{
+  assert(severity >= 0 && severity < 8);
+
+  return evel_receiver_severities[severity];
+}
+
+/**************************************************************************//**
+ * Take the next space-separated word, terminating it in place.
+ *
+ * @param pos       Where to start, moved past the word and its space.
+ * @param end       End of the text.
+ *
+ * @returns The word, or NULL if the text is used up.
+ *****************************************************************************/
+static char * evel_receiver_word(char ** pos, char * const end)
+{
+  char * word = *pos;
+  char * space;
+
+  if (word >= end)
+  {
+    return NULL;
+  }
+
+  space = memchr(word, ' ', end - word);
+  if (space == NULL)
+  {
+    *pos = end;
+  }
+  else
+  {
+    *space = '\0';
+    *pos = space + 1;
+  }
+
+  return word;
+}
+
+/**************************************************************************//**
+ * Map the RFC 5424 NILVALUE, "-", to NULL.
+ *****************************************************************************/
+static char * evel_receiver_nil(char * const word)
+{
+  if (word == NULL || strcmp(word, "-") == 0 || *word == '\0')
+  {
+    return NULL;
+  }
+  return word;
+}
+
+/**************************************************************************//**
+ * Check for an RFC 3164 timestamp, "Mmm dd hh:mm:ss", followed by a space.
+ *****************************************************************************/
+static int evel_receiver_is_timestamp(const char * pos,
+                                      const char * const end)
+{
+  static const char * const form = "Aaa dd dd:dd:dd ";
+  int ii;
+
+  if (end - pos < 16)
+  {
+    return 0;
+  }
+
+  for (ii = 0; ii < 16; ii++)
+  {
+    switch (form[ii])
+    {
+      case 'A':
+        if (!isupper((unsigned char) pos[ii])) return 0;
+        break;
+      case 'a':
+        if (!islower((unsigned char) pos[ii])) return 0;
+        break;
+      case 'd':
+        if (!isdigit((unsigned char) pos[ii]) &&
+            !(ii == 4 && pos[ii] == ' '))
+        {
+          return 0;
+        }
+        break;
+      default:
+        if (pos[ii] != form[ii]) return 0;
+        break;
+    }
+  }
+
+  return 1;
+}
+
+/**************************************************************************//**
+ * Take an RFC 3164 tag, "name:" or "name[pid]:", if there is one.
+ *****************************************************************************/
+static void evel_receiver_tag(EVEL_SYSLOG_MESSAGE * const message,
+                              char ** pos,
+                              char * const end)
+{
+  char * name = *pos;
+  char * pid = NULL;
+  char * scan = name;
+  char * close;
+
+  while (scan < end && scan - name <= EVEL_RECEIVER_MAX_TAG &&
+         *scan != '[' && *scan != ':' && *scan != ' ')
+  {
+    scan++;
+  }
+
+  if (scan == name || scan >= end || scan - name > EVEL_RECEIVER_MAX_TAG)
+  {
+    return;
+  }
+
+  if (*scan == '[')
+  {
+    close = memchr(scan, ']', end - scan);
+    if (close == NULL)
+    {
+      return;
+    }
+    *scan = '\0';
+    *close = '\0';
+    pid = scan + 1;
+    scan = close + 1;
+    if (scan < end && *scan == ':')
+    {
+      scan++;
+    }
+  }
+  else if (*scan == ':')
+  {
+    *scan++ = '\0';
+  }
+  else
+  {
+    return;
+  }
+
+  message->app_name = name;
+  if (pid != NULL && *pid != '\0' && strspn(pid, "0123456789") == strlen(pid))
+  {
+    message->proc_id = atoi(pid);
+  }
+
+  while (scan < end && *scan == ' ')
+  {
+    scan++;
+  }
+  *pos = scan;
+}
+
+/**************************************************************************//**
+ * Take RFC 5424 structured data: "-", or one or more "[id name="value"]"
+ * elements, in whose values '\' escapes '"', '\' and ']'.
+ *****************************************************************************/
+static void evel_receiver_structured_data(EVEL_SYSLOG_MESSAGE * const message,
+                                          char ** pos,
+                                          char * const end)
+{
+  char * start = *pos;
+  char * scan = start;
+  int quoted = 0;
+  size_t length;
+
+  if (scan < end && *scan == '-')
+  {
+    scan++;
+  }
+  else
+  {
+    while (scan < end && *scan == '[')
+    {
+      length = strcspn(scan + 1, " ]");
+      if (message->sdid[0] == '\0' && length < sizeof(message->sdid))
+      {
+        memcpy(message->sdid, scan + 1, length);
+        message->sdid[length] = '\0';
+      }
+
+      for (scan++; scan < end; scan++)
+      {
+        if (quoted && *scan == '\\' && scan + 1 < end)
+        {
+          scan++;
+        }
+        else if (*scan == '"')
+        {
+          quoted = !quoted;
+        }
+        else if (!quoted && *scan == ']')
+        {
+          scan++;
+          break;
+        }
+      }
+    }
+    if (scan > start)
+    {
+      message->structured_data = start;
+    }
+  }
+
+  if (scan < end)
+  {
+    *scan++ = '\0';
+  }
+  *pos = scan;
+}
+
+/**************************************************************************//**
+ * Parse a syslog message.
+ *
+ * @param text      The message as received.
+ * @param length    Length of the message.
+ * @param fields    Space for the parsed fields, at least length + 1 bytes.
+ * @param message   The message to fill in.  Its strings point into fields
+ *                  and text.
+ *****************************************************************************/
+void evel_syslog_parse(const char * const text,
+                       const size_t length,
+                       char * const fields,
+                       EVEL_SYSLOG_MESSAGE * const message)
+{
+  char * pos = fields;
+  char * end = fields + length;
+  char * word;
+  int priority = 0;
+  int digits = 0;
+
+  assert(text != NULL);
+  assert(fields != NULL);
+  assert(message != NULL);
+
+  memset(message, 0, sizeof(EVEL_SYSLOG_MESSAGE));
+  message->text = text;
+  message->length = length;
+  message->facility = EVEL_RECEIVER_DEFAULT_FACILITY;
+  message->severity = EVEL_RECEIVER_DEFAULT_SEVERITY;
+
+  memcpy(fields, text, length);
+  while (end > pos && (end[-1] == '\n' || end[-1] == '\r' || end[-1] == '\0'))
+  {
+    end--;
+  }
+  *end = '\0';
+
+  /***************************************************************************/
+  /* <PRI>, up to three digits for a value up to 191.                        */
+  /***************************************************************************/
+  if (pos < end && *pos == '<')
+  {
+    for (word = pos + 1;
+         word < end && digits < 3 && isdigit((unsigned char) *word);
+         word++, digits++)
+    {
+      priority = priority * 10 + (*word - '0');
+    }
+    if (digits > 0 && word < end && *word == '>' && priority <= 191)
+    {
+      message->facility = priority >> 3;
+      message->severity = priority & 7;
+      pos = word + 1;
+    }
+  }
+
+  if (end - pos >= 2 && pos[0] == '1' && pos[1] == ' ')
+  {
+    /*************************************************************************/
+    /* RFC 5424: VERSION SP TIMESTAMP SP HOSTNAME SP APP-NAME SP PROCID SP   */
+    /* MSGID SP STRUCTURED-DATA [SP MSG]                                     */
+    /*************************************************************************/
+    message->version = 1;
+    pos += 2;
+    message->timestamp = evel_receiver_nil(evel_receiver_word(&pos, end));
+    message->hostname = evel_receiver_nil(evel_receiver_word(&pos, end));
+    message->app_name = evel_receiver_nil(evel_receiver_word(&pos, end));
+    word = evel_receiver_nil(evel_receiver_word(&pos, end));
+    if (word != NULL && strspn(word, "0123456789") == strlen(word))
+    {
+      message->proc_id = atoi(word);
+    }
+    message->msg_id = evel_receiver_nil(evel_receiver_word(&pos, end));
+    evel_receiver_structured_data(message, &pos, end);
+
+    if (end - pos >= 3 && memcmp(pos, "\xef\xbb\xbf", 3) == 0)
+    {
+      pos += 3;
+    }
+  }
+  else
+  {
+    /*************************************************************************/
+    /* RFC 3164: [TIMESTAMP SP [HOSTNAME SP]] [TAG] MSG.  A word after the   */
+    /* timestamp is the hostname unless it is itself the tag.                */
+    /*************************************************************************/
+    if (evel_receiver_is_timestamp(pos, end))
+    {
+      message->timestamp = pos;
+      pos[15] = '\0';
+      pos += 16;
+
+      word = pos;
+      while (word < end && *word != ' ' && *word != '[')
+      {
+        word++;
+      }
+      if (word < end && *word == ' ' && word > pos && word[-1] != ':')
+      {
+        message->hostname = evel_receiver_word(&pos, end);
+      }
+    }
+    evel_receiver_tag(message, &pos, end);
+  }
+
+  message->message = pos;
+  message->message_length = end - pos;
+}
+
+/**************************************************************************//**
+ * Create a receiver with no sockets.
+ *
+ * @returns pointer to the new receiver.
+ * @retval  NULL  Failed to allocate the receiver.
+ *****************************************************************************/
+EVEL_SYSLOG_RECEIVER * evel_new_syslog_receiver(void)
+{
+  EVEL_SYSLOG_RECEIVER * receiver = NULL;
+  int ii;
+
+  EVEL_ENTER();
+
+  receiver = calloc(1, sizeof(EVEL_SYSLOG_RECEIVER));
+  if (receiver == NULL)
+  {
+    log_error_state("Failed to allocate syslog receiver");
+    goto exit_label;
+  }
+
+  receiver->buffers = malloc(EVEL_RECEIVER_BATCH *
+                             (EVEL_RECEIVER_MAX_MESSAGE + 1));
+  receiver->fields = malloc(EVEL_RECEIVER_MAX_MESSAGE + 1);
+  if (receiver->buffers == NULL || receiver->fields == NULL)
+  {
+    log_error_state("Failed to allocate syslog receiver buffers");
+    evel_free_syslog_receiver(receiver);
+    receiver = NULL;
+    goto exit_label;
+  }
+
+  for (ii = 0; ii < EVEL_RECEIVER_BATCH; ii++)
+  {
+    receiver->iovecs[ii].iov_base =
+                     receiver->buffers + ii * (EVEL_RECEIVER_MAX_MESSAGE + 1);
+    receiver->iovecs[ii].iov_len = EVEL_RECEIVER_MAX_MESSAGE;
+    receiver->messages[ii].msg_hdr.msg_iov = &receiver->iovecs[ii];
+    receiver->messages[ii].msg_hdr.msg_iovlen = 1;
+  }
+
+exit_label:
+  EVEL_EXIT();
+  return receiver;
+}
+
+/**************************************************************************//**
+ * Close a receiver's sockets, removing its Unix sockets, and free it.
+ *
+ * @param receiver  The receiver.  May be NULL.
+ *****************************************************************************/
+void evel_free_syslog_receiver(EVEL_SYSLOG_RECEIVER * receiver)
+{
+  int ii;
+
+  EVEL_ENTER();
+
+  if (receiver != NULL)
+  {
+    for (ii = 0; ii < receiver->num_sockets; ii++)
+    {
+      close(receiver->sockets[ii]);
+      if (receiver->paths[ii] != NULL)
+      {
+        unlink(receiver->paths[ii]);
+        free(receiver->paths[ii]);
+      }
+    }
+    free(receiver->buffers);
+    free(receiver->fields);
+    free(receiver);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Add a bound socket to the receiver.
+ *****************************************************************************/
+static EVEL_ERR_CODES evel_receiver_add(EVEL_SYSLOG_RECEIVER * const receiver,
+                                        const int fd,
+                                        const char * const path)
+{
+  int size = EVEL_RECEIVER_SOCKET_BUFFER;
+
+  if (receiver->num_sockets == EVEL_RECEIVER_MAX_SOCKETS)
+  {
+    log_error_state("Too many syslog receiver sockets");
+    close(fd);
+    return EVEL_ERR_GEN_FAIL;
+  }
+
+  /***************************************************************************/
+  /* A larger buffer is only a help; the kernel may cap or refuse it.        */
+  /***************************************************************************/
+  setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+
+  receiver->sockets[receiver->num_sockets] = fd;
+  receiver->paths[receiver->num_sockets] = (path != NULL) ? strdup(path) : NULL;
+  receiver->num_sockets++;
+
+  return EVEL_SUCCESS;
+}
+
+/**************************************************************************//**
+ * Listen on a Unix datagram socket, such as /dev/log.  A socket left at the
+ * path by an earlier run is replaced.
+ *
+ * @param receiver  The receiver.
+ * @param path      Path of the socket.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_ERR_GEN_FAIL The socket could not be created.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_syslog_receiver_unix(EVEL_SYSLOG_RECEIVER * const receiver,
+                                         const char * const path)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  struct sockaddr_un address;
+  struct stat status;
+  int fd;
+
+  EVEL_ENTER();
+
+  assert(receiver != NULL);
+  assert(path != NULL);
+
+  if (strlen(path) >= sizeof(address.sun_path))
+  {
+    log_error_state("Syslog socket path too long: %s", path);
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, path);
+
+  if (lstat(path, &status) == 0 && S_ISSOCK(status.st_mode))
+  {
+    unlink(path);
+  }
+
+  fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+  {
+    log_error_state("Failed to create syslog socket: %s", strerror(errno));
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  if (bind(fd, (struct sockaddr *) &address, sizeof(address)) != 0)
+  {
+    log_error_state("Failed to bind %s: %s", path, strerror(errno));
+    close(fd);
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Every process must be able to log.                                      */
+  /***************************************************************************/
+  chmod(path, 0666);
+
+  rc = evel_receiver_add(receiver, fd, path);
+  EVEL_INFO("Receiving syslog on %s", path);
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Listen on UDP, on each address the name resolves to.
+ *
+ * @param receiver  The receiver.
+ * @param address   Address or host name to bind to, or NULL for all.
+ * @param port      The port, usually 514.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_ERR_GEN_FAIL No socket could be bound.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_syslog_receiver_udp(EVEL_SYSLOG_RECEIVER * const receiver,
+                                        const char * const address,
+                                        const int port)
+{
+  EVEL_ERR_CODES rc = EVEL_ERR_GEN_FAIL;
+  struct addrinfo hints;
+  struct addrinfo * addresses = NULL;
+  struct addrinfo * ai;
+  char service[16];
+  int on = 1;
+  int error;
+  int fd;
+
+  EVEL_ENTER();
+
+  assert(receiver != NULL);
+  assert(port > 0 && port < 65536);
+
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_DGRAM;
+  hints.ai_flags = AI_PASSIVE | AI_NUMERICSERV;
+  snprintf(service, sizeof(service), "%d", port);
+
+  error = getaddrinfo(address, service, &hints, &addresses);
+  if (error != 0)
+  {
+    log_error_state("Failed to resolve %s: %s",
+                    (address != NULL) ? address : "*", gai_strerror(error));
+    goto exit_label;
+  }
+
+  for (ai = addresses; ai != NULL; ai = ai->ai_next)
+  {
+    fd = socket(ai->ai_family,
+                ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                ai->ai_protocol);
+    if (fd < 0)
+    {
+      continue;
+    }
+
+    /*************************************************************************/
+    /* Keep IPv6 sockets to IPv6, so the IPv4 wildcard can be bound too.     */
+    /*************************************************************************/
+    if (ai->ai_family == AF_INET6)
+    {
+      setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &on, sizeof(on));
+    }
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    if (bind(fd, ai->ai_addr, ai->ai_addrlen) != 0)
+    {
+      EVEL_ERROR("Failed to bind syslog UDP port %d: %s",
+                 port, strerror(errno));
+      close(fd);
+      continue;
+    }
+
+    if (evel_receiver_add(receiver, fd, NULL) == EVEL_SUCCESS)
+    {
+      rc = EVEL_SUCCESS;
+    }
+  }
+
+  if (rc == EVEL_SUCCESS)
+  {
+    EVEL_INFO("Receiving syslog on UDP port %d", port);
+  }
+  else
+  {
+    log_error_state("Failed to listen on syslog UDP port %d", port);
+  }
+
+exit_label:
+  if (addresses != NULL)
+  {
+    freeaddrinfo(addresses);
+  }
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Read what is waiting on a socket, a batch at a time, and hand on each
+ * message.
+ *****************************************************************************/
+static void evel_receiver_drain(EVEL_SYSLOG_RECEIVER * const receiver,
+                                const int fd,
+                                EVEL_SYSLOG_MESSAGE_FN function,
+                                void * context)
+{
+  EVEL_SYSLOG_MESSAGE message;
+  char * text;
+  int received;
+  int batches;
+  int ii;
+
+  for (batches = 0; batches < EVEL_RECEIVER_MAX_BATCHES; batches++)
+  {
+    received = recvmmsg(fd,
+                        receiver->messages,
+                        EVEL_RECEIVER_BATCH,
+                        MSG_DONTWAIT,
+                        NULL);
+    if (received <= 0)
+    {
+      if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK &&
+          errno != EINTR)
+      {
+        EVEL_ERROR("Failed to receive syslog: %s", strerror(errno));
+      }
+      break;
+    }
+
+    for (ii = 0; ii < received; ii++)
+    {
+      text = receiver->iovecs[ii].iov_base;
+      text[receiver->messages[ii].msg_len] = '\0';
+      evel_syslog_parse(text,
+                        receiver->messages[ii].msg_len,
+                        receiver->fields,
+                        &message);
+      (*function)(context, &message);
+    }
+
+    if (received < EVEL_RECEIVER_BATCH)
+    {
+      break;
+    }
+  }
+}
+
+/**************************************************************************//**
+ * Wait for messages, and hand on each one received.
+ *
+ * @param receiver    The receiver.
+ * @param timeout_ms  Longest time to wait, in milliseconds.
+ * @param function    Function to hand messages to.
+ * @param context     Context passed to function.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success, including when the wait times out.
+ * @retval  EVEL_ERR_GEN_FAIL Waiting failed.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_syslog_receiver_wait(EVEL_SYSLOG_RECEIVER * const receiver,
+                                         const int timeout_ms,
+                                         EVEL_SYSLOG_MESSAGE_FN function,
+                                         void * context)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  struct pollfd fds[EVEL_RECEIVER_MAX_SOCKETS];
+  int ready;
+  int ii;
+
+  EVEL_ENTER();
+
+  assert(receiver != NULL);
+  assert(function != NULL);
+
+  for (ii = 0; ii < receiver->num_sockets; ii++)
+  {
+    fds[ii].fd = receiver->sockets[ii];
+    fds[ii].events = POLLIN;
+    fds[ii].revents = 0;
+  }
+
+  ready = poll(fds, receiver->num_sockets, timeout_ms);
+  if (ready < 0 && errno != EINTR)
+  {
+    log_error_state("Failed to wait for syslog: %s", strerror(errno));
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  for (ii = 0; ready > 0 && ii < receiver->num_sockets; ii++)
+  {
+    if (fds[ii].revents & POLLIN)
+    {
+      evel_receiver_drain(receiver, fds[ii].fd, function, context);
+    }
+  }
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
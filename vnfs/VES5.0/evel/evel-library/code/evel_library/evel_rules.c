@@ -0,0 +1,755 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Threshold rules evaluated as each metric is sampled.
+ *
+ * Every metric keeps the list of rules which read it, so a sample only
+ * evaluates those rules, and the cost of a sample does not depend on how
+ * many other rules there are.  A ratio is only evaluated at the end of a
+ * round of samples in which both its metrics were sampled, so that it never
+ * divides one round's sample by another's.  A rule is raised once its
+ * condition has held for its set delay, and cleared once the value has come
+ * back past its clear threshold for its clear delay; the gap between the two
+ * thresholds stops a value hovering around one of them from raising and
+ * clearing repeatedly.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Initial number of rules and metrics there is space for, grown as needed.  */
+/*****************************************************************************/
+#define EVEL_RULES_INITIAL_RULES 16
+#define EVEL_RULES_INITIAL_METRICS 16
+
+/*****************************************************************************/
+/* Initial number of rules reading each metric, grown as needed.             */
+/*****************************************************************************/
+#define EVEL_RULES_INITIAL_READERS 2
+
+/*****************************************************************************/
+/* Size of the metric name index.                                            */
+/*****************************************************************************/
+#define EVEL_RULES_HASH_SIZE 1024
+
+/*****************************************************************************/
+/* Space for a value formatted for a Threshold Crossing Alert.               */
+/*****************************************************************************/
+#define EVEL_RULES_VALUE_LEN 32
+
+struct evel_rule_metric;
+
+/**************************************************************************//**
+ * A rule, and whether it is raised.  A set or clear is pending while its
+ * condition holds but has not yet held for the delay.
+ *****************************************************************************/
+typedef struct evel_rule {
+  char * name;
+  char * description;
+  EVEL_RULE_TYPES type;
+  EVEL_RULE_DIRECTIONS direction;
+  double set_threshold;
+  double clear_threshold;
+  unsigned long long set_after_usec;
+  unsigned long long clear_after_usec;
+  EVEL_SEVERITIES severity;
+  EVEL_ALERT_TYPE alert_type;
+  void * context;
+  struct evel_rule_metric * metric;
+  struct evel_rule_metric * denominator;
+  int raised;
+  int pending;
+  unsigned long long pending_since;
+  unsigned long long raised_at;
+} EVEL_RULE;
+
+/**************************************************************************//**
+ * A metric, its latest sample and rate, the round it was taken in, and the
+ * rules other than ratios which read it.
+ *****************************************************************************/
+typedef struct evel_rule_metric {
+  char * name;
+  int id;
+  int valid;
+  int rate_valid;
+  double value;
+  double rate;
+  unsigned long long timestamp;
+  unsigned int round;
+  int num_readers;
+  int max_readers;
+  EVEL_RULE ** readers;
+} EVEL_RULE_METRIC;
+
+/**************************************************************************//**
+ * Rule set state.  The mutex protects the rules and metrics against
+ * samples arriving from several threads.
+ *****************************************************************************/
+struct evel_rules {
+  EVEL_RULE_ALERT_FN alert;
+  void * context;
+  HASHTABLE_T * index;
+  int num_metrics;
+  int max_metrics;
+  EVEL_RULE_METRIC ** metrics;
+  int num_rules;
+  int max_rules;
+  EVEL_RULE ** rules;
+  unsigned int round;
+  pthread_mutex_t mutex;
+};
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static EVEL_RULE_METRIC * evel_rules_metric_get(EVEL_RULES * const rules,
+                                                const char * const name);
+static EVEL_ERR_CODES evel_rules_reader_add(EVEL_RULE_METRIC * const metric,
+                                            EVEL_RULE * const rule);
+static void evel_free_rule(EVEL_RULE * rule);
+static int evel_rule_value(const EVEL_RULE * const rule, double * value);
+static void evel_rule_evaluate(EVEL_RULES * const rules,
+                               EVEL_RULE * const rule,
+                               const unsigned long long now);
+static void evel_rule_alert(EVEL_RULES * const rules,
+                            EVEL_RULE * const rule,
+                            const EVEL_EVENT_ACTION action,
+                            const double value,
+                            const unsigned long long now);
+
+/**************************************************************************//**
+ * Create an empty rule set.
+ *
+ * @param alert     Function to call when a rule is raised or cleared.
+ * @param context   Context passed to alert.
+ *
+ * @returns pointer to the new rule set.
+ * @retval  NULL  Failed to create the rule set.
+ *****************************************************************************/
+EVEL_RULES * evel_new_rules(EVEL_RULE_ALERT_FN alert, void * context)
+{
+  EVEL_RULES * rules = NULL;
+
+  EVEL_ENTER();
+
+  assert(alert != NULL);
+
+  rules = calloc(1, sizeof(EVEL_RULES));
+  if (rules == NULL)
+  {
+    log_error_state("Failed to allocate rule set");
+    goto exit_label;
+  }
+  rules->alert = alert;
+  rules->context = context;
+  rules->index = ht_create(EVEL_RULES_HASH_SIZE);
+  rules->metrics = malloc(EVEL_RULES_INITIAL_METRICS *
+                          sizeof(EVEL_RULE_METRIC *));
+  rules->rules = malloc(EVEL_RULES_INITIAL_RULES * sizeof(EVEL_RULE *));
+  if (rules->index == NULL || rules->metrics == NULL || rules->rules == NULL)
+  {
+    log_error_state("Failed to allocate rule set");
+    if (rules->index != NULL)
+    {
+      ht_destroy(rules->index);
+    }
+    free(rules->metrics);
+    free(rules->rules);
+    free(rules);
+    rules = NULL;
+    goto exit_label;
+  }
+  rules->max_metrics = EVEL_RULES_INITIAL_METRICS;
+  rules->max_rules = EVEL_RULES_INITIAL_RULES;
+  pthread_mutex_init(&rules->mutex, NULL);
+
+exit_label:
+  EVEL_EXIT();
+  return rules;
+}
+
+/**************************************************************************//**
+ * Free a rule.
+ *
+ * @param rule      The rule.
+ *****************************************************************************/
+static void evel_free_rule(EVEL_RULE * rule)
+{
+  free(rule->name);
+  free(rule->description);
+  free(rule);
+}
+
+/**************************************************************************//**
+ * Free a rule set.  No alert is raised for rules which are still raised.
+ *
+ * @param rules     The rule set.
+ *****************************************************************************/
+void evel_free_rules(EVEL_RULES * rules)
+{
+  int ii;
+
+  EVEL_ENTER();
+
+  if (rules == NULL)
+  {
+    goto exit_label;
+  }
+
+  for (ii = 0; ii < rules->num_rules; ii++)
+  {
+    evel_free_rule(rules->rules[ii]);
+  }
+  free(rules->rules);
+
+  /***************************************************************************/
+  /* The metrics themselves belong to the index.                             */
+  /***************************************************************************/
+  for (ii = 0; ii < rules->num_metrics; ii++)
+  {
+    free(rules->metrics[ii]->name);
+    free(rules->metrics[ii]->readers);
+  }
+  free(rules->metrics);
+  ht_destroy(rules->index);
+  pthread_mutex_destroy(&rules->mutex);
+  free(rules);
+
+exit_label:
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Find a metric by name, adding it if it is new.  Called with the rule
+ * set's mutex held.
+ *
+ * @param rules     The rule set.
+ * @param name      ASCIIZ name of the metric.
+ *
+ * @returns The metric, or NULL if it could not be added.
+ *****************************************************************************/
+static EVEL_RULE_METRIC * evel_rules_metric_get(EVEL_RULES * const rules,
+                                                const char * const name)
+{
+  EVEL_RULE_METRIC * metric;
+  EVEL_RULE_METRIC ** metrics;
+
+  metric = ht_get(rules->index, (char *) name);
+  if (metric != NULL)
+  {
+    return metric;
+  }
+
+  if (rules->num_metrics == rules->max_metrics)
+  {
+    metrics = realloc(rules->metrics,
+                      2 * rules->max_metrics * sizeof(EVEL_RULE_METRIC *));
+    if (metrics == NULL)
+    {
+      log_error_state("Failed to grow rule metrics");
+      return NULL;
+    }
+    rules->metrics = metrics;
+    rules->max_metrics *= 2;
+  }
+
+  metric = calloc(1, sizeof(EVEL_RULE_METRIC));
+  if (metric == NULL || (metric->name = strdup(name)) == NULL)
+  {
+    log_error_state("Failed to allocate rule metric");
+    free(metric);
+    return NULL;
+  }
+  metric->id = rules->num_metrics;
+  ht_set(rules->index, metric->name, metric);
+  rules->metrics[rules->num_metrics++] = metric;
+
+  return metric;
+}
+
+/**************************************************************************//**
+ * Get the identifier of a metric, for passing samples of it to
+ * evel_rules_sample().
+ *
+ * @param rules     The rule set.
+ * @param name      ASCIIZ name of the metric.
+ *
+ * @returns The identifier, or -1 if the metric could not be added.
+ *****************************************************************************/
+int evel_rules_metric(EVEL_RULES * const rules, const char * const name)
+{
+  EVEL_RULE_METRIC * metric;
+  int id = -1;
+
+  assert(rules != NULL);
+  assert(name != NULL);
+
+  pthread_mutex_lock(&rules->mutex);
+  metric = evel_rules_metric_get(rules, name);
+  if (metric != NULL)
+  {
+    id = metric->id;
+  }
+  pthread_mutex_unlock(&rules->mutex);
+
+  return id;
+}
+
+/**************************************************************************//**
+ * Add a rule to the list of rules reading a metric.
+ *
+ * @param metric    The metric.
+ * @param rule      The rule.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success.
+ * @retval  EVEL_OUT_OF_MEMORY The list could not be grown.
+ *****************************************************************************/
+static EVEL_ERR_CODES evel_rules_reader_add(EVEL_RULE_METRIC * const metric,
+                                            EVEL_RULE * const rule)
+{
+  EVEL_RULE ** readers;
+  int max_readers;
+
+  if (metric->num_readers == metric->max_readers)
+  {
+    max_readers = metric->max_readers == 0 ? EVEL_RULES_INITIAL_READERS :
+                                             2 * metric->max_readers;
+    readers = realloc(metric->readers, max_readers * sizeof(EVEL_RULE *));
+    if (readers == NULL)
+    {
+      log_error_state("Failed to grow rule metric readers");
+      return EVEL_OUT_OF_MEMORY;
+    }
+    metric->readers = readers;
+    metric->max_readers = max_readers;
+  }
+  metric->readers[metric->num_readers++] = rule;
+
+  return EVEL_SUCCESS;
+}
+
+/**************************************************************************//**
+ * Add a rule.
+ *
+ * @param rules     The rule set.
+ * @param spec      The rule.  The library takes copies of the strings.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success.
+ * @retval  EVEL_OUT_OF_MEMORY The rule could not be added.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_rules_add(EVEL_RULES * const rules,
+                              const EVEL_RULE_SPEC * const spec)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  EVEL_RULE * rule = NULL;
+  EVEL_RULE ** list;
+
+  EVEL_ENTER();
+
+  assert(rules != NULL);
+  assert(spec != NULL);
+  assert(spec->name != NULL);
+  assert(spec->metric != NULL);
+  assert(spec->type < EVEL_MAX_RULE_TYPES);
+  assert(spec->direction < EVEL_MAX_RULE_DIRECTIONS);
+  assert(spec->type != EVEL_RULE_RATIO || spec->denominator != NULL);
+  assert(spec->severity < EVEL_MAX_SEVERITIES);
+  assert(spec->alert_type < EVEL_MAX_ANOMALY);
+
+  rule = calloc(1, sizeof(EVEL_RULE));
+  if (rule == NULL)
+  {
+    log_error_state("Failed to allocate rule");
+    rc = EVEL_OUT_OF_MEMORY;
+    goto exit_label;
+  }
+  rule->name = strdup(spec->name);
+  rule->description = strdup(spec->description != NULL ? spec->description :
+                                                          spec->name);
+  if (rule->name == NULL || rule->description == NULL)
+  {
+    log_error_state("Failed to allocate rule");
+    evel_free_rule(rule);
+    rc = EVEL_OUT_OF_MEMORY;
+    goto exit_label;
+  }
+  rule->type = spec->type;
+  rule->direction = spec->direction;
+  rule->set_threshold = spec->set_threshold;
+  rule->clear_threshold = spec->clear_threshold;
+
+  /***************************************************************************/
+  /* A clear threshold on the wrong side of the set threshold would let the  */
+  /* rule be raised and cleared by the same value.                           */
+  /***************************************************************************/
+  if ((rule->direction == EVEL_RULE_ABOVE &&
+       rule->clear_threshold > rule->set_threshold) ||
+      (rule->direction == EVEL_RULE_BELOW &&
+       rule->clear_threshold < rule->set_threshold))
+  {
+    EVEL_ERROR("Rule %s clear threshold is past its set threshold",
+               rule->name);
+    rule->clear_threshold = rule->set_threshold;
+  }
+  rule->set_after_usec = spec->set_after_ms * 1000ULL;
+  rule->clear_after_usec = spec->clear_after_ms * 1000ULL;
+  rule->severity = spec->severity;
+  rule->alert_type = spec->alert_type;
+  rule->context = spec->context;
+
+  pthread_mutex_lock(&rules->mutex);
+  if (rules->num_rules == rules->max_rules)
+  {
+    list = realloc(rules->rules, 2 * rules->max_rules * sizeof(EVEL_RULE *));
+    if (list == NULL)
+    {
+      log_error_state("Failed to grow rules");
+      rc = EVEL_OUT_OF_MEMORY;
+      goto unlock_label;
+    }
+    rules->rules = list;
+    rules->max_rules *= 2;
+  }
+
+  rule->metric = evel_rules_metric_get(rules, spec->metric);
+  if (rule->metric == NULL)
+  {
+    rc = EVEL_OUT_OF_MEMORY;
+    goto unlock_label;
+  }
+  if (rule->type == EVEL_RULE_RATIO)
+  {
+    rule->denominator = evel_rules_metric_get(rules, spec->denominator);
+    if (rule->denominator == NULL)
+    {
+      rc = EVEL_OUT_OF_MEMORY;
+      goto unlock_label;
+    }
+  }
+
+  /***************************************************************************/
+  /* A ratio is evaluated at the end of each round rather than on a sample.  */
+  /***************************************************************************/
+  if (rule->type != EVEL_RULE_RATIO)
+  {
+    rc = evel_rules_reader_add(rule->metric, rule);
+    if (rc != EVEL_SUCCESS)
+    {
+      goto unlock_label;
+    }
+  }
+  rules->rules[rules->num_rules++] = rule;
+  rule = NULL;
+
+unlock_label:
+  pthread_mutex_unlock(&rules->mutex);
+  if (rule != NULL)
+  {
+    evel_free_rule(rule);
+  }
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Get the value a rule compares against its thresholds.
+ *
+ * @param rule        The rule.
+ * @param[out] value  The value.
+ *
+ * @returns Non-zero if there is a value, or zero if there are not yet
+ *          enough samples, or a ratio's denominator is zero.
+ *****************************************************************************/
+static int evel_rule_value(const EVEL_RULE * const rule, double * value)
+{
+  switch (rule->type)
+  {
+    case EVEL_RULE_ABSOLUTE:
+      *value = rule->metric->value;
+      return rule->metric->valid;
+
+    case EVEL_RULE_RATE:
+      *value = rule->metric->rate;
+      return rule->metric->rate_valid;
+
+    case EVEL_RULE_RATIO:
+      if (!rule->metric->valid ||
+          !rule->denominator->valid ||
+          rule->denominator->value == 0.0)
+      {
+        return 0;
+      }
+      *value = rule->metric->value / rule->denominator->value;
+      return 1;
+
+    default:
+      assert(0);
+      return 0;
+  }
+}
+
+/**************************************************************************//**
+ * Evaluate a rule after its metrics have been sampled, raising or
+ * clearing it once its condition has held for long enough.
+ *
+ * @param rules     The rule set.
+ * @param rule      The rule.
+ * @param now       Time of the sample.
+ *****************************************************************************/
+static void evel_rule_evaluate(EVEL_RULES * const rules,
+                               EVEL_RULE * const rule,
+                               const unsigned long long now)
+{
+  double value;
+  int crossed;
+  unsigned long long delay;
+
+  if (!evel_rule_value(rule, &value))
+  {
+    return;
+  }
+
+  if (!rule->raised)
+  {
+    crossed = (rule->direction == EVEL_RULE_ABOVE) ?
+                value > rule->set_threshold :
+                value < rule->set_threshold;
+    delay = rule->set_after_usec;
+  }
+  else
+  {
+    crossed = (rule->direction == EVEL_RULE_ABOVE) ?
+                value <= rule->clear_threshold :
+                value >= rule->clear_threshold;
+    delay = rule->clear_after_usec;
+  }
+
+  if (!crossed)
+  {
+    rule->pending = 0;
+    return;
+  }
+  if (!rule->pending)
+  {
+    rule->pending = 1;
+    rule->pending_since = now;
+  }
+  if (now - rule->pending_since < delay)
+  {
+    return;
+  }
+
+  rule->pending = 0;
+  rule->raised = !rule->raised;
+  if (rule->raised)
+  {
+    rule->raised_at = now;
+  }
+  evel_rule_alert(rules,
+                  rule,
+                  rule->raised ? EVEL_EVENT_ACTION_SET :
+                                 EVEL_EVENT_ACTION_CLEAR,
+                  value,
+                  now);
+}
+
+/**************************************************************************//**
+ * Tell the owner of the rule set that a rule has been raised or cleared.
+ *
+ * @param rules     The rule set.
+ * @param rule      The rule.
+ * @param action    Whether the rule was raised or cleared.
+ * @param value     The value which raised or cleared it.
+ * @param now       Time of the sample.
+ *****************************************************************************/
+static void evel_rule_alert(EVEL_RULES * const rules,
+                            EVEL_RULE * const rule,
+                            const EVEL_EVENT_ACTION action,
+                            const double value,
+                            const unsigned long long now)
+{
+  EVEL_RULE_ALERT alert;
+
+  alert.rule = rule->name;
+  alert.metric = rule->metric->name;
+  alert.description = rule->description;
+  alert.action = action;
+  alert.value = value;
+  alert.threshold = (action == EVEL_EVENT_ACTION_SET) ?
+                      rule->set_threshold : rule->clear_threshold;
+  alert.severity = (action == EVEL_EVENT_ACTION_SET) ?
+                     rule->severity : EVEL_SEVERITY_NORMAL;
+  alert.alert_type = rule->alert_type;
+  alert.context = rule->context;
+  alert.start_usec = rule->raised_at;
+  alert.now_usec = now;
+
+  EVEL_DEBUG("Rule %s %s at %f",
+             rule->name,
+             (action == EVEL_EVENT_ACTION_SET) ? "raised" : "cleared",
+             value);
+  (*rules->alert)(rules->context, &alert);
+}
+
+/**************************************************************************//**
+ * Record a sample of a metric, and evaluate the rules which read it.
+ *
+ * @param rules     The rule set.
+ * @param metric    Identifier of the metric, from evel_rules_metric().
+ * @param value     The sample.
+ * @param timestamp When the sample was taken, in microseconds from
+ *                  evel_time_monotonic_usec().
+ *****************************************************************************/
+void evel_rules_sample(EVEL_RULES * const rules,
+                       const int metric,
+                       const double value,
+                       const unsigned long long timestamp)
+{
+  EVEL_RULE_METRIC * sampled;
+  int ii;
+
+  assert(rules != NULL);
+
+  pthread_mutex_lock(&rules->mutex);
+  assert(metric >= 0 && metric < rules->num_metrics);
+  sampled = rules->metrics[metric];
+
+  if (sampled->valid && timestamp > sampled->timestamp)
+  {
+    sampled->rate = (value - sampled->value) * 1000000.0 /
+                    (double) (timestamp - sampled->timestamp);
+    sampled->rate_valid = 1;
+  }
+  sampled->value = value;
+  sampled->timestamp = timestamp;
+  sampled->valid = 1;
+  sampled->round = rules->round;
+
+  for (ii = 0; ii < sampled->num_readers; ii++)
+  {
+    evel_rule_evaluate(rules, sampled->readers[ii], timestamp);
+  }
+  pthread_mutex_unlock(&rules->mutex);
+}
+
+/**************************************************************************//**
+ * End a round of samples, evaluating the ratios both of whose metrics were
+ * sampled in it.
+ *
+ * @param rules     The rule set.
+ *****************************************************************************/
+void evel_rules_round_end(EVEL_RULES * const rules)
+{
+  EVEL_RULE * rule;
+  unsigned long long now;
+  int ii;
+
+  assert(rules != NULL);
+
+  pthread_mutex_lock(&rules->mutex);
+  for (ii = 0; ii < rules->num_rules; ii++)
+  {
+    rule = rules->rules[ii];
+    if (rule->type != EVEL_RULE_RATIO ||
+        !rule->metric->valid || rule->metric->round != rules->round ||
+        !rule->denominator->valid || rule->denominator->round != rules->round)
+    {
+      continue;
+    }
+    now = (rule->metric->timestamp > rule->denominator->timestamp) ?
+            rule->metric->timestamp : rule->denominator->timestamp;
+    evel_rule_evaluate(rules, rule, now);
+  }
+  rules->round++;
+  pthread_mutex_unlock(&rules->mutex);
+}
+
+/**************************************************************************//**
+ * Create a Threshold Crossing Alert for a rule being raised or cleared.
+ *
+ * @param alert       The alert.
+ * @param ev_name     ASCIIZ event name.
+ * @param ev_id       ASCIIZ event identifier.
+ *
+ * @returns pointer to the new event, which the caller posts or frees.
+ * @retval  NULL  Failed to create the event.
+ *****************************************************************************/
+EVENT_THRESHOLD_CROSS * evel_rules_new_threshold_cross(
+                                          const EVEL_RULE_ALERT * const alert,
+                                          const char * const ev_name,
+                                          const char * const ev_id)
+{
+  EVENT_THRESHOLD_CROSS * event = NULL;
+  unsigned long long offset;
+  char value[EVEL_RULES_VALUE_LEN];
+  char threshold[EVEL_RULES_VALUE_LEN];
+
+  EVEL_ENTER();
+
+  assert(alert != NULL);
+  assert(ev_name != NULL);
+  assert(ev_id != NULL);
+
+  /***************************************************************************/
+  /* Samples are timed on the monotonic clock; the event needs wall-clock    */
+  /* times.                                                                  */
+  /***************************************************************************/
+  offset = evel_time_now_usec(EVEL_CLOCK_EXACT) - evel_time_monotonic_usec();
+
+  snprintf(value, sizeof(value), "%.2f", alert->value);
+  snprintf(threshold, sizeof(threshold), "%.2f", alert->threshold);
+  event = evel_new_threshold_cross(
+                          ev_name,
+                          ev_id,
+                          alert->severity == EVEL_SEVERITY_CRITICAL ||
+                          alert->severity == EVEL_SEVERITY_MAJOR ? "MAJ" :
+                                                                   "MIN",
+                          (char *) alert->metric,
+                          threshold,
+                          value,
+                          alert->action,
+                          (char *) alert->description,
+                          alert->alert_type,
+                          offset + alert->now_usec,
+                          alert->severity,
+                          offset + alert->start_usec);
+  if (event == NULL)
+  {
+    goto exit_label;
+  }
+  evel_threshold_cross_alertid_add(event, (char *) alert->rule);
+  evel_threshold_cross_alertvalue_set(event, value);
+  evel_start_epoch_set(&event->header, offset + alert->start_usec);
+  evel_last_epoch_set(&event->header, offset + alert->now_usec);
+
+exit_label:
+  EVEL_EXIT();
+  return event;
+}
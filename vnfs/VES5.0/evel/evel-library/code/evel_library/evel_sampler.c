@@ -0,0 +1,764 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * High-frequency sampling of metrics between measurement intervals.
+ *
+ * A measurement sent every 10 to 60 seconds only shows the average over the
+ * interval, hiding short bursts.  The sampler reads each metric several
+ * times a second on its own thread and folds every sample into an
+ * ::EVEL_STATS, which keeps the min, max and mean exactly and percentiles
+ * to within one histogram bucket, in fixed space.  At the end of each
+ * interval the reporter collects the statistics into its Measurement.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Initial number of metrics a sampler has space for, grown as needed.       */
+/*****************************************************************************/
+#define EVEL_SAMPLER_INITIAL_METRICS 8
+
+/*****************************************************************************/
+/* Space for a number formatted as an Additional Measurement value.          */
+/*****************************************************************************/
+#define EVEL_SAMPLE_VALUE_LEN 32
+
+/**************************************************************************//**
+ * A metric being sampled.
+ *****************************************************************************/
+typedef struct evel_sample_metric {
+  char * name;
+  EVEL_SAMPLE_TYPES type;
+  int distribution;
+  EVEL_SAMPLE_READ_FN read;
+  void * context;
+  EVEL_COUNTER counter;
+  EVEL_STATS stats;
+  int rule_metric;
+} EVEL_SAMPLE_METRIC;
+
+/**************************************************************************//**
+ * Sampler state.  The mutex protects the metrics against collection while
+ * the thread is sampling them.
+ *****************************************************************************/
+struct evel_sampler {
+  int period_ms;
+  EVEL_SAMPLE_ROUND_FN round;
+  void * context;
+  int num_metrics;
+  int max_metrics;
+  EVEL_SAMPLE_METRIC ** metrics;
+  EVEL_RULES * rules;
+  pthread_mutex_t mutex;
+  pthread_t thread;
+  int running;
+};
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static int evel_stats_bucket(const double value);
+static void evel_stats_bucket_range(const int bucket,
+                                    double * low,
+                                    double * high);
+static void evel_stats_value_add(EVENT_MEASUREMENT * const measurement,
+                                 const char * const group,
+                                 const char * const name,
+                                 const double value);
+static void evel_sampler_round(EVEL_SAMPLER * const sampler);
+static void * evel_sampler_thread(void * arg);
+
+/**************************************************************************//**
+ * Clear a set of statistics.
+ *
+ * @param stats     The statistics.
+ *****************************************************************************/
+void evel_stats_reset(EVEL_STATS * const stats)
+{
+  assert(stats != NULL);
+
+  memset(stats, 0, sizeof(EVEL_STATS));
+}
+
+/**************************************************************************//**
+ * Find the histogram bucket for a value.
+ *
+ * @param value     The value.
+ *
+ * @returns Index of the bucket.
+ *****************************************************************************/
+static int evel_stats_bucket(const double value)
+{
+  unsigned long long whole;
+  int exponent;
+  int sub_bucket;
+
+  if (!(value >= 1.0))
+  {
+    return 0;
+  }
+  if (value >= (double) (1ULL << EVEL_STATS_MAX_EXPONENT))
+  {
+    return EVEL_STATS_BUCKETS - 1;
+  }
+
+  /***************************************************************************/
+  /* The power of two is the top bit of the integer part; the sub-bucket is  */
+  /* how far the value is through that power of two.                         */
+  /***************************************************************************/
+  whole = (unsigned long long) value;
+  exponent = 63 - __builtin_clzll(whole);
+  sub_bucket = (int) ((value / (double) (1ULL << exponent) - 1.0) *
+                      EVEL_STATS_SUB_BUCKETS);
+  if (sub_bucket >= EVEL_STATS_SUB_BUCKETS)
+  {
+    sub_bucket = EVEL_STATS_SUB_BUCKETS - 1;
+  }
+
+  return 1 + exponent * EVEL_STATS_SUB_BUCKETS + sub_bucket;
+}
+
+/**************************************************************************//**
+ * Get the range of values counted in a histogram bucket.
+ *
+ * @param bucket      Index of the bucket.
+ * @param[out] low    The low end of the range.
+ * @param[out] high   The high end of the range.
+ *****************************************************************************/
+static void evel_stats_bucket_range(const int bucket,
+                                    double * low,
+                                    double * high)
+{
+  double base;
+  int sub_bucket;
+
+  assert(bucket >= 0 && bucket < EVEL_STATS_BUCKETS);
+
+  if (bucket == 0)
+  {
+    *low = 0.0;
+    *high = 1.0;
+    return;
+  }
+
+  base = (double) (1ULL << ((bucket - 1) / EVEL_STATS_SUB_BUCKETS));
+  sub_bucket = (bucket - 1) % EVEL_STATS_SUB_BUCKETS;
+  *low = base + base * sub_bucket / EVEL_STATS_SUB_BUCKETS;
+  *high = base + base * (sub_bucket + 1) / EVEL_STATS_SUB_BUCKETS;
+}
+
+/**************************************************************************//**
+ * Add a sample to a set of statistics.
+ *
+ * @param stats     The statistics.
+ * @param value     The sample.  Negative values count as zero in the
+ *                  histogram.
+ *****************************************************************************/
+void evel_stats_add(EVEL_STATS * const stats, const double value)
+{
+  int bucket;
+
+  assert(stats != NULL);
+
+  if (stats->count == 0 || value < stats->min)
+  {
+    stats->min = value;
+  }
+  if (stats->count == 0 || value > stats->max)
+  {
+    stats->max = value;
+  }
+  stats->count++;
+  stats->sum += value;
+
+  bucket = evel_stats_bucket(value);
+  if (stats->buckets[bucket] < UINT_MAX)
+  {
+    stats->buckets[bucket]++;
+  }
+}
+
+/**************************************************************************//**
+ * Get the mean of a set of statistics.
+ *
+ * @param stats     The statistics.
+ *
+ * @returns The mean, or 0 if there are no samples.
+ *****************************************************************************/
+double evel_stats_mean(const EVEL_STATS * const stats)
+{
+  assert(stats != NULL);
+
+  if (stats->count == 0)
+  {
+    return 0.0;
+  }
+  return stats->sum / (double) stats->count;
+}
+
+/**************************************************************************//**
+ * Estimate a percentile of a set of statistics.
+ *
+ * Finds the bucket holding the sample at that rank and assumes the samples
+ * in it are spread evenly across its range, bounded by the exact min and
+ * max.
+ *
+ * @param stats       The statistics.
+ * @param percentile  The percentile, from 0 to 100.
+ *
+ * @returns The estimate, or 0 if there are no samples.
+ *****************************************************************************/
+double evel_stats_percentile(const EVEL_STATS * const stats,
+                             const double percentile)
+{
+  double rank;
+  double below = 0.0;
+  double low;
+  double high;
+  double estimate;
+  int bucket;
+
+  assert(stats != NULL);
+  assert(percentile >= 0.0 && percentile <= 100.0);
+
+  if (stats->count == 0)
+  {
+    return 0.0;
+  }
+
+  rank = percentile * (double) stats->count / 100.0;
+  for (bucket = 0; bucket < EVEL_STATS_BUCKETS - 1; bucket++)
+  {
+    if (stats->buckets[bucket] > 0 &&
+        below + stats->buckets[bucket] >= rank)
+    {
+      break;
+    }
+    below += stats->buckets[bucket];
+  }
+
+  evel_stats_bucket_range(bucket, &low, &high);
+  if (low < stats->min || bucket == 0)
+  {
+    low = stats->min;
+  }
+  if (high > stats->max)
+  {
+    high = stats->max;
+  }
+  if (stats->buckets[bucket] > 0)
+  {
+    estimate = low + (high - low) * (rank - below) / stats->buckets[bucket];
+  }
+  else
+  {
+    estimate = high;
+  }
+  return estimate;
+}
+
+/**************************************************************************//**
+ * Add a number to an Additional Measurements group.
+ *
+ * @param measurement   Pointer to the Measurement.
+ * @param group         ASCIIZ name of the group.
+ * @param name          ASCIIZ name of the value.
+ * @param value         The value.
+ *****************************************************************************/
+static void evel_stats_value_add(EVENT_MEASUREMENT * const measurement,
+                                 const char * const group,
+                                 const char * const name,
+                                 const double value)
+{
+  char text[EVEL_SAMPLE_VALUE_LEN];
+
+  snprintf(text, sizeof(text), "%.2f", value);
+  evel_measurement_custom_measurement_add(measurement, group, name, text);
+}
+
+/**************************************************************************//**
+ * Add a set of statistics to a Measurement as an Additional Measurements
+ * group.
+ *
+ * @param measurement   Pointer to the Measurement.
+ * @param group         ASCIIZ name of the group.
+ * @param stats         The statistics.
+ *****************************************************************************/
+void evel_stats_measurement_add(EVENT_MEASUREMENT * const measurement,
+                                const char * const group,
+                                const EVEL_STATS * const stats)
+{
+  char text[EVEL_SAMPLE_VALUE_LEN];
+
+  EVEL_ENTER();
+
+  assert(measurement != NULL);
+  assert(group != NULL);
+  assert(stats != NULL);
+
+  snprintf(text, sizeof(text), "%llu", stats->count);
+  evel_measurement_custom_measurement_add(measurement, group, "samples", text);
+  if (stats->count > 0)
+  {
+    evel_stats_value_add(measurement, group, "min", stats->min);
+    evel_stats_value_add(measurement, group, "max", stats->max);
+    evel_stats_value_add(measurement, group, "mean", evel_stats_mean(stats));
+    evel_stats_value_add(measurement, group, "p50",
+                         evel_stats_percentile(stats, 50.0));
+    evel_stats_value_add(measurement, group, "p90",
+                         evel_stats_percentile(stats, 90.0));
+    evel_stats_value_add(measurement, group, "p99",
+                         evel_stats_percentile(stats, 99.0));
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Add the histogram of a set of statistics to a Measurement's Latency
+ * Distribution.
+ *
+ * @param measurement   Pointer to the Measurement.
+ * @param stats         The statistics.
+ *****************************************************************************/
+void evel_stats_latency_buckets_add(EVENT_MEASUREMENT * const measurement,
+                                    const EVEL_STATS * const stats)
+{
+  MEASUREMENT_LATENCY_BUCKET * bucket = NULL;
+  double low;
+  double high;
+  int ii;
+
+  EVEL_ENTER();
+
+  assert(measurement != NULL);
+  assert(stats != NULL);
+
+  for (ii = 0; ii < EVEL_STATS_BUCKETS; ii++)
+  {
+    if (stats->buckets[ii] == 0)
+    {
+      continue;
+    }
+    evel_stats_bucket_range(ii, &low, &high);
+    bucket = evel_new_meas_latency_bucket(stats->buckets[ii] > INT_MAX ?
+                                            INT_MAX :
+                                            (int) stats->buckets[ii]);
+    evel_meas_latency_bucket_low_end_set(bucket, low);
+    evel_meas_latency_bucket_high_end_set(bucket, high);
+    evel_meas_latency_bucket_add(measurement, bucket);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Create a sampler.
+ *
+ * @param period_ms   Sampling period in milliseconds.
+ * @param round       Function to call before each round of reads, or NULL.
+ * @param context     Context passed to round.
+ *
+ * @returns pointer to the new sampler.
+ * @retval  NULL  Failed to create the sampler.
+ *****************************************************************************/
+EVEL_SAMPLER * evel_new_sampler(const int period_ms,
+                                EVEL_SAMPLE_ROUND_FN round,
+                                void * context)
+{
+  EVEL_SAMPLER * sampler = NULL;
+
+  EVEL_ENTER();
+
+  assert(period_ms > 0);
+
+  sampler = malloc(sizeof(EVEL_SAMPLER));
+  if (sampler == NULL)
+  {
+    log_error_state("Failed to allocate sampler");
+    goto exit_label;
+  }
+  memset(sampler, 0, sizeof(EVEL_SAMPLER));
+  sampler->metrics = malloc(EVEL_SAMPLER_INITIAL_METRICS *
+                            sizeof(EVEL_SAMPLE_METRIC *));
+  if (sampler->metrics == NULL)
+  {
+    log_error_state("Failed to allocate sampler metrics");
+    free(sampler);
+    sampler = NULL;
+    goto exit_label;
+  }
+  sampler->max_metrics = EVEL_SAMPLER_INITIAL_METRICS;
+  sampler->period_ms = period_ms;
+  sampler->round = round;
+  sampler->context = context;
+  pthread_mutex_init(&sampler->mutex, NULL);
+
+exit_label:
+  EVEL_EXIT();
+  return sampler;
+}
+
+/**************************************************************************//**
+ * Stop a sampler if it is running, and free it.
+ *
+ * @param sampler   The sampler.
+ *****************************************************************************/
+void evel_free_sampler(EVEL_SAMPLER * sampler)
+{
+  int ii;
+
+  EVEL_ENTER();
+
+  if (sampler == NULL)
+  {
+    goto exit_label;
+  }
+
+  evel_sampler_stop(sampler);
+  for (ii = 0; ii < sampler->num_metrics; ii++)
+  {
+    free(sampler->metrics[ii]->name);
+    free(sampler->metrics[ii]);
+  }
+  free(sampler->metrics);
+  pthread_mutex_destroy(&sampler->mutex);
+  free(sampler);
+
+exit_label:
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Add a metric to a sampler.
+ *
+ * @param sampler       The sampler.
+ * @param name          ASCIIZ name of the metric.
+ * @param type          Whether to sample the value or its rate.
+ * @param distribution  Non-zero to also collect the metric's histogram as
+ *                      the Measurement's Latency Distribution.
+ * @param read          Function to read the metric.
+ * @param context       Context passed to read.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success.
+ * @retval  EVEL_OUT_OF_MEMORY The metric could not be added.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_sampler_metric_add(EVEL_SAMPLER * const sampler,
+                                       const char * const name,
+                                       const EVEL_SAMPLE_TYPES type,
+                                       const int distribution,
+                                       EVEL_SAMPLE_READ_FN read,
+                                       void * context)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  EVEL_SAMPLE_METRIC * metric = NULL;
+  EVEL_SAMPLE_METRIC ** metrics = NULL;
+
+  EVEL_ENTER();
+
+  assert(sampler != NULL);
+  assert(name != NULL);
+  assert(type < EVEL_MAX_SAMPLE_TYPES);
+  assert(read != NULL);
+
+  metric = malloc(sizeof(EVEL_SAMPLE_METRIC));
+  if (metric == NULL)
+  {
+    log_error_state("Failed to allocate sampled metric");
+    rc = EVEL_OUT_OF_MEMORY;
+    goto exit_label;
+  }
+  memset(metric, 0, sizeof(EVEL_SAMPLE_METRIC));
+  metric->name = strdup(name);
+  if (metric->name == NULL)
+  {
+    log_error_state("Failed to allocate sampled metric name");
+    free(metric);
+    rc = EVEL_OUT_OF_MEMORY;
+    goto exit_label;
+  }
+  metric->type = type;
+  metric->distribution = distribution;
+  metric->read = read;
+  metric->context = context;
+  evel_counter_init(&metric->counter, EVEL_COUNTER_AUTO);
+
+  pthread_mutex_lock(&sampler->mutex);
+  metric->rule_metric = -1;
+  if (sampler->rules != NULL)
+  {
+    metric->rule_metric = evel_rules_metric(sampler->rules, name);
+  }
+  if (sampler->num_metrics == sampler->max_metrics)
+  {
+    metrics = realloc(sampler->metrics,
+                      2 * sampler->max_metrics * sizeof(EVEL_SAMPLE_METRIC *));
+    if (metrics == NULL)
+    {
+      pthread_mutex_unlock(&sampler->mutex);
+      log_error_state("Failed to grow sampler metrics");
+      free(metric->name);
+      free(metric);
+      rc = EVEL_OUT_OF_MEMORY;
+      goto exit_label;
+    }
+    sampler->metrics = metrics;
+    sampler->max_metrics *= 2;
+  }
+  sampler->metrics[sampler->num_metrics++] = metric;
+  pthread_mutex_unlock(&sampler->mutex);
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Take one sample of every metric.  Called with the sampler's mutex held.
+ *
+ * @param sampler   The sampler.
+ *****************************************************************************/
+static void evel_sampler_round(EVEL_SAMPLER * const sampler)
+{
+  EVEL_SAMPLE_METRIC * metric;
+  unsigned long long value;
+  unsigned long long now;
+  double sample;
+  int had_reading;
+  int ii;
+
+  if (sampler->round != NULL &&
+      (*sampler->round)(sampler->context) != EVEL_SUCCESS)
+  {
+    return;
+  }
+
+  for (ii = 0; ii < sampler->num_metrics; ii++)
+  {
+    metric = sampler->metrics[ii];
+    if ((*metric->read)(metric->context, &value) != EVEL_SUCCESS)
+    {
+      continue;
+    }
+
+    now = evel_time_monotonic_usec();
+    if (metric->type == EVEL_SAMPLE_RATE)
+    {
+      had_reading = metric->counter.valid;
+      evel_counter_update(&metric->counter, value, now);
+      if (!had_reading)
+      {
+        continue;
+      }
+      sample = metric->counter.rate;
+    }
+    else
+    {
+      sample = (double) value;
+    }
+
+    evel_stats_add(&metric->stats, sample);
+    if (sampler->rules != NULL && metric->rule_metric >= 0)
+    {
+      evel_rules_sample(sampler->rules, metric->rule_metric, sample, now);
+    }
+  }
+
+  if (sampler->rules != NULL)
+  {
+    evel_rules_round_end(sampler->rules);
+  }
+}
+
+/**************************************************************************//**
+ * Sampler thread: sample every metric once per period.
+ *
+ * Sleeps until absolute times on the monotonic clock, so that the time
+ * taken by each round does not add to the period.
+ *
+ * @param arg   The sampler.
+ *****************************************************************************/
+static void * evel_sampler_thread(void * arg)
+{
+  EVEL_SAMPLER * sampler = (EVEL_SAMPLER *) arg;
+  struct timespec next;
+
+  clock_gettime(CLOCK_MONOTONIC, &next);
+  while (__atomic_load_n(&sampler->running, __ATOMIC_ACQUIRE))
+  {
+    pthread_mutex_lock(&sampler->mutex);
+    evel_sampler_round(sampler);
+    pthread_mutex_unlock(&sampler->mutex);
+
+    next.tv_sec += sampler->period_ms / 1000;
+    next.tv_nsec += (sampler->period_ms % 1000) * 1000000L;
+    if (next.tv_nsec >= 1000000000L)
+    {
+      next.tv_sec++;
+      next.tv_nsec -= 1000000000L;
+    }
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL)
+           == EINTR)
+    {
+    }
+  }
+
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Start the sampling thread.
+ *
+ * @param sampler   The sampler.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success, or if the sampler is already running.
+ * @retval  EVEL_PTHREAD_LIBRARY_FAIL The thread could not be started.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_sampler_start(EVEL_SAMPLER * const sampler)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+
+  EVEL_ENTER();
+
+  assert(sampler != NULL);
+
+  if (!sampler->running)
+  {
+    __atomic_store_n(&sampler->running, 1, __ATOMIC_RELEASE);
+    if (pthread_create(&sampler->thread,
+                       NULL,
+                       evel_sampler_thread,
+                       sampler) != 0)
+    {
+      __atomic_store_n(&sampler->running, 0, __ATOMIC_RELEASE);
+      log_error_state("Failed to start sampler thread");
+      rc = EVEL_PTHREAD_LIBRARY_FAIL;
+    }
+  }
+
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Stop the sampling thread.  Waits for at most one period.
+ *
+ * @param sampler   The sampler.
+ *****************************************************************************/
+void evel_sampler_stop(EVEL_SAMPLER * const sampler)
+{
+  EVEL_ENTER();
+
+  assert(sampler != NULL);
+
+  if (sampler->running)
+  {
+    __atomic_store_n(&sampler->running, 0, __ATOMIC_RELEASE);
+    pthread_join(sampler->thread, NULL);
+  }
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Add the statistics of each metric since the last collection to a
+ * Measurement, then start a new interval.
+ *
+ * @param sampler       The sampler.
+ * @param measurement   Pointer to the Measurement.
+ *****************************************************************************/
+void evel_sampler_collect(EVEL_SAMPLER * const sampler,
+                          EVENT_MEASUREMENT * const measurement)
+{
+  EVEL_SAMPLE_METRIC * metric;
+  int ii;
+
+  EVEL_ENTER();
+
+  assert(sampler != NULL);
+  assert(measurement != NULL);
+
+  pthread_mutex_lock(&sampler->mutex);
+  for (ii = 0; ii < sampler->num_metrics; ii++)
+  {
+    metric = sampler->metrics[ii];
+    evel_stats_measurement_add(measurement, metric->name, &metric->stats);
+    if (metric->distribution)
+    {
+      evel_stats_latency_buckets_add(measurement, &metric->stats);
+    }
+    evel_stats_reset(&metric->stats);
+  }
+  pthread_mutex_unlock(&sampler->mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Evaluate a rule set on every sample a sampler takes.
+ *
+ * @param sampler   The sampler.
+ * @param rules     The rule set, or NULL to stop evaluating rules.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success.
+ * @retval  EVEL_OUT_OF_MEMORY A metric could not be added to the rule set.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_sampler_rules_set(EVEL_SAMPLER * const sampler,
+                                      EVEL_RULES * const rules)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  EVEL_SAMPLE_METRIC * metric;
+  int ii;
+
+  EVEL_ENTER();
+
+  assert(sampler != NULL);
+
+  pthread_mutex_lock(&sampler->mutex);
+  sampler->rules = rules;
+  for (ii = 0; ii < sampler->num_metrics; ii++)
+  {
+    metric = sampler->metrics[ii];
+    metric->rule_metric = -1;
+    if (rules != NULL)
+    {
+      metric->rule_metric = evel_rules_metric(rules, metric->name);
+      if (metric->rule_metric < 0)
+      {
+        rc = EVEL_OUT_OF_MEMORY;
+      }
+    }
+  }
+  pthread_mutex_unlock(&sampler->mutex);
+
+  EVEL_EXIT();
+  return rc;
+}
@@ -3070,6 +3070,7 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
 
   evel_json_encode_header(jbuf, &event->header);
   evel_json_open_named_object(jbuf, "measurementsForVfScalingFields");
+  evel_json_expose_object(jbuf, NULL);
 
   /***************************************************************************/
   /* Mandatory fields.                                                       */
@@ -3222,7 +3223,7 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
                                           "cpuUsageArray",
                                           cpu_use->id))
       {
-        evel_json_open_object(jbuf);
+        evel_json_open_delta_object(jbuf, "cpuUsageArray", cpu_use->id);
         evel_enc_kv_string(jbuf, "cpuIdentifier", cpu_use->id);
         evel_enc_kv_opt_double(jbuf, "cpuIdle", &cpu_use->idle);
         evel_enc_kv_opt_double(jbuf, "cpuUsageInterrupt", &cpu_use->intrpt);
@@ -3233,8 +3234,10 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
         evel_enc_kv_opt_double(jbuf, "cpuUsageUser", &cpu_use->user);
         evel_enc_kv_opt_double(jbuf, "cpuWait", &cpu_use->wait);
         evel_enc_kv_double(jbuf, "percentUsage",cpu_use->usage);
-        evel_json_close_object(jbuf);
-        item_added = true;
+        if (evel_json_close_delta_object(jbuf))
+        {
+          item_added = true;
+        }
       }
       item = dlist_get_next(item);
     }
@@ -3268,7 +3271,7 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
                                           "diskUsageArray",
                                           disk_use->id))
       {
-        evel_json_open_object(jbuf);
+        evel_json_open_delta_object(jbuf, "diskUsageArray", disk_use->id);
         evel_enc_kv_string(jbuf, "diskIdentifier", disk_use->id);
         evel_enc_kv_opt_double(jbuf, "diskIoTimeAvg", &disk_use->iotimeavg);
         evel_enc_kv_opt_double(jbuf, "diskIoTimeLast", &disk_use->iotimelast);
@@ -3310,8 +3313,10 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
         evel_enc_kv_opt_double(jbuf, "diskTimeWriteLast", &disk_use->timewritelast);
         evel_enc_kv_opt_double(jbuf, "diskTimeWriteMax", &disk_use->timewritemax);
         evel_enc_kv_opt_double(jbuf, "diskTimeWriteMin", &disk_use->timewritemin);
-        evel_json_close_object(jbuf);
-        item_added = true;
+        if (evel_json_close_delta_object(jbuf))
+        {
+          item_added = true;
+        }
       }
       item = dlist_get_next(item);
     }
@@ -3344,7 +3349,9 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
                                           "filesystemUsageArray",
                                           fsys_use->filesystem_name))
       {
-        evel_json_open_object(jbuf);
+        evel_json_open_delta_object(jbuf,
+                                    "filesystemUsageArray",
+                                    fsys_use->filesystem_name);
         evel_enc_kv_string(jbuf, "filesystemName", fsys_use->filesystem_name);
         evel_enc_kv_double(
           jbuf, "blockConfigured", fsys_use->block_configured);
@@ -3354,8 +3361,10 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
           jbuf, "ephemeralConfigured", fsys_use->ephemeral_configured);
         evel_enc_kv_double(jbuf, "ephemeralIops", fsys_use->ephemeral_iops);
         evel_enc_kv_double(jbuf, "ephemeralUsed", fsys_use->ephemeral_used);
-        evel_json_close_object(jbuf);
-        item_added = true;
+        if (evel_json_close_delta_object(jbuf))
+        {
+          item_added = true;
+        }
       }
       item = dlist_get_next(item);
     }
@@ -3416,7 +3425,9 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
                                           "vNicPerformanceArray",
                                           vnic_performance->vnic_id))
       {
-        evel_json_open_object(jbuf);
+        evel_json_open_delta_object(jbuf,
+                                    "vNicPerformanceArray",
+                                    vnic_performance->vnic_id);
 
         /*********************************************************************/
         /* Optional fields.                                                  */
@@ -3484,8 +3495,10 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
         evel_enc_kv_string(jbuf, "valuesAreSuspect", vnic_performance->valuesaresuspect);
         evel_enc_kv_string(jbuf, "vNicIdentifier", vnic_performance->vnic_id);
 
-        evel_json_close_object(jbuf);
-        item_added = true;
+        if (evel_json_close_delta_object(jbuf))
+        {
+          item_added = true;
+        }
       }
       item = dlist_get_next(item);
     }
@@ -3520,7 +3533,7 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
                                           "memoryUsageArray",
                                           mem_use->id))
       {
-        evel_json_open_object(jbuf);
+        evel_json_open_delta_object(jbuf, "memoryUsageArray", mem_use->id);
         evel_enc_kv_double(jbuf, "memoryBuffered", mem_use->membuffsz);
         evel_enc_kv_opt_double(jbuf, "memoryCached", &mem_use->memcache);
         evel_enc_kv_opt_double(jbuf, "memoryConfigured", &mem_use->memconfig);
@@ -3529,8 +3542,10 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
         evel_enc_kv_opt_double(jbuf, "memorySlabUnrecl", &mem_use->slabunrecl);
         evel_enc_kv_opt_double(jbuf, "memoryUsed", &mem_use->memused);
         evel_enc_kv_string(jbuf, "vmIdentifier", mem_use->id);
-        evel_json_close_object(jbuf);
-        item_added = true;
+        if (evel_json_close_delta_object(jbuf))
+        {
+          item_added = true;
+        }
       }
       item = dlist_get_next(item);
     }
@@ -3558,6 +3573,7 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
       evel_json_open_opt_named_object(jbuf, "errors"))
   {
     errors = event->errors;
+    evel_json_expose_object(jbuf, NULL);
     evel_enc_kv_int(jbuf, "receiveDiscards", errors->receive_discards);
     evel_enc_kv_int(jbuf, "receiveErrors", errors->receive_errors);
     evel_enc_kv_int(jbuf, "transmitDiscards", errors->transmit_discards);
@@ -3584,6 +3600,7 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
                                           feature_use->feature_id))
       {
         evel_json_open_object(jbuf);
+        evel_json_expose_object(jbuf, feature_use->feature_id);
         evel_enc_kv_string(jbuf, "featureIdentifier", feature_use->feature_id);
         evel_enc_kv_int(
           jbuf, "featureUtilization", feature_use->feature_utilization);
@@ -3622,6 +3639,7 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
                                           codec_use->codec_id))
       {
         evel_json_open_object(jbuf);
+        evel_json_expose_object(jbuf, codec_use->codec_id);
         evel_enc_kv_string(jbuf, "codecIdentifier", codec_use->codec_id);
         evel_enc_kv_int(jbuf, "numberInUse", codec_use->number_in_use);
         evel_json_close_object(jbuf);
@@ -3675,6 +3693,10 @@ void evel_json_encode_measurement(EVEL_JSON_BUFFER * jbuf,
           evel_enc_kv_string(jbuf, "name", custom_measurement->name);
           evel_enc_kv_string(jbuf, "value", custom_measurement->value);
           evel_json_close_object(jbuf);
+          evel_json_expose_custom(jbuf,
+                                  measurement_group->name,
+                                  custom_measurement->name,
+                                  custom_measurement->value);
           nested_item = dlist_get_next(nested_item);
         }
         evel_json_close_list(jbuf);
@@ -0,0 +1,714 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Periodic jobs for the reporters.
+ *
+ * The reporters each slept for their interval after doing their work, so
+ * every interval was stretched by the time the work took, and each kind of
+ * fault check needed its own thread.  Here one timer thread reads a
+ * periodic timerfd on the monotonic clock and hands jobs that are due to a
+ * small pool of workers, so a job's runs stay exactly one interval apart.
+ *
+ * Ticks are lined up with the wall clock when the scheduler is created, and
+ * each job runs when the wall-clock time of a tick is a multiple of its
+ * interval.  After that only the monotonic clock is used, so that setting
+ * the system time does not make jobs run early, late or twice.
+ *
+ * Jobs are kept in a hashed timer wheel: each tick only looks at the jobs
+ * in one slot, however many jobs there are, and a job due more than one
+ * turn of the wheel ahead is passed over until the tick it is due.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Number of slots in the timer wheel.                                       */
+/*****************************************************************************/
+#define EVEL_SCHEDULER_SLOTS 512
+
+/**************************************************************************//**
+ * A periodic job.  It is pending from when it is queued until its run
+ * ends, and is never queued twice.
+ *****************************************************************************/
+struct evel_scheduler_job {
+  EVEL_SCHEDULER * scheduler;
+  char * name;
+  int interval_ticks;
+  EVEL_SCHEDULER_FN function;
+  void * context;
+  unsigned long long due;             /** Tick of the next run.              */
+  unsigned long long scheduled;       /** Wall-clock time of the queued run. */
+  int pending;
+  unsigned long long skipped;
+  EVEL_SCHEDULER_JOB * slot_next;
+  EVEL_SCHEDULER_JOB * queue_next;
+  EVEL_SCHEDULER_JOB * all_next;
+};
+
+/**************************************************************************//**
+ * Scheduler state.  The mutex protects the wheel, the queue and the jobs'
+ * scheduling fields.  Times are in microseconds, and tick 0 is at
+ * base_wall on the wall clock and base_mono on the monotonic clock.
+ *****************************************************************************/
+struct evel_scheduler {
+  int num_workers;
+  pthread_t * workers;
+  pthread_t timer_thread;
+  int timer_fd;
+  int stop_fd;
+  unsigned long long base_wall;
+  unsigned long long base_mono;
+  unsigned long long tick;            /** The last tick handled.             */
+  EVEL_SCHEDULER_JOB * wheel[EVEL_SCHEDULER_SLOTS];
+  EVEL_SCHEDULER_JOB * jobs;
+  EVEL_SCHEDULER_JOB * queue_head;
+  EVEL_SCHEDULER_JOB * queue_tail;
+  pthread_mutex_t mutex;
+  pthread_cond_t ready;
+  int running;
+};
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static unsigned long long evel_scheduler_clock(clockid_t clock);
+static unsigned long long evel_scheduler_current_tick(
+                                       const EVEL_SCHEDULER * const scheduler);
+static int evel_scheduler_ticks(const int interval_ms);
+static void evel_scheduler_insert(EVEL_SCHEDULER * const scheduler,
+                                  EVEL_SCHEDULER_JOB * const job);
+static void evel_scheduler_unlink(EVEL_SCHEDULER * const scheduler,
+                                  EVEL_SCHEDULER_JOB * const job);
+static void evel_scheduler_tick(EVEL_SCHEDULER * const scheduler);
+static void * evel_scheduler_timer_thread(void * arg);
+static void * evel_scheduler_worker_thread(void * arg);
+
+/**************************************************************************//**
+ * Read a clock.
+ *
+ * @param clock     The clock.
+ *
+ * @returns The time in microseconds.
+ *****************************************************************************/
+static unsigned long long evel_scheduler_clock(clockid_t clock)
+{
+  struct timespec now;
+
+  clock_gettime(clock, &now);
+  return (unsigned long long) now.tv_sec * 1000000ULL +
+         (unsigned long long) now.tv_nsec / 1000ULL;
+}
+
+/**************************************************************************//**
+ * Work out which tick it is now from the monotonic clock.
+ *
+ * @param scheduler   The scheduler.
+ *
+ * @returns The tick.
+ *****************************************************************************/
+static unsigned long long evel_scheduler_current_tick(
+                                        const EVEL_SCHEDULER * const scheduler)
+{
+  return (evel_scheduler_clock(CLOCK_MONOTONIC) - scheduler->base_mono) /
+                                          (EVEL_SCHEDULER_TICK_MS * 1000ULL);
+}
+
+/**************************************************************************//**
+ * Convert an interval to ticks, rounding up.
+ *
+ * @param interval_ms   Interval in milliseconds.
+ *
+ * @returns The number of ticks, at least 1.
+ *****************************************************************************/
+static int evel_scheduler_ticks(const int interval_ms)
+{
+  int ticks = (interval_ms + EVEL_SCHEDULER_TICK_MS - 1) /
+                                                        EVEL_SCHEDULER_TICK_MS;
+
+  return (ticks > 0) ? ticks : 1;
+}
+
+/**************************************************************************//**
+ * Put a job in the wheel at the first multiple of its interval on the wall
+ * clock after the current tick.  Called with the mutex held.
+ *
+ * @param scheduler   The scheduler.
+ * @param job         The job.
+ *****************************************************************************/
+static void evel_scheduler_insert(EVEL_SCHEDULER * const scheduler,
+                                  EVEL_SCHEDULER_JOB * const job)
+{
+  unsigned long long base;
+  unsigned long long now;
+  EVEL_SCHEDULER_JOB ** slot;
+
+  /***************************************************************************/
+  /* Count ticks from the epoch, where every interval has a boundary.        */
+  /***************************************************************************/
+  base = scheduler->base_wall / (EVEL_SCHEDULER_TICK_MS * 1000ULL);
+  now = base + scheduler->tick;
+  job->due = (now / job->interval_ticks + 1) * job->interval_ticks - base;
+
+  slot = &scheduler->wheel[job->due % EVEL_SCHEDULER_SLOTS];
+  job->slot_next = *slot;
+  *slot = job;
+}
+
+/**************************************************************************//**
+ * Take a job out of the wheel.  Called with the mutex held.
+ *
+ * @param scheduler   The scheduler.
+ * @param job         The job.
+ *****************************************************************************/
+static void evel_scheduler_unlink(EVEL_SCHEDULER * const scheduler,
+                                  EVEL_SCHEDULER_JOB * const job)
+{
+  EVEL_SCHEDULER_JOB ** link;
+
+  for (link = &scheduler->wheel[job->due % EVEL_SCHEDULER_SLOTS];
+       *link != NULL;
+       link = &(*link)->slot_next)
+  {
+    if (*link == job)
+    {
+      *link = job->slot_next;
+      break;
+    }
+  }
+}
+
+/**************************************************************************//**
+ * Queue the jobs due at the current tick, and put them back in the wheel
+ * for their next run.  Called with the mutex held.
+ *
+ * @param scheduler   The scheduler.
+ *****************************************************************************/
+static void evel_scheduler_tick(EVEL_SCHEDULER * const scheduler)
+{
+  EVEL_SCHEDULER_JOB ** link;
+  EVEL_SCHEDULER_JOB * job;
+  EVEL_SCHEDULER_JOB * due = NULL;
+
+  /***************************************************************************/
+  /* Take the due jobs out first, as they may go back into the same slot.    */
+  /***************************************************************************/
+  link = &scheduler->wheel[scheduler->tick % EVEL_SCHEDULER_SLOTS];
+  while ((job = *link) != NULL)
+  {
+    if (job->due != scheduler->tick)
+    {
+      link = &job->slot_next;
+      continue;
+    }
+    *link = job->slot_next;
+    job->slot_next = due;
+    due = job;
+  }
+
+  while ((job = due) != NULL)
+  {
+    due = job->slot_next;
+
+    if (job->pending)
+    {
+      job->skipped++;
+      EVEL_DEBUG("Skipped job %s, still running; %llu skipped",
+                 job->name, job->skipped);
+    }
+    else
+    {
+      job->pending = 1;
+      job->scheduled = scheduler->base_wall +
+                 scheduler->tick * EVEL_SCHEDULER_TICK_MS * 1000ULL;
+      job->queue_next = NULL;
+      if (scheduler->queue_tail != NULL)
+      {
+        scheduler->queue_tail->queue_next = job;
+      }
+      else
+      {
+        scheduler->queue_head = job;
+      }
+      scheduler->queue_tail = job;
+      pthread_cond_signal(&scheduler->ready);
+    }
+
+    evel_scheduler_insert(scheduler, job);
+  }
+}
+
+/**************************************************************************//**
+ * Timer thread: handle each tick as the timerfd expires.
+ *
+ * If the thread falls behind, the timerfd's count of expirations says how
+ * many ticks have passed, and each is handled in turn so that no job's
+ * boundary is missed.
+ *
+ * @param arg   The scheduler.
+ *****************************************************************************/
+static void * evel_scheduler_timer_thread(void * arg)
+{
+  EVEL_SCHEDULER * scheduler = (EVEL_SCHEDULER *) arg;
+  struct pollfd fds[2];
+  uint64_t expirations;
+  ssize_t bytes;
+
+  fds[0].fd = scheduler->timer_fd;
+  fds[0].events = POLLIN;
+  fds[1].fd = scheduler->stop_fd;
+  fds[1].events = POLLIN;
+
+  while (1)
+  {
+    if (poll(fds, 2, -1) < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      log_error_state("Scheduler failed to poll: %s", strerror(errno));
+      break;
+    }
+    if (fds[1].revents != 0)
+    {
+      break;
+    }
+
+    bytes = read(scheduler->timer_fd, &expirations, sizeof(expirations));
+    if (bytes != sizeof(expirations))
+    {
+      continue;
+    }
+
+    pthread_mutex_lock(&scheduler->mutex);
+    while (expirations-- > 0)
+    {
+      scheduler->tick++;
+      evel_scheduler_tick(scheduler);
+    }
+    pthread_mutex_unlock(&scheduler->mutex);
+  }
+
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Worker thread: run queued jobs until the scheduler stops.
+ *
+ * @param arg   The scheduler.
+ *****************************************************************************/
+static void * evel_scheduler_worker_thread(void * arg)
+{
+  EVEL_SCHEDULER * scheduler = (EVEL_SCHEDULER *) arg;
+  EVEL_SCHEDULER_JOB * job;
+
+  pthread_mutex_lock(&scheduler->mutex);
+  while (1)
+  {
+    while (scheduler->running && scheduler->queue_head == NULL)
+    {
+      pthread_cond_wait(&scheduler->ready, &scheduler->mutex);
+    }
+    if (!scheduler->running)
+    {
+      break;
+    }
+
+    job = scheduler->queue_head;
+    scheduler->queue_head = job->queue_next;
+    if (scheduler->queue_head == NULL)
+    {
+      scheduler->queue_tail = NULL;
+    }
+    pthread_mutex_unlock(&scheduler->mutex);
+
+    (*job->function)(job->context, job->scheduled);
+
+    pthread_mutex_lock(&scheduler->mutex);
+    job->pending = 0;
+  }
+  pthread_mutex_unlock(&scheduler->mutex);
+
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Create a scheduler.
+ *
+ * @param num_workers   Number of jobs that can run at the same time.
+ *
+ * @returns pointer to the new scheduler.
+ * @retval  NULL  Failed to create the scheduler.
+ *****************************************************************************/
+EVEL_SCHEDULER * evel_new_scheduler(const int num_workers)
+{
+  EVEL_SCHEDULER * scheduler = NULL;
+  unsigned long long wall;
+  unsigned long long mono;
+  unsigned long long offset;
+
+  EVEL_ENTER();
+
+  assert(num_workers > 0);
+
+  scheduler = malloc(sizeof(EVEL_SCHEDULER));
+  if (scheduler == NULL)
+  {
+    log_error_state("Failed to allocate scheduler");
+    goto exit_label;
+  }
+  memset(scheduler, 0, sizeof(EVEL_SCHEDULER));
+  scheduler->workers = calloc(num_workers, sizeof(pthread_t));
+  if (scheduler->workers == NULL)
+  {
+    log_error_state("Failed to allocate scheduler workers");
+    free(scheduler);
+    scheduler = NULL;
+    goto exit_label;
+  }
+  scheduler->num_workers = num_workers;
+
+  scheduler->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+  scheduler->stop_fd = eventfd(0, EFD_CLOEXEC);
+  if (scheduler->timer_fd < 0 || scheduler->stop_fd < 0)
+  {
+    log_error_state("Failed to create scheduler timer: %s", strerror(errno));
+    if (scheduler->timer_fd >= 0)
+    {
+      close(scheduler->timer_fd);
+    }
+    if (scheduler->stop_fd >= 0)
+    {
+      close(scheduler->stop_fd);
+    }
+    free(scheduler->workers);
+    free(scheduler);
+    scheduler = NULL;
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Tick 0 is the last whole tick on the wall clock.                        */
+  /***************************************************************************/
+  wall = evel_scheduler_clock(CLOCK_REALTIME);
+  mono = evel_scheduler_clock(CLOCK_MONOTONIC);
+  offset = wall % (EVEL_SCHEDULER_TICK_MS * 1000ULL);
+  scheduler->base_wall = wall - offset;
+  scheduler->base_mono = mono - offset;
+
+  pthread_mutex_init(&scheduler->mutex, NULL);
+  pthread_cond_init(&scheduler->ready, NULL);
+
+exit_label:
+  EVEL_EXIT();
+  return scheduler;
+}
+
+/**************************************************************************//**
+ * Stop a scheduler if it is running, and free it and its jobs.
+ *
+ * @param scheduler   The scheduler.
+ *****************************************************************************/
+void evel_free_scheduler(EVEL_SCHEDULER * scheduler)
+{
+  EVEL_SCHEDULER_JOB * job;
+
+  EVEL_ENTER();
+
+  if (scheduler == NULL)
+  {
+    goto exit_label;
+  }
+
+  evel_scheduler_stop(scheduler);
+  while ((job = scheduler->jobs) != NULL)
+  {
+    scheduler->jobs = job->all_next;
+    free(job->name);
+    free(job);
+  }
+  close(scheduler->timer_fd);
+  close(scheduler->stop_fd);
+  pthread_cond_destroy(&scheduler->ready);
+  pthread_mutex_destroy(&scheduler->mutex);
+  free(scheduler->workers);
+  free(scheduler);
+
+exit_label:
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Add a periodic job.
+ *
+ * @param scheduler     The scheduler.
+ * @param name          ASCIIZ name of the job, for logging.
+ * @param interval_ms   Interval in milliseconds.
+ * @param function      Function to run.
+ * @param context       Context passed to function.
+ *
+ * @returns pointer to the job.
+ * @retval  NULL  Failed to add the job.
+ *****************************************************************************/
+EVEL_SCHEDULER_JOB * evel_scheduler_job_add(EVEL_SCHEDULER * const scheduler,
+                                            const char * const name,
+                                            const int interval_ms,
+                                            EVEL_SCHEDULER_FN function,
+                                            void * context)
+{
+  EVEL_SCHEDULER_JOB * job = NULL;
+
+  EVEL_ENTER();
+
+  assert(scheduler != NULL);
+  assert(name != NULL);
+  assert(function != NULL);
+
+  job = malloc(sizeof(EVEL_SCHEDULER_JOB));
+  if (job == NULL)
+  {
+    log_error_state("Failed to allocate scheduler job");
+    goto exit_label;
+  }
+  memset(job, 0, sizeof(EVEL_SCHEDULER_JOB));
+  job->name = strdup(name);
+  if (job->name == NULL)
+  {
+    log_error_state("Failed to allocate scheduler job name");
+    free(job);
+    job = NULL;
+    goto exit_label;
+  }
+  job->scheduler = scheduler;
+  job->interval_ticks = evel_scheduler_ticks(interval_ms);
+  job->function = function;
+  job->context = context;
+
+  pthread_mutex_lock(&scheduler->mutex);
+  job->all_next = scheduler->jobs;
+  scheduler->jobs = job;
+  if (!scheduler->running)
+  {
+    scheduler->tick = evel_scheduler_current_tick(scheduler);
+  }
+  evel_scheduler_insert(scheduler, job);
+  pthread_mutex_unlock(&scheduler->mutex);
+
+exit_label:
+  EVEL_EXIT();
+  return job;
+}
+
+/**************************************************************************//**
+ * Change the interval of a job.
+ *
+ * @param job           The job.
+ * @param interval_ms   Interval in milliseconds.
+ *****************************************************************************/
+void evel_scheduler_job_interval_set(EVEL_SCHEDULER_JOB * const job,
+                                     const int interval_ms)
+{
+  EVEL_SCHEDULER * scheduler;
+  int ticks = evel_scheduler_ticks(interval_ms);
+
+  EVEL_ENTER();
+
+  assert(job != NULL);
+
+  scheduler = job->scheduler;
+  pthread_mutex_lock(&scheduler->mutex);
+  if (job->interval_ticks != ticks)
+  {
+    evel_scheduler_unlink(scheduler, job);
+    job->interval_ticks = ticks;
+    evel_scheduler_insert(scheduler, job);
+  }
+  pthread_mutex_unlock(&scheduler->mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Start the timer and worker threads.
+ *
+ * @param scheduler   The scheduler.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success, or if the scheduler is already running.
+ * @retval  EVEL_PTHREAD_LIBRARY_FAIL The threads could not be started.
+ * @retval  EVEL_ERR_GEN_FAIL The timer could not be set.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_scheduler_start(EVEL_SCHEDULER * const scheduler)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  EVEL_SCHEDULER_JOB * job;
+  struct itimerspec timer;
+  unsigned long long first;
+  int started = 0;
+
+  EVEL_ENTER();
+
+  assert(scheduler != NULL);
+
+  /***************************************************************************/
+  /* Test and set running under the mutex, so that of two threads starting   */
+  /* the scheduler at once only one starts its threads.                      */
+  /***************************************************************************/
+  pthread_mutex_lock(&scheduler->mutex);
+  if (scheduler->running)
+  {
+    pthread_mutex_unlock(&scheduler->mutex);
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Jobs added before now may have been due while the scheduler was not     */
+  /* running, so put them all back from the current tick.                    */
+  /***************************************************************************/
+  scheduler->tick = evel_scheduler_current_tick(scheduler);
+  memset(scheduler->wheel, 0, sizeof(scheduler->wheel));
+  for (job = scheduler->jobs; job != NULL; job = job->all_next)
+  {
+    evel_scheduler_insert(scheduler, job);
+  }
+  scheduler->running = 1;
+  pthread_mutex_unlock(&scheduler->mutex);
+
+  first = scheduler->base_mono +
+          (scheduler->tick + 1) * EVEL_SCHEDULER_TICK_MS * 1000ULL;
+  memset(&timer, 0, sizeof(timer));
+  timer.it_value.tv_sec = first / 1000000ULL;
+  timer.it_value.tv_nsec = (first % 1000000ULL) * 1000L;
+  timer.it_interval.tv_sec = EVEL_SCHEDULER_TICK_MS / 1000;
+  timer.it_interval.tv_nsec = (EVEL_SCHEDULER_TICK_MS % 1000) * 1000000L;
+  if (timerfd_settime(scheduler->timer_fd,
+                      TFD_TIMER_ABSTIME,
+                      &timer,
+                      NULL) != 0)
+  {
+    log_error_state("Failed to set scheduler timer: %s", strerror(errno));
+    rc = EVEL_ERR_GEN_FAIL;
+    goto error;
+  }
+
+  for (started = 0; started < scheduler->num_workers; started++)
+  {
+    if (pthread_create(&scheduler->workers[started],
+                       NULL,
+                       evel_scheduler_worker_thread,
+                       scheduler) != 0)
+    {
+      log_error_state("Failed to start scheduler worker");
+      rc = EVEL_PTHREAD_LIBRARY_FAIL;
+      goto error;
+    }
+  }
+  if (pthread_create(&scheduler->timer_thread,
+                     NULL,
+                     evel_scheduler_timer_thread,
+                     scheduler) != 0)
+  {
+    log_error_state("Failed to start scheduler timer thread");
+    rc = EVEL_PTHREAD_LIBRARY_FAIL;
+    goto error;
+  }
+  goto exit_label;
+
+error:
+  pthread_mutex_lock(&scheduler->mutex);
+  scheduler->running = 0;
+  pthread_cond_broadcast(&scheduler->ready);
+  pthread_mutex_unlock(&scheduler->mutex);
+  while (started-- > 0)
+  {
+    pthread_join(scheduler->workers[started], NULL);
+  }
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Stop the timer and worker threads, waiting for any running jobs.  Runs
+ * that are queued but not yet started are dropped.
+ *
+ * @param scheduler   The scheduler.
+ *****************************************************************************/
+void evel_scheduler_stop(EVEL_SCHEDULER * const scheduler)
+{
+  EVEL_SCHEDULER_JOB * job;
+  struct itimerspec timer;
+  uint64_t value = 1;
+  ssize_t bytes;
+  int ii;
+
+  EVEL_ENTER();
+
+  assert(scheduler != NULL);
+
+  if (!scheduler->running)
+  {
+    goto exit_label;
+  }
+
+  bytes = write(scheduler->stop_fd, &value, sizeof(value));
+  assert(bytes == sizeof(value));
+  (void) bytes;
+  pthread_join(scheduler->timer_thread, NULL);
+
+  pthread_mutex_lock(&scheduler->mutex);
+  scheduler->running = 0;
+  pthread_cond_broadcast(&scheduler->ready);
+  pthread_mutex_unlock(&scheduler->mutex);
+  for (ii = 0; ii < scheduler->num_workers; ii++)
+  {
+    pthread_join(scheduler->workers[ii], NULL);
+  }
+
+  /***************************************************************************/
+  /* Leave the scheduler as it was before it started.                        */
+  /***************************************************************************/
+  while ((job = scheduler->queue_head) != NULL)
+  {
+    scheduler->queue_head = job->queue_next;
+    job->pending = 0;
+  }
+  scheduler->queue_tail = NULL;
+  bytes = read(scheduler->stop_fd, &value, sizeof(value));
+  (void) bytes;
+  memset(&timer, 0, sizeof(timer));
+  timerfd_settime(scheduler->timer_fd, 0, &timer, NULL);
+
+exit_label:
+  EVEL_EXIT();
+}
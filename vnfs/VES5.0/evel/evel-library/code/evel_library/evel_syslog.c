@@ -21,6 +21,7 @@
  *
  ****************************************************************************/
 
+#include <stdio.h>
 #include <string.h>
 #include <assert.h>
 #include <stdlib.h>
@@ -158,6 +159,67 @@ void evel_syslog_addl_filter_set(EVENT_SYSLOG * syslog,
   EVEL_EXIT();
 }
 
+/**************************************************************************//**
+ * Add an additional field name/value pair to the Syslog.  The pairs are
+ * encoded as additionalFields, "name=value" delimited by '|'.
+ *
+ * @param syslog    Pointer to the syslog.
+ * @param name      ASCIIZ string with the attribute's name.  The caller
+ *                  does not need to preserve the value once the function
+ *                  returns.
+ * @param value     ASCIIZ string with the attribute's value.  The caller
+ *                  does not need to preserve the value once the function
+ *                  returns.
+ *****************************************************************************/
+void evel_syslog_addl_field_add(EVENT_SYSLOG * syslog,
+                                char * name,
+                                char * value)
+{
+  char * fields = NULL;
+  size_t length;
+
+  EVEL_ENTER();
+
+  /***************************************************************************/
+  /* Check preconditions.                                                    */
+  /***************************************************************************/
+  assert(syslog != NULL);
+  assert(syslog->header.event_domain == EVEL_DOMAIN_SYSLOG);
+  assert(name != NULL);
+  assert(value != NULL);
+
+  length = strlen(name) + strlen(value) + 2;
+  if (syslog->additional_filters.is_set)
+  {
+    length += strlen(syslog->additional_filters.value) + 1;
+  }
+
+  fields = malloc(length);
+  if (fields == NULL)
+  {
+    log_error_state("Out of memory");
+    goto exit_label;
+  }
+
+  if (syslog->additional_filters.is_set)
+  {
+    snprintf(fields, length, "%s|%s=%s",
+             syslog->additional_filters.value, name, value);
+    free(syslog->additional_filters.value);
+  }
+  else
+  {
+    snprintf(fields, length, "%s=%s", name, value);
+  }
+  EVEL_DEBUG("Syslog additional fields: %s", fields);
+
+  syslog->additional_filters.value = fields;
+  syslog->additional_filters.is_set = EVEL_TRUE;
+
+exit_label:
+  EVEL_EXIT();
+}
+
 /**************************************************************************//**
  * Set the Event Source Host property of the Syslog.
  *
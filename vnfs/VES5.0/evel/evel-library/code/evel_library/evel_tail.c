@@ -0,0 +1,507 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Following a log file as lines are added to it.
+ *
+ * The file is kept open, and inotify says when it has been written to,
+ * moved or deleted, or when a file has been created in its place.  New data
+ * is read in large blocks from where the last read stopped, and handed on a
+ * line at a time; a line still being written is held back until its
+ * newline arrives.
+ *
+ * Rotation is followed by inode: when the path names a different file, the
+ * old one is read to its end and closed, and the new one is read from its
+ * start, so that lines written either side of the rotation are neither
+ * missed nor repeated.  A file which shrinks in place, as logrotate's
+ * copytruncate leaves it, is read again from its start.  inotify wakes the
+ * tail as soon as that happens; a truncation only goes unseen if the file
+ * has grown back past where the tail had got to before it looks.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* How much of the file to read at once.                                     */
+/*****************************************************************************/
+#define EVEL_TAIL_READ_SIZE 65536
+
+/*****************************************************************************/
+/* Longest line held back waiting for its newline.  A longer one is handed   */
+/* on in pieces of this length.                                              */
+/*****************************************************************************/
+#define EVEL_TAIL_MAX_LINE 65536
+
+/*****************************************************************************/
+/* Space for a batch of inotify events.                                      */
+/*****************************************************************************/
+#define EVEL_TAIL_EVENT_BUFFER 4096
+
+/**************************************************************************//**
+ * Tail state.  The file's directory is watched for a new file at the path,
+ * and the open file itself for writes, moves and deletion.
+ *****************************************************************************/
+struct evel_tail {
+  char * path;
+  char * directory;
+  int inotify_fd;
+  int file_wd;
+  int fd;
+  dev_t dev;
+  ino_t ino;
+  off_t position;
+  char * buffer;
+  char * line;
+  size_t line_length;
+};
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static void evel_tail_open(EVEL_TAIL * const tail, const int at_end);
+static void evel_tail_close(EVEL_TAIL * const tail);
+static void evel_tail_line(EVEL_TAIL * const tail,
+                           const char * data,
+                           size_t length,
+                           const int complete,
+                           EVEL_TAIL_LINE_FN function,
+                           void * context);
+static void evel_tail_read(EVEL_TAIL * const tail,
+                           EVEL_TAIL_LINE_FN function,
+                           void * context);
+static void evel_tail_follow(EVEL_TAIL * const tail,
+                             EVEL_TAIL_LINE_FN function,
+                             void * context);
+
+/**************************************************************************//**
+ * Open the file at the tail's path, if there is one.
+ *
+ * @param tail      The tail.
+ * @param at_end    Non-zero to start at the end of the file, else at its
+ *                  start.
+ *****************************************************************************/
+static void evel_tail_open(EVEL_TAIL * const tail, const int at_end)
+{
+  struct stat st;
+
+  tail->fd = open(tail->path, O_RDONLY | O_CLOEXEC);
+  if (tail->fd < 0)
+  {
+    if (errno != ENOENT)
+    {
+      EVEL_ERROR("Failed to open %s: %s", tail->path, strerror(errno));
+    }
+    return;
+  }
+  if (fstat(tail->fd, &st) != 0)
+  {
+    EVEL_ERROR("Failed to stat %s: %s", tail->path, strerror(errno));
+    close(tail->fd);
+    tail->fd = -1;
+    return;
+  }
+
+  tail->dev = st.st_dev;
+  tail->ino = st.st_ino;
+  tail->position = at_end ? st.st_size : 0;
+  lseek(tail->fd, tail->position, SEEK_SET);
+
+  if (tail->inotify_fd >= 0)
+  {
+    tail->file_wd = inotify_add_watch(tail->inotify_fd,
+                                      tail->path,
+                                      IN_MODIFY | IN_MOVE_SELF |
+                                      IN_DELETE_SELF);
+    if (tail->file_wd < 0)
+    {
+      EVEL_ERROR("Failed to watch %s: %s", tail->path, strerror(errno));
+    }
+  }
+  EVEL_DEBUG("Following %s from offset %lld",
+             tail->path, (long long) tail->position);
+}
+
+/**************************************************************************//**
+ * Close the file being followed.
+ *
+ * @param tail      The tail.
+ *****************************************************************************/
+static void evel_tail_close(EVEL_TAIL * const tail)
+{
+  if (tail->file_wd >= 0)
+  {
+    /*************************************************************************/
+    /* Fails harmlessly if the file has gone and taken its watch with it.    */
+    /*************************************************************************/
+    inotify_rm_watch(tail->inotify_fd, tail->file_wd);
+    tail->file_wd = -1;
+  }
+  if (tail->fd >= 0)
+  {
+    close(tail->fd);
+    tail->fd = -1;
+  }
+}
+
+/**************************************************************************//**
+ * Add data to the line being held back, handing the line on once it is
+ * complete or has grown too long.
+ *
+ * @param tail      The tail.
+ * @param data      The data, without any newline.
+ * @param length    Length of the data.
+ * @param complete  Non-zero if the data ends the line.
+ * @param function  Function to hand lines to.
+ * @param context   Context passed to function.
+ *****************************************************************************/
+static void evel_tail_line(EVEL_TAIL * const tail,
+                           const char * data,
+                           size_t length,
+                           const int complete,
+                           EVEL_TAIL_LINE_FN function,
+                           void * context)
+{
+  size_t space;
+
+  while (length > 0 || complete)
+  {
+    space = EVEL_TAIL_MAX_LINE - tail->line_length;
+    if (length > space)
+    {
+      memcpy(tail->line + tail->line_length, data, space);
+      tail->line_length += space;
+      data += space;
+      length -= space;
+    }
+    else
+    {
+      memcpy(tail->line + tail->line_length, data, length);
+      tail->line_length += length;
+      length = 0;
+      if (!complete)
+      {
+        break;
+      }
+    }
+
+    tail->line[tail->line_length] = '\0';
+    (*function)(context, tail->line, tail->line_length);
+    tail->line_length = 0;
+    if (length == 0)
+    {
+      break;
+    }
+  }
+}
+
+/**************************************************************************//**
+ * Read whatever has been added to the file since the last read, handing on
+ * each complete line.
+ *
+ * @param tail      The tail.
+ * @param function  Function to hand lines to.
+ * @param context   Context passed to function.
+ *****************************************************************************/
+static void evel_tail_read(EVEL_TAIL * const tail,
+                           EVEL_TAIL_LINE_FN function,
+                           void * context)
+{
+  struct stat st;
+  ssize_t bytes;
+  char * start;
+  char * end;
+  char * newline;
+
+  if (tail->fd < 0)
+  {
+    return;
+  }
+
+  /***************************************************************************/
+  /* A file shorter than where we got to has been truncated in place.  What  */
+  /* was held back of its last line went with it.                            */
+  /***************************************************************************/
+  if (fstat(tail->fd, &st) == 0 && st.st_size < tail->position)
+  {
+    EVEL_INFO("%s was truncated, reading it from the start", tail->path);
+    tail->position = 0;
+    tail->line_length = 0;
+    lseek(tail->fd, 0, SEEK_SET);
+  }
+
+  while (1)
+  {
+    bytes = read(tail->fd, tail->buffer, EVEL_TAIL_READ_SIZE);
+    if (bytes < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (bytes < 0)
+    {
+      EVEL_ERROR("Failed to read %s: %s", tail->path, strerror(errno));
+      break;
+    }
+    if (bytes == 0)
+    {
+      break;
+    }
+    tail->position += bytes;
+
+    start = tail->buffer;
+    end = tail->buffer + bytes;
+    while ((newline = memchr(start, '\n', end - start)) != NULL)
+    {
+      if (tail->line_length == 0)
+      {
+        /*********************************************************************/
+        /* The usual case: the whole line is in the block, so hand it on     */
+        /* from there.  The block has a spare byte for the last NUL.         */
+        /*********************************************************************/
+        *newline = '\0';
+        (*function)(context, start, newline - start);
+      }
+      else
+      {
+        evel_tail_line(tail, start, newline - start, 1, function, context);
+      }
+      start = newline + 1;
+    }
+    if (start < end)
+    {
+      evel_tail_line(tail, start, end - start, 0, function, context);
+    }
+  }
+}
+
+/**************************************************************************//**
+ * If the path now names a different file, finish the old one and start the
+ * new one from its beginning.
+ *
+ * @param tail      The tail.
+ * @param function  Function to hand lines to.
+ * @param context   Context passed to function.
+ *****************************************************************************/
+static void evel_tail_follow(EVEL_TAIL * const tail,
+                             EVEL_TAIL_LINE_FN function,
+                             void * context)
+{
+  struct stat st;
+
+  if (stat(tail->path, &st) != 0)
+  {
+    /*************************************************************************/
+    /* Moved away and not yet replaced: keep reading the old file, which its */
+    /* writer may still have open.                                           */
+    /*************************************************************************/
+    return;
+  }
+  if (tail->fd >= 0 && st.st_dev == tail->dev && st.st_ino == tail->ino)
+  {
+    return;
+  }
+
+  if (tail->fd >= 0)
+  {
+    EVEL_INFO("%s was rotated", tail->path);
+    evel_tail_read(tail, function, context);
+    if (tail->line_length > 0)
+    {
+      evel_tail_line(tail, "", 0, 1, function, context);
+    }
+    evel_tail_close(tail);
+  }
+  evel_tail_open(tail, 0);
+  evel_tail_read(tail, function, context);
+}
+
+/**************************************************************************//**
+ * Start following a file.
+ *
+ * @param path      Path of the file.
+ *
+ * @returns pointer to the new tail.
+ * @retval  NULL  Failed to create the tail.
+ *****************************************************************************/
+EVEL_TAIL * evel_new_tail(const char * const path)
+{
+  EVEL_TAIL * tail = NULL;
+  char * slash;
+
+  EVEL_ENTER();
+
+  assert(path != NULL);
+
+  tail = calloc(1, sizeof(EVEL_TAIL));
+  if (tail == NULL)
+  {
+    log_error_state("Failed to allocate tail");
+    goto exit_label;
+  }
+  tail->inotify_fd = -1;
+  tail->file_wd = -1;
+  tail->fd = -1;
+
+  tail->path = strdup(path);
+  tail->directory = strdup(path);
+  tail->buffer = malloc(EVEL_TAIL_READ_SIZE + 1);
+  tail->line = malloc(EVEL_TAIL_MAX_LINE + 1);
+  if (tail->path == NULL || tail->directory == NULL ||
+      tail->buffer == NULL || tail->line == NULL)
+  {
+    log_error_state("Failed to allocate tail");
+    goto error_label;
+  }
+
+  slash = strrchr(tail->directory, '/');
+  if (slash == NULL)
+  {
+    strcpy(tail->directory, ".");
+  }
+  else if (slash == tail->directory)
+  {
+    strcpy(tail->directory, "/");
+  }
+  else
+  {
+    *slash = '\0';
+  }
+
+  /***************************************************************************/
+  /* Without inotify the file is still followed, by looking at it each time  */
+  /* the wait times out.                                                     */
+  /***************************************************************************/
+  tail->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (tail->inotify_fd < 0)
+  {
+    EVEL_ERROR("Failed to create inotify for %s: %s",
+               path, strerror(errno));
+  }
+  else if (inotify_add_watch(tail->inotify_fd,
+                             tail->directory,
+                             IN_CREATE | IN_MOVED_TO) < 0)
+  {
+    EVEL_ERROR("Failed to watch %s: %s", tail->directory, strerror(errno));
+  }
+
+  evel_tail_open(tail, 1);
+  goto exit_label;
+
+error_label:
+  evel_free_tail(tail);
+  tail = NULL;
+
+exit_label:
+  EVEL_EXIT();
+  return tail;
+}
+
+/**************************************************************************//**
+ * Stop following a file, and free the tail.
+ *
+ * @param tail      The tail.
+ *****************************************************************************/
+void evel_free_tail(EVEL_TAIL * tail)
+{
+  EVEL_ENTER();
+
+  if (tail == NULL)
+  {
+    goto exit_label;
+  }
+
+  evel_tail_close(tail);
+  if (tail->inotify_fd >= 0)
+  {
+    close(tail->inotify_fd);
+  }
+  free(tail->path);
+  free(tail->directory);
+  free(tail->buffer);
+  free(tail->line);
+  free(tail);
+
+exit_label:
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Wait for lines to be added to the file, and hand on each one.
+ *
+ * @param tail        The tail.
+ * @param timeout_ms  Longest time to wait, in milliseconds.
+ * @param function    Function to hand lines to.
+ * @param context     Context passed to function.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success, including when the wait times out.
+ * @retval  EVEL_ERR_GEN_FAIL Waiting failed.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_tail_wait(EVEL_TAIL * const tail,
+                              const int timeout_ms,
+                              EVEL_TAIL_LINE_FN function,
+                              void * context)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  char events[EVEL_TAIL_EVENT_BUFFER]
+               __attribute__ ((aligned(__alignof__(struct inotify_event))));
+  struct pollfd fds;
+  int ready;
+
+  EVEL_ENTER();
+
+  assert(tail != NULL);
+  assert(function != NULL);
+
+  fds.fd = tail->inotify_fd;
+  fds.events = POLLIN;
+  ready = poll(&fds, (tail->inotify_fd >= 0) ? 1 : 0, timeout_ms);
+  if (ready < 0 && errno != EINTR)
+  {
+    log_error_state("Failed to wait for %s: %s", tail->path, strerror(errno));
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* The events only say to look; what to do is decided from the file, so    */
+  /* that events merged or lost by inotify do not matter.                    */
+  /***************************************************************************/
+  if (ready > 0)
+  {
+    while (read(tail->inotify_fd, events, sizeof(events)) > 0)
+    {
+    }
+  }
+  evel_tail_read(tail, function, context);
+  evel_tail_follow(tail, function, context);
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
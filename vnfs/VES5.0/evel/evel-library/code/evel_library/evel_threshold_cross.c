@@ -429,7 +429,7 @@ void evel_json_encode_perf_counter( EVEL_JSON_BUFFER * jbuf, PERF_COUNTER *pcoun
   /***************************************************************************/
   evel_enc_kv_string(jbuf, "criticality", pcounter->criticality);
   evel_enc_kv_string(jbuf, "name", pcounter->name);
-  evel_enc_kv_string(jbuf, "thresholdCrossed", pcounter->name);
+  evel_enc_kv_string(jbuf, "thresholdCrossed", pcounter->thresholdCrossed);
   evel_enc_kv_string(jbuf, "value", pcounter->value);
 
   evel_json_close_object(jbuf);
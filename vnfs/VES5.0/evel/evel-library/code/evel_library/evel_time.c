@@ -0,0 +1,231 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Timestamp service.
+ *
+ * Wall-clock timestamps for events come in three grades:
+ *  - ::EVEL_CLOCK_EXACT  - CLOCK_REALTIME, microsecond resolution.
+ *  - ::EVEL_CLOCK_COARSE - CLOCK_REALTIME_COARSE, which the kernel updates
+ *                          once per tick (typically 1-4ms) and is cheaper to
+ *                          read.
+ *  - ::EVEL_CLOCK_CACHED - a value published by evel_time_tick(), read with a
+ *                          single load.  It is refreshed by the ticker
+ *                          thread; without the ticker it falls back to
+ *                          ::EVEL_CLOCK_COARSE.
+ *
+ * Intervals should be measured with evel_time_monotonic_usec(), which is not
+ * affected by NTP steps or manual changes to the system time.
+ ****************************************************************************/
+
+#include <assert.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "evel.h"
+
+/*****************************************************************************/
+/* Fall back to the exact clock where the coarse one is not available.       */
+/*****************************************************************************/
+#ifndef CLOCK_REALTIME_COARSE
+#define CLOCK_REALTIME_COARSE CLOCK_REALTIME
+#endif
+
+/*****************************************************************************/
+/* Latest cached realtime, in microseconds since the epoch.                  */
+/*****************************************************************************/
+static unsigned long long cached_usec = 0;
+
+/*****************************************************************************/
+/* Clock used for the default timestamps in new event headers.               */
+/*****************************************************************************/
+static EVEL_CLOCK_TYPES header_clock = EVEL_CLOCK_COARSE;
+
+/*****************************************************************************/
+/* Ticker thread state.                                                      */
+/*****************************************************************************/
+static pthread_mutex_t ticker_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t ticker_thread;
+static int ticker_running = 0;
+static int ticker_period_ms = 0;
+
+/**************************************************************************//**
+ * Read a clock in microseconds.
+ *
+ * @param clock_id  The POSIX clock to read.
+ *****************************************************************************/
+static unsigned long long evel_time_read(const clockid_t clock_id)
+{
+  struct timespec ts;
+
+  clock_gettime(clock_id, &ts);
+  return (unsigned long long) ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+/**************************************************************************//**
+ * Get the current wall-clock time.
+ *
+ * @param clock     Which grade of clock to use - see ::EVEL_CLOCK_TYPES.
+ *
+ * @returns Microseconds since the epoch.
+ *****************************************************************************/
+unsigned long long evel_time_now_usec(const EVEL_CLOCK_TYPES clock)
+{
+  switch (clock)
+  {
+  case EVEL_CLOCK_CACHED:
+    if (__atomic_load_n(&ticker_running, __ATOMIC_RELAXED))
+    {
+      return __atomic_load_n(&cached_usec, __ATOMIC_RELAXED);
+    }
+    return evel_time_read(CLOCK_REALTIME_COARSE);
+
+  case EVEL_CLOCK_COARSE:
+    return evel_time_read(CLOCK_REALTIME_COARSE);
+
+  case EVEL_CLOCK_EXACT:
+  default:
+    return evel_time_read(CLOCK_REALTIME);
+  }
+}
+
+/**************************************************************************//**
+ * Get the current monotonic time, for measuring intervals.
+ *
+ * @returns Microseconds since an arbitrary fixed point.
+ *****************************************************************************/
+unsigned long long evel_time_monotonic_usec(void)
+{
+  return evel_time_read(CLOCK_MONOTONIC);
+}
+
+/**************************************************************************//**
+ * Refresh the cached timestamp returned for ::EVEL_CLOCK_CACHED.
+ *****************************************************************************/
+void evel_time_tick(void)
+{
+  __atomic_store_n(&cached_usec,
+                   evel_time_read(CLOCK_REALTIME_COARSE),
+                   __ATOMIC_RELAXED);
+}
+
+/**************************************************************************//**
+ * Ticker thread: refresh the cached timestamp periodically.
+ *
+ * @param arg   Unused.
+ *****************************************************************************/
+static void * evel_time_ticker(void * arg)
+{
+  struct timespec period;
+
+  (void) arg;
+
+  period.tv_sec = ticker_period_ms / 1000;
+  period.tv_nsec = (ticker_period_ms % 1000) * 1000000L;
+
+  while (__atomic_load_n(&ticker_running, __ATOMIC_ACQUIRE))
+  {
+    evel_time_tick();
+    nanosleep(&period, NULL);
+  }
+
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Start a thread refreshing the cached timestamp.
+ *
+ * While it runs, ::EVEL_CLOCK_CACHED timestamps cost a single memory load
+ * and are at most period_ms old.
+ *
+ * @param period_ms   Refresh period in milliseconds.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success, or if the ticker is already running.
+ * @retval  EVEL_PTHREAD_LIBRARY_FAIL The thread could not be started.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_time_ticker_start(const int period_ms)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+
+  EVEL_ENTER();
+
+  assert(period_ms > 0);
+
+  pthread_mutex_lock(&ticker_mutex);
+  if (!ticker_running)
+  {
+    ticker_period_ms = period_ms;
+    evel_time_tick();
+    __atomic_store_n(&ticker_running, 1, __ATOMIC_RELEASE);
+    if (pthread_create(&ticker_thread, NULL, evel_time_ticker, NULL) != 0)
+    {
+      __atomic_store_n(&ticker_running, 0, __ATOMIC_RELEASE);
+      log_error_state("Failed to start time ticker thread");
+      rc = EVEL_PTHREAD_LIBRARY_FAIL;
+    }
+  }
+  pthread_mutex_unlock(&ticker_mutex);
+
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Stop the ticker thread.  ::EVEL_CLOCK_CACHED reverts to the coarse clock.
+ *****************************************************************************/
+void evel_time_ticker_stop(void)
+{
+  EVEL_ENTER();
+
+  pthread_mutex_lock(&ticker_mutex);
+  if (ticker_running)
+  {
+    __atomic_store_n(&ticker_running, 0, __ATOMIC_RELEASE);
+    pthread_join(ticker_thread, NULL);
+  }
+  pthread_mutex_unlock(&ticker_mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Set the clock used to timestamp new event headers.
+ *
+ * @param clock     Which grade of clock to use - see ::EVEL_CLOCK_TYPES.
+ *****************************************************************************/
+void evel_header_clock_set(const EVEL_CLOCK_TYPES clock)
+{
+  EVEL_ENTER();
+
+  assert(clock < EVEL_MAX_CLOCK_TYPES);
+  header_clock = clock;
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Get the current wall-clock time for a new event header.
+ *
+ * @returns Microseconds since the epoch.
+ *****************************************************************************/
+unsigned long long evel_time_header_usec(void)
+{
+  return evel_time_now_usec(header_clock);
+}
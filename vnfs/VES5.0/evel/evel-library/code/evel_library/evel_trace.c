@@ -0,0 +1,480 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Function entry/exit tracing behind ::EVEL_ENTER and ::EVEL_EXIT.
+ *
+ * Trace points test ::evel_trace_flags and only call in here when some form
+ * of tracing is enabled.  Ring tracing writes fixed-size binary records into
+ * a lock-free per-thread ring; a drain thread periodically empties every
+ * ring into the trace file.  Syslog tracing reproduces the original
+ * "Enter xxx {" / "Exit xxx }" debug logs.
+ *
+ * @note  Functions in this file must not themselves use EVEL_ENTER/EXIT.
+ ****************************************************************************/
+
+#include <string.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+
+#include "evel.h"
+#include "evel_trace.h"
+
+/*****************************************************************************/
+/* Size of the drain thread's function-name to string ID table.              */
+/*****************************************************************************/
+#define EVEL_TRACE_STRINGS 4096
+
+/*****************************************************************************/
+/* Enabled forms of tracing - a combination of ::EVEL_TRACE_MODES.           */
+/*****************************************************************************/
+unsigned int evel_trace_flags = 0;
+
+/*****************************************************************************/
+/* All rings ever created.  Rings are only ever pushed onto the front of the */
+/* list and are recycled rather than freed when their thread exits.          */
+/*****************************************************************************/
+static EVEL_TRACE_RING * trace_rings = NULL;
+static __thread EVEL_TRACE_RING * thread_ring = NULL;
+static pthread_key_t ring_key;
+static pthread_once_t ring_key_once = PTHREAD_ONCE_INIT;
+
+/*****************************************************************************/
+/* Drain thread state, guarded by trace_control_mutex.                       */
+/*****************************************************************************/
+static pthread_mutex_t trace_control_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t drain_thread;
+static int drain_running = 0;
+static FILE * trace_file = NULL;
+
+/*****************************************************************************/
+/* Function-name interning, only touched by the drain thread.                */
+/*****************************************************************************/
+static const char * trace_strings[EVEL_TRACE_STRINGS];
+static unsigned int trace_string_ids[EVEL_TRACE_STRINGS];
+static unsigned int trace_next_string_id = 1;
+
+/**************************************************************************//**
+ * Current CLOCK_MONOTONIC time in nanoseconds.
+ *****************************************************************************/
+static unsigned long long evel_trace_now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**************************************************************************//**
+ * Thread-exit destructor: hand the ring back for reuse by a later thread.
+ *
+ * @param arg   The exiting thread's ::EVEL_TRACE_RING.
+ *****************************************************************************/
+static void evel_trace_ring_release(void * arg)
+{
+  EVEL_TRACE_RING * ring = arg;
+
+  __atomic_store_n(&ring->in_use, 0, __ATOMIC_RELEASE);
+}
+
+/**************************************************************************//**
+ * Create the thread-specific key used to detect thread exit.
+ *****************************************************************************/
+static void evel_trace_key_create(void)
+{
+  pthread_key_create(&ring_key, evel_trace_ring_release);
+}
+
+/**************************************************************************//**
+ * Attach a ring to the calling thread.
+ *
+ * A drained ring released by an exited thread is reused if one exists,
+ * otherwise a new ring is allocated and pushed onto ::trace_rings.
+ *
+ * @returns The ring, or NULL if out of memory.
+ *****************************************************************************/
+static EVEL_TRACE_RING * evel_trace_ring_attach(void)
+{
+  EVEL_TRACE_RING * ring;
+  int expected;
+
+  pthread_once(&ring_key_once, evel_trace_key_create);
+
+  for (ring = __atomic_load_n(&trace_rings, __ATOMIC_ACQUIRE);
+       ring != NULL;
+       ring = ring->next)
+  {
+    expected = 0;
+    if (__atomic_load_n(&ring->head, __ATOMIC_RELAXED) ==
+          __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) &&
+        __atomic_compare_exchange_n(&ring->in_use, &expected, 1, 0,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+    {
+      break;
+    }
+  }
+
+  if (ring == NULL)
+  {
+    ring = calloc(1, sizeof(EVEL_TRACE_RING));
+    if (ring == NULL)
+    {
+      return NULL;
+    }
+    ring->in_use = 1;
+    ring->next = __atomic_load_n(&trace_rings, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&trace_rings, &ring->next, ring, 1,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+    {
+    }
+  }
+
+  ring->thread_id = (unsigned int) syscall(SYS_gettid);
+  ring->depth = 0;
+  pthread_setspecific(ring_key, ring);
+  thread_ring = ring;
+
+  return ring;
+}
+
+/**************************************************************************//**
+ * Record a trace point.
+ *
+ * Called by ::EVEL_ENTER and ::EVEL_EXIT when ::evel_trace_flags is
+ * non-zero.
+ *
+ * @param kind      ::EVEL_TRACE_KIND_ENTER or ::EVEL_TRACE_KIND_EXIT.
+ * @param function  The function name; must have static storage duration.
+ *****************************************************************************/
+void evel_trace_point(const int kind, const char * const function)
+{
+  EVEL_TRACE_RING * ring;
+  EVEL_TRACE_RECORD * record;
+  unsigned int flags = __atomic_load_n(&evel_trace_flags, __ATOMIC_RELAXED);
+  unsigned long long head;
+
+  if (flags & EVEL_TRACE_MODE_SYSLOG)
+  {
+    if (kind == EVEL_TRACE_KIND_ENTER)
+    {
+      log_debug(EVEL_LOG_DEBUG, "Enter %s {", function);
+      debug_indent += 2;
+    }
+    else
+    {
+      debug_indent -= 2;
+      log_debug(EVEL_LOG_DEBUG, "Exit %s }", function);
+    }
+  }
+
+  if (flags & EVEL_TRACE_MODE_RING)
+  {
+    ring = thread_ring;
+    if (ring == NULL)
+    {
+      ring = evel_trace_ring_attach();
+      if (ring == NULL)
+      {
+        return;
+      }
+    }
+
+    head = ring->head;
+    if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) >=
+          EVEL_TRACE_RING_SIZE)
+    {
+      __atomic_add_fetch(&ring->dropped, 1, __ATOMIC_RELAXED);
+      return;
+    }
+
+    record = &ring->records[head & EVEL_TRACE_RING_MASK];
+    record->timestamp = evel_trace_now();
+    record->function = function;
+    record->kind = kind;
+    if (kind == EVEL_TRACE_KIND_ENTER)
+    {
+      record->depth = ring->depth++;
+    }
+    else
+    {
+      /***********************************************************************/
+      /* Tracing may have been switched on part way down a call chain.       */
+      /***********************************************************************/
+      if (ring->depth > 0)
+      {
+        ring->depth--;
+      }
+      record->depth = ring->depth;
+    }
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+  }
+}
+
+/**************************************************************************//**
+ * Look up the string ID for a function name, writing a string record the
+ * first time the name is seen.
+ *
+ * @param function  The function name.
+ *
+ * @returns The string ID.
+ *****************************************************************************/
+static unsigned int evel_trace_intern(const char * const function)
+{
+  EVEL_TRACE_FILE_RECORD file_record;
+  unsigned int slot;
+  unsigned int probes;
+  unsigned int id;
+
+  slot = (unsigned int) (((unsigned long) function >> 3) %
+                         EVEL_TRACE_STRINGS);
+  for (probes = 0; probes < EVEL_TRACE_STRINGS; probes++)
+  {
+    if (trace_strings[slot] == function)
+    {
+      return trace_string_ids[slot];
+    }
+    if (trace_strings[slot] == NULL)
+    {
+      break;
+    }
+    slot = (slot + 1) % EVEL_TRACE_STRINGS;
+  }
+
+  /***************************************************************************/
+  /* New name.  If the table is full the name is simply written again.       */
+  /***************************************************************************/
+  id = trace_next_string_id++;
+  if (probes < EVEL_TRACE_STRINGS)
+  {
+    trace_strings[slot] = function;
+    trace_string_ids[slot] = id;
+  }
+
+  memset(&file_record, 0, sizeof(file_record));
+  file_record.kind = EVEL_TRACE_KIND_STRING;
+  file_record.length = (unsigned short) strlen(function);
+  file_record.string_id = id;
+  fwrite(&file_record, sizeof(file_record), 1, trace_file);
+  fwrite(function, file_record.length, 1, trace_file);
+
+  return id;
+}
+
+/**************************************************************************//**
+ * Empty every ring into the trace file.
+ *****************************************************************************/
+static void evel_trace_drain(void)
+{
+  EVEL_TRACE_RING * ring;
+  EVEL_TRACE_RECORD * record;
+  EVEL_TRACE_FILE_RECORD file_record;
+  unsigned long long head;
+  unsigned long long tail;
+  unsigned long long dropped;
+
+  memset(&file_record, 0, sizeof(file_record));
+
+  for (ring = __atomic_load_n(&trace_rings, __ATOMIC_ACQUIRE);
+       ring != NULL;
+       ring = ring->next)
+  {
+    head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    tail = ring->tail;
+    file_record.thread_id = ring->thread_id;
+
+    for (; tail != head; tail++)
+    {
+      record = &ring->records[tail & EVEL_TRACE_RING_MASK];
+      file_record.string_id = evel_trace_intern(record->function);
+      file_record.kind = record->kind;
+      file_record.length = record->depth;
+      file_record.value = record->timestamp;
+      fwrite(&file_record, sizeof(file_record), 1, trace_file);
+    }
+    __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+
+    dropped = __atomic_exchange_n(&ring->dropped, 0, __ATOMIC_RELAXED);
+    if (dropped != 0)
+    {
+      file_record.kind = EVEL_TRACE_KIND_DROPPED;
+      file_record.length = 0;
+      file_record.string_id = 0;
+      file_record.value = dropped;
+      fwrite(&file_record, sizeof(file_record), 1, trace_file);
+    }
+  }
+
+  fflush(trace_file);
+}
+
+/**************************************************************************//**
+ * Drain thread.
+ *
+ * @param arg   Unused.
+ *****************************************************************************/
+static void * evel_trace_drain_thread(void * arg)
+{
+  struct timespec interval = {0, EVEL_TRACE_DRAIN_MS * 1000000L};
+
+  (void) arg;
+
+  while (__atomic_load_n(&drain_running, __ATOMIC_ACQUIRE))
+  {
+    nanosleep(&interval, NULL);
+    evel_trace_drain();
+  }
+
+  /***************************************************************************/
+  /* Pick up anything written between the last pass and being stopped.      */
+  /***************************************************************************/
+  evel_trace_drain();
+
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Start binary ring tracing to a file.
+ *
+ * @param path  Path of the trace file to create.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS On success
+ * @retval  EVEL_ERR_GEN_FAIL The file could not be created or tracing is
+ *                            already running.
+ * @retval  EVEL_PTHREAD_LIBRARY_FAIL The drain thread could not be started.
+ *****************************************************************************/
+EVEL_ERR_CODES evel_trace_start(const char * const path)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  EVEL_TRACE_FILE_HEADER header;
+  EVEL_TRACE_RING * ring;
+  struct timespec ts;
+
+  assert(path != NULL);
+
+  pthread_mutex_lock(&trace_control_mutex);
+
+  if (drain_running)
+  {
+    log_error_state("Tracing is already running");
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  trace_file = fopen(path, "w");
+  if (trace_file == NULL)
+  {
+    log_error_state("Failed to open trace file %s", path);
+    rc = EVEL_ERR_GEN_FAIL;
+    goto exit_label;
+  }
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, EVEL_TRACE_MAGIC, sizeof(EVEL_TRACE_MAGIC));
+  header.version = EVEL_TRACE_VERSION;
+  header.record_size = sizeof(EVEL_TRACE_FILE_RECORD);
+  clock_gettime(CLOCK_REALTIME, &ts);
+  header.realtime_base = (unsigned long long) ts.tv_sec * 1000000000ULL +
+                         ts.tv_nsec;
+  header.monotonic_base = evel_trace_now();
+  fwrite(&header, sizeof(header), 1, trace_file);
+
+  /***************************************************************************/
+  /* Discard anything left over from a previous run and start afresh.        */
+  /***************************************************************************/
+  memset(trace_strings, 0, sizeof(trace_strings));
+  trace_next_string_id = 1;
+  for (ring = __atomic_load_n(&trace_rings, __ATOMIC_ACQUIRE);
+       ring != NULL;
+       ring = ring->next)
+  {
+    __atomic_store_n(&ring->tail,
+                     __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE),
+                     __ATOMIC_RELEASE);
+  }
+
+  drain_running = 1;
+  if (pthread_create(&drain_thread, NULL, evel_trace_drain_thread, NULL) != 0)
+  {
+    log_error_state("Failed to start trace drain thread");
+    drain_running = 0;
+    fclose(trace_file);
+    trace_file = NULL;
+    rc = EVEL_PTHREAD_LIBRARY_FAIL;
+    goto exit_label;
+  }
+
+  __atomic_or_fetch(&evel_trace_flags,
+                    EVEL_TRACE_MODE_RING,
+                    __ATOMIC_RELEASE);
+  EVEL_INFO("Tracing to %s", path);
+
+exit_label:
+  pthread_mutex_unlock(&trace_control_mutex);
+  return rc;
+}
+
+/**************************************************************************//**
+ * Stop binary ring tracing, draining outstanding records and closing the
+ * trace file.  Does nothing if tracing is not running.
+ *****************************************************************************/
+void evel_trace_stop(void)
+{
+  pthread_mutex_lock(&trace_control_mutex);
+
+  if (drain_running)
+  {
+    __atomic_and_fetch(&evel_trace_flags,
+                       ~EVEL_TRACE_MODE_RING,
+                       __ATOMIC_RELEASE);
+    __atomic_store_n(&drain_running, 0, __ATOMIC_RELEASE);
+    pthread_join(drain_thread, NULL);
+    fclose(trace_file);
+    trace_file = NULL;
+    EVEL_INFO("Tracing stopped");
+  }
+
+  pthread_mutex_unlock(&trace_control_mutex);
+}
+
+/**************************************************************************//**
+ * Enable or disable the "Enter xxx {" / "Exit xxx }" debug logs.
+ *
+ * @param enable    Non-zero to enable, zero to disable.
+ *****************************************************************************/
+void evel_trace_syslog_set(const int enable)
+{
+  if (enable)
+  {
+    __atomic_or_fetch(&evel_trace_flags,
+                      EVEL_TRACE_MODE_SYSLOG,
+                      __ATOMIC_RELEASE);
+  }
+  else
+  {
+    __atomic_and_fetch(&evel_trace_flags,
+                       ~EVEL_TRACE_MODE_SYSLOG,
+                       __ATOMIC_RELEASE);
+  }
+}
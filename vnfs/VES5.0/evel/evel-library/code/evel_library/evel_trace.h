@@ -0,0 +1,119 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef EVEL_TRACE_INCLUDED
+#define EVEL_TRACE_INCLUDED
+
+/**************************************************************************//**
+ * @file
+ * Binary function trace: in-memory ring and on-disk file formats.
+ *
+ * Each thread that hits a trace point while ring tracing is enabled owns an
+ * ::EVEL_TRACE_RING.  The thread is the only writer of the ring's head and
+ * the drain thread is the only writer of its tail, so no locks are needed.
+ * The drain thread converts the records to ::EVEL_TRACE_FILE_RECORD form,
+ * replacing function-name pointers with string IDs, and appends them to the
+ * trace file, which evel_trace_decode turns back into readable text.
+ *
+ ****************************************************************************/
+
+/*****************************************************************************/
+/* Number of records in each per-thread ring.  Must be a power of two.       */
+/*****************************************************************************/
+#define EVEL_TRACE_RING_SIZE 4096
+#define EVEL_TRACE_RING_MASK (EVEL_TRACE_RING_SIZE - 1)
+
+/*****************************************************************************/
+/* How often the drain thread empties the rings, in milliseconds.            */
+/*****************************************************************************/
+#define EVEL_TRACE_DRAIN_MS 20
+
+/*****************************************************************************/
+/* Trace file identification.                                                */
+/*****************************************************************************/
+#define EVEL_TRACE_MAGIC "EVELTRC"
+#define EVEL_TRACE_VERSION 1
+
+/*****************************************************************************/
+/* Trace record kinds.  EVEL_TRACE_KIND_ENTER (1) and EVEL_TRACE_KIND_EXIT   */
+/* (2) are defined in evel.h for use by the trace point macros.              */
+/*****************************************************************************/
+#define EVEL_TRACE_KIND_STRING 3
+#define EVEL_TRACE_KIND_DROPPED 4
+
+/**************************************************************************//**
+ * In-memory trace record.
+ *****************************************************************************/
+typedef struct evel_trace_record {
+  unsigned long long timestamp;
+  const char * function;
+  unsigned short kind;
+  unsigned short depth;
+} EVEL_TRACE_RECORD;
+
+/**************************************************************************//**
+ * Per-thread trace ring.
+ *
+ * head and tail are free-running counters; the ring is full when they are
+ * ::EVEL_TRACE_RING_SIZE apart.  The two are kept on separate cache lines
+ * since they are written by different threads.
+ *****************************************************************************/
+typedef struct evel_trace_ring {
+  struct evel_trace_ring * next;
+  unsigned int thread_id;
+  int in_use;
+  unsigned long long dropped;
+  unsigned int depth;
+  unsigned long long head __attribute__((aligned(64)));
+  unsigned long long tail __attribute__((aligned(64)));
+  EVEL_TRACE_RECORD records[EVEL_TRACE_RING_SIZE];
+} EVEL_TRACE_RING;
+
+/**************************************************************************//**
+ * Trace file header.
+ *
+ * The realtime and monotonic clocks are sampled together when tracing
+ * starts so that record timestamps can be shown as wall-clock times.
+ *****************************************************************************/
+typedef struct evel_trace_file_header {
+  char magic[8];
+  unsigned int version;
+  unsigned int record_size;
+  unsigned long long realtime_base;
+  unsigned long long monotonic_base;
+} EVEL_TRACE_FILE_HEADER;
+
+/**************************************************************************//**
+ * Trace file record.
+ *
+ * kind                    | length           | string_id | value
+ * ----------------------- | ---------------- | --------- | ----------------
+ * EVEL_TRACE_KIND_ENTER   | call depth       | function  | timestamp (ns)
+ * EVEL_TRACE_KIND_EXIT    | call depth       | function  | timestamp (ns)
+ * EVEL_TRACE_KIND_STRING  | bytes that follow| new ID    | 0
+ * EVEL_TRACE_KIND_DROPPED | 0                | 0         | records lost
+ *****************************************************************************/
+typedef struct evel_trace_file_record {
+  unsigned short kind;
+  unsigned short length;
+  unsigned int thread_id;
+  unsigned int string_id;
+  unsigned int reserved;
+  unsigned long long value;
+} EVEL_TRACE_FILE_RECORD;
+
+#endif
@@ -204,6 +204,32 @@ void *ht_get( HASHTABLE_T *hashtable, char *key ) {
 	
 }
 
+/**************************************************************************//**
+ *  Free a hash table, including its keys and values.
+ *
+ * @param   hashtable    Pointer to the hashtable
+ *
+ * @returns Nothing
+******************************************************************************/
+void ht_destroy( HASHTABLE_T *hashtable ) {
+	size_t bin;
+	ENTRY_T *pair;
+	ENTRY_T *next;
+
+	if( hashtable == NULL ) return;
+
+	for( bin = 0; bin < hashtable->size; bin++ ) {
+		for( pair = hashtable->table[ bin ]; pair != NULL; pair = next ) {
+			next = pair->next;
+			free( pair->key );
+			free( pair->value );
+			free( pair );
+		}
+	}
+	free( hashtable->table );
+	free( hashtable );
+}
+
 /*
 int main( int argc, char **argv ) {
 
@@ -94,4 +94,11 @@ void ht_set( HASHTABLE_T *hashtable, char *key, void *value );
 ******************************************************************************/
 void *ht_get( HASHTABLE_T *hashtable, char *key );
 
+/**************************************************************************//**
+ *  Free a hash table, including its keys and values.
+ * @param   hashtable    Pointer to the hashtable
+ * @returns Nothing
+******************************************************************************/
+void ht_destroy( HASHTABLE_T *hashtable );
+
 #endif
@@ -11,19 +11,33 @@
  * Unless required by applicable law or agreed to in writing, software
  * distributed under the License is distributed on an "AS IS" BASIS,
  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and 
+ * See the License for the specific language governing permissions and
  * limitations under the License.
  * ECOMP is a trademark and service mark of AT&T Intellectual Property.
  ****************************************************************************/
 /**************************************************************************//**
  * @file
  * Wrap the OpenStack metadata service.
+ *
+ * The VM name and UUID are held in an immutable ::OPENSTACK_IDENTITY which
+ * is replaced, never modified, so readers need only a single atomic load.
+ * openstack_metadata_start() publishes the last known identity from the
+ * cache file straight away and leaves a background thread to query the
+ * metadata service, refresh the cache and periodically re-check.
  ****************************************************************************/
 
 #include <string.h>
 #include <assert.h>
 #include <malloc.h>
 #include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 
 #include <curl/curl.h>
 
@@ -45,20 +59,78 @@ static const char * OPENSTACK_METADATA_URL =
  *****************************************************************************/
 static const int OPENSTACK_METADATA_TIMEOUT = 2;
 
+/**************************************************************************//**
+ * How long the background refresh waits for a connection to the metadata
+ * service in milliseconds.
+ *****************************************************************************/
+static const long OPENSTACK_METADATA_CONNECT_TIMEOUT_MS = 500;
+
+/**************************************************************************//**
+ * Delay before the first retry after a failed background fetch, in seconds.
+ * It doubles on each failure up to ::OPENSTACK_METADATA_REFRESH.
+ *****************************************************************************/
+static const int OPENSTACK_METADATA_RETRY = 1;
+
+/**************************************************************************//**
+ * How often the background thread re-checks the metadata, in seconds.
+ *****************************************************************************/
+static const int OPENSTACK_METADATA_REFRESH = 300;
+
+/**************************************************************************//**
+ * Largest cache file we will read.
+ *****************************************************************************/
+#define MAX_METADATA_CACHE 1024
+
 /**************************************************************************//**
  * Size of fields extracted from metadata service.
  *****************************************************************************/
 #define MAX_METADATA_STRING  64
 
 /**************************************************************************//**
- * UUID of the VM extracted from the OpenStack metadata service.
+ * VM identity extracted from the OpenStack metadata service.
+ *
+ * Once published an identity is never modified; a new one is allocated for
+ * each change and the old one is kept on the retired list, since callers
+ * may still be reading it.
+ *****************************************************************************/
+typedef struct openstack_identity {
+  char uuid[MAX_METADATA_STRING+1];
+  char name[MAX_METADATA_STRING+1];
+  struct openstack_identity * retired;
+} OPENSTACK_IDENTITY;
+
+/**************************************************************************//**
+ * Identity in use before any has been published.
+ *****************************************************************************/
+static OPENSTACK_IDENTITY empty_identity = {{0}, {0}, NULL};
+
+/**************************************************************************//**
+ * The current identity.  Only written under ::identity_mutex.
  *****************************************************************************/
-static char vm_uuid[MAX_METADATA_STRING+1] = {0};
+static OPENSTACK_IDENTITY * identity = &empty_identity;
 
 /**************************************************************************//**
- * Name of the VM extracted from the OpenStack metadata service.
+ * Identities which have been replaced.
  *****************************************************************************/
-static char vm_name[MAX_METADATA_STRING+1] = {0};
+static OPENSTACK_IDENTITY * retired_identities = NULL;
+
+/**************************************************************************//**
+ * Whether evel_set_source_name() has overridden the VM name, in which case
+ * refreshes from the metadata service only update the UUID.
+ *****************************************************************************/
+static int name_overridden = 0;
+
+static pthread_mutex_t identity_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*****************************************************************************/
+/* Background refresh thread state.                                          */
+/*****************************************************************************/
+static pthread_mutex_t refresh_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t refresh_cond = PTHREAD_COND_INITIALIZER;
+static pthread_t refresh_thread;
+static int refresh_running = 0;
+static int refresh_stop = 0;
+static int refresh_verbosity = 0;
 
 /**************************************************************************//**
  * How many metadata elements we allow for in the retrieved JSON.
@@ -68,6 +140,19 @@ static const int MAX_METADATA_TOKENS = 128;
 /*****************************************************************************/
 /* Local prototypes.                                                         */
 /*****************************************************************************/
+static EVEL_ERR_CODES openstack_metadata_fetch(int verbosity,
+                                               long connect_timeout_ms,
+                                               OPENSTACK_IDENTITY * fetched);
+static EVEL_ERR_CODES openstack_metadata_parse(const char * json,
+                                               size_t json_size,
+                                               OPENSTACK_IDENTITY * parsed);
+static EVEL_ERR_CODES openstack_cache_read(OPENSTACK_IDENTITY * cached);
+static void openstack_cache_write(const OPENSTACK_IDENTITY * fetched);
+static const char * openstack_cache_path(void);
+static void openstack_identity_publish(const char * uuid,
+                                       const char * name,
+                                       int source_name);
+static void * openstack_metadata_refresh(void * arg);
 static EVEL_ERR_CODES json_get_top_level_string(const char * json_string,
                                                 const jsmntok_t *tokens,
                                                 int json_token_count,
@@ -83,6 +168,9 @@ static int jsoneq(const char *json, const jsmntok_t *tok, const char *s);
 /**************************************************************************//**
  * Download metadata from the OpenStack metadata service.
  *
+ * This blocks for up to ::OPENSTACK_METADATA_TIMEOUT seconds; applications
+ * which do not want to wait should use openstack_metadata_start() instead.
+ *
  * @param verbosity   Controls whether to generate debug to stdout.  Zero:
  *                    none.  Non-zero: generate debug.
  * @returns Status code
@@ -91,14 +179,8 @@ static int jsoneq(const char *json, const jsmntok_t *tok, const char *s);
  *****************************************************************************/
 EVEL_ERR_CODES openstack_metadata(int verbosity)
 {
-  int rc = EVEL_SUCCESS;
-  CURLcode curl_rc = CURLE_OK;
-  CURL * curl_handle = NULL;
-  MEMORY_CHUNK rx_chunk;
-  char curl_err_string[CURL_ERROR_SIZE] = "<NULL>";
-  jsmn_parser json_parser;
-  jsmntok_t tokens[MAX_METADATA_TOKENS];
-  int json_token_count = 0;
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  OPENSTACK_IDENTITY fetched;
 
   EVEL_ENTER();
 
@@ -108,6 +190,197 @@ EVEL_ERR_CODES openstack_metadata(int verbosity)
   /***************************************************************************/
   openstack_metadata_initialize();
 
+  rc = openstack_metadata_fetch(verbosity,
+                                OPENSTACK_METADATA_TIMEOUT * 1000L,
+                                &fetched);
+  if (rc == EVEL_SUCCESS)
+  {
+    openstack_identity_publish(fetched.uuid, fetched.name, 0);
+    openstack_cache_write(&fetched);
+  }
+
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Start non-blocking discovery of the OpenStack metadata.
+ *
+ * The default identity, or the one saved in the cache file by a previous
+ * run, is available as soon as this returns.  A background thread then
+ * queries the metadata service, retrying with backoff until it succeeds and
+ * re-checking every ::OPENSTACK_METADATA_REFRESH seconds after that.  Any
+ * change is published atomically and written to the cache file.
+ *
+ * The cache file is named by the ::EVEL_METADATA_CACHE_ENV environment
+ * variable, defaulting to ::EVEL_METADATA_CACHE_DEFAULT.
+ *
+ * @param verbosity   Controls whether to generate debug to stdout.  Zero:
+ *                    none.  Non-zero: generate debug.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS      On success, or if already started.
+ * @retval  EVEL_PTHREAD_LIBRARY_FAIL The refresh thread could not be started.
+ *****************************************************************************/
+EVEL_ERR_CODES openstack_metadata_start(int verbosity)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  OPENSTACK_IDENTITY cached;
+
+  EVEL_ENTER();
+
+  pthread_mutex_lock(&refresh_mutex);
+  if (refresh_running)
+  {
+    goto exit_label;
+  }
+
+  openstack_metadata_initialize();
+  if (openstack_cache_read(&cached) == EVEL_SUCCESS)
+  {
+    EVEL_INFO("Using cached OpenStack metadata: name %s, UUID %s",
+              cached.name, cached.uuid);
+    openstack_identity_publish(cached.uuid, cached.name, 0);
+  }
+
+  refresh_verbosity = verbosity;
+  refresh_stop = 0;
+  if (pthread_create(&refresh_thread,
+                     NULL,
+                     openstack_metadata_refresh,
+                     NULL) != 0)
+  {
+    rc = EVEL_PTHREAD_LIBRARY_FAIL;
+    log_error_state("Failed to start metadata refresh thread");
+    goto exit_label;
+  }
+  refresh_running = 1;
+
+exit_label:
+  pthread_mutex_unlock(&refresh_mutex);
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Stop the background metadata refresh.
+ *
+ * Waits for any fetch in progress, which is bounded by
+ * ::OPENSTACK_METADATA_TIMEOUT.  The current identity remains available.
+ *****************************************************************************/
+void openstack_metadata_stop(void)
+{
+  EVEL_ENTER();
+
+  pthread_mutex_lock(&refresh_mutex);
+  if (refresh_running)
+  {
+    refresh_stop = 1;
+    pthread_cond_signal(&refresh_cond);
+    pthread_mutex_unlock(&refresh_mutex);
+    pthread_join(refresh_thread, NULL);
+    pthread_mutex_lock(&refresh_mutex);
+    refresh_running = 0;
+  }
+  pthread_mutex_unlock(&refresh_mutex);
+
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Background refresh thread.
+ *
+ * @param arg   Unused.
+ *****************************************************************************/
+static void * openstack_metadata_refresh(void * arg)
+{
+  OPENSTACK_IDENTITY fetched;
+  OPENSTACK_IDENTITY cached;
+  int have_cached;
+  int delay = OPENSTACK_METADATA_RETRY;
+  struct timespec deadline;
+
+  (void) arg;
+
+  have_cached = (openstack_cache_read(&cached) == EVEL_SUCCESS);
+
+  pthread_mutex_lock(&refresh_mutex);
+  while (!refresh_stop)
+  {
+    pthread_mutex_unlock(&refresh_mutex);
+
+    if (openstack_metadata_fetch(refresh_verbosity,
+                                 OPENSTACK_METADATA_CONNECT_TIMEOUT_MS,
+                                 &fetched) == EVEL_SUCCESS)
+    {
+      /***********************************************************************/
+      /* Only publish and rewrite the cache when something has changed.      */
+      /***********************************************************************/
+      if (!have_cached ||
+          strcmp(fetched.uuid, cached.uuid) != 0 ||
+          strcmp(fetched.name, cached.name) != 0)
+      {
+        EVEL_INFO("OpenStack metadata updated: name %s, UUID %s",
+                  fetched.name, fetched.uuid);
+        openstack_identity_publish(fetched.uuid, fetched.name, 0);
+        openstack_cache_write(&fetched);
+        cached = fetched;
+        have_cached = 1;
+      }
+      delay = OPENSTACK_METADATA_REFRESH;
+    }
+    else
+    {
+      EVEL_DEBUG("Metadata service unavailable - retry in %d seconds", delay);
+      delay = (delay * 2 < OPENSTACK_METADATA_REFRESH) ?
+                                       delay * 2 : OPENSTACK_METADATA_REFRESH;
+    }
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += delay;
+
+    pthread_mutex_lock(&refresh_mutex);
+    while (!refresh_stop &&
+           pthread_cond_timedwait(&refresh_cond,
+                                  &refresh_mutex,
+                                  &deadline) != ETIMEDOUT)
+    {
+    }
+  }
+  pthread_mutex_unlock(&refresh_mutex);
+
+  return NULL;
+}
+
+/**************************************************************************//**
+ * Fetch and parse the metadata from the OpenStack metadata service.
+ *
+ * @param verbosity   Controls whether to generate debug to stdout.
+ * @param connect_timeout_ms  How long to wait for the connection to be
+ *                    established, in milliseconds.  The whole transfer is
+ *                    limited to ::OPENSTACK_METADATA_TIMEOUT seconds.
+ * @param[out] fetched  The identity from the metadata service.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS      On success - @p fetched filled in.
+ * @retval  ::EVEL_ERR_CODES  On failure.
+ *****************************************************************************/
+static EVEL_ERR_CODES openstack_metadata_fetch(int verbosity,
+                                               long connect_timeout_ms,
+                                               OPENSTACK_IDENTITY * fetched)
+{
+  int rc = EVEL_SUCCESS;
+  CURLcode curl_rc = CURLE_OK;
+  CURL * curl_handle = NULL;
+  MEMORY_CHUNK rx_chunk;
+  char curl_err_string[CURL_ERROR_SIZE] = "<NULL>";
+
+  EVEL_ENTER();
+
+  assert(fetched != NULL);
+
+  rx_chunk.memory = NULL;
+  rx_chunk.size = 0;
+
   /***************************************************************************/
   /* Get a curl handle which we'll use for accessing the metadata service.   */
   /***************************************************************************/
@@ -175,11 +448,22 @@ EVEL_ERR_CODES openstack_metadata(int verbosity)
   }
 
   /***************************************************************************/
-  /* Set the timeout for the operation.                                      */
+  /* Set the timeouts for the operation.  Signals must not be used for the   */
+  /* timeouts since this may run on a background thread.                     */
   /***************************************************************************/
   curl_rc = curl_easy_setopt(curl_handle,
                              CURLOPT_TIMEOUT,
                              OPENSTACK_METADATA_TIMEOUT);
+  if (curl_rc == CURLE_OK)
+  {
+    curl_rc = curl_easy_setopt(curl_handle,
+                               CURLOPT_CONNECTTIMEOUT_MS,
+                               connect_timeout_ms);
+  }
+  if (curl_rc == CURLE_OK)
+  {
+    curl_rc = curl_easy_setopt(curl_handle, CURLOPT_NOSIGNAL, 1L);
+  }
   if (curl_rc != CURLE_OK)
   {
     rc = EVEL_NO_METADATA;
@@ -236,61 +520,9 @@ EVEL_ERR_CODES openstack_metadata(int verbosity)
   }
   else
   {
-    /*************************************************************************/
-    /* We have some metadata available, so break it out into tokens.         */
-    /*************************************************************************/
     EVEL_DEBUG("Received metadata size = %d", rx_chunk.size);
     EVEL_INFO("Received metadata = %s", rx_chunk.memory);
-    jsmn_init(&json_parser);
-    json_token_count = jsmn_parse(&json_parser,
-                                  rx_chunk.memory, rx_chunk.size,
-                                  tokens, MAX_METADATA_TOKENS);
-
-    /*************************************************************************/
-    /* Check that we parsed some data and that the top level is as expected. */
-    /*************************************************************************/
-    if (json_token_count < 0 || tokens[0].type != JSMN_OBJECT)
-    {
-      rc = EVEL_BAD_METADATA;
-      EVEL_ERROR("Failed to parse received JSON OpenStack metadata.  "
-                 "Error code=%d", json_token_count);
-      goto exit_label;
-    }
-    else
-    {
-      EVEL_DEBUG("Extracted %d tokens from the JSON OpenStack metadata.  ",
-                                                             json_token_count);
-    }
-
-    /*************************************************************************/
-    /* Find the keys we want from the metadata.                              */
-    /*************************************************************************/
-    if (json_get_string(rx_chunk.memory,
-                        tokens,
-                        json_token_count,
-                        "uuid",
-                        vm_uuid) != EVEL_SUCCESS)
-    {
-      rc = EVEL_BAD_METADATA;
-      EVEL_ERROR("Failed to extract UUID from OpenStack metadata");
-    }
-    else
-    {
-      EVEL_DEBUG("UUID: %s", vm_uuid);
-    }
-    if (json_get_top_level_string(rx_chunk.memory,
-                                  tokens,
-                                  json_token_count,
-                                  "name",
-                                  vm_name) != EVEL_SUCCESS)
-    {
-      rc = EVEL_BAD_METADATA;
-      EVEL_ERROR("Failed to extract VM Name from OpenStack metadata");
-    }
-    else
-    {
-      EVEL_DEBUG("VM Name: %s", vm_name);
-    }
+    rc = openstack_metadata_parse(rx_chunk.memory, rx_chunk.size, fetched);
   }
 
 exit_label:
@@ -309,36 +541,346 @@ exit_label:
   return rc;
 }
 
+/**************************************************************************//**
+ * Extract the VM identity from metadata JSON.
+ *
+ * The cache file uses the same keys as the metadata service, so this parses
+ * both.
+ *
+ * @param[in] json        The JSON text.
+ * @param[in] json_size   Length of @p json.
+ * @param[out] parsed     The identity found.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS      Both the UUID and name were found.
+ * @retval  EVEL_BAD_METADATA On failure.
+ *****************************************************************************/
+static EVEL_ERR_CODES openstack_metadata_parse(const char * json,
+                                               size_t json_size,
+                                               OPENSTACK_IDENTITY * parsed)
+{
+  EVEL_ERR_CODES rc = EVEL_SUCCESS;
+  jsmn_parser json_parser;
+  jsmntok_t tokens[MAX_METADATA_TOKENS];
+  int json_token_count = 0;
+
+  EVEL_ENTER();
+
+  assert(json != NULL);
+  assert(parsed != NULL);
+
+  /***************************************************************************/
+  /* Break the metadata out into tokens.                                     */
+  /***************************************************************************/
+  jsmn_init(&json_parser);
+  json_token_count = jsmn_parse(&json_parser,
+                                json, json_size,
+                                tokens, MAX_METADATA_TOKENS);
+
+  /***************************************************************************/
+  /* Check that we parsed some data and that the top level is as expected.   */
+  /***************************************************************************/
+  if (json_token_count <= 0 || tokens[0].type != JSMN_OBJECT)
+  {
+    rc = EVEL_BAD_METADATA;
+    EVEL_ERROR("Failed to parse received JSON OpenStack metadata.  "
+               "Error code=%d", json_token_count);
+    goto exit_label;
+  }
+  else
+  {
+    EVEL_DEBUG("Extracted %d tokens from the JSON OpenStack metadata.  ",
+                                                           json_token_count);
+  }
+
+  /***************************************************************************/
+  /* Find the keys we want from the metadata.                                */
+  /***************************************************************************/
+  if (json_get_string(json,
+                      tokens,
+                      json_token_count,
+                      "uuid",
+                      parsed->uuid) != EVEL_SUCCESS)
+  {
+    rc = EVEL_BAD_METADATA;
+    EVEL_ERROR("Failed to extract UUID from OpenStack metadata");
+  }
+  else
+  {
+    EVEL_DEBUG("UUID: %s", parsed->uuid);
+  }
+  if (json_get_top_level_string(json,
+                                tokens,
+                                json_token_count,
+                                "name",
+                                parsed->name) != EVEL_SUCCESS)
+  {
+    rc = EVEL_BAD_METADATA;
+    EVEL_ERROR("Failed to extract VM Name from OpenStack metadata");
+  }
+  else
+  {
+    EVEL_DEBUG("VM Name: %s", parsed->name);
+  }
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Get the name of the metadata cache file.
+ *
+ * @returns The file name, or NULL if caching is disabled by setting
+ *          ::EVEL_METADATA_CACHE_ENV to an empty string.
+ *****************************************************************************/
+static const char * openstack_cache_path(void)
+{
+  const char * path = getenv(EVEL_METADATA_CACHE_ENV);
+
+  if (path == NULL)
+  {
+    return EVEL_METADATA_CACHE_DEFAULT;
+  }
+  return (path[0] != '\0') ? path : NULL;
+}
+
+/**************************************************************************//**
+ * Read the identity saved by a previous run.
+ *
+ * @param[out] cached   The identity from the cache file.
+ *
+ * @returns Status code
+ * @retval  EVEL_SUCCESS      On success - @p cached filled in.
+ * @retval  EVEL_NO_METADATA  There is no usable cache file.
+ *****************************************************************************/
+static EVEL_ERR_CODES openstack_cache_read(OPENSTACK_IDENTITY * cached)
+{
+  EVEL_ERR_CODES rc = EVEL_NO_METADATA;
+  const char * path = openstack_cache_path();
+  char json[MAX_METADATA_CACHE];
+  ssize_t json_size;
+  struct stat st;
+  int fd;
+
+  EVEL_ENTER();
+
+  assert(cached != NULL);
+
+  if (path == NULL)
+  {
+    goto exit_label;
+  }
+
+  fd = open(path, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+  if (fd < 0)
+  {
+    EVEL_DEBUG("No metadata cache file %s", path);
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* Only trust a file that we wrote and that nobody else can change.        */
+  /***************************************************************************/
+  if (fstat(fd, &st) != 0 ||
+      !S_ISREG(st.st_mode) ||
+      st.st_uid != geteuid() ||
+      (st.st_mode & (S_IWGRP | S_IWOTH)) != 0)
+  {
+    EVEL_ERROR("Ignoring metadata cache file %s not owned by us", path);
+    close(fd);
+    goto exit_label;
+  }
+  json_size = read(fd, json, sizeof(json));
+  close(fd);
+  if (json_size < 0)
+  {
+    EVEL_ERROR("Failed to read metadata cache file %s: %s",
+               path, strerror(errno));
+    goto exit_label;
+  }
+
+  if (openstack_metadata_parse(json, json_size, cached) == EVEL_SUCCESS)
+  {
+    rc = EVEL_SUCCESS;
+  }
+  else
+  {
+    EVEL_ERROR("Ignoring invalid metadata cache file %s", path);
+  }
+
+exit_label:
+  EVEL_EXIT();
+  return rc;
+}
+
+/**************************************************************************//**
+ * Save the identity for use by the next run.
+ *
+ * The file is written under a temporary name and renamed into place, so a
+ * crash part way through never leaves a truncated cache.  The temporary
+ * file is created by mkstemp() in the cache's own directory, which is made
+ * if it does not exist yet.
+ *
+ * @param[in] fetched   The identity from the metadata service.
+ *****************************************************************************/
+static void openstack_cache_write(const OPENSTACK_IDENTITY * fetched)
+{
+  const char * path = openstack_cache_path();
+  const char * slash;
+  char temp_path[PATH_MAX];
+  FILE * file;
+  int fd;
+  int dir_len;
+  int written;
+
+  EVEL_ENTER();
+
+  assert(fetched != NULL);
+
+  if (path == NULL)
+  {
+    goto exit_label;
+  }
+
+  /***************************************************************************/
+  /* The values are written without escaping, so skip any that need it.      */
+  /***************************************************************************/
+  if (strpbrk(fetched->uuid, "\"\\") != NULL ||
+      strpbrk(fetched->name, "\"\\") != NULL)
+  {
+    EVEL_DEBUG("Metadata needs escaping - not cached");
+    goto exit_label;
+  }
+
+  slash = strrchr(path, '/');
+  dir_len = (slash != NULL) ? (int) (slash - path) : 1;
+  if (snprintf(temp_path, sizeof(temp_path), "%.*s/.evel_metadata.XXXXXX",
+               dir_len, (slash != NULL) ? path : ".") >=
+                                                      (int) sizeof(temp_path))
+  {
+    EVEL_ERROR("Metadata cache file name too long: %s", path);
+    goto exit_label;
+  }
+
+  fd = mkstemp(temp_path);
+  if (fd < 0 && errno == ENOENT && dir_len > 0)
+  {
+    temp_path[dir_len] = '\0';
+    mkdir(temp_path, 0755);
+    temp_path[dir_len] = '/';
+    memcpy(temp_path + strlen(temp_path) - 6, "XXXXXX", 6);
+    fd = mkstemp(temp_path);
+  }
+  if (fd < 0)
+  {
+    EVEL_ERROR("Failed to create metadata cache file %s: %s",
+               temp_path, strerror(errno));
+    goto exit_label;
+  }
+
+  file = fdopen(fd, "w");
+  if (file == NULL)
+  {
+    EVEL_ERROR("Failed to create metadata cache file %s: %s",
+               temp_path, strerror(errno));
+    close(fd);
+    unlink(temp_path);
+    goto exit_label;
+  }
+  written = fprintf(file,
+                    "{\"uuid\": \"%s\", \"name\": \"%s\"}\n",
+                    fetched->uuid,
+                    fetched->name);
+  if (fclose(file) != 0 || written < 0 || rename(temp_path, path) != 0)
+  {
+    EVEL_ERROR("Failed to write metadata cache file %s: %s",
+               path, strerror(errno));
+    unlink(temp_path);
+  }
+
+exit_label:
+  EVEL_EXIT();
+}
+
+/**************************************************************************//**
+ * Publish a new identity.
+ *
+ * @param uuid        The VM UUID, or NULL to keep the current one.
+ * @param name        The VM name.
+ * @param source_name Non-zero if @p name was set by evel_set_source_name(),
+ *                    which takes precedence over the metadata service.
+ *****************************************************************************/
+static void openstack_identity_publish(const char * uuid,
+                                       const char * name,
+                                       int source_name)
+{
+  OPENSTACK_IDENTITY * new_identity;
+
+  assert(name != NULL);
+
+  new_identity = malloc(sizeof(OPENSTACK_IDENTITY));
+  assert(new_identity != NULL);
+
+  pthread_mutex_lock(&identity_mutex);
+  if (source_name)
+  {
+    name_overridden = 1;
+  }
+  strncpy(new_identity->uuid,
+          (uuid != NULL) ? uuid : identity->uuid,
+          MAX_METADATA_STRING);
+  new_identity->uuid[MAX_METADATA_STRING] = '\0';
+  strncpy(new_identity->name,
+          (name_overridden && !source_name) ? identity->name : name,
+          MAX_METADATA_STRING);
+  new_identity->name[MAX_METADATA_STRING] = '\0';
+  new_identity->retired = NULL;
+
+  if (identity != &empty_identity)
+  {
+    identity->retired = retired_identities;
+    retired_identities = identity;
+  }
+  __atomic_store_n(&identity, new_identity, __ATOMIC_RELEASE);
+  pthread_mutex_unlock(&identity_mutex);
+}
 
 /**************************************************************************//**
  * Initialize default values for vm_name and vm_uuid - for testing purposes.
  *****************************************************************************/
 void openstack_metadata_initialize()
 {
-  char hostname[MAX_METADATA_STRING];
+  char hostname[MAX_METADATA_STRING+1];
+  char uuid[MAX_METADATA_STRING+1];
+  char name[MAX_METADATA_STRING+1];
 
   FILE * f = fopen ("/proc/sys/kernel/random/uuid", "r");
 
-  strncpy(vm_uuid,
+  strncpy(uuid,
           "Dummy VM UUID - No Metadata available",
           MAX_METADATA_STRING);
-  strncpy(vm_name,
+  strncpy(name,
           "Dummy VM name - No Metadata available",
           MAX_METADATA_STRING);
 
-  if( gethostname(hostname, 1024) != -1 )
-      strcpy(vm_name,hostname);
+  if( gethostname(hostname, sizeof(hostname)) != -1 )
+  {
+      hostname[MAX_METADATA_STRING] = '\0';
+      strcpy(name,hostname);
+  }
 
   if (f)
   {
-    if (fgets(vm_uuid,MAX_METADATA_STRING, f)!=NULL)
+    if (fgets(uuid,MAX_METADATA_STRING, f)!=NULL)
     {
-      vm_uuid[strlen( vm_uuid ) - 1 ] = '\0';
-      EVEL_DEBUG("VM UUID: %s", vm_uuid);
+      uuid[strlen( uuid ) - 1 ] = '\0';
+      EVEL_DEBUG("VM UUID: %s", uuid);
     }
     fclose (f);
   }
 
+  openstack_identity_publish(uuid, name, 0);
 }
 
 /**************************************************************************//**
@@ -354,9 +896,9 @@ EVEL_ERR_CODES evel_set_source_name(char * src_name)
   if( src_name && src_name[0] )
   {
       if( strlen(src_name) < MAX_METADATA_STRING ){
-          strcpy(vm_name,src_name);
+          openstack_identity_publish(NULL, src_name, 1);
           return EVEL_SUCCESS;
-       } else 
+       } else
           EVEL_DEBUG("Event Source Name too long");
   }
   else
@@ -425,6 +967,10 @@ static EVEL_ERR_CODES json_get_string(const char * json_string,
       if (jsoneq(json_string, &tokens[token_num], key) == 0)
       {
         token_len = tokens[token_num + 1].end - tokens[token_num + 1].start;
+        if (token_len > MAX_METADATA_STRING)
+        {
+          token_len = MAX_METADATA_STRING;
+        }
         EVEL_DEBUG("Token %d len %d matches at %d to %d", token_num,
                                                    tokens[token_num + 1].start,
                                                    tokens[token_num + 1].end);
@@ -550,6 +1096,10 @@ static EVEL_ERR_CODES json_get_top_level_string(const char * json_string,
         if (bracket_count == 1)
         {
           token_len = tokens[token_num + 1].end - tokens[token_num + 1].start;
+          if (token_len > MAX_METADATA_STRING)
+          {
+            token_len = MAX_METADATA_STRING;
+          }
           EVEL_DEBUG("Token %d len %d matches at top level at %d to %d",
                      token_num,
                      tokens[token_num + 1].start,
@@ -615,6 +1165,7 @@ static int jsoneq(const char *json, const jsmntok_t *tok, const char *s) {
   return -1;
 }
 
+
 /**************************************************************************//**
  * Get the VM name provided by the metadata service.
  *
@@ -622,7 +1173,7 @@ static int jsoneq(const char *json, const jsmntok_t *tok, const char *s) {
  *****************************************************************************/
 const char *openstack_vm_name()
 {
-  return vm_name;
+  return __atomic_load_n(&identity, __ATOMIC_ACQUIRE)->name;
 }
 
 /**************************************************************************//**
@@ -632,5 +1183,5 @@ const char *openstack_vm_name()
  *****************************************************************************/
 const char *openstack_vm_uuid()
 {
-  return vm_uuid;
+  return __atomic_load_n(&identity, __ATOMIC_ACQUIRE)->uuid;
 }
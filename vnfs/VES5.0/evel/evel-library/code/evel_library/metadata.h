@@ -25,6 +25,13 @@
 
 #include "evel.h"
 
+/*****************************************************************************/
+/* Environment variable naming the file used to cache the metadata between   */
+/* runs.  Set it to an empty string to disable the cache.                    */
+/*****************************************************************************/
+#define EVEL_METADATA_CACHE_ENV "EVEL_METADATA_CACHE"
+#define EVEL_METADATA_CACHE_DEFAULT "/var/lib/evel/metadata.json"
+
 /**************************************************************************//**
  * Download metadata from the OpenStack metadata service.
  *
@@ -36,6 +43,22 @@
  *****************************************************************************/
 EVEL_ERR_CODES openstack_metadata(int verbosity);
 
+/**************************************************************************//**
+ * Start non-blocking discovery of the OpenStack metadata.
+ *
+ * @param verbosity   Controls whether to generate debug to stdout.  Zero:
+ *                    none.  Non-zero: generate debug.
+ * @returns Status code
+ * @retval  EVEL_SUCCESS      On success
+ * @retval  ::EVEL_ERR_CODES  On failure.
+ *****************************************************************************/
+EVEL_ERR_CODES openstack_metadata_start(int verbosity);
+
+/**************************************************************************//**
+ * Stop the background metadata refresh.
+ *****************************************************************************/
+void openstack_metadata_stop(void);
+
 /**************************************************************************//**
  * Initialize default values for vm_name and vm_uuid - for testing purposes.
  *****************************************************************************/
@@ -0,0 +1,284 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+
+/**************************************************************************//**
+ * @file
+ * Decoder for EVEL binary function trace files.
+ *
+ * Reads a file written by ::evel_trace_start and prints one line per trace
+ * point, merged across threads in timestamp order:
+ *
+ *   2017-03-01 10:15:02.123456789 [ 4242] | | Enter evel_new_fault {
+ *
+ * Usage: evel_trace_decode [-r] <trace file>
+ *
+ *   -r  Print records in file order instead of sorting by timestamp.
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "evel.h"
+#include "evel_trace.h"
+
+/**************************************************************************//**
+ * A decoded trace point.
+ *****************************************************************************/
+typedef struct trace_point {
+  unsigned long long timestamp;
+  unsigned long long order;
+  unsigned int thread_id;
+  unsigned int string_id;
+  unsigned short kind;
+  unsigned short depth;
+} TRACE_POINT;
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static int load_trace(FILE * file);
+static void print_trace(void);
+static int compare_points(const void * a, const void * b);
+static const char * lookup_string(unsigned int id);
+
+/*****************************************************************************/
+/* Decoded contents of the trace file.                                       */
+/*****************************************************************************/
+static EVEL_TRACE_FILE_HEADER header;
+static TRACE_POINT * points = NULL;
+static size_t num_points = 0;
+static char ** strings = NULL;
+static size_t num_strings = 0;
+static unsigned long long dropped = 0;
+
+/**************************************************************************//**
+ * Main function.
+ *
+ * @param[in] argc  Argument count.
+ * @param[in] argv  Argument vector - see usage above.
+ *
+ * @returns 0 on success, 1 on failure.
+ *****************************************************************************/
+int main(int argc, char ** argv)
+{
+  FILE * file;
+  int raw = 0;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "r")) != -1)
+  {
+    switch (opt)
+    {
+    case 'r':
+      raw = 1;
+      break;
+
+    default:
+      fprintf(stderr, "Usage: %s [-r] <trace file>\n", argv[0]);
+      return 1;
+    }
+  }
+
+  if (optind != argc - 1)
+  {
+    fprintf(stderr, "Usage: %s [-r] <trace file>\n", argv[0]);
+    return 1;
+  }
+
+  file = fopen(argv[optind], "r");
+  if (file == NULL)
+  {
+    perror(argv[optind]);
+    return 1;
+  }
+
+  if (load_trace(file) != 0)
+  {
+    fclose(file);
+    return 1;
+  }
+  fclose(file);
+
+  if (!raw)
+  {
+    qsort(points, num_points, sizeof(TRACE_POINT), compare_points);
+  }
+  print_trace();
+
+  if (dropped != 0)
+  {
+    printf("*** %llu trace points were dropped because a ring was full\n",
+           dropped);
+  }
+
+  return 0;
+}
+
+/**************************************************************************//**
+ * Read the whole trace file into ::points and ::strings.
+ *
+ * @param file  The open trace file.
+ *
+ * @returns 0 on success, 1 if the file is not a valid trace.
+ *****************************************************************************/
+static int load_trace(FILE * file)
+{
+  EVEL_TRACE_FILE_RECORD record;
+  size_t points_size = 0;
+  char * name;
+
+  if (fread(&header, sizeof(header), 1, file) != 1 ||
+      memcmp(header.magic, EVEL_TRACE_MAGIC, sizeof(EVEL_TRACE_MAGIC)) != 0)
+  {
+    fprintf(stderr, "Not an EVEL trace file\n");
+    return 1;
+  }
+  if (header.version != EVEL_TRACE_VERSION ||
+      header.record_size != sizeof(EVEL_TRACE_FILE_RECORD))
+  {
+    fprintf(stderr, "Unsupported trace file version %u\n", header.version);
+    return 1;
+  }
+
+  while (fread(&record, sizeof(record), 1, file) == 1)
+  {
+    switch (record.kind)
+    {
+    case EVEL_TRACE_KIND_STRING:
+      name = malloc(record.length + 1);
+      if (name == NULL ||
+          (record.length > 0 && fread(name, record.length, 1, file) != 1))
+      {
+        fprintf(stderr, "Truncated trace file\n");
+        free(name);
+        return 1;
+      }
+      name[record.length] = '\0';
+      if (record.string_id >= num_strings)
+      {
+        strings = realloc(strings, (record.string_id + 1) * sizeof(char *));
+        if (strings == NULL)
+        {
+          fprintf(stderr, "Out of memory\n");
+          return 1;
+        }
+        memset(strings + num_strings,
+               0,
+               (record.string_id + 1 - num_strings) * sizeof(char *));
+        num_strings = record.string_id + 1;
+      }
+      free(strings[record.string_id]);
+      strings[record.string_id] = name;
+      break;
+
+    case EVEL_TRACE_KIND_ENTER:
+    case EVEL_TRACE_KIND_EXIT:
+      if (num_points == points_size)
+      {
+        points_size = (points_size == 0) ? 4096 : points_size * 2;
+        points = realloc(points, points_size * sizeof(TRACE_POINT));
+        if (points == NULL)
+        {
+          fprintf(stderr, "Out of memory\n");
+          return 1;
+        }
+      }
+      points[num_points].timestamp = record.value;
+      points[num_points].order = num_points;
+      points[num_points].thread_id = record.thread_id;
+      points[num_points].string_id = record.string_id;
+      points[num_points].kind = record.kind;
+      points[num_points].depth = record.length;
+      num_points++;
+      break;
+
+    case EVEL_TRACE_KIND_DROPPED:
+      dropped += record.value;
+      break;
+
+    default:
+      fprintf(stderr, "Unknown record kind %u\n", record.kind);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/**************************************************************************//**
+ * Print every trace point as text.
+ *****************************************************************************/
+static void print_trace(void)
+{
+  TRACE_POINT * point;
+  unsigned long long wallclock;
+  time_t seconds;
+  struct tm tm;
+  char date[32];
+  size_t i;
+
+  for (i = 0; i < num_points; i++)
+  {
+    point = &points[i];
+    wallclock = header.realtime_base + (point->timestamp -
+                                        header.monotonic_base);
+    seconds = (time_t) (wallclock / 1000000000ULL);
+    gmtime_r(&seconds, &tm);
+    strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", &tm);
+
+    printf("%s.%09llu [%6u] %.*s%s %s %s\n",
+           date,
+           wallclock % 1000000000ULL,
+           point->thread_id,
+           point->depth * 2,
+           INDENT_SEPARATORS,
+           (point->kind == EVEL_TRACE_KIND_ENTER) ? "Enter" : "Exit",
+           lookup_string(point->string_id),
+           (point->kind == EVEL_TRACE_KIND_ENTER) ? "{" : "}");
+  }
+}
+
+/**************************************************************************//**
+ * Order trace points by timestamp, then by position in the file.
+ *****************************************************************************/
+static int compare_points(const void * a, const void * b)
+{
+  const TRACE_POINT * pa = a;
+  const TRACE_POINT * pb = b;
+
+  if (pa->timestamp != pb->timestamp)
+  {
+    return (pa->timestamp < pb->timestamp) ? -1 : 1;
+  }
+  return (pa->order < pb->order) ? -1 : (pa->order > pb->order);
+}
+
+/**************************************************************************//**
+ * Look up a function name by string ID.
+ *****************************************************************************/
+static const char * lookup_string(unsigned int id)
+{
+  if (id < num_strings && strings[id] != NULL)
+  {
+    return strings[id];
+  }
+  return "<unknown>";
+}
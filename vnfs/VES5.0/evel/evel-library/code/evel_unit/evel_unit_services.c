@@ -0,0 +1,2055 @@
+/*************************************************************************//**
+ *
+ * Copyright © 2017 AT&T Intellectual Property. All rights reserved.
+ *
+ * Unless otherwise specified, all software contained herein is
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and 
+ * limitations under the License.
+ *
+ * ECOMP is a trademark and service mark of AT&T Intellectual Property.
+ ****************************************************************************/
+/**************************************************************************//**
+ * @file
+ * Unit tests for the library's services: ID generation, counters and
+ * statistics, the system collectors, configuration, commands and probes,
+ * scheduling, log following and matching, syslog and collectd receivers,
+ * threshold rules, delta reporting, application metrics and scraping.
+ *
+ * Unlike evel_unit.c, these run against the real clock.
+ *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+
+#include "evel.h"
+#include "evel_internal.h"
+
+/*****************************************************************************/
+/* Local prototypes.                                                         */
+/*****************************************************************************/
+static void test_ids();
+static void test_counter_delta();
+static void test_counter_update();
+static void test_stats();
+static void test_cpustats();
+static void test_memstats();
+static void test_diskstats();
+static void test_fsstats();
+static void test_ifstats();
+static void test_config();
+static void test_command();
+static void test_probe();
+static void test_scheduler();
+static void test_tail();
+static void test_match();
+static void test_receiver();
+static void test_syslog_addl_fields();
+static void test_rules();
+static void test_delta();
+static void test_metrics();
+static void test_collectd();
+static void test_prometheus();
+
+/**************************************************************************//**
+ * Main function.
+ *
+ * Runs all unit test cases, and fails hard on the first failure.
+ *
+ * @param[in] argc  Argument count.
+ * @param[in] argv  Argument vector - unused.
+ *****************************************************************************/
+int main(int argc, char ** argv)
+{
+  assert(argc >= 0);
+  assert(argv != NULL);
+
+  /***************************************************************************/
+  /* Minimal initialisation to exercise the services.                        */
+  /***************************************************************************/
+  functional_role = "UNIT TEST";
+  log_initialize(EVEL_LOG_DEBUG, "EVEL");
+
+  /***************************************************************************/
+  /* Test event sequence and ID generation.                                  */
+  /***************************************************************************/
+  test_ids();
+
+  /***************************************************************************/
+  /* Test counter deltas.                                                    */
+  /***************************************************************************/
+  test_counter_delta();
+  test_counter_update();
+
+  /***************************************************************************/
+  /* Test sample statistics.                                                 */
+  /***************************************************************************/
+  test_stats();
+
+  /***************************************************************************/
+  /* Test CPU statistics.                                                    */
+  /***************************************************************************/
+  test_cpustats();
+
+  /***************************************************************************/
+  /* Memory, disk and filesystem collectors.                                 */
+  /***************************************************************************/
+  test_memstats();
+  test_diskstats();
+  test_fsstats();
+
+  /***************************************************************************/
+  /* Test network interface counters.                                        */
+  /***************************************************************************/
+  test_ifstats();
+
+  /***************************************************************************/
+  /* Test configuration parsing and reload.                                  */
+  /***************************************************************************/
+  test_config();
+
+  /***************************************************************************/
+  /* Test command templates.                                                 */
+  /***************************************************************************/
+  test_command();
+
+  /***************************************************************************/
+  /* Test running probe commands in parallel.                                */
+  /***************************************************************************/
+  test_probe();
+
+  /***************************************************************************/
+  /* Test the periodic job scheduler.                                        */
+  /***************************************************************************/
+  test_scheduler();
+
+  /***************************************************************************/
+  /* Test following a log file.                                              */
+  /***************************************************************************/
+  test_tail();
+
+  /***************************************************************************/
+  /* Test matching lines against many patterns.                              */
+  /***************************************************************************/
+  test_match();
+
+  /***************************************************************************/
+  /* Test receiving syslog messages.                                         */
+  /***************************************************************************/
+  test_receiver();
+
+  /***************************************************************************/
+  /* Test adding fields to a syslog event.                                   */
+  /***************************************************************************/
+  test_syslog_addl_fields();
+
+  /***************************************************************************/
+  /* Test raising and clearing threshold rules.                              */
+  /***************************************************************************/
+  test_rules();
+
+  /***************************************************************************/
+  /* Test leaving unchanged measurements out under delta reporting.          */
+  /***************************************************************************/
+  test_delta();
+
+  /***************************************************************************/
+  /* Test reading application metrics from shared memory.                    */
+  /***************************************************************************/
+  test_metrics();
+
+  /***************************************************************************/
+  /* Test decoding collectd's metrics into measurements.                     */
+  /***************************************************************************/
+  test_collectd();
+
+  /***************************************************************************/
+  /* Test scraping the latest measurement values.                            */
+  /***************************************************************************/
+  test_prometheus();
+
+  printf ("\nAll Tests Passed\n");
+
+  return 0;
+}
+
+/**************************************************************************//**
+ * Numbers drawn by one of the threads in test_ids().
+ *****************************************************************************/
+#define TEST_IDS_THREADS 4
+#define TEST_IDS_PER_THREAD 5000
+
+typedef struct test_ids_draw {
+  EVEL_ID_GENERATOR * generator;
+  unsigned long long sequences[TEST_IDS_PER_THREAD];
+  unsigned long long ids[TEST_IDS_PER_THREAD];
+  int id_errors;
+} TEST_IDS_DRAW;
+
+static void * test_ids_thread(void * context)
+{
+  TEST_IDS_DRAW * draw = context;
+  char id[EVEL_ID_MAX_LEN + 1];
+  char expected[EVEL_ID_MAX_LEN + 1];
+  int ii;
+
+  for (ii = 0; ii < TEST_IDS_PER_THREAD; ii++)
+  {
+    draw->sequences[ii] = evel_next_event_sequence();
+    draw->ids[ii] = evel_id_generator_next(draw->generator, id, sizeof(id));
+    snprintf(expected, sizeof(expected), "fault%09llu", draw->ids[ii]);
+    if (strcmp(id, expected) != 0)
+    {
+      draw->id_errors++;
+    }
+  }
+
+  return NULL;
+}
+
+static int test_ids_compare(const void * a, const void * b)
+{
+  const unsigned long long * x = a;
+  const unsigned long long * y = b;
+
+  return (*x > *y) - (*x < *y);
+}
+
+/**************************************************************************//**
+ * Test event sequence numbers and IDs drawn by many threads at once.
+ *****************************************************************************/
+void test_ids()
+{
+  EVEL_ID_GENERATOR generator;
+  TEST_IDS_DRAW * draws;
+  pthread_t threads[TEST_IDS_THREADS];
+  unsigned long long * all;
+  char id[EVEL_ID_MAX_LEN + 1];
+  int ii;
+  int jj;
+
+  /***************************************************************************/
+  /* IDs are padded to a fixed width, widening only when they must.          */
+  /***************************************************************************/
+  assert(evel_format_event_id(id, sizeof(id), "fault", 42, 9) == 14);
+  assert(strcmp(id, "fault000000042") == 0);
+  assert(evel_format_event_id(id, sizeof(id), "", 0, 9) == 9);
+  assert(strcmp(id, "000000000") == 0);
+  assert(evel_format_event_id(id, sizeof(id), "x", 1234567890123ULL, 9) == 14);
+  assert(strcmp(id, "x1234567890123") == 0);
+  assert(evel_format_event_id(id, sizeof(id), "", 18446744073709551615ULL, 1)
+         == 20);
+  assert(strcmp(id, "18446744073709551615") == 0);
+  assert(evel_format_event_id(id, 10, "fault", 42, 9) == 0);
+
+  evel_id_generator_init(&generator, "fault", 1);
+  assert(evel_id_generator_next(&generator, id, sizeof(id)) == 1);
+  assert(strcmp(id, "fault000000001") == 0);
+
+  /***************************************************************************/
+  /* Threads drawing at once get unique numbers, increasing in each thread.  */
+  /***************************************************************************/
+  draws = calloc(TEST_IDS_THREADS, sizeof(TEST_IDS_DRAW));
+  all = malloc(TEST_IDS_THREADS * TEST_IDS_PER_THREAD * sizeof(*all));
+  assert(draws != NULL && all != NULL);
+  for (ii = 0; ii < TEST_IDS_THREADS; ii++)
+  {
+    draws[ii].generator = &generator;
+    assert(pthread_create(&threads[ii], NULL, test_ids_thread, &draws[ii])
+           == 0);
+  }
+  for (ii = 0; ii < TEST_IDS_THREADS; ii++)
+  {
+    assert(pthread_join(threads[ii], NULL) == 0);
+    assert(draws[ii].id_errors == 0);
+    for (jj = 1; jj < TEST_IDS_PER_THREAD; jj++)
+    {
+      assert(draws[ii].sequences[jj] > draws[ii].sequences[jj - 1]);
+      assert(draws[ii].ids[jj] > draws[ii].ids[jj - 1]);
+    }
+  }
+
+  for (ii = 0; ii < TEST_IDS_THREADS; ii++)
+  {
+    memcpy(all + ii * TEST_IDS_PER_THREAD,
+           draws[ii].sequences,
+           sizeof(draws[ii].sequences));
+  }
+  qsort(all, TEST_IDS_THREADS * TEST_IDS_PER_THREAD, sizeof(*all),
+        test_ids_compare);
+  for (ii = 1; ii < TEST_IDS_THREADS * TEST_IDS_PER_THREAD; ii++)
+  {
+    assert(all[ii] != all[ii - 1]);
+  }
+
+  /***************************************************************************/
+  /* The generator's numbers are all used, with none missed or repeated.     */
+  /***************************************************************************/
+  for (ii = 0; ii < TEST_IDS_THREADS; ii++)
+  {
+    memcpy(all + ii * TEST_IDS_PER_THREAD,
+           draws[ii].ids,
+           sizeof(draws[ii].ids));
+  }
+  qsort(all, TEST_IDS_THREADS * TEST_IDS_PER_THREAD, sizeof(*all),
+        test_ids_compare);
+  for (ii = 0; ii < TEST_IDS_THREADS * TEST_IDS_PER_THREAD; ii++)
+  {
+    assert(all[ii] == (unsigned long long) ii + 2);
+  }
+
+  free(all);
+  free(draws);
+}
+
+/**************************************************************************//**
+ * Test counter deltas across wraps and resets.
+ *****************************************************************************/
+void test_counter_delta()
+{
+  int reset = 0;
+
+  /***************************************************************************/
+  /* Normal increase.                                                        */
+  /***************************************************************************/
+  assert(evel_counter_delta(100, 150, 64, &reset) == 50);
+  assert(reset == 0);
+  assert(evel_counter_delta(100, 100, EVEL_COUNTER_AUTO, &reset) == 0);
+  assert(reset == 0);
+
+  /***************************************************************************/
+  /* 32-bit wrap, with the width known and guessed.                          */
+  /***************************************************************************/
+  assert(evel_counter_delta(0xFFFFFF00ULL, 0x100, 32, &reset) == 0x200);
+  assert(reset == 0);
+  assert(evel_counter_delta(0xFFFFFF00ULL, 0x100, EVEL_COUNTER_AUTO, &reset)
+         == 0x200);
+  assert(reset == 0);
+  assert(evel_counter_delta(0xFFFFFFFFULL, 0, 32, &reset) == 1);
+  assert(reset == 0);
+
+  /***************************************************************************/
+  /* 64-bit wrap.                                                            */
+  /***************************************************************************/
+  assert(evel_counter_delta(0xFFFFFFFFFFFFFF00ULL, 0x100, 64, &reset)
+         == 0x200);
+  assert(reset == 0);
+
+  /***************************************************************************/
+  /* Reset: counted from zero.                                               */
+  /***************************************************************************/
+  assert(evel_counter_delta(1000, 10, 64, &reset) == 10);
+  assert(reset == 1);
+  assert(evel_counter_delta(1000, 10, EVEL_COUNTER_AUTO, &reset) == 10);
+  assert(reset == 1);
+  assert(evel_counter_delta(0x100000005ULL, 3, EVEL_COUNTER_AUTO, &reset)
+         == 3);
+  assert(reset == 1);
+  assert(evel_counter_delta(1000, 10, 64, NULL) == 10);
+}
+
+/**************************************************************************//**
+ * Test counter deltas and rates across successive readings.
+ *****************************************************************************/
+void test_counter_update()
+{
+  EVEL_COUNTER counter;
+
+  evel_counter_init(&counter, EVEL_COUNTER_AUTO);
+  assert(!counter.valid);
+
+  /***************************************************************************/
+  /* The first reading has no delta.                                         */
+  /***************************************************************************/
+  evel_counter_update(&counter, 0xFFFFF000ULL, 1000000);
+  assert(counter.valid);
+  assert(counter.value == 0xFFFFF000ULL);
+  assert(counter.delta == 0);
+  assert(counter.rate == 0.0);
+
+  /***************************************************************************/
+  /* Two seconds later, having wrapped.                                      */
+  /***************************************************************************/
+  evel_counter_update(&counter, 0x1000, 3000000);
+  assert(counter.value == 0x1000);
+  assert(counter.delta == 0x2000);
+  assert(counter.rate == 4096.0);
+  assert(!counter.reset);
+
+  /***************************************************************************/
+  /* Then reset.                                                             */
+  /***************************************************************************/
+  evel_counter_update(&counter, 500, 4000000);
+  assert(counter.delta == 500);
+  assert(counter.rate == 500.0);
+  assert(counter.reset);
+}
+
+/**************************************************************************//**
+ * Test sample statistics and their percentile estimates.
+ *****************************************************************************/
+void test_stats()
+{
+  EVEL_STATS stats;
+  double p50;
+  double p99;
+  int ii;
+
+  evel_stats_reset(&stats);
+  assert(stats.count == 0);
+  assert(evel_stats_mean(&stats) == 0.0);
+  assert(evel_stats_percentile(&stats, 50.0) == 0.0);
+
+  /***************************************************************************/
+  /* 1 to 1000: min, max and mean are exact; percentiles are within the      */
+  /* width of a bucket.                                                      */
+  /***************************************************************************/
+  for (ii = 1; ii <= 1000; ii++)
+  {
+    evel_stats_add(&stats, (double) ii);
+  }
+  assert(stats.count == 1000);
+  assert(stats.min == 1.0);
+  assert(stats.max == 1000.0);
+  assert(evel_stats_mean(&stats) == 500.5);
+
+  p50 = evel_stats_percentile(&stats, 50.0);
+  p99 = evel_stats_percentile(&stats, 99.0);
+  assert(p50 > 500.0 * (1.0 - 1.0 / EVEL_STATS_SUB_BUCKETS));
+  assert(p50 < 500.0 * (1.0 + 1.0 / EVEL_STATS_SUB_BUCKETS));
+  assert(p99 > 990.0 * (1.0 - 1.0 / EVEL_STATS_SUB_BUCKETS));
+  assert(p99 <= 1000.0);
+  assert(evel_stats_percentile(&stats, 0.0) == 1.0);
+  assert(evel_stats_percentile(&stats, 100.0) == 1000.0);
+
+  /***************************************************************************/
+  /* A single burst shows in the max and the top percentile.                 */
+  /***************************************************************************/
+  evel_stats_reset(&stats);
+  for (ii = 0; ii < 99; ii++)
+  {
+    evel_stats_add(&stats, 10.0);
+  }
+  evel_stats_add(&stats, 1.0e9);
+  assert(stats.max == 1.0e9);
+  p50 = evel_stats_percentile(&stats, 50.0);
+  assert(p50 >= 10.0 && p50 < 10.0 * (1.0 + 1.0 / EVEL_STATS_SUB_BUCKETS));
+  assert(evel_stats_percentile(&stats, 100.0) == 1.0e9);
+
+  /***************************************************************************/
+  /* Out of range values.                                                    */
+  /***************************************************************************/
+  evel_stats_reset(&stats);
+  evel_stats_add(&stats, -5.0);
+  evel_stats_add(&stats, 1.0e18);
+  assert(stats.buckets[0] == 1);
+  assert(stats.buckets[EVEL_STATS_BUCKETS - 1] == 1);
+  assert(stats.min == -5.0);
+  assert(evel_stats_percentile(&stats, 0.0) == -5.0);
+}
+
+/**************************************************************************//**
+ * Write a test file.
+ *
+ * @param path      Template for the file name, updated with the name used.
+ * @param contents  What to write.
+ *****************************************************************************/
+static void write_test_file(char * path, const char * contents)
+{
+  ssize_t written;
+  int fd = mkstemp(path);
+  assert(fd >= 0);
+  written = write(fd, contents, strlen(contents));
+  assert(written == (ssize_t) strlen(contents));
+  close(fd);
+}
+
+/**************************************************************************//**
+ * Test per-CPU usage from /proc/stat.
+ *****************************************************************************/
+void test_cpustats()
+{
+  EVEL_CPU_SNAPSHOT before;
+  EVEL_CPU_SNAPSHOT after;
+  EVENT_MEASUREMENT * measurement = NULL;
+  MEASUREMENT_CPU_USE * cpu_use = NULL;
+  DLIST_ITEM * item = NULL;
+  char path_before[] = "/tmp/evel_unit_statXXXXXX";
+  char path_after[] = "/tmp/evel_unit_statXXXXXX";
+
+  write_test_file(path_before,
+    "cpu  200 0 100 700 0 0 0 0 0 0\n"
+    "cpu0 100 0 50 350 0 0 0 0 0 0\n"
+    "cpu1 100 0 50 350 0 0 0 0 0 0\n"
+    "intr 12345 1 2 3\n"
+    "ctxt 999\n");
+  write_test_file(path_after,
+    "cpu  300 20 150 1020 10 0 0 0 0 0\n"
+    "cpu0 160 10 70 450 5 2 3 0 0 0\n"
+    "cpu1 100 0 50 350 0 0 0 0 0 0\n"
+    "cpu2 5 0 5 90 0 0 0 0 0 0\n"
+    "intr 23456 1 2 3\n");
+
+  assert(evel_cpu_snapshot_init(&before) == EVEL_SUCCESS);
+  assert(evel_cpu_snapshot_init(&after) == EVEL_SUCCESS);
+  assert(evel_cpustats_read_procfs(&before, path_before) == EVEL_SUCCESS);
+  assert(evel_cpustats_read_procfs(&after, path_after) == EVEL_SUCCESS);
+  assert(before.num_cpus == 2);
+  assert(after.num_cpus == 3);
+  assert(strcmp(after.cpus[2].id, "cpu2") == 0);
+  assert(after.cpus[0].softirq == 3);
+
+  /***************************************************************************/
+  /* cpu0 ran for 200 jiffies; cpu1 did not tick and cpu2 is new, so only    */
+  /* cpu0 is reported.                                                       */
+  /***************************************************************************/
+  measurement = evel_new_measurement(1, "CPU", "cpu_stats");
+  assert(measurement != NULL);
+  evel_cpustats_measurement_add(measurement, &after, &before);
+  item = dlist_get_first(&measurement->cpu_usage);
+  assert(item != NULL);
+  assert(dlist_get_next(item) == NULL);
+  cpu_use = (MEASUREMENT_CPU_USE *) item->item;
+  assert(strcmp(cpu_use->id, "cpu0") == 0);
+  assert(cpu_use->usage == 47.5);
+  assert(cpu_use->user.value == 30.0);
+  assert(cpu_use->nice.value == 5.0);
+  assert(cpu_use->sys.value == 10.0);
+  assert(cpu_use->idle.value == 50.0);
+  assert(cpu_use->wait.value == 2.5);
+  assert(cpu_use->intrpt.value == 1.0);
+  assert(cpu_use->softirq.value == 1.5);
+  assert(cpu_use->steal.value == 0.0);
+  evel_free_event(measurement);
+
+  /***************************************************************************/
+  /* Without an earlier snapshot, usage is since boot.                       */
+  /***************************************************************************/
+  measurement = evel_new_measurement(1, "CPU", "cpu_stats");
+  assert(measurement != NULL);
+  evel_cpustats_measurement_add(measurement, &before, NULL);
+  item = dlist_get_first(&measurement->cpu_usage);
+  assert(item != NULL);
+  cpu_use = (MEASUREMENT_CPU_USE *) item->item;
+  assert(cpu_use->usage == 30.0);
+  evel_free_event(measurement);
+
+  evel_cpu_snapshot_free(&before);
+  evel_cpu_snapshot_free(&after);
+  unlink(path_before);
+  unlink(path_after);
+}
+
+void test_memstats()
+{
+  EVEL_MEM_STATS stats;
+  EVENT_MEASUREMENT * measurement = NULL;
+  MEASUREMENT_MEM_USE * mem_use = NULL;
+  DLIST_ITEM * item = NULL;
+  char path[] = "/tmp/evel_unit_meminfoXXXXXX";
+  char path_bad[] = "/tmp/evel_unit_meminfoXXXXXX";
+
+  write_test_file(path,
+    "MemTotal:        8000000 kB\n"
+    "MemFree:         3000000 kB\n"
+    "MemAvailable:    5000000 kB\n"
+    "Buffers:          200000 kB\n"
+    "Cached:          1500000 kB\n"
+    "SwapCached:            0 kB\n"
+    "SReclaimable:     250000 kB\n"
+    "SUnreclaim:        50000 kB\n");
+
+  assert(evel_memstats_read_procfs(&stats, path) == EVEL_SUCCESS);
+  assert(stats.total == 8000000);
+  assert(stats.free == 3000000);
+  assert(stats.buffers == 200000);
+  assert(stats.cached == 1500000);
+  assert(stats.slab_reclaimable == 250000);
+  assert(stats.slab_unreclaimable == 50000);
+
+  measurement = evel_new_measurement(1, "Memory", "mem_stats");
+  assert(measurement != NULL);
+  evel_memstats_measurement_add(measurement, &stats, "memory", "vm1");
+  item = dlist_get_first(&measurement->mem_usage);
+  assert(item != NULL);
+  mem_use = (MEASUREMENT_MEM_USE *) item->item;
+  assert(strcmp(mem_use->id, "memory") == 0);
+  assert(strcmp(mem_use->vmid, "vm1") == 0);
+  assert(mem_use->membuffsz == 200000.0);
+  assert(mem_use->memconfig.value == 8000000.0);
+  assert(mem_use->memfree.value == 3000000.0);
+  assert(mem_use->memcache.value == 1500000.0);
+  assert(mem_use->memused.value == 3000000.0);
+  evel_free_event(measurement);
+
+  /***************************************************************************/
+  /* A file without MemTotal is rejected.                                    */
+  /***************************************************************************/
+  write_test_file(path_bad, "MemFree: 1 kB\n");
+  assert(evel_memstats_read_procfs(&stats, path_bad) != EVEL_SUCCESS);
+
+  unlink(path);
+  unlink(path_bad);
+}
+
+void test_diskstats()
+{
+  EVEL_DISK_COLLECTOR collector;
+  EVENT_MEASUREMENT * measurement = NULL;
+  MEASUREMENT_DISK_USE * disk_use = NULL;
+  DLIST_ITEM * item = NULL;
+  char path_first[] = "/tmp/evel_unit_diskstatsXXXXXX";
+  char path_second[] = "/tmp/evel_unit_diskstatsXXXXXX";
+  char path_third[] = "/tmp/evel_unit_diskstatsXXXXXX";
+
+  write_test_file(path_first,
+    "   7       0 loop0 0 0 0 0 0 0 0 0 0 0 0\n"
+    "   8       0 sda 100 10 2000 500 50 5 1000 300 0 600 800\n");
+  assert(evel_disk_collector_init(&collector) == EVEL_SUCCESS);
+  assert(evel_diskstats_sample(&collector, path_first) == EVEL_SUCCESS);
+  assert(collector.num_disks == 1);
+  assert(strcmp(collector.disks[0].counters.name, "sda") == 0);
+  assert(collector.disks[0].summaries[0].count == 0);
+
+  /***************************************************************************/
+  /* sda did 10 reads taking 40ms and 4 writes taking 20ms, with 2 queued,   */
+  /* then 5 reads taking 5ms and none queued.  sdb is new, so only sets its  */
+  /* baseline.                                                               */
+  /***************************************************************************/
+  write_test_file(path_second,
+    "   8       0 sda 110 12 2160 540 54 6 1064 320 2 650 900\n"
+    "   8      16 sdb 1 0 8 1 0 0 0 0 0 1 1\n");
+  assert(evel_diskstats_sample(&collector, path_second) == EVEL_SUCCESS);
+  write_test_file(path_third,
+    "   8       0 sda 115 12 2200 545 54 6 1064 320 0 655 905\n"
+    "   8      16 sdb 1 0 8 1 0 0 0 0 0 1 1\n");
+  assert(evel_diskstats_sample(&collector, path_third) == EVEL_SUCCESS);
+  assert(collector.num_disks == 2);
+
+  measurement = evel_new_measurement(1, "Disk", "disk_stats");
+  assert(measurement != NULL);
+  evel_diskstats_measurement_add(measurement, &collector);
+  item = dlist_get_first(&measurement->disk_usage);
+  assert(item != NULL);
+  assert(dlist_get_next(item) != NULL);
+  disk_use = (MEASUREMENT_DISK_USE *) item->item;
+  assert(strcmp(disk_use->id, "sda") == 0);
+  assert(disk_use->timereadmax.value == 4.0);
+  assert(disk_use->timereadmin.value == 1.0);
+  assert(disk_use->timereadavg.value == 2.5);
+  assert(disk_use->timereadlast.value == 1.0);
+  assert(disk_use->timewritemax.value == 5.0);
+  assert(disk_use->timewritelast.value == 0.0);
+  assert(disk_use->pendingopsmax.value == 2.0);
+  assert(disk_use->pendingopslast.value == 0.0);
+  assert(disk_use->opsreadmax.value > 0.0);
+  assert(disk_use->octetsreadmin.value > 0.0);
+  assert(disk_use->octetswritelast.value == 0.0);
+  evel_free_event(measurement);
+
+  /***************************************************************************/
+  /* The summaries start again for the next interval.                        */
+  /***************************************************************************/
+  assert(collector.disks[0].summaries[0].count == 0);
+  measurement = evel_new_measurement(1, "Disk", "disk_stats");
+  assert(measurement != NULL);
+  evel_diskstats_measurement_add(measurement, &collector);
+  assert(dlist_get_first(&measurement->disk_usage) == NULL);
+  evel_free_event(measurement);
+
+  evel_disk_collector_free(&collector);
+  unlink(path_first);
+  unlink(path_second);
+  unlink(path_third);
+}
+
+void test_fsstats()
+{
+  EVENT_MEASUREMENT * measurement = NULL;
+  MEASUREMENT_FSYS_USE * fsys_use = NULL;
+  DLIST_ITEM * item = NULL;
+  char path[] = "/tmp/evel_unit_mountsXXXXXX";
+
+  /***************************************************************************/
+  /* Only the first mount of the device is reported; pseudo filesystems and  */
+  /* mount points which do not exist are skipped.                            */
+  /***************************************************************************/
+  write_test_file(path,
+    "proc /proc proc rw,nosuid 0 0\n"
+    "/dev/evel_unit0 / ext4 rw,relatime 0 0\n"
+    "/dev/evel_unit0 /tmp ext4 rw,relatime 0 0\n"
+    "/dev/evel_unit1 /no\\040such\\040dir ext4 rw 0 0\n");
+
+  measurement = evel_new_measurement(1, "Filesystem", "fs_stats");
+  assert(measurement != NULL);
+  assert(evel_fsstats_measurement_add(measurement, path) == EVEL_SUCCESS);
+  item = dlist_get_first(&measurement->filesystem_usage);
+  assert(item != NULL);
+  assert(dlist_get_next(item) == NULL);
+  fsys_use = (MEASUREMENT_FSYS_USE *) item->item;
+  assert(strcmp(fsys_use->filesystem_name, "/") == 0);
+  assert(fsys_use->block_configured > 0.0);
+  assert(fsys_use->block_used <= fsys_use->block_configured);
+  evel_free_event(measurement);
+
+  unlink(path);
+}
+
+/**************************************************************************//**
+ * Test network interface counters from /proc/net/dev.
+ *****************************************************************************/
+void test_ifstats()
+{
+  EVEL_IF_SNAPSHOT before;
+  EVEL_IF_SNAPSHOT after;
+  const EVEL_IF_STATS * eth0_before;
+  const EVEL_IF_STATS * eth0_after;
+  MEASUREMENT_VNIC_PERFORMANCE * vnic_performance = NULL;
+  char path_before[] = "/tmp/evel_unit_netdevXXXXXX";
+  char path_after[] = "/tmp/evel_unit_netdevXXXXXX";
+
+  write_test_file(path_before,
+    "Inter-|   Receive                                                |"
+    "  Transmit\n"
+    " face |bytes    packets errs drop fifo frame compressed multicast|"
+    "bytes    packets errs drop fifo colls carrier compressed\n"
+    "    lo:    1000      10    0    0    0     0          0         0"
+    "     1000      10    0    0    0     0       0          0\n"
+    "eth0:4294967296 100 1 2 0 0 0 10 8589934592 200 3 4 0 0 0 0\n"
+    "  bad0: 1 2 3\n");
+  write_test_file(path_after,
+    "Inter-|   Receive                                                |"
+    "  Transmit\n"
+    " face |bytes    packets errs drop fifo frame compressed multicast|"
+    "bytes    packets errs drop fifo colls carrier compressed\n"
+    "eth0:4294972296 150 1 5 0 0 0 20 8589934692 260 3 4 0 0 0 0\n");
+
+  assert(evel_if_snapshot_init(&before) == EVEL_SUCCESS);
+  assert(evel_if_snapshot_init(&after) == EVEL_SUCCESS);
+  assert(evel_ifstats_read_procfs(&before, path_before) == EVEL_SUCCESS);
+  assert(evel_ifstats_read_procfs(&after, path_after) == EVEL_SUCCESS);
+
+  /***************************************************************************/
+  /* The malformed line is skipped, and counters are read in full even with  */
+  /* no space after the colon.                                               */
+  /***************************************************************************/
+  assert(evel_if_snapshot_get(&before, "lo") != NULL);
+  assert(evel_if_snapshot_get(&before, "bad0") == NULL);
+  eth0_before = evel_if_snapshot_get(&before, "eth0");
+  assert(eth0_before != NULL);
+  assert(eth0_before->rx_bytes == 4294967296ULL);
+  assert(eth0_before->rx_packets == 100);
+  assert(eth0_before->rx_errors == 1);
+  assert(eth0_before->rx_dropped == 2);
+  assert(eth0_before->rx_multicast == 10);
+  assert(eth0_before->tx_bytes == 8589934592ULL);
+  assert(eth0_before->tx_packets == 200);
+  assert(eth0_before->tx_errors == 3);
+  assert(eth0_before->tx_dropped == 4);
+
+  /***************************************************************************/
+  /* An interface which has gone away is no longer found.                    */
+  /***************************************************************************/
+  assert(evel_if_snapshot_get(&after, "lo") == NULL);
+  eth0_after = evel_if_snapshot_get(&after, "eth0");
+  assert(eth0_after != NULL);
+
+  vnic_performance = evel_measurement_new_vnic_performance("eth0", "false");
+  assert(vnic_performance != NULL);
+  evel_vnic_performance_if_stats_set(vnic_performance,
+                                     eth0_after,
+                                     eth0_before);
+  assert(vnic_performance->recvd_octets_acc.value == 4294972296.0);
+  assert(vnic_performance->recvd_octets_delta.value == 5000.0);
+  assert(vnic_performance->recvd_total_packets_delta.value == 50.0);
+  assert(vnic_performance->recvd_ucast_packets_acc.value == 130.0);
+  assert(vnic_performance->recvd_ucast_packets_delta.value == 40.0);
+  assert(vnic_performance->recvd_mcast_packets_delta.value == 10.0);
+  assert(vnic_performance->recvd_discarded_packets_delta.value == 3.0);
+  assert(vnic_performance->recvd_error_packets_delta.value == 0.0);
+  assert(vnic_performance->tx_octets_acc.value == 8589934692.0);
+  assert(vnic_performance->tx_octets_delta.value == 100.0);
+  assert(vnic_performance->tx_total_packets_delta.value == 60.0);
+  assert(!vnic_performance->recvd_bcast_packets_acc.is_set);
+  assert(!vnic_performance->tx_bcast_packets_delta.is_set);
+  evel_measurement_free_vnic_performance(vnic_performance);
+  free(vnic_performance);
+
+  evel_if_snapshot_free(&before);
+  evel_if_snapshot_free(&after);
+  unlink(path_before);
+  unlink(path_after);
+}
+
+/**************************************************************************//**
+ * Compile a test configuration down to a copy of its "name".
+ *****************************************************************************/
+static void * test_config_compile(const EVEL_CONFIG * config, void * context)
+{
+  const char * name = evel_config_string(config, NULL, "name", NULL);
+
+  assert(context == NULL);
+
+  return (name != NULL) ? strdup(name) : NULL;
+}
+
+/**************************************************************************//**
+ * Test configuration parsing, lookup and reload on change.
+ *****************************************************************************/
+void test_config()
+{
+  EVEL_CONFIG * config = NULL;
+  EVEL_CONFIG_WATCH * watch = NULL;
+  const EVEL_CONFIG_NODE * node = NULL;
+  char * compiled = NULL;
+  char * old_compiled = NULL;
+  char path[] = "/tmp/evel_unit_configXXXXXX";
+  char path_bad[] = "/tmp/evel_unit_configXXXXXX";
+  char dir[] = "/tmp/evel_unit_configXXXXXX";
+  char file[sizeof(dir) + 16];
+  char new_file[sizeof(dir) + 16];
+  FILE * fp;
+  int count = 0;
+
+  /***************************************************************************/
+  /* Nested lookup, escapes, integers and array iteration.                   */
+  /***************************************************************************/
+  write_test_file(path,
+    "{\n"
+    "  \"direct\": {\"eventName\": \"a\\\"b\\u00e9\", \"interval\": 20},\n"
+    "  \"devices\": [\"lo\", \"eth0\", \"eth1\"],\n"
+    "  \"flag\": true\n"
+    "}\n");
+  config = evel_new_config(path);
+  assert(config != NULL);
+  assert(strcmp(evel_config_string(config, NULL, "direct/eventName", NULL),
+                "a\"b\xc3\xa9") == 0);
+  assert(evel_config_int(config, NULL, "direct/interval", 0) == 20);
+  assert(evel_config_int(config, NULL, "direct/eventName", -1) == -1);
+  assert(evel_config_int(config, NULL, "direct/missing", 60) == 60);
+  assert(strcmp(evel_config_string(config, NULL, "flag", NULL), "true") == 0);
+  assert(evel_config_find(config, NULL, "flag/deeper") == NULL);
+  node = evel_config_find(config, NULL, "devices");
+  assert(node != NULL && node->type == EVEL_CONFIG_ARRAY);
+  for (node = evel_config_child(config, node);
+       node != NULL;
+       node = evel_config_next(config, node))
+  {
+    assert(node->type == EVEL_CONFIG_STRING);
+    count++;
+  }
+  assert(count == 3);
+  evel_free_config(config);
+
+  write_test_file(path_bad, "{\"direct\": {\"eventName\": \"a\"}");
+  assert(evel_new_config(path_bad) == NULL);
+
+  /***************************************************************************/
+  /* A watch reloads only when the file is replaced, and keeps the version a */
+  /* reader holds until it is released.                                     */
+  /***************************************************************************/
+  assert(mkdtemp(dir) != NULL);
+  snprintf(file, sizeof(file), "%s/test.json", dir);
+  snprintf(new_file, sizeof(new_file), "%s/test.json.new", dir);
+  fp = fopen(file, "w");
+  assert(fp != NULL);
+  fputs("{\"name\": \"first\"}", fp);
+  fclose(fp);
+
+  watch = evel_new_config_watch(file, test_config_compile, free, NULL);
+  assert(watch != NULL);
+  assert(evel_config_watch_check(watch) == 0);
+  old_compiled = evel_config_watch_acquire(watch);
+  assert(strcmp(old_compiled, "first") == 0);
+
+  fp = fopen(new_file, "w");
+  assert(fp != NULL);
+  fputs("{\"name\": \"second\"}", fp);
+  fclose(fp);
+  assert(rename(new_file, file) == 0);
+  assert(evel_config_watch_check(watch) == 1);
+  compiled = evel_config_watch_acquire(watch);
+  assert(strcmp(compiled, "second") == 0);
+  assert(strcmp(old_compiled, "first") == 0);
+  evel_config_watch_release(watch, old_compiled);
+  evel_config_watch_release(watch, compiled);
+
+  /***************************************************************************/
+  /* A version which does not compile leaves the current one in place.       */
+  /***************************************************************************/
+  fp = fopen(new_file, "w");
+  assert(fp != NULL);
+  fputs("{\"other\": 1}", fp);
+  fclose(fp);
+  assert(rename(new_file, file) == 0);
+  assert(evel_config_watch_check(watch) == 0);
+  compiled = evel_config_watch_acquire(watch);
+  assert(strcmp(compiled, "second") == 0);
+  evel_config_watch_release(watch, compiled);
+  evel_free_config_watch(watch);
+
+  unlink(file);
+  rmdir(dir);
+  unlink(path);
+  unlink(path_bad);
+}
+
+/**************************************************************************//**
+ * Test command template compilation, rendering and native counters.
+ *****************************************************************************/
+void test_command()
+{
+  const char * const variables[] = { "tmp_device", "other" };
+  const char * const values[] = { "eth0", "X" };
+  EVEL_COMMAND command;
+  EVEL_IF_SNAPSHOT snapshot;
+  char buffer[64];
+  char path[] = "/tmp/evel_unit_netdevXXXXXX";
+
+  /***************************************************************************/
+  /* Variables are only matched as whole names.                              */
+  /***************************************************************************/
+  assert(evel_command_compile(&command,
+                              "echo $tmp_device-$tmp_devicex $other$",
+                              variables,
+                              2) == EVEL_SUCCESS);
+  assert(command.type == EVEL_COMMAND_SHELL);
+  assert(command.num_segments == 5);
+  assert(evel_command_render(&command, values, buffer, sizeof(buffer)) == 25);
+  assert(strcmp(buffer, "echo eth0-$tmp_devicex X$") == 0);
+  assert(evel_command_render(&command, values, buffer, 8) == 25);
+  assert(strcmp(buffer, "echo et") == 0);
+  assert(evel_command_run(&command, values, NULL, buffer, sizeof(buffer))
+                                                             == EVEL_SUCCESS);
+  assert(strcmp(buffer, "eth0- X$") == 0);
+  evel_command_free(&command);
+
+  /***************************************************************************/
+  /* /proc/net/dev pipelines are read from the interface counters.           */
+  /***************************************************************************/
+  write_test_file(path,
+    "Inter-|   Receive                            |  Transmit\n"
+    " face |bytes    packets errs drop fifo frame compressed multicast|"
+    "bytes    packets errs drop fifo colls carrier compressed\n"
+    "  eth0:123456789012 2 0 0 0 0 0 0 3 4 0 0 0 0 0 0\n");
+  assert(evel_if_snapshot_init(&snapshot) == EVEL_SUCCESS);
+  assert(evel_ifstats_read_procfs(&snapshot, path) == EVEL_SUCCESS);
+
+  assert(evel_command_compile(&command,
+    "sudo cat /proc/net/dev | grep $tmp_device | tr -s ' ' | "
+    "cut -d ':' -f2 | cut -d ' ' -f2",
+    variables,
+    2) == EVEL_SUCCESS);
+  assert(command.type == EVEL_COMMAND_IF_STATS);
+  assert(evel_command_run(&command, values, &snapshot, buffer, sizeof(buffer))
+                                                             == EVEL_SUCCESS);
+  assert(strcmp(buffer, "123456789012") == 0);
+  evel_command_free(&command);
+
+  assert(evel_command_compile(&command,
+    "cat /proc/net/dev|grep \"$tmp_device\"|tr -s \" \"|cut -d: -f2|"
+    "cut -d' ' -f 11",
+    variables,
+    2) == EVEL_SUCCESS);
+  assert(command.type == EVEL_COMMAND_IF_STATS);
+  assert(evel_command_run(&command, values, &snapshot, buffer, sizeof(buffer))
+                                                             == EVEL_SUCCESS);
+  assert(strcmp(buffer, "4") == 0);
+  evel_command_free(&command);
+
+  assert(evel_command_compile(&command,
+    "cat /proc/net/dev | grep $tmp_device | tr -s ' ' | "
+    "cut -d ':' -f2 | cut -d ' ' -f2 | wc -l",
+    variables,
+    2) == EVEL_SUCCESS);
+  assert(command.type == EVEL_COMMAND_SHELL);
+  evel_command_free(&command);
+
+  evel_if_snapshot_free(&snapshot);
+  unlink(path);
+}
+
+/**************************************************************************//**
+ * Test running a batch of probe commands.
+ *****************************************************************************/
+void test_probe()
+{
+  const char * const variables[] = { "tmp_device" };
+  const char * const links[] = { "l0", "l1", "l2", "l3", "l4", "l5" };
+  EVEL_COMMAND sleeper;
+  EVEL_COMMAND hanger;
+  EVEL_COMMAND failer;
+  EVEL_PROBE probes[8];
+  EVEL_PROBE_STATS stats;
+  char results[8][32];
+  int ii;
+
+  assert(evel_command_compile(&sleeper, "sleep 0.2; echo $tmp_device",
+                              variables, 1) == EVEL_SUCCESS);
+  assert(evel_command_compile(&hanger, "sleep 5 | cat",
+                              variables, 1) == EVEL_SUCCESS);
+  assert(evel_command_compile(&failer, "printf 'a\\npartial\\n'; exit 3",
+                              variables, 1) == EVEL_SUCCESS);
+
+  memset(probes, 0, sizeof(probes));
+  for (ii = 0; ii < 8; ii++)
+  {
+    probes[ii].command = (ii < 6) ? &sleeper : (ii == 6) ? &hanger : &failer;
+    probes[ii].values = &links[(ii < 6) ? ii : 0];
+    probes[ii].result = results[ii];
+    probes[ii].result_size = sizeof(results[ii]);
+  }
+
+  /***************************************************************************/
+  /* Four at a time, the six sleepers take two rounds, not six; the hung     */
+  /* pipeline is killed at its timeout.                                      */
+  /***************************************************************************/
+  assert(evel_probe_run(probes, 8, NULL, 4, 1000, &stats) == EVEL_SUCCESS);
+  for (ii = 0; ii < 6; ii++)
+  {
+    assert(probes[ii].state == EVEL_PROBE_SUCCESS);
+    assert(strcmp(results[ii], links[ii]) == 0);
+  }
+  assert(probes[6].state == EVEL_PROBE_TIMED_OUT);
+  assert(probes[7].state == EVEL_PROBE_FAILED);
+  assert(probes[7].exit_status == 3);
+  assert(strcmp(results[7], "partial") == 0);
+  assert(stats.num_probes == 8);
+  assert(stats.num_failed == 1);
+  assert(stats.num_timed_out == 1);
+  assert(stats.runtime >= 1000000 && stats.runtime < 3000000);
+
+  evel_command_free(&sleeper);
+  evel_command_free(&hanger);
+  evel_command_free(&failer);
+}
+
+/**************************************************************************//**
+ * Runs of a scheduler job, recorded by test_scheduler_job().
+ *****************************************************************************/
+typedef struct test_scheduler_runs {
+  int count;
+  unsigned long long scheduled[32];
+  useconds_t duration;
+} TEST_SCHEDULER_RUNS;
+
+static void test_scheduler_job(void * context, unsigned long long scheduled)
+{
+  TEST_SCHEDULER_RUNS * runs = context;
+
+  if (runs->count < 32)
+  {
+    runs->scheduled[runs->count] = scheduled;
+  }
+  __atomic_add_fetch(&runs->count, 1, __ATOMIC_RELEASE);
+  usleep(runs->duration);
+}
+
+/**************************************************************************//**
+ * Test the periodic job scheduler.
+ *****************************************************************************/
+void test_scheduler()
+{
+  EVEL_SCHEDULER * scheduler;
+  EVEL_SCHEDULER_JOB * job;
+  TEST_SCHEDULER_RUNS quick;
+  TEST_SCHEDULER_RUNS slow;
+  int ii;
+
+  memset(&quick, 0, sizeof(quick));
+  memset(&slow, 0, sizeof(slow));
+  quick.duration = 50000;
+  slow.duration = 450000;
+
+  scheduler = evel_new_scheduler(2);
+  assert(scheduler != NULL);
+  job = evel_scheduler_job_add(scheduler, "quick", 200,
+                               test_scheduler_job, &quick);
+  assert(job != NULL);
+  assert(evel_scheduler_job_add(scheduler, "slow", 200,
+                                test_scheduler_job, &slow) != NULL);
+  assert(evel_scheduler_start(scheduler) == EVEL_SUCCESS);
+  usleep(1500000);
+  evel_scheduler_stop(scheduler);
+
+  /***************************************************************************/
+  /* Runs are on the wall-clock boundaries, exactly one interval apart, even */
+  /* though each run takes a quarter of the interval.                        */
+  /***************************************************************************/
+  assert(quick.count >= 6 && quick.count <= 8);
+  for (ii = 0; ii < quick.count; ii++)
+  {
+    assert(quick.scheduled[ii] % 200000 == 0);
+    if (ii > 0)
+    {
+      assert(quick.scheduled[ii] - quick.scheduled[ii - 1] == 200000);
+    }
+  }
+
+  /***************************************************************************/
+  /* A run still going at the next boundary makes that boundary be skipped.  */
+  /***************************************************************************/
+  assert(slow.count >= 2 && slow.count <= 3);
+  for (ii = 1; ii < slow.count; ii++)
+  {
+    assert(slow.scheduled[ii] - slow.scheduled[ii - 1] == 600000);
+  }
+
+  /***************************************************************************/
+  /* A new interval is lined up with the wall clock in the same way.         */
+  /***************************************************************************/
+  quick.count = 0;
+  evel_scheduler_job_interval_set(job, 500);
+  assert(evel_scheduler_start(scheduler) == EVEL_SUCCESS);
+  usleep(1200000);
+  evel_free_scheduler(scheduler);
+  assert(quick.count >= 2 && quick.count <= 3);
+  for (ii = 0; ii < quick.count; ii++)
+  {
+    assert(quick.scheduled[ii] % 500000 == 0);
+  }
+}
+
+/**************************************************************************//**
+ * Lines handed on by a tail, joined with '|'.
+ *****************************************************************************/
+static void test_tail_line(void * context, const char * line, size_t length)
+{
+  char * lines = context;
+
+  assert(strlen(line) == length);
+  strcat(lines, line);
+  strcat(lines, "|");
+}
+
+/**************************************************************************//**
+ * Append to a file.
+ *****************************************************************************/
+static void test_tail_append(const char * path, const char * text)
+{
+  FILE * fp = fopen(path, "a");
+
+  assert(fp != NULL);
+  fputs(text, fp);
+  fclose(fp);
+}
+
+/**************************************************************************//**
+ * Test following a log file through writes, rotation and truncation.
+ *****************************************************************************/
+void test_tail()
+{
+  char dir[] = "/tmp/evel_unit_tailXXXXXX";
+  char file[64];
+  char rotated[64];
+  char lines[256];
+  EVEL_TAIL * tail;
+
+  assert(mkdtemp(dir) != NULL);
+  snprintf(file, sizeof(file), "%s/messages", dir);
+  snprintf(rotated, sizeof(rotated), "%s/messages.1", dir);
+  test_tail_append(file, "old\n");
+
+  /***************************************************************************/
+  /* Only lines added after the tail starts are handed on, and a line is     */
+  /* held back until its newline arrives.                                    */
+  /***************************************************************************/
+  tail = evel_new_tail(file);
+  assert(tail != NULL);
+  lines[0] = '\0';
+  test_tail_append(file, "a\nb");
+  assert(evel_tail_wait(tail, 100, test_tail_line, lines) == EVEL_SUCCESS);
+  assert(strcmp(lines, "a|") == 0);
+  test_tail_append(file, "c\nd\n");
+  assert(evel_tail_wait(tail, 100, test_tail_line, lines) == EVEL_SUCCESS);
+  assert(strcmp(lines, "a|bc|d|") == 0);
+
+  /***************************************************************************/
+  /* Lines still written to the old file after it is moved away come before  */
+  /* those in its replacement.                                               */
+  /***************************************************************************/
+  lines[0] = '\0';
+  test_tail_append(file, "e\n");
+  assert(rename(file, rotated) == 0);
+  test_tail_append(rotated, "f");
+  assert(evel_tail_wait(tail, 100, test_tail_line, lines) == EVEL_SUCCESS);
+  assert(strcmp(lines, "e|") == 0);
+  test_tail_append(file, "g\n");
+  assert(evel_tail_wait(tail, 100, test_tail_line, lines) == EVEL_SUCCESS);
+  assert(strcmp(lines, "e|f|g|") == 0);
+
+  /***************************************************************************/
+  /* A file truncated in place is read again from its start.                 */
+  /***************************************************************************/
+  lines[0] = '\0';
+  assert(truncate(file, 0) == 0);
+  assert(evel_tail_wait(tail, 100, test_tail_line, lines) == EVEL_SUCCESS);
+  assert(strcmp(lines, "") == 0);
+  test_tail_append(file, "h\n");
+  assert(evel_tail_wait(tail, 100, test_tail_line, lines) == EVEL_SUCCESS);
+  assert(strcmp(lines, "h|") == 0);
+  assert(evel_tail_wait(tail, 10, test_tail_line, lines) == EVEL_SUCCESS);
+  assert(strcmp(lines, "h|") == 0);
+
+  evel_free_tail(tail);
+  unlink(file);
+  unlink(rotated);
+  rmdir(dir);
+}
+
+/**************************************************************************//**
+ * Match a NUL-terminated line.
+ *****************************************************************************/
+static int test_match_line(const EVEL_MATCHER * matcher, const char * line)
+{
+  return evel_matcher_match(matcher, line, strlen(line));
+}
+
+void test_match()
+{
+  EVEL_MATCHER * matcher;
+
+  matcher = evel_new_matcher();
+  assert(matcher != NULL);
+  assert(evel_matcher_compile(matcher) == EVEL_SUCCESS);
+  assert(test_match_line(matcher, "peer reset") == -1);
+
+  /***************************************************************************/
+  /* Overlapping patterns, and patterns ending inside others, are all found; */
+  /* the first added decides the identifier.                                 */
+  /***************************************************************************/
+  assert(evel_matcher_include(matcher, "peer reset", 10) == EVEL_SUCCESS);
+  assert(evel_matcher_include(matcher, "reset", 20) == EVEL_SUCCESS);
+  assert(evel_matcher_include(matcher, "link down", 30) == EVEL_SUCCESS);
+  assert(evel_matcher_include(matcher, "", 40) == EVEL_ERR_GEN_FAIL);
+  assert(evel_matcher_exclude(matcher, "EVEL") == EVEL_SUCCESS);
+  assert(evel_matcher_exclude(matcher, "syslogTag") == EVEL_SUCCESS);
+  assert(evel_matcher_compile(matcher) == EVEL_SUCCESS);
+
+  assert(test_match_line(matcher, "kernel: connection peer reset") == 10);
+  assert(test_match_line(matcher, "kernel: reset by peer reset") == 10);
+  assert(test_match_line(matcher, "kernel: peer peer rese reset") == 20);
+  assert(test_match_line(matcher, "eth0 link down, reset") == 20);
+  assert(test_match_line(matcher, "eth0 link dow") == -1);
+  assert(test_match_line(matcher, "") == -1);
+  assert(evel_matcher_match(matcher, "peer reset", 9) == -1);
+
+  /***************************************************************************/
+  /* An exclude pattern anywhere in the line, including inside an include    */
+  /* pattern, stops it matching.                                             */
+  /***************************************************************************/
+  assert(test_match_line(matcher, "EVEL: peer reset") == -1);
+  assert(test_match_line(matcher, "peer reset syslogTag") == -1);
+  assert(test_match_line(matcher, "peer reset syslogTa") == 10);
+
+  /***************************************************************************/
+  /* Adding a pattern needs a recompile, and patterns are matched bytewise.  */
+  /***************************************************************************/
+  assert(evel_matcher_exclude(matcher, "res") == EVEL_SUCCESS);
+  assert(evel_matcher_include(matcher, "\xc3\xa9tat", 50) == EVEL_SUCCESS);
+  assert(evel_matcher_compile(matcher) == EVEL_SUCCESS);
+  assert(test_match_line(matcher, "peer reset") == -1);
+  assert(test_match_line(matcher, "link down") == 30);
+  assert(test_match_line(matcher, "\xc3\xa9tat") == 50);
+
+  evel_free_matcher(matcher);
+  evel_free_matcher(NULL);
+}
+
+/**************************************************************************//**
+ * Parse a NUL-terminated syslog message.
+ *****************************************************************************/
+static void test_receiver_parse(const char * text,
+                                char * fields,
+                                EVEL_SYSLOG_MESSAGE * message)
+{
+  evel_syslog_parse(text, strlen(text), fields, message);
+}
+
+/**************************************************************************//**
+ * Record the application and message of each message received, joined by
+ * '|'.
+ *****************************************************************************/
+static void test_receiver_message(void * context,
+                                  const EVEL_SYSLOG_MESSAGE * message)
+{
+  char * received = context;
+
+  strcat(received, message->app_name != NULL ? message->app_name : "-");
+  strcat(received, ":");
+  strcat(received, message->message);
+  strcat(received, "|");
+}
+
+void test_receiver()
+{
+  char dir[] = "/tmp/evel_unit_receiverXXXXXX";
+  char fields[512];
+  char received[512];
+  char name[80];
+  struct sockaddr_un address;
+  EVEL_SYSLOG_MESSAGE message;
+  EVEL_SYSLOG_RECEIVER * receiver;
+  int sender;
+
+  /***************************************************************************/
+  /* RFC 5424, with structured data and a BOM before the message.            */
+  /***************************************************************************/
+  test_receiver_parse("<165>1 2003-10-11T22:14:15.003Z mymachine.example.com "
+                      "evntslog 1234 ID47 [exampleSDID@32473 iut=\"3\" "
+                      "eventID=\"1011\" x=\"a\\]b\"][other@1 y=\"2\"] "
+                      "\xef\xbb\xbf" "An application event\n",
+                      fields, &message);
+  assert(message.version == 1);
+  assert(message.facility == EVEL_SYSLOG_FACILITY_LOCAL4);
+  assert(message.severity == 5);
+  assert(strcmp(evel_syslog_severity_name(message.severity), "Notice") == 0);
+  assert(strcmp(message.timestamp, "2003-10-11T22:14:15.003Z") == 0);
+  assert(strcmp(message.hostname, "mymachine.example.com") == 0);
+  assert(strcmp(message.app_name, "evntslog") == 0);
+  assert(message.proc_id == 1234);
+  assert(strcmp(message.msg_id, "ID47") == 0);
+  assert(strcmp(message.structured_data,
+                "[exampleSDID@32473 iut=\"3\" eventID=\"1011\" x=\"a\\]b\"]"
+                "[other@1 y=\"2\"]") == 0);
+  assert(strcmp(message.sdid, "exampleSDID@32473") == 0);
+  assert(strcmp(message.message, "An application event") == 0);
+
+  test_receiver_parse("<34>1 - - su - - - ", fields, &message);
+  assert(message.facility == EVEL_SYSLOG_FACILITY_SECURITY_AUTH);
+  assert(message.severity == 2);
+  assert(message.timestamp == NULL && message.hostname == NULL);
+  assert(strcmp(message.app_name, "su") == 0);
+  assert(message.proc_id == 0 && message.msg_id == NULL);
+  assert(message.structured_data == NULL && message.sdid[0] == '\0');
+  assert(strcmp(message.message, "") == 0);
+
+  /***************************************************************************/
+  /* RFC 3164, from the network and from syslog() without a hostname.        */
+  /***************************************************************************/
+  test_receiver_parse("<13>Oct  9 22:33:20 host01 kernel: peer reset",
+                      fields, &message);
+  assert(message.version == 0);
+  assert(message.facility == EVEL_SYSLOG_FACILITY_USER);
+  assert(strcmp(message.timestamp, "Oct  9 22:33:20") == 0);
+  assert(strcmp(message.hostname, "host01") == 0);
+  assert(strcmp(message.app_name, "kernel") == 0);
+  assert(strcmp(message.message, "peer reset") == 0);
+
+  test_receiver_parse("<30>Oct 19 01:02:03 sshd[812]: Accepted key",
+                      fields, &message);
+  assert(message.facility == EVEL_SYSLOG_FACILITY_SYSTEM_DAEMON);
+  assert(message.severity == 6);
+  assert(message.hostname == NULL);
+  assert(strcmp(message.app_name, "sshd") == 0);
+  assert(message.proc_id == 812);
+  assert(strcmp(message.message, "Accepted key") == 0);
+
+  /***************************************************************************/
+  /* Without a valid priority or a tag, the text is all message.             */
+  /***************************************************************************/
+  test_receiver_parse("<999>no priority here", fields, &message);
+  assert(message.facility == EVEL_SYSLOG_FACILITY_USER);
+  assert(message.severity == 5);
+  assert(message.app_name == NULL);
+  assert(strcmp(message.message, "<999>no priority here") == 0);
+
+  /***************************************************************************/
+  /* Messages sent to a Unix socket are received together.                   */
+  /***************************************************************************/
+  assert(mkdtemp(dir) != NULL);
+  snprintf(name, sizeof(name), "%s/log", dir);
+  receiver = evel_new_syslog_receiver();
+  assert(receiver != NULL);
+  assert(evel_syslog_receiver_unix(receiver, name) == EVEL_SUCCESS);
+
+  sender = socket(AF_UNIX, SOCK_DGRAM, 0);
+  assert(sender >= 0);
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, name);
+  assert(sendto(sender, "<14>app[1]: one", 15, 0,
+                (struct sockaddr *) &address, sizeof(address)) == 15);
+  assert(sendto(sender, "<14>1 - - two - - - 2", 21, 0,
+                (struct sockaddr *) &address, sizeof(address)) == 21);
+
+  received[0] = '\0';
+  assert(evel_syslog_receiver_wait(receiver, 1000,
+                                   test_receiver_message,
+                                   received) == EVEL_SUCCESS);
+  assert(strcmp(received, "app:one|two:2|") == 0);
+  received[0] = '\0';
+  assert(evel_syslog_receiver_wait(receiver, 10,
+                                   test_receiver_message,
+                                   received) == EVEL_SUCCESS);
+  assert(received[0] == '\0');
+
+  close(sender);
+  evel_free_syslog_receiver(receiver);
+  assert(access(name, F_OK) != 0);
+  rmdir(dir);
+}
+
+void test_syslog_addl_fields()
+{
+  EVENT_SYSLOG * syslog;
+
+  syslog = evel_new_syslog("syslog_test", "syslog0001",
+                           EVEL_SOURCE_VIRTUAL_MACHINE, "peer reset", "reset");
+  assert(syslog != NULL);
+  evel_syslog_addl_field_add(syslog, "repeatCount", "3");
+  assert(strcmp(syslog->additional_filters.value, "repeatCount=3") == 0);
+  evel_syslog_addl_field_add(syslog, "host", "vm1");
+  assert(strcmp(syslog->additional_filters.value,
+                "repeatCount=3|host=vm1") == 0);
+  evel_free_event(syslog);
+}
+
+/**************************************************************************//**
+ * Record each rule raised or cleared, and check its Threshold Crossing
+ * Alert.
+ *****************************************************************************/
+static void test_rules_alert(void * context,
+                             const EVEL_RULE_ALERT * const alert)
+{
+  char * alerts = context;
+  char text[80];
+  EVENT_THRESHOLD_CROSS * event;
+
+  sprintf(text, "%s:%s:%g|",
+          alert->rule,
+          alert->action == EVEL_EVENT_ACTION_SET ? "set" : "clear",
+          alert->value);
+  strcat(alerts, text);
+
+  event = evel_rules_new_threshold_cross(alert, "tca_test", "tca0001");
+  assert(event != NULL);
+  assert(event->alertAction == alert->action);
+  assert(strcmp(event->additionalParameters.name, alert->metric) == 0);
+  assert(event->eventStartTimestamp <= event->collectionTimestamp);
+  evel_free_event(event);
+}
+
+void test_rules()
+{
+  char alerts[512] = "";
+  EVEL_RULES * rules;
+  EVEL_RULE_SPEC spec;
+  int cpu;
+  int packets;
+  int errors;
+
+  rules = evel_new_rules(test_rules_alert, alerts);
+  assert(rules != NULL);
+
+  /***************************************************************************/
+  /* Raised above 80 once held for 2s, cleared at or below 60 once held for  */
+  /* 1s.                                                                     */
+  /***************************************************************************/
+  memset(&spec, 0, sizeof(spec));
+  spec.name = "cpuHigh";
+  spec.metric = "cpu";
+  spec.type = EVEL_RULE_ABSOLUTE;
+  spec.direction = EVEL_RULE_ABOVE;
+  spec.set_threshold = 80;
+  spec.clear_threshold = 60;
+  spec.set_after_ms = 2000;
+  spec.clear_after_ms = 1000;
+  spec.severity = EVEL_SEVERITY_MAJOR;
+  spec.alert_type = EVEL_ELEMENT_ANOMALY;
+  assert(evel_rules_add(rules, &spec) == EVEL_SUCCESS);
+
+  /***************************************************************************/
+  /* Raised below 10 packets a second, cleared at 20 or more.                */
+  /***************************************************************************/
+  memset(&spec, 0, sizeof(spec));
+  spec.name = "trafficLow";
+  spec.metric = "packets";
+  spec.type = EVEL_RULE_RATE;
+  spec.direction = EVEL_RULE_BELOW;
+  spec.set_threshold = 10;
+  spec.clear_threshold = 20;
+  spec.severity = EVEL_SEVERITY_MINOR;
+  spec.alert_type = EVEL_INTERFACE_ANOMALY;
+  assert(evel_rules_add(rules, &spec) == EVEL_SUCCESS);
+
+  /***************************************************************************/
+  /* Raised when more than half of the packets are errors.                   */
+  /***************************************************************************/
+  memset(&spec, 0, sizeof(spec));
+  spec.name = "errorsHigh";
+  spec.metric = "errors";
+  spec.denominator = "packets";
+  spec.type = EVEL_RULE_RATIO;
+  spec.direction = EVEL_RULE_ABOVE;
+  spec.set_threshold = 0.5;
+  spec.clear_threshold = 0.5;
+  spec.severity = EVEL_SEVERITY_CRITICAL;
+  spec.alert_type = EVEL_INTERFACE_ANOMALY;
+  assert(evel_rules_add(rules, &spec) == EVEL_SUCCESS);
+
+  cpu = evel_rules_metric(rules, "cpu");
+  packets = evel_rules_metric(rules, "packets");
+  errors = evel_rules_metric(rules, "errors");
+  assert(cpu >= 0 && packets >= 0 && errors >= 0);
+  assert(evel_rules_metric(rules, "packets") == packets);
+
+  /***************************************************************************/
+  /* A breach which does not last is ignored; one which does raises the      */
+  /* rule, which stays raised until the value drops to the clear threshold. */
+  /***************************************************************************/
+  evel_rules_sample(rules, cpu, 90, 0);
+  evel_rules_sample(rules, cpu, 70, 1000000);
+  evel_rules_sample(rules, cpu, 90, 2000000);
+  evel_rules_sample(rules, cpu, 95, 3000000);
+  assert(strcmp(alerts, "") == 0);
+  evel_rules_sample(rules, cpu, 95, 4000000);
+  assert(strcmp(alerts, "cpuHigh:set:95|") == 0);
+  evel_rules_sample(rules, cpu, 70, 5000000);
+  evel_rules_sample(rules, cpu, 50, 6000000);
+  assert(strcmp(alerts, "cpuHigh:set:95|") == 0);
+  evel_rules_sample(rules, cpu, 55, 7000000);
+  assert(strcmp(alerts, "cpuHigh:set:95|cpuHigh:clear:55|") == 0);
+  alerts[0] = '\0';
+
+  /***************************************************************************/
+  /* Rates need two samples.                                                 */
+  /***************************************************************************/
+  evel_rules_sample(rules, packets, 0, 0);
+  evel_rules_sample(rules, packets, 100, 1000000);
+  evel_rules_sample(rules, packets, 105, 2000000);
+  assert(strcmp(alerts, "trafficLow:set:5|") == 0);
+  evel_rules_sample(rules, packets, 115, 3000000);
+  assert(strcmp(alerts, "trafficLow:set:5|") == 0);
+  evel_rules_sample(rules, packets, 140, 4000000);
+  assert(strcmp(alerts, "trafficLow:set:5|trafficLow:clear:25|") == 0);
+  alerts[0] = '\0';
+
+  /***************************************************************************/
+  /* A ratio is only evaluated at the end of a round in which both metrics   */
+  /* were sampled, so errors are never divided by the last round's packets.  */
+  /***************************************************************************/
+  evel_rules_sample(rules, errors, 60, 4000000);
+  evel_rules_round_end(rules);
+  assert(strcmp(alerts, "") == 0);
+  evel_rules_sample(rules, errors, 80, 5000000);
+  evel_rules_sample(rules, packets, 200, 5000000);
+  evel_rules_round_end(rules);
+  assert(strcmp(alerts, "") == 0);
+  evel_rules_sample(rules, packets, 220, 6000000);
+  evel_rules_round_end(rules);
+  assert(strcmp(alerts, "") == 0);
+  evel_rules_sample(rules, errors, 150, 7000000);
+  evel_rules_sample(rules, packets, 250, 7000000);
+  evel_rules_round_end(rules);
+  assert(strcmp(alerts, "errorsHigh:set:0.6|") == 0);
+  evel_rules_sample(rules, errors, 90, 8000000);
+  evel_rules_sample(rules, packets, 300, 8000000);
+  evel_rules_round_end(rules);
+  assert(strcmp(alerts, "errorsHigh:set:0.6|errorsHigh:clear:0.3|") == 0);
+
+  evel_free_rules(rules);
+}
+
+static void test_delta_encode(char * json_body, const double cpu2_idle)
+{
+  EVENT_MEASUREMENT * measurement;
+  MEASUREMENT_CPU_USE * cpu_use;
+
+  measurement = evel_new_measurement(1.0, "delta_test", "delta0001");
+  assert(measurement != NULL);
+  cpu_use = evel_measurement_new_cpu_use_add(measurement, "cpu1", 10.0);
+  evel_measurement_cpu_use_idle_set(cpu_use, 90.0);
+  cpu_use = evel_measurement_new_cpu_use_add(measurement, "cpu2", 20.0);
+  evel_measurement_cpu_use_idle_set(cpu_use, cpu2_idle);
+
+  evel_json_encode_event(json_body, EVEL_MAX_JSON_BODY,
+                         (EVENT_HEADER *) measurement);
+  evel_free_event(measurement);
+}
+
+void test_delta()
+{
+  char json_body[EVEL_MAX_JSON_BODY];
+
+  assert(evel_delta_enable(EVEL_DOMAIN_MEASUREMENT, 3) == EVEL_SUCCESS);
+
+  /***************************************************************************/
+  /* The first event is sent in full, and the next without what has not      */
+  /* changed.                                                                */
+  /***************************************************************************/
+  test_delta_encode(json_body, 80.0);
+  assert(strstr(json_body, "\"cpuIdentifier\": \"cpu1\"") != NULL);
+  assert(strstr(json_body, "\"cpuIdentifier\": \"cpu2\"") != NULL);
+
+  test_delta_encode(json_body, 80.0);
+  assert(strstr(json_body, "cpuUsageArray") == NULL);
+
+  /***************************************************************************/
+  /* A changed optional field is sent with the mandatory fields only.        */
+  /***************************************************************************/
+  test_delta_encode(json_body, 70.0);
+  assert(strstr(json_body,
+                "\"cpuUsageArray\": [{\"cpuIdentifier\": \"cpu2\", "
+                "\"cpuIdle\": 70.000000, "
+                "\"percentUsage\": 20.000000}]") != NULL);
+  assert(strstr(json_body, "cpu1") == NULL);
+
+  /***************************************************************************/
+  /* Every third event is sent in full, as is every event once disabled.     */
+  /***************************************************************************/
+  test_delta_encode(json_body, 70.0);
+  assert(strstr(json_body, "\"cpuIdle\": 90.000000") != NULL);
+  assert(strstr(json_body, "\"cpuIdle\": 70.000000") != NULL);
+
+  test_delta_encode(json_body, 70.0);
+  assert(strstr(json_body, "cpuUsageArray") == NULL);
+
+  evel_delta_disable(EVEL_DOMAIN_MEASUREMENT);
+  test_delta_encode(json_body, 70.0);
+  assert(strstr(json_body, "\"cpuIdle\": 90.000000") != NULL);
+}
+
+void test_metrics()
+{
+  char path[] = "/tmp/evel_unit_metricsXXXXXX";
+  char json_body[EVEL_MAX_JSON_BODY];
+  EVEL_METRICS * writer;
+  EVEL_METRICS * reader;
+  EVEL_METRIC * packets;
+  EVEL_METRIC * depth;
+  EVEL_METRIC_VALUE values[4];
+  EVENT_MEASUREMENT * measurement;
+  uint32_t max_metrics;
+  uint64_t values_offset;
+  int fd;
+
+  fd = mkstemp(path);
+  assert(fd >= 0);
+  close(fd);
+
+  /***************************************************************************/
+  /* The reader finds nothing until the application creates the registry.   */
+  /***************************************************************************/
+  reader = evel_new_metrics_reader(path);
+  assert(reader != NULL);
+  assert(evel_metrics_snapshot(reader, values, 4) == 0);
+
+  writer = evel_new_metrics(path, 3);
+  assert(writer != NULL);
+  packets = evel_metrics_add(writer, "app", "packets", EVEL_METRIC_COUNTER);
+  depth = evel_metrics_add(writer, "app", "queueDepth", EVEL_METRIC_GAUGE);
+  assert(packets != NULL);
+  assert(depth != NULL);
+  assert(evel_metrics_add(writer, "app", "packets", EVEL_METRIC_COUNTER) ==
+         packets);
+  assert(evel_metrics_add(writer, "app", "packets", EVEL_METRIC_GAUGE) ==
+         NULL);
+
+  evel_metric_increment(packets, 5);
+  evel_metric_increment(packets, 2);
+  evel_metric_set(depth, 12.5);
+
+  assert(evel_metrics_snapshot(reader, values, 4) == 2);
+  assert(strcmp(values[0].group, "app") == 0);
+  assert(strcmp(values[0].name, "packets") == 0);
+  assert(values[0].type == EVEL_METRIC_COUNTER);
+  assert(values[0].counter == 7);
+  assert(strcmp(values[1].name, "queueDepth") == 0);
+  assert(values[1].type == EVEL_METRIC_GAUGE);
+  assert(values[1].gauge == 12.5);
+
+  /***************************************************************************/
+  /* Metrics are added to a measurement as custom measurements.              */
+  /***************************************************************************/
+  measurement = evel_new_measurement(1.0, "metrics_test", "metrics0001");
+  assert(measurement != NULL);
+  assert(evel_metrics_measurement_add(reader, measurement) == 2);
+  evel_json_encode_event(json_body, EVEL_MAX_JSON_BODY,
+                         (EVENT_HEADER *) measurement);
+  evel_free_event(measurement);
+  assert(strstr(json_body, "\"name\": \"app\"") != NULL);
+  assert(strstr(json_body,
+                "{\"name\": \"packets\", \"value\": \"7\"}") != NULL);
+  assert(strstr(json_body,
+                "{\"name\": \"queueDepth\", \"value\": \"12.5\"}") != NULL);
+
+  /***************************************************************************/
+  /* A registry recreated by a restarted application is mapped afresh, and   */
+  /* one removed reads as empty.                                             */
+  /***************************************************************************/
+  evel_free_metrics(writer);
+  writer = evel_new_metrics(path, 3);
+  assert(writer != NULL);
+  assert(evel_metrics_snapshot(reader, values, 4) == 0);
+  packets = evel_metrics_add(writer, "app", "restarts", EVEL_METRIC_COUNTER);
+  evel_metric_increment(packets, 1);
+  assert(evel_metrics_snapshot(reader, values, 4) == 1);
+  assert(strcmp(values[0].name, "restarts") == 0);
+  assert(values[0].counter == 1);
+
+  evel_free_metrics(writer);
+  assert(evel_metrics_snapshot(reader, values, 4) == 0);
+  evel_free_metrics(reader);
+
+  /***************************************************************************/
+  /* A registry whose layout wraps around the end of the address space is    */
+  /* refused rather than read.                                               */
+  /***************************************************************************/
+  writer = evel_new_metrics(path, 3);
+  assert(writer != NULL);
+  assert(evel_metrics_add(writer, "app", "packets", EVEL_METRIC_COUNTER) !=
+         NULL);
+  fd = open(path, O_RDWR);
+  assert(fd >= 0);
+  max_metrics = (1 << 20) + 1;
+  values_offset = 0 - ((uint64_t) 64 << 20);
+  assert(pwrite(fd, &max_metrics, sizeof(max_metrics), 8) ==
+         sizeof(max_metrics));
+  assert(pwrite(fd, &values_offset, sizeof(values_offset), 32) ==
+         sizeof(values_offset));
+  close(fd);
+  reader = evel_new_metrics_reader(path);
+  assert(reader != NULL);
+  assert(evel_metrics_snapshot(reader, values, 4) == 0);
+  evel_free_metrics(reader);
+  evel_free_metrics(writer);
+}
+
+static size_t test_collectd_part(unsigned char * pos,
+                                 const int type,
+                                 const void * body,
+                                 const size_t length)
+{
+  pos[0] = type >> 8;
+  pos[1] = type & 0xff;
+  pos[2] = (length + 4) >> 8;
+  pos[3] = (length + 4) & 0xff;
+  memcpy(pos + 4, body, length);
+  return length + 4;
+}
+
+static size_t test_collectd_string(unsigned char * pos,
+                                   const int type,
+                                   const char * value)
+{
+  return test_collectd_part(pos, type, value, strlen(value) + 1);
+}
+
+static size_t test_collectd_values(unsigned char * pos,
+                                   const int num_values,
+                                   const int type,
+                                   const double * values)
+{
+  unsigned char body[2 + EVEL_COLLECTD_MAX_VALUES * 9];
+  unsigned long long bits;
+  int ii;
+  int jj;
+
+  body[0] = 0;
+  body[1] = num_values;
+  for (ii = 0; ii < num_values; ii++)
+  {
+    body[2 + ii] = type;
+    if (type == EVEL_COLLECTD_GAUGE)
+    {
+      memcpy(&bits, &values[ii], sizeof(bits));
+      for (jj = 0; jj < 8; jj++)
+      {
+        body[2 + num_values + ii * 8 + jj] = (bits >> (8 * jj)) & 0xff;
+      }
+    }
+    else
+    {
+      bits = (unsigned long long) values[ii];
+      for (jj = 0; jj < 8; jj++)
+      {
+        body[2 + num_values + ii * 8 + jj] = (bits >> (56 - 8 * jj)) & 0xff;
+      }
+    }
+  }
+  return test_collectd_part(pos, 6, body, 2 + num_values * 9);
+}
+
+static size_t test_collectd_time(unsigned char * pos,
+                                 const unsigned long long seconds)
+{
+  unsigned char body[8];
+  int ii;
+
+  for (ii = 0; ii < 8; ii++)
+  {
+    body[ii] = (seconds >> (56 - 8 * ii)) & 0xff;
+  }
+  return test_collectd_part(pos, 1, body, sizeof(body));
+}
+
+static void test_collectd_add(void * context,
+                              const EVEL_COLLECTD_VALUES * values)
+{
+  evel_collectd_add(context, values);
+}
+
+static EVENT_MEASUREMENT * test_collectd_measurement(void * context,
+                                                     const char * host)
+{
+  EVENT_MEASUREMENT ** measurement = context;
+
+  assert(strcmp(host, "vm1") == 0);
+  *measurement = evel_new_measurement(10.0, "collectd_test", "collectd0001");
+  assert(*measurement != NULL);
+  return *measurement;
+}
+
+void test_collectd()
+{
+  unsigned char packet[1024];
+  char json_body[EVEL_MAX_JSON_BODY];
+  EVEL_COLLECTD * collectd;
+  EVENT_MEASUREMENT * measurement = NULL;
+  double values[3];
+  size_t length = 0;
+
+  collectd = evel_new_collectd();
+  assert(collectd != NULL);
+
+  /***************************************************************************/
+  /* Each part sets the identity of the value lists which follow it.         */
+  /***************************************************************************/
+  length += test_collectd_string(packet + length, 0, "vm1");
+  length += test_collectd_time(packet + length, 1500000000);
+  length += test_collectd_string(packet + length, 2, "cpu");
+  length += test_collectd_string(packet + length, 3, "0");
+  length += test_collectd_string(packet + length, 4, "percent");
+  length += test_collectd_string(packet + length, 5, "idle");
+  values[0] = 75.0;
+  length += test_collectd_values(packet + length, 1, EVEL_COLLECTD_GAUGE, values);
+  length += test_collectd_string(packet + length, 5, "user");
+  values[0] = 20.0;
+  length += test_collectd_values(packet + length, 1, EVEL_COLLECTD_GAUGE, values);
+  length += test_collectd_string(packet + length, 5, "system");
+  values[0] = 5.0;
+  length += test_collectd_values(packet + length, 1, EVEL_COLLECTD_GAUGE, values);
+  length += test_collectd_string(packet + length, 2, "interface");
+  length += test_collectd_string(packet + length, 3, "eth0");
+  length += test_collectd_string(packet + length, 4, "if_octets");
+  length += test_collectd_string(packet + length, 5, "");
+  values[0] = 1000;
+  values[1] = 2000;
+  length += test_collectd_values(packet + length, 2, EVEL_COLLECTD_DERIVE, values);
+  length += test_collectd_string(packet + length, 2, "memory");
+  length += test_collectd_string(packet + length, 3, "");
+  length += test_collectd_string(packet + length, 4, "memory");
+  length += test_collectd_string(packet + length, 5, "used");
+  values[0] = 2048.0 * 1024;
+  length += test_collectd_values(packet + length, 1, EVEL_COLLECTD_GAUGE, values);
+  length += test_collectd_string(packet + length, 2, "load");
+  length += test_collectd_string(packet + length, 4, "load");
+  length += test_collectd_string(packet + length, 5, "");
+  values[0] = 0.5;
+  values[1] = 0.25;
+  values[2] = 0.125;
+  length += test_collectd_values(packet + length, 3, EVEL_COLLECTD_GAUGE, values);
+  assert(length <= sizeof(packet));
+  assert(evel_collectd_parse(packet, length, test_collectd_add, collectd) == 6);
+
+  /***************************************************************************/
+  /* A second reading gives the interface's deltas.                          */
+  /***************************************************************************/
+  length = 0;
+  length += test_collectd_string(packet + length, 0, "vm1");
+  length += test_collectd_time(packet + length, 1500000010);
+  length += test_collectd_string(packet + length, 2, "interface");
+  length += test_collectd_string(packet + length, 3, "eth0");
+  length += test_collectd_string(packet + length, 4, "if_octets");
+  values[0] = 3000;
+  values[1] = 2500;
+  length += test_collectd_values(packet + length, 2, EVEL_COLLECTD_DERIVE, values);
+  assert(evel_collectd_parse(packet, length, test_collectd_add, collectd) == 1);
+
+  /***************************************************************************/
+  /* A truncated datagram is malformed.                                      */
+  /***************************************************************************/
+  assert(evel_collectd_parse(packet, length - 1, test_collectd_add, collectd) == -1);
+
+  assert(evel_collectd_report(collectd, test_collectd_measurement,
+                              &measurement) == 1);
+  assert(measurement != NULL);
+  evel_json_encode_event(json_body, EVEL_MAX_JSON_BODY,
+                         (EVENT_HEADER *) measurement);
+  evel_free_event(measurement);
+  assert(strstr(json_body, "\"cpuIdentifier\": \"0\"") != NULL);
+  assert(strstr(json_body, "\"cpuIdle\": 75.000000") != NULL);
+  assert(strstr(json_body, "\"percentUsage\": 25.000000") != NULL);
+  assert(strstr(json_body, "\"vNicIdentifier\": \"eth0\"") != NULL);
+  assert(strstr(json_body, "\"receivedOctetsAccumulated\": 3000") != NULL);
+  assert(strstr(json_body, "\"receivedOctetsDelta\": 2000") != NULL);
+  assert(strstr(json_body, "\"transmittedOctetsDelta\": 500") != NULL);
+  assert(strstr(json_body, "\"memoryUsed\": 2048.000000") != NULL);
+  assert(strstr(json_body, "\"name\": \"load\"") != NULL);
+  assert(strstr(json_body,
+                "{\"name\": \"load.1\", \"value\": \"0.25\"}") != NULL);
+
+  /***************************************************************************/
+  /* Nothing new has been received, so there is nothing to report.           */
+  /***************************************************************************/
+  measurement = NULL;
+  assert(evel_collectd_report(collectd, test_collectd_measurement,
+                              &measurement) == 0);
+  assert(measurement == NULL);
+
+  /***************************************************************************/
+  /* New readings of value lists already seen are reported again.            */
+  /***************************************************************************/
+  assert(evel_collectd_parse(packet, length, test_collectd_add, collectd) == 1);
+  assert(evel_collectd_report(collectd, test_collectd_measurement,
+                              &measurement) == 1);
+  assert(measurement != NULL);
+  evel_json_encode_event(json_body, EVEL_MAX_JSON_BODY,
+                         (EVENT_HEADER *) measurement);
+  evel_free_event(measurement);
+  assert(strstr(json_body, "\"receivedOctetsDelta\": 0") != NULL);
+  assert(strstr(json_body, "cpuUsageArray") == NULL);
+
+  /***************************************************************************/
+  /* A derive may go down, which is a negative rate rather than a reset.     */
+  /***************************************************************************/
+  length = 0;
+  length += test_collectd_string(packet + length, 0, "vm1");
+  length += test_collectd_time(packet + length, 1500000000);
+  length += test_collectd_string(packet + length, 2, "app");
+  length += test_collectd_string(packet + length, 4, "queue");
+  values[0] = 100;
+  length += test_collectd_values(packet + length, 1, EVEL_COLLECTD_DERIVE, values);
+  length += test_collectd_time(packet + length, 1500000010);
+  values[0] = 40;
+  length += test_collectd_values(packet + length, 1, EVEL_COLLECTD_DERIVE, values);
+  assert(evel_collectd_parse(packet, length, test_collectd_add, collectd) == 2);
+  assert(evel_collectd_report(collectd, test_collectd_measurement,
+                              &measurement) == 1);
+  evel_json_encode_event(json_body, EVEL_MAX_JSON_BODY,
+                         (EVENT_HEADER *) measurement);
+  evel_free_event(measurement);
+  assert(strstr(json_body,
+                "{\"name\": \"queue\", \"value\": \"-6\"}") != NULL);
+
+  evel_free_collectd(collectd);
+}
+
+/**************************************************************************//**
+ * Fetch a path from the Prometheus endpoint on the loopback address.
+ *****************************************************************************/
+static void test_prometheus_get(const int port,
+                                const char * path,
+                                char * response,
+                                size_t size)
+{
+  struct sockaddr_in address;
+  char request[128];
+  size_t length = 0;
+  ssize_t bytes;
+  int fd;
+
+  fd = socket(AF_INET, SOCK_STREAM, 0);
+  assert(fd >= 0);
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  assert(connect(fd, (struct sockaddr *) &address, sizeof(address)) == 0);
+
+  snprintf(request, sizeof(request),
+           "GET %s HTTP/1.1\r\nHost: localhost\r\n\r\n", path);
+  assert(send(fd, request, strlen(request), 0) == (ssize_t) strlen(request));
+  while ((bytes = recv(fd, response + length, size - 1 - length, 0)) > 0)
+  {
+    length += bytes;
+  }
+  response[length] = '\0';
+  close(fd);
+}
+
+void test_prometheus()
+{
+  const int port = 29105;
+  char json_body[EVEL_MAX_JSON_BODY];
+  char response[16384];
+  EVENT_MEASUREMENT * measurement;
+  MEASUREMENT_CPU_USE * cpu_use;
+  int ii;
+
+  assert(evel_prometheus_start("127.0.0.1", port) == EVEL_SUCCESS);
+  assert(evel_prometheus_start("127.0.0.1", port) != EVEL_SUCCESS);
+
+  /***************************************************************************/
+  /* Values are taken as measurements are encoded, the latest winning.       */
+  /***************************************************************************/
+  for (ii = 1; ii <= 2; ii++)
+  {
+    measurement = evel_new_measurement(10.0, "prometheus_test",
+                                       "prometheus0001");
+    assert(measurement != NULL);
+    evel_source_name_set(&measurement->header, "vm\"1");
+    cpu_use = evel_measurement_new_cpu_use_add(measurement, "cpu0", 12.5 * ii);
+    evel_measurement_cpu_use_idle_set(cpu_use, 100.0 - 12.5 * ii);
+    evel_measurement_new_cpu_use_add(measurement, "cpu1", 50.0);
+    evel_measurement_request_rate_set(measurement, 7);
+    evel_measurement_custom_measurement_add(measurement, "app", "packets", "42");
+    evel_measurement_custom_measurement_add(measurement, "app", "state", "up");
+    evel_json_encode_event(json_body, EVEL_MAX_JSON_BODY,
+                           (EVENT_HEADER *) measurement);
+    evel_free_event(measurement);
+  }
+
+  test_prometheus_get(port, "/metrics", response, sizeof(response));
+  assert(strstr(response, "HTTP/1.1 200 OK\r\n") == response);
+  assert(strstr(response, "Content-Type: text/plain; version=0.0.4") != NULL);
+  assert(strstr(response, "\nevel_events_posted_total ") != NULL);
+  assert(strstr(response, "\nevel_prometheus_scrapes_total 1\n") != NULL);
+  assert(strstr(response,
+                "# TYPE ves_cpuIdle gauge\n"
+                "ves_cpuIdle{event=\"prometheus_test\",source=\"vm\\\"1\","
+                "id=\"cpu0\"} 75\n") != NULL);
+  assert(strstr(response,
+                "ves_percentUsage{event=\"prometheus_test\","
+                "source=\"vm\\\"1\",id=\"cpu0\"} 25\n") != NULL);
+  assert(strstr(response,
+                "ves_percentUsage{event=\"prometheus_test\","
+                "source=\"vm\\\"1\",id=\"cpu1\"} 50\n") != NULL);
+  assert(strstr(strstr(response, "# TYPE ves_percentUsage") + 1,
+                "# TYPE ves_percentUsage") == NULL);
+  assert(strstr(response,
+                "ves_measurementInterval{event=\"prometheus_test\","
+                "source=\"vm\\\"1\"} 10\n") != NULL);
+  assert(strstr(response,
+                "ves_requestRate{event=\"prometheus_test\","
+                "source=\"vm\\\"1\"} 7\n") != NULL);
+  assert(strstr(response,
+                "ves_additionalMeasurements{event=\"prometheus_test\","
+                "source=\"vm\\\"1\",group=\"app\",name=\"packets\"} 42\n")
+         != NULL);
+  assert(strstr(response, "name=\"state\"") == NULL);
+  assert(strstr(response, "ves_sequence") == NULL);
+
+  test_prometheus_get(port, "/", response, sizeof(response));
+  assert(strstr(response, "HTTP/1.1 404 Not Found\r\n") == response);
+
+  evel_prometheus_stop();
+}
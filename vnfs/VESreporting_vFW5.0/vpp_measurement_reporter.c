@@ -28,10 +28,8 @@
 #define READ_INTERVAL 10
 
 typedef struct dummy_vpp_metrics_struct {
-  int bytes_in;
-  int bytes_out;
-  int packets_in;
-  int packets_out;
+  EVEL_IF_STATS stats;
+  int valid;
 } vpp_metrics_struct;
 
 void read_vpp_metrics(vpp_metrics_struct *, char *);
@@ -43,13 +41,8 @@ int main(int argc, char** argv)
   EVENT_HEADER* vpp_m_header = NULL;
   EVENT_HEADER* batch_header = NULL;
   MEASUREMENT_VNIC_PERFORMANCE * vnic_performance = NULL;
-  int bytes_in_this_round;
-  int bytes_out_this_round;
-  int packets_in_this_round;
-  int packets_out_this_round;
   vpp_metrics_struct* last_vpp_metrics = malloc(sizeof(vpp_metrics_struct));
   vpp_metrics_struct* curr_vpp_metrics = malloc(sizeof(vpp_metrics_struct));
-  struct timeval time_val;
   time_t start_epoch;
   time_t last_epoch;
   char hostname[BUFSIZE];
@@ -130,8 +123,7 @@ int main(int argc, char** argv)
   gethostname(hostname, BUFSIZE);
   memset(last_vpp_metrics, 0, sizeof(vpp_metrics_struct));
   read_vpp_metrics(last_vpp_metrics, vnic);
-  gettimeofday(&time_val, NULL);
-  start_epoch = time_val.tv_sec * 1000000 + time_val.tv_usec;
+  start_epoch = evel_time_now_usec(EVEL_CLOCK_EXACT);
   sleep(READ_INTERVAL);
 
   /***************************************************************************/
@@ -141,42 +133,17 @@ int main(int argc, char** argv)
     memset(curr_vpp_metrics, 0, sizeof(vpp_metrics_struct));
     read_vpp_metrics(curr_vpp_metrics, vnic);
 
-    if(curr_vpp_metrics->bytes_in - last_vpp_metrics->bytes_in > 0) {
-      bytes_in_this_round = curr_vpp_metrics->bytes_in - last_vpp_metrics->bytes_in;
-    }
-    else {
-      bytes_in_this_round = 0;
-    }
-    if(curr_vpp_metrics->bytes_out - last_vpp_metrics->bytes_out > 0) {
-      bytes_out_this_round = curr_vpp_metrics->bytes_out - last_vpp_metrics->bytes_out;
-    }
-    else {
-      bytes_out_this_round = 0;
-    }
-    if(curr_vpp_metrics->packets_in - last_vpp_metrics->packets_in > 0) {
-      packets_in_this_round = curr_vpp_metrics->packets_in - last_vpp_metrics->packets_in;
-    }
-    else {
-      packets_in_this_round = 0;
-    }
-    if(curr_vpp_metrics->packets_out - last_vpp_metrics->packets_out > 0) {
-      packets_out_this_round = curr_vpp_metrics->packets_out - last_vpp_metrics->packets_out;
-    }
-    else {
-      packets_out_this_round = 0;
-    }
-
     vpp_m = evel_new_measurement(READ_INTERVAL, eventName, eventId);
 
     if(vpp_m != NULL) {
       printf("New measurement report created...\n");
       vnic_performance = (MEASUREMENT_VNIC_PERFORMANCE *)evel_measurement_new_vnic_performance(vnic, "true");
       evel_meas_vnic_performance_add(vpp_m, vnic_performance);
-      evel_vnic_performance_rx_total_pkt_delta_set(vnic_performance, packets_in_this_round);
-      evel_vnic_performance_tx_total_pkt_delta_set(vnic_performance, packets_out_this_round);
-
-      evel_vnic_performance_rx_octets_delta_set(vnic_performance, bytes_in_this_round);
-      evel_vnic_performance_tx_octets_delta_set(vnic_performance, bytes_out_this_round);
+      if (curr_vpp_metrics->valid) {
+        evel_vnic_performance_if_stats_set(vnic_performance,
+                                           &curr_vpp_metrics->stats,
+                                           last_vpp_metrics->valid ? &last_vpp_metrics->stats : NULL);
+      }
 
       /***************************************************************************/
       /* Set parameters in the MEASUREMENT header packet                         */
@@ -205,12 +172,10 @@ int main(int argc, char** argv)
       printf("New measurement report failed (%s)\n", evel_error_string());
     }
 
-    last_vpp_metrics->bytes_in = curr_vpp_metrics->bytes_in;
-    last_vpp_metrics->bytes_out = curr_vpp_metrics->bytes_out;
-    last_vpp_metrics->packets_in = curr_vpp_metrics->packets_in;
-    last_vpp_metrics->packets_out = curr_vpp_metrics->packets_out;
-    gettimeofday(&time_val, NULL);
-    start_epoch = time_val.tv_sec * 1000000 + time_val.tv_usec;
+    if (curr_vpp_metrics->valid) {
+      *last_vpp_metrics = *curr_vpp_metrics;
+    }
+    start_epoch = evel_time_now_usec(EVEL_CLOCK_EXACT);
 
     sleep(READ_INTERVAL);
   }
@@ -228,46 +193,31 @@ int main(int argc, char** argv)
 }
 
 void read_vpp_metrics(vpp_metrics_struct *vpp_metrics, char *vnic) {
-  // Define an array of char that contains the parameters of the unix 'cut' command
-  char* params[] = {"-f3", "-f11", "-f4", "-f12"};
-  // Define the unix command to execute in order to read metrics from the vNIC
-  char* cmd_prefix = "sudo cat /proc/net/dev | grep \"";
-  char* cmd_mid = "\" | tr -s \' \' | cut -d\' \' ";
-  char cmd[BUFSIZE];
-  // Define other variables
-  char buf[BUFSIZE];		/* buffer used to store VPP metrics 	*/
-  int temp[] = {0, 0, 0, 0};	/* temp array that contains VPP values 	*/
-  FILE *fp;			/* file descriptor to pipe cmd to shell */
-  int i;
-
-  for(i = 0; i < 4; i++) {
-    // Clear buffers
-    memset(buf, 0, BUFSIZE);
-    memset(cmd, 0, BUFSIZE);
-    // Build shell command to read metrics from the vNIC
-    strcat(cmd, cmd_prefix);
-    strcat(cmd, vnic);
-    strcat(cmd, cmd_mid);
-    strcat(cmd, params[i]);
-    
-    // Open a pipe and read VPP values
-    if ((fp = popen(cmd, "r")) == NULL) {
-        printf("Error opening pipe!\n");
-        return;
+  static EVEL_IF_SNAPSHOT snapshot;	/* counters for every interface	*/
+  static int snapshot_ready = 0;
+  const EVEL_IF_STATS *stats;
+
+  if (!snapshot_ready) {
+    if (evel_if_snapshot_init(&snapshot) != EVEL_SUCCESS) {
+      printf("Error allocating interface counters!\n");
+      return;
     }
+    snapshot_ready = 1;
+  }
 
-    while (fgets(buf, BUFSIZE, fp) != NULL);
-    temp[i] = atoi(buf);
+  // Read the 64-bit counters for all interfaces with one netlink request
+  if (evel_ifstats_read_netlink(&snapshot) != EVEL_SUCCESS) {
+    printf("Error reading interface counters!\n");
+    return;
+  }
 
-    if(pclose(fp))  {
-        printf("Command not found or exited with error status\n");
-        return;
-    }
+  stats = evel_if_snapshot_get(&snapshot, vnic);
+  if (stats == NULL) {
+    printf("Interface %s not found\n", vnic);
+    return;
   }
 
   // Store metrics read from the vNIC in the struct passed from the main function
-  vpp_metrics->bytes_in = temp[0];
-  vpp_metrics->bytes_out = temp[1];
-  vpp_metrics->packets_in = temp[2];
-  vpp_metrics->packets_out = temp[3];
+  vpp_metrics->stats = *stats;
+  vpp_metrics->valid = 1;
 }
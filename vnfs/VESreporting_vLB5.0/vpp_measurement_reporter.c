@@ -27,15 +27,23 @@
 
 #define BUFSIZE 128
 #define READ_INTERVAL 10
+#define SAMPLE_PERIOD_MS 100
 
 typedef struct dummy_vpp_metrics_struct {
-  int bytes_in;
-  int bytes_out;
-  int packets_in;
-  int packets_out;
+  EVEL_COUNTER bytes_in;
+  EVEL_COUNTER bytes_out;
+  EVEL_COUNTER packets_in;
+  EVEL_COUNTER packets_out;
 } vpp_metrics_struct;
 
-void read_vpp_metrics(vpp_metrics_struct *, char *);
+typedef struct dummy_vnic_sample_struct {
+  char *vnic;
+  EVEL_IF_SNAPSHOT snapshot;
+  const EVEL_IF_STATS *stats;
+} vnic_sample_struct;
+
+EVEL_ERR_CODES read_vpp_metrics(vpp_metrics_struct *, char *);
+EVEL_SAMPLER *start_vnic_sampler(vnic_sample_struct *);
 
 unsigned long long epoch_start = 0;
 
@@ -111,9 +119,10 @@ int main(int argc, char** argv)
   int bytes_out_this_round;
   int packets_in_this_round;
   int packets_out_this_round;
-  vpp_metrics_struct* last_vpp_metrics = malloc(sizeof(vpp_metrics_struct));
-  vpp_metrics_struct* curr_vpp_metrics = malloc(sizeof(vpp_metrics_struct));
-  struct timeval time_val;
+  EVEL_ERR_CODES read_rc;
+  vpp_metrics_struct* vpp_metrics = malloc(sizeof(vpp_metrics_struct));
+  vnic_sample_struct vnic_sample;
+  EVEL_SAMPLER* vnic_sampler = NULL;
   //time_t start_epoch;
   //time_t last_epoch;
   char hostname[BUFSIZE];
@@ -187,10 +196,17 @@ int main(int argc, char** argv)
   }
 
   gethostname(hostname, BUFSIZE);
-  memset(last_vpp_metrics, 0, sizeof(vpp_metrics_struct));
-  read_vpp_metrics(last_vpp_metrics, vnic);
-  gettimeofday(&time_val, NULL);
-  epoch_start = time_val.tv_sec * 1000000 + time_val.tv_usec;
+  evel_counter_init(&vpp_metrics->bytes_in, 64);
+  evel_counter_init(&vpp_metrics->bytes_out, 64);
+  evel_counter_init(&vpp_metrics->packets_in, 64);
+  evel_counter_init(&vpp_metrics->packets_out, 64);
+  read_vpp_metrics(vpp_metrics, vnic);
+
+  // Sample the vNIC rates several times a second, so that bursts shorter
+  // than the reporting interval show in the reported maximum and percentiles
+  vnic_sample.vnic = vnic;
+  vnic_sampler = start_vnic_sampler(&vnic_sample);
+  epoch_start = evel_time_now_usec(EVEL_CLOCK_EXACT);
   sleep(READ_INTERVAL);
 
   /***************************************************************************/
@@ -210,29 +226,29 @@ int main(int argc, char** argv)
       return 1;
     }
 
-    memset(curr_vpp_metrics, 0, sizeof(vpp_metrics_struct));
-    read_vpp_metrics(curr_vpp_metrics, vnic);
+    // A failed read leaves the last interval's deltas, so they are not sent
+    read_rc = read_vpp_metrics(vpp_metrics, vnic);
 
-    if(active_dns > 0 && (curr_vpp_metrics->bytes_in - last_vpp_metrics->bytes_in > 0)) {
-      bytes_in_this_round = (int) round((curr_vpp_metrics->bytes_in - last_vpp_metrics->bytes_in) / active_dns);
+    if(active_dns > 0) {
+      bytes_in_this_round = (int) round(vpp_metrics->bytes_in.delta / active_dns);
     }
     else {
       bytes_in_this_round = 0;
     }
-    if(active_dns > 0 && (curr_vpp_metrics->bytes_out - last_vpp_metrics->bytes_out > 0)) {
-      bytes_out_this_round = (int) round((curr_vpp_metrics->bytes_out - last_vpp_metrics->bytes_out) / active_dns);
+    if(active_dns > 0) {
+      bytes_out_this_round = (int) round(vpp_metrics->bytes_out.delta / active_dns);
     }
     else {
       bytes_out_this_round = 0;
     }
-    if(active_dns > 0 && (curr_vpp_metrics->packets_in - last_vpp_metrics->packets_in > 0)) {
-      packets_in_this_round = (int) round((curr_vpp_metrics->packets_in - last_vpp_metrics->packets_in) / active_dns);
+    if(active_dns > 0) {
+      packets_in_this_round = (int) round(vpp_metrics->packets_in.delta / active_dns);
     }
     else {
       packets_in_this_round = 0;
     }
-    if(active_dns > 0 && (curr_vpp_metrics->packets_out - last_vpp_metrics->packets_out > 0)) {
-      packets_out_this_round = (int) round((curr_vpp_metrics->packets_out - last_vpp_metrics->packets_out) / active_dns);
+    if(active_dns > 0) {
+      packets_out_this_round = (int) round(vpp_metrics->packets_out.delta / active_dns);
     }
     else {
       packets_out_this_round = 0;
@@ -248,18 +264,28 @@ int main(int argc, char** argv)
       evel_measurement_type_set(vpp_m, "HTTP request rate");
       evel_measurement_request_rate_set(vpp_m, rand()%10000);
 
-      evel_vnic_performance_rx_total_pkt_delta_set(vnic_performance, packets_in_this_round);
-      evel_vnic_performance_tx_total_pkt_delta_set(vnic_performance, packets_out_this_round);
+      if (read_rc == EVEL_SUCCESS) {
+        evel_vnic_performance_rx_total_pkt_delta_set(vnic_performance, packets_in_this_round);
+        evel_vnic_performance_tx_total_pkt_delta_set(vnic_performance, packets_out_this_round);
+
+        evel_vnic_performance_rx_octets_delta_set(vnic_performance, bytes_in_this_round);
+        evel_vnic_performance_tx_octets_delta_set(vnic_performance, bytes_out_this_round);
+
+        evel_vnic_performance_rx_total_pkt_acc_set(vnic_performance, vpp_metrics->packets_in.value);
+        evel_vnic_performance_tx_total_pkt_acc_set(vnic_performance, vpp_metrics->packets_out.value);
+
+        evel_vnic_performance_rx_octets_acc_set(vnic_performance, vpp_metrics->bytes_in.value);
+        evel_vnic_performance_tx_octets_acc_set(vnic_performance, vpp_metrics->bytes_out.value);
+      }
 
-      evel_vnic_performance_rx_octets_delta_set(vnic_performance, bytes_in_this_round);
-      evel_vnic_performance_tx_octets_delta_set(vnic_performance, bytes_out_this_round);
+      if (vnic_sampler != NULL) {
+        evel_sampler_collect(vnic_sampler, vpp_m);
+      }
 
       /***************************************************************************/
       /* Set parameters in the MEASUREMENT header packet                         */
       /***************************************************************************/
-      struct timeval tv_now;
-      gettimeofday(&tv_now, NULL);
-      unsigned long long epoch_now = tv_now.tv_usec + 1000000 * tv_now.tv_sec;
+      unsigned long long epoch_now = evel_time_now_usec(EVEL_CLOCK_EXACT);
 
       //last_epoch = start_epoch + READ_INTERVAL * 1000000;
       vpp_m_header = (EVENT_HEADER *)vpp_m;
@@ -288,10 +314,6 @@ int main(int argc, char** argv)
       printf("New measurement report failed (%s)\n", evel_error_string());
     }
 
-    last_vpp_metrics->bytes_in = curr_vpp_metrics->bytes_in;
-    last_vpp_metrics->bytes_out = curr_vpp_metrics->bytes_out;
-    last_vpp_metrics->packets_in = curr_vpp_metrics->packets_in;
-    last_vpp_metrics->packets_out = curr_vpp_metrics->packets_out;
     //gettimeofday(&time_val, NULL);
     //start_epoch = time_val.tv_sec * 1000000 + time_val.tv_usec;
 
@@ -303,55 +325,103 @@ int main(int argc, char** argv)
   /***************************************************************************/
   sleep(1);
   evel_free_measurement(vpp_m);
-  free(last_vpp_metrics);
-  free(curr_vpp_metrics);
+  free(vpp_metrics);
+  if (vnic_sampler != NULL) {
+    evel_free_sampler(vnic_sampler);
+    evel_if_snapshot_free(&vnic_sample.snapshot);
+  }
   evel_terminate();
   printf("Terminated\n");
 
   return 0;
 }
 
-void read_vpp_metrics(vpp_metrics_struct *vpp_metrics, char *vnic) {
-  // Define an array of char that contains the parameters of the unix 'cut' command
-  char* params[] = {"-f3", "-f11", "-f4", "-f12"};
-  // Define the unix command to execute in order to read metrics from the vNIC
-  char* cmd_prefix = "sudo cat /proc/net/dev | grep \"";
-  char* cmd_mid = "\" | tr -s \' \' | cut -d\' \' ";
-  char cmd[BUFSIZE];
-  // Define other variables
-  char buf[BUFSIZE];		/* buffer used to store VPP metrics 	*/
-  int temp[] = {0, 0, 0, 0};	/* temp array that contains VPP values 	*/
-  FILE *fp;			/* file descriptor to pipe cmd to shell */
-  int i;
-
-  for(i = 0; i < 4; i++) {
-    // Clear buffers
-    memset(buf, 0, BUFSIZE);
-    memset(cmd, 0, BUFSIZE);
-    // Build shell command to read metrics from the vNIC
-    strcat(cmd, cmd_prefix);
-    strcat(cmd, vnic);
-    strcat(cmd, cmd_mid);
-    strcat(cmd, params[i]);
-    
-    // Open a pipe and read VPP values
-    if ((fp = popen(cmd, "r")) == NULL) {
-      printf("Error opening pipe!\n");
-      return;
+EVEL_ERR_CODES read_vpp_metrics(vpp_metrics_struct *vpp_metrics, char *vnic) {
+  static EVEL_IF_SNAPSHOT snapshot;	/* counters for every interface	*/
+  static int snapshot_ready = 0;
+  const EVEL_IF_STATS *stats;
+
+  if (!snapshot_ready) {
+    if (evel_if_snapshot_init(&snapshot) != EVEL_SUCCESS) {
+      printf("Error allocating interface counters!\n");
+      return EVEL_OUT_OF_MEMORY;
     }
+    snapshot_ready = 1;
+  }
 
-    while (fgets(buf, BUFSIZE, fp) != NULL);
-    temp[i] = atoi(buf);
+  // Read the 64-bit counters for all interfaces with one netlink request
+  if (evel_ifstats_read_netlink(&snapshot) != EVEL_SUCCESS) {
+    printf("Error reading interface counters!\n");
+    return EVEL_ERR_GEN_FAIL;
+  }
 
-    if(pclose(fp))  {
-      printf("Command not found or exited with error status\n");
-      return;
-    }
+  stats = evel_if_snapshot_get(&snapshot, vnic);
+  if (stats == NULL) {
+    printf("Interface %s not found\n", vnic);
+    return EVEL_ERR_GEN_FAIL;
+  }
+
+  // Update the counters passed from the main function, which work out the
+  // deltas since the last read
+  evel_counter_update(&vpp_metrics->bytes_in, stats->rx_bytes, snapshot.timestamp);
+  evel_counter_update(&vpp_metrics->bytes_out, stats->tx_bytes, snapshot.timestamp);
+  evel_counter_update(&vpp_metrics->packets_in, stats->rx_packets, snapshot.timestamp);
+  evel_counter_update(&vpp_metrics->packets_out, stats->tx_packets, snapshot.timestamp);
+  return EVEL_SUCCESS;
+}
+
+EVEL_ERR_CODES read_vnic_sample(void *context) {
+  vnic_sample_struct *vnic_sample = (vnic_sample_struct *) context;
+  EVEL_ERR_CODES rc;
+
+  rc = evel_ifstats_read_netlink(&vnic_sample->snapshot);
+  if (rc != EVEL_SUCCESS) {
+    return rc;
+  }
+  vnic_sample->stats = evel_if_snapshot_get(&vnic_sample->snapshot, vnic_sample->vnic);
+  return (vnic_sample->stats != NULL) ? EVEL_SUCCESS : EVEL_ERR_GEN_FAIL;
+}
+
+EVEL_ERR_CODES sample_rx_bytes(void *context, unsigned long long *value) {
+  *value = ((vnic_sample_struct *) context)->stats->rx_bytes;
+  return EVEL_SUCCESS;
+}
+
+EVEL_ERR_CODES sample_tx_bytes(void *context, unsigned long long *value) {
+  *value = ((vnic_sample_struct *) context)->stats->tx_bytes;
+  return EVEL_SUCCESS;
+}
+
+EVEL_ERR_CODES sample_rx_packets(void *context, unsigned long long *value) {
+  *value = ((vnic_sample_struct *) context)->stats->rx_packets;
+  return EVEL_SUCCESS;
+}
+
+EVEL_ERR_CODES sample_tx_packets(void *context, unsigned long long *value) {
+  *value = ((vnic_sample_struct *) context)->stats->tx_packets;
+  return EVEL_SUCCESS;
+}
+
+EVEL_SAMPLER *start_vnic_sampler(vnic_sample_struct *vnic_sample) {
+  EVEL_SAMPLER *sampler;
+
+  if (evel_if_snapshot_init(&vnic_sample->snapshot) != EVEL_SUCCESS) {
+    printf("Error allocating interface counters for sampling!\n");
+    return NULL;
+  }
+
+  sampler = evel_new_sampler(SAMPLE_PERIOD_MS, read_vnic_sample, vnic_sample);
+  if (sampler == NULL ||
+      evel_sampler_metric_add(sampler, "rxOctetsPerSecond", EVEL_SAMPLE_RATE, 0, sample_rx_bytes, vnic_sample) != EVEL_SUCCESS ||
+      evel_sampler_metric_add(sampler, "txOctetsPerSecond", EVEL_SAMPLE_RATE, 0, sample_tx_bytes, vnic_sample) != EVEL_SUCCESS ||
+      evel_sampler_metric_add(sampler, "rxPacketsPerSecond", EVEL_SAMPLE_RATE, 0, sample_rx_packets, vnic_sample) != EVEL_SUCCESS ||
+      evel_sampler_metric_add(sampler, "txPacketsPerSecond", EVEL_SAMPLE_RATE, 0, sample_tx_packets, vnic_sample) != EVEL_SUCCESS ||
+      evel_sampler_start(sampler) != EVEL_SUCCESS) {
+    printf("Error starting the vNIC sampler!\n");
+    evel_free_sampler(sampler);
+    evel_if_snapshot_free(&vnic_sample->snapshot);
+    return NULL;
   }
 
-  // Store metrics read from the vNIC in the struct passed from the main function
-  vpp_metrics->bytes_in = temp[0];
-  vpp_metrics->bytes_out = temp[1];
-  vpp_metrics->packets_in = temp[2];
-  vpp_metrics->packets_out = temp[3];
+  return sampler;
 }